@@ -1,6 +1,6 @@
 /*
 *
-*  Copyright (C) 2016-2022, OFFIS e.V.
+*  Copyright (C) 2016-2026, OFFIS e.V.
 *  All rights reserved.  See COPYRIGHT file for details.
 *
 *  This software and supporting documentation were developed by
@@ -25,6 +25,7 @@
 #include "dcmtk/dcmdata/cmdlnarg.h"
 
 #include "dcmtk/dcmdata/dcjson.h"
+#include "dcmtk/dcmdata/dcjsonw.h"
 #include "dcmtk/ofstd/ofstream.h"
 #include "dcmtk/ofstd/ofconapp.h"
 #include "dcmtk/ofstd/ofexit.h"
@@ -78,9 +79,12 @@ static OFCondition writeFile(STD_NAMESPACE ostream &out,
             DcmJsonFormatCompact fmt(printMetaInfo);
             fmt.setJsonExtensionEnabled(encode_extended);
             fmt.setJsonNumStringPolicy(opt_ns_policy);
+            /* the compact format is written to a memory buffer first, which is much faster */
+            DcmJsonWriter writer(fmt);
             if (readMode == ERM_dataset)
-               result = dset->writeJsonExt(out, fmt, OFTrue, OFTrue);
-               else result = dfile->writeJson(out, fmt);
+               result = writer.writeDataset(*dset);
+               else result = writer.writeFileFormat(*dfile);
+            out.write(writer.getBuffer(), writer.getLength());
         }
     }
     return result;
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -89,6 +89,9 @@ int main(int argc, char *argv[])
   OFCmdUnsignedInt opt_itempad = 0;
 #ifdef WITH_ZLIB
   OFCmdUnsignedInt opt_compressionLevel = 0;
+#ifdef WITH_THREADS
+  OFCmdUnsignedInt opt_compressionThreads = 1;
+#endif
 #endif
 #ifdef DCMTK_ENABLE_CHARSET_CONVERSION
   const char *opt_convertToCharset = NULL;
@@ -217,6 +220,11 @@ int main(int argc, char *argv[])
     cmd.addSubGroup("deflate compression level (only with --write-xfer-deflated):");
       cmd.addOption("--compression-level",   "+cl", 1, "[l]evel: integer (default: 6)",
                                                        "0=uncompressed, 1=fastest, 9=best compression");
+#ifdef WITH_THREADS
+    cmd.addSubGroup("deflate compression threads (only with --write-xfer-deflated):");
+      cmd.addOption("--compression-threads", "+ct", 1, "[n]umber: integer (1..128, default: 1)",
+                                                       "compress blocks of data in n threads in parallel");
+#endif
 #endif
 
     /* evaluate command line */
@@ -535,6 +543,14 @@ int main(int argc, char *argv[])
         app.checkValue(cmd.getValueAndCheckMinMax(opt_compressionLevel, 0, 9));
         dcmZlibCompressionLevel.set(OFstatic_cast(int, opt_compressionLevel));
       }
+#ifdef WITH_THREADS
+      if (cmd.findOption("--compression-threads"))
+      {
+        app.checkDependence("--compression-threads", "--write-xfer-deflated", opt_oxfer == EXS_DeflatedLittleEndianExplicit);
+        app.checkValue(cmd.getValueAndCheckMinMax(opt_compressionThreads, 1, 128));
+        dcmZlibCompressionThreads.set(OFstatic_cast(Uint32, opt_compressionThreads));
+      }
+#endif
 #endif
     }
 
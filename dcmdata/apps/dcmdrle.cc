@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2022, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -26,6 +26,7 @@
 #include "dcmtk/ofstd/ofconapp.h"
 #include "dcmtk/dcmdata/dcuid.h"     /* for dcmtk version name */
 #include "dcmtk/dcmdata/dcrledrg.h"  /* for DcmRLEDecoderRegistration */
+#include "dcmtk/dcmdata/dccodec.h"   /* for dcmDecompressionThreads */
 
 #ifdef WITH_ZLIB
 #include <zlib.h>      /* for zlibVersion() */
@@ -90,6 +91,11 @@ int main(int argc, char *argv[])
     cmd.addSubGroup("RLE byte segment order:");
       cmd.addOption("--byte-order-default",  "+bd",    "most significant byte first (default)");
       cmd.addOption("--byte-order-reverse",  "+br",    "least significant byte first");
+#ifdef WITH_THREADS
+    cmd.addSubGroup("multi-frame decompression:");
+      cmd.addOption("--threads",             "+mt", 1, "[n]umber of threads: integer (default: 1)",
+                                                       "decompress frames of multi-frame images\nin parallel using n threads");
+#endif
 
   cmd.addGroup("output options:");
     cmd.addSubGroup("output file format:");
@@ -152,6 +158,15 @@ int main(int argc, char *argv[])
       if (cmd.findOption("--byte-order-reverse")) opt_reversebyteorder = OFTrue;
       cmd.endOptionBlock();
 
+#ifdef WITH_THREADS
+      if (cmd.findOption("--threads"))
+      {
+        OFCmdUnsignedInt opt_decompressionThreads = 1;
+        app.checkValue(cmd.getValueAndCheckMinMax(opt_decompressionThreads, 1, 256));
+        dcmDecompressionThreads.set(OFstatic_cast(Uint32, opt_decompressionThreads));
+      }
+#endif
+
       cmd.beginOptionBlock();
       if (cmd.findOption("--read-file"))
       {
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2017, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -105,6 +105,7 @@ DCMTK_MAIN_FUNCTION
     OFBool opt_write = OFTrue;
     OFBool opt_append = OFFalse;
     OFBool opt_update = OFFalse;
+    OFBool opt_incremental = OFFalse;
     OFBool opt_recurse = OFFalse;
     E_EncodingType opt_enctype = EET_ExplicitLength;
     E_GrpLenEncoding opt_glenc = EGL_withoutGL;
@@ -185,6 +186,11 @@ DCMTK_MAIN_FUNCTION
                                                            "use PGM image 'prefix'+'dcmfile-in' as icon\n(default: create icon from DICOM image)");
         cmd.addOption("--default-icon",          "-Xd", 1, "[f]ilename: string",
                                                            "use specified PGM image if icon cannot be\ncreated automatically (default: black image)");
+#endif
+#ifdef WITH_THREADS
+      cmd.addSubGroup("multi-threading:");
+        cmd.addOption("--threads",               "+mt", 1, "[n]umber of threads: integer (default: 1)",
+                                                           "load and check input files in parallel\nusing n threads");
 #endif
     cmd.addGroup("output options:");
       cmd.addSubGroup("DICOMDIR file:");
@@ -225,6 +231,7 @@ DCMTK_MAIN_FUNCTION
       cmd.addSubGroup("writing:");
         cmd.addOption("--replace",               "-A",     "replace existing DICOMDIR (default)");
         cmd.addOption("--append",                "+A",     "append to existing DICOMDIR");
+        cmd.addOption("--append-incremental",    "+Ai",    "append to existing DICOMDIR, only write new\nrecords to the file (if possible)");
         cmd.addOption("--update",                "+U",     "update existing DICOMDIR");
         cmd.addOption("--discard",               "-w",     "do not write out DICOMDIR");
       cmd.addSubGroup("backup:");
@@ -361,6 +368,14 @@ DCMTK_MAIN_FUNCTION
             ddir.setDefaultIcon(defaultIcon);
         }
 #endif
+#ifdef WITH_THREADS
+        if (cmd.findOption("--threads"))
+        {
+            OFCmdUnsignedInt numberOfThreads = 1;
+            app.checkValue(cmd.getValueAndCheckMinMax(numberOfThreads, 1, 256));
+            ddir.setNumberOfThreads(OFstatic_cast(unsigned int, numberOfThreads));
+        }
+#endif
 
         /* output options */
         if (cmd.findOption("--output-file"))
@@ -435,24 +450,35 @@ DCMTK_MAIN_FUNCTION
             opt_write = OFTrue;
             opt_append = OFFalse;
             opt_update = OFFalse;
+            opt_incremental = OFFalse;
         }
         if (cmd.findOption("--append"))
         {
             opt_write = OFTrue;
             opt_append = OFTrue;
             opt_update = OFFalse;
+            opt_incremental = OFFalse;
+        }
+        if (cmd.findOption("--append-incremental"))
+        {
+            opt_write = OFTrue;
+            opt_append = OFTrue;
+            opt_update = OFFalse;
+            opt_incremental = OFTrue;
         }
         if (cmd.findOption("--update"))
         {
             opt_write = OFTrue;
             opt_append = OFFalse;
             opt_update = OFTrue;
+            opt_incremental = OFFalse;
         }
         if (cmd.findOption("--discard"))
         {
             opt_write = OFFalse;
             opt_append = OFFalse;
             opt_update = OFFalse;
+            opt_incremental = OFFalse;
         }
         cmd.endOptionBlock();
 
@@ -583,26 +609,10 @@ DCMTK_MAIN_FUNCTION
         {
             /* collect 'bad' files */
             OFList<OFFilename> badFiles;
-            unsigned int goodFiles = 0;
-            OFListIterator(OFFilename) iter = fileNames.begin();
-            OFListIterator(OFFilename) last = fileNames.end();
-            /* iterate over all input filenames */
-            while ((iter != last) && result.good())
-            {
-                /* add files to the DICOMDIR */
-                result = ddir.addDicomFile((*iter), opt_directory);
-                if (result.bad())
-                {
-                    badFiles.push_back(*iter);
-                    if (!ddir.abortMode())
-                    {
-                        /* ignore inconsistent file, just warn (already done inside "ddir") */
-                        result = EC_Normal;
-                    }
-                } else
-                    ++goodFiles;
-                ++iter;
-            }
+            size_t goodFiles = 0;
+            /* add all input files to the DICOMDIR (inconsistent files are only
+             * reported unless abort mode is enabled, already done inside "ddir") */
+            result = ddir.addDicomFiles(fileNames, opt_directory, badFiles, goodFiles);
             /* evaluate result of file checking/adding procedure */
             if (goodFiles == 0)
             {
@@ -613,8 +623,8 @@ DCMTK_MAIN_FUNCTION
             {
                 OFOStringStream oss;
                 oss << badFiles.size() << " file(s) cannot be added to DICOMDIR: ";
-                iter = badFiles.begin();
-                last = badFiles.end();
+                OFListIterator(OFFilename) iter = badFiles.begin();
+                OFListIterator(OFFilename) last = badFiles.end();
                 while (iter != last)
                 {
                     oss << OFendl << "  " << (*iter);
@@ -629,7 +639,10 @@ DCMTK_MAIN_FUNCTION
             if (result.good() && opt_write)
             {
                 action = "writing";
-                result = ddir.writeDicomDir(opt_enctype, opt_glenc);
+                if (opt_incremental)
+                    result = ddir.writeDicomDirIncremental(opt_enctype, opt_glenc);
+                else
+                    result = ddir.writeDicomDir(opt_enctype, opt_glenc);
             }
         }
     }
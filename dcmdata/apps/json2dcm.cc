@@ -0,0 +1,329 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: Convert JSON document to DICOM file or data set
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/cmdlnarg.h"
+#include "dcmtk/dcmdata/dcjsonr.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/ofconapp.h"
+#include "dcmtk/dcmdata/dcostrmz.h"   /* for dcmZlibCompressionLevel */
+
+#ifdef WITH_ZLIB
+#include <zlib.h>                     /* for zlibVersion() */
+#endif
+
+#define OFFIS_CONSOLE_APPLICATION "json2dcm"
+#define OFFIS_CONSOLE_DESCRIPTION "Convert JSON document to DICOM file or data set"
+
+static char rcsid[] = "$dcmtk: " OFFIS_CONSOLE_APPLICATION " v"
+  OFFIS_DCMTK_VERSION " " OFFIS_DCMTK_RELEASEDATE " $";
+
+static OFLogger json2dcmLogger = OFLog::getLogger("dcmtk.apps." OFFIS_CONSOLE_APPLICATION);
+
+#define SHORTCOL 3
+#define LONGCOL 21
+
+// ********************************************
+
+/* write a single dataset to a DICOM file */
+static OFCondition writeFile(DcmFileFormat &fileformat,
+                             const OFFilename &ofname,
+                             E_TransferSyntax xfer,
+                             E_EncodingType enctype,
+                             E_GrpLenEncoding glenc,
+                             E_PaddingEncoding padenc,
+                             OFCmdUnsignedInt filepad,
+                             OFCmdUnsignedInt itempad,
+                             E_FileWriteMode writeMode)
+{
+    DcmDataset *dataset = fileformat.getDataset();
+    /* JSON documents are always encoded in UTF-8 */
+    if (dataset->containsExtendedCharacters(OFFalse /*checkAllStrings*/))
+    {
+        OFString charset;
+        if (dataset->findAndGetOFStringArray(DCM_SpecificCharacterSet, charset).bad() || (charset != "ISO_IR 192"))
+        {
+            OFLOG_WARN(json2dcmLogger, "data set contains non-ASCII characters, setting Specific Character Set to \"ISO_IR 192\"");
+            dataset->putAndInsertString(DCM_SpecificCharacterSet, "ISO_IR 192");
+        }
+    }
+    OFLOG_INFO(json2dcmLogger, "writing DICOM output file: " << ofname);
+    if (!fileformat.canWriteXfer(xfer))
+    {
+        OFLOG_ERROR(json2dcmLogger, "no conversion to transfer syntax " << DcmXfer(xfer).getXferName() << " possible!");
+        return EC_CannotChangeRepresentation;
+    }
+    OFCondition result = fileformat.saveFile(ofname, xfer, enctype, glenc, padenc,
+        OFstatic_cast(Uint32, filepad), OFstatic_cast(Uint32, itempad), writeMode);
+    if (result.bad())
+        OFLOG_ERROR(json2dcmLogger, result.text() << ": writing file: "  << ofname);
+    return result;
+}
+
+
+int main(int argc, char *argv[])
+{
+    OFBool opt_allDatasets = OFFalse;
+    const char *opt_bulkDataDir = NULL;
+    E_TransferSyntax opt_xfer = EXS_LittleEndianExplicit;
+    E_EncodingType opt_enctype = EET_ExplicitLength;
+    E_GrpLenEncoding opt_glenc = EGL_recalcGL;
+    E_PaddingEncoding opt_padenc = EPD_withoutPadding;
+    E_FileWriteMode opt_writeMode = EWM_fileformat;
+    OFCmdUnsignedInt opt_filepad = 0;
+    OFCmdUnsignedInt opt_itempad = 0;
+
+    /* set-up command line parameters and options */
+    OFConsoleApplication app(OFFIS_CONSOLE_APPLICATION, OFFIS_CONSOLE_DESCRIPTION, rcsid);
+    OFCommandLine cmd;
+    cmd.setOptionColumns(LONGCOL, SHORTCOL);
+    cmd.setParamColumn(LONGCOL + SHORTCOL + 4);
+
+    cmd.addParam("jsonfile-in", "JSON input filename to be converted", OFCmdParam::PM_Mandatory);
+    cmd.addParam("dcmfile-out", "DICOM output filename, or filename prefix\nwith --all-datasets", OFCmdParam::PM_Mandatory);
+
+    cmd.addGroup("general options:", LONGCOL, SHORTCOL + 2);
+      cmd.addOption("--help",                  "-h",     "print this help text and exit", OFCommandLine::AF_Exclusive);
+      cmd.addOption("--version",                         "print version information and exit", OFCommandLine::AF_Exclusive);
+      OFLog::addOptions(cmd);
+
+    cmd.addGroup("input options:");
+      cmd.addSubGroup("data sets:");
+        cmd.addOption("--first-dataset",       "-a",     "convert first data set of an array only (default)");
+        cmd.addOption("--all-datasets",        "+a",     "convert all data sets of an array, write\none numbered file per data set");
+      cmd.addSubGroup("bulk data:");
+        cmd.addOption("--bulk-data-dir",       "+B",  1, "[d]irectory: string",
+                                                         "read bulk data of relative and \"file\"\nBulkDataURIs from directory d");
+
+    cmd.addGroup("output options:");
+      cmd.addSubGroup("output file format:");
+        cmd.addOption("--write-file",          "+F",     "write file format (default)");
+        cmd.addOption("--write-dataset",       "-F",     "write data set without file meta information");
+        cmd.addOption("--update-meta-info",    "+Fu",    "update particular file meta information");
+      cmd.addSubGroup("output transfer syntax:");
+        cmd.addOption("--write-xfer-little",   "+te",    "write with explicit VR little endian TS\n(default)");
+        cmd.addOption("--write-xfer-big",      "+tb",    "write with explicit VR big endian TS");
+        cmd.addOption("--write-xfer-implicit", "+ti",    "write with implicit VR little endian TS");
+#ifdef WITH_ZLIB
+        cmd.addOption("--write-xfer-deflated", "+td",    "write with deflated expl. VR little endian TS");
+#endif
+      cmd.addSubGroup("group length encoding:");
+        cmd.addOption("--group-length-recalc", "+g=",    "recalculate group lengths if present (default)");
+        cmd.addOption("--group-length-create", "+g",     "always write with group length elements");
+        cmd.addOption("--group-length-remove", "-g",     "always write without group length elements");
+      cmd.addSubGroup("length encoding in sequences and items:");
+        cmd.addOption("--length-explicit",     "+e",     "write with explicit lengths (default)");
+        cmd.addOption("--length-undefined",    "-e",     "write with undefined lengths");
+      cmd.addSubGroup("data set trailing padding (not with --write-dataset):");
+        cmd.addOption("--padding-off",         "-p",     "no padding (default)");
+        cmd.addOption("--padding-create",      "+p",  2, "[f]ile-pad [i]tem-pad: integer",
+                                                         "align file on multiple of f bytes\nand items on multiple of i bytes");
+#ifdef WITH_ZLIB
+      cmd.addSubGroup("deflate compression level (only with --write-xfer-deflated):");
+        cmd.addOption("--compression-level",   "+cl", 1, "[l]evel: integer (default: 6)",
+                                                         "0=uncompressed, 1=fastest, 9=best compression");
+#endif
+
+    /* evaluate command line */
+    prepareCmdLineArgs(argc, argv, OFFIS_CONSOLE_APPLICATION);
+    if (app.parseCommandLine(cmd, argc, argv))
+    {
+        /* check exclusive options first */
+        if (cmd.hasExclusiveOption())
+        {
+            if (cmd.findOption("--version"))
+            {
+                app.printHeader(OFTrue /*print host identifier*/);
+                COUT << OFendl << "External libraries used:";
+#ifdef WITH_ZLIB
+                COUT << OFendl << "- ZLIB, Version " << zlibVersion() << OFendl;
+#else
+                COUT << " none" << OFendl;
+#endif
+                return 0;
+            }
+        }
+
+        /* general options */
+        OFLog::configureFromCommandLine(cmd, app);
+
+        /* input options */
+
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--first-dataset"))
+            opt_allDatasets = OFFalse;
+        if (cmd.findOption("--all-datasets"))
+            opt_allDatasets = OFTrue;
+        cmd.endOptionBlock();
+
+        if (cmd.findOption("--bulk-data-dir"))
+            app.checkValue(cmd.getValue(opt_bulkDataDir));
+
+        /* output options */
+
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--write-file"))
+            opt_writeMode = EWM_fileformat;
+        if (cmd.findOption("--write-dataset"))
+            opt_writeMode = EWM_dataset;
+        cmd.endOptionBlock();
+
+        if (cmd.findOption("--update-meta-info"))
+        {
+            app.checkConflict("--update-meta-info", "--write-dataset", opt_writeMode == EWM_dataset);
+            opt_writeMode = EWM_updateMeta;
+        }
+
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--write-xfer-little"))
+            opt_xfer = EXS_LittleEndianExplicit;
+        if (cmd.findOption("--write-xfer-big"))
+            opt_xfer = EXS_BigEndianExplicit;
+        if (cmd.findOption("--write-xfer-implicit"))
+            opt_xfer = EXS_LittleEndianImplicit;
+#ifdef WITH_ZLIB
+        if (cmd.findOption("--write-xfer-deflated"))
+            opt_xfer = EXS_DeflatedLittleEndianExplicit;
+#endif
+        cmd.endOptionBlock();
+
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--group-length-recalc"))
+            opt_glenc = EGL_recalcGL;
+        if (cmd.findOption("--group-length-create"))
+            opt_glenc = EGL_withGL;
+        if (cmd.findOption("--group-length-remove"))
+            opt_glenc = EGL_withoutGL;
+        cmd.endOptionBlock();
+
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--length-explicit"))
+            opt_enctype = EET_ExplicitLength;
+        if (cmd.findOption("--length-undefined"))
+            opt_enctype = EET_UndefinedLength;
+        cmd.endOptionBlock();
+
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--padding-off"))
+            opt_padenc = EPD_withoutPadding;
+        if (cmd.findOption("--padding-create"))
+        {
+            app.checkConflict("--padding-create", "--write-dataset", opt_writeMode == EWM_dataset);
+            app.checkValue(cmd.getValueAndCheckMin(opt_filepad, 0));
+            app.checkValue(cmd.getValueAndCheckMin(opt_itempad, 0));
+            opt_padenc = EPD_withPadding;
+        }
+        cmd.endOptionBlock();
+
+#ifdef WITH_ZLIB
+        if (cmd.findOption("--compression-level"))
+        {
+            OFCmdUnsignedInt comprLevel = 0;
+            app.checkDependence("--compression-level", "--write-xfer-deflated", opt_xfer == EXS_DeflatedLittleEndianExplicit);
+            app.checkValue(cmd.getValueAndCheckMinMax(comprLevel, 0, 9));
+            dcmZlibCompressionLevel.set(OFstatic_cast(int, comprLevel));
+        }
+#endif
+    }
+
+    /* print resource identifier */
+    OFLOG_DEBUG(json2dcmLogger, rcsid << OFendl);
+
+    /* make sure data dictionary is loaded */
+    if (!dcmDataDict.isDictionaryLoaded())
+    {
+        OFLOG_WARN(json2dcmLogger, "no data dictionary loaded, check environment variable: "
+            << DCM_DICT_ENVIRONMENT_VARIABLE);
+    }
+
+    OFCondition result = EC_Normal;
+    const char *opt_ifname = NULL;
+    const char *opt_ofname = NULL;
+    cmd.getParam(1, opt_ifname);
+    cmd.getParam(2, opt_ofname);
+
+    /* check filenames */
+    if ((opt_ifname == NULL) || (strlen(opt_ifname) == 0))
+    {
+        OFLOG_ERROR(json2dcmLogger, OFFIS_CONSOLE_APPLICATION << ": invalid input filename: <empty string>");
+        result = EC_IllegalParameter;
+    }
+    if ((opt_ofname == NULL) || (strlen(opt_ofname) == 0))
+    {
+        OFLOG_ERROR(json2dcmLogger, OFFIS_CONSOLE_APPLICATION << ": invalid output filename: <empty string>");
+        result = EC_IllegalParameter;
+    }
+
+    if (result.good())
+    {
+        DcmJsonReader reader;
+        if (opt_bulkDataDir != NULL)
+            reader.setBulkDataDirectory(opt_bulkDataDir);
+        OFLOG_INFO(json2dcmLogger, "reading JSON input file: " << opt_ifname);
+        result = reader.openFile(opt_ifname);
+        if (result.good())
+        {
+            DcmFileFormat fileformat;
+            unsigned long count = 0;
+            /* the data sets are converted one after the other while reading the document */
+            while (result.good())
+            {
+                result = reader.readFileFormat(fileformat);
+                if (result == EC_EndOfStream)
+                {
+                    result = EC_Normal;
+                    if (count == 0)
+                    {
+                        OFLOG_ERROR(json2dcmLogger, "JSON document contains no data set: " << opt_ifname);
+                        result = EC_IllegalCall;
+                    }
+                    break;
+                }
+                if (result.bad())
+                    OFLOG_ERROR(json2dcmLogger, result.text() << ": reading file: " << opt_ifname);
+                else if (opt_allDatasets)
+                {
+                    char suffix[20];
+                    OFStandard::snprintf(suffix, sizeof(suffix), "%04lu.dcm", count);
+                    result = writeFile(fileformat, OFString(opt_ofname) + suffix, opt_xfer, opt_enctype,
+                        opt_glenc, opt_padenc, opt_filepad, opt_itempad, opt_writeMode);
+                }
+                else if (count == 0)
+                {
+                    result = writeFile(fileformat, opt_ofname, opt_xfer, opt_enctype,
+                        opt_glenc, opt_padenc, opt_filepad, opt_itempad, opt_writeMode);
+                }
+                else
+                {
+                    OFLOG_WARN(json2dcmLogger, "JSON document contains more than one data set, ignoring all but the first one"
+                        << " (use --all-datasets to convert all)");
+                    break;
+                }
+                ++count;
+            }
+        }
+    }
+
+    return result.status();
+}
@@ -0,0 +1,179 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: memory arena for DcmObject trees
+ *
+ */
+
+#ifndef DCARENA_H
+#define DCARENA_H
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/ofvector.h"     /* for class OFVector */
+#include "dcmtk/ofstd/ofthread.h"     /* for class OFMutex */
+#include "dcmtk/dcmdata/dcdefine.h"   /* for DCMTK_DCMDATA_EXPORT */
+
+/// default size of the memory chunks allocated by class DcmMemoryArena, in bytes
+#define DcmMemoryArenaChunkSize 65536
+
+
+/** a memory arena from which the objects of a DcmObject tree (data elements,
+ *  items, sequences and list nodes) can be allocated. Memory is taken from
+ *  large chunks by incrementing a pointer, and is not returned to the heap
+ *  when an individual object is deleted. Instead, all chunks are reused once
+ *  every object allocated from the arena has been deleted, and are freed in
+ *  one go when all references to the arena have been released and the last
+ *  object has been deleted. This avoids most heap operations when reading and
+ *  deleting large datasets and prevents heap fragmentation.
+ *
+ *  Objects allocated from an arena may safely be removed from their dataset
+ *  and live longer than the owner of the arena, since the arena counts the
+ *  objects that are still alive. A typical owner is class DcmDataset, see
+ *  DcmDataset::enableMemoryArena(). Class DcmList also holds a reference to
+ *  the arena from which its nodes are allocated.
+ *
+ *  The chunks of all arenas are registered in a global table, so that
+ *  deallocate() can find the arena a block was taken from without storing
+ *  anything in front of the block. Blocks allocated from the heap are passed
+ *  to the global operators new and delete unchanged.
+ */
+class DCMTK_DCMDATA_EXPORT DcmMemoryArena
+{
+public:
+
+  /** constructor. The creator of the arena holds the first reference to it
+   *  and must call release() instead of deleting the arena.
+   *  @param chunkSize size of the memory chunks to be allocated, in bytes
+   */
+  DcmMemoryArena(const size_t chunkSize = DcmMemoryArenaChunkSize);
+
+  /** adds a reference to the arena, which keeps the arena alive until
+   *  release() is called, even if no object allocated from it is left
+   */
+  void addReference();
+
+  /** releases a reference to the arena. The arena is deleted as soon as all
+   *  references have been released and all objects allocated from it have
+   *  been deleted, possibly immediately. The caller must not use the arena
+   *  after this call.
+   */
+  void release();
+
+  /** allocates a memory block for an object
+   *  @param size size of the block in bytes
+   *  @param arena arena from which the block is allocated, NULL for the heap
+   *  @return pointer to the block, never NULL
+   */
+  static void *allocate(const size_t size,
+                        DcmMemoryArena *arena);
+
+  /** deallocates a memory block that was returned by allocate()
+   *  @param ptr pointer to the block, may be NULL
+   */
+  static void deallocate(void *ptr);
+
+  /** returns the number of blocks allocated from this arena so far
+   *  @return number of allocations
+   */
+  size_t getNumberOfAllocations() const;
+
+  /** returns the number of blocks allocated from this arena that have
+   *  not been deallocated yet
+   *  @return number of live objects
+   */
+  size_t getNumberOfLiveObjects() const;
+
+  /** returns the number of memory chunks currently held by this arena,
+   *  i.e.\ the number of heap allocations performed by this arena
+   *  @return number of chunks
+   */
+  size_t getNumberOfChunks() const;
+
+private:
+
+  /// private destructor, see release()
+  ~DcmMemoryArena();
+
+  /// private undefined copy constructor
+  DcmMemoryArena(const DcmMemoryArena&);
+
+  /// private undefined copy assignment operator
+  DcmMemoryArena& operator=(const DcmMemoryArena&);
+
+  /** allocates a block from the chunks of this arena
+   *  @param size size of the block in bytes
+   *  @return pointer to the block
+   */
+  void *allocateBlock(size_t size);
+
+  /** marks a block of this arena as deallocated. Deletes the arena if all
+   *  references have been released and this was the last live block.
+   */
+  void deallocateBlock();
+
+  /** allocates a new chunk and adds it to the global table of chunks
+   *  @param size size of the chunk in bytes
+   *  @return pointer to the chunk
+   */
+  Uint8 *allocateChunk(size_t size);
+
+  /** removes a chunk from the global table of chunks and frees it
+   *  @param chunk pointer to the chunk
+   */
+  static void freeChunk(Uint8 *chunk);
+
+  /** looks up the arena that owns the chunk containing the given block
+   *  @param ptr pointer to the block
+   *  @return arena that owns the block, NULL if it was allocated from the heap
+   */
+  static DcmMemoryArena *findArena(const void *ptr);
+
+  /// frees all chunks for blocks that are larger than the chunk size
+  void freeLargeChunks();
+
+  /// size of the regular chunks in bytes
+  size_t chunkSize_;
+
+  /// regular chunks, all of size chunkSize_
+  OFVector<Uint8 *> chunks_;
+
+  /// chunks that hold a single block larger than the chunk size
+  OFVector<Uint8 *> largeChunks_;
+
+  /// index of the chunk from which the next block is allocated
+  size_t currentChunk_;
+
+  /// offset of the next block within the current chunk
+  size_t offset_;
+
+  /// number of blocks allocated so far
+  size_t allocations_;
+
+  /// number of blocks not yet deallocated
+  size_t liveObjects_;
+
+  /// number of references to the arena
+  size_t references_;
+
+#ifdef WITH_THREADS
+  /// mutex protecting the arena, since objects may be deleted by any thread
+  OFMutex mutex_;
+#endif
+};
+
+#endif
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2023, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -27,6 +27,8 @@
 #include "dcmtk/dcmdata/dctypes.h"
 #include "dcmtk/dcmdata/dcxfer.h"
 #include "dcmtk/ofstd/oflist.h"
+#include "dcmtk/ofstd/ofglobal.h"
+#include "dcmtk/ofstd/ofvector.h"
 
 class DcmStack;
 class DcmRepresentationParameter;
@@ -35,6 +37,22 @@ class DcmPolymorphOBOW;
 class DcmItem;
 class DcmTagKey;
 
+/** This flag defines the number of threads used by the decoders for
+ *  encapsulated transfer syntaxes (RLE, JPEG, JPEG-LS) when decompressing a
+ *  multi-frame image as a whole, e.g.\ in DcmPixelData::chooseRepresentation().
+ *  If set to a value larger than 1, the frames are decompressed concurrently
+ *  into their final location within the uncompressed pixel data, provided
+ *  that the fragments of each frame can be determined without decompressing
+ *  the preceding frames (i.e.\ one fragment per frame or a valid basic offset
+ *  table). The RLE decoder processes all frames in parallel. The JPEG and
+ *  JPEG-LS decoders decompress the first frame sequentially, since it
+ *  determines the color model and planar configuration of the uncompressed
+ *  image, and the remaining frames in parallel. Otherwise, or if DCMTK was
+ *  compiled without thread support, all frames are decompressed
+ *  sequentially. Default is 1 (sequential).
+ */
+extern DCMTK_DCMDATA_EXPORT OFGlobal<Uint32> dcmDecompressionThreads; /* default 1 */
+
 /** abstract base class for a codec parameter object that
  *  describes the settings (modes of operations) for one
  *  particular codec (DcmCodec) object.
@@ -65,6 +83,210 @@ public:
 };
 
 
+/** abstract base class for a task that decompresses individual frames of
+ *  a multi-frame image. Used by DcmCodec::decompressFrames() to decompress
+ *  a range of frames in parallel. Each call of decompressFrame() must only
+ *  access data that is not shared with other frames, i.e.\ the compressed
+ *  fragments and the output buffer of the given frame, and the per-thread
+ *  state identified by the thread number.
+ */
+class DCMTK_DCMDATA_EXPORT DcmFrameDecompressionTask
+{
+public:
+    /// default constructor
+    DcmFrameDecompressionTask() {}
+
+    /// destructor
+    virtual ~DcmFrameDecompressionTask() {}
+
+    /** decompresses a single frame.
+     *  @param frameNo number of the frame, starting with 0 for the first frame
+     *  @param threadNo number of the calling thread, starting with 0. Frames
+     *    decompressed with the same thread number are never processed
+     *    concurrently, so this number can be used to select a decoder instance.
+     *  @return EC_Normal if successful, an error code otherwise.
+     */
+    virtual OFCondition decompressFrame(Uint32 frameNo, Uint32 threadNo) = 0;
+
+private:
+
+    /// private undefined copy constructor
+    DcmFrameDecompressionTask(const DcmFrameDecompressionTask&);
+
+    /// private undefined copy assignment operator
+    DcmFrameDecompressionTask& operator=(const DcmFrameDecompressionTask&);
+};
+
+
+/** base class for a task that decompresses the frames of an encapsulated
+ *  multi-frame image, used by the RLE, JPEG and JPEG-LS decoders. The
+ *  fragments of each frame have to be determined in advance, see
+ *  DcmCodec::determineFrameFragments() and DcmCodec::getFragmentData().
+ *  This class checks the frame, thread and fragment numbers and determines
+ *  the output buffer of each frame. Derived classes only implement the codec
+ *  specific decompression of the fragments of a single frame.
+ */
+class DCMTK_DCMDATA_EXPORT DcmEncapsulatedFrameDecompressionTask: public DcmFrameDecompressionTask
+{
+public:
+    /** constructor
+     *  @param fragmentData pointers to the content of all fragments
+     *  @param fragmentLength lengths of all fragments
+     *  @param startFragments index of the first fragment of each frame, followed
+     *    by the index of the fragment following the last frame. May be empty if
+     *    decompressFrame() is not used.
+     *  @param imageData8 pointer to the uncompressed pixel data of all frames
+     *  @param frameSize size of an uncompressed frame in bytes
+     *  @param numberOfThreads number of threads that will use this object
+     */
+    DcmEncapsulatedFrameDecompressionTask(
+      const OFVector<Uint8 *>& fragmentData,
+      const OFVector<Uint32>& fragmentLength,
+      const OFVector<Uint32>& startFragments,
+      Uint8 *imageData8,
+      Uint32 frameSize,
+      Uint32 numberOfThreads);
+
+    /// destructor
+    virtual ~DcmEncapsulatedFrameDecompressionTask();
+
+    /** decompresses a single frame, using the fragments determined by
+     *  DcmCodec::determineFrameFragments().
+     *  @param frameNo number of the frame, starting with 0 for the first frame
+     *  @param threadNo number of the calling thread, starting with 0
+     *  @return EC_Normal if successful, an error code otherwise.
+     */
+    virtual OFCondition decompressFrame(Uint32 frameNo, Uint32 threadNo);
+
+    /** decompresses a single frame starting with the given fragment. Can be used
+     *  for sequential decompression if the fragments of the frames are not known
+     *  in advance.
+     *  @param frameNo number of the frame, starting with 0 for the first frame
+     *  @param threadNo number of the calling thread, starting with 0
+     *  @param currentItem index of the first fragment of the frame. Upon return,
+     *    contains the index of the fragment following the last one used.
+     *  @param endItem index of the fragment following the last one that may be used
+     *  @return EC_Normal if successful, an error code otherwise.
+     */
+    OFCondition decompressFrameAt(Uint32 frameNo, Uint32 threadNo, Uint32& currentItem, Uint32 endItem);
+
+protected:
+
+    /** decompresses a single frame into the given buffer. Implemented by the
+     *  codec specific derived classes. Fragments are accessed with getFragment().
+     *  @param frameNo number of the frame, starting with 0 for the first frame
+     *  @param threadNo number of the calling thread, starting with 0. Always
+     *    less than the number of threads passed to the constructor.
+     *  @param currentItem index of the first fragment of the frame. Upon return,
+     *    contains the index of the fragment following the last one used.
+     *  @param endItem index of the fragment following the last one that may be
+     *    used, never larger than the number of fragments
+     *  @param frameData pointer to the uncompressed pixel data of this frame
+     *  @return EC_Normal if successful, an error code otherwise.
+     */
+    virtual OFCondition decodeFrame(
+      Uint32 frameNo,
+      Uint32 threadNo,
+      Uint32& currentItem,
+      Uint32 endItem,
+      Uint8 *frameData) = 0;
+
+    /** access the next fragment of a frame
+     *  @param currentItem index of the fragment, incremented upon success
+     *  @param endItem index of the fragment following the last one that may be used
+     *  @param data pointer to the content of the fragment returned in this parameter,
+     *    may be NULL if the fragment is empty
+     *  @param length length of the fragment returned in this parameter
+     *  @return EC_Normal if successful, EC_CorruptedData if there is no further
+     *    fragment for this frame
+     */
+    OFCondition getFragment(Uint32& currentItem, Uint32 endItem, Uint8 *& data, Uint32& length) const;
+
+    /** get size of an uncompressed frame
+     *  @return size of an uncompressed frame in bytes
+     */
+    Uint32 getFrameSize() const { return frameSize_; }
+
+private:
+
+    /// private undefined copy constructor
+    DcmEncapsulatedFrameDecompressionTask(const DcmEncapsulatedFrameDecompressionTask&);
+
+    /// private undefined copy assignment operator
+    DcmEncapsulatedFrameDecompressionTask& operator=(const DcmEncapsulatedFrameDecompressionTask&);
+
+    /// pointers to the content of all fragments
+    const OFVector<Uint8 *>& fragmentData_;
+
+    /// lengths of all fragments
+    const OFVector<Uint32>& fragmentLength_;
+
+    /// index of the first fragment of each frame
+    const OFVector<Uint32>& startFragments_;
+
+    /// pointer to the uncompressed pixel data of all frames
+    Uint8 *imageData8_;
+
+    /// size of an uncompressed frame in bytes
+    Uint32 frameSize_;
+
+    /// number of threads that use this object
+    Uint32 numberOfThreads_;
+};
+
+
+/** abstract base class for a task that compresses individual frames of
+ *  a multi-frame image. Used by DcmCodec::compressFrames() to compress
+ *  a range of frames in parallel. Processing of each frame consists of
+ *  three steps: prepareFrame() and storeFrame() are always called from
+ *  the thread that called DcmCodec::compressFrames(), in ascending order
+ *  of frame numbers, whereas compressFrame() may be called concurrently
+ *  for different frames and must only access data that is not shared
+ *  with other frames.
+ */
+class DCMTK_DCMDATA_EXPORT DcmFrameCompressionTask
+{
+public:
+    /// default constructor
+    DcmFrameCompressionTask() {}
+
+    /// destructor
+    virtual ~DcmFrameCompressionTask() {}
+
+    /** prepares the compression of a single frame, e.g.\ by rendering the
+     *  frame into a buffer that is owned by this frame. The default
+     *  implementation does nothing.
+     *  @param frameNo number of the frame, starting with 0 for the first frame
+     *  @return EC_Normal if successful, an error code otherwise.
+     */
+    virtual OFCondition prepareFrame(Uint32 /* frameNo */) { return EC_Normal; }
+
+    /** compresses a single frame.
+     *  @param frameNo number of the frame, starting with 0 for the first frame
+     *  @param threadNo number of the calling thread, starting with 0. Frames
+     *    compressed with the same thread number are never processed
+     *    concurrently, so this number can be used to select an encoder instance.
+     *  @return EC_Normal if successful, an error code otherwise.
+     */
+    virtual OFCondition compressFrame(Uint32 frameNo, Uint32 threadNo) = 0;
+
+    /** stores a compressed frame, e.g.\ in a pixel sequence, and releases
+     *  all memory associated with this frame.
+     *  @param frameNo number of the frame, starting with 0 for the first frame
+     *  @return EC_Normal if successful, an error code otherwise.
+     */
+    virtual OFCondition storeFrame(Uint32 frameNo) = 0;
+
+private:
+
+    /// private undefined copy constructor
+    DcmFrameCompressionTask(const DcmFrameCompressionTask&);
+
+    /// private undefined copy assignment operator
+    DcmFrameCompressionTask& operator=(const DcmFrameCompressionTask&);
+};
+
+
 /** abstract base class for a codec object that can be registered
  *  in dcmdata and performs transfer syntax transformation (i.e.
  *  compressing, decompressing or transcoding between different
@@ -305,6 +527,88 @@ public:
     Sint32 numberOfFrames,
     DcmPixelSequence * fromPixSeq,
     Uint32& currentItem);
+
+  /** determine the index numbers of the first compressed pixel data fragment
+   *  of all frames of an image at once. This only succeeds if the fragments can
+   *  be assigned to the frames without decompressing the image, i.e.\ if there
+   *  is exactly one fragment per frame or if the basic offset table is valid.
+   *  @param numberOfFrames number of frames of this image
+   *  @param fromPixSeq compressed pixel sequence
+   *  @param startFragments upon success, contains numberOfFrames + 1 entries:
+   *    the index of the first fragment of each frame, followed by the number
+   *    of fragments (i.e.\ the end of the last frame)
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  static OFCondition determineFrameFragments(
+    Uint32 numberOfFrames,
+    DcmPixelSequence *fromPixSeq,
+    OFVector<Uint32>& startFragments);
+
+  /** retrieve pointers to the content of all compressed pixel data fragments.
+   *  The content of each fragment is loaded into memory if necessary, so that
+   *  the returned pointers can safely be accessed from multiple threads as long
+   *  as the pixel sequence is not modified.
+   *  @param fromPixSeq compressed pixel sequence
+   *  @param fragmentData upon success, contains a pointer to the content of
+   *    each fragment (including the basic offset table at index 0)
+   *  @param fragmentLength upon success, contains the length of each fragment
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  static OFCondition getFragmentData(
+    DcmPixelSequence *fromPixSeq,
+    OFVector<Uint8 *>& fragmentData,
+    OFVector<Uint32>& fragmentLength);
+
+  /** determine the number of threads to be used for decompressing the given
+   *  number of frames, based on the global flag dcmDecompressionThreads.
+   *  @param numberOfFrames number of frames to be decompressed
+   *  @return number of threads, 1 for sequential decompression
+   */
+  static Uint32 getDecompressionThreadCount(Uint32 numberOfFrames);
+
+  /** decompress a range of frames using the given number of threads.
+   *  Each thread fetches the next frame that has not yet been processed
+   *  and calls DcmFrameDecompressionTask::decompressFrame() for it. If
+   *  decompression of a frame fails, no further frames are started.
+   *  @param task task that decompresses a single frame
+   *  @param firstFrame number of the first frame to be decompressed
+   *  @param numberOfFrames number of frames to be decompressed
+   *  @param numberOfThreads number of threads. If 1 or if DCMTK was compiled
+   *    without thread support, all frames are decompressed by the calling thread.
+   *  @return EC_Normal if successful, the error code of the first frame
+   *    that could not be decompressed otherwise
+   */
+  static OFCondition decompressFrames(
+    DcmFrameDecompressionTask& task,
+    Uint32 firstFrame,
+    Uint32 numberOfFrames,
+    Uint32 numberOfThreads);
+
+  /** determine the number of threads to be used for compressing the given
+   *  number of frames, i.e.\ the number of encoder instances needed.
+   *  @param numberOfThreads number of threads requested, e.g.\ by a codec parameter
+   *  @param numberOfFrames number of frames to be compressed
+   *  @return number of threads, 1 for sequential compression
+   */
+  static Uint32 getCompressionThreadCount(Uint32 numberOfThreads, Uint32 numberOfFrames);
+
+  /** compress all frames of an image using the given number of threads.
+   *  The frames are processed in batches of a few frames per thread: all
+   *  frames of a batch are prepared (sequentially), then compressed (in
+   *  parallel) and finally stored (sequentially, in ascending order).
+   *  This limits the amount of memory needed for intermediate results.
+   *  Processing stops at the first error.
+   *  @param task task that compresses a single frame
+   *  @param numberOfFrames number of frames to be compressed
+   *  @param numberOfThreads number of threads. If 1 or if DCMTK was compiled
+   *    without thread support, all frames are processed one after the other
+   *    by the calling thread.
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  static OFCondition compressFrames(
+    DcmFrameCompressionTask& task,
+    Uint32 numberOfFrames,
+    Uint32 numberOfThreads);
 };
 
 
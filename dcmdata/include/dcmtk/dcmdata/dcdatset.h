@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2020, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -94,6 +94,23 @@ class DCMTK_DCMDATA_EXPORT DcmDataset
      */
     virtual OFCondition clear();
 
+    /** enable or disable the memory arena of this dataset. If enabled, the
+     *  data elements, items and sequences created when reading this dataset
+     *  (e.g.\ by DcmFileFormat::loadFile()) are allocated from a memory arena
+     *  owned by this dataset instead of individually from the heap, which
+     *  speeds up reading and deleting large datasets with many small elements.
+     *  Objects read before this call are not affected. The arena is not copied
+     *  with the dataset. Objects removed from the dataset remain valid.
+     *  @param enable enable memory arena if OFTrue, disable otherwise
+     */
+    void enableMemoryArena(const OFBool enable = OFTrue);
+
+    /** get the memory arena from which the objects read into this dataset are
+     *  allocated, see enableMemoryArena()
+     *  @return pointer to the memory arena, NULL if objects are allocated from the heap
+     */
+    virtual DcmMemoryArena *getMemoryArena() const;
+
     /** remove all elements with an invalid group number, i.e. 0x0000 to 0x0003,
      *  0x0005, 0x0007 and 0xFFFF in case of a data set.  For sequence items, also
      *  group 0x0006 is disallowed.  For command sets, only group 0x0000 is allowed,
@@ -320,6 +337,28 @@ class DCMTK_DCMDATA_EXPORT DcmDataset
                                  const Uint32 maxReadLength = DCM_MaxReadLength,
                                  const DcmTagKey &stopParsingAtElement = DCM_UndefinedTagKey);
 
+    /** load only the selected attributes from a DICOM file. All other attributes
+     *  are skipped in the file and not created as DcmElement objects, which is much
+     *  faster for files with large sequences that are not needed.
+     *  This method only supports DICOM objects stored as a dataset, i.e. without meta header.
+     *  Use DcmFileFormat::loadFileSelective() to load files with meta header.
+     *  @param fileName name of the file to load (may contain wide chars if support enabled).
+     *    Since there are various constructors for the OFFilename class, a "char *", "OFString"
+     *    or "wchar_t *" can also be passed directly to this parameter.
+     *  @param selection attributes to be read, see class DcmTagSelection for details
+     *  @param readXfer transfer syntax used to read the data (auto detection if EXS_Unknown)
+     *  @param groupLength flag, specifying how to handle the group length tags
+     *  @param maxReadLength maximum number of bytes to be read for an element value.
+     *    Element values with a larger size are not loaded until their value is retrieved
+     *    (with getXXX()) or loadAllDataIntoMemory() is called.
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition loadFileSelective(const OFFilename &fileName,
+                                 const DcmTagSelection &selection,
+                                 const E_TransferSyntax readXfer = EXS_Unknown,
+                                 const E_GrpLenEncoding groupLength = EGL_noChange,
+                                 const Uint32 maxReadLength = DCM_MaxReadLength);
+
     /** save object to a DICOM file.
      *  This method only supports DICOM objects stored as a dataset, i.e. without meta header.
      *  Use DcmFileFormat::saveFile() to save files with meta header.
@@ -397,6 +436,8 @@ class DCMTK_DCMDATA_EXPORT DcmDataset
     E_TransferSyntax OriginalXfer;
     /// current transfer syntax of the dataset
     E_TransferSyntax CurrentXfer;
+    /// memory arena owned by this dataset, NULL if not enabled
+    DcmMemoryArena *MemoryArena;
 };
 
 
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2023, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -26,6 +26,8 @@
 #include "dcmtk/config/osconfig.h"
 
 #include "dcmtk/dcmdata/dcdicdir.h"
+#include "dcmtk/ofstd/oflist.h"
+
 
 
 /*------------------------------------*
@@ -38,6 +40,10 @@
 #define DEFAULT_DESCRIPTOR_CHARSET "ISO_IR 100"
 
 
+// forward declarations
+class DicomDirLoadThread;
+
+
 /*----------------------*
  *  class declarations  *
  *----------------------*/
@@ -250,6 +256,24 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
     OFCondition writeDicomDir(const E_EncodingType encodingType = EET_UndefinedLength,
                               const E_GrpLenEncoding groupLength = EGL_withoutGL);
 
+    /** write the current DICOMDIR object to file by appending the new records only.
+     *  Unlike writeDicomDir(), the existing DICOMDIR file is not rewritten completely
+     *  but the directory records that have been added since the file was read (or last
+     *  written) are appended to it, and only the offsets that refer to the new records
+     *  are updated in place (see DcmDicomDir::writeIncremental() for details).  This
+     *  is much faster for large DICOMDIRs, especially if files are added one at a time
+     *  by calling addDicomFile() and this method repeatedly for the same object, which
+     *  avoids reading the DICOMDIR again for each file.
+     *  If existing records might have been modified, i.e. when updating a DICOMDIR
+     *  (see updateDicomDir()) or when the "invent" modes are enabled, or if the file
+     *  cannot be updated in place, the complete file is written as by writeDicomDir().
+     *  @param encodingType flag, specifying the encoding with undefined or explicit length
+     *  @param groupLength flag, specifying how to handle the group length tags
+     *  @return EC_Normal upon success, an error code otherwise
+     */
+    OFCondition writeDicomDirIncremental(const E_EncodingType encodingType = EET_UndefinedLength,
+                                         const E_GrpLenEncoding groupLength = EGL_withoutGL);
+
     /** check whether specified filename is valid. i.e. conforms to the DICOM standard
      *  requirements (length, number of components and proper characters).  This function
      *  is called automatically for the following methods: checkDicomFile(), addDicomFile()
@@ -301,6 +325,29 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
     OFCondition addDicomFile(const OFFilename &filename,
                              const OFFilename &directory = OFFilename());
 
+    /** add the specified DICOM files to the current DICOMDIR.
+     *  This method is equivalent to calling addDicomFile() for each file of the list.
+     *  However, if more than one thread is selected (see setNumberOfThreads()), the
+     *  files are loaded and checked by multiple threads in parallel.  The directory
+     *  records are still created one after the other and in the order of the list,
+     *  so the resulting DICOMDIR does not depend on the number of threads.
+     *  Please note that the pixel data is only loaded if icon images are created from
+     *  the DICOM files (see enableIconImageMode() and addImageSupport()).
+     *  @param filenames names of the DICOM files to be added
+     *  @param directory directory where the DICOM files are stored (optional),
+     *    see addDicomFile()
+     *  @param badFiles names of the files that could not be added are appended to
+     *    this list
+     *  @param goodFiles returns the number of files that have been added successfully
+     *  @return EC_Normal upon success (even if some files could not be added), an error
+     *    code if the "abort on first error" mode is enabled and a file could not be
+     *    added (see enableAbortMode()) or if no DICOMDIR object exists
+     */
+    OFCondition addDicomFiles(const OFList<OFFilename> &filenames,
+                              const OFFilename &directory,
+                              OFList<OFFilename> &badFiles,
+                              size_t &goodFiles);
+
     /** set the file-set descriptor file ID and character set.
      *  Prior to any internal modification both 'filename' and 'charset' are checked
      *  using the above checking routines.  Existence of 'filename' is not checked.
@@ -332,6 +379,14 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
      */
     OFCondition setIconPrefix(const OFFilename &prefix);
 
+    /** set number of threads used by addDicomFiles() for loading and checking the
+     *  DICOM files.  Multiple threads are only supported if DCMTK has been compiled
+     *  with thread support.
+     *  @param threads number of threads (1..256, initial: 1)
+     *  @return EC_Normal upon success, an error code otherwise
+     */
+    OFCondition setNumberOfThreads(const unsigned int threads);
+
     /** set filename of default icon image.
      *  For cases that the icon image cannot be created (neither from PGM nor from
      *  DICOM file, respectively) a default icon (8 bit binary PGM) can be specified.
@@ -395,6 +450,15 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
         return IconImageMode;
     }
 
+    /** get number of threads used by addDicomFiles().
+     *  See setNumberOfThreads() for more details.
+     *  @return number of threads
+     */
+    unsigned int numberOfThreads() const
+    {
+        return NumberOfThreads;
+    }
+
     /** get current status of the "create backup" mode.
      *  See disableBackupMode() for more details.
      *  @return OFTrue if mode is enabled, OFFalse otherwise
@@ -614,6 +678,23 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
                                       DcmFileFormat &fileformat,
                                       const OFBool checkFilename = OFTrue);
 
+    /** check whether the pixel data of the DICOM files has to be loaded, i.e.\ whether
+     *  icon images are created from the image data
+     *  @return OFTrue if pixel data is needed, OFFalse otherwise
+     */
+    OFBool isPixelDataRequired() const;
+
+    /** add the directory records for a DICOM file that has already been loaded and
+     *  checked with loadAndCheckDicomFile() to the current DICOMDIR
+     *  @param filename name of the DICOM file to be added
+     *  @param directory directory where the DICOM file is stored
+     *  @param fileformat object in which the loaded data is stored
+     *  @return EC_Normal upon success, an error code otherwise
+     */
+    OFCondition addDicomFileRecords(const OFFilename &filename,
+                                    const OFFilename &directory,
+                                    DcmFileFormat &fileformat);
+
     /** check SOP class and transfer syntax for compliance with current profile
      *  @param metainfo object where the DICOM file meta information is stored
      *  @param dataset object where the DICOM dataset is stored
@@ -1623,6 +1704,9 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
     /// filename of the default icon (if any)
     OFFilename DefaultIcon;
 
+    /// number of threads used for loading and checking DICOM files
+    unsigned int NumberOfThreads;
+
     /// flag indicating whether RLE decompression is supported
     OFBool RLESupport;
     /// flag indicating whether JPEG decompression is supported
@@ -1650,6 +1734,9 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
 
     /// private undefined assignment operator
     DicomDirInterface &operator=(const DicomDirInterface &obj);
+
+    // the load threads call loadAndCheckDicomFile()
+    friend class DicomDirLoadThread;
 };
 
 
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2019, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -123,6 +123,27 @@ public:
       const E_EncodingType enctype = EET_UndefinedLength,
       const E_GrpLenEncoding glenc = EGL_withoutGL );
 
+    /** writes DICOMDIR to file by appending the directory records that have been
+     *  added since the file was read or last written, instead of writing the complete
+     *  file again. The new records are stored at the end of the Directory Record
+     *  Sequence, and the offsets of existing records that refer to them (as well as the
+     *  offsets of the first and last root record and the length of the sequence) are
+     *  updated in place. All other parts of the existing file remain unchanged, so
+     *  existing records must not have been modified in any other way.
+     *  If the file cannot be updated in this way, e.g. because it does not exist yet,
+     *  because multi-referenced file records are present, or because its header
+     *  differs from the current dataset, the complete file is written using write().
+     *  Please note that, unlike write(), this method does not use a temporary file,
+     *  i.e. the existing file is modified directly.
+     *  @param enctype encoding type for sequences (used for the new records only)
+     *  @param glenc encoding type for group lengths (EGL_withGL always results in the
+     *    complete file being written)
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition writeIncremental(
+      const E_EncodingType enctype = EET_UndefinedLength,
+      const E_GrpLenEncoding glenc = EGL_withoutGL );
+
     /** check the currently stored element value
      *  @param autocorrect correct value length if OFTrue
      *  @return status, EC_Normal if value length is correct, an error code otherwise
@@ -186,6 +207,11 @@ public:
                                      E_GrpLenEncoding glenc,        // in
                                      DcmSequenceOfItems &unresRecs);// inout
 
+    // append new records to the existing file, see writeIncremental().
+    // Returns EC_IllegalCall if this is not possible and the file is unchanged.
+    OFCondition appendNewRecords(    E_EncodingType enctype,        // in
+                                     E_GrpLenEncoding glenc );      // in
+
   private:
 
     /// private undefined copy assignment operator
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2023, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -49,6 +49,41 @@ enum DcmDictRangeRestriction
 };
 
 
+/** plain data structure describing an entry of the builtin data dictionary.
+ *  Arrays of this structure are generated by mkdictbi as constant data. The
+ *  DcmDictEntry object for an entry of the static part of the builtin
+ *  dictionary is only created when the entry is accessed for the first
+ *  time, see DcmBuiltinDictEntryStorage.
+ */
+struct DcmBuiltinDictEntry
+{
+    /// lower limit of group number
+    Uint16 group;
+    /// lower limit of element number
+    Uint16 element;
+    /// upper limit of group number
+    Uint16 upperGroup;
+    /// upper limit of element number
+    Uint16 upperElement;
+    /// value representation
+    DcmEVR evr;
+    /// attribute name
+    const char* tagName;
+    /// lower limit for VM
+    int vmMin;
+    /// upper limit for VM
+    int vmMax;
+    /// standard version name, may be NULL
+    const char* standardVersion;
+    /// restriction (even, odd, unrestricted) for group range
+    DcmDictRangeRestriction groupRestriction;
+    /// restriction (even, odd, unrestricted) for element range
+    DcmDictRangeRestriction elementRestriction;
+    /// private creator name, may be NULL
+    const char* privateCreator;
+};
+
+
 /** each object of this class manages one entry of the
  *  global DICOM data dictionary.
  */
@@ -405,4 +440,34 @@ private:
     const char *privateCreator;
 };
 
+
+/** uninitialized storage for the DcmDictEntry object of an entry of the
+ *  static part of the builtin data dictionary. mkdictbi generates a
+ *  zero-initialized array of this structure next to the constant table of
+ *  DcmBuiltinDictEntry data, so loading the builtin dictionary neither
+ *  allocates memory nor runs any code per entry. The entry is constructed
+ *  in place when it is accessed for the first time and is never destroyed.
+ */
+struct DCMTK_DCMDATA_EXPORT DcmBuiltinDictEntryStorage
+{
+    /** returns the dictionary entry stored here, constructs it from the given
+     *  data if this has not been done yet. This method is thread-safe.
+     *  @param data constant data of the entry, must remain valid as long as
+     *    the program runs
+     *  @return pointer to the dictionary entry, never NULL
+     */
+    const DcmDictEntry *get(const DcmBuiltinDictEntry& data);
+
+    /// nonzero if the entry has been constructed, accessed atomically
+    int constructed;
+
+    /// storage for the entry, the other members only ensure the alignment
+    union
+    {
+        char data[sizeof(DcmDictEntry)];
+        void *alignPointer;
+        double alignDouble;
+    } entry;
+};
+
 #endif /* !DCDICENT_H */
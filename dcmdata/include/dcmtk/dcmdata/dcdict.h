@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2023, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -27,6 +27,7 @@
 
 #include "dcmtk/ofstd/ofthread.h"
 #include "dcmtk/dcmdata/dchashdi.h"
+#include "dcmtk/dcmdata/dcdicent.h"
 
 /// maximum length of a line in the loadable DICOM dictionary
 #define DCM_MAXDICTLINESIZE     2048
@@ -74,6 +75,12 @@ public:
      */
     DcmDataDictionary(OFBool loadBuiltin, OFBool loadExternal);
 
+    /** copy constructor, creates a deep copy of the given dictionary
+     *  (including the skeleton entries).
+     *  @param other the dictionary to be copied
+     */
+    DcmDataDictionary(const DcmDataDictionary &other);
+
     /// destructor
     ~DcmDataDictionary();
 
@@ -82,8 +89,11 @@ public:
      */
     OFBool isDictionaryLoaded() const { return dictionaryLoaded; }
 
-    /// returns the number of normal (non-repeating) tag entries
-    int numberOfNormalTagEntries() const { return hashDict.size(); }
+    /** returns the number of normal (non-repeating) tag entries, including the
+     *  entries of the static part of the builtin dictionary that are not
+     *  overridden by other entries with the same tag key
+     */
+    int numberOfNormalTagEntries() const;
 
     /// returns the number of repeating tag entries
     int numberOfRepeatingTagEntries() const { return OFstatic_cast(int, repDict.size()); }
@@ -150,11 +160,17 @@ public:
 
     /* Iterators to access the normal and the repeating entries */
 
-    /// returns an iterator to the start of the normal (non-repeating) dictionary
-    DcmHashDictIterator normalBegin() { return hashDict.begin(); }
+    /** returns an iterator to the start of the normal (non-repeating) dictionary.
+     *  The iterator first traverses the entries of the static part of the
+     *  builtin dictionary (except for those overridden by other entries),
+     *  followed by the entries of the hash dictionary.
+     */
+    DcmHashDictIterator normalBegin()
+        { return DcmHashDictIterator(&hashDict, builtinEntries, builtinStorage, builtinCount); }
 
     /// returns an iterator to the end of the normal (non-repeating) dictionary
-    DcmHashDictIterator normalEnd() { return hashDict.end(); }
+    DcmHashDictIterator normalEnd()
+        { return DcmHashDictIterator(&hashDict, builtinEntries, builtinStorage, builtinCount, OFTrue); }
 
     /// returns an iterator to the start of the repeating tag dictionary
     DcmDictEntryListIterator repeatingBegin() { return repDict.begin(); }
@@ -162,16 +178,30 @@ public:
     /// returns an iterator to the end of the repeating tag dictionary
     DcmDictEntryListIterator repeatingEnd() { return repDict.end(); }
 
+    /** computes the hash value used for the static perfect hash table of the
+     *  builtin dictionary. This function is used by the generator mkdictbi
+     *  and for looking up entries in the generated table.
+     *  @param key tag key, group number in the upper 16 bits
+     *  @param seed seed value (displacement) for the hash function
+     *  @return hash value
+     */
+    static inline Uint32 builtinHash(Uint32 key, Uint32 seed)
+    {
+        Uint32 h = key ^ (seed * 0x9e3779b9U);
+        h ^= h >> 16;
+        h *= 0x85ebca6bU;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35U;
+        h ^= h >> 16;
+        return h;
+    }
+
 private:
 
     /** private undefined assignment operator
      */
     DcmDataDictionary &operator=(const DcmDataDictionary &);
 
-    /** private undefined copy constructor
-     */
-    DcmDataDictionary(const DcmDataDictionary &);
-
     /** loads external dictionaries defined via environment variables
      *  @return true if successful
      */
@@ -179,10 +209,51 @@ private:
 
     /** loads a builtin (compiled) data dictionary.
      *  Depending on which code is in use, this function may not
-     *  do anything.
+     *  do anything. The standard non-repeating entries are not added to the
+     *  hash dictionary but looked up through a static perfect hash table
+     *  (see setBuiltinEntries()), all other entries are added as usual.
      */
     void loadBuiltinDictionary();
 
+    /** sets the static part of the builtin data dictionary. The given tables
+     *  are only referenced, no memory is allocated and no entry is created.
+     *  The DcmDictEntry object of an entry is constructed in the given storage
+     *  when the entry is accessed for the first time. Entries with the same
+     *  tag key that are already in the hash dictionary (i.e. skeleton entries)
+     *  are removed. Any previous builtin entries are released. Called by the
+     *  generated loadBuiltinDictionary().
+     *  @param entries array of builtin entries, must remain valid as long as
+     *    the program runs
+     *  @param storage zero-initialized storage for the DcmDictEntry objects,
+     *    one element per entry, must remain valid as long as the program runs.
+     *    It may be shared by several dictionaries using the same entries.
+     *  @param count number of entries in the array
+     *  @param displacements displacement table of the perfect hash function
+     *  @param numBuckets number of entries in the displacement table (power of 2)
+     *  @param slots slot table of the perfect hash function, containing an
+     *    index into the array of entries or 0xffff for unused slots
+     *  @param tableSize number of entries in the slot table (power of 2)
+     */
+    void setBuiltinEntries(const DcmBuiltinDictEntry *entries,
+                           DcmBuiltinDictEntryStorage *storage,
+                           Uint16 count,
+                           const Uint16 *displacements,
+                           Uint32 numBuckets,
+                           const Uint16 *slots,
+                           Uint32 tableSize);
+
+    /** looks up the given tag key in the static part of the builtin
+     *  data dictionary, which only contains standard (public) entries.
+     *  @param key tag key
+     *  @return pointer to entry if found, NULL otherwise
+     */
+    const DcmDictEntry* findBuiltinEntry(const DcmTagKey& key) const;
+
+    /** releases the static part of the builtin data dictionary (if any).
+     *  The entries themselves are not destroyed since they are static data.
+     */
+    void deleteBuiltinEntries();
+
     /** loads the skeleton dictionary (the bare minimum needed to run)
      *  @return true if successful
      */
@@ -216,6 +287,34 @@ private:
      */
     OFBool dictionaryLoaded;
 
+    /** constant data of the static part of the builtin dictionary, NULL if none
+     */
+    const DcmBuiltinDictEntry *builtinEntries;
+
+    /** storage for the DcmDictEntry objects of builtinEntries, NULL if none
+     */
+    DcmBuiltinDictEntryStorage *builtinStorage;
+
+    /** number of entries in the static part of the builtin dictionary
+     */
+    int builtinCount;
+
+    /** displacement table of the perfect hash function for builtinEntries
+     */
+    const Uint16 *builtinDisplacements;
+
+    /** number of entries in builtinDisplacements minus 1 (used as a bit mask)
+     */
+    Uint32 builtinBucketMask;
+
+    /** slot table of the perfect hash function for builtinEntries
+     */
+    const Uint16 *builtinSlots;
+
+    /** number of entries in builtinSlots minus 1 (used as a bit mask)
+     */
+    Uint32 builtinSlotMask;
+
 };
 
 
@@ -224,6 +323,10 @@ private:
  *  on first use, if the user accesses it via rdlock() or wrlock().  The
  *  dictionary allows safe read (shared) and write (exclusive) access from
  *  multiple threads in parallel.
+ *  After startup, the dictionary can be frozen (see freeze()). From then on,
+ *  read access does not acquire any lock at all, and write access modifies a
+ *  copy of the dictionary that replaces the current one when the write lock
+ *  is released ("copy on write").
  */
 class DCMTK_DCMDATA_EXPORT GlobalDcmDataDictionary
 {
@@ -270,6 +373,26 @@ public:
    */
   void clear();
 
+  /** freezes the dictionary, i.e.\ turns it into an immutable snapshot that
+   *  can be read without locking. This is useful for multi-threaded
+   *  applications that create many DcmTag instances in parallel, e.g. while
+   *  parsing datasets, and should be called after the application has loaded
+   *  all required dictionaries. Subsequent write access through wrlock() is
+   *  still possible but creates a new snapshot, which is published by
+   *  wrunlock(). Previous snapshots are kept until this object is destroyed
+   *  since other threads might still use them, so modifying a frozen
+   *  dictionary should be the exception. A frozen dictionary cannot be
+   *  unfrozen. This method acquires and releases a write lock. It must not be
+   *  called with another lock on the dictionary being held by the calling
+   *  thread.
+   */
+  void freeze();
+
+  /** checks whether the dictionary has been frozen, see freeze().
+   *  @return OFTrue if the dictionary is frozen, OFFalse otherwise
+   */
+  OFBool isFrozen() const;
+
 private:
   /** private undefined assignment operator
    */
@@ -288,6 +411,23 @@ private:
    */
   DcmDataDictionary *dataDict;
 
+  /** the copy of the frozen data dictionary that is currently being modified
+   *  between wrlock() and wrunlock(), NULL if the dictionary is not frozen
+   *  or not locked for writing
+   */
+  DcmDataDictionary *writeDict;
+
+  /** previous snapshots of the frozen data dictionary that might still be
+   *  in use by other threads
+   */
+  OFList<DcmDataDictionary *> retiredDicts;
+
+  /** flag indicating whether the dictionary is frozen. Once it is set, this
+   *  flag and dataDict are read without holding the lock, so both are only
+   *  accessed with atomic loads and stores where this may happen.
+   */
+  OFBool frozen;
+
 #ifdef WITH_THREADS
   /** the read/write lock used to protect access from multiple threads
    *  @remark this member is only available if DCMTK is compiled with thread
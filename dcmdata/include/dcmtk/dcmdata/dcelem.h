@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2023, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -28,6 +28,7 @@
 #include "dcmtk/dcmdata/dcobject.h"
 #include "dcmtk/ofstd/ofstring.h"
 #include "dcmtk/ofstd/oftypes.h"
+#include "dcmtk/ofstd/offile.h"    /* for offile_off_t */
 
 // forward declarations
 class DcmInputStreamFactory;
@@ -50,6 +51,9 @@ class DCMTK_DCMDATA_EXPORT DcmElement
     friend OFBool operator<=(const DcmElement& lhs, const DcmElement& rhs);
     friend OFBool operator>=(const DcmElement& lhs, const DcmElement& rhs);
 
+    // the JSON writer needs access to the little endian value of binary elements
+    friend class DcmJsonWriter;
+
     /** constructor.
      *  Create new element from given tag and length.
      *  @param tag DICOM tag for the new element
@@ -834,6 +838,22 @@ class DCMTK_DCMDATA_EXPORT DcmElement
         return fLoadValue;
     }
 
+    /** determines the location of the element value in the file it has been
+     *  read from, if the value has not been loaded yet. This permits forwarding
+     *  the value without loading it into memory, e.g.\ by sending the given
+     *  byte range of the file to a socket with sendfile() or by copying it into
+     *  another file. The bytes in the file are encoded in the byte order of the
+     *  transfer syntax of the file.
+     *  @param filename returns the name of the file
+     *  @param offset returns the byte offset of the value in the file
+     *  @param length returns the length of the value in bytes
+     *  @return EC_Normal if successful, EC_IllegalCall if the value has already
+     *    been loaded or has not been read from a plain (uncompressed) file
+     */
+    OFCondition getValueFileLocation(OFFilename &filename,
+                                     offile_off_t &offset,
+                                     Uint32 &length) const;
+
     /* --- static helper functions --- */
 
     /** scan string value for conformance with given value representation (VR)
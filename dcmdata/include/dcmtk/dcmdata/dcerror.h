@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -185,6 +185,12 @@ extern DCMTK_DCMDATA_EXPORT const OFConditionConst EC_SOPClassMismatch;
 extern DCMTK_DCMDATA_EXPORT const OFConditionConst EC_UnknownUIDName;
 /// Cannot write IS/DS string as JSON number
 extern DCMTK_DCMDATA_EXPORT const OFConditionConst EC_CannotWriteStringAsJsonNumber;
+/// Data elements not written in ascending tag order
+extern DCMTK_DCMDATA_EXPORT const OFConditionConst EC_TagOrderViolation;
+/// Number of bytes written does not match the announced value length
+extern DCMTK_DCMDATA_EXPORT const OFConditionConst EC_ValueLengthMismatch;
+/// JSON parse error
+extern DCMTK_DCMDATA_EXPORT const OFConditionConst EC_JsonParseError;
 
 //@}
 
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2023, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -30,6 +30,8 @@
 class DcmDictEntry;
 class DcmTagKey;
 class DcmHashDict;
+struct DcmBuiltinDictEntry;
+struct DcmBuiltinDictEntryStorage;
 
 typedef OFListIterator(DcmDictEntry *) DcmDictEntryListIterator;
 typedef OFListConstIterator(DcmDictEntry *) DcmDictEntryListConstIterator;
@@ -110,7 +112,10 @@ private:
 };
 
 
-/** iterator class for traversing a DcmHashDict
+/** iterator class for traversing a DcmHashDict. Optionally, the iterator
+ *  first traverses the static part of the builtin data dictionary, skipping
+ *  those entries that are overridden by a public entry with the same tag key
+ *  in the hash dictionary.
  */
 class DCMTK_DCMDATA_EXPORT DcmHashDictIterator
 {
@@ -119,6 +124,7 @@ public:
     /// default constructor
     DcmHashDictIterator()
       : dict(NULL), hindex(0), iterating(OFFalse), iter()
+      , extra(NULL), extraStorage(NULL), extraCount(0), extraIndex(0)
         { init(NULL); }
 
     /** constructor, creates iterator to existing hash dictionary
@@ -128,6 +134,26 @@ public:
      */
     DcmHashDictIterator(const DcmHashDict* d, OFBool atEnd = OFFalse)
       : dict(NULL), hindex(0), iterating(OFFalse), iter()
+      , extra(NULL), extraStorage(NULL), extraCount(0), extraIndex(0)
+        { init(d, atEnd); }
+
+    /** constructor, creates iterator to existing hash dictionary and the
+     *  static part of the builtin data dictionary, which is traversed first
+     *  @param d pointer to dictionary
+     *  @param extraEntries constant data of the builtin entries (without
+     *    private creator), may be NULL
+     *  @param extraEntryStorage storage for the DcmDictEntry objects of the
+     *    builtin entries, one element per entry in extraEntries
+     *  @param numExtraEntries number of entries in extraEntries
+     *  @param atEnd if true, iterator points after last element
+     *   of hash dictionary, otherwise iterator points to first element
+     */
+    DcmHashDictIterator(const DcmHashDict* d, const DcmBuiltinDictEntry* extraEntries,
+                        DcmBuiltinDictEntryStorage* extraEntryStorage,
+                        int numExtraEntries, OFBool atEnd = OFFalse)
+      : dict(NULL), hindex(0), iterating(OFFalse), iter()
+      , extra(extraEntries), extraStorage(extraEntryStorage)
+      , extraCount(numExtraEntries), extraIndex(0)
         { init(d, atEnd); }
 
     /** copy constructor
@@ -135,6 +161,8 @@ public:
      */
     DcmHashDictIterator(const DcmHashDictIterator& i)
       : dict(i.dict), hindex(i.hindex), iterating(i.iterating), iter(i.iter)
+      , extra(i.extra), extraStorage(i.extraStorage)
+      , extraCount(i.extraCount), extraIndex(i.extraIndex)
         { }
 
     /** copy assignment operator
@@ -142,13 +170,17 @@ public:
      */
     DcmHashDictIterator& operator=(const DcmHashDictIterator& i)
         { dict = i.dict; hindex = i.hindex;
-          iterating = i.iterating; iter = i.iter; return *this; }
+          iterating = i.iterating; iter = i.iter;
+          extra = i.extra; extraStorage = i.extraStorage;
+          extraCount = i.extraCount;
+          extraIndex = i.extraIndex; return *this; }
 
     /** comparison equality
      * @param x the iterator to compare against
      */
     OFBool operator==(const DcmHashDictIterator& x) const
-        { return iterating ? x.iterating && (hindex == x.hindex) && (iter == x.iter) : !x.iterating; }
+        { return (extraIndex == x.extraIndex) &&
+            (iterating ? x.iterating && (hindex == x.hindex) && (iter == x.iter) : !x.iterating); }
 
     /** comparison non-equality
      * @param x the iterator to compare against
@@ -157,8 +189,7 @@ public:
         { return !(*this == x); }
 
     /// dereferencing of iterator
-    const DcmDictEntry* operator*() const
-        { return (*iter); }
+    const DcmDictEntry* operator*() const;
 
     /// pre-increment operator
     DcmHashDictIterator& operator++()
@@ -181,6 +212,12 @@ private:
      */
     void stepUp();
 
+    /** moves extraIndex to the next additional entry (starting with the
+     *  given index) that is not overridden by the hash dictionary
+     *  @param index index of the first entry to be checked
+     */
+    void stepExtra(int index);
+
     /// pointer to the hash dictionary this iterator traverses
     const DcmHashDict* dict;
 
@@ -192,6 +229,18 @@ private:
 
     /// iterator for traversing a bucket in the hash table
     DcmDictEntryListIterator iter;
+
+    /// constant data of the builtin entries traversed before the hash table, may be NULL
+    const DcmBuiltinDictEntry* extra;
+
+    /// storage for the DcmDictEntry objects of the builtin entries
+    DcmBuiltinDictEntryStorage* extraStorage;
+
+    /// number of additional entries
+    int extraCount;
+
+    /// index of current additional entry, extraCount if traversing the hash table
+    int extraIndex;
 };
 
 
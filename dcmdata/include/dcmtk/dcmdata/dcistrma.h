@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2018, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -119,7 +119,10 @@ enum DcmInputStreamFactoryType
   DFT_DcmInputFileStreamFactory,
 
   /// class DcmInputTempFileStreamFactory
-  DFT_DcmInputTempFileStreamFactory
+  DFT_DcmInputTempFileStreamFactory,
+
+  /// class DcmInputSharedFileStreamFactory
+  DFT_DcmInputSharedFileStreamFactory
 };
 
 /** pure virtual abstract base class for input stream factories,
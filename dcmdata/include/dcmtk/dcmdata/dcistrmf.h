@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2020, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -105,6 +105,99 @@ private:
 };
 
 
+/** producer class that maps a plain file into memory and reads data
+ *  directly from the mapping. Compared to DcmFileProducer, this avoids
+ *  the copy from the operating system's page cache into the stdio buffer,
+ *  and skip() and putback() are simple pointer operations.
+ *  Memory mapping is only available on systems providing mmap();
+ *  on all other systems, the status of the producer is always bad.
+ */
+class DCMTK_DCMDATA_EXPORT DcmMappedFileProducer: public DcmProducer
+{
+public:
+  /** constructor
+   *  @param filename name of file to be mapped (may contain wide chars
+   *    if support enabled)
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmMappedFileProducer(const OFFilename &filename, offile_off_t offset = 0);
+
+  /// destructor, unmaps the file
+  virtual ~DcmMappedFileProducer();
+
+  /** returns the status of the producer. Unless the status is good,
+   *  the producer will not permit any operation.
+   *  @return status, true if good
+   */
+  virtual OFBool good() const;
+
+  /** returns the status of the producer as an OFCondition object.
+   *  Unless the status is good, the producer will not permit any operation.
+   *  @return status, EC_Normal if good
+   */
+  virtual OFCondition status() const;
+
+  /** returns true if the producer is at the end of stream.
+   *  @return true if end of stream, false otherwise
+   */
+  virtual OFBool eos();
+
+  /** returns the minimum number of bytes that can be read with the
+   *  next call to read().
+   *  @return minimum of data available in producer
+   */
+  virtual offile_off_t avail();
+
+  /** reads as many bytes as possible into the given block.
+   *  @param buf pointer to memory block, must not be NULL
+   *  @param buflen length of memory block
+   *  @return number of bytes actually read.
+   */
+  virtual offile_off_t read(void *buf, offile_off_t buflen);
+
+  /** skips over the given number of bytes (or less)
+   *  @param skiplen number of bytes to skip
+   *  @return number of bytes actually skipped.
+   */
+  virtual offile_off_t skip(offile_off_t skiplen);
+
+  /** resets the stream to the position by the given number of bytes.
+   *  @param num number of bytes to putback. If the putback operation
+   *    fails, the producer status becomes bad.
+   */
+  virtual void putback(offile_off_t num);
+
+  /** returns a read-only pointer to the mapped file content at the current
+   *  read position without copying it. The pointer remains valid as long
+   *  as this producer exists.
+   *  @param len returns the number of bytes that can be accessed through
+   *    the returned pointer
+   *  @return pointer to mapped data, NULL if not available
+   */
+  const void *view(offile_off_t &len) const;
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmMappedFileProducer(const DcmMappedFileProducer&);
+
+  /// private unimplemented copy assignment operator
+  DcmMappedFileProducer& operator=(const DcmMappedFileProducer&);
+
+  /// start of the memory mapping, NULL if not mapped
+  Uint8 *data_;
+
+  /// status
+  OFCondition status_;
+
+  /// number of bytes in file (and mapping)
+  offile_off_t size_;
+
+  /// current read position
+  offile_off_t pos_;
+};
+
+
 /** input stream factory for plain files
  */
 class DCMTK_DCMDATA_EXPORT DcmInputFileStreamFactory: public DcmInputStreamFactory
@@ -115,8 +208,12 @@ public:
    *  @param filename name of file to be opened (may contain wide chars
    *    if support enabled)
    *  @param offset byte offset to skip from the start of file
+   *  @param useMemoryMapping if true, create streams that map the file
+   *    into memory (see DcmInputMappedFileStream)
    */
-  DcmInputFileStreamFactory(const OFFilename &filename, offile_off_t offset);
+  DcmInputFileStreamFactory(const OFFilename &filename,
+                            offile_off_t offset,
+                            OFBool useMemoryMapping = OFFalse);
 
   /** copy constructor
    * @param arg the factory to copy
@@ -162,6 +259,14 @@ public:
       return offset_;
   }
 
+  /** checks whether the streams created by this factory use memory mapping
+   *  @return OFTrue if memory mapping is used, OFFalse otherwise
+   */
+  OFBool usesMemoryMapping() const
+  {
+      return useMemoryMapping_;
+  }
+
 private:
 
   /// private unimplemented copy assignment operator
@@ -173,6 +278,9 @@ private:
   /// offset in file
   offile_off_t offset_;
 
+  /// flag indicating whether to create memory mapped streams
+  OFBool useMemoryMapping_;
+
 };
 
 
@@ -217,6 +325,61 @@ private:
   OFFilename filename_;
 };
 
+/** input stream that reads from a plain file that is mapped into memory.
+ *  If the file cannot be mapped (e.g. because mmap() is not supported on
+ *  the current system), the status of the stream is bad. Use
+ *  DcmInputMappedFileStream::create() to transparently fall back to
+ *  DcmInputFileStream in that case.
+ */
+class DCMTK_DCMDATA_EXPORT DcmInputMappedFileStream: public DcmInputStream
+{
+public:
+  /** constructor
+   *  @param filename name of file to be mapped (may contain wide chars
+   *    if support enabled)
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmInputMappedFileStream(const OFFilename &filename, offile_off_t offset = 0);
+
+  /// destructor
+  virtual ~DcmInputMappedFileStream();
+
+  /** creates a new factory object for the current stream
+   *  and stream position. The streams created by the factory also use
+   *  memory mapping. If a filter is installed, returns NULL.
+   *  @return pointer to new factory object if successful, NULL otherwise.
+   */
+  virtual DcmInputStreamFactory *newFactory() const;
+
+  /** creates a new input stream for the given file. If memory mapping is
+   *  requested and the file can be mapped, a DcmInputMappedFileStream is
+   *  returned, otherwise a DcmInputFileStream.
+   *  @param filename name of file to be opened (may contain wide chars
+   *    if support enabled)
+   *  @param offset byte offset to skip from the start of file
+   *  @param useMemoryMapping try to map the file into memory if true
+   *  @return pointer to new input stream, never NULL. The caller is
+   *    responsible for deleting the object.
+   */
+  static DcmInputStream *create(const OFFilename &filename,
+                                offile_off_t offset,
+                                OFBool useMemoryMapping);
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmInputMappedFileStream(const DcmInputMappedFileStream&);
+
+  /// private unimplemented copy assignment operator
+  DcmInputMappedFileStream& operator=(const DcmInputMappedFileStream&);
+
+  /// the final producer of the filter chain
+  DcmMappedFileProducer producer_;
+
+  /// filename
+  OFFilename filename_;
+};
+
 /** class that manages the life cycle of a temporary file.
  *  It maintains a thread-safe reference counter, and when this counter
  *  is decreased to zero, unlinks (deletes) the file and then the handler
@@ -331,4 +494,325 @@ private:
   DcmTempFileHandler *fileHandler_;
 };
 
+/** class that manages a file that is kept open and shared by all input
+ *  streams reading from it, e.g.\ by all element values of a dataset whose
+ *  loading has been postponed (see parameter maxReadLength of loadFile()).
+ *  It maintains a thread-safe reference counter, and when this counter is
+ *  decreased to zero, closes the file and deletes the handle object itself.
+ *  Data is read with pread() where available, i.e.\ without a shared file
+ *  position, so that several threads can read from the same handle
+ *  concurrently. On other systems, read access is serialized.
+ */
+class DCMTK_DCMDATA_EXPORT DcmSharedFileHandle
+{
+public:
+
+  /** static method that permits creation of instances of
+   *  this class (only) on the heap, never on the stack.
+   *  A newly created instance always has a reference counter of 1.
+   *  Check status() to find out whether the file could be opened.
+   *  @param filename name of file to be opened (may contain wide chars
+   *    if support enabled)
+   */
+  static DcmSharedFileHandle *newInstance(const OFFilename &filename);
+
+  /** returns the status of the handle
+   *  @return EC_Normal if the file is open, an error code otherwise
+   */
+  OFCondition status() const;
+
+  /** returns name of the file
+   *  @return name of file
+   */
+  const OFFilename &getFilename() const;
+
+  /** returns the number of bytes in the file (at the time it was opened)
+   *  @return size of file in bytes
+   */
+  offile_off_t getFileSize() const;
+
+  /** reads a block of data from the given position in the file.
+   *  This method is thread-safe and does not change any file position.
+   *  @param buf pointer to memory block, must not be NULL
+   *  @param buflen number of bytes to read
+   *  @param offset byte offset in the file from which to read
+   *  @return number of bytes actually read, less than buflen only at the
+   *    end of the file or in case of an error
+   */
+  offile_off_t readAt(void *buf, offile_off_t buflen, offile_off_t offset);
+
+  /// increase reference counter for this object
+  void increaseRefCount();
+
+  /** decreases reference counter for this object and closes the file
+   *  and deletes this object if the reference counter becomes zero.
+   */
+  void decreaseRefCount();
+
+private:
+
+  /** private constructor.
+   *  Instances of this class are always created through newInstance().
+   *  @param filename name of file to be opened
+   */
+  DcmSharedFileHandle(const OFFilename &filename);
+
+  /** private destructor. Instances of this class
+   *  are always deleted through the reference counting methods
+   */
+  virtual ~DcmSharedFileHandle();
+
+  /// private undefined copy constructor
+  DcmSharedFileHandle(const DcmSharedFileHandle& arg);
+
+  /// private undefined copy assignment operator
+  DcmSharedFileHandle& operator=(const DcmSharedFileHandle& arg);
+
+  /// number of references to this object, initialized to 1
+  size_t refCount_;
+
+#ifdef WITH_THREADS
+  /// mutex for MT-safe reference counting (and file access if pread() is not available)
+  /// @remark this member is only available if DCMTK is compiled with thread
+  /// support enabled.
+  OFMutex mutex_;
+#endif
+
+  /// the open file
+  OFFile file_;
+
+  /// status
+  OFCondition status_;
+
+  /// number of bytes in file
+  offile_off_t size_;
+
+  /// name of file
+  OFFilename filename_;
+};
+
+/** producer class that reads data from a shared file handle.
+ *  The current position is maintained by the producer itself, small reads
+ *  (e.g.\ tags and lengths during parsing) are served from an internal
+ *  buffer, and large reads (e.g.\ element values) are directly read into
+ *  the caller's memory block.
+ */
+class DCMTK_DCMDATA_EXPORT DcmSharedFileProducer: public DcmProducer
+{
+public:
+
+  /** constructor, opens the given file and creates a new shared handle for it
+   *  @param filename name of file to be opened (may contain wide chars
+   *    if support enabled)
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmSharedFileProducer(const OFFilename &filename, offile_off_t offset = 0);
+
+  /** constructor, reads from an existing shared file handle
+   *  @param handle shared file handle, must not be NULL.
+   *    Reference counter of the handle is increased by this operation.
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmSharedFileProducer(DcmSharedFileHandle *handle, offile_off_t offset);
+
+  /// destructor, decreases the reference counter of the shared file handle
+  virtual ~DcmSharedFileProducer();
+
+  /** returns the status of the producer. Unless the status is good,
+   *  the producer will not permit any operation.
+   *  @return status, true if good
+   */
+  virtual OFBool good() const;
+
+  /** returns the status of the producer as an OFCondition object.
+   *  Unless the status is good, the producer will not permit any operation.
+   *  @return status, EC_Normal if good
+   */
+  virtual OFCondition status() const;
+
+  /** returns true if the producer is at the end of stream.
+   *  @return true if end of stream, false otherwise
+   */
+  virtual OFBool eos();
+
+  /** returns the minimum number of bytes that can be read with the
+   *  next call to read().
+   *  @return minimum of data available in producer
+   */
+  virtual offile_off_t avail();
+
+  /** reads as many bytes as possible into the given block.
+   *  @param buf pointer to memory block, must not be NULL
+   *  @param buflen length of memory block
+   *  @return number of bytes actually read.
+   */
+  virtual offile_off_t read(void *buf, offile_off_t buflen);
+
+  /** skips over the given number of bytes (or less)
+   *  @param skiplen number of bytes to skip
+   *  @return number of bytes actually skipped.
+   */
+  virtual offile_off_t skip(offile_off_t skiplen);
+
+  /** resets the stream to the position by the given number of bytes.
+   *  @param num number of bytes to putback. If the putback operation
+   *    fails, the producer status becomes bad.
+   */
+  virtual void putback(offile_off_t num);
+
+  /** returns the shared file handle this producer reads from
+   *  @return shared file handle, never NULL
+   */
+  DcmSharedFileHandle *getFileHandle() const
+  {
+    return handle_;
+  }
+
+  /** returns the current position in the file
+   *  @return current byte offset in the file
+   */
+  offile_off_t tell() const
+  {
+    return pos_;
+  }
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmSharedFileProducer(const DcmSharedFileProducer&);
+
+  /// private unimplemented copy assignment operator
+  DcmSharedFileProducer& operator=(const DcmSharedFileProducer&);
+
+  /// the shared file handle we're reading from
+  DcmSharedFileHandle *handle_;
+
+  /// status
+  OFCondition status_;
+
+  /// number of bytes in file
+  offile_off_t size_;
+
+  /// current read position
+  offile_off_t pos_;
+
+  /// read buffer, allocated on first use
+  Uint8 *buf_;
+
+  /// file offset of the first byte in the read buffer
+  offile_off_t bufStart_;
+
+  /// number of bytes in the read buffer
+  offile_off_t bufCount_;
+};
+
+/** input stream that reads from a file through a shared file handle.
+ *  Factories created by this stream refer to the same handle, i.e.\ element
+ *  values that are loaded later on do not re-open the file.
+ */
+class DCMTK_DCMDATA_EXPORT DcmInputSharedFileStream: public DcmInputStream
+{
+public:
+
+  /** constructor, opens the given file
+   *  @param filename name of file to be opened (may contain wide chars
+   *    if support enabled)
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmInputSharedFileStream(const OFFilename &filename, offile_off_t offset = 0);
+
+  /** constructor, reads from an existing shared file handle
+   *  @param handle shared file handle, must not be NULL
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmInputSharedFileStream(DcmSharedFileHandle *handle, offile_off_t offset);
+
+  /// destructor
+  virtual ~DcmInputSharedFileStream();
+
+  /** creates a new factory object for the current stream
+   *  and stream position, which refers to the same shared file handle.
+   *  If a filter is installed, returns NULL.
+   *  @return pointer to new factory object if successful, NULL otherwise.
+   */
+  virtual DcmInputStreamFactory *newFactory() const;
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmInputSharedFileStream(const DcmInputSharedFileStream&);
+
+  /// private unimplemented copy assignment operator
+  DcmInputSharedFileStream& operator=(const DcmInputSharedFileStream&);
+
+  /// the final producer of the filter chain
+  DcmSharedFileProducer producer_;
+};
+
+/** input stream factory for shared file handles
+ */
+class DCMTK_DCMDATA_EXPORT DcmInputSharedFileStreamFactory: public DcmInputStreamFactory
+{
+public:
+
+  /** constructor
+   *  @param handle pointer to shared file handle, must not be NULL.
+   *    Reference counter of the handle is increased by this operation.
+   *  @param offset byte offset of the data in the file
+   */
+  DcmInputSharedFileStreamFactory(DcmSharedFileHandle *handle, offile_off_t offset);
+
+  /** copy constructor
+   * @param arg the factory to copy
+   */
+  DcmInputSharedFileStreamFactory(const DcmInputSharedFileStreamFactory &arg);
+
+  /// destructor, decreases reference counter of shared file handle
+  virtual ~DcmInputSharedFileStreamFactory();
+
+  /** create a new input stream object
+   *  @return pointer to new input stream object
+   */
+  virtual DcmInputStream *create() const;
+
+  /** returns a pointer to a copy of this object
+   */
+  virtual DcmInputStreamFactory *clone() const;
+
+  /** returns an enum describing the class to which this instance belongs
+   *  @return class to which this instance belongs
+   */
+  virtual DcmInputStreamFactoryType ident() const
+  {
+    return DFT_DcmInputSharedFileStreamFactory;
+  }
+
+  /** returns the shared file handle
+   *  @return shared file handle, never NULL
+   */
+  DcmSharedFileHandle *getFileHandle() const
+  {
+    return fileHandle_;
+  }
+
+  /** returns offset of the data in the file
+   *  @return offset of the data in the file
+   */
+  offile_off_t getOffset() const
+  {
+    return offset_;
+  }
+
+private:
+
+  /// private unimplemented copy assignment operator
+  DcmInputSharedFileStreamFactory& operator=(const DcmInputSharedFileStreamFactory&);
+
+  /// shared file handle
+  DcmSharedFileHandle *fileHandle_;
+
+  /// offset in file
+  offile_off_t offset_;
+};
+
 #endif
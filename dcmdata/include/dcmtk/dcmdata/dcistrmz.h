@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2018, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -41,6 +41,16 @@ END_EXTERN_C
  */
 extern DCMTK_DCMDATA_EXPORT OFGlobal<OFBool> dcmZlibExpectRFC1950Encoding;
 
+/** global flag defining the size (in bytes) of the input and output ring
+ *  buffers used by the zlib decompressor. Larger buffers reduce the number
+ *  of calls to zlib and to the underlying producer. The value is evaluated
+ *  when a decompression filter is created; values smaller than 4096 are
+ *  replaced by 4096. Default is 65536.
+ *  @remark this flag is only available if DCMTK is compiled with
+ *  ZLIB support enabled.
+ */
+extern DCMTK_DCMDATA_EXPORT OFGlobal<Uint32> dcmZlibInputBufferSize;
+
 /** zlib compression filter for input streams
  *  @remark this class is only available if DCMTK is compiled with
  *  ZLIB support enabled.
@@ -173,6 +183,9 @@ private:
   /// true if the zlib object has reported Z_STREAM_END
   OFBool eos_;
 
+  /// size of the input and output ring buffers in bytes
+  offile_off_t bufSize_;
+
   /// input ring buffer
   unsigned char *inputBuf_;
 
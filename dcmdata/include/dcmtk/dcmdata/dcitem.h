@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2023, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -26,6 +26,7 @@
 #include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
 
 #include "dcmtk/ofstd/offile.h"       /* for offile_off_t */
+#include "dcmtk/ofstd/ofvector.h"     /* for OFVector */
 #include "dcmtk/dcmdata/dctypes.h"
 #include "dcmtk/dcmdata/dcobject.h"
 #include "dcmtk/dcmdata/dclist.h"
@@ -37,6 +38,7 @@ class DcmElement;
 class DcmJsonFormat;
 class DcmSequenceOfItems;
 class DcmSpecificCharacterSet;
+class DcmTagSelection;
 
 
 /** a class representing a list of DICOM elements in which each
@@ -259,6 +261,27 @@ class DCMTK_DCMDATA_EXPORT DcmItem
                                      const Uint32 maxReadLength = DCM_MaxReadLength,
                                      const DcmTagKey &stopParsingAtElement = DCM_UndefinedTagKey);
 
+    /** sets the selection of attributes that are read by subsequent calls of
+     *  read() or readUntilTag(). All other attributes are skipped in the input
+     *  stream and not added to this item. Attributes with explicit length are
+     *  skipped without being parsed; sequences and other attributes with
+     *  undefined length have to be parsed in order to find their end, but
+     *  their content is discarded.
+     *  @param selection the attributes to be read, NULL to read all attributes.
+     *    NULL also clears the selection of all sequences and items that have
+     *    been read so far. The selection is not copied and must remain valid
+     *    until reading is completed.
+     */
+    void setReadSelection(const DcmTagSelection *selection);
+
+    /** returns the selection of attributes that are read by read()
+     *  @return selection of attributes, NULL if all attributes are read
+     */
+    const DcmTagSelection *getReadSelection() const
+    {
+        return readSelection;
+    }
+
     /** write object to a stream
      *  @param outStream DICOM output stream
      *  @param oxfer output transfer syntax
@@ -1207,7 +1230,7 @@ class DCMTK_DCMDATA_EXPORT DcmItem
                                    const OFBool replaceOld = OFTrue);
 
     /** create a new element, put specified value to it and insert the element into the dataset/item.
-     *  Applicable to the following VRs: SL.
+     *  Applicable to the following VRs: IS, SL.
      *  @param tag DICOM tag specifying the attribute to be created
      *  @param value value to be set for the new element
      *  @param count number of values (not bytes!) to be copied from 'value'
@@ -1261,7 +1284,7 @@ class DCMTK_DCMDATA_EXPORT DcmItem
                                     const OFBool replaceOld = OFTrue);
 
     /** create a new element, put specified value to it and insert the element into the dataset/item.
-     *  Applicable to the following VRs: FD, OD.
+     *  Applicable to the following VRs: DS, FD, OD.
      *  @param tag DICOM tag specifying the attribute to be created
      *  @param value value to be set for the new element
      *  @param count number of values (not bytes!) to be copied from 'value'
@@ -1397,6 +1420,15 @@ class DCMTK_DCMDATA_EXPORT DcmItem
                                  Uint32 &length,                 // out
                                  Uint32 &bytesRead);             // out
 
+    /** adds the given private creator to the private creator cache of this item.
+     *  Used when parsing data elements without creating element objects, so that
+     *  readTagAndLength() can still determine the VR of private data elements.
+     *  @param tag tag of the private creator element
+     *  @param privateCreator private creator identifier
+     */
+    void addPrivateCreator(const DcmTagKey &tag,
+                           const char *privateCreator);
+
     /** This function creates a new DcmElement object on the basis of the newTag
      *  and newLength information which was passed, inserts this new element into
      *  elementList, reads the actual data value which belongs to this element
@@ -1420,6 +1452,24 @@ class DCMTK_DCMDATA_EXPORT DcmItem
                                const E_GrpLenEncoding glenc,     // in
                                const Uint32 maxReadLength = DCM_MaxReadLength);
 
+    /** This function skips the remaining value of an attribute that is not
+     *  selected for reading (see setReadSelection()). The number of bytes to
+     *  be skipped is taken from skipBytesRemaining.
+     *  @param inStream The stream which contains the information.
+     *  @return EC_Normal if the value has been skipped completely,
+     *    EC_StreamNotifyClient if more data is needed, an error code otherwise
+     */
+    OFCondition skipSubElementValue(DcmInputStream &inStream);
+
+    /** checks whether the given attribute is selected for reading, i.e.\ no
+     *  read selection is set or the attribute is part of it. Item and delimitation
+     *  tags as well as the private creator elements needed for selected private
+     *  attributes are always selected.
+     *  @param tag the tag of the attribute
+     *  @return OFTrue if the attribute should be read, OFFalse otherwise
+     */
+    OFBool isSelectedForReading(const DcmTagKey &tag) const;
+
     /** This function reads the first 6 bytes from the input stream and determines
      *  the transfer syntax which was used to code the information in the stream.
      *  The decision is based on two questions: a) Did we encounter a valid tag?
@@ -1469,16 +1519,49 @@ class DCMTK_DCMDATA_EXPORT DcmItem
      *  @param readAsUN flag indicating whether parser is currently handling
      *    UN element that must be read in implicit VR little endian; updated
      *    upon return
+     *  @param arena memory arena from which the element is allocated,
+     *    NULL for the heap
      *  @return EC_Normal upon success, an error code otherwise
      */
     static OFCondition newDicomElement(DcmElement *&newElement,
                                        DcmTag &tag,
                                        const Uint32 length,
                                        DcmPrivateTagCache *privateCreatorCache,
-                                       OFBool& readAsUN);
+                                       OFBool& readAsUN,
+                                       DcmMemoryArena *arena = NULL);
 
   private:
 
+    /** helper function that makes sure that the element index is up to date,
+     *  i.e.\ creates or recreates it if required. The index is only used if
+     *  the number of elements reaches dcmElementIndexThreshold and if the
+     *  elements in elementList are sorted by their tag.
+     *  @return OFTrue if the index can be used, OFFalse otherwise
+     */
+    OFBool updateElementIndex();
+
+    /** helper function that checks whether the element index is in sync
+     *  with elementList, i.e.\ whether it can be updated incrementally.
+     *  @return OFTrue if the index is usable and up to date, OFFalse otherwise
+     */
+    OFBool elementIndexInSync() const;
+
+    /** helper function that performs a binary search in the element index.
+     *  May only be called if updateElementIndex() or elementIndexInSync()
+     *  returned OFTrue.
+     *  @param tag tag key to be searched
+     *  @return position of the first element in the index whose tag is not
+     *    less than the given tag, i.e.\ elementIndex.size() if there is none
+     */
+    size_t lowerBoundInElementIndex(const DcmTagKey &tag) const;
+
+    /** helper function that removes the given element from the element index
+     *  after it has been removed from elementList. May only be called if
+     *  elementIndexInSync() returned OFTrue before the element was removed.
+     *  @param elem element to be removed from the index
+     */
+    void removeFromElementIndex(DcmElement *elem);
+
     /** helper function for search(). May only be called if elementList is non-empty.
      *  Performs hierarchical search for given tag and pushes pointer of sub-element
      *  on result stack if found
@@ -1502,6 +1585,26 @@ class DCMTK_DCMDATA_EXPORT DcmItem
 
     /// cache for private creator tags and identifiers
     DcmPrivateTagCache privateCreatorCache;
+
+    /** sorted index of the elements in elementList (see dcmElementIndexThreshold).
+     *  Empty if the index is not used.
+     */
+    OFVector<DcmElement *> elementIndex;
+
+    /// modification counter of elementList at the time elementIndex was updated
+    unsigned long elementIndexVersion;
+
+    /// flag indicating whether elementIndexVersion is valid at all
+    OFBool elementIndexCreated;
+
+    /// selection of attributes to be read, NULL to read all attributes
+    const DcmTagSelection *readSelection;
+
+    /// number of bytes of a non-selected attribute still to be skipped while reading
+    Uint32 skipBytesRemaining;
+
+    /// non-selected attribute currently being read that is deleted when complete
+    DcmElement *discardElement;
 };
 
 /** Checks whether left hand side item is smaller than right hand side
@@ -0,0 +1,342 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: streaming parser for the DICOM JSON model
+ *
+ */
+
+#ifndef DCJSONR_H
+#define DCJSONR_H
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/offile.h"       /* for class OFFile */
+#include "dcmtk/ofstd/ofvector.h"     /* for class OFVector */
+#include "dcmtk/ofstd/ofstring.h"     /* for class OFString */
+#include "dcmtk/dcmdata/dcerror.h"    /* for OFCondition */
+#include "dcmtk/dcmdata/dctagkey.h"   /* for class DcmTagKey */
+
+class DcmElement;
+class DcmItem;
+class DcmFileFormat;
+
+/// default size of the input buffer used by class DcmJsonReader, in bytes
+#define DcmJsonReaderBufferSize 65536
+
+
+/** streaming parser for the DICOM JSON model (PS3.18 Annex F.2), i.e.\ the
+ *  counterpart of DcmItem::writeJson() and class DcmJsonWriter. The JSON
+ *  document is read in chunks of fixed size and the dataset is built while
+ *  the document is parsed, so no representation of the whole document is
+ *  kept in memory. The document may either consist of a single dataset or
+ *  of an array of datasets (e.g.\ the metadata of a STOW-RS request), which
+ *  are returned one after the other by readDataset().
+ *
+ *  String values are stored as they are found in the document, i.e.\ in
+ *  UTF-8. Binary values given as "InlineBinary" are decoded from Base64.
+ *  Values given as "BulkDataURI" are passed to readBulkData(), which can be
+ *  overridden by a derived class to retrieve the value from the given URI.
+ *  By default, bulk data is only read from local files if a bulk data
+ *  directory has been set with setBulkDataDirectory().
+ *
+ *  <h3>Usage Example:</h3>
+ *  @code{.cpp}
+ *  DcmJsonReader reader;
+ *  if (reader.openFile("metadata.json").good())
+ *  {
+ *    DcmFileFormat fileformat;
+ *    while (reader.readFileFormat(fileformat).good())
+ *    {
+ *      // process the next dataset ...
+ *    }
+ *  }
+ *  @endcode
+ */
+class DCMTK_DCMDATA_EXPORT DcmJsonReader
+{
+public:
+
+  /** constructor
+   *  @param bufferSize size of the buffer used for reading from a file, in bytes
+   */
+  DcmJsonReader(const size_t bufferSize = DcmJsonReaderBufferSize);
+
+  /// destructor, closes the input file
+  virtual ~DcmJsonReader();
+
+  /** opens the given file for reading. A previously opened input is closed.
+   *  @param filename name of the JSON file
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition openFile(const OFFilename &filename);
+
+  /** uses the given memory buffer as input. A previously opened input is
+   *  closed. The buffer is not copied and must remain valid until the
+   *  input is closed.
+   *  @param data pointer to the JSON document
+   *  @param length length of the JSON document in bytes
+   */
+  void setBuffer(const char *data,
+                 const size_t length);
+
+  /// closes the current input
+  void close();
+
+  /** sets the directory from which bulk data is read. If set, the value of
+   *  an element given as a "BulkDataURI" that is a relative reference or a
+   *  URI with the "file" scheme is read from a file within this directory,
+   *  see readBulkData(). By default, no directory is set and no files are
+   *  read.
+   *  @param directory name of the bulk data directory, empty to disable
+   *    reading bulk data from files
+   */
+  void setBulkDataDirectory(const OFString &directory);
+
+  /** reads the next dataset from the input and inserts its elements into the
+   *  given item. If the document is a single JSON object, the first call
+   *  returns this object and all subsequent calls return EC_EndOfStream. If
+   *  the document is an array, each call returns the next array element.
+   *  Elements that already exist in the item are replaced.
+   *  @param dataset dataset or item to which the elements are added
+   *  @return EC_Normal if successful, EC_EndOfStream if no more datasets are
+   *    available, an error code otherwise
+   */
+  OFCondition readDataset(DcmItem &dataset);
+
+  /** reads the next dataset from the input into the given file format
+   *  object, see readDataset(). The file format object is cleared first.
+   *  Elements of group 0x0002 (as written by dcm2json with --write-meta)
+   *  are moved to the file meta information.
+   *  @param fileformat file format object to be filled
+   *  @return EC_Normal if successful, EC_EndOfStream if no more datasets are
+   *    available, an error code otherwise
+   */
+  OFCondition readFileFormat(DcmFileFormat &fileformat);
+
+protected:
+
+  /** retrieves the value of an element that is given as a BulkDataURI.
+   *  The default implementation reads the value from a local file if a bulk
+   *  data directory has been set and the URI is either a relative reference
+   *  or uses the "file" scheme. The (percent-decoded) path must not contain
+   *  ".." and must denote a file within the bulk data directory, otherwise
+   *  an error is returned. In all other cases, the element is left empty
+   *  and a warning is reported.
+   *  Derived classes may retrieve the value from other sources and should
+   *  use putBinaryValue() to set the element value.
+   *  @param element element whose value is to be retrieved, already created
+   *    with the VR given in the document
+   *  @param uri BulkDataURI from the JSON document
+   *  @return EC_Normal if successful, an error code otherwise. An error code
+   *    aborts the parsing of the document.
+   */
+  virtual OFCondition readBulkData(DcmElement &element,
+                                   const OFString &uri);
+
+  /** sets the value of an element from the content of a file, see putBinaryValue()
+   *  @param element element whose value is to be set
+   *  @param filename name of the file
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  static OFCondition loadBulkDataFile(DcmElement &element,
+                                      const OFFilename &filename);
+
+  /** sets the value of an element from raw bytes in little endian byte order,
+   *  i.e.\ the encoding of "InlineBinary" and of bulk data. For string VRs,
+   *  the bytes are used as the string value.
+   *  @param element element whose value is to be set
+   *  @param data pointer to the value, may be modified by this function
+   *  @param length length of the value in bytes
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  static OFCondition putBinaryValue(DcmElement &element,
+                                    Uint8 *data,
+                                    const size_t length);
+
+private:
+
+  /// a single entry of the "Value" array of an element
+  struct JsonValue;
+
+  /// private undefined copy constructor
+  DcmJsonReader(const DcmJsonReader&);
+
+  /// private undefined copy assignment operator
+  DcmJsonReader& operator=(const DcmJsonReader&);
+
+  /** reads the members of a JSON object describing an item or dataset,
+   *  starting after the opening brace
+   *  @param item item to which the elements are added
+   *  @param firstKey tag of the first member if it has already been read,
+   *    NULL otherwise
+   *  @param depth nesting depth of the object
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition readItemContent(DcmItem &item,
+                              const OFString *firstKey,
+                              const unsigned int depth);
+
+  /** reads a JSON object describing a data element and adds the element to
+   *  the given item
+   *  @param item item to which the element is added
+   *  @param key tag of the element as found in the document ("ggggeeee")
+   *  @param depth nesting depth of the element object
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition readElement(DcmItem &item,
+                          const OFString &key,
+                          const unsigned int depth);
+
+  /** reads the "Value" array of an element
+   *  @param values list of values to be filled
+   *  @param depth nesting depth of the array
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition readValueArray(OFVector<JsonValue> &values,
+                             const unsigned int depth);
+
+  /** reads an object within a "Value" array, which is either a person name
+   *  or a sequence item
+   *  @param value value to be filled
+   *  @param depth nesting depth of the object
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition readValueObject(JsonValue &value,
+                              const unsigned int depth);
+
+  /** reads the members of a person name object, starting with the value of
+   *  the given member
+   *  @param value value to be filled with the person name in DICOM notation
+   *  @param firstKey name of the first member, already read
+   *  @param depth nesting depth of the object
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition readPersonName(JsonValue &value,
+                             const OFString &firstKey,
+                             const unsigned int depth);
+
+  /** creates the element from the parsed members and adds it to the item
+   *  @param item item to which the element is added
+   *  @param tagKey tag of the element
+   *  @param vr value representation from the document, empty if not present
+   *  @param values content of the "Value" array
+   *  @param inlineBinary content of "InlineBinary", if present
+   *  @param bulkDataURI content of "BulkDataURI", if present
+   *  @param member bit mask of the members found in the document
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition createElement(DcmItem &item,
+                            const DcmTagKey &tagKey,
+                            const OFString &vr,
+                            OFVector<JsonValue> &values,
+                            const OFString &inlineBinary,
+                            const OFString &bulkDataURI,
+                            const unsigned int member);
+
+  /** reads a JSON string, starting at the opening quotation mark. Escape
+   *  sequences are resolved and the result is encoded in UTF-8.
+   *  @param value string to be filled
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition readString(OFString &value);
+
+  /** reads a JSON number or literal (e.g.\ "null") and returns its text.
+   *  The extended encoding of infinity and not-a-number written by dcm2json
+   *  is also accepted.
+   *  @param value string to be filled
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition readWord(OFString &value);
+
+  /** skips a JSON value of any type
+   *  @param depth nesting depth of the value
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition skipValue(const unsigned int depth);
+
+  /** reads the separator after an object member or array entry
+   *  @param close closing character of the object or array
+   *  @param done set to OFTrue if the closing character was found
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition readSeparator(const char close,
+                            OFBool &done);
+
+  /** skips whitespace and returns the next character without consuming it
+   *  @return next character, or -1 at the end of the input
+   */
+  int peek();
+
+  /** skips whitespace and consumes the given character
+   *  @param c expected character
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition expect(const char c);
+
+  /** makes sure that at least one byte is available in the input buffer
+   *  @return OFTrue if successful, OFFalse at the end of the input
+   */
+  inline OFBool fill()
+  {
+    return (pos_ < end_) || refill();
+  }
+
+  /** reads the next chunk of the input file into the input buffer
+   *  @return OFTrue if data is available, OFFalse at the end of the input
+   */
+  OFBool refill();
+
+  /** reports a parse error at the current position
+   *  @param message description of the error
+   *  @return EC_JsonParseError
+   */
+  OFCondition parseError(const char *message);
+
+  /// input file, if reading from a file
+  OFFile file_;
+
+  /// size of the input buffer
+  size_t bufferSize_;
+
+  /// input buffer for reading from a file
+  OFVector<char> buffer_;
+
+  /// current position in the input
+  const char *pos_;
+
+  /// end of the data available in the input buffer
+  const char *end_;
+
+  /// number of the current line, for error messages
+  unsigned long line_;
+
+  /// directory from which bulk data is read, empty if disabled
+  OFString bulkDataDir_;
+
+  /// state of the top level of the document
+  enum
+  {
+    /// nothing read yet
+    TS_start,
+    /// within a top level array
+    TS_array,
+    /// document completely read
+    TS_done
+  } topLevel_;
+};
+
+#endif
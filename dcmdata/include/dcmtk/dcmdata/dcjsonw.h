@@ -0,0 +1,302 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: fast compact JSON writer for DICOM datasets
+ *
+ */
+
+#ifndef DCJSONW_H
+#define DCJSONW_H
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/ofvector.h"     /* for class OFVector */
+#include "dcmtk/ofstd/ofstring.h"     /* for class OFString */
+#include "dcmtk/dcmdata/dcerror.h"    /* for OFCondition */
+#include "dcmtk/dcmdata/dcjson.h"     /* for class DcmJsonFormatCompact */
+
+#include <cstring>                    /* for memcpy() */
+
+class DcmElement;
+class DcmItem;
+class DcmFileFormat;
+class DcmPersonName;
+class DcmSequenceOfItems;
+
+
+/** fast writer for the DICOM JSON model (PS3.18 Annex F) in compact format.
+ *  In contrast to DcmItem::writeJson(), this class does not use an output
+ *  stream, but writes into a growable memory buffer that can be reused for
+ *  any number of datasets. Strings are escaped with a lookup table and
+ *  copied in runs, and binary numbers are formatted without iostreams.
+ *  The output is identical to the output of DcmItem::writeJsonExt() and
+ *  DcmFileFormat::writeJson() with the same DcmJsonFormatCompact object,
+ *  i.e.\ the options of the format object (meta information, extended
+ *  encoding of infinity and not-a-number, IS/DS policy) and its
+ *  DcmJsonFormat::asBulkDataURI() callback are obeyed. Elements for which
+ *  no optimized code exists, e.g.\ pixel data, are written by their own
+ *  writeJson() method.
+ *
+ *  <h3>Usage Example:</h3>
+ *  @code{.cpp}
+ *  DcmJsonFormatCompact format(OFFalse);
+ *  DcmJsonWriter writer(format);
+ *  writer.append("[");
+ *  for (size_t i = 0; i < datasets.size(); ++i)
+ *  {
+ *    if (i > 0) writer.append(",");
+ *    if (writer.writeDataset(*datasets[i]).bad()) ...
+ *  }
+ *  writer.append("]");
+ *  send(writer.getBuffer(), writer.getLength());
+ *  writer.clear(); // keeps the allocated memory
+ *  @endcode
+ */
+class DCMTK_DCMDATA_EXPORT DcmJsonWriter
+{
+public:
+
+  /** constructor
+   *  @param format compact JSON format providing the encoding options and the
+   *    BulkDataURI callback. Must remain valid until this object is destroyed.
+   */
+  DcmJsonWriter(DcmJsonFormatCompact& format);
+
+  /// destructor
+  virtual ~DcmJsonWriter();
+
+  /** sets the minimum value length of elements that are passed to
+   *  DcmJsonFormat::asBulkDataURI(). Values with a length of up to this
+   *  number of bytes are always written inline, which avoids the callback
+   *  for the majority of elements. This threshold does not apply to
+   *  elements that are written by their own writeJson() method.
+   *  @param threshold threshold in bytes, 0 (default) means that all
+   *    candidate elements are passed to the callback
+   */
+  void setBulkDataThreshold(const Uint32 threshold);
+
+  /** reserves memory for the given number of bytes in the output buffer
+   *  @param size number of bytes
+   */
+  void reserve(const size_t size);
+
+  /** appends a dataset or item as a JSON object to the output buffer.
+   *  Equivalent to DcmItem::writeJsonExt(out, format, OFTrue, OFTrue).
+   *  @param item dataset or item to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeDataset(DcmItem& item);
+
+  /** appends a DICOM file to the output buffer.
+   *  Equivalent to DcmFileFormat::writeJson().
+   *  @param fileformat file to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeFileFormat(DcmFileFormat& fileformat);
+
+  /** appends the given text to the output buffer without any escaping,
+   *  e.g.\ brackets and commas that combine several datasets into an array
+   *  @param text text to be appended
+   */
+  void append(const char *text);
+
+  /** returns the content of the output buffer. Not terminated by a null byte.
+   *  @return pointer to the output buffer, only valid until the next
+   *    modification of the buffer
+   */
+  const char *getBuffer() const;
+
+  /** returns the number of bytes in the output buffer
+   *  @return length of the output in bytes
+   */
+  size_t getLength() const;
+
+  /** clears the output buffer, but keeps the allocated memory for reuse
+   */
+  void clear();
+
+private:
+
+  /// private undefined copy constructor
+  DcmJsonWriter(const DcmJsonWriter&);
+
+  /// private undefined copy assignment operator
+  DcmJsonWriter& operator=(const DcmJsonWriter&);
+
+  /** writes the content of an item
+   *  @param item item to be written
+   *  @param printBraces write braces around the content if true
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeItemContent(DcmItem& item,
+                               const OFBool printBraces);
+
+  /** writes a data element, dispatching on its value representation
+   *  @param elem element to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeElement(DcmElement& elem);
+
+  /** writes a string element
+   *  @param elem element to be written
+   *  @param bulkData true if the element may be written as BulkDataURI
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeString(DcmElement& elem,
+                          const OFBool bulkData);
+
+  /** writes a person name element
+   *  @param elem element to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writePersonName(DcmPersonName& elem);
+
+  /** writes an integer string (IS) or decimal string (DS) element
+   *  @param elem element to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeNumberString(DcmElement& elem);
+
+  /** writes a binary integer element (US, SS, UL, SL)
+   *  @param elem element to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeInteger(DcmElement& elem);
+
+  /** writes a floating point element (FL, FD)
+   *  @param elem element to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeFloat(DcmElement& elem);
+
+  /** writes an attribute tag element (AT)
+   *  @param elem element to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeAttributeTag(DcmElement& elem);
+
+  /** writes a sequence element
+   *  @param elem element to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeSequence(DcmSequenceOfItems& elem);
+
+  /** writes a binary element (OB, OW, OD, OF, OL, OV, UN) as InlineBinary
+   *  @param elem element to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeInlineBinary(DcmElement& elem);
+
+  /** writes an element by means of its writeJson() method
+   *  @param elem element to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeWithStream(DcmElement& elem);
+
+  /** writes the tag and VR of an element, i.e.\ the beginning of the JSON object
+   *  @param elem element
+   */
+  void writeOpener(DcmElement& elem);
+
+  /** checks whether the element is to be written as BulkDataURI and writes
+   *  the URI if so
+   *  @param elem element
+   *  @return OFTrue if the BulkDataURI has been written, OFFalse otherwise
+   */
+  OFBool writeBulkDataURI(DcmElement& elem);
+
+  /** writes a string value in double quotes, or null if the value is empty
+   *  @param value string value
+   */
+  void writeValueString(const OFString& value);
+
+  /** writes the characters of a string, escaping all characters that
+   *  are not permitted in a JSON string
+   *  @param str pointer to the characters
+   *  @param length number of characters
+   */
+  void writeEscaped(const char *str,
+                    size_t length);
+
+  /** writes a number given as a string after removing plus signs and
+   *  leading zeros (see DcmJsonFormat::normalizeDecimalString()), or null
+   *  if the string is empty
+   *  @param str pointer to the number
+   *  @param length length of the number
+   *  @param decimal true for a decimal number, false for an integer
+   */
+  void writeNumber(const char *str,
+                   size_t length,
+                   const OFBool decimal);
+
+  /** writes an unsigned integer number
+   *  @param value number to be written
+   *  @param negative write a minus sign before the number if true
+   */
+  void writeUnsigned(unsigned long value,
+                     const OFBool negative = OFFalse);
+
+  /** makes sure that the output buffer has room for the given number of bytes
+   *  @param size number of bytes
+   */
+  inline void makeRoom(const size_t size)
+  {
+    if (length_ + size > buffer_.size()) grow(size);
+  }
+
+  /** enlarges the output buffer
+   *  @param size number of bytes that must fit into the buffer
+   */
+  void grow(const size_t size);
+
+  /** appends characters to the output buffer
+   *  @param str pointer to the characters
+   *  @param length number of characters
+   */
+  inline void write(const char *str, const size_t length)
+  {
+    makeRoom(length);
+    memcpy(&buffer_[length_], str, length);
+    length_ += length;
+  }
+
+  /** appends a single character to the output buffer
+   *  @param c character
+   */
+  inline void write(const char c)
+  {
+    makeRoom(1);
+    buffer_[length_++] = c;
+  }
+
+  /// JSON format providing the encoding options and the BulkDataURI callback
+  DcmJsonFormatCompact& format_;
+
+  /// minimum value length of elements passed to the BulkDataURI callback
+  Uint32 bulkDataThreshold_;
+
+  /// output buffer, only the first length_ bytes are used
+  OFVector<char> buffer_;
+
+  /// number of bytes in the output buffer
+  size_t length_;
+
+  /// temporary string for element values
+  OFString value_;
+};
+
+#endif
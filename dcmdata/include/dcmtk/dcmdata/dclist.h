@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2021, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -49,6 +49,66 @@ public:
     /// return pointer to object maintained by this list node
     inline DcmObject *value() { return objNodeValue; } 
 
+    /** allocates memory for a new list node from the heap. Same as the
+     *  global operator new, only declared since the class-specific
+     *  placement form below would hide it otherwise.
+     *  @param size size of the list node in bytes
+     *  @return pointer to the memory
+     */
+    static void *operator new(size_t size);
+
+    /** allocates memory for a new list node from the heap without throwing
+     *  an exception. Same as the global nothrow form of operator new.
+     *  @param size size of the list node in bytes
+     *  @param nt nothrow tag
+     *  @return pointer to the memory, NULL if out of memory
+     */
+    static void *operator new(size_t size, const std::nothrow_t& nt) OFnoexcept;
+
+    /** constructs a list node in the given memory. Same as the global
+     *  placement form of operator new.
+     *  @param size size of the list node in bytes
+     *  @param ptr pointer to the memory
+     *  @return ptr
+     */
+    static void *operator new(size_t size, void *ptr) OFnoexcept;
+
+    /** allocates memory for a new list node from the given memory arena,
+     *  e.g.\ "new (arena) DcmListNode(obj)"
+     *  @param size size of the list node in bytes
+     *  @param arena memory arena, NULL for the heap
+     *  @return pointer to the memory
+     */
+    static void *operator new(size_t size, DcmMemoryArena *arena);
+
+    /** frees the memory of a list node, regardless of whether it has been
+     *  allocated from the heap or from a memory arena. Memory from the heap
+     *  is passed to the global operator delete unchanged.
+     *  @param ptr pointer to the memory
+     */
+    static void operator delete(void *ptr);
+
+    /** frees the memory of a list node allocated with the nothrow form of
+     *  operator new. Only called if the constructor throws an exception.
+     *  @param ptr pointer to the memory
+     *  @param nt nothrow tag
+     */
+    static void operator delete(void *ptr, const std::nothrow_t& nt) OFnoexcept;
+
+    /** counterpart of the placement form of operator new, does nothing.
+     *  Only called if the constructor throws an exception.
+     *  @param ptr pointer to the memory
+     *  @param place pointer passed to operator new
+     */
+    static void operator delete(void *ptr, void *place) OFnoexcept;
+
+    /** frees the memory of a list node allocated from a memory arena.
+     *  Only called if the constructor throws an exception.
+     *  @param ptr pointer to the memory
+     *  @param arena memory arena
+     */
+    static void operator delete(void *ptr, DcmMemoryArena *arena);
+
 private:
     friend class DcmList;
 
@@ -161,6 +221,20 @@ public:
     /// return true if current node exists, false otherwise
     inline OFBool valid(void) const { return currentNode != NULL; }
 
+    /** return the number of modifications of this list so far, i.e.\ the
+     *  number of insert and remove operations. Can be used to check whether
+     *  information derived from the content of the list is still up to date.
+     *  @return modification counter of this list
+     */
+    inline unsigned long modificationCounter() const { return modCounter; }
+
+    /** set the memory arena from which new nodes of this list are allocated.
+     *  The list holds a reference to the arena until another arena is set or
+     *  the list is destroyed.
+     *  @param arena memory arena, NULL for the heap (default)
+     */
+    void setMemoryArena(DcmMemoryArena *arena);
+
 private:
     /// pointer to first node in list
     DcmListNode *firstNode;
@@ -173,6 +247,12 @@ private:
 
     /// number of elements in list
     unsigned long cardinality;
+
+    /// number of modifications of this list
+    unsigned long modCounter;
+
+    /// memory arena from which the list nodes are allocated, NULL for the heap
+    DcmMemoryArena *memoryArena;
  
     /// private undefined copy constructor 
     DcmList &operator=(const DcmList &);
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2017-2018, OFFIS e.V.
+ *  Copyright (C) 2017-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -26,6 +26,11 @@
 #include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
 
 #include "dcmtk/ofstd/ofcond.h"
+#include "dcmtk/ofstd/ofstring.h"
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/ofstd/ofdate.h"
+#include "dcmtk/ofstd/oftime.h"
+#include "dcmtk/ofstd/ofdatime.h"
 #include "dcmtk/dcmdata/dcdefine.h"
 
 // forward declaration of DcmVR
@@ -97,6 +102,170 @@ public:
         size_t secondSize;
     };
 
+    /** A query value that has been prepared once for being matched against many candidates.
+     *  Unlike the matching functions of DcmAttributeMatching, which analyze the query value
+     *  each time they are called, CompiledQuery analyzes it only once during construction:
+     *  Wild Card queries are split into their literal segments, the bounds of date/time
+     *  ranges are parsed into OFDate, OFTime or OFDateTime objects and lists of UIDs are
+     *  sorted for binary search. The result of a match is always the same as the one of
+     *  the respective matching function, e.g.\ wildCardMatching() for the VR PN.
+     *  @details
+     *  <h3>Usage Example</h3>
+     *  @code{.cpp}
+     *  const DcmAttributeMatching::CompiledQuery query( EVR_DA, "20160101-20181231", 17 );
+     *  for( size_t i = 0; i < numCandidates; ++i )
+     *      if( query( candidates[i].c_str(), candidates[i].size() ) )
+     *          ++numMatches;
+     *  @endcode
+     */
+    class DCMTK_DCMDATA_EXPORT CompiledQuery
+    {
+    public:
+
+        /** Default construct an empty CompiledQuery object that cannot be used for matching.
+         */
+        CompiledQuery();
+
+        /** Prepare the given query value for matching candidates of the given VR.
+         *  @param vr the DICOM Value Representation of the query and the candidates.
+         *  @param queryData a pointer to the query value, the data is copied, i.e.\ it does
+         *    not need to remain valid after construction.
+         *  @param querySize the size (in bytes) of the data queryData refers to.
+         */
+        CompiledQuery( const DcmVR vr, const void* queryData, const size_t querySize );
+
+        /** Test whether this object may be used for matching, i.e.\ whether it is not empty.
+         *  @return OFTrue if this object may be used for matching, OFFalse otherwise.
+         */
+#ifdef HAVE_CXX11
+        explicit
+#endif
+        operator OFBool() const;
+
+        /** Test whether this object cannot be used for matching, i.e.\ whether it is empty.
+         *  @return OFTrue if this object cannot be used for matching, OFFalse otherwise.
+         */
+        OFBool operator!() const;
+
+        /** Match the given candidate with the compiled query.
+         *  @param candidateData a pointer to some DICOM data that uses the same VR that was
+         *    given during construction of this object.
+         *  @param candidateSize the size (in bytes) of the data candidateData refers to.
+         *  @return OFTrue if the query and the candidate match, OFFalse otherwise (also if
+         *    the query value could not be parsed, e.g.\ an invalid date range).
+         *  @pre !(*this) must evaluate to OFFalse.
+         */
+        OFBool operator()( const void* candidateData, const size_t candidateSize ) const;
+
+    private:
+
+        /// the different kinds of compiled queries
+        enum E_Type
+        {
+            /// empty object, cannot be used for matching
+            T_Empty,
+            /// Universal Matching, every candidate matches
+            T_Universal,
+            /// query could not be parsed, no candidate matches
+            T_None,
+            /// Single Value Matching (also used for Wild Card queries without Wild Cards)
+            T_SingleValue,
+            /// Wild Card Matching
+            T_WildCard,
+            /// Range Matching of dates
+            T_Date,
+            /// Range Matching of times
+            T_Time,
+            /// Range Matching of date times
+            T_DateTime,
+            /// List of UID Matching
+            T_UIDList
+        };
+
+        /// a part of the stored query value, i.e.\ a segment between '*' wild cards or a UID
+        struct Segment
+        {
+            /// offset of the segment within the stored query value
+            size_t offset;
+            /// size (in bytes) of the segment
+            size_t size;
+            /// OFTrue if the segment contains the '?' wild card
+            OFBool hasWildCard;
+        };
+
+        /// prepare a Wild Card query, called by the constructor
+        void compileWildCard();
+
+        /// prepare a List of UID query, called by the constructor
+        void compileUIDList();
+
+        /// prepare a date/time range query, called by the constructor
+        template<typename T>
+        void compileRange( OFCondition (*parse)(const char*,const size_t,T&), T& first, T& second );
+
+        /// match a candidate using the prepared range, called by operator()
+        template<typename T>
+        OFBool matchRange( OFCondition (*parse)(const char*,const size_t,T&), const T& first, const T& second,
+                           const char* candidateData, const size_t candidateSize ) const;
+
+        /// match a candidate using the prepared Wild Card segments, called by operator()
+        OFBool matchWildCard( const char* candidateData, const size_t candidateSize ) const;
+
+        /// match a candidate using the sorted list of UIDs, called by operator()
+        OFBool matchUIDList( const char* candidateData, const size_t candidateSize ) const;
+
+        /// match a single segment at the given position of the candidate (which must be large enough)
+        OFBool matchSegment( const Segment& segment, const char* candidateData ) const;
+
+        /// find the first occurrence of a segment within the given part of the candidate
+        const char* findSegment( const Segment& segment, const char* begin, const char* end ) const;
+
+        /// kind of this query
+        E_Type m_eType;
+
+        /// copy of the query value
+        OFString m_Query;
+
+        /// literal segments of a Wild Card query or the sorted UIDs of a List of UID query
+        OFVector<Segment> m_Segments;
+
+        /// OFTrue if the Wild Card query begins with '*', i.e.\ the first segment is not anchored
+        OFBool m_bOpenBeginning;
+
+        /// OFTrue if the Wild Card query ends with '*', i.e.\ the last segment is not anchored
+        OFBool m_bOpenEnd;
+
+        /// minimum size of a candidate matching the Wild Card query
+        size_t m_MinSize;
+
+        /// OFTrue if the date/time query is a range
+        OFBool m_bIsRange;
+
+        /// OFTrue if the date/time range has no lower bound
+        OFBool m_bNoLowerBound;
+
+        /// OFTrue if the date/time range has no upper bound
+        OFBool m_bNoUpperBound;
+
+        /// lower bound (or single value) of a date range
+        OFDate m_FirstDate;
+
+        /// upper bound of a date range
+        OFDate m_SecondDate;
+
+        /// lower bound (or single value) of a time range
+        OFTime m_FirstTime;
+
+        /// upper bound of a time range
+        OFTime m_SecondTime;
+
+        /// lower bound (or single value) of a date time range
+        OFDateTime m_FirstDateTime;
+
+        /// upper bound of a date time range
+        OFDateTime m_SecondDateTime;
+    };
+
     /** Check whether the given query data conforms to the VR DA.
      *  @param queryData a pointer to some data.
      *  @param querySize the size (in bytes) of the data queryData refers to.
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2020, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -27,12 +27,15 @@
 
 #include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
 
+#include "dcmtk/ofstd/ofdefine.h"
 #include "dcmtk/ofstd/ofglobal.h"
 #include "dcmtk/dcmdata/dcerror.h"
 #include "dcmtk/dcmdata/dcxfer.h"
 #include "dcmtk/dcmdata/dctag.h"
 #include "dcmtk/dcmdata/dcstack.h"
 
+#include <new>      /* for std::nothrow_t */
+
 
 // forward declarations
 class DcmItem;
@@ -41,6 +44,7 @@ class DcmOutputStream;
 class DcmInputStream;
 class DcmWriteCache;
 class DcmSpecificCharacterSet;
+class DcmMemoryArena;
 
 // include this file in doxygen documentation
 
@@ -227,6 +231,38 @@ extern DCMTK_DCMDATA_EXPORT OFGlobal<OFBool> dcmConvertVOILUTSequenceOWtoSQ; /*
  */
 extern DCMTK_DCMDATA_EXPORT OFGlobal<OFBool> dcmUseExplLengthPixDataForEncTS; /* default OFFalse */
 
+/** This flag defines whether DcmFileFormat::loadFile() and DcmDataset::loadFile()
+ *  map the input file into memory instead of reading it through the stdio
+ *  library. This avoids copying the file content twice when parsing large
+ *  objects, and element values that are loaded later on (see parameter
+ *  maxReadLength) are also read from a memory mapping. If the file cannot be
+ *  mapped, e.g.\ because memory mapping is not supported on the current system,
+ *  the file is read as usual. Default is "off" (OFFalse).
+ */
+extern DCMTK_DCMDATA_EXPORT OFGlobal<OFBool> dcmUseMemoryMappedFileInput; /* default OFFalse */
+
+/** This flag defines whether DcmFileFormat::loadFile() and DcmDataset::loadFile()
+ *  read the input file through a shared file handle (see DcmSharedFileHandle)
+ *  that is kept open as long as element values that have not been loaded yet
+ *  (see parameter maxReadLength) refer to it. These values are then read with
+ *  pread() instead of opening the file again for each access, also if the
+ *  dataset has been copied. If enabled, this flag takes precedence over
+ *  dcmUseMemoryMappedFileInput. Please note that the file remains open until
+ *  all values have been loaded or the dataset (and all copies) are deleted.
+ *  Default is "off" (OFFalse).
+ */
+extern DCMTK_DCMDATA_EXPORT OFGlobal<OFBool> dcmUseSharedFileHandleInput; /* default OFFalse */
+
+/** This flag defines the minimum number of elements a dataset or item must
+ *  contain before DcmItem maintains a sorted index of its elements, which is
+ *  used for looking up elements on the main level (e.g.\ by search(),
+ *  tagExists() and all findAndGetXXX() methods) using a binary search instead
+ *  of a linear scan of the element list. The index is created on demand and
+ *  kept up to date by insert() and remove(). A value of 0 disables the index.
+ *  Default is 64.
+ */
+extern DCMTK_DCMDATA_EXPORT OFGlobal<Uint32> dcmElementIndexThreshold; /* default 64 */
+
 /** Abstract base class for most classes in module dcmdata. As a rule of thumb,
  *  everything that is either a dataset or that can be identified with a DICOM
  *  attribute tag is derived from class DcmObject.
@@ -255,6 +291,66 @@ class DCMTK_DCMDATA_EXPORT DcmObject
      */
     virtual DcmObject *clone() const = 0;
 
+    /** allocates memory for a new object from the heap. Same as the
+     *  global operator new, only declared since the class-specific
+     *  placement form below would hide it otherwise.
+     *  @param size size of the object in bytes
+     *  @return pointer to the memory
+     */
+    static void *operator new(size_t size);
+
+    /** allocates memory for a new object from the heap without throwing
+     *  an exception. Same as the global nothrow form of operator new.
+     *  @param size size of the object in bytes
+     *  @param nt nothrow tag
+     *  @return pointer to the memory, NULL if out of memory
+     */
+    static void *operator new(size_t size, const std::nothrow_t& nt) OFnoexcept;
+
+    /** constructs a object in the given memory. Same as the global
+     *  placement form of operator new.
+     *  @param size size of the object in bytes
+     *  @param ptr pointer to the memory
+     *  @return ptr
+     */
+    static void *operator new(size_t size, void *ptr) OFnoexcept;
+
+    /** allocates memory for a new object from the given memory arena,
+     *  e.g.\ "new (arena) DcmUnsignedShort(tag)"
+     *  @param size size of the object in bytes
+     *  @param arena memory arena, NULL for the heap
+     *  @return pointer to the memory
+     */
+    static void *operator new(size_t size, DcmMemoryArena *arena);
+
+    /** frees the memory of an object, regardless of whether it has been
+     *  allocated from the heap or from a memory arena. Memory from the heap
+     *  is passed to the global operator delete unchanged.
+     *  @param ptr pointer to the memory
+     */
+    static void operator delete(void *ptr);
+
+    /** frees the memory of an object allocated with the nothrow form of
+     *  operator new. Only called if the constructor throws an exception.
+     *  @param ptr pointer to the memory
+     *  @param nt nothrow tag
+     */
+    static void operator delete(void *ptr, const std::nothrow_t& nt) OFnoexcept;
+
+    /** counterpart of the placement form of operator new, does nothing.
+     *  Only called if the constructor throws an exception.
+     *  @param ptr pointer to the memory
+     *  @param place pointer passed to operator new
+     */
+    static void operator delete(void *ptr, void *place) OFnoexcept;
+
+    /** frees the memory of an object allocated from a memory arena.
+     *  Only called if the constructor throws an exception.
+     *  @param ptr pointer to the memory
+     *  @param arena memory arena
+     */
+    static void operator delete(void *ptr, DcmMemoryArena *arena);
+
     /** copy assignment operator
      *  @param obj object to be copied
      *  @return reference to this object
@@ -381,6 +477,12 @@ class DCMTK_DCMDATA_EXPORT DcmObject
      */
     inline void setParent(DcmObject *parent) { Parent = parent; }
 
+    /** get the memory arena from which the objects read into this object are
+     *  allocated. By default, this is the memory arena of the parent.
+     *  @return pointer to the memory arena, NULL if objects are allocated from the heap
+     */
+    virtual DcmMemoryArena *getMemoryArena() const;
+
     /** return the group number of the attribute tag for this object
      *  @return group number of the attribute tag for this object
      */
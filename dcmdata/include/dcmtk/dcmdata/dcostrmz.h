@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2018, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -40,6 +40,40 @@ END_EXTERN_C
  */
 extern DCMTK_DCMDATA_EXPORT OFGlobal<int> dcmZlibCompressionLevel;
 
+/** global flag defining the size (in bytes) of the input and output ring
+ *  buffers used by the zlib compressor. Larger buffers reduce the number
+ *  of calls to zlib and to the underlying consumer. The value is evaluated
+ *  when a compression filter is created; values smaller than 4096 are
+ *  replaced by 4096. Default is 65536.
+ *  @remark this flag is only available if DCMTK is compiled with
+ *  ZLIB support enabled.
+ */
+extern DCMTK_DCMDATA_EXPORT OFGlobal<Uint32> dcmZlibOutputBufferSize;
+
+/** global flag defining the number of threads used for zlib (deflate)
+ *  compression. If larger than 1, the data is split into blocks of
+ *  dcmZlibParallelBlockSize bytes that are compressed concurrently and
+ *  concatenated into a single deflated bitstream, which can be decoded by
+ *  any compliant reader. The compressed size is usually slightly larger
+ *  than with a single thread. Default is 1, i.e. no block-parallel compression.
+ *  If DCMTK is compiled without thread support, the blocks are compressed
+ *  one after the other.
+ *  @remark this flag is only available if DCMTK is compiled with
+ *  ZLIB support enabled. It has no effect if DCMTK is compiled with
+ *  ZLIB_ENCODE_RFC1950_HEADER defined.
+ */
+extern DCMTK_DCMDATA_EXPORT OFGlobal<Uint32> dcmZlibCompressionThreads;
+
+/** global flag defining the number of uncompressed bytes per block for
+ *  block-parallel zlib (deflate) compression, see dcmZlibCompressionThreads.
+ *  Values smaller than 32768 are replaced by 32768. Default is 131072.
+ *  @remark this flag is only available if DCMTK is compiled with
+ *  ZLIB support enabled.
+ */
+extern DCMTK_DCMDATA_EXPORT OFGlobal<Uint32> dcmZlibParallelBlockSize;
+
+class DcmZLibParallelCompressor;
+
 /** zlib compression filter for output streams.
  *  @remark this class is only available if DCMTK is compiled with
  *  ZLIB support enabled.
@@ -147,6 +181,13 @@ private:
    */
   void compressInputBuffer(OFBool finalize);
 
+  /** implementation of write() for block-parallel compression.
+   *  @param buf pointer to memory block
+   *  @param buflen length of memory block
+   *  @return number of bytes actually processed.
+   */
+  offile_off_t writeParallel(const void *buf, offile_off_t buflen);
+
   /// pointer to consumer to which compressed output is written
   DcmConsumer *current_;
 
@@ -159,6 +200,9 @@ private:
   /// true if the zlib object has reported Z_STREAM_END
   OFBool flushed_;
 
+  /// size of the input and output ring buffers in bytes
+  offile_off_t bufSize_;
+
   /// input ring buffer
   unsigned char *inputBuf_;
 
@@ -177,6 +221,9 @@ private:
   /// number of bytes in output ring buffer
   offile_off_t outputBufCount_;
 
+  /// block-parallel compressor, NULL unless more than one thread is used
+  DcmZLibParallelCompressor *parallel_;
+
 };
 
 #endif
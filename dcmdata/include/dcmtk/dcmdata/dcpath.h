@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2008-2023, OFFIS e.V.
+ *  Copyright (C) 2008-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -26,6 +26,7 @@
 #include "dcmtk/config/osconfig.h" /* make sure OS specific configuration is included first */
 
 #include "dcmtk/dcmdata/dcdatset.h"
+#include "dcmtk/ofstd/ofvector.h"
 
 /** Class representing a node in DcmPath. A node contains just
  * a pointer to a DcmObject (e.g. a sequence or an item). Additionally
@@ -520,4 +521,122 @@ private:
     DcmPathProcessor& operator=(const DcmPathProcessor& arg);
 };
 
+
+/** Class representing a selection of attributes (a "whitelist") that should
+ *  be read from a dataset. All other attributes are skipped by the parser
+ *  and never created as DcmElement objects, see DcmItem::setReadSelection().
+ *  The attributes are added in the path syntax used by DcmPathProcessor,
+ *  e.g.\ "PatientName", "(0010,0020)" or
+ *  "ReferencedSeriesSequence[*].SeriesInstanceUID". If the path ends with
+ *  a sequence (or an item of a sequence), the complete sequence is selected;
+ *  otherwise only the given attributes within the items of the sequence are
+ *  read. Item numbers are accepted but not evaluated, i.e.\ all items of a
+ *  sequence are filtered in the same way. Private tags are selected by tag
+ *  number only; the private creator elements of a group that contains
+ *  selected private tags are always retained in order to identify the tags.
+ */
+class DCMTK_DCMDATA_EXPORT DcmTagSelection
+{
+
+public:
+
+    /** Constructor, creates an empty selection, i.e.\ no attribute is
+     *  selected at all
+     */
+    DcmTagSelection();
+
+    /** Destructor
+     */
+    ~DcmTagSelection();
+
+    /** adds the attribute or sequence path in the path syntax of
+     *  DcmPathProcessor to this selection
+     *  @param path the path to be added, e.g.\ "ContentSequence[*].CodeValue"
+     *  @return EC_Normal if successful, error code otherwise
+     */
+    OFCondition addPath(const OFString& path);
+
+    /** adds the given attribute on the main level of this selection. If the
+     *  attribute is a sequence, it is selected completely.
+     *  @param tag the tag of the attribute to be added
+     */
+    void addTag(const DcmTagKey& tag);
+
+    /** removes all attributes from this selection
+     */
+    void clear();
+
+    /** checks whether this selection is empty
+     *  @return OFTrue if no attribute is selected, OFFalse otherwise
+     */
+    OFBool empty() const;
+
+    /** checks whether the given attribute should be read, either completely
+     *  or partially (in case of a sequence)
+     *  @param tag the tag of the attribute to be checked
+     *  @return OFTrue if the attribute is selected, OFFalse otherwise
+     */
+    OFBool isSelected(const DcmTagKey& tag) const;
+
+    /** returns the selection that applies to the items of the given sequence
+     *  @param tag the tag of the sequence
+     *  @return selection for the items, or NULL if the sequence is selected
+     *    completely (or not at all, see isSelected())
+     */
+    const DcmTagSelection* getItemSelection(const DcmTagKey& tag) const;
+
+    /** checks whether the given attribute is a private creator element that
+     *  is needed to identify selected private tags on this level
+     *  @param tag the tag of the attribute to be checked
+     *  @return OFTrue if the attribute is a needed private creator element
+     */
+    OFBool isNeededPrivateCreator(const DcmTagKey& tag) const;
+
+private:
+
+    /** entry of the selection, i.e.\ a selected attribute on this level
+     */
+    struct SelectionEntry
+    {
+        /// tag of the selected attribute
+        DcmTagKey tag;
+        /// selection for the items of the sequence, NULL if the attribute
+        /// is selected completely
+        DcmTagSelection *itemSelection;
+    };
+
+    /** finds the position of the given tag in the sorted list of entries
+     *  @param tag the tag to be searched for
+     *  @return index of the first entry whose tag is not less than the given tag
+     */
+    size_t lowerBound(const DcmTagKey& tag) const;
+
+    /** finds the entry for the given tag
+     *  @param tag the tag to be searched for
+     *  @return pointer to the entry if found, NULL otherwise
+     */
+    const SelectionEntry* findEntry(const DcmTagKey& tag) const;
+
+    /** adds the (remaining) path to this selection level
+     *  @param path [in/out] the path to be added, parsed components are
+     *    removed
+     *  @return EC_Normal if successful, error code otherwise
+     */
+    OFCondition addPathComponents(OFString& path);
+
+    /// selected attributes on this level, sorted by tag
+    OFVector<SelectionEntry> m_selection;
+
+    /** Private undefined copy constructor
+     *  @param rhs Object to copy from
+     */
+    DcmTagSelection(const DcmTagSelection& rhs);
+
+    /** Private undefined assignment operator
+     *  @param arg Object to copy from
+     *  @return Reference to this object
+     */
+    DcmTagSelection& operator=(const DcmTagSelection& arg);
+};
+
 #endif // DCPATH_H
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2023, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -101,6 +101,14 @@ public:
    */
   void updateCache(DcmObject *dobj);
 
+  /** updates the private creator cache with the given private creator
+   *  element tag and identifier, e.g.\ when parsing a dataset without
+   *  creating element objects.
+   *  @param tk tag of the private creator element
+   *  @param pc private creator identifier
+   */
+  void updateCache(const DcmTagKey& tk, const char *pc);
+
 private:
 
   /// private undefined copy constructor
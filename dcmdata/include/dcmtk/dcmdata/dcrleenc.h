@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2022, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -173,7 +173,20 @@ public:
   {
     if (buf)
     {
-      while (bufcount--) add(*buf++);
+      const unsigned char *end = buf + bufcount;
+      while (buf < end)
+      {
+        if ((! fail_) && (OFstatic_cast(int, *buf) == RLE_prev_))
+        {
+          // continuation of the current repeat run: count all identical
+          // bytes at once instead of passing them one by one to add()
+          const unsigned char *runStart = buf;
+          const unsigned char ch = *buf;
+          while ((++buf < end) && (*buf == ch)) /* nothing */ ;
+          RLE_pcount_ += OFstatic_cast(int, buf - runStart);
+        }
+        else add(*buf++);
+      }
     }
   }
 
@@ -350,7 +363,12 @@ private:
           break;    // exit while loop
         }
       }
-      currentBlock_[offset_++] = RLE_buff_[i++];
+      // copy as many bytes as fit into the current block
+      size_t count = numberOfBytes - i;
+      if (count > DcmRLEEncoder_BLOCKSIZE - offset_) count = DcmRLEEncoder_BLOCKSIZE - offset_;
+      memcpy(currentBlock_ + offset_, RLE_buff_ + i, count);
+      offset_ += count;
+      i += count;
     }
   }
 
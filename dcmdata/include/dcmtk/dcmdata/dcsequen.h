@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2020, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -33,6 +33,7 @@
 
 // forward declarations
 class DcmJsonFormat;
+class DcmTagSelection;
 
 /** class representing a DICOM Sequence of Items (SQ).
  *  This class is derived from class DcmElement (and not from DcmObject) despite the fact
@@ -505,6 +506,25 @@ public:
                                         DcmFileCache *cache = NULL,
                                         E_ByteOrder byteOrder = gLocalByteOrder);
 
+    /** sets the selection of attributes that is passed to the items of this
+     *  sequence when they are created while reading, see
+     *  DcmItem::setReadSelection() for details.
+     *  @param selection the attributes to be read from each item, NULL to
+     *    read all attributes. NULL also clears the selection of all items
+     *    that have been read so far. The selection is not copied and must
+     *    remain valid until reading is completed.
+     */
+    void setItemReadSelection(const DcmTagSelection *selection);
+
+    /** returns the selection of attributes that is passed to the items of
+     *  this sequence when they are created while reading
+     *  @return selection of attributes, NULL if all attributes are read
+     */
+    const DcmTagSelection *getItemReadSelection() const
+    {
+        return itemReadSelection;
+    }
+
 protected:
 
     /** constructor. Create new element from given tag and length.
@@ -622,6 +642,9 @@ private:
      */
     OFBool readAsUN_;
 
+    /// selection of attributes to be read from the items of this sequence
+    const DcmTagSelection *itemReadSelection;
+
 };
 
 
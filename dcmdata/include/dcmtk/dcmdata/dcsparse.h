@@ -0,0 +1,286 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: event-driven parser for DICOM files and datasets
+ *
+ */
+
+#ifndef DCSPARSE_H
+#define DCSPARSE_H
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/ofvector.h"     /* for class OFVector */
+#include "dcmtk/ofstd/ofstd.h"        /* for class OFFilename */
+#include "dcmtk/dcmdata/dcerror.h"    /* for OFCondition */
+#include "dcmtk/dcmdata/dctag.h"      /* for class DcmTag */
+#include "dcmtk/dcmdata/dcxfer.h"     /* for E_TransferSyntax */
+
+class DcmInputStream;
+class DcmStreamParserItem;
+
+
+/** abstract handler for the events reported by class DcmStreamParser.
+ *  All methods have a default implementation that ignores the event, so a
+ *  derived class only needs to implement the events it is interested in.
+ *  If a method returns an error code, parsing is stopped and the error code
+ *  is returned by the parser.
+ */
+class DCMTK_DCMDATA_EXPORT DcmParserHandler
+{
+public:
+
+  /// destructor
+  virtual ~DcmParserHandler();
+
+  /** called after the file meta information (if any) has been parsed and
+   *  before the first data element of the dataset is reported
+   *  @param xfer transfer syntax of the dataset
+   *  @return EC_Normal to continue parsing, an error code otherwise
+   */
+  virtual OFCondition startDataset(const E_TransferSyntax xfer);
+
+  /** called when the end of the dataset has been reached
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  virtual OFCondition endDataset();
+
+  /** called for each data element that is neither a sequence nor encapsulated
+   *  pixel data, including the elements of the file meta information.
+   *  @param tag tag of the data element, including the VR and, for private
+   *    data elements, the private creator identifier
+   *  @param length value length in bytes
+   *  @param readValue set to OFFalse if the value is not needed, in which case
+   *    it is skipped and elementValue() is not called for this element.
+   *    Initialized to OFTrue.
+   *  @return EC_Normal to continue parsing, an error code otherwise
+   */
+  virtual OFCondition elementHeader(const DcmTag& tag,
+                                    const Uint32 length,
+                                    OFBool& readValue);
+
+  /** called with the value of the current data element, possibly in several
+   *  chunks of consecutive bytes. The data is passed in the byte order of the
+   *  transfer syntax and without any conversion. Not called for empty values.
+   *  @param tag tag of the data element
+   *  @param data pointer to the chunk, only valid during this call
+   *  @param length number of bytes in this chunk
+   *  @param offset offset of this chunk within the value, in bytes
+   *  @return EC_Normal to continue parsing, an error code otherwise
+   */
+  virtual OFCondition elementValue(const DcmTag& tag,
+                                   const Uint8 *data,
+                                   const Uint32 length,
+                                   const Uint32 offset);
+
+  /** called at the start of a sequence
+   *  @param tag tag of the sequence
+   *  @param length value length of the sequence, may be undefined length
+   *  @return EC_Normal to continue parsing, an error code otherwise
+   */
+  virtual OFCondition startSequence(const DcmTag& tag,
+                                    const Uint32 length);
+
+  /** called at the end of a sequence
+   *  @param tag tag of the sequence
+   *  @return EC_Normal to continue parsing, an error code otherwise
+   */
+  virtual OFCondition endSequence(const DcmTag& tag);
+
+  /** called at the start of an item within a sequence
+   *  @param length length of the item, may be undefined length
+   *  @return EC_Normal to continue parsing, an error code otherwise
+   */
+  virtual OFCondition startItem(const Uint32 length);
+
+  /** called at the end of an item within a sequence
+   *  @return EC_Normal to continue parsing, an error code otherwise
+   */
+  virtual OFCondition endItem();
+
+  /** called at the start of encapsulated pixel data
+   *  @param tag tag of the pixel data element
+   *  @return EC_Normal to continue parsing, an error code otherwise
+   */
+  virtual OFCondition startPixelSequence(const DcmTag& tag);
+
+  /** called with the content of a pixel data fragment, possibly in several
+   *  chunks of consecutive bytes. An empty fragment is reported by a single
+   *  call with length 0.
+   *  @param fragment number of the fragment, 0 being the basic offset table
+   *  @param data pointer to the chunk, only valid during this call
+   *  @param length number of bytes in this chunk
+   *  @param offset offset of this chunk within the fragment, in bytes
+   *  @param fragmentLength total length of the fragment, in bytes
+   *  @return EC_Normal to continue parsing, an error code otherwise
+   */
+  virtual OFCondition pixelFragment(const Uint32 fragment,
+                                    const Uint8 *data,
+                                    const Uint32 length,
+                                    const Uint32 offset,
+                                    const Uint32 fragmentLength);
+
+  /** called at the end of encapsulated pixel data
+   *  @return EC_Normal to continue parsing, an error code otherwise
+   */
+  virtual OFCondition endPixelSequence();
+};
+
+
+/** event-driven parser for DICOM files and datasets. In contrast to
+ *  DcmFileFormat::loadFile() and DcmItem::read(), this class does not create
+ *  a tree of DcmObject instances. Instead, it walks through the input stream
+ *  and reports each data element header, the value bytes, the start and end
+ *  of sequences and items, and pixel data fragments to a DcmParserHandler.
+ *  Values that are not needed by the handler are skipped without copying.
+ *  Tag and length fields are read with the same code as used by DcmItem, so
+ *  global parser flags such as dcmPreferVRFromDataDictionary are obeyed.
+ *  The input stream must provide all data on request, i.e. it must not be
+ *  a stream that suspends I/O, such as a network stream.
+ */
+class DCMTK_DCMDATA_EXPORT DcmStreamParser
+{
+public:
+
+  /** constructor
+   *  @param handler handler to which the parser events are reported.
+   *    The handler must remain valid until this object is destroyed.
+   */
+  DcmStreamParser(DcmParserHandler& handler);
+
+  /// destructor
+  virtual ~DcmStreamParser();
+
+  /** parses a DICOM file, i.e.\ the file meta information (if present) and
+   *  the dataset.
+   *  @param fileName name of the file to be parsed
+   *  @param readXfer transfer syntax used to parse the dataset if the file
+   *    has no file meta information. EXS_Unknown means auto detection.
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition parseFile(const OFFilename& fileName,
+                        const E_TransferSyntax readXfer = EXS_Unknown);
+
+  /** parses a DICOM file from an input stream, i.e.\ the file meta information
+   *  (if present) and the dataset.
+   *  @param inStream stream from which the file is read
+   *  @param readXfer transfer syntax used to parse the dataset if the file
+   *    has no file meta information. EXS_Unknown means auto detection.
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition parseFileFormat(DcmInputStream& inStream,
+                              const E_TransferSyntax readXfer = EXS_Unknown);
+
+  /** parses a dataset without file meta information from an input stream
+   *  until the end of the stream is reached.
+   *  @param inStream stream from which the dataset is read
+   *  @param xfer transfer syntax of the dataset. EXS_Unknown means auto detection.
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition parseDataset(DcmInputStream& inStream,
+                           const E_TransferSyntax xfer);
+
+  /** sets the maximum number of bytes that are passed to the handler in one
+   *  call of DcmParserHandler::elementValue() or DcmParserHandler::pixelFragment().
+   *  @param chunkSize maximum chunk size in bytes, must be larger than 0
+   */
+  void setChunkSize(const Uint32 chunkSize);
+
+private:
+
+  /// private undefined copy constructor
+  DcmStreamParser(const DcmStreamParser&);
+
+  /// private undefined copy assignment operator
+  DcmStreamParser& operator=(const DcmStreamParser&);
+
+  /** parses the content of the dataset or an item
+   *  @param inStream stream from which the content is read
+   *  @param xfer transfer syntax of the content
+   *  @param length length of the item, undefined length for a dataset or an item
+   *    that ends with an item delimitation item
+   *  @param isDataset true if the content of the dataset is parsed
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition parseItemContent(DcmInputStream& inStream,
+                               const E_TransferSyntax xfer,
+                               const Uint32 length,
+                               const OFBool isDataset);
+
+  /** parses the items of a sequence
+   *  @param reader helper item of the enclosing dataset or item
+   *  @param inStream stream from which the sequence is read
+   *  @param xfer transfer syntax of the sequence
+   *  @param tag tag of the sequence
+   *  @param length length of the sequence, may be undefined length
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition parseSequence(DcmStreamParserItem& reader,
+                            DcmInputStream& inStream,
+                            const E_TransferSyntax xfer,
+                            const DcmTag& tag,
+                            const Uint32 length);
+
+  /** parses the fragments of encapsulated pixel data
+   *  @param reader helper item of the enclosing dataset or item
+   *  @param inStream stream from which the pixel data is read
+   *  @param xfer transfer syntax of the pixel data
+   *  @param tag tag of the pixel data element
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition parsePixelSequence(DcmStreamParserItem& reader,
+                                 DcmInputStream& inStream,
+                                 const E_TransferSyntax xfer,
+                                 const DcmTag& tag);
+
+  /** reads the value of a data element or pixel fragment and passes it to the
+   *  handler in chunks.
+   *  @param inStream stream from which the value is read
+   *  @param tag tag of the data element
+   *  @param length value length in bytes
+   *  @param fragment number of the pixel fragment, or DCM_UndefinedLength
+   *    if the value of a data element is read
+   *  @param notifyHandler if false, the value is read without passing it to the handler
+   *  @param value if not NULL, a copy of the complete value is stored here
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition readValue(DcmInputStream& inStream,
+                        const DcmTag& tag,
+                        const Uint32 length,
+                        const Uint32 fragment,
+                        const OFBool notifyHandler,
+                        OFString *value);
+
+  /** skips the value of a data element
+   *  @param inStream stream from which the value is read
+   *  @param length value length in bytes
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition skipValue(DcmInputStream& inStream,
+                        const Uint32 length);
+
+  /// handler to which the parser events are reported
+  DcmParserHandler& handler_;
+
+  /// maximum number of bytes passed to the handler at once
+  Uint32 chunkSize_;
+
+  /// buffer for reading values
+  OFVector<Uint8> buffer_;
+};
+
+#endif
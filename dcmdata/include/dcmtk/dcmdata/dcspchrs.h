@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2017, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -30,6 +30,11 @@
 #include "dcmtk/dcmdata/dcdefine.h"
 
 
+/// default maximum number of unused converters kept in the process-wide cache
+/// of DcmSpecificCharacterSet::acquireConverter()
+#define DCMTK_CHARSET_CONVERTER_CACHE_SIZE 32
+
+
 // forward declaration
 class DcmItem;
 
@@ -223,6 +228,51 @@ class DCMTK_DCMDATA_EXPORT DcmSpecificCharacterSet
      */
     static size_t countCharactersInUTF8String(const OFString &utf8String);
 
+    /** get a character set converter for the given combination of source and
+     *  destination character set from a process-wide cache.  Opening the
+     *  conversion descriptors of the underlying character encoding library is
+     *  rather expensive, so converters that are no longer needed should be
+     *  passed to releaseConverter() and are then reused by subsequent calls
+     *  of this method.  A converter is only used by a single caller at a time,
+     *  i.e.\ this method may be called concurrently from different threads,
+     *  each of them getting its own converter.  If the converter is modified
+     *  (e.g.\ by calling selectCharacterSet() or setConversionFlags()), it is
+     *  deleted by releaseConverter() instead of being cached.
+     *  @param  fromCharset  name of the source character set(s), see
+     *                       selectCharacterSet()
+     *  @param  toCharset    name of the destination character set, see
+     *                       selectCharacterSet()
+     *  @param  flags        conversion flags, see setConversionFlags().  0 means
+     *                       that the default flags are used.
+     *  @param  converter    reference to variable where the converter is stored.
+     *                       Set to NULL if an error occurred.
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    static OFCondition acquireConverter(const OFString &fromCharset,
+                                        const OFString &toCharset,
+                                        const unsigned flags,
+                                        DcmSpecificCharacterSet *&converter);
+
+    /** return a converter that has been created by acquireConverter() to the
+     *  process-wide cache.  If the cache is full or the converter has been
+     *  modified, the converter is deleted.
+     *  @param  converter  converter to be returned (might be NULL).  The
+     *                     converter must not be used after this call.
+     */
+    static void releaseConverter(DcmSpecificCharacterSet *converter);
+
+    /** set the maximum number of unused converters that are kept in the
+     *  process-wide cache of acquireConverter().  If the cache currently
+     *  contains more converters, all of them are deleted.
+     *  @param  maxSize  maximum number of converters, 0 disables the cache
+     */
+    static void setConverterCacheSize(const size_t maxSize);
+
+    /** delete all unused converters from the process-wide cache of
+     *  acquireConverter()
+     */
+    static void clearConverterCache();
+
 
   protected:
 
@@ -276,6 +326,25 @@ class DCMTK_DCMDATA_EXPORT DcmSpecificCharacterSet
     OFString convertToLengthLimitedOctalString(const char *strValue,
                                                const size_t strLength) const;
 
+    /** check whether the given character encoding is a superset of ASCII, i.e.\
+     *  all characters in the range 0x00 to 0x7f have the same meaning as in ASCII
+     *  @param  encoding  name of the character encoding as used by the
+     *                    underlying character encoding library
+     *  @return OFTrue if the encoding is compatible with ASCII, OFFalse otherwise
+     */
+    static OFBool isASCIICompatibleEncoding(const OFString &encoding);
+
+    /** check whether the given string consists of ASCII characters only, which
+     *  are not affected by a conversion between ASCII compatible encodings.
+     *  The escape character (ESC) is not regarded as such a character.
+     *  @param  strValue   input string to be checked
+     *  @param  strLength  length of the input string
+     *  @return OFTrue if the string can be copied without conversion, OFFalse
+     *    otherwise
+     */
+    static OFBool isPlainASCIIString(const char *strValue,
+                                     const size_t strLength);
+
 
   private:
 
@@ -305,6 +374,15 @@ class DCMTK_DCMDATA_EXPORT DcmSpecificCharacterSet
     /// map of character set conversion descriptors
     /// (only used if multiple character sets are needed)
     T_EncodingConvertersMap EncodingConverters;
+
+    /// flag indicating whether both the default source encoding and the
+    /// destination encoding are compatible with ASCII, i.e.\ whether ASCII
+    /// strings can be copied without calling the conversion library
+    OFBool ASCIIPassThrough;
+
+    /// key of this converter in the process-wide cache (empty if the converter
+    /// has not been created by acquireConverter())
+    OFString CacheKey;
 };
 
 
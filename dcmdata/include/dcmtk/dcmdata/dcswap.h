@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -51,6 +51,41 @@ DCMTK_DCMDATA_EXPORT void swapBytes(
   const Uint32 byteLength,
   const size_t valWidth);
 
+/** copy block of data and swap it from big-endian to little-endian or back
+ *  while copying. This is faster than copying the data and swapping it in
+ *  place afterwards since the data is only touched once. Bytes at the end of
+ *  the block that do not form a complete value are copied unchanged.
+ *  @param target pointer to target block of at least byteLength bytes
+ *  @param source pointer to block of data to be copied. May be identical to
+ *    target (in which case the data is swapped in place), but must not
+ *    overlap otherwise.
+ *  @param byteLength size of data block in bytes
+ *  @param valWidth size of each value in the data block, in bytes
+ */
+DCMTK_DCMDATA_EXPORT void swapBytesCopy(
+  void * target,
+  const void * source,
+  const Uint32 byteLength,
+  const size_t valWidth);
+
+/** copy block of data and swap it from big-endian to little-endian or back
+ *  while copying, if necessary. If no swapping is needed, the data is just copied.
+ *  @param newByteOrder desired byte order of target block
+ *  @param oldByteOrder byte order of source block
+ *  @param target pointer to target block of at least byteLength bytes
+ *  @param source pointer to block of data to be copied, must not overlap with target
+ *  @param byteLength size of data block in bytes
+ *  @param valWidth size of each value in the data block, in bytes
+ *  @return EC_Normal if successful, an error code otherwise
+ */
+DCMTK_DCMDATA_EXPORT OFCondition copySwapIfNecessary(
+  const E_ByteOrder newByteOrder,
+  const E_ByteOrder oldByteOrder,
+  void * target,
+  const void * source,
+  const Uint32 byteLength,
+  const size_t valWidth);
+
 /** swap an Uint16 number from big-endian to little-endian or back
  *  @param toSwap number to be swapped
  *  @return swapped number
@@ -0,0 +1,301 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: streaming writer for DICOM datasets
+ *
+ */
+
+#ifndef DCSWRITE_H
+#define DCSWRITE_H
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/ofvector.h"     /* for class OFVector */
+#include "dcmtk/dcmdata/dcerror.h"    /* for OFCondition */
+#include "dcmtk/dcmdata/dctag.h"      /* for class DcmTag */
+#include "dcmtk/dcmdata/dcxfer.h"     /* for E_TransferSyntax */
+#include "dcmtk/dcmdata/dcwcache.h"   /* for class DcmWriteCache */
+
+class DcmObject;
+class DcmOutputStream;
+
+
+/** This class writes a DICOM file or dataset to an output stream on the fly,
+ *  without building the complete dataset in memory. The application pushes
+ *  data elements, begin/end events for sequences and items, and the pixel data
+ *  in chunks (native format) or fragments (encapsulated format), in ascending
+ *  tag order. Each call immediately serializes its data to the output stream.
+ *
+ *  Sequences and items are always written with undefined length, so no length
+ *  needs to be fixed up afterwards. Native pixel data cannot be encoded with
+ *  undefined length; its length must be announced in beginPixelData() and is
+ *  checked when endPixelData() is called. Encapsulated pixel data is written
+ *  with an empty basic offset table, one fragment per call of writePixelData().
+ *  Group length elements and dataset trailing padding are not created.
+ *
+ *  The output stream must be blocking, i.e. it must accept all data passed to
+ *  it (e.g. DcmOutputFileStream). A typical use looks like this:
+ *  @code
+ *  DcmOutputFileStream out("image.dcm");
+ *  DcmStreamingWriter writer(out, EXS_LittleEndianExplicit);
+ *  writer.writeMetaHeader(sopClassUID, sopInstanceUID);
+ *  writer.writeString(DCM_SOPClassUID, sopClassUID);
+ *  // ... further elements in ascending tag order ...
+ *  writer.beginPixelData(frameSize * numberOfFrames);
+ *  for (...) writer.writePixelData(frame, frameSize);
+ *  writer.endPixelData();
+ *  writer.finish();
+ *  @endcode
+ *  Once an error has occurred, all further calls return this error.
+ */
+class DCMTK_DCMDATA_EXPORT DcmStreamingWriter
+{
+public:
+
+  /** constructor
+   *  @param outStream output stream to which the dataset is written.
+   *    The stream must remain valid until this object is destroyed.
+   *  @param xfer transfer syntax of the dataset. Big endian implicit is not supported.
+   */
+  DcmStreamingWriter(DcmOutputStream& outStream, const E_TransferSyntax xfer);
+
+  /// destructor
+  virtual ~DcmStreamingWriter();
+
+  /** writes the file preamble, the DICOM prefix and the file meta information.
+   *  If this method is used, it must be called before any other write operation.
+   *  If it is not called, a plain dataset without file meta information is written.
+   *  @param sopClassUID value of the Media Storage SOP Class UID
+   *  @param sopInstanceUID value of the Media Storage SOP Instance UID
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeMetaHeader(const OFString& sopClassUID,
+                              const OFString& sopInstanceUID);
+
+  /** writes a complete data element or sequence (including all its items)
+   *  at the current nesting level. The object remains owned by the caller
+   *  and may be deleted or reused after this call.
+   *  @param object data element or sequence to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeElement(DcmObject& object);
+
+  /** creates a data element with the given string value and writes it.
+   *  The VR is taken from the data dictionary.
+   *  @param tag tag of the data element
+   *  @param value string value, multiple values separated by backslash
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeString(const DcmTag& tag,
+                          const OFString& value);
+
+  /** creates a data element with the given 16-bit unsigned value and writes it.
+   *  The VR is taken from the data dictionary and should be US, OW or xs.
+   *  @param tag tag of the data element
+   *  @param value value to be written
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeUint16(const DcmTag& tag,
+                          const Uint16 value);
+
+  /** starts a sequence at the current nesting level.
+   *  The sequence is written with undefined length.
+   *  @param tag tag of the sequence
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition beginSequence(const DcmTag& tag);
+
+  /** ends the current sequence, i.e.\ writes a sequence delimitation item
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition endSequence();
+
+  /** starts a new item in the current sequence.
+   *  The item is written with undefined length.
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition beginItem();
+
+  /** ends the current item, i.e.\ writes an item delimitation item
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition endItem();
+
+  /** starts native (uncompressed) pixel data at the current nesting level.
+   *  Only permitted if the transfer syntax is not encapsulated.
+   *  @param length total number of bytes that will be passed to writePixelData().
+   *    An odd length is padded with a zero byte.
+   *  @param vr value representation of the pixel data, OB or OW
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition beginPixelData(const Uint32 length,
+                             const DcmEVR vr = EVR_OW);
+
+  /** starts encapsulated pixel data at the current nesting level and writes
+   *  an empty basic offset table. Only permitted if the transfer syntax is
+   *  encapsulated.
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition beginEncapsulatedPixelData();
+
+  /** writes pixel data. For native pixel data, the data is appended to the
+   *  value and may be passed in chunks of any size. 16-bit data (VR OW) must
+   *  be in local byte order and is converted to the byte order of the transfer
+   *  syntax if necessary; in this case, the length of each chunk must be even.
+   *  For encapsulated pixel data, each call writes one
+   *  fragment, e.g.\ a complete compressed frame. An odd fragment length is
+   *  padded with a zero byte.
+   *  @param data pointer to the data
+   *  @param length number of bytes to write
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writePixelData(const void *data,
+                             const Uint32 length);
+
+  /** ends the pixel data. For native pixel data, the number of bytes written
+   *  must match the length announced in beginPixelData().
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition endPixelData();
+
+  /** checks that all sequences, items and pixel data have been closed and
+   *  flushes the output stream.
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition finish();
+
+  /** returns the current status of the writer
+   *  @return EC_Normal if no error has occurred so far, the first error otherwise
+   */
+  OFCondition status() const
+  {
+    return status_;
+  }
+
+private:
+
+  /// private undefined copy constructor
+  DcmStreamingWriter(const DcmStreamingWriter&);
+
+  /// private undefined copy assignment operator
+  DcmStreamingWriter& operator=(const DcmStreamingWriter&);
+
+  /// kind of a nesting level
+  enum E_Level
+  {
+    /// top level dataset
+    EL_dataset,
+    /// item of a sequence
+    EL_item,
+    /// sequence (containing items)
+    EL_sequence
+  };
+
+  /// state of the pixel data
+  enum E_PixelDataState
+  {
+    /// not within pixel data
+    EPS_none,
+    /// within native pixel data
+    EPS_native,
+    /// within encapsulated pixel data
+    EPS_encapsulated
+  };
+
+  /** starts the dataset, i.e.\ installs the compression filter for deflated
+   *  transfer syntaxes. Does nothing if the dataset has already been started.
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition startDataset();
+
+  /** checks that a data element with the given tag may be written at the current
+   *  nesting level and records its tag. Also starts the dataset if necessary.
+   *  @param tag tag of the data element to be written
+   *  @return EC_Normal if permitted, an error code otherwise
+   */
+  OFCondition checkElement(const DcmTagKey& tag);
+
+  /** writes the given buffer to the output stream
+   *  @param data pointer to the data
+   *  @param length number of bytes to write
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeRaw(const void *data, const Uint32 length);
+
+  /** writes tag, VR (for explicit VR transfer syntaxes) and length field
+   *  @param tag tag to be written
+   *  @param vr value representation, must use extended length encoding
+   *  @param length value of the length field
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeHeader(const DcmTagKey& tag, const DcmEVR vr, const Uint32 length);
+
+  /** writes an item, item delimitation or sequence delimitation tag together
+   *  with its length field. These are never preceded by a VR.
+   *  @param tag tag to be written
+   *  @param length value of the length field
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition writeItemHeader(const DcmTagKey& tag, const Uint32 length);
+
+  /// output stream
+  DcmOutputStream& outStream_;
+
+  /// transfer syntax of the dataset
+  E_TransferSyntax xfer_;
+
+  /// byte order of the dataset
+  E_ByteOrder byteOrder_;
+
+  /// true if the transfer syntax uses explicit VR
+  OFBool explicitVR_;
+
+  /// status, contains the first error that occurred
+  OFCondition status_;
+
+  /// true if the file meta information has been written
+  OFBool metaHeaderWritten_;
+
+  /// true if the dataset has been started, i.e. the file meta information may no longer be written
+  OFBool datasetStarted_;
+
+  /// kind of each nesting level, the first entry is the top level dataset
+  OFVector<E_Level> levels_;
+
+  /// tag of the last data element written at each nesting level
+  OFVector<DcmTagKey> lastTags_;
+
+  /// state of the pixel data
+  E_PixelDataState pixelDataState_;
+
+  /// announced length of native pixel data, in bytes
+  Uint32 pixelDataLength_;
+
+  /// number of native pixel data bytes written so far
+  Uint32 pixelDataWritten_;
+
+  /// true if native pixel data must be swapped to the byte order of the transfer syntax
+  OFBool swapPixelData_;
+
+  /// buffer used for swapping native pixel data while copying
+  OFVector<Uint8> swapBuffer_;
+
+  /// write cache used for data elements with values that reside in file
+  DcmWriteCache writeCache_;
+};
+
+#endif
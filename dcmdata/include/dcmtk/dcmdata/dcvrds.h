@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2019, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -152,6 +152,19 @@ class DCMTK_DCMDATA_EXPORT DcmDecimalString
                                        const Uint8 prec = 6,
                                        const OFBool cutTrailZeroes = OFTrue);
 
+    /** replace the element value by the given array of float values.
+     *  Each value is converted to the shortest decimal string (at most 16 characters)
+     *  from which the same floating point value is obtained again. If the value
+     *  cannot be represented exactly in 16 characters, the most precise string that
+     *  fits is used. The conversion is not affected by a locale setting.
+     *  @param doubleVals array of float values to be stored
+     *  @param numDoubles number of values in the array doubleVals
+     *  @return status, EC_Normal if successful, an error code otherwise
+     *    (e.g. EC_IllegalParameter for values that are not finite or too large)
+     */
+    virtual OFCondition putFloat64Array(const Float64 *doubleVals,
+                                        const unsigned long numDoubles);
+
     /** write object in XML format
      *  @param out output stream to which the XML document is written
      *  @param flags optional flag used to customize the output (see DCMTypes::XF_xxx)
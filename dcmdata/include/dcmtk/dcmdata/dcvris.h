@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2020, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -24,6 +24,7 @@
 
 #include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
 
+#include "dcmtk/ofstd/ofvector.h"
 #include "dcmtk/dcmdata/dcbytstr.h"
 
 
@@ -106,6 +107,27 @@ class DCMTK_DCMDATA_EXPORT DcmIntegerString
     virtual OFCondition getSint32(Sint32 &sintVal,
                                   const unsigned long pos = 0);
 
+    /** get stored integer values as a vector.
+     *  The values are converted directly within the stored string value, i.e.\ without
+     *  creating a temporary string for each value.
+     *  Please note that only an element value consisting of zero or more spaces is considered
+     *  as being empty and, therefore, results in an empty vector with status ".good()"; use
+     *  isEmpty() before calling this method if you also want to check for other non-significant
+     *  characters (e.g. the backslash).
+     *  @param sintVals reference to result variable
+     *    (cleared automatically before entries are added)
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition getSint32Vector(OFVector<Sint32> &sintVals);
+
+    /** replace the element value by the given array of integer values
+     *  @param sintVals array of integer values to be stored
+     *  @param numSints number of values in the array sintVals
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition putSint32Array(const Sint32 *sintVals,
+                                       const unsigned long numSints);
+
     /** get a particular value as a character string
      *  @param stringVal variable in which the result value is stored
      *  @param pos index of the value in case of multi-valued elements (0..vm-1)
@@ -0,0 +1,336 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: memory arena for DcmObject trees
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmdata/dcarena.h"
+
+#include <new>
+
+#ifdef HAVE_WINDOWS_H
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>       /* for MemoryBarrier() */
+#endif
+
+/* alignment of the blocks allocated from an arena. 16 bytes keep the blocks
+ * aligned for any fundamental type.
+ */
+#define DCMARENA_ALIGNMENT 16
+
+/* round a block size up to a multiple of the alignment */
+#define DCMARENA_ALIGN(size) (((size) + DCMARENA_ALIGNMENT - 1) & ~OFstatic_cast(size_t, DCMARENA_ALIGNMENT - 1))
+
+
+/* entry of the global table of chunks */
+struct DcmMemoryArenaChunk
+{
+  /// first byte of the chunk
+  const Uint8 *begin;
+  /// first byte after the chunk
+  const Uint8 *end;
+  /// arena that owns the chunk
+  DcmMemoryArena *arena;
+};
+
+/* chunks of all arenas, sorted by address */
+static OFVector<DcmMemoryArenaChunk> dcmMemoryArenaChunks;
+
+#ifdef WITH_THREADS
+/* mutex protecting the table of chunks */
+static OFMutex dcmMemoryArenaChunksMutex;
+
+/* number of entries in the table of chunks. It is only changed while the
+ * mutex is held, but read without the mutex by findArena(), so that deleting
+ * an object does not lock the mutex as long as no arena has any chunks. The
+ * accesses use the same atomic loads and stores as the frozen data dictionary.
+ */
+static size_t dcmMemoryArenaChunkCount = 0;
+
+/* returns the number of chunks, can be called without holding the mutex */
+static inline size_t loadChunkCount()
+{
+#ifdef HAVE_ATOMIC_LOAD_N
+  return __atomic_load_n(&dcmMemoryArenaChunkCount, __ATOMIC_ACQUIRE);
+#else
+  const size_t count = *OFconst_cast(const volatile size_t *, &dcmMemoryArenaChunkCount);
+#ifdef HAVE_WINDOWS_H
+  MemoryBarrier();
+#elif defined(HAVE_SYNC_ADD_AND_FETCH)
+  __sync_synchronize();
+#endif
+  return count;
+#endif
+}
+
+/* updates the number of chunks, must be called with the mutex held */
+static inline void storeChunkCount()
+{
+  const size_t count = dcmMemoryArenaChunks.size();
+#ifdef HAVE_ATOMIC_LOAD_N
+  __atomic_store_n(&dcmMemoryArenaChunkCount, count, __ATOMIC_RELEASE);
+#else
+#ifdef HAVE_WINDOWS_H
+  MemoryBarrier();
+#elif defined(HAVE_SYNC_ADD_AND_FETCH)
+  __sync_synchronize();
+#endif
+  *OFconst_cast(volatile size_t *, &dcmMemoryArenaChunkCount) = count;
+#endif
+}
+#endif
+
+/* returns the index of the first chunk that starts after the given address */
+static size_t upperBoundChunk(const Uint8 *ptr)
+{
+  size_t first = 0;
+  size_t count = dcmMemoryArenaChunks.size();
+  while (count > 0)
+  {
+    const size_t step = count / 2;
+    if (dcmMemoryArenaChunks[first + step].begin <= ptr)
+    {
+      first += step + 1;
+      count -= step + 1;
+    }
+    else
+      count = step;
+  }
+  return first;
+}
+
+
+DcmMemoryArena::DcmMemoryArena(const size_t chunkSize)
+: chunkSize_(DCMARENA_ALIGN(chunkSize > DCMARENA_ALIGNMENT ? chunkSize : DcmMemoryArenaChunkSize))
+, chunks_()
+, largeChunks_()
+, currentChunk_(0)
+, offset_(0)
+, allocations_(0)
+, liveObjects_(0)
+, references_(1)
+#ifdef WITH_THREADS
+, mutex_()
+#endif
+{
+}
+
+
+DcmMemoryArena::~DcmMemoryArena()
+{
+  for (size_t i = 0; i < chunks_.size(); ++i) freeChunk(chunks_[i]);
+  freeLargeChunks();
+}
+
+
+void DcmMemoryArena::addReference()
+{
+#ifdef WITH_THREADS
+  mutex_.lock();
+#endif
+  ++references_;
+#ifdef WITH_THREADS
+  mutex_.unlock();
+#endif
+}
+
+
+void DcmMemoryArena::release()
+{
+#ifdef WITH_THREADS
+  mutex_.lock();
+#endif
+  const OFBool unused = (--references_ == 0) && (liveObjects_ == 0);
+#ifdef WITH_THREADS
+  mutex_.unlock();
+#endif
+  if (unused) delete this;
+}
+
+
+void *DcmMemoryArena::allocate(const size_t size, DcmMemoryArena *arena)
+{
+  if (arena)
+    return arena->allocateBlock(DCMARENA_ALIGN(size));
+  return ::operator new(size);
+}
+
+
+void DcmMemoryArena::deallocate(void *ptr)
+{
+  if (ptr)
+  {
+    DcmMemoryArena *arena = findArena(ptr);
+    if (arena)
+      arena->deallocateBlock();
+    else
+      ::operator delete(ptr);
+  }
+}
+
+
+void *DcmMemoryArena::allocateBlock(size_t size)
+{
+  void *result = NULL;
+#ifdef WITH_THREADS
+  mutex_.lock();
+#endif
+  if (size > chunkSize_)
+  {
+    // blocks that do not fit into a regular chunk get a chunk of their own
+    Uint8 *chunk = allocateChunk(size);
+    largeChunks_.push_back(chunk);
+    result = chunk;
+  }
+  else
+  {
+    if ((currentChunk_ < chunks_.size()) && (offset_ + size > chunkSize_))
+    {
+      ++currentChunk_;
+      offset_ = 0;
+    }
+    if (currentChunk_ == chunks_.size())
+    {
+      chunks_.push_back(allocateChunk(chunkSize_));
+      offset_ = 0;
+    }
+    result = chunks_[currentChunk_] + offset_;
+    offset_ += size;
+  }
+  ++allocations_;
+  ++liveObjects_;
+#ifdef WITH_THREADS
+  mutex_.unlock();
+#endif
+  return result;
+}
+
+
+void DcmMemoryArena::deallocateBlock()
+{
+  OFBool unused = OFFalse;
+#ifdef WITH_THREADS
+  mutex_.lock();
+#endif
+  if (--liveObjects_ == 0)
+  {
+    if (references_ == 0)
+      unused = OFTrue;
+    else
+    {
+      // all objects are gone, reuse the chunks for the next allocations
+      currentChunk_ = 0;
+      offset_ = 0;
+      freeLargeChunks();
+    }
+  }
+#ifdef WITH_THREADS
+  mutex_.unlock();
+#endif
+  if (unused) delete this;
+}
+
+
+Uint8 *DcmMemoryArena::allocateChunk(size_t size)
+{
+  Uint8 *chunk = new Uint8[size];
+  DcmMemoryArenaChunk entry;
+  entry.begin = chunk;
+  entry.end = chunk + size;
+  entry.arena = this;
+#ifdef WITH_THREADS
+  dcmMemoryArenaChunksMutex.lock();
+#endif
+  dcmMemoryArenaChunks.insert(dcmMemoryArenaChunks.begin() + upperBoundChunk(chunk), entry);
+#ifdef WITH_THREADS
+  storeChunkCount();
+  dcmMemoryArenaChunksMutex.unlock();
+#endif
+  return chunk;
+}
+
+
+void DcmMemoryArena::freeChunk(Uint8 *chunk)
+{
+#ifdef WITH_THREADS
+  dcmMemoryArenaChunksMutex.lock();
+#endif
+  const size_t index = upperBoundChunk(chunk);
+  if ((index > 0) && (dcmMemoryArenaChunks[index - 1].begin == chunk))
+    dcmMemoryArenaChunks.erase(dcmMemoryArenaChunks.begin() + (index - 1));
+#ifdef WITH_THREADS
+  storeChunkCount();
+  dcmMemoryArenaChunksMutex.unlock();
+#endif
+  delete[] chunk;
+}
+
+
+DcmMemoryArena *DcmMemoryArena::findArena(const void *ptr)
+{
+  const Uint8 *block = OFstatic_cast(const Uint8 *, ptr);
+  DcmMemoryArena *arena = NULL;
+#ifdef WITH_THREADS
+  /* a block allocated from an arena lies in a chunk that stays in the table
+   * until the block has been deallocated. Without any chunks, the block has
+   * been allocated with the global operator new.
+   */
+  if (loadChunkCount() == 0)
+    return NULL;
+  dcmMemoryArenaChunksMutex.lock();
+#endif
+  if (!dcmMemoryArenaChunks.empty())
+  {
+    // the block belongs to the last chunk that starts at or before it, if any
+    const size_t index = upperBoundChunk(block);
+    if ((index > 0) && (block < dcmMemoryArenaChunks[index - 1].end))
+      arena = dcmMemoryArenaChunks[index - 1].arena;
+  }
+#ifdef WITH_THREADS
+  dcmMemoryArenaChunksMutex.unlock();
+#endif
+  return arena;
+}
+
+
+void DcmMemoryArena::freeLargeChunks()
+{
+  for (size_t i = 0; i < largeChunks_.size(); ++i) freeChunk(largeChunks_[i]);
+  largeChunks_.clear();
+}
+
+
+size_t DcmMemoryArena::getNumberOfAllocations() const
+{
+  return allocations_;
+}
+
+
+size_t DcmMemoryArena::getNumberOfLiveObjects() const
+{
+  return liveObjects_;
+}
+
+
+size_t DcmMemoryArena::getNumberOfChunks() const
+{
+  return chunks_.size() + largeChunks_.size();
+}
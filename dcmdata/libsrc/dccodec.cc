@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2023, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -40,6 +40,349 @@ OFList<DcmCodecList *> DcmCodecList::registeredCodecs;
 OFReadWriteLock DcmCodecList::codecLock;
 #endif
 
+// global flags
+OFGlobal<Uint32> dcmDecompressionThreads(1);
+
+#ifdef WITH_THREADS
+
+/** helper class that distributes the frames processed by
+ *  DcmCodec::decompressFrames() to the participating threads
+ *  and keeps track of the first error that occurred.
+ */
+class DcmFrameDecompressionQueue
+{
+public:
+  /** constructor
+   *  @param firstFrame number of the first frame to be processed
+   *  @param lastFrame number of the frame following the last frame to be processed
+   */
+  DcmFrameDecompressionQueue(Uint32 firstFrame, Uint32 lastFrame)
+  : mutex()
+  , nextFrame(firstFrame)
+  , endFrame(lastFrame)
+  , result(EC_Normal)
+  {
+  }
+
+  /** fetch the next frame to be processed
+   *  @param frameNo number of the frame returned in this parameter
+   *  @return OFTrue if a frame was returned, OFFalse if there are no more
+   *    frames or an error has occurred
+   */
+  OFBool next(Uint32& frameNo)
+  {
+    OFBool found = OFFalse;
+    mutex.lock();
+    if (result.good() && (nextFrame < endFrame))
+    {
+      frameNo = nextFrame++;
+      found = OFTrue;
+    }
+    mutex.unlock();
+    return found;
+  }
+
+  /** report the result of processing a frame
+   *  @param cond result of the decompression
+   */
+  void report(const OFCondition& cond)
+  {
+    if (cond.bad())
+    {
+      mutex.lock();
+      if (result.good()) result = cond;
+      mutex.unlock();
+    }
+  }
+
+  /** return the first error that occurred, or EC_Normal
+   *  @return result of the decompression
+   */
+  OFCondition status()
+  {
+    mutex.lock();
+    OFCondition cond = result;
+    mutex.unlock();
+    return cond;
+  }
+
+private:
+
+  /// mutex protecting all members
+  OFMutex mutex;
+
+  /// number of the next frame to be processed
+  Uint32 nextFrame;
+
+  /// number of the frame following the last frame to be processed
+  Uint32 endFrame;
+
+  /// first error that occurred
+  OFCondition result;
+};
+
+
+class DcmFrameThreadPool;
+
+/** worker thread of a DcmFrameThreadPool
+ */
+class DcmFrameDecompressionThread: public OFThread
+{
+public:
+  /** constructor
+   *  @param aPool thread pool this thread belongs to
+   *  @param aThreadNo number of this thread, passed to the task
+   */
+  DcmFrameDecompressionThread(DcmFrameThreadPool& aPool, Uint32 aThreadNo)
+  : OFThread()
+  , pool(aPool)
+  , threadNo(aThreadNo)
+  {
+  }
+
+  /// process the frames of each batch until the pool is shut down
+  virtual void run();
+
+private:
+
+  /// private undefined copy constructor
+  DcmFrameDecompressionThread(const DcmFrameDecompressionThread&);
+
+  /// private undefined copy assignment operator
+  DcmFrameDecompressionThread& operator=(const DcmFrameDecompressionThread&);
+
+  /// thread pool this thread belongs to
+  DcmFrameThreadPool& pool;
+
+  /// number of this thread
+  Uint32 threadNo;
+};
+
+
+/** pool of worker threads used by DcmCodec::decompressFrames() and
+ *  DcmCodec::compressFrames(). The threads are started once and then
+ *  process any number of batches of frames, so that compressing an image
+ *  in several batches does not create new threads for each batch.
+ *  The calling thread takes part in the processing as thread number 0.
+ */
+class DcmFrameThreadPool
+{
+public:
+  /** constructor, starts the worker threads
+   *  @param aTask task that processes a single frame
+   *  @param numberOfThreads number of threads including the calling thread
+   */
+  DcmFrameThreadPool(DcmFrameDecompressionTask& aTask, Uint32 numberOfThreads)
+  : task(aTask)
+  , queue(NULL)
+  , shutdown(OFFalse)
+  , startBatch(0)
+  , batchDone(0)
+  , threads()
+  {
+    threads.reserve(numberOfThreads - 1);
+    for (Uint32 threadNo = 1; threadNo < numberOfThreads; ++threadNo)
+    {
+      DcmFrameDecompressionThread *thread = new DcmFrameDecompressionThread(*this, threadNo);
+      if (thread->start() == 0)
+        threads.push_back(thread);
+      else
+      {
+        // cannot create more threads, continue with those we have
+        DCMDATA_DEBUG("DcmCodec: cannot create thread for frame processing, using " << threadNo << " thread(s)");
+        delete thread;
+        break;
+      }
+    }
+  }
+
+  /// destructor, stops and joins the worker threads
+  ~DcmFrameThreadPool()
+  {
+    shutdown = OFTrue;
+    for (size_t i = 0; i < threads.size(); ++i) startBatch.post();
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+      threads[i]->join();
+      delete threads[i];
+    }
+  }
+
+  /** process a range of frames with all threads of the pool and
+   *  wait until all of them are done
+   *  @param firstFrame number of the first frame to be processed
+   *  @param numberOfFrames number of frames to be processed
+   *  @return EC_Normal if successful, the first error that occurred otherwise
+   */
+  OFCondition process(Uint32 firstFrame, Uint32 numberOfFrames)
+  {
+    DcmFrameDecompressionQueue batch(firstFrame, firstFrame + numberOfFrames);
+    queue = &batch;
+    for (size_t i = 0; i < threads.size(); ++i) startBatch.post();
+    processQueue(0);
+    for (size_t i = 0; i < threads.size(); ++i) batchDone.wait();
+    queue = NULL;
+    return batch.status();
+  }
+
+private:
+
+  friend class DcmFrameDecompressionThread;
+
+  /// private undefined copy constructor
+  DcmFrameThreadPool(const DcmFrameThreadPool&);
+
+  /// private undefined copy assignment operator
+  DcmFrameThreadPool& operator=(const DcmFrameThreadPool&);
+
+  /** process frames of the current batch until its queue is empty
+   *  @param threadNo number of the calling thread
+   */
+  void processQueue(Uint32 threadNo)
+  {
+    Uint32 frameNo = 0;
+    while (queue->next(frameNo)) queue->report(task.decompressFrame(frameNo, threadNo));
+  }
+
+  /// task that processes a single frame
+  DcmFrameDecompressionTask& task;
+
+  /// queue of the current batch, set by process()
+  DcmFrameDecompressionQueue *queue;
+
+  /// true if the worker threads should terminate
+  OFBool shutdown;
+
+  /// posted once per worker thread when a batch starts or the pool shuts down
+  OFSemaphore startBatch;
+
+  /// posted by each worker thread when the queue of a batch is empty
+  OFSemaphore batchDone;
+
+  /// worker threads
+  OFVector<DcmFrameDecompressionThread *> threads;
+};
+
+
+void DcmFrameDecompressionThread::run()
+{
+  while (pool.startBatch.wait() == 0)
+  {
+    if (pool.shutdown) break;
+    pool.processQueue(threadNo);
+    pool.batchDone.post();
+  }
+}
+
+
+/** helper class that allows DcmCodec::compressFrames() to run the
+ *  compression step of a DcmFrameCompressionTask with the thread pool
+ *  also used by DcmCodec::decompressFrames().
+ */
+class DcmFrameCompressionAdapter: public DcmFrameDecompressionTask
+{
+public:
+  /** constructor
+   *  @param aTask compression task
+   */
+  DcmFrameCompressionAdapter(DcmFrameCompressionTask& aTask)
+  : DcmFrameDecompressionTask()
+  , task(aTask)
+  {
+  }
+
+  /** compresses a single frame, see DcmFrameCompressionTask::compressFrame()
+   *  @param frameNo number of the frame
+   *  @param threadNo number of the calling thread
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  virtual OFCondition decompressFrame(Uint32 frameNo, Uint32 threadNo)
+  {
+    return task.compressFrame(frameNo, threadNo);
+  }
+
+private:
+
+  /// private undefined copy constructor
+  DcmFrameCompressionAdapter(const DcmFrameCompressionAdapter&);
+
+  /// private undefined copy assignment operator
+  DcmFrameCompressionAdapter& operator=(const DcmFrameCompressionAdapter&);
+
+  /// compression task
+  DcmFrameCompressionTask& task;
+};
+
+#endif
+
+/* --------------------------------------------------------------- */
+
+// DcmEncapsulatedFrameDecompressionTask
+
+DcmEncapsulatedFrameDecompressionTask::DcmEncapsulatedFrameDecompressionTask(
+  const OFVector<Uint8 *>& fragmentData,
+  const OFVector<Uint32>& fragmentLength,
+  const OFVector<Uint32>& startFragments,
+  Uint8 *imageData8,
+  Uint32 frameSize,
+  Uint32 numberOfThreads)
+: DcmFrameDecompressionTask()
+, fragmentData_(fragmentData)
+, fragmentLength_(fragmentLength)
+, startFragments_(startFragments)
+, imageData8_(imageData8)
+, frameSize_(frameSize)
+, numberOfThreads_(numberOfThreads)
+{
+}
+
+
+DcmEncapsulatedFrameDecompressionTask::~DcmEncapsulatedFrameDecompressionTask()
+{
+}
+
+
+OFCondition DcmEncapsulatedFrameDecompressionTask::decompressFrame(Uint32 frameNo, Uint32 threadNo)
+{
+  if (frameNo + 1 >= startFragments_.size()) return EC_IllegalCall;
+  Uint32 currentItem = startFragments_[frameNo];
+  return decompressFrameAt(frameNo, threadNo, currentItem, startFragments_[frameNo + 1]);
+}
+
+
+OFCondition DcmEncapsulatedFrameDecompressionTask::decompressFrameAt(
+  Uint32 frameNo,
+  Uint32 threadNo,
+  Uint32& currentItem,
+  Uint32 endItem)
+{
+  if ((threadNo >= numberOfThreads_) || (imageData8_ == NULL)) return EC_IllegalCall;
+
+  // never access fragments that do not exist, even if the
+  // offset table or the caller claims otherwise
+  const Uint32 numberOfFragments = OFstatic_cast(Uint32, fragmentData_.size());
+  if (endItem > numberOfFragments) endItem = numberOfFragments;
+  if (currentItem >= endItem) return EC_CorruptedData;
+
+  return decodeFrame(frameNo, threadNo, currentItem, endItem,
+    imageData8_ + OFstatic_cast(size_t, frameNo) * frameSize_);
+}
+
+
+OFCondition DcmEncapsulatedFrameDecompressionTask::getFragment(
+  Uint32& currentItem,
+  Uint32 endItem,
+  Uint8 *& data,
+  Uint32& length) const
+{
+  if ((currentItem >= endItem) || (currentItem >= fragmentData_.size()) || (currentItem >= fragmentLength_.size()))
+    return EC_CorruptedData;
+  data = fragmentData_[currentItem];
+  length = fragmentLength_[currentItem];
+  ++currentItem;
+  return EC_Normal;
+}
+
 /* --------------------------------------------------------------- */
 
 // DcmCodec static helper methods
@@ -324,6 +667,188 @@ OFCondition DcmCodec::determineStartFragment(
 }
 
 
+OFCondition DcmCodec::determineFrameFragments(
+  Uint32 numberOfFrames,
+  DcmPixelSequence *fromPixSeq,
+  OFVector<Uint32>& startFragments)
+{
+  startFragments.clear();
+  if (fromPixSeq == NULL) return EC_IllegalCall;
+  Uint32 numberOfFragments = OFstatic_cast(Uint32, fromPixSeq->card());
+  if ((numberOfFrames < 1) || (numberOfFragments <= numberOfFrames))
+    return EC_IllegalCall;
+
+  startFragments.reserve(numberOfFrames + 1);
+  if (numberOfFragments == numberOfFrames + 1)
+  {
+    // standard case: there is one fragment per frame
+    for (Uint32 idx = 1; idx <= numberOfFragments; ++idx)
+      startFragments.push_back(idx);
+    return EC_Normal;
+  }
+
+  // non-standard case: multiple fragments per frame.
+  // We now try to consult the offset table.
+  DcmPixelItem *pixItem = NULL;
+  Uint8 *rawOffsetTable = NULL;
+  OFCondition result = fromPixSeq->getItem(pixItem, 0);
+  if (result.good()) result = pixItem->getUint8Array(rawOffsetTable);
+  if (result.bad() || (rawOffsetTable == NULL) || (pixItem->getLength() == 0))
+    return makeOFCondition(OFM_dcmdata, EC_CODE_CannotDetermineStartFragment, OF_error, "Cannot determine start fragment: basic offset table is empty or not accessible");
+  if (pixItem->getLength() != 4 * numberOfFrames)
+    return makeOFCondition(OFM_dcmdata, EC_CODE_CannotDetermineStartFragment, OF_error, "Cannot determine start fragment: basic offset table has wrong size");
+
+  // walk through all fragments and compute the offset of each fragment,
+  // adding 8 bytes overhead for the item tag and length field. The offset
+  // table is always in little endian byte order, so we decode it bytewise.
+  Uint32 counter = 0;
+  Uint32 frameNo = 0;
+  for (Uint32 idx = 1; (idx < numberOfFragments) && (frameNo < numberOfFrames); ++idx)
+  {
+    const Uint8 *entry = rawOffsetTable + 4 * frameNo;
+    Uint32 offset = OFstatic_cast(Uint32, entry[0]) | (OFstatic_cast(Uint32, entry[1]) << 8) |
+      (OFstatic_cast(Uint32, entry[2]) << 16) | (OFstatic_cast(Uint32, entry[3]) << 24);
+    if (offset == counter)
+    {
+      startFragments.push_back(idx);
+      ++frameNo;
+    }
+    else if (offset < counter)
+      break; // offset does not point to the start of a fragment
+    result = fromPixSeq->getItem(pixItem, idx);
+    if (result.bad())
+      return makeOFCondition(OFM_dcmdata, EC_CODE_CannotDetermineStartFragment, OF_error, "Cannot determine start fragment: cannot access referenced pixel item");
+    counter += pixItem->getLength() + 8;
+  }
+  if (frameNo < numberOfFrames)
+  {
+    startFragments.clear();
+    return makeOFCondition(OFM_dcmdata, EC_CODE_CannotDetermineStartFragment, OF_error, "Cannot determine start fragment: possibly wrong value in basic offset table");
+  }
+  startFragments.push_back(numberOfFragments);
+  return EC_Normal;
+}
+
+
+OFCondition DcmCodec::getFragmentData(
+  DcmPixelSequence *fromPixSeq,
+  OFVector<Uint8 *>& fragmentData,
+  OFVector<Uint32>& fragmentLength)
+{
+  fragmentData.clear();
+  fragmentLength.clear();
+  if (fromPixSeq == NULL) return EC_IllegalCall;
+  const unsigned long numberOfFragments = fromPixSeq->card();
+  fragmentData.reserve(numberOfFragments);
+  fragmentLength.reserve(numberOfFragments);
+  DcmPixelItem *pixItem = NULL;
+  Uint8 *data = NULL;
+  OFCondition result = EC_Normal;
+  for (unsigned long idx = 0; (idx < numberOfFragments) && result.good(); ++idx)
+  {
+    result = fromPixSeq->getItem(pixItem, idx);
+    if (result.good()) result = pixItem->getUint8Array(data);
+    if (result.good())
+    {
+      fragmentData.push_back(data);
+      fragmentLength.push_back(pixItem->getLength());
+    }
+  }
+  return result;
+}
+
+
+Uint32 DcmCodec::getDecompressionThreadCount(Uint32 numberOfFrames)
+{
+#ifdef WITH_THREADS
+  Uint32 numberOfThreads = dcmDecompressionThreads.get();
+  if (numberOfThreads > numberOfFrames) numberOfThreads = numberOfFrames;
+  if (numberOfThreads > 1) return numberOfThreads;
+#else
+  (void) numberOfFrames;
+#endif
+  return 1;
+}
+
+
+OFCondition DcmCodec::decompressFrames(
+  DcmFrameDecompressionTask& task,
+  Uint32 firstFrame,
+  Uint32 numberOfFrames,
+  Uint32 numberOfThreads)
+{
+  OFCondition result = EC_Normal;
+#ifdef WITH_THREADS
+  if (numberOfThreads > 1)
+  {
+    DcmFrameThreadPool pool(task, numberOfThreads);
+    return pool.process(firstFrame, numberOfFrames);
+  }
+#else
+  (void) numberOfThreads;
+#endif
+  for (Uint32 frameNo = firstFrame; (frameNo < firstFrame + numberOfFrames) && result.good(); ++frameNo)
+    result = task.decompressFrame(frameNo, 0);
+  return result;
+}
+
+
+Uint32 DcmCodec::getCompressionThreadCount(Uint32 numberOfThreads, Uint32 numberOfFrames)
+{
+#ifdef WITH_THREADS
+  if (numberOfThreads > numberOfFrames) numberOfThreads = numberOfFrames;
+  if (numberOfThreads > 1) return numberOfThreads;
+#else
+  (void) numberOfThreads;
+  (void) numberOfFrames;
+#endif
+  return 1;
+}
+
+
+OFCondition DcmCodec::compressFrames(
+  DcmFrameCompressionTask& task,
+  Uint32 numberOfFrames,
+  Uint32 numberOfThreads)
+{
+  OFCondition result = EC_Normal;
+  Uint32 frameNo = 0;
+#ifdef WITH_THREADS
+  numberOfThreads = getCompressionThreadCount(numberOfThreads, numberOfFrames);
+  if (numberOfThreads > 1)
+  {
+    // process a few frames per thread at once, so that threads finishing
+    // early rarely have to wait for the others at the end of a batch
+    const Uint32 batchSize = 4 * numberOfThreads;
+    DcmFrameCompressionAdapter adapter(task);
+    DcmFrameThreadPool pool(adapter, numberOfThreads);
+    while ((frameNo < numberOfFrames) && result.good())
+    {
+      Uint32 count = numberOfFrames - frameNo;
+      if (count > batchSize) count = batchSize;
+      for (Uint32 i = 0; (i < count) && result.good(); ++i)
+        result = task.prepareFrame(frameNo + i);
+      if (result.good())
+        result = pool.process(frameNo, count);
+      for (Uint32 i = 0; (i < count) && result.good(); ++i)
+        result = task.storeFrame(frameNo + i);
+      frameNo += count;
+    }
+    return result;
+  }
+#else
+  (void) numberOfThreads;
+#endif
+  for (; (frameNo < numberOfFrames) && result.good(); ++frameNo)
+  {
+    result = task.prepareFrame(frameNo);
+    if (result.good()) result = task.compressFrame(frameNo, 0);
+    if (result.good()) result = task.storeFrame(frameNo);
+  }
+  return result;
+}
+
+
 /* --------------------------------------------------------------- */
 
 DcmCodecList::DcmCodecList(
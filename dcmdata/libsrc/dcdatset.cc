@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2021, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -28,6 +28,7 @@
 
 #include "dcmtk/dcmdata/dcjson.h"
 #include "dcmtk/dcmdata/dcdatset.h"
+#include "dcmtk/dcmdata/dcarena.h"
 #include "dcmtk/dcmdata/dcxfer.h"
 #include "dcmtk/dcmdata/dcvrus.h"
 #include "dcmtk/dcmdata/dcpixel.h"
@@ -48,7 +49,8 @@ DcmDataset::DcmDataset()
   : DcmItem(DCM_ItemTag, DCM_UndefinedLength),
     OriginalXfer(EXS_Unknown),
     // the default transfer syntax is explicit VR with local endianness
-    CurrentXfer((gLocalByteOrder == EBO_BigEndian) ? EXS_BigEndianExplicit : EXS_LittleEndianExplicit)
+    CurrentXfer((gLocalByteOrder == EBO_BigEndian) ? EXS_BigEndianExplicit : EXS_LittleEndianExplicit),
+    MemoryArena(NULL)
 {
 }
 
@@ -70,7 +72,8 @@ DcmDataset& DcmDataset::operator=(const DcmDataset& obj)
 DcmDataset::DcmDataset(const DcmDataset &old)
   : DcmItem(old),
     OriginalXfer(old.OriginalXfer),
-    CurrentXfer(old.CurrentXfer)
+    CurrentXfer(old.CurrentXfer),
+    MemoryArena(NULL)
 {
 }
 
@@ -88,6 +91,30 @@ OFCondition DcmDataset::copyFrom(const DcmObject& rhs)
 
 DcmDataset::~DcmDataset()
 {
+    // the arena itself is deleted when the last object allocated from it is gone
+    if (MemoryArena != NULL)
+        MemoryArena->release();
+}
+
+
+// ********************************
+
+
+void DcmDataset::enableMemoryArena(const OFBool enable)
+{
+    if (enable && (MemoryArena == NULL))
+        MemoryArena = new DcmMemoryArena();
+    else if (!enable && (MemoryArena != NULL))
+    {
+        MemoryArena->release();
+        MemoryArena = NULL;
+    }
+}
+
+
+DcmMemoryArena *DcmDataset::getMemoryArena() const
+{
+    return (MemoryArena != NULL) ? MemoryArena : DcmItem::getMemoryArena();
 }
 
 
@@ -669,11 +696,13 @@ OFCondition DcmDataset::loadFileUntilTag(const OFFilename &fileName,
             }
 
         } else {
-            /* open file for input */
-            DcmInputFileStream fileStream(fileName);
+            /* open file for input (through a shared file handle or memory mapped, if enabled and possible) */
+            DcmInputStream *fileStream = dcmUseSharedFileHandleInput.get()
+                ? OFstatic_cast(DcmInputStream *, new DcmInputSharedFileStream(fileName))
+                : DcmInputMappedFileStream::create(fileName, 0, dcmUseMemoryMappedFileInput.get());
 
             /* check stream status */
-            l_error = fileStream.status();
+            l_error = fileStream->status();
 
             if (l_error.good())
             {
@@ -683,10 +712,11 @@ OFCondition DcmDataset::loadFileUntilTag(const OFFilename &fileName,
                 {
                     /* read data from file */
                     transferInit();
-                    l_error = readUntilTag(fileStream, readXfer, groupLength, maxReadLength, stopParsingAtElement);
+                    l_error = readUntilTag(*fileStream, readXfer, groupLength, maxReadLength, stopParsingAtElement);
                     transferEnd();
                 }
             }
+            delete fileStream;
 
         }
     }
@@ -694,6 +724,23 @@ OFCondition DcmDataset::loadFileUntilTag(const OFFilename &fileName,
 }
 
 
+OFCondition DcmDataset::loadFileSelective(const OFFilename &fileName,
+                                          const DcmTagSelection &selection,
+                                          const E_TransferSyntax readXfer,
+                                          const E_GrpLenEncoding groupLength,
+                                          const Uint32 maxReadLength)
+{
+    /* the selection is only used while reading this file */
+    setReadSelection(&selection);
+    OFCondition l_error = loadFile(fileName, readXfer, groupLength, maxReadLength);
+    setReadSelection(NULL);
+    return l_error;
+}
+
+
+// ********************************
+
+
 OFCondition DcmDataset::saveFile(const OFFilename &fileName,
                                  const E_TransferSyntax writeXfer,
                                  const E_EncodingType encodingType,
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2024, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -38,6 +38,11 @@
 #include "dcmtk/ofstd/ofstream.h"
 #include "dcmtk/ofstd/ofbmanip.h"     /* for class OFBitmanipTemplate */
 #include "dcmtk/ofstd/ofcast.h"
+#include "dcmtk/ofstd/ofvector.h"
+
+#ifdef WITH_THREADS
+#include "dcmtk/ofstd/ofthread.h"     /* for class OFThread */
+#endif
 
 
 /*-------------------------*
@@ -265,13 +270,27 @@ static OFBool locateDicomFile(const OFString &dicomFilename,
 }
 
 
-// compare two strings (empty strings are always regarded as unequal)
+// determine the length of a string without trailing padding (spaces and null bytes)
+static size_t lengthWithoutPadding(const OFString &string)
+{
+    size_t length = string.length();
+    while ((length > 0) && ((string.at(length - 1) == ' ') || (string.at(length - 1) == '\0')))
+        --length;
+    return length;
+}
+
+
+// compare two strings, ignoring trailing padding that is not removed when
+// reading a file with automatic input data correction disabled
+// (empty strings are always regarded as unequal)
 static OFBool compare(const OFString &string1,
                       const OFString &string2)
 {
-    if (string1.empty() || string2.empty())
+    const size_t length1 = lengthWithoutPadding(string1);
+    const size_t length2 = lengthWithoutPadding(string2);
+    if ((length1 == 0) || (length2 == 0) || (length1 != length2))
         return OFFalse;
-    return (string1.compare(string2) == 0) ? OFTrue : OFFalse;
+    return (memcmp(string1.data(), string2.data(), length1) == 0) ? OFTrue : OFFalse;
 }
 
 
@@ -1144,6 +1163,202 @@ static OFBool isMultiframeStorageSOPClass(const OFString &sopClassUID)
 }
 
 
+#ifdef WITH_THREADS
+
+/*--------------------------*
+ *  local helper classes    *
+ *--------------------------*/
+
+/** helper class that distributes the files processed by
+ *  DicomDirInterface::addDicomFiles() to the load threads and
+ *  passes the loaded files back in the order of the list.
+ *  At most 'windowSize' files are loaded ahead of the caller.
+ */
+class DicomDirLoadQueue
+{
+public:
+    /** constructor
+     *  @param filenames list of files to be loaded
+     *  @param windowSize maximum number of files loaded ahead
+     */
+    DicomDirLoadQueue(const OFList<OFFilename> &filenames,
+                      const size_t windowSize)
+      : Mutex(),
+        FreeSlots(OFstatic_cast(unsigned int, windowSize)),
+        Loaded(windowSize),
+        Entries(windowSize),
+        Iterator(filenames.begin()),
+        Last(filenames.end()),
+        NextIndex(0),
+        Cancelled(OFFalse)
+    {
+        for (size_t i = 0; i < windowSize; ++i)
+        {
+            Loaded[i] = new OFSemaphore(0);
+            Entries[i].FileFormat = NULL;
+        }
+    }
+
+    /// destructor, frees all files that have not been fetched
+    ~DicomDirLoadQueue()
+    {
+        for (size_t i = 0; i < Loaded.size(); ++i)
+        {
+            delete Loaded[i];
+            delete Entries[i].FileFormat;
+        }
+    }
+
+    /** fetch the next file to be loaded. Blocks until a slot is available.
+     *  @param index index of the file in the list
+     *  @param filename name of the file
+     *  @return OFTrue if a file was returned, OFFalse if there are no more
+     *    files or processing has been cancelled
+     */
+    OFBool next(size_t &index, OFFilename &filename)
+    {
+        OFBool found = OFFalse;
+        FreeSlots.wait();
+        Mutex.lock();
+        if (!Cancelled && (Iterator != Last))
+        {
+            index = NextIndex++;
+            filename = *Iterator++;
+            found = OFTrue;
+        }
+        Mutex.unlock();
+        /* pass the slot on so that all waiting threads terminate */
+        if (!found)
+            FreeSlots.post();
+        return found;
+    }
+
+    /** store a loaded file
+     *  @param index index of the file in the list
+     *  @param fileformat loaded file, ownership is transferred to this object
+     *  @param result result of loading and checking the file
+     */
+    void done(const size_t index, DcmFileFormat *fileformat, const OFCondition &result)
+    {
+        const size_t slot = index % Entries.size();
+        Entries[slot].FileFormat = fileformat;
+        Entries[slot].Result = result;
+        Loaded[slot]->post();
+    }
+
+    /** fetch a loaded file. Blocks until the file has been loaded.
+     *  @param index index of the file in the list
+     *  @param result returns the result of loading and checking the file
+     *  @return loaded file, ownership is transferred to the caller
+     */
+    DcmFileFormat *get(const size_t index, OFCondition &result)
+    {
+        const size_t slot = index % Entries.size();
+        Loaded[slot]->wait();
+        DcmFileFormat *fileformat = Entries[slot].FileFormat;
+        result = Entries[slot].Result;
+        Entries[slot].FileFormat = NULL;
+        FreeSlots.post();
+        return fileformat;
+    }
+
+    /// stop loading further files
+    void cancel()
+    {
+        Mutex.lock();
+        Cancelled = OFTrue;
+        Mutex.unlock();
+        FreeSlots.post();
+    }
+
+private:
+
+    /// private undefined copy constructor
+    DicomDirLoadQueue(const DicomDirLoadQueue &);
+
+    /// private undefined assignment operator
+    DicomDirLoadQueue &operator=(const DicomDirLoadQueue &);
+
+    /// a loaded file and the result of loading it
+    struct Entry
+    {
+        /// loaded file (NULL if not loaded or already fetched)
+        DcmFileFormat *FileFormat;
+        /// result of loading and checking the file
+        OFCondition Result;
+    };
+
+    /// mutex protecting the list iterator and the cancel flag
+    OFMutex Mutex;
+    /// number of slots that are available for loading
+    OFSemaphore FreeSlots;
+    /// one semaphore per slot, posted when the file has been loaded
+    OFVector<OFSemaphore *> Loaded;
+    /// loaded files, indexed by slot
+    OFVector<Entry> Entries;
+    /// next file to be loaded
+    OFListConstIterator(OFFilename) Iterator;
+    /// end of the list of files
+    OFListConstIterator(OFFilename) Last;
+    /// index of the next file to be loaded
+    size_t NextIndex;
+    /// flag indicating that processing has been cancelled
+    OFBool Cancelled;
+};
+
+
+/** worker thread used by DicomDirInterface::addDicomFiles()
+ */
+class DicomDirLoadThread: public OFThread
+{
+public:
+    /** constructor
+     *  @param ddir DICOMDIR interface used for loading and checking the files
+     *  @param queue queue of files shared by all threads
+     *  @param directory directory where the files are stored
+     */
+    DicomDirLoadThread(DicomDirInterface &ddir,
+                       DicomDirLoadQueue &queue,
+                       const OFFilename &directory)
+      : OFThread(),
+        Interface(ddir),
+        Queue(queue),
+        Directory(directory)
+    {
+    }
+
+    /// load files until the queue is empty
+    virtual void run()
+    {
+        size_t index = 0;
+        OFFilename filename;
+        while (Queue.next(index, filename))
+        {
+            DcmFileFormat *fileformat = new DcmFileFormat();
+            OFCondition result = Interface.loadAndCheckDicomFile(filename, Directory, *fileformat, OFTrue /*checkFilename*/);
+            Queue.done(index, fileformat, result);
+        }
+    }
+
+private:
+
+    /// private undefined copy constructor
+    DicomDirLoadThread(const DicomDirLoadThread &);
+
+    /// private undefined assignment operator
+    DicomDirLoadThread &operator=(const DicomDirLoadThread &);
+
+    /// DICOMDIR interface used for loading and checking the files
+    DicomDirInterface &Interface;
+    /// queue of files shared by all threads
+    DicomDirLoadQueue &Queue;
+    /// directory where the files are stored
+    const OFFilename Directory;
+};
+
+#endif
+
+
 /*------------------*
  *  implementation  *
  *------------------*/
@@ -1171,6 +1386,7 @@ DicomDirInterface::DicomDirInterface()
     IconSize(64),
     IconPrefix(),
     DefaultIcon(),
+    NumberOfThreads(1),
     RLESupport(OFFalse),
     JPEGSupport(OFFalse),
     JP2KSupport(OFFalse),
@@ -1416,6 +1632,32 @@ OFCondition DicomDirInterface::writeDicomDir(const E_EncodingType encodingType,
 }
 
 
+// write the current DICOMDIR object to file, appending the new records only
+OFCondition DicomDirInterface::writeDicomDirIncremental(const E_EncodingType encodingType,
+                                                        const E_GrpLenEncoding groupLength)
+{
+    /* existing records might have been modified in these modes */
+    if (FilesetUpdateMode || InventMode || InventPatientIDMode)
+        return writeDicomDir(encodingType, groupLength);
+    OFCondition result = EC_InvalidDICOMDIR;
+    /* check whether DICOMDIR object is valid */
+    if (isDicomDirValid())
+    {
+        DCMDATA_INFO("appending to file: " << DicomDir->getDirFileName());
+        result = DicomDir->writeIncremental(encodingType, groupLength);
+        /* delete backup copy in case the file could be written without any errors */
+        if (result.good())
+            deleteDicomDirBackup();
+        else
+        {
+            /* report an error */
+            DCMDATA_ERROR(result.text() << ": writing file: " << DicomDir->getDirFileName());
+        }
+    }
+    return result;
+}
+
+
 // check whether the specified filename conforms to the DICOM standard requirements
 OFBool DicomDirInterface::isFilenameValid(const OFFilename &filename,
                                           const OFBool allowEmpty)
@@ -2800,8 +3042,14 @@ OFCondition DicomDirInterface::loadAndCheckDicomFile(const OFFilename &filename,
     /* check filename (if not disabled) */
     if (!checkFilename || isFilenameValid(filename))
     {
-        /* load DICOM file */
-        result = fileformat.loadFile(pathname);
+        /* load DICOM file (the pixel data is only needed for creating icon images) */
+        if (isPixelDataRequired())
+            result = fileformat.loadFile(pathname);
+        else
+        {
+            result = fileformat.loadFileUntilTag(pathname, EXS_Unknown, EGL_noChange, DCM_MaxReadLength,
+                ERM_autoDetect, DCM_PixelData);
+        }
         if (result.good())
         {
             /* check for correct part 10 file format */
@@ -4910,6 +5158,21 @@ void DicomDirInterface::inventMissingInstanceLevelAttributes(DcmDirectoryRecord
 }
 
 
+// check whether the pixel data is needed for creating icon images from the DICOM files
+OFBool DicomDirInterface::isPixelDataRequired() const
+{
+    /* icon images are only created from the pixel data if no external icons are used */
+    if ((ImagePlugin == NULL) || !IconPrefix.isEmpty())
+        return OFFalse;
+    /* particular application profiles always require icon images */
+    return IconImageMode ||
+           (ApplicationProfile == AP_BasicCardiac) ||
+           (ApplicationProfile == AP_XrayAngiographic) ||
+           (ApplicationProfile == AP_XrayAngiographicDVD) ||
+           (ApplicationProfile == AP_CTandMR);
+}
+
+
 // add DICOM file to the current DICOMDIR object
 OFCondition DicomDirInterface::addDicomFile(const OFFilename &filename,
                                             const OFFilename &directory)
@@ -4918,95 +5181,196 @@ OFCondition DicomDirInterface::addDicomFile(const OFFilename &filename,
     /* first, make sure that a DICOMDIR object exists */
     if (DicomDir != NULL)
     {
-        /* create fully qualified pathname of the DICOM file to be added */
-        OFFilename pathname;
-        OFStandard::combineDirAndFilename(pathname, directory, filename, OFTrue /*allowEmptyDirName*/);
         /* then check the file name, load the file and check the content */
         DcmFileFormat fileformat;
         result = loadAndCheckDicomFile(filename, directory, fileformat, OFTrue /*checkFilename*/);
         if (result.good())
+            result = addDicomFileRecords(filename, directory, fileformat);
+    }
+    return result;
+}
+
+
+// add DICOM files to the current DICOMDIR object
+OFCondition DicomDirInterface::addDicomFiles(const OFList<OFFilename> &filenames,
+                                             const OFFilename &directory,
+                                             OFList<OFFilename> &badFiles,
+                                             size_t &goodFiles)
+{
+    goodFiles = 0;
+    /* first, make sure that a DICOMDIR object exists */
+    if (DicomDir == NULL)
+        return EC_IllegalParameter;
+    OFCondition result = EC_Normal;
+    OFListConstIterator(OFFilename) iter = filenames.begin();
+    OFListConstIterator(OFFilename) last = filenames.end();
+#ifdef WITH_THREADS
+    size_t numberOfThreads = NumberOfThreads;
+    if (numberOfThreads > filenames.size())
+        numberOfThreads = filenames.size();
+    if (numberOfThreads > 1)
+    {
+        /* load and check the files in parallel, a few files ahead of the record creation */
+        DicomDirLoadQueue queue(filenames, 8 * numberOfThreads);
+        OFVector<DicomDirLoadThread *> threads;
+        threads.reserve(numberOfThreads);
+        for (size_t i = 0; i < numberOfThreads; ++i)
         {
-            DCMDATA_INFO("adding file: " << pathname);
-            /* start creating the DICOMDIR directory structure */
-            DcmDirectoryRecord *rootRecord = &(DicomDir->getRootRecord());
-            DcmMetaInfo *metainfo = fileformat.getMetaInfo();
-            /* massage filename into DICOM format (DOS conventions for path separators, uppercase) */
-            OFString fileID;
-            hostToDicomFilename(OFSTRING_GUARD(filename.getCharPointer()), fileID);
-            /* what kind of object (SOP Class) is stored in the file */
-            OFString sopClass;
-            metainfo->findAndGetOFString(DCM_MediaStorageSOPClassUID, sopClass);
-            /* if hanging protocol, palette or implant file then attach it to the root record and stop */
-            if (compare(sopClass, UID_HangingProtocolStorage))
-            {
-                /* add a hanging protocol record below the root */
-                if (addRecord(rootRecord, ERT_HangingProtocol, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
-            }
-            else if (compare(sopClass, UID_ColorPaletteStorage))
+            DicomDirLoadThread *thread = new DicomDirLoadThread(*this, queue, directory);
+            if (thread->start() == 0)
+                threads.push_back(thread);
+            else
             {
-                /* add a palette record below the root */
-                if (addRecord(rootRecord, ERT_Palette, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
+                /* cannot create more threads, continue with those we have */
+                DCMDATA_DEBUG("cannot create thread for loading DICOM files, using " << i << " thread(s)");
+                delete thread;
+                break;
             }
-            else if (compare(sopClass, UID_GenericImplantTemplateStorage))
+        }
+        if (!threads.empty())
+        {
+            /* create the directory records in the order of the list */
+            for (size_t index = 0; iter != last; ++index, ++iter)
             {
-                /* add an implant record below the root */
-                if (addRecord(rootRecord, ERT_Implant, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
+                OFCondition status;
+                DcmFileFormat *fileformat = queue.get(index, status);
+                if (status.good())
+                    status = addDicomFileRecords(*iter, directory, *fileformat);
+                delete fileformat;
+                if (status.bad())
+                {
+                    badFiles.push_back(*iter);
+                    if (AbortMode)
+                    {
+                        result = status;
+                        queue.cancel();
+                        break;
+                    }
+                } else
+                    ++goodFiles;
             }
-            else if (compare(sopClass, UID_ImplantAssemblyTemplateStorage))
+            for (size_t i = 0; i < threads.size(); ++i)
             {
-                /* add an implant group record below the root */
-                if (addRecord(rootRecord, ERT_ImplantGroup, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
+                threads[i]->join();
+                delete threads[i];
             }
-            else if (compare(sopClass, UID_ImplantTemplateGroupStorage))
+            return result;
+        }
+    }
+#endif
+    /* add one file after the other */
+    while (iter != last)
+    {
+        OFCondition status = addDicomFile(*iter, directory);
+        if (status.bad())
+        {
+            badFiles.push_back(*iter);
+            if (AbortMode)
             {
-                /* add an implant assy record below the root */
-                if (addRecord(rootRecord, ERT_ImplantAssy, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
+                result = status;
+                break;
             }
-            else if (compare(sopClass, UID_InventoryStorage))
+        } else
+            ++goodFiles;
+        ++iter;
+    }
+    return result;
+}
+
+
+// add the directory records for an already loaded DICOM file to the current DICOMDIR object
+OFCondition DicomDirInterface::addDicomFileRecords(const OFFilename &filename,
+                                                   const OFFilename &directory,
+                                                   DcmFileFormat &fileformat)
+{
+    OFCondition result = EC_IllegalParameter;
+    /* first, make sure that a DICOMDIR object exists */
+    if (DicomDir != NULL)
+    {
+        /* create fully qualified pathname of the DICOM file to be added */
+        OFFilename pathname;
+        OFStandard::combineDirAndFilename(pathname, directory, filename, OFTrue /*allowEmptyDirName*/);
+        result = EC_Normal;
+        DCMDATA_INFO("adding file: " << pathname);
+        /* start creating the DICOMDIR directory structure */
+        DcmDirectoryRecord *rootRecord = &(DicomDir->getRootRecord());
+        DcmMetaInfo *metainfo = fileformat.getMetaInfo();
+        /* massage filename into DICOM format (DOS conventions for path separators, uppercase) */
+        OFString fileID;
+        hostToDicomFilename(OFSTRING_GUARD(filename.getCharPointer()), fileID);
+        /* what kind of object (SOP Class) is stored in the file */
+        OFString sopClass;
+        metainfo->findAndGetOFString(DCM_MediaStorageSOPClassUID, sopClass);
+        /* if hanging protocol, palette or implant file then attach it to the root record and stop */
+        if (compare(sopClass, UID_HangingProtocolStorage))
+        {
+            /* add a hanging protocol record below the root */
+            if (addRecord(rootRecord, ERT_HangingProtocol, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_ColorPaletteStorage))
+        {
+            /* add a palette record below the root */
+            if (addRecord(rootRecord, ERT_Palette, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_GenericImplantTemplateStorage))
+        {
+            /* add an implant record below the root */
+            if (addRecord(rootRecord, ERT_Implant, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_ImplantAssemblyTemplateStorage))
+        {
+            /* add an implant group record below the root */
+            if (addRecord(rootRecord, ERT_ImplantGroup, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_ImplantTemplateGroupStorage))
+        {
+            /* add an implant assy record below the root */
+            if (addRecord(rootRecord, ERT_ImplantAssy, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_InventoryStorage))
+        {
+            /* add an inventory record below the root */
+            if (addRecord(rootRecord, ERT_Inventory, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        } else {
+            /* add a patient record below the root */
+            DcmDirectoryRecord *patientRecord = addRecord(rootRecord, ERT_Patient, &fileformat, fileID, pathname);
+            if (patientRecord != NULL)
             {
-                /* add an inventory record below the root */
-                if (addRecord(rootRecord, ERT_Inventory, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
-            } else {
-                /* add a patient record below the root */
-                DcmDirectoryRecord *patientRecord = addRecord(rootRecord, ERT_Patient, &fileformat, fileID, pathname);
-                if (patientRecord != NULL)
+                /* if patient management file then attach it to patient record and stop */
+                if (compare(sopClass, UID_RETIRED_DetachedPatientManagementMetaSOPClass))
                 {
-                    /* if patient management file then attach it to patient record and stop */
-                    if (compare(sopClass, UID_RETIRED_DetachedPatientManagementMetaSOPClass))
+                    result = patientRecord->assignToSOPFile(fileID.c_str(), pathname);
+                    DCMDATA_ERROR(result.text() << ": cannot assign patient record to file: " << pathname);
+                } else {
+                    /* add a study record below the current patient record */
+                    DcmDirectoryRecord *studyRecord = addRecord(patientRecord, ERT_Study, &fileformat, fileID, pathname);;
+                    if (studyRecord != NULL)
                     {
-                        result = patientRecord->assignToSOPFile(fileID.c_str(), pathname);
-                        DCMDATA_ERROR(result.text() << ": cannot assign patient record to file: " << pathname);
-                    } else {
-                        /* add a study record below the current patient record */
-                        DcmDirectoryRecord *studyRecord = addRecord(patientRecord, ERT_Study, &fileformat, fileID, pathname);;
-                        if (studyRecord != NULL)
+                        /* add a series record below the current study record */
+                        DcmDirectoryRecord *seriesRecord = addRecord(studyRecord, ERT_Series, &fileformat, fileID, pathname);;
+                        if (seriesRecord != NULL)
                         {
-                            /* add a series record below the current study record */
-                            DcmDirectoryRecord *seriesRecord = addRecord(studyRecord, ERT_Series, &fileformat, fileID, pathname);;
-                            if (seriesRecord != NULL)
-                            {
-                                /* add one of the instance record below the current series record */
-                                if (addRecord(seriesRecord, sopClassToRecordType(sopClass), &fileformat, fileID, pathname) == NULL)
-                                    result = EC_CorruptedData;
-                            } else
+                            /* add one of the instance record below the current series record */
+                            if (addRecord(seriesRecord, sopClassToRecordType(sopClass), &fileformat, fileID, pathname) == NULL)
                                 result = EC_CorruptedData;
                         } else
                             result = EC_CorruptedData;
-                    }
-                } else
-                    result = EC_CorruptedData;
-                /* invent missing attributes on all levels or PatientID only */
-                if (InventMode)
-                    inventMissingAttributes(rootRecord);
-                else if (InventPatientIDMode)
-                    inventMissingAttributes(rootRecord, OFFalse /*recurse*/);
-            }
+                    } else
+                        result = EC_CorruptedData;
+                }
+            } else
+                result = EC_CorruptedData;
+            /* invent missing attributes on all levels or PatientID only */
+            if (InventMode)
+                inventMissingAttributes(rootRecord);
+            else if (InventPatientIDMode)
+                inventMissingAttributes(rootRecord, OFFalse /*recurse*/);
         }
     }
     return result;
@@ -5085,6 +5449,25 @@ OFCondition DicomDirInterface::setIconPrefix(const OFFilename &prefix)
 }
 
 
+// set number of threads used for loading and checking DICOM files
+OFCondition DicomDirInterface::setNumberOfThreads(const unsigned int threads)
+{
+    OFCondition result = EC_IllegalParameter;
+    /* check valid range */
+    if ((threads > 0) && (threads <= 256))
+    {
+#ifndef WITH_THREADS
+        /* only a single thread is supported */
+        if (threads > 1)
+            return EC_IllegalCall;
+#endif
+        NumberOfThreads = threads;
+        result = EC_Normal;
+    }
+    return result;
+}
+
+
 // set filename for default image icon which is used in case of error
 OFCondition DicomDirInterface::setDefaultIcon(const OFFilename &filename)
 {
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2023, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -40,11 +40,14 @@
 #include "dcmtk/dcmdata/dcdeftag.h"
 #include "dcmtk/dcmdata/dcostrma.h"    /* for class DcmOutputStream */
 #include "dcmtk/dcmdata/dcostrmf.h"    /* for class DcmOutputFileStream */
+#include "dcmtk/dcmdata/dcostrmb.h"    /* for class DcmOutputBufferStream */
 #include "dcmtk/dcmdata/dcistrmf.h"    /* for class DcmInputFileStream */
 #include "dcmtk/dcmdata/dcvrcs.h"
 #include "dcmtk/dcmdata/dcvrus.h"
 #include "dcmtk/dcmdata/dcmetinf.h"
 #include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/offile.h"        /* for class OFFile */
+#include "dcmtk/ofstd/ofvector.h"      /* for class OFVector */
 #include "dcmtk/dcmdata/dcwcache.h"    /* for class DcmWriteCache */
 #include "dcmtk/dcmdata/dcvrui.h"      /* for class DcmUniqueIdentifier */
 
@@ -1088,6 +1091,8 @@ OFCondition DcmDicomDir::write(const E_TransferSyntax oxfer,
     if (errorFlag == EC_Normal) {
         // remove temporary backup (if any)
         OFStandard::deleteFile(backupFilename);
+        // the file exists now, so it can be updated by subsequent calls
+        mustCreateNewDir = OFFalse;
     }
 
     // remove all records from sequence localDirRecSeq
@@ -1109,6 +1114,435 @@ OFCondition DcmDicomDir::write(const E_TransferSyntax oxfer,
 // ********************************
 
 
+/* helper structure describing an offset value in an existing DICOMDIR file
+ * that is updated by DcmDicomDir::appendNewRecords()
+ */
+struct DcmDicomDirOffsetPatch
+{
+    /// position of the element (tag) in the file
+    offile_off_t position;
+    /// offset element in memory
+    DcmUnsignedLongOffset *element;
+    /// record referenced by the new value
+    DcmDirectoryRecord *record;
+    /// value currently stored in the file
+    Uint32 oldValue;
+    /// new value to be stored
+    Uint32 newValue;
+};
+
+
+static Uint16 getLittleEndianUint16(const Uint8 *buffer)
+{
+    return OFstatic_cast(Uint16, buffer[0] | (buffer[1] << 8));
+}
+
+
+static Uint32 getLittleEndianUint32(const Uint8 *buffer)
+{
+    return OFstatic_cast(Uint32, buffer[0]) | (OFstatic_cast(Uint32, buffer[1]) << 8) |
+        (OFstatic_cast(Uint32, buffer[2]) << 16) | (OFstatic_cast(Uint32, buffer[3]) << 24);
+}
+
+
+static void putLittleEndianUint32(Uint8 *buffer, const Uint32 value)
+{
+    buffer[0] = OFstatic_cast(Uint8, value);
+    buffer[1] = OFstatic_cast(Uint8, value >> 8);
+    buffer[2] = OFstatic_cast(Uint8, value >> 16);
+    buffer[3] = OFstatic_cast(Uint8, value >> 24);
+}
+
+
+static OFBool readFileBytes(OFFile &file, const offile_off_t position, Uint8 *buffer, const size_t length)
+{
+    return (file.fseek(position, SEEK_SET) == 0) && (file.fread(buffer, 1, length) == length);
+}
+
+
+static OFBool writeFileBytes(OFFile &file, const offile_off_t position, const Uint8 *buffer, const size_t length)
+{
+    return (file.fseek(position, SEEK_SET) == 0) && (file.fwrite(buffer, 1, length) == length);
+}
+
+
+/* create the expected encoding of an offset element (explicit VR little endian) */
+static void encodeOffsetElement(Uint8 *buffer, const DcmTagKey &tag, const Uint32 value)
+{
+    buffer[0] = OFstatic_cast(Uint8, tag.getGroup());
+    buffer[1] = OFstatic_cast(Uint8, tag.getGroup() >> 8);
+    buffer[2] = OFstatic_cast(Uint8, tag.getElement());
+    buffer[3] = OFstatic_cast(Uint8, tag.getElement() >> 8);
+    buffer[4] = 'U';
+    buffer[5] = 'L';
+    buffer[6] = 4;
+    buffer[7] = 0;
+    putLittleEndianUint32(buffer + 8, value);
+}
+
+
+/* collect all records of the tree below the given record, parents before children */
+static void collectRecords(DcmDirectoryRecord *record, OFVector<DcmDirectoryRecord *> &records)
+{
+    const unsigned long count = record->cardSub();
+    for (unsigned long i = 0; i < count; i++)
+    {
+        DcmDirectoryRecord *subRecord = record->getSub(i);
+        records.push_back(subRecord);
+        collectRecords(subRecord, records);
+    }
+}
+
+
+OFCondition DcmDicomDir::appendNewRecords( E_EncodingType enctype,
+                                           E_GrpLenEncoding glenc )
+{
+    const E_TransferSyntax oxfer = DICOMDIR_DEFAULT_TRANSFERSYNTAX;
+    DcmDataset &dset = getDataset();    // guaranteed to exist
+    DcmSequenceOfItems &localDirRecSeq = getDirRecSeq( dset );
+
+    // check whether the records in memory can be appended at all
+    const char *reason = NULL;
+    if ( mustCreateNewDir )
+        reason = "file does not exist yet";
+    else if ( glenc == EGL_withGL )
+        reason = "group length elements requested";
+    else if ( dset.getOriginalXfer() != oxfer )
+        reason = "file not encoded in Explicit VR Little Endian";
+    else if ( getMRDRSequence().card() > 0 )
+        reason = "multi-referenced file records present";
+    else if ( localDirRecSeq.card() > 0 )
+        reason = "unreferenced records present";
+    else if ( dset.getElement( dset.card() - 1 ) != &localDirRecSeq )
+        reason = "Directory Record Sequence is not the last element";
+
+    OFFile file;
+    if ( ( reason == NULL ) && !file.fopen( dicomDirFileName, "r+b" ) )
+        reason = "cannot open file for update";
+
+    // parse the header of the existing file up to the Directory Record Sequence
+    Uint8 buffer[12];
+    offile_off_t position = 132;
+    offile_off_t beginOfDataset = 0;
+    offile_off_t firstRecPos = 0;
+    offile_off_t lastRecPos = 0;
+    offile_off_t seqPos = 0;
+    Uint32 seqLength = 0;
+    if ( ( reason == NULL ) && ( !readFileBytes( file, 128, buffer, 4 ) || ( memcmp( buffer, "DICM", 4 ) != 0 ) ) )
+        reason = "file has no DICOM prefix";
+    while ( ( reason == NULL ) && ( seqPos == 0 ) )
+    {
+        if ( !readFileBytes( file, position, buffer, 8 ) )
+        {
+            reason = "unexpected end of file";
+            break;
+        }
+        const DcmTagKey tag( getLittleEndianUint16( buffer ), getLittleEndianUint16( buffer + 2 ) );
+        const char vrName[3] = { OFstatic_cast(char, buffer[4]), OFstatic_cast(char, buffer[5]), '\0' };
+        const DcmVR vr( vrName );
+        Uint32 length = getLittleEndianUint16( buffer + 6 );
+        offile_off_t valuePos = position + 8;
+        if ( vr.usesExtendedLengthEncoding() )
+        {
+            if ( !readFileBytes( file, position + 8, buffer + 8, 4 ) )
+            {
+                reason = "unexpected end of file";
+                break;
+            }
+            length = getLittleEndianUint32( buffer + 8 );
+            valuePos += 4;
+        }
+        if ( ( beginOfDataset == 0 ) && ( tag.getGroup() != 0x0002 ) )
+            beginOfDataset = position;
+        if ( tag == DCM_DirectoryRecordSequence )
+        {
+            if ( vr.getEVR() != EVR_SQ )
+                reason = "unexpected encoding of Directory Record Sequence";
+            seqPos = position;
+            seqLength = length;
+        }
+        else if ( ( length == DCM_UndefinedLength ) || ( vr.getEVR() == EVR_SQ ) ||
+                  ( ( tag.getElement() == 0x0000 ) && ( tag.getGroup() != 0x0002 ) ) )
+        {
+            // the group length of the meta header is not affected, but others would be
+            reason = "unsupported element in file header";
+        }
+        else if ( tag == DCM_OffsetOfTheFirstDirectoryRecordOfTheRootDirectoryEntity )
+            firstRecPos = position;
+        else if ( tag == DCM_OffsetOfTheLastDirectoryRecordOfTheRootDirectoryEntity )
+            lastRecPos = position;
+        position = valuePos + length;
+    }
+    if ( ( reason == NULL ) && ( ( firstRecPos == 0 ) || ( lastRecPos == 0 ) ) )
+        reason = "root record offsets missing";
+
+    // the dataset header in memory must still be identical to the one in the file
+    if ( reason == NULL )
+    {
+        Uint32 headerLength = 0;
+        unsigned long numHeaderElements = 0;
+        while ( dset.getElement( numHeaderElements ) != &localDirRecSeq )
+            headerLength += dset.getElement( numHeaderElements++ )->calcElementLength( oxfer, enctype );
+        if ( OFstatic_cast(offile_off_t, headerLength) != seqPos - beginOfDataset )
+            reason = "file header modified";
+        else
+        {
+            OFVector<Uint8> fileHeader( headerLength );
+            OFVector<Uint8> memoryHeader( headerLength );
+            DcmOutputBufferStream outStream( &memoryHeader[0], headerLength );
+            for ( unsigned long i = 0; ( i < numHeaderElements ) && ( reason == NULL ); i++ )
+            {
+                DcmElement *elem = dset.getElement( i );
+                elem->transferInit();
+                if ( elem->write( outStream, oxfer, enctype, NULL ).bad() )
+                    reason = "cannot encode file header";
+                elem->transferEnd();
+            }
+            if ( ( reason == NULL ) && ( !readFileBytes( file, beginOfDataset, &fileHeader[0], headerLength ) ||
+                 ( memcmp( &fileHeader[0], &memoryHeader[0], headerLength ) != 0 ) ) )
+            {
+                reason = "file header modified";
+            }
+        }
+    }
+
+    // determine where the new records are appended
+    offile_off_t appendPos = 0;
+    if ( reason == NULL )
+    {
+        file.fseek( 0, SEEK_END );
+        const offile_off_t fileSize = file.ftell();
+        if ( seqLength == DCM_UndefinedLength )
+        {
+            static const Uint8 seqDelimiter[8] = { 0xfe, 0xff, 0xdd, 0xe0, 0x00, 0x00, 0x00, 0x00 };
+            appendPos = fileSize - 8;
+            if ( ( appendPos < seqPos + 12 ) || !readFileBytes( file, appendPos, buffer, 8 ) ||
+                 ( memcmp( buffer, seqDelimiter, 8 ) != 0 ) )
+            {
+                reason = "Directory Record Sequence is not at the end of the file";
+            }
+        } else {
+            appendPos = seqPos + 12 + seqLength;
+            if ( appendPos != fileSize )
+                reason = "Directory Record Sequence is not at the end of the file";
+        }
+    }
+
+    // assign file offsets to the new records, which are appended in tree order
+    OFVector<DcmDirectoryRecord *> records;
+    OFVector<DcmDirectoryRecord *> newRecords;
+    offile_off_t endPos = appendPos;
+    if ( reason == NULL )
+    {
+        collectRecords( &getRootRecord(), records );
+        for ( size_t i = 0; i < records.size(); i++ )
+        {
+            DcmDirectoryRecord *record = records[i];
+            if ( record->getFileOffset() == 0 )
+            {
+                // make sure that the record has the same structure as after copyRecordPtrToSQ()
+                DcmTag nextRecTag( DCM_OffsetOfTheNextDirectoryRecord );
+                DcmUnsignedLongOffset *uloP = new DcmUnsignedLongOffset( nextRecTag );
+                uloP->putUint32(Uint32(0));
+                record->insert( uloP, OFTrue );
+                DcmTag lowerRefTag( DCM_OffsetOfReferencedLowerLevelDirectoryEntity );
+                uloP = new DcmUnsignedLongOffset( lowerRefTag );
+                uloP->putUint32(Uint32(0));
+                record->insert( uloP, OFTrue );
+                record->computeGroupLengthAndPadding( glenc, EPD_noChange, oxfer, enctype );
+                newRecords.push_back( record );
+            }
+            else if ( ( record->getFileOffset() < seqPos ) || ( record->getFileOffset() >= appendPos ) )
+                reason = "record offsets do not match the file";
+        }
+        for ( size_t i = 0; ( i < newRecords.size() ) && ( reason == NULL ); i++ )
+        {
+            if ( endPos > OFstatic_cast(offile_off_t, 0xffffffff) )
+                reason = "file size exceeds the maximum offset";
+            else
+            {
+                newRecords[i]->setFileOffset( OFstatic_cast(Uint32, endPos) );
+                endPos += lengthOfRecord( newRecords[i], oxfer, enctype );
+            }
+        }
+    }
+
+    // determine the offsets that have to be updated and set those of the new records
+    OFVector<DcmDicomDirOffsetPatch> patches;
+    if ( reason == NULL )
+    {
+        DcmDirectoryRecord *rootRecord = &getRootRecord();
+        const unsigned long rootCount = rootRecord->cardSub();
+        DcmDicomDirOffsetPatch patch;
+        patch.position = firstRecPos;
+        patch.element = lookForOffsetElem( &dset, DCM_OffsetOfTheFirstDirectoryRecordOfTheRootDirectoryEntity );
+        patch.record = ( rootCount > 0 ) ? rootRecord->getSub( 0 ) : NULL;
+        patches.push_back( patch );
+        patch.position = lastRecPos;
+        patch.element = lookForOffsetElem( &dset, DCM_OffsetOfTheLastDirectoryRecordOfTheRootDirectoryEntity );
+        patch.record = ( rootCount > 0 ) ? rootRecord->getSub( rootCount - 1 ) : NULL;
+        patches.push_back( patch );
+        OFVector<DcmDirectoryRecord *> parents;
+        parents.push_back( rootRecord );
+        parents.insert( parents.end(), records.begin(), records.end() );
+        for ( size_t i = 0; ( i < parents.size() ) && ( reason == NULL ); i++ )
+        {
+            const unsigned long count = parents[i]->cardSub();
+            for ( unsigned long j = 0; j < count; j++ )
+            {
+                DcmDirectoryRecord *record = parents[i]->getSub( j );
+                DcmDirectoryRecord *nextRec = ( j + 1 < count ) ? parents[i]->getSub( j + 1 ) : NULL;
+                DcmDirectoryRecord *lowerRec = ( record->cardSub() > 0 ) ? record->getSub( 0 ) : NULL;
+                patch.element = lookForOffsetElem( record, DCM_OffsetOfTheNextDirectoryRecord );
+                patch.record = nextRec;
+                DcmUnsignedLongOffset *lowerElem = lookForOffsetElem( record, DCM_OffsetOfReferencedLowerLevelDirectoryEntity );
+                if ( ( patch.element == NULL ) || ( lowerElem == NULL ) )
+                {
+                    reason = "offset elements missing in record";
+                    break;
+                }
+                // the new records are written with their final offsets
+                if ( record->getFileOffset() >= appendPos )
+                {
+                    patch.element->putUint32( ( nextRec != NULL ) ? nextRec->getFileOffset() : 0 );
+                    patch.element->setNextRecord( nextRec );
+                    lowerElem->putUint32( ( lowerRec != NULL ) ? lowerRec->getFileOffset() : 0 );
+                    lowerElem->setNextRecord( lowerRec );
+                    continue;
+                }
+                // compute the position of the offset elements of existing records
+                DcmDicomDirOffsetPatch lowerPatch;
+                lowerPatch.position = 0;
+                lowerPatch.element = lowerElem;
+                lowerPatch.record = lowerRec;
+                patch.position = 0;
+                offile_off_t elemPos = record->getFileOffset() + 8;
+                const unsigned long numElements = record->card();
+                for ( unsigned long k = 0; ( k < numElements ) && ( lowerPatch.position == 0 ); k++ )
+                {
+                    DcmElement *elem = record->getElement( k );
+                    if ( elem == patch.element )
+                        patch.position = elemPos;
+                    else if ( elem == lowerElem )
+                        lowerPatch.position = elemPos;
+                    elemPos += elem->calcElementLength( oxfer, enctype );
+                }
+                if ( ( patch.position == 0 ) || ( lowerPatch.position == 0 ) )
+                {
+                    reason = "offset elements missing in record";
+                    break;
+                }
+                patches.push_back( patch );
+                patches.push_back( lowerPatch );
+            }
+        }
+    }
+
+    // check the current values in the file and remove those that do not change
+    if ( reason == NULL )
+    {
+        size_t numPatches = 0;
+        for ( size_t i = 0; ( i < patches.size() ) && ( reason == NULL ); i++ )
+        {
+            DcmDicomDirOffsetPatch &patch = patches[i];
+            Uint8 expected[12];
+            if ( ( patch.element == NULL ) || patch.element->getUint32( patch.oldValue ).bad() )
+                reason = "offset elements missing";
+            else
+            {
+                patch.newValue = ( patch.record != NULL ) ? patch.record->getFileOffset() : 0;
+                if ( patch.newValue != patch.oldValue )
+                {
+                    encodeOffsetElement( expected, patch.element->getTag(), patch.oldValue );
+                    if ( !readFileBytes( file, patch.position, buffer, 12 ) || ( memcmp( buffer, expected, 12 ) != 0 ) )
+                        reason = "record offsets do not match the file";
+                    else
+                        patches[numPatches++] = patch;
+                }
+            }
+        }
+        patches.resize( numPatches );
+    }
+
+    if ( reason != NULL )
+    {
+        DCMDATA_DEBUG("DcmDicomDir: cannot append records to DICOMDIR file " << dicomDirFileName
+            << " (" << reason << "), writing complete file");
+        // the offsets of the new records are re-computed by write()
+        file.fclose();
+        return EC_IllegalCall;
+    }
+
+    DCMDATA_DEBUG("DcmDicomDir: appending " << newRecords.size() << " record(s) to DICOMDIR file "
+        << dicomDirFileName << ", updating " << patches.size() << " offset(s)");
+
+    // write the new records at the end of the sequence
+    OFBool ok = ( file.fseek( appendPos, SEEK_SET ) == 0 );
+    OFVector<Uint8> recordBuffer;
+    for ( size_t i = 0; ( i < newRecords.size() ) && ok; i++ )
+    {
+        const Uint32 length = lengthOfRecord( newRecords[i], oxfer, enctype );
+        recordBuffer.resize( length );
+        DcmOutputBufferStream outStream( &recordBuffer[0], length );
+        newRecords[i]->transferInit();
+        ok = newRecords[i]->write( outStream, oxfer, enctype, NULL ).good() && ( outStream.filled() == OFstatic_cast(offile_off_t, length) );
+        newRecords[i]->transferEnd();
+        if ( ok )
+            ok = ( file.fwrite( &recordBuffer[0], 1, length ) == length );
+    }
+    // then terminate or resize the sequence
+    if ( ok )
+    {
+        if ( seqLength == DCM_UndefinedLength )
+        {
+            static const Uint8 seqDelimiter[8] = { 0xfe, 0xff, 0xdd, 0xe0, 0x00, 0x00, 0x00, 0x00 };
+            ok = ( file.fwrite( seqDelimiter, 1, 8 ) == 8 );
+        } else {
+            putLittleEndianUint32( buffer, OFstatic_cast(Uint32, endPos - seqPos - 12) );
+            ok = writeFileBytes( file, seqPos + 8, buffer, 4 );
+        }
+    }
+    // finally, link the new records by updating the offsets of the existing ones
+    for ( size_t i = 0; ( i < patches.size() ) && ok; i++ )
+    {
+        putLittleEndianUint32( buffer, patches[i].newValue );
+        ok = writeFileBytes( file, patches[i].position + 8, buffer, 4 );
+    }
+    if ( ok )
+        ok = ( file.fflush() == 0 );
+    if ( !ok )
+    {
+        OFString message = OFStandard::getLastSystemErrorCode().message();
+        errorFlag = makeOFCondition(OFM_dcmdata, 19, OF_error, message.c_str());
+        DCMDATA_ERROR("DcmDicomDir: Cannot append records to DICOMDIR file: " << dicomDirFileName);
+    } else {
+        for ( size_t i = 0; i < patches.size(); i++ )
+        {
+            patches[i].element->putUint32( patches[i].newValue );
+            patches[i].element->setNextRecord( patches[i].record );
+        }
+        errorFlag = EC_Normal;
+        modified = OFFalse;
+    }
+    file.fclose();
+    return errorFlag;
+}
+
+
+OFCondition DcmDicomDir::writeIncremental(const E_EncodingType enctype,
+                                          const E_GrpLenEncoding glenc)
+{
+    OFCondition result = appendNewRecords(enctype, glenc);
+    if (result == EC_IllegalCall)
+        result = write(DICOMDIR_DEFAULT_TRANSFERSYNTAX, enctype, glenc);
+    return result;
+}
+
+
+// ********************************
+// ********************************
+
+
 OFCondition DcmDicomDir::countMRDRRefs( DcmDirectoryRecord *startRec,
                                         ItemOffset *refCounter,
                                         const unsigned long numCounters )
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2024, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -29,6 +29,8 @@
 #include "dcmtk/ofstd/ofstd.h"
 #include "dcmtk/ofstd/offile.h"
 
+#include <new>
+
 #ifdef HAVE_WINDOWS_H
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -45,6 +47,53 @@
 #define DCM_DICT_COMMENT_CHAR '#'
 
 
+/* Once the global dictionary is frozen, the frozen flag and the dictionary
+ * pointer are read without holding the lock. The same applies to the flag
+ * marking a constructed builtin entry. They are therefore accessed with
+ * atomic loads (acquire) and stores (release), so that a thread that sees
+ * the new value also sees the complete object it refers to. Without the
+ * __atomic builtins, a memory barrier is used around a volatile access,
+ * relying on aligned loads and stores of pointers, ints and bools being
+ * atomic on all platforms with thread support (x86, x64, ARM and ARM64 on
+ * Windows).
+ */
+template <typename T>
+static inline T loadAcquire(const T *ptr)
+{
+#ifdef HAVE_ATOMIC_LOAD_N
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#else
+  T value = *OFconst_cast(const volatile T *, ptr);
+#ifdef HAVE_WINDOWS_H
+  MemoryBarrier();
+#elif defined(HAVE_SYNC_ADD_AND_FETCH)
+  __sync_synchronize();
+#endif
+  return value;
+#endif
+}
+
+template <typename T>
+static inline void storeRelease(T *ptr, T value)
+{
+#ifdef HAVE_ATOMIC_LOAD_N
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#else
+#ifdef HAVE_WINDOWS_H
+  MemoryBarrier();
+#elif defined(HAVE_SYNC_ADD_AND_FETCH)
+  __sync_synchronize();
+#endif
+  *OFconst_cast(volatile T *, ptr) = value;
+#endif
+}
+
+#ifdef WITH_THREADS
+/* mutex protecting the construction of the builtin entries */
+static OFMutex builtinEntryMutex;
+#endif
+
+
 /*
 ** THE Global DICOM Data Dictionary
 */
@@ -113,11 +162,44 @@ DcmDataDictionary::DcmDataDictionary(OFBool loadBuiltin, OFBool loadExternal)
   : hashDict(),
     repDict(),
     skeletonCount(0),
-    dictionaryLoaded(OFFalse)
+    dictionaryLoaded(OFFalse),
+    builtinEntries(NULL),
+    builtinStorage(NULL),
+    builtinCount(0),
+    builtinDisplacements(NULL),
+    builtinBucketMask(0),
+    builtinSlots(NULL),
+    builtinSlotMask(0)
 {
     reloadDictionaries(loadBuiltin, loadExternal);
 }
 
+DcmDataDictionary::DcmDataDictionary(const DcmDataDictionary &other)
+  : hashDict(),
+    repDict(),
+    skeletonCount(other.skeletonCount),
+    dictionaryLoaded(other.dictionaryLoaded),
+    builtinEntries(other.builtinEntries),
+    builtinStorage(other.builtinStorage),
+    builtinCount(other.builtinCount),
+    builtinDisplacements(other.builtinDisplacements),
+    builtinBucketMask(other.builtinBucketMask),
+    builtinSlots(other.builtinSlots),
+    builtinSlotMask(other.builtinSlotMask)
+{
+    /* the static part of the builtin dictionary (if any) is shared */
+    /* copy the normal tag entries */
+    DcmHashDictIterator iter(other.hashDict.begin());
+    DcmHashDictIterator last(other.hashDict.end());
+    for (; iter != last; ++iter)
+        hashDict.put(new DcmDictEntry(**iter));
+    /* copy the repeating tag entries, the order of the list is significant */
+    DcmDictEntryListConstIterator repIter(other.repDict.begin());
+    DcmDictEntryListConstIterator repLast(other.repDict.end());
+    for (; repIter != repLast; ++repIter)
+        repDict.push_back(new DcmDictEntry(**repIter));
+}
+
 DcmDataDictionary::~DcmDataDictionary()
 {
     clear();
@@ -128,11 +210,125 @@ void DcmDataDictionary::clear()
 {
    hashDict.clear();
    repDict.clear();
+   deleteBuiltinEntries();
    skeletonCount = 0;
    dictionaryLoaded = OFFalse;
 }
 
 
+void DcmDataDictionary::setBuiltinEntries(const DcmBuiltinDictEntry *entries,
+                                          DcmBuiltinDictEntryStorage *storage,
+                                          Uint16 count,
+                                          const Uint16 *displacements,
+                                          Uint32 numBuckets,
+                                          const Uint16 *slots,
+                                          Uint32 tableSize)
+{
+    deleteBuiltinEntries();
+    /* the entries are created on demand, see DcmBuiltinDictEntryStorage::get() */
+    builtinEntries = entries;
+    builtinStorage = storage;
+    builtinCount = count;
+    builtinDisplacements = displacements;
+    builtinBucketMask = numBuckets - 1;
+    builtinSlots = slots;
+    builtinSlotMask = tableSize - 1;
+    /* entries loaded later replace earlier ones, e.g. from the skeleton
+     * dictionary. The hash dictionary is usually very small at this point.
+     */
+    if (hashDict.size() > 0)
+    {
+        OFList<DcmTagKey> replaced;
+        DcmHashDictIterator iter(hashDict.begin());
+        DcmHashDictIterator last(hashDict.end());
+        for (; iter != last; ++iter)
+        {
+            if (((*iter)->getPrivateCreator() == NULL) && (findBuiltinEntry(**iter) != NULL))
+                replaced.push_back(**iter);
+        }
+        OFListIterator(DcmTagKey) key = replaced.begin();
+        while (key != replaced.end())
+        {
+            hashDict.del(*key, NULL);
+            ++key;
+        }
+    }
+}
+
+
+int DcmDataDictionary::numberOfNormalTagEntries() const
+{
+    int count = hashDict.size() + builtinCount;
+    /* do not count builtin entries that are overridden by the hash dictionary */
+    for (int i = 0; i < builtinCount; ++i)
+    {
+        if (hashDict.get(DcmTagKey(builtinEntries[i].group, builtinEntries[i].element), NULL) != NULL)
+            --count;
+    }
+    return count;
+}
+
+
+const DcmDictEntry* DcmDataDictionary::findBuiltinEntry(const DcmTagKey& key) const
+{
+    if (builtinEntries != NULL)
+    {
+        const Uint32 k = (OFstatic_cast(Uint32, key.getGroup()) << 16) | key.getElement();
+        /* a displacement of 0 marks an empty bucket */
+        const Uint16 d = builtinDisplacements[builtinHash(k, 0) & builtinBucketMask];
+        if (d != 0)
+        {
+            const Uint16 i = builtinSlots[builtinHash(k, d) & builtinSlotMask];
+            if ((i < builtinCount) && (builtinEntries[i].group == key.getGroup()) &&
+                (builtinEntries[i].element == key.getElement()))
+                return builtinStorage[i].get(builtinEntries[i]);
+        }
+    }
+    return NULL;
+}
+
+
+void DcmDataDictionary::deleteBuiltinEntries()
+{
+    /* the entries are static data that may be shared with other dictionaries */
+    builtinEntries = NULL;
+    builtinStorage = NULL;
+    builtinCount = 0;
+    builtinDisplacements = NULL;
+    builtinBucketMask = 0;
+    builtinSlots = NULL;
+    builtinSlotMask = 0;
+}
+
+
+const DcmDictEntry* DcmBuiltinDictEntryStorage::get(const DcmBuiltinDictEntry& data)
+{
+    DcmDictEntry *e = OFreinterpret_cast(DcmDictEntry *, entry.data);
+    if (!loadAcquire(&constructed))
+    {
+#ifdef WITH_THREADS
+        builtinEntryMutex.lock();
+#endif
+        /* another thread may have constructed the entry in the meantime */
+        if (!constructed)
+        {
+            /* the strings are not copied, they are static data */
+            new (e) DcmDictEntry(data.group, data.element,
+                data.upperGroup, data.upperElement, data.evr,
+                data.tagName, data.vmMin, data.vmMax,
+                data.standardVersion, OFFalse, data.privateCreator);
+            e->setGroupRangeRestriction(data.groupRestriction);
+            e->setElementRangeRestriction(data.elementRestriction);
+            storeRelease(&constructed, 1);
+        }
+#ifdef WITH_THREADS
+        builtinEntryMutex.unlock();
+#endif
+    }
+    return e;
+}
+
+
 static void
 stripWhitespace(char* s)
 {
@@ -731,6 +927,8 @@ DcmDataDictionary::findEntry(const DcmDictEntry& entry) const
         }
     } else {
         e = hashDict.get(entry, entry.getPrivateCreator());
+        if ((e == NULL) && (entry.getPrivateCreator() == NULL))
+            e = findBuiltinEntry(entry);
     }
     return e;
 }
@@ -744,6 +942,10 @@ DcmDataDictionary::findEntry(const DcmTagKey& key, const char *privCreator) cons
     const DcmDictEntry* e = NULL;
 
     e = hashDict.get(key, privCreator);
+    if ((e == NULL) && (privCreator == NULL)) {
+        /* search in the static part of the builtin dictionary */
+        e = findBuiltinEntry(key);
+    }
     if (e == NULL) {
         /* search in the repeating tags dictionary */
         OFBool found = OFFalse;
@@ -781,6 +983,12 @@ DcmDataDictionary::findEntry(const char *name) const
         }
     }
 
+    /* search in the static part of the builtin dictionary, which has no private tags */
+    for (int i = 0; (e == NULL) && (i < builtinCount); ++i) {
+        if (strcmp(builtinEntries[i].tagName, name) == 0)
+            e = builtinStorage[i].get(builtinEntries[i]);
+    }
+
     if (e == NULL) {
         /* search in the repeating tags dictionary */
         OFBool found = OFFalse;
@@ -808,6 +1016,9 @@ DcmDataDictionary::findEntry(const char *name) const
 
 GlobalDcmDataDictionary::GlobalDcmDataDictionary()
   : dataDict(NULL)
+  , writeDict(NULL)
+  , retiredDicts()
+  , frozen(OFFalse)
 #ifdef WITH_THREADS
   , dataDictLock()
 #endif
@@ -818,6 +1029,12 @@ GlobalDcmDataDictionary::~GlobalDcmDataDictionary()
 {
   /* No threads may be active any more, so no locking needed */
   delete dataDict;
+  OFListIterator(DcmDataDictionary *) iter = retiredDicts.begin();
+  while (iter != retiredDicts.end())
+  {
+    delete *iter;
+    ++iter;
+  }
 }
 
 void GlobalDcmDataDictionary::createDataDict()
@@ -843,6 +1060,10 @@ void GlobalDcmDataDictionary::createDataDict()
 
 const DcmDataDictionary& GlobalDcmDataDictionary::rdlock()
 {
+  /* A frozen dictionary is never modified, so no lock is needed. Since the
+   * dictionary cannot be unfrozen, rdunlock() will come to the same result. */
+  if (loadAcquire(&frozen))
+    return *loadAcquire(&dataDict);
 #ifdef WITH_THREADS
   dataDictLock.rdlock();
 #endif
@@ -857,7 +1078,13 @@ const DcmDataDictionary& GlobalDcmDataDictionary::rdlock()
     dataDictLock.rdlock();
 #endif
   }
-  return *dataDict;
+#ifdef WITH_THREADS
+  /* The dictionary might have been frozen while we were waiting for the
+   * lock. In this case, rdunlock() will not release it, so do it now. */
+  if (loadAcquire(&frozen))
+    dataDictLock.rdunlock();
+#endif
+  return *loadAcquire(&dataDict);
 }
 
 DcmDataDictionary& GlobalDcmDataDictionary::wrlock()
@@ -876,18 +1103,36 @@ DcmDataDictionary& GlobalDcmDataDictionary::wrlock()
     dataDictLock.wrlock();
 #endif
   }
+  if (frozen)
+  {
+    /* Readers do not lock a frozen dictionary, so modify a copy of it.
+     * The write lock still makes sure that there is only one writer. */
+    writeDict = new DcmDataDictionary(*dataDict);
+    return *writeDict;
+  }
   return *dataDict;
 }
 
 void GlobalDcmDataDictionary::rdunlock()
 {
 #ifdef WITH_THREADS
-  dataDictLock.rdunlock();
+  if (!loadAcquire(&frozen))
+    dataDictLock.rdunlock();
 #endif
 }
 
 void GlobalDcmDataDictionary::wrunlock()
 {
+  if (writeDict)
+  {
+    /* Publish the modified copy. The previous snapshot is kept since other
+     * threads might still be using it. The release store makes sure that
+     * the new dictionary is completely visible to other threads before the
+     * pointer is replaced. */
+    retiredDicts.push_back(dataDict);
+    storeRelease(&dataDict, writeDict);
+    writeDict = NULL;
+  }
 #ifdef WITH_THREADS
   dataDictLock.wrunlock();
 #endif
@@ -905,3 +1150,16 @@ void GlobalDcmDataDictionary::clear()
   wrlock().clear();
   wrunlock();
 }
+
+void GlobalDcmDataDictionary::freeze()
+{
+  /* make sure the dictionary exists and no other thread holds a lock */
+  wrlock();
+  storeRelease(&frozen, OFTrue);
+  wrunlock();
+}
+
+OFBool GlobalDcmDataDictionary::isFrozen() const
+{
+  return loadAcquire(&frozen);
+}
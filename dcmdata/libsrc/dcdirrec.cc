@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2023, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -582,11 +582,13 @@ E_DirRecType DcmDirectoryRecord::lookForRecordType()
         {
             if (stack.top()->ident() == EVR_CS)
             {
-                char *recName = NULL;
+                OFString recName;
                 DcmCodeString *recType = OFstatic_cast(DcmCodeString *, stack.top());
                 recType->verify(OFTrue);            // force dealignment
-                recType->getString(recName);
-                localType = recordNameToType(recName);
+                // the normalized value does not contain the trailing padding,
+                // which is retained if automatic input data correction is disabled
+                recType->getOFString(recName, 0, OFTrue /* normalize */);
+                localType = recordNameToType(recName.c_str());
 
                 DCMDATA_TRACE("DcmDirectoryRecord::lookForRecordType() RecordType Element "
                     << recType->getTag() << " Type = " << DRTypeNames[DirRecordType]);
@@ -1158,25 +1160,19 @@ OFCondition DcmDirectoryRecord::convertCharacterSet(DcmSpecificCharacterSet &con
     if (findAndGetOFStringArray(DCM_SpecificCharacterSet, fromCharset, OFFalse /*searchIntoSub*/).good() &&
         (fromCharset != converter.getSourceCharacterSet()))
     {
-        DcmSpecificCharacterSet newConverter;
-        // create a new character set converter
-        DCMDATA_DEBUG("DcmDirectoryRecord::convertCharacterSet() creating a new character set converter for '"
+        DCMDATA_DEBUG("DcmDirectoryRecord::convertCharacterSet() using a character set converter for '"
             << fromCharset << "'" << (fromCharset.empty() ? " (ASCII)" : "") << " to '"
             << toCharset << "'" << (toCharset.empty() ? " (ASCII)" : ""));
-        // select source and destination character set, use same transliteration mode
-        status = newConverter.selectCharacterSet(fromCharset, toCharset);
+        // get a converter for the source and destination character set, use same transliteration mode
+        DcmSpecificCharacterSet *newConverter = NULL;
+        status = DcmSpecificCharacterSet::acquireConverter(fromCharset, toCharset, converter.getConversionFlags(), newConverter);
         if (status.good())
         {
-            const unsigned cflags = converter.getConversionFlags();
-            if (cflags > 0)
-                status = newConverter.setConversionFlags(cflags);
-            if (status.good())
-            {
-                // convert all affected element values in the item with the new converter
-                status = DcmItem::convertCharacterSet(newConverter);
-                // update the Specific Character Set (0008,0005) element
-                updateSpecificCharacterSet(status, newConverter);
-            }
+            // convert all affected element values in the item with the new converter
+            status = DcmItem::convertCharacterSet(*newConverter);
+            // update the Specific Character Set (0008,0005) element
+            updateSpecificCharacterSet(status, *newConverter);
+            DcmSpecificCharacterSet::releaseConverter(newConverter);
         }
     } else {
         // no Specific Character Set attribute or the same character set,
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2023, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -31,6 +31,7 @@
 #include "dcmtk/dcmdata/dcobject.h"
 #include "dcmtk/dcmdata/dcswap.h"
 #include "dcmtk/dcmdata/dcistrma.h"    /* for class DcmInputStream */
+#include "dcmtk/dcmdata/dcistrmf.h"    /* for class DcmInputFileStreamFactory */
 #include "dcmtk/dcmdata/dcostrma.h"    /* for class DcmOutputStream */
 #include "dcmtk/dcmdata/dcfcache.h"    /* for class DcmFileCache */
 #include "dcmtk/dcmdata/dcwcache.h"    /* for class DcmWriteCache */
@@ -642,6 +643,38 @@ OFCondition DcmElement::loadAllDataIntoMemory()
 }
 
 
+OFCondition DcmElement::getValueFileLocation(OFFilename &filename,
+                                             offile_off_t &offset,
+                                             Uint32 &length) const
+{
+    /* the value must still remain in the file */
+    if (fValue || !fLoadValue || (getTransferState() == ERW_inWork))
+        return EC_IllegalCall;
+    switch (fLoadValue->ident())
+    {
+        case DFT_DcmInputFileStreamFactory:
+        {
+            const DcmInputFileStreamFactory *factory = OFstatic_cast(const DcmInputFileStreamFactory *, fLoadValue);
+            filename = factory->getFilename();
+            offset = factory->getOffset();
+            break;
+        }
+        case DFT_DcmInputSharedFileStreamFactory:
+        {
+            const DcmInputSharedFileStreamFactory *factory = OFstatic_cast(const DcmInputSharedFileStreamFactory *, fLoadValue);
+            filename = factory->getFileHandle()->getFilename();
+            offset = factory->getOffset();
+            break;
+        }
+        default:
+            /* value remains in a temporary file that might be deleted at any time */
+            return EC_IllegalCall;
+    }
+    length = getLengthField();
+    return EC_Normal;
+}
+
+
 OFCondition DcmElement::loadValue(DcmInputStream *inStream)
 {
     /* initialize return value */
@@ -858,12 +891,11 @@ OFCondition DcmElement::changeValue(const void *value,
                     errorFlag = EC_MemoryExhausted;
                 if (errorFlag.good())
                 {
-                    // swap to local byte order
-                    swapIfNecessary(gLocalByteOrder, fByteOrder, fValue,
-                                    getLengthField(), getTag().getVR().getValueWidth());
+                    // copy old value in the beginning of new value,
+                    // swapping it to local byte order while copying
+                    copySwapIfNecessary(gLocalByteOrder, fByteOrder, newValue, fValue,
+                                        getLengthField(), getTag().getVR().getValueWidth());
                     fByteOrder = gLocalByteOrder;
-                    // copy old value in the beginning of new value
-                    memcpy(newValue, fValue, size_t(getLengthField()));
                     // copy value passed as a parameter to the end
                     memcpy(&newValue[getLengthField()], OFstatic_cast(const Uint8 *, value), size_t(num));
 #if defined(HAVE_STD__NOTHROW) && defined(HAVE_NOTHROW_DELETE)
@@ -1752,6 +1784,16 @@ OFCondition DcmElement::getPartialValue(void *targetBuffer,
   if (valueLoaded())
   {
     // the attribute value is already in memory.
+    const size_t valueWidth = getTag().getVR().getValueWidth();
+    if ((byteOrder != fByteOrder) && (byteOrder != EBO_unknown) && (fByteOrder != EBO_unknown) &&
+        (valueWidth > 0) && (offset % valueWidth == 0) && (numBytes % valueWidth == 0))
+    {
+      // the requested range consists of complete values. Swap them while
+      // copying instead of changing the byte order of the complete value field.
+      copySwapIfNecessary(byteOrder, fByteOrder, targetBuffer, fValue + offset, numBytes, valueWidth);
+      return EC_Normal;
+    }
+
     // change internal byte order of the attribute value to the desired byte order.
     // This should only happen once for multiple calls to this method since the
     // caller will hopefully always request the same byte order.
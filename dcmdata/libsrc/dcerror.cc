@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -84,6 +84,9 @@ makeOFConditionConst(EC_XMLValidationFailure,            OFM_dcmdata, 58, OF_err
 makeOFConditionConst(EC_SOPClassMismatch,                OFM_dcmdata, 59, OF_error, "SOP class mismatch" );
 makeOFConditionConst(EC_UnknownUIDName,                  OFM_dcmdata, 60, OF_error, "Unknown UID name: No mapping to UID value defined" );
 makeOFConditionConst(EC_CannotWriteStringAsJsonNumber,   OFM_dcmdata, 61, OF_error, "Cannot write IS/DS string as JSON number" );
+makeOFConditionConst(EC_TagOrderViolation,               OFM_dcmdata, 62, OF_error, "Data elements not written in ascending tag order" );
+makeOFConditionConst(EC_ValueLengthMismatch,             OFM_dcmdata, 63, OF_error, "Number of bytes written does not match the announced value length" );
+makeOFConditionConst(EC_JsonParseError,                  OFM_dcmdata, 64, OF_error, "JSON parse error" );
 
 const unsigned short EC_CODE_CannotSelectCharacterSet     = 35;
 const unsigned short EC_CODE_CannotConvertCharacterSet    = 36;
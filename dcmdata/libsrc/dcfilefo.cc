@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -938,11 +938,13 @@ OFCondition DcmFileFormat::loadFileUntilTag(
             }
 
         } else {
-            /* open file for output */
-            DcmInputFileStream fileStream(fileName);
+            /* open file for input (through a shared file handle or memory mapped, if enabled and possible) */
+            DcmInputStream *fileStream = dcmUseSharedFileHandleInput.get()
+                ? OFstatic_cast(DcmInputStream *, new DcmInputSharedFileStream(fileName))
+                : DcmInputMappedFileStream::create(fileName, 0, dcmUseMemoryMappedFileInput.get());
 
             /* check stream status */
-            l_error = fileStream.status();
+            l_error = fileStream->status();
             if (l_error.good())
             {
                 /* clear this object */
@@ -954,18 +956,37 @@ OFCondition DcmFileFormat::loadFileUntilTag(
                     FileReadMode = readMode;
                     /* read data from file */
                     transferInit();
-                    l_error = readUntilTag(fileStream, readXfer, groupLength, maxReadLength, stopParsingAtElement);
+                    l_error = readUntilTag(*fileStream, readXfer, groupLength, maxReadLength, stopParsingAtElement);
                     transferEnd();
                     /* restore old value */
                     FileReadMode = oldMode;
                 }
             }
+            delete fileStream;
         }
     }
     return l_error;
 }
 
 
+OFCondition DcmFileFormat::loadFileSelective(const OFFilename &fileName,
+                                             const DcmTagSelection &selection,
+                                             const E_TransferSyntax readXfer,
+                                             const E_GrpLenEncoding groupLength,
+                                             const Uint32 maxReadLength,
+                                             const E_FileReadMode readMode)
+{
+    DcmDataset *dataset = getDataset();
+    if (dataset == NULL)
+        return EC_IllegalCall;
+    /* the selection is only used while reading this file */
+    dataset->setReadSelection(&selection);
+    OFCondition l_error = loadFile(fileName, readXfer, groupLength, maxReadLength, readMode);
+    dataset->setReadSelection(NULL);
+    return l_error;
+}
+
+
 OFCondition DcmFileFormat::saveFile(const OFFilename &fileName,
                                     const E_TransferSyntax writeXfer,
                                     const E_EncodingType encodingType,
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2021, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -169,6 +169,10 @@ DcmHashDictIterator::init(const DcmHashDict* d, OFBool atEnd)
     dict = d;
     hindex = 0;
     iterating = OFFalse;
+    if (atEnd || extra == NULL)
+        extraIndex = extraCount;
+    else
+        stepExtra(0);
     if (dict != NULL) {
         if (atEnd || dict->size() == 0) {
             hindex = dict->highestBucket;
@@ -184,9 +188,31 @@ DcmHashDictIterator::init(const DcmHashDict* d, OFBool atEnd)
     }
 }
 
+const DcmDictEntry*
+DcmHashDictIterator::operator*() const
+{
+    return (extraIndex < extraCount) ? extraStorage[extraIndex].get(extra[extraIndex]) : (*iter);
+}
+
+void
+DcmHashDictIterator::stepExtra(int index)
+{
+    /* skip the additional entries that are overridden by the hash dictionary */
+    extraIndex = index;
+    while ((extraIndex < extraCount) && (dict != NULL) &&
+           (dict->get(DcmTagKey(extra[extraIndex].group, extra[extraIndex].element), NULL) != NULL))
+        extraIndex++;
+}
+
 void
 DcmHashDictIterator::stepUp()
 {
+    if (extraIndex < extraCount)
+    {
+        /* the hash table has already been positioned at its first entry */
+        stepExtra(extraIndex + 1);
+        return;
+    }
     assert(dict != NULL);
 
     while (hindex <= dict->highestBucket) {
@@ -356,6 +382,7 @@ DcmHashDict::del(const DcmTagKey& key, const char *privCreator)
     DcmDictEntryList* bucket = hashTab[idx];
     if (bucket != NULL) {
         DcmDictEntry* entry = removeInList(*bucket, key, privCreator);
+        if (entry != NULL) entryCount--;
         delete entry;
     }
 }
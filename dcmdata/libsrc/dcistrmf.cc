@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2021, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -32,8 +32,27 @@ BEGIN_EXTERN_C
 #ifdef HAVE_IO_H
 #include <io.h>
 #endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
 END_EXTERN_C
 
+/* use pread() for shared file handles, which does not modify the file position */
+#if defined(HAVE_UNISTD_H) && !defined(_WIN32)
+#define DCMSHAREDFILE_USE_PREAD
+#endif
+
+/* size of the read buffer of DcmSharedFileProducer */
+#define DCMSHAREDFILE_BUFSIZE 65536
+
+/* minimum size of a read request that DcmSharedFileProducer passes
+ * directly to the file instead of re-filling its read buffer
+ */
+#define DCMSHAREDFILE_DIRECTREAD 4096
+
 DcmFileProducer::DcmFileProducer(const OFFilename &filename, offile_off_t offset)
 : DcmProducer()
 , file_()
@@ -136,10 +155,139 @@ void DcmFileProducer::putback(offile_off_t num)
 
 /* ======================================================================= */
 
-DcmInputFileStreamFactory::DcmInputFileStreamFactory(const OFFilename &filename, offile_off_t offset)
+DcmMappedFileProducer::DcmMappedFileProducer(const OFFilename &filename, offile_off_t offset)
+: DcmProducer()
+, data_(NULL)
+, status_(EC_Normal)
+, size_(0)
+, pos_(0)
+{
+#ifdef HAVE_SYS_MMAN_H
+  OFFile file;
+  if (file.fopen(filename, "rb"))
+  {
+    // Get number of bytes in file
+    file.fseek(0L, SEEK_END);
+    size_ = file.ftell();
+    if ((offset < 0) || (offset > size_))
+      status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, "Invalid offset for memory mapped file");
+    else if (OFstatic_cast(Uint64, size_) > OFstatic_cast(Uint64, OFstatic_cast(size_t, -1)))
+      status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, "File too large to be mapped into memory");
+    else if (size_ > 0)
+    {
+      // the mapping remains valid after the file has been closed
+      void *addr = mmap(NULL, OFstatic_cast(size_t, size_), PROT_READ, MAP_PRIVATE, file.fileNo(), 0);
+      if (addr == MAP_FAILED)
+      {
+        char buf[256];
+        status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, OFStandard::strerror(errno, buf, sizeof(buf)));
+      }
+      else
+      {
+        data_ = OFstatic_cast(Uint8 *, addr);
+#ifdef MADV_SEQUENTIAL
+        // DICOM files are usually parsed from start to end
+        (void) madvise(addr, OFstatic_cast(size_t, size_), MADV_SEQUENTIAL);
+#endif
+      }
+    }
+    if (status_.good()) pos_ = offset;
+    file.fclose();
+  }
+  else
+  {
+    OFString s("(unknown error code)");
+    file.getLastErrorString(s);
+    status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, s.c_str());
+  }
+#else
+  (void) filename;
+  (void) offset;
+  status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, "Memory mapped files not supported on this system");
+#endif
+}
+
+DcmMappedFileProducer::~DcmMappedFileProducer()
+{
+#ifdef HAVE_SYS_MMAN_H
+  if (data_) munmap(data_, OFstatic_cast(size_t, size_));
+#endif
+}
+
+OFBool DcmMappedFileProducer::good() const
+{
+  return status_.good();
+}
+
+OFCondition DcmMappedFileProducer::status() const
+{
+  return status_;
+}
+
+OFBool DcmMappedFileProducer::eos()
+{
+  return (pos_ >= size_);
+}
+
+offile_off_t DcmMappedFileProducer::avail()
+{
+  if (status_.good()) return size_ - pos_; else return 0;
+}
+
+offile_off_t DcmMappedFileProducer::read(void *buf, offile_off_t buflen)
+{
+  offile_off_t result = 0;
+  if (status_.good() && data_ && buf && buflen)
+  {
+    result = (size_ - pos_ < buflen) ? (size_ - pos_) : buflen;
+    memcpy(buf, data_ + pos_, OFstatic_cast(size_t, result));
+    pos_ += result;
+  }
+  return result;
+}
+
+offile_off_t DcmMappedFileProducer::skip(offile_off_t skiplen)
+{
+  offile_off_t result = 0;
+  if (status_.good() && skiplen)
+  {
+    result = (size_ - pos_ < skiplen) ? (size_ - pos_) : skiplen;
+    pos_ += result;
+  }
+  return result;
+}
+
+void DcmMappedFileProducer::putback(offile_off_t num)
+{
+  if (status_.good() && num)
+  {
+    if (num <= pos_)
+      pos_ -= num;
+    else status_ = EC_PutbackFailed; // tried to putback before start of file
+  }
+}
+
+const void *DcmMappedFileProducer::view(offile_off_t &len) const
+{
+  if (status_.good() && data_)
+  {
+    len = size_ - pos_;
+    return data_ + pos_;
+  }
+  len = 0;
+  return NULL;
+}
+
+
+/* ======================================================================= */
+
+DcmInputFileStreamFactory::DcmInputFileStreamFactory(const OFFilename &filename,
+                                                     offile_off_t offset,
+                                                     OFBool useMemoryMapping)
 : DcmInputStreamFactory()
 , filename_(filename)
 , offset_(offset)
+, useMemoryMapping_(useMemoryMapping)
 {
 }
 
@@ -147,6 +295,7 @@ DcmInputFileStreamFactory::DcmInputFileStreamFactory(const DcmInputFileStreamFac
 : DcmInputStreamFactory(arg)
 , filename_(arg.filename_)
 , offset_(arg.offset_)
+, useMemoryMapping_(arg.useMemoryMapping_)
 {
 }
 
@@ -156,6 +305,8 @@ DcmInputFileStreamFactory::~DcmInputFileStreamFactory()
 
 DcmInputStream *DcmInputFileStreamFactory::create() const
 {
+  if (useMemoryMapping_)
+    return DcmInputMappedFileStream::create(filename_, offset_, OFTrue);
   return new DcmInputFileStream(filename_, offset_);
 }
 
@@ -185,6 +336,44 @@ DcmInputStreamFactory *DcmInputFileStream::newFactory() const
 
 /* ======================================================================= */
 
+DcmInputMappedFileStream::DcmInputMappedFileStream(const OFFilename &filename, offile_off_t offset)
+: DcmInputStream(&producer_) // safe because DcmInputStream only stores pointer
+, producer_(filename, offset)
+, filename_(filename)
+{
+}
+
+DcmInputMappedFileStream::~DcmInputMappedFileStream()
+{
+}
+
+DcmInputStreamFactory *DcmInputMappedFileStream::newFactory() const
+{
+  DcmInputStreamFactory *result = NULL;
+  if (currentProducer() == &producer_)
+  {
+    // no filter installed, can create factory object
+    result = new DcmInputFileStreamFactory(filename_, tell(), OFTrue);
+  }
+  return result;
+}
+
+DcmInputStream *DcmInputMappedFileStream::create(const OFFilename &filename,
+                                                 offile_off_t offset,
+                                                 OFBool useMemoryMapping)
+{
+  if (useMemoryMapping)
+  {
+    DcmInputStream *stream = new DcmInputMappedFileStream(filename, offset);
+    if (stream->good()) return stream;
+    // mapping failed, try again with a plain file stream
+    delete stream;
+  }
+  return new DcmInputFileStream(filename, offset);
+}
+
+/* ======================================================================= */
+
 DcmInputStream *DcmTempFileHandler::create() const
 {
     return new DcmInputFileStream(filename_, 0);
@@ -262,3 +451,298 @@ DcmInputStreamFactory *DcmInputTempFileStreamFactory::clone() const
 {
     return new DcmInputTempFileStreamFactory(*this);
 }
+
+/* ======================================================================= */
+
+DcmSharedFileHandle::DcmSharedFileHandle(const OFFilename &filename)
+#ifdef WITH_THREADS
+: refCount_(1), mutex_(), file_(), status_(EC_Normal), size_(0), filename_(filename)
+#else
+: refCount_(1), file_(), status_(EC_Normal), size_(0), filename_(filename)
+#endif
+{
+  if (file_.fopen(filename, "rb"))
+  {
+    // Get number of bytes in file
+    file_.fseek(0L, SEEK_END);
+    size_ = file_.ftell();
+  }
+  else
+  {
+    OFString s("(unknown error code)");
+    file_.getLastErrorString(s);
+    status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, s.c_str());
+  }
+}
+
+DcmSharedFileHandle::~DcmSharedFileHandle()
+{
+  file_.fclose();
+}
+
+DcmSharedFileHandle *DcmSharedFileHandle::newInstance(const OFFilename &filename)
+{
+  return new DcmSharedFileHandle(filename);
+}
+
+OFCondition DcmSharedFileHandle::status() const
+{
+  return status_;
+}
+
+const OFFilename &DcmSharedFileHandle::getFilename() const
+{
+  return filename_;
+}
+
+offile_off_t DcmSharedFileHandle::getFileSize() const
+{
+  return size_;
+}
+
+offile_off_t DcmSharedFileHandle::readAt(void *buf, offile_off_t buflen, offile_off_t offset)
+{
+  offile_off_t result = 0;
+  if (status_.bad() || (buf == NULL) || (buflen <= 0) || (offset < 0) || (offset >= size_)) return 0;
+  if (buflen > size_ - offset) buflen = size_ - offset;
+#ifdef DCMSHAREDFILE_USE_PREAD
+  const int fd = file_.fileNo();
+  char *target = OFstatic_cast(char *, buf);
+  while (result < buflen)
+  {
+#ifdef EXPLICIT_LFS_64
+    const ssize_t count = pread64(fd, target + result, OFstatic_cast(size_t, buflen - result), offset + result);
+#else
+    const ssize_t count = pread(fd, target + result, OFstatic_cast(size_t, buflen - result), offset + result);
+#endif
+    if (count > 0) result += count;
+    else if ((count < 0) && (errno == EINTR)) continue;
+    else break; // end of file or error
+  }
+#else
+  // no pread(), serialize access to the file position
+#ifdef WITH_THREADS
+  mutex_.lock();
+#endif
+  if (file_.fseek(offset, SEEK_SET) == 0)
+    result = OFstatic_cast(offile_off_t, file_.fread(buf, 1, OFstatic_cast(size_t, buflen)));
+#ifdef WITH_THREADS
+  mutex_.unlock();
+#endif
+#endif
+  return result;
+}
+
+void DcmSharedFileHandle::increaseRefCount()
+{
+#ifdef WITH_THREADS
+  mutex_.lock();
+#endif
+  ++refCount_;
+#ifdef WITH_THREADS
+  mutex_.unlock();
+#endif
+}
+
+void DcmSharedFileHandle::decreaseRefCount()
+{
+#ifdef WITH_THREADS
+  mutex_.lock();
+#endif
+  size_t result = --refCount_;
+#ifdef WITH_THREADS
+  mutex_.unlock();
+#endif
+  if (result == 0) delete this;
+}
+
+/* ======================================================================= */
+
+DcmSharedFileProducer::DcmSharedFileProducer(const OFFilename &filename, offile_off_t offset)
+: DcmProducer()
+, handle_(DcmSharedFileHandle::newInstance(filename))
+, status_(handle_->status())
+, size_(handle_->getFileSize())
+, pos_(0)
+, buf_(NULL)
+, bufStart_(0)
+, bufCount_(0)
+{
+  if (status_.good())
+  {
+    if ((offset < 0) || (offset > size_))
+      status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, "Invalid offset for shared file handle");
+    else pos_ = offset;
+  }
+}
+
+DcmSharedFileProducer::DcmSharedFileProducer(DcmSharedFileHandle *handle, offile_off_t offset)
+: DcmProducer()
+, handle_(handle)
+, status_(handle->status())
+, size_(handle->getFileSize())
+, pos_(0)
+, buf_(NULL)
+, bufStart_(0)
+, bufCount_(0)
+{
+  handle_->increaseRefCount();
+  if (status_.good())
+  {
+    if ((offset < 0) || (offset > size_))
+      status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, "Invalid offset for shared file handle");
+    else pos_ = offset;
+  }
+}
+
+DcmSharedFileProducer::~DcmSharedFileProducer()
+{
+  delete[] buf_;
+  handle_->decreaseRefCount();
+}
+
+OFBool DcmSharedFileProducer::good() const
+{
+  return status_.good();
+}
+
+OFCondition DcmSharedFileProducer::status() const
+{
+  return status_;
+}
+
+OFBool DcmSharedFileProducer::eos()
+{
+  if (status_.bad()) return OFTrue;
+  return pos_ >= size_;
+}
+
+offile_off_t DcmSharedFileProducer::avail()
+{
+  if (status_.good()) return size_ - pos_; else return 0;
+}
+
+offile_off_t DcmSharedFileProducer::read(void *buf, offile_off_t buflen)
+{
+  offile_off_t result = 0;
+  if (status_.good() && buf && buflen)
+  {
+    Uint8 *target = OFstatic_cast(Uint8 *, buf);
+    while ((result < buflen) && (pos_ < size_))
+    {
+      offile_off_t count = 0;
+      if ((pos_ >= bufStart_) && (pos_ < bufStart_ + bufCount_))
+      {
+        // serve the request from the read buffer
+        count = bufStart_ + bufCount_ - pos_;
+        if (count > buflen - result) count = buflen - result;
+        memcpy(target + result, buf_ + (pos_ - bufStart_), OFstatic_cast(size_t, count));
+      }
+      else if (buflen - result >= DCMSHAREDFILE_DIRECTREAD)
+      {
+        // large block, read directly into the caller's memory
+        count = handle_->readAt(target + result, buflen - result, pos_);
+      }
+      else
+      {
+        // re-fill the read buffer
+        if (buf_ == NULL) buf_ = new Uint8[DCMSHAREDFILE_BUFSIZE];
+        bufStart_ = pos_;
+        bufCount_ = handle_->readAt(buf_, DCMSHAREDFILE_BUFSIZE, pos_);
+        if (bufCount_ > 0) continue;
+      }
+      if (count == 0)
+      {
+        // read error, file has probably been truncated
+        status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, "Unable to read from shared file handle");
+        break;
+      }
+      pos_ += count;
+      result += count;
+    }
+  }
+  return result;
+}
+
+offile_off_t DcmSharedFileProducer::skip(offile_off_t skiplen)
+{
+  offile_off_t result = 0;
+  if (status_.good() && skiplen > 0)
+  {
+    result = (size_ - pos_ < skiplen) ? (size_ - pos_) : skiplen;
+    pos_ += result;
+  }
+  return result;
+}
+
+void DcmSharedFileProducer::putback(offile_off_t num)
+{
+  if (status_.good() && num)
+  {
+    if (num <= pos_) pos_ -= num;
+    else status_ = EC_PutbackFailed; // tried to putback before start of file
+  }
+}
+
+/* ======================================================================= */
+
+DcmInputSharedFileStream::DcmInputSharedFileStream(const OFFilename &filename, offile_off_t offset)
+: DcmInputStream(&producer_) // safe because DcmInputStream only stores pointer
+, producer_(filename, offset)
+{
+}
+
+DcmInputSharedFileStream::DcmInputSharedFileStream(DcmSharedFileHandle *handle, offile_off_t offset)
+: DcmInputStream(&producer_) // safe because DcmInputStream only stores pointer
+, producer_(handle, offset)
+{
+}
+
+DcmInputSharedFileStream::~DcmInputSharedFileStream()
+{
+}
+
+DcmInputStreamFactory *DcmInputSharedFileStream::newFactory() const
+{
+  DcmInputStreamFactory *result = NULL;
+  if (currentProducer() == &producer_)
+  {
+    // no filter installed, can create factory object.
+    // Since there is no filter, the producer's position is the stream position.
+    result = new DcmInputSharedFileStreamFactory(producer_.getFileHandle(), producer_.tell());
+  }
+  return result;
+}
+
+/* ======================================================================= */
+
+DcmInputSharedFileStreamFactory::DcmInputSharedFileStreamFactory(DcmSharedFileHandle *handle, offile_off_t offset)
+: DcmInputStreamFactory()
+, fileHandle_(handle)
+, offset_(offset)
+{
+  fileHandle_->increaseRefCount();
+}
+
+DcmInputSharedFileStreamFactory::DcmInputSharedFileStreamFactory(const DcmInputSharedFileStreamFactory &arg)
+: DcmInputStreamFactory(arg)
+, fileHandle_(arg.fileHandle_)
+, offset_(arg.offset_)
+{
+  fileHandle_->increaseRefCount();
+}
+
+DcmInputSharedFileStreamFactory::~DcmInputSharedFileStreamFactory()
+{
+  fileHandle_->decreaseRefCount();
+}
+
+DcmInputStream *DcmInputSharedFileStreamFactory::create() const
+{
+  return new DcmInputSharedFileStream(fileHandle_, offset_);
+}
+
+DcmInputStreamFactory *DcmInputSharedFileStreamFactory::clone() const
+{
+  return new DcmInputSharedFileStreamFactory(*this);
+}
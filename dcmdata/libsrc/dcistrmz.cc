@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2010, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -26,10 +26,20 @@
 #include "dcmtk/dcmdata/dcistrmz.h"
 #include "dcmtk/dcmdata/dcerror.h"
 
-#define DCMZLIBINPUTFILTER_BUFSIZE 4096
+#define DCMZLIBINPUTFILTER_DEFAULT_BUFSIZE 65536
+#define DCMZLIBINPUTFILTER_MIN_BUFSIZE 4096
 #define DCMZLIBINPUTFILTER_PUTBACKSIZE 1024
 
 OFGlobal<OFBool> dcmZlibExpectRFC1950Encoding(OFFalse);
+OFGlobal<Uint32> dcmZlibInputBufferSize(DCMZLIBINPUTFILTER_DEFAULT_BUFSIZE);
+
+/* determine the buffer size to be used by a new filter object */
+static offile_off_t getInputBufferSize()
+{
+  Uint32 size = dcmZlibInputBufferSize.get();
+  if (size < DCMZLIBINPUTFILTER_MIN_BUFSIZE) size = DCMZLIBINPUTFILTER_MIN_BUFSIZE;
+  return OFstatic_cast(offile_off_t, size);
+}
 
 // helper methods to fix old-style casts warnings
 BEGIN_EXTERN_C
@@ -50,10 +60,11 @@ DcmZLibInputFilter::DcmZLibInputFilter()
 , zstream_(new z_stream)
 , status_(EC_MemoryExhausted)
 , eos_(OFFalse)
-, inputBuf_(new unsigned char[DCMZLIBINPUTFILTER_BUFSIZE])
+, bufSize_(getInputBufferSize())
+, inputBuf_(new unsigned char[OFstatic_cast(size_t, bufSize_)])
 , inputBufStart_(0)
 , inputBufCount_(0)
-, outputBuf_(new unsigned char[DCMZLIBINPUTFILTER_BUFSIZE])
+, outputBuf_(new unsigned char[OFstatic_cast(size_t, bufSize_)])
 , outputBufStart_(0)
 , outputBufCount_(0)
 , outputBufPutback_(0)
@@ -150,10 +161,10 @@ offile_off_t DcmZLibInputFilter::read(void *buf, offile_off_t buflen)
     {
       // determine next block of data in output buffer
       offset = outputBufStart_ + outputBufPutback_;
-      if (offset >= DCMZLIBINPUTFILTER_BUFSIZE) offset -= DCMZLIBINPUTFILTER_BUFSIZE;
+      if (offset >= bufSize_) offset -= bufSize_;
 
       availBytes = outputBufCount_;
-      if (offset + availBytes > DCMZLIBINPUTFILTER_BUFSIZE) availBytes = DCMZLIBINPUTFILTER_BUFSIZE - offset;
+      if (offset + availBytes > bufSize_) availBytes = bufSize_ - offset;
       if (availBytes > buflen) availBytes = buflen;
 
       if (availBytes) memcpy(target, outputBuf_ + offset, OFstatic_cast(size_t, availBytes));
@@ -167,7 +178,7 @@ offile_off_t DcmZLibInputFilter::read(void *buf, offile_off_t buflen)
       if (outputBufPutback_ > DCMZLIBINPUTFILTER_PUTBACKSIZE)
       {
         outputBufStart_ += outputBufPutback_ - DCMZLIBINPUTFILTER_PUTBACKSIZE;
-        if (outputBufStart_ >= DCMZLIBINPUTFILTER_BUFSIZE) outputBufStart_ -= DCMZLIBINPUTFILTER_BUFSIZE;
+        if (outputBufStart_ >= bufSize_) outputBufStart_ -= bufSize_;
         outputBufPutback_ = DCMZLIBINPUTFILTER_PUTBACKSIZE;
       }
     }
@@ -193,10 +204,10 @@ offile_off_t DcmZLibInputFilter::skip(offile_off_t skiplen)
     {
       // determine next block of data in output buffer
       offset = outputBufStart_ + outputBufPutback_;
-      if (offset >= DCMZLIBINPUTFILTER_BUFSIZE) offset -= DCMZLIBINPUTFILTER_BUFSIZE;
+      if (offset >= bufSize_) offset -= bufSize_;
 
       availBytes = outputBufCount_;
-      if (offset + availBytes > DCMZLIBINPUTFILTER_BUFSIZE) availBytes = DCMZLIBINPUTFILTER_BUFSIZE - offset;
+      if (offset + availBytes > bufSize_) availBytes = bufSize_ - offset;
       if (availBytes > skiplen) availBytes = skiplen;
       result += availBytes;
       skiplen -= availBytes;
@@ -208,7 +219,7 @@ offile_off_t DcmZLibInputFilter::skip(offile_off_t skiplen)
       {
         outputBufStart_ += outputBufPutback_ - DCMZLIBINPUTFILTER_PUTBACKSIZE;
         outputBufPutback_ = DCMZLIBINPUTFILTER_PUTBACKSIZE;
-        if (outputBufStart_ >= DCMZLIBINPUTFILTER_BUFSIZE) outputBufStart_ -= DCMZLIBINPUTFILTER_BUFSIZE;
+        if (outputBufStart_ >= bufSize_) outputBufStart_ -= bufSize_;
       }
     }
 
@@ -238,14 +249,14 @@ void DcmZLibInputFilter::append(DcmProducer& producer)
 offile_off_t DcmZLibInputFilter::fillInputBuffer()
 {
   offile_off_t result = 0;
-  if (status_.good() && current_ && (inputBufCount_ < DCMZLIBINPUTFILTER_BUFSIZE))
+  if (status_.good() && current_ && (inputBufCount_ < bufSize_))
   {
 
     // use first part of input buffer
-    if (inputBufStart_ + inputBufCount_ < DCMZLIBINPUTFILTER_BUFSIZE)
+    if (inputBufStart_ + inputBufCount_ < bufSize_)
     {
       result = current_->read(inputBuf_ + inputBufStart_ + inputBufCount_,
-        DCMZLIBINPUTFILTER_BUFSIZE - (inputBufStart_ + inputBufCount_));
+        bufSize_ - (inputBufStart_ + inputBufCount_));
 
       inputBufCount_ += result;
 
@@ -264,11 +275,11 @@ offile_off_t DcmZLibInputFilter::fillInputBuffer()
     }
 
     // use second part of input buffer
-    if (inputBufCount_ < DCMZLIBINPUTFILTER_BUFSIZE &&
-        inputBufStart_ + inputBufCount_ >= DCMZLIBINPUTFILTER_BUFSIZE)
+    if (inputBufCount_ < bufSize_ &&
+        inputBufStart_ + inputBufCount_ >= bufSize_)
     {
-      offile_off_t result2 = current_->read(inputBuf_ + (inputBufStart_ + inputBufCount_ - DCMZLIBINPUTFILTER_BUFSIZE),
-        DCMZLIBINPUTFILTER_BUFSIZE - inputBufCount_);
+      offile_off_t result2 = current_->read(inputBuf_ + (inputBufStart_ + inputBufCount_ - bufSize_),
+        bufSize_ - inputBufCount_);
 
       inputBufCount_ += result2;
       result += result2;
@@ -277,7 +288,7 @@ offile_off_t DcmZLibInputFilter::fillInputBuffer()
       {
          // producer has signalled eos, now append zero pad byte that makes
          // zlib recognize the end of stream when no zlib header is present
-         *(inputBuf_ + inputBufStart_ + inputBufCount_ - DCMZLIBINPUTFILTER_BUFSIZE) = 0;
+         *(inputBuf_ + inputBufStart_ + inputBufCount_ - bufSize_) = 0;
          inputBufCount_++;
          padded_ = OFTrue;
       }
@@ -296,8 +307,8 @@ offile_off_t DcmZLibInputFilter::decompress(const void *buf, offile_off_t buflen
   int astatus;
 
   // decompress from inputBufStart_ to end of data or end of buffer, whatever comes first
-  offile_off_t numBytes = (inputBufStart_ + inputBufCount_ > DCMZLIBINPUTFILTER_BUFSIZE) ?
-         (DCMZLIBINPUTFILTER_BUFSIZE - inputBufStart_) : inputBufCount_ ;
+  offile_off_t numBytes = (inputBufStart_ + inputBufCount_ > bufSize_) ?
+         (bufSize_ - inputBufStart_) : inputBufCount_ ;
 
   if (numBytes || buflen)
   {
@@ -338,7 +349,7 @@ offile_off_t DcmZLibInputFilter::decompress(const void *buf, offile_off_t buflen
     inputBufStart_ += numBytes - OFstatic_cast(offile_off_t, zstream_->avail_in);
     inputBufCount_ -= numBytes - OFstatic_cast(offile_off_t, zstream_->avail_in);
 
-    if (inputBufStart_ == DCMZLIBINPUTFILTER_BUFSIZE)
+    if (inputBufStart_ == bufSize_)
     {
       // wrapped around
       inputBufStart_ = 0;
@@ -407,10 +418,10 @@ void DcmZLibInputFilter::fillOutputBuffer()
 
     // determine next block of free space in output buffer
     offset = outputBufStart_ + outputBufPutback_ + outputBufCount_;
-    if (offset >= DCMZLIBINPUTFILTER_BUFSIZE) offset -= DCMZLIBINPUTFILTER_BUFSIZE;
+    if (offset >= bufSize_) offset -= bufSize_;
 
-    availBytes = DCMZLIBINPUTFILTER_BUFSIZE - (outputBufPutback_ + outputBufCount_);
-    if (offset + availBytes > DCMZLIBINPUTFILTER_BUFSIZE) availBytes = DCMZLIBINPUTFILTER_BUFSIZE - offset;
+    availBytes = bufSize_ - (outputBufPutback_ + outputBufCount_);
+    if (offset + availBytes > bufSize_) availBytes = bufSize_ - offset;
 
     // decompress to output buffer
     outputBytes = decompress(outputBuf_ + offset, availBytes);
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2023, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -28,6 +28,7 @@
 #include "dcmtk/dcmdata/dcobject.h"
 #include "dcmtk/dcmdata/dcostrma.h"   /* for class DcmOutputStream */
 #include "dcmtk/dcmdata/dcovlay.h"
+#include "dcmtk/dcmdata/dcpath.h"     /* for class DcmTagSelection */
 #include "dcmtk/dcmdata/dcpixel.h"
 #include "dcmtk/dcmdata/dcsequen.h"
 #include "dcmtk/dcmdata/dcswap.h"
@@ -83,7 +84,13 @@ DcmItem::DcmItem()
     elementList(NULL),
     lastElementComplete(OFTrue),
     fStartPosition(0),
-    privateCreatorCache()
+    privateCreatorCache(),
+    elementIndex(),
+    elementIndexVersion(0),
+    elementIndexCreated(OFFalse),
+    readSelection(NULL),
+    skipBytesRemaining(0),
+    discardElement(NULL)
 {
     elementList = new DcmList;
 }
@@ -95,7 +102,13 @@ DcmItem::DcmItem(const DcmTag &tag,
     elementList(NULL),
     lastElementComplete(OFTrue),
     fStartPosition(0),
-    privateCreatorCache()
+    privateCreatorCache(),
+    elementIndex(),
+    elementIndexVersion(0),
+    elementIndexCreated(OFFalse),
+    readSelection(NULL),
+    skipBytesRemaining(0),
+    discardElement(NULL)
 {
     elementList = new DcmList;
 }
@@ -106,7 +119,13 @@ DcmItem::DcmItem(const DcmItem &old)
     elementList(new DcmList),
     lastElementComplete(old.lastElementComplete),
     fStartPosition(old.fStartPosition),
-    privateCreatorCache()
+    privateCreatorCache(),
+    elementIndex(),
+    elementIndexVersion(0),
+    elementIndexCreated(OFFalse),
+    readSelection(NULL),
+    skipBytesRemaining(0),
+    discardElement(NULL)
 {
     if (!old.elementList->empty())
     {
@@ -1240,6 +1259,16 @@ OFCondition DcmItem::readTagAndLength(DcmInputStream &inStream,
 // ********************************
 
 
+void DcmItem::addPrivateCreator(const DcmTagKey &tag,
+                                const char *privateCreator)
+{
+    privateCreatorCache.updateCache(tag, privateCreator);
+}
+
+
+// ********************************
+
+
 OFCondition DcmItem::readSubElement(DcmInputStream &inStream,
                                     DcmTag &newTag,
                                     const Uint32 newLength,
@@ -1252,7 +1281,9 @@ OFCondition DcmItem::readSubElement(DcmInputStream &inStream,
     /* create a new DcmElement* object with corresponding tag and */
     /* length; the object will be accessible through subElem */
     OFBool readAsUN = OFFalse;
-    OFCondition l_error = DcmItem::newDicomElement(subElem, newTag, newLength, &privateCreatorCache, readAsUN);
+    DcmMemoryArena *arena = getMemoryArena();
+    elementList->setMemoryArena(arena);
+    OFCondition l_error = DcmItem::newDicomElement(subElem, newTag, newLength, &privateCreatorCache, readAsUN, arena);
 
     /* if no error occurred and subElem does not equal NULL, go ahead */
     if (l_error.good() && subElem != NULL)
@@ -1262,9 +1293,27 @@ OFCondition DcmItem::readSubElement(DcmInputStream &inStream,
         /* insert the new element into the (sorted) element list and */
         /* assign information which was read from the inStream to it */
         subElem->transferInit();
+        /* if only selected attributes are read, a sequence is either filtered */
+        /* in the same way or, if not selected at all, parsed and discarded */
+        if (readSelection != NULL)
+        {
+            if (!isSelectedForReading(newTag))
+                discardElement = subElem;
+            if (subElem->ident() == EVR_SQ)
+            {
+                static const DcmTagSelection emptySelection;
+                OFstatic_cast(DcmSequenceOfItems *, subElem)->setItemReadSelection(
+                    (discardElement == subElem) ? &emptySelection : readSelection->getItemSelection(newTag));
+            }
+        }
+        /* temporarily set the parent, so that a sequence allocates its */
+        /* items from the memory arena of this item (if any) */
+        if (arena != NULL)
+            subElem->setParent(this);
         /* we need to read the content of the attribute, no matter if */
         /* inserting the attribute succeeds or fails */
         l_error = subElem->read(inStream, (readAsUN ? EXS_LittleEndianImplicit : xfer), glenc, maxReadLength);
+        subElem->setParent(NULL);
         // try to insert element into item. Note that
         // "elementList->insert(subElem, ELP_next)" would be faster,
         // but this is better since this insert-function creates a
@@ -1278,6 +1327,8 @@ OFCondition DcmItem::readSubElement(DcmInputStream &inStream,
             // produce diagnostics
             DCMDATA_WARN("DcmItem: Element " << newTag
                 << " found twice in one data set or item, ignoring second entry");
+            if (discardElement == subElem)
+                discardElement = NULL;
             delete subElem;
         }
     }
@@ -1338,6 +1389,51 @@ OFCondition DcmItem::readSubElement(DcmInputStream &inStream,
 // ********************************
 
 
+OFCondition DcmItem::skipSubElementValue(DcmInputStream &inStream)
+{
+    while ((skipBytesRemaining > 0) && inStream.good())
+    {
+        const offile_off_t skipped = inStream.skip(skipBytesRemaining);
+        if (skipped <= 0)
+            break;
+        skipBytesRemaining -= OFstatic_cast(Uint32, skipped);
+    }
+    if (inStream.status().bad())
+        return inStream.status();
+    /* not enough data available, continue with the next call of read() */
+    return (skipBytesRemaining > 0) ? EC_StreamNotifyClient : EC_Normal;
+}
+
+
+OFBool DcmItem::isSelectedForReading(const DcmTagKey &tag) const
+{
+    return (readSelection == NULL) || (tag.getGroup() == 0xfffe) ||
+        readSelection->isSelected(tag) || readSelection->isNeededPrivateCreator(tag);
+}
+
+
+void DcmItem::setReadSelection(const DcmTagSelection *selection)
+{
+    readSelection = selection;
+    /* the sequences read so far refer to parts of the previous selection,
+     * which is usually destroyed after reading, so clear them as well
+     */
+    if ((selection == NULL) && !elementList->empty())
+    {
+        elementList->seek(ELP_first);
+        do
+        {
+            DcmObject *dO = elementList->get();
+            if ((dO != NULL) && (dO->ident() == EVR_SQ))
+                OFstatic_cast(DcmSequenceOfItems *, dO)->setItemReadSelection(NULL);
+        } while (elementList->seek(ELP_next));
+    }
+}
+
+
+// ********************************
+
+
 OFCondition DcmItem::read(DcmInputStream & inStream,
                           const E_TransferSyntax xfer,
                           const E_GrpLenEncoding glenc,
@@ -1382,6 +1478,7 @@ OFCondition DcmItem::readUntilTag(DcmInputStream & inStream,
             /* initialize variables */
             Uint32 newValueLength = 0;
             Uint32 bytes_tagAndLen = 0;
+            OFBool elementSkipped = OFFalse;
             /* if the reading of the last element was complete, go ahead and read the next element */
             if (lastElementComplete)
             {
@@ -1437,6 +1534,20 @@ OFCondition DcmItem::readUntilTag(DcmInputStream & inStream,
                       DCMDATA_INFO("DcmItem: Element " << newTag.getTagName() << " " << newTag
                         << " encountered, skipping rest of dataset");
                     }
+                    /* skip the value of attributes that are not selected for reading, */
+                    /* as long as the end of the value can be determined from its length */
+                    else if ((newValueLength != DCM_UndefinedLength) && !isSelectedForReading(newTag))
+                    {
+                      DCMDATA_TRACE("DcmItem::read() skipping element " << newTag
+                        << " with length " << newValueLength);
+                      skipBytesRemaining = newValueLength;
+                      errorFlag = skipSubElementValue(inStream);
+                      if (errorFlag.good())
+                      {
+                        lastElementComplete = OFTrue;
+                        elementSkipped = OFTrue;
+                      }
+                    }
                     else
                     {
                       /* read the actual data value which belongs to this element */
@@ -1458,10 +1569,18 @@ OFCondition DcmItem::readUntilTag(DcmInputStream & inStream,
                 /* tag and length (and possibly VR) information as well as maybe some data */
                 /* data value information. We need to continue reading the data value */
                 /* information for this particular element. */
-                DcmObject *dO = elementList->get();
-                if (dO)
-                  errorFlag = dO->read(inStream, xfer, glenc, maxReadLength);
-                  else errorFlag = EC_InternalError; // should never happen
+                if (skipBytesRemaining > 0)
+                {
+                    /* continue skipping the value of a non-selected attribute */
+                    errorFlag = skipSubElementValue(inStream);
+                    if (errorFlag.good())
+                        elementSkipped = OFTrue;
+                } else {
+                    DcmObject *dO = elementList->get();
+                    if (dO)
+                      errorFlag = dO->read(inStream, xfer, glenc, maxReadLength);
+                      else errorFlag = EC_InternalError; // should never happen
+                }
 
                 /* if reading was successful, we read the entire information */
                 /* for this element; hence lastElementComplete is true */
@@ -1472,8 +1591,14 @@ OFCondition DcmItem::readUntilTag(DcmInputStream & inStream,
             setTransferredBytes(OFstatic_cast(Uint32, inStream.tell() - fStartPosition));
             if (errorFlag.good())
             {
+                // If we completed an element that is not selected for reading, delete it
+                if (lastElementComplete && (discardElement != NULL))
+                {
+                    delete remove(discardElement);
+                    discardElement = NULL;
+                }
                 // If we completed one element, update the private tag cache.
-                if (lastElementComplete)
+                else if (lastElementComplete && !elementSkipped)
                 {
                     privateCreatorCache.updateCache(elementList->get());
                     // evaluate option for skipping rest of dataset
@@ -1740,6 +1865,8 @@ void DcmItem::transferInit()
     DcmObject::transferInit();
     fStartPosition = 0;
     lastElementComplete = OFTrue;
+    skipBytesRemaining = 0;
+    discardElement = NULL;
     privateCreatorCache.clear();
     if (!elementList->empty())
     {
@@ -1774,6 +1901,8 @@ OFCondition DcmItem::insert(DcmElement *elem,
 {
     /* initialize error flag with ok */
     errorFlag = EC_Normal;
+    /* check whether the element index can be updated incrementally */
+    const OFBool indexInSync = elementIndexInSync();
     /* do something only if the pointer which was passed does not equal NULL */
     if (elem != NULL)
     {
@@ -1903,6 +2032,16 @@ OFCondition DcmItem::insert(DcmElement *elem,
     /* if the pointer which was passed equals NULL, this is an illegal call */
     else
         errorFlag = EC_IllegalCall;
+    /* keep the element index (if any) up to date */
+    if (errorFlag.good() && indexInSync)
+    {
+        const size_t pos = lowerBoundInElementIndex(elem->getTag());
+        if ((pos < elementIndex.size()) && (elementIndex[pos]->getTag().getTagKey() == elem->getTag().getTagKey()))
+            elementIndex[pos] = elem;
+        else
+            elementIndex.insert(elementIndex.begin() + pos, elem);
+        elementIndexVersion = elementList->modificationCounter();
+    }
     /* return result value */
     return errorFlag;
 }
@@ -1994,12 +2133,15 @@ DcmElement *DcmItem::remove(const unsigned long num)
 {
     errorFlag = EC_Normal;
     DcmElement *elem;
+    const OFBool indexInSync = elementIndexInSync();
     elem = OFstatic_cast(DcmElement *, elementList->seek_to(num));
     // read element from list
     if (elem != NULL)
     {
         elementList->remove();          // removes element from list but does not delete it
         elem->setParent(NULL);          // forget about the parent
+        if (indexInSync)
+            removeFromElementIndex(elem);
     } else
         errorFlag = EC_IllegalCall;
     return elem;
@@ -2015,6 +2157,7 @@ DcmElement *DcmItem::remove(DcmObject *elem)
     if (!elementList->empty() && elem != NULL)
     {
         DcmObject *dO;
+        const OFBool indexInSync = elementIndexInSync();
         elementList->seek(ELP_first);
         do {
             dO = elementList->get();
@@ -2022,6 +2165,8 @@ DcmElement *DcmItem::remove(DcmObject *elem)
             {
                 elementList->remove();     // removes element from list but does not delete it
                 elem->setParent(NULL);     // forget about the parent
+                if (indexInSync)
+                    removeFromElementIndex(OFstatic_cast(DcmElement *, elem));
                 errorFlag = EC_Normal;
                 break;
             }
@@ -2041,6 +2186,14 @@ DcmElement *DcmItem::remove(const DcmTagKey &tag)
 {
     errorFlag = EC_TagNotFound;
     DcmObject *dO = NULL;
+    /* use the element index (if any) to find out quickly whether the tag exists at all */
+    const OFBool indexInSync = updateElementIndex();
+    if (indexInSync)
+    {
+        const size_t pos = lowerBoundInElementIndex(tag);
+        if ((pos == elementIndex.size()) || (elementIndex[pos]->getTag() != tag))
+            return NULL;
+    }
     if (!elementList->empty())
     {
         elementList->seek(ELP_first);
@@ -2050,6 +2203,8 @@ DcmElement *DcmItem::remove(const DcmTagKey &tag)
             {
                 elementList->remove();     // removes element from list but does not delete it
                 dO->setParent(NULL);       // forget about the parent
+                if (indexInSync)
+                    removeFromElementIndex(OFstatic_cast(DcmElement *, dO));
                 errorFlag = EC_Normal;
                 break;
             }
@@ -2105,6 +2260,83 @@ OFCondition DcmItem::verify(const OFBool autocorrect)
 }
 
 
+// ********************************
+
+
+OFBool DcmItem::elementIndexInSync() const
+{
+    return elementIndexCreated && !elementIndex.empty() &&
+        (elementIndexVersion == elementList->modificationCounter());
+}
+
+
+OFBool DcmItem::updateElementIndex()
+{
+    const Uint32 threshold = dcmElementIndexThreshold.get();
+    if ((threshold == 0) || (elementList->card() < threshold))
+    {
+        /* index not used (anymore) */
+        if (elementIndexCreated)
+        {
+            elementIndex.clear();
+            elementIndexCreated = OFFalse;
+        }
+        return OFFalse;
+    }
+    /* (re-)create the index if the element list has been modified */
+    if (!elementIndexCreated || (elementIndexVersion != elementList->modificationCounter()))
+    {
+        elementIndex.clear();
+        elementIndex.reserve(elementList->card());
+        DcmObject *dO = elementList->seek(ELP_first);
+        while (dO != NULL)
+        {
+            /* the binary search requires the elements to be sorted, which should always be the case */
+            if (!elementIndex.empty() && !(elementIndex.back()->getTag().getTagKey() < dO->getTag().getTagKey()))
+            {
+                DCMDATA_DEBUG("DcmItem: Elements not in ascending tag order, cannot use element index");
+                elementIndex.clear();
+                break;
+            }
+            elementIndex.push_back(OFstatic_cast(DcmElement *, dO));
+            dO = elementList->seek(ELP_next);
+        }
+        elementIndexVersion = elementList->modificationCounter();
+        elementIndexCreated = OFTrue;
+    }
+    return !elementIndex.empty();
+}
+
+
+size_t DcmItem::lowerBoundInElementIndex(const DcmTagKey &tag) const
+{
+    size_t first = 0;
+    size_t count = elementIndex.size();
+    while (count > 0)
+    {
+        const size_t step = count / 2;
+        if (elementIndex[first + step]->getTag().getTagKey() < tag)
+        {
+            first += step + 1;
+            count -= step + 1;
+        } else
+            count = step;
+    }
+    return first;
+}
+
+
+void DcmItem::removeFromElementIndex(DcmElement *elem)
+{
+    const size_t pos = lowerBoundInElementIndex(elem->getTag());
+    if ((pos < elementIndex.size()) && (elementIndex[pos] == elem))
+    {
+        elementIndex.erase(elementIndex.begin() + pos);
+        elementIndexVersion = elementList->modificationCounter();
+    }
+}
+
+
 // ********************************
 
 // Precondition: elementList is non-empty!
@@ -2121,7 +2353,18 @@ OFCondition DcmItem::searchSubFromHere(const DcmTagKey &tag,
 {
     DcmObject *dO;
     OFCondition l_error = EC_TagNotFound;
-    if (!elementList->empty())
+    /* use binary search in the element index for non-recursive searches */
+    if (!searchIntoSub && updateElementIndex())
+    {
+        const size_t pos = lowerBoundInElementIndex(tag);
+        if ((pos < elementIndex.size()) && (elementIndex[pos]->getTag() == tag))
+        {
+            resultStack.push(elementIndex[pos]);
+            DCMDATA_TRACE("DcmItem::searchSubFromHere() Element " << tag << " found");
+            l_error = EC_Normal;
+        }
+    }
+    else if (!elementList->empty())
     {
         elementList->seek(ELP_first);
         do {
@@ -3846,6 +4089,9 @@ OFCondition DcmItem::putAndInsertSint32Array(const DcmTag& tag,
     DcmElement *elem = NULL;
     switch(tag.getEVR())
     {
+        case EVR_IS:
+            elem = new DcmIntegerString(tag);
+            break;
         case EVR_SL:
             elem = new DcmSignedLong(tag);
             break;
@@ -4006,6 +4252,9 @@ OFCondition DcmItem::putAndInsertFloat64Array(const DcmTag& tag,
     DcmElement *elem = NULL;
     switch(tag.getEVR())
     {
+        case EVR_DS:
+            elem = new DcmDecimalString(tag);
+            break;
         case EVR_FD:
             elem = new DcmFloatingPointDouble(tag);
             break;
@@ -4394,33 +4643,28 @@ OFCondition DcmItem::convertCharacterSet(const OFString &fromCharset,
     // if the item is empty, there is nothing to do
     if (!elementList->empty())
     {
-        DcmSpecificCharacterSet converter;
-        // create a new character set converter
-        DCMDATA_DEBUG("DcmItem::convertCharacterSet() creating a new character set converter for '"
+        unsigned cflags = 0;
+        /* pass flags to underlying implementation */
+        if (flags & DCMTypes::CF_discardIllegal)
+            cflags |= OFCharacterEncoding::DiscardIllegalSequences;
+        if (flags & DCMTypes::CF_transliterate)
+            cflags |= OFCharacterEncoding::TransliterateIllegalSequences;
+        DCMDATA_DEBUG("DcmItem::convertCharacterSet() using a character set converter for '"
             << fromCharset << "'" << (fromCharset.empty() ? " (ASCII)" : "") << " to '"
             << toCharset << "'" << (toCharset.empty() ? " (ASCII)" : ""));
-        // select source and destination character set
-        status = converter.selectCharacterSet(fromCharset, toCharset);
+        // get a converter for the source and destination character set (reused if possible)
+        DcmSpecificCharacterSet *converter = NULL;
+        status = DcmSpecificCharacterSet::acquireConverter(fromCharset, toCharset, cflags, converter);
         if (status.good())
         {
-            unsigned cflags = 0;
-            /* pass flags to underlying implementation */
-            if (flags & DCMTypes::CF_discardIllegal)
-                cflags |= OFCharacterEncoding::DiscardIllegalSequences;
-            if (flags & DCMTypes::CF_transliterate)
-                cflags |= OFCharacterEncoding::TransliterateIllegalSequences;
-            if (cflags > 0)
-                status = converter.setConversionFlags(cflags);
-            if (status.good())
+            // convert all affected element values in the item
+            status = convertCharacterSet(*converter);
+            if (updateCharset)
             {
-                // convert all affected element values in the item
-                status = convertCharacterSet(converter);
-                if (updateCharset)
-                {
-                    // update the Specific Character Set (0008,0005) element
-                    updateSpecificCharacterSet(status, converter);
-                }
+                // update the Specific Character Set (0008,0005) element
+                updateSpecificCharacterSet(status, *converter);
             }
+            DcmSpecificCharacterSet::releaseConverter(converter);
         }
     }
     return status;
@@ -4518,7 +4762,8 @@ OFCondition DcmItem::newDicomElement(DcmElement *&newElement,
                                      DcmTag &tag,
                                      const Uint32 length,
                                      DcmPrivateTagCache *privateCreatorCache,
-                                     OFBool& readAsUN)
+                                     OFBool& readAsUN,
+                                     DcmMemoryArena *arena)
 {
     /* initialize variables */
     OFCondition l_error = EC_Normal;
@@ -4562,72 +4807,72 @@ OFCondition DcmItem::newDicomElement(DcmElement *&newElement,
     {
         // byte strings:
         case EVR_AE :
-            newElement = new DcmApplicationEntity(tag, length);
+            newElement = new (arena) DcmApplicationEntity(tag, length);
             break;
         case EVR_AS :
-            newElement = new DcmAgeString(tag, length);
+            newElement = new (arena) DcmAgeString(tag, length);
             break;
         case EVR_CS :
-            newElement = new DcmCodeString(tag, length);
+            newElement = new (arena) DcmCodeString(tag, length);
             break;
         case EVR_DA :
-            newElement = new DcmDate(tag, length);
+            newElement = new (arena) DcmDate(tag, length);
             break;
         case EVR_DS :
-            newElement = new DcmDecimalString(tag, length);
+            newElement = new (arena) DcmDecimalString(tag, length);
             break;
         case EVR_DT :
-            newElement = new DcmDateTime(tag, length);
+            newElement = new (arena) DcmDateTime(tag, length);
             break;
         case EVR_IS :
-            newElement = new DcmIntegerString(tag, length);
+            newElement = new (arena) DcmIntegerString(tag, length);
             break;
         case EVR_TM :
-            newElement = new DcmTime(tag, length);
+            newElement = new (arena) DcmTime(tag, length);
             break;
         case EVR_UI :
-            newElement = new DcmUniqueIdentifier(tag, length);
+            newElement = new (arena) DcmUniqueIdentifier(tag, length);
             break;
         case EVR_UR:
-            newElement = new DcmUniversalResourceIdentifierOrLocator(tag, length);
+            newElement = new (arena) DcmUniversalResourceIdentifierOrLocator(tag, length);
             break;
 
         // character strings:
         case EVR_LO :
-            newElement = new DcmLongString(tag, length);
+            newElement = new (arena) DcmLongString(tag, length);
             break;
         case EVR_LT :
-            newElement = new DcmLongText(tag, length);
+            newElement = new (arena) DcmLongText(tag, length);
             break;
         case EVR_PN :
-            newElement = new DcmPersonName(tag, length);
+            newElement = new (arena) DcmPersonName(tag, length);
             break;
         case EVR_SH :
-            newElement = new DcmShortString(tag, length);
+            newElement = new (arena) DcmShortString(tag, length);
             break;
         case EVR_ST :
-            newElement = new DcmShortText(tag, length);
+            newElement = new (arena) DcmShortText(tag, length);
             break;
         case EVR_UC:
-            newElement = new DcmUnlimitedCharacters(tag, length);
+            newElement = new (arena) DcmUnlimitedCharacters(tag, length);
             break;
         case EVR_UT:
-            newElement = new DcmUnlimitedText(tag, length);
+            newElement = new (arena) DcmUnlimitedText(tag, length);
             break;
 
         // dependent on byte order:
         case EVR_AT :
-            newElement = new DcmAttributeTag(tag, length);
+            newElement = new (arena) DcmAttributeTag(tag, length);
             break;
         case EVR_SS :
-            newElement = new DcmSignedShort(tag, length);
+            newElement = new (arena) DcmSignedShort(tag, length);
             break;
         case EVR_xs : // according to DICOM standard
         case EVR_US :
-            newElement = new DcmUnsignedShort(tag, length);
+            newElement = new (arena) DcmUnsignedShort(tag, length);
             break;
         case EVR_SL :
-            newElement = new DcmSignedLong(tag, length);
+            newElement = new (arena) DcmSignedLong(tag, length);
             break;
         case EVR_up : // for (0004,eeee) according to DICOM standard
         case EVR_UL :
@@ -4635,39 +4880,39 @@ OFCondition DcmItem::newDicomElement(DcmElement *&newElement,
                 // generate tag with VR from dictionary!
                 DcmTag ulupTag(tag.getTagKey());
                 if (ulupTag.getEVR() == EVR_up)
-                    newElement = new DcmUnsignedLongOffset(ulupTag, length);
+                    newElement = new (arena) DcmUnsignedLongOffset(ulupTag, length);
                 else
-                    newElement = new DcmUnsignedLong(tag, length);
+                    newElement = new (arena) DcmUnsignedLong(tag, length);
             }
             break;
         case EVR_OL :
-            newElement = new DcmOtherLong(tag, length);
+            newElement = new (arena) DcmOtherLong(tag, length);
             break;
         case EVR_SV :
-            newElement = new DcmSigned64bitVeryLong(tag, length);
+            newElement = new (arena) DcmSigned64bitVeryLong(tag, length);
             break;
         case EVR_UV :
-            newElement = new DcmUnsigned64bitVeryLong(tag, length);
+            newElement = new (arena) DcmUnsigned64bitVeryLong(tag, length);
             break;
         case EVR_OV :
-            newElement = new DcmOther64bitVeryLong(tag, length);
+            newElement = new (arena) DcmOther64bitVeryLong(tag, length);
             break;
         case EVR_FL :
-            newElement = new DcmFloatingPointSingle(tag, length);
+            newElement = new (arena) DcmFloatingPointSingle(tag, length);
             break;
         case EVR_FD :
-            newElement = new DcmFloatingPointDouble(tag, length);
+            newElement = new (arena) DcmFloatingPointDouble(tag, length);
             break;
         case EVR_OF :
-            newElement = new DcmOtherFloat(tag, length);
+            newElement = new (arena) DcmOtherFloat(tag, length);
             break;
         case EVR_OD :
-            newElement = new DcmOtherDouble(tag, length);
+            newElement = new (arena) DcmOtherDouble(tag, length);
             break;
 
         // sequences and items:
         case EVR_SQ :
-            newElement = new DcmSequenceOfItems(tag, length, readAsUN);
+            newElement = new (arena) DcmSequenceOfItems(tag, length, readAsUN);
             break;
         case EVR_na :
             if (tag == DCM_Item)
@@ -4686,25 +4931,25 @@ OFCondition DcmItem::newDicomElement(DcmElement *&newElement,
         // unclear 8 or 16 bit:
         case EVR_ox :
             if (tag == DCM_PixelData)
-                newElement = new DcmPixelData(tag, length);
+                newElement = new (arena) DcmPixelData(tag, length);
             else if (tag.getBaseTag() == DCM_OverlayData)
-                newElement = new DcmOverlayData(tag, length);
+                newElement = new (arena) DcmOverlayData(tag, length);
             else
                 /* we don't know this element's real transfer syntax, so we just
                  * use the defaults of class DcmOtherByteOtherWord and let the
                  * application handle it.
                  */
-                newElement = new DcmOtherByteOtherWord(tag, length);
+                newElement = new (arena) DcmOtherByteOtherWord(tag, length);
             break;
 
         case EVR_px :
-            newElement = new DcmPixelData(tag, length);
+            newElement = new (arena) DcmPixelData(tag, length);
             break;
 
         // This case should only occur if we encounter an element with an invalid
         // "Pi" VR. Make sure this does not cause problems later on
         case EVR_PixelData :
-            newElement = new DcmPixelData(tag, length);
+            newElement = new (arena) DcmPixelData(tag, length);
             // set VR to OW to make sure that we never write/send the internal VR
             if (newElement) newElement->setVR(EVR_OW);
             break;
@@ -4712,21 +4957,21 @@ OFCondition DcmItem::newDicomElement(DcmElement *&newElement,
         // This case should only occur if we encounter an element with an invalid
         // "Ov" VR. Make sure this does not cause problems later on
         case EVR_OverlayData :
-            newElement = new DcmOverlayData(tag, length);
+            newElement = new (arena) DcmOverlayData(tag, length);
             // set VR to OW to make sure that we never write/send the internal VR
             if (newElement) newElement->setVR(EVR_OW);
             break;
 
         case EVR_lt :
-            newElement = new DcmOtherByteOtherWord(tag, length);
+            newElement = new (arena) DcmOtherByteOtherWord(tag, length);
             break;
 
         case EVR_OB :
         case EVR_OW :
             if (tag == DCM_PixelData)
-                newElement = new DcmPixelData(tag, length);
+                newElement = new (arena) DcmPixelData(tag, length);
             else if (tag.getBaseTag() == DCM_OverlayData)
-                newElement = new DcmOverlayData(tag, length);
+                newElement = new (arena) DcmOverlayData(tag, length);
             else if ((tag == DCM_VOILUTSequence) && (length != DCM_UndefinedLength))
             {
                 // this is an incorrectly encoded VOI LUT Sequence.
@@ -4736,14 +4981,14 @@ OFCondition DcmItem::newDicomElement(DcmElement *&newElement,
                   // Silently fix the error by interpreting as a sequence.
                   DcmTag newTag(tag);
                   newTag.setVR(DcmVR(EVR_SQ)); // on writing we will handle this element as SQ, not OB/OW
-                  newElement = new DcmSequenceOfItems(newTag, length);
+                  newElement = new (arena) DcmSequenceOfItems(newTag, length);
                 } else {
 
                     if (dcmIgnoreParsingErrors.get())
                     {
                         // ignore parse error, keep VR unchanged
                         DCMDATA_WARN("DcmItem: VOI LUT Sequence with VR=OW and explicit length encountered.");
-                        newElement = new DcmOtherByteOtherWord(tag, length);
+                        newElement = new (arena) DcmOtherByteOtherWord(tag, length);
                     }
                     else
                     {
@@ -4762,7 +5007,7 @@ OFCondition DcmItem::newDicomElement(DcmElement *&newElement,
                 {
                     DCMDATA_WARN("Found private element " << tag << " with VR " << tag.getVRName()
                         << " and undefined length, reading a pixel sequence according to data dictionary");
-                    newElement = new DcmPixelData(tag, length);
+                    newElement = new (arena) DcmPixelData(tag, length);
                 }
             }
             // no element has been created yet and no error reported
@@ -4778,14 +5023,14 @@ OFCondition DcmItem::newDicomElement(DcmElement *&newElement,
                         // catch the sequence delimitation item.
                         DcmTag newTag(tag);
                         newTag.setVR(DcmVR(EVR_SQ)); // on writing we will handle this element as SQ, not OB/OW
-                        newElement = new DcmSequenceOfItems(newTag, length);
+                        newElement = new (arena) DcmSequenceOfItems(newTag, length);
                     } else {
                         if (dcmIgnoreParsingErrors.get())
                         {
                             // ignore parse error, keep VR unchanged
                             OFCondition tempcond = EC_UndefinedLengthOBOW;
                             DCMDATA_WARN("DcmItem: Parse error in " << tag << ": " << tempcond.text());
-                            newElement = new DcmSequenceOfItems(tag, length);
+                            newElement = new (arena) DcmSequenceOfItems(tag, length);
                         } else {
                             // bail out with an error
                             l_error = EC_UndefinedLengthOBOW;
@@ -4794,7 +5039,7 @@ OFCondition DcmItem::newDicomElement(DcmElement *&newElement,
                     }
                 } else {
                     // default case
-                    newElement = new DcmOtherByteOtherWord(tag, length);
+                    newElement = new (arena) DcmOtherByteOtherWord(tag, length);
                 }
             }
             break;
@@ -4816,10 +5061,10 @@ OFCondition DcmItem::newDicomElement(DcmElement *&newElement,
                 } else {
                     DCMDATA_WARN("Found element " << newTag << " with VR UN and undefined length");
                 }
-                newElement = new DcmSequenceOfItems(newTag, length, dcmEnableCP246Support.get());
+                newElement = new (arena) DcmSequenceOfItems(newTag, length, dcmEnableCP246Support.get());
             } else {
                 // defined length UN element, treat like OB
-                newElement = new DcmOtherByteOtherWord(tag, length);
+                newElement = new (arena) DcmOtherByteOtherWord(tag, length);
             }
             break;
 
@@ -0,0 +1,1048 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: streaming parser for the DICOM JSON model
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmdata/dcjsonr.h"
+#include "dcmtk/dcmdata/dcfilefo.h"
+#include "dcmtk/dcmdata/dcmetinf.h"
+#include "dcmtk/dcmdata/dcdatset.h"
+#include "dcmtk/dcmdata/dcsequen.h"
+#include "dcmtk/dcmdata/dcswap.h"
+#include "dcmtk/dcmdata/dcvrsv.h"
+#include "dcmtk/dcmdata/dcvruv.h"
+#include "dcmtk/ofstd/ofstd.h"
+
+/* bit mask of the members of an element object */
+#define JSON_MEMBER_VR           0x01
+#define JSON_MEMBER_VALUE        0x02
+#define JSON_MEMBER_INLINEBINARY 0x04
+#define JSON_MEMBER_BULKDATAURI  0x08
+
+/* maximum nesting depth of JSON objects and arrays */
+#define JSON_MAX_DEPTH 256
+
+/* names of the component groups of a person name */
+static const char *JsonComponentGroupNames[] = { "Alphabetic", "Ideographic", "Phonetic" };
+
+
+struct DcmJsonReader::JsonValue
+{
+  /// type of a value
+  enum Type
+  {
+    /// null
+    JV_null,
+    /// string
+    JV_string,
+    /// number, stored as text
+    JV_number,
+    /// person name object, stored in DICOM notation
+    JV_personName,
+    /// sequence item
+    JV_item
+  };
+
+  JsonValue()
+  : type(JV_null)
+  , text()
+  , item(NULL)
+  {
+  }
+
+  /// type of this value
+  Type type;
+
+  /// text of the value
+  OFString text;
+
+  /// sequence item, owned by this value until inserted into a sequence
+  DcmItem *item;
+};
+
+
+/* append a Unicode code point to a string in UTF-8 encoding */
+static void appendUTF8(OFString &value, const Uint32 codePoint)
+{
+  if (codePoint < 0x80)
+    value += OFstatic_cast(char, codePoint);
+  else if (codePoint < 0x800)
+  {
+    value += OFstatic_cast(char, 0xc0 | (codePoint >> 6));
+    value += OFstatic_cast(char, 0x80 | (codePoint & 0x3f));
+  }
+  else if (codePoint < 0x10000)
+  {
+    value += OFstatic_cast(char, 0xe0 | (codePoint >> 12));
+    value += OFstatic_cast(char, 0x80 | ((codePoint >> 6) & 0x3f));
+    value += OFstatic_cast(char, 0x80 | (codePoint & 0x3f));
+  }
+  else
+  {
+    value += OFstatic_cast(char, 0xf0 | (codePoint >> 18));
+    value += OFstatic_cast(char, 0x80 | ((codePoint >> 12) & 0x3f));
+    value += OFstatic_cast(char, 0x80 | ((codePoint >> 6) & 0x3f));
+    value += OFstatic_cast(char, 0x80 | (codePoint & 0x3f));
+  }
+}
+
+
+/* convert a hexadecimal digit, returns -1 if the character is no digit */
+static int hexDigit(const char c)
+{
+  if ((c >= '0') && (c <= '9')) return c - '0';
+  if ((c >= 'a') && (c <= 'f')) return c - 'a' + 10;
+  if ((c >= 'A') && (c <= 'F')) return c - 'A' + 10;
+  return -1;
+}
+
+
+/* convert a string of hexadecimal digits, returns OFFalse if invalid */
+static OFBool parseHex(const char *str, const size_t length, Uint32 &result)
+{
+  result = 0;
+  for (size_t i = 0; i < length; ++i)
+  {
+    const int digit = hexDigit(str[i]);
+    if (digit < 0) return OFFalse;
+    result = (result << 4) | OFstatic_cast(Uint32, digit);
+  }
+  return OFTrue;
+}
+
+
+/* check whether the given URI reference starts with a scheme (RFC 3986) */
+static OFBool hasUriScheme(const OFString &uri)
+{
+  for (size_t i = 0; i < uri.length(); ++i)
+  {
+    const char c = uri[i];
+    if (c == ':')
+      return (i > 0);
+    if (!(((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+         ((i > 0) && (((c >= '0') && (c <= '9')) || (c == '+') || (c == '-') || (c == '.')))))
+      return OFFalse;
+  }
+  return OFFalse;
+}
+
+
+/* resolve percent-encoded octets, returns OFFalse if invalid */
+static OFBool decodePercent(const OFString &str, OFString &result)
+{
+  result.clear();
+  Uint32 octet = 0;
+  for (size_t i = 0; i < str.length(); ++i)
+  {
+    if (str[i] != '%')
+      result += str[i];
+    else if ((i + 2 < str.length()) && parseHex(str.c_str() + i + 1, 2, octet) && (octet != 0))
+    {
+      result += OFstatic_cast(char, octet);
+      i += 2;
+    }
+    else
+      return OFFalse;
+  }
+  return OFTrue;
+}
+
+
+/* check whether the given character is a path separator */
+static inline OFBool isPathSeparator(const char c)
+{
+  return (c == '/') || (c == '\\');
+}
+
+
+/* check that a path is relative and does not refer to a parent directory */
+static OFBool isSafeRelativePath(const OFString &path)
+{
+  if (path.empty() || isPathSeparator(path[0]) || (path.find(':') != OFString_npos))
+    return OFFalse;
+  size_t start = 0;
+  while (start <= path.length())
+  {
+    size_t end = path.find_first_of("/\\", start);
+    if (end == OFString_npos)
+      end = path.length();
+    if (path.compare(start, end - start, "..") == 0)
+      return OFFalse;
+    start = end + 1;
+  }
+  return OFTrue;
+}
+
+
+DcmJsonReader::DcmJsonReader(const size_t bufferSize)
+: file_()
+, bufferSize_(bufferSize > 0 ? bufferSize : DcmJsonReaderBufferSize)
+, buffer_()
+, pos_(NULL)
+, end_(NULL)
+, line_(1)
+, bulkDataDir_()
+, topLevel_(TS_done)
+{
+}
+
+
+DcmJsonReader::~DcmJsonReader()
+{
+  close();
+}
+
+
+OFCondition DcmJsonReader::openFile(const OFFilename &filename)
+{
+  close();
+  if (!file_.fopen(filename, "rb"))
+  {
+    DCMDATA_ERROR("cannot open JSON file: " << filename);
+    return EC_InvalidFilename;
+  }
+  buffer_.resize(bufferSize_);
+  topLevel_ = TS_start;
+  return EC_Normal;
+}
+
+
+void DcmJsonReader::setBuffer(const char *data,
+                              const size_t length)
+{
+  close();
+  pos_ = data;
+  end_ = data + length;
+  topLevel_ = TS_start;
+}
+
+
+void DcmJsonReader::close()
+{
+  if (file_.open()) file_.fclose();
+  pos_ = NULL;
+  end_ = NULL;
+  line_ = 1;
+  topLevel_ = TS_done;
+}
+
+
+void DcmJsonReader::setBulkDataDirectory(const OFString &directory)
+{
+  bulkDataDir_ = directory;
+}
+
+
+OFBool DcmJsonReader::refill()
+{
+  if (!file_.open())
+    return OFFalse;
+  const size_t count = file_.fread(&buffer_[0], 1, buffer_.size());
+  pos_ = &buffer_[0];
+  end_ = pos_ + count;
+  return count > 0;
+}
+
+
+OFCondition DcmJsonReader::parseError(const char *message)
+{
+  DCMDATA_ERROR("DcmJsonReader: " << message << " in line " << line_);
+  return EC_JsonParseError;
+}
+
+
+int DcmJsonReader::peek()
+{
+  while (fill())
+  {
+    switch (*pos_)
+    {
+      case '\n':
+        ++line_;
+        /* fall through */
+      case ' ':
+      case '\t':
+      case '\r':
+        ++pos_;
+        break;
+      default:
+        return OFstatic_cast(unsigned char, *pos_);
+    }
+  }
+  return -1;
+}
+
+
+OFCondition DcmJsonReader::expect(const char c)
+{
+  if (peek() != OFstatic_cast(unsigned char, c))
+  {
+    OFString message = "'";
+    message += c;
+    message += "' expected";
+    return parseError(message.c_str());
+  }
+  ++pos_;
+  return EC_Normal;
+}
+
+
+OFCondition DcmJsonReader::readSeparator(const char close,
+                                         OFBool &done)
+{
+  const int c = peek();
+  if (c == ',')
+  {
+    ++pos_;
+    done = OFFalse;
+    return EC_Normal;
+  }
+  if (c == OFstatic_cast(unsigned char, close))
+  {
+    ++pos_;
+    done = OFTrue;
+    return EC_Normal;
+  }
+  return parseError(close == '}' ? "',' or '}' expected" : "',' or ']' expected");
+}
+
+
+OFCondition DcmJsonReader::readString(OFString &value)
+{
+  OFCondition result = expect('"');
+  value.clear();
+  while (result.good())
+  {
+    if (!fill())
+      return parseError("unterminated string");
+    // copy the run of characters that need no processing
+    const char *run = pos_;
+    while ((pos_ < end_) && (*pos_ != '"') && (*pos_ != '\\') && (*pos_ != '\n')) ++pos_;
+    value.append(run, pos_ - run);
+    if (pos_ == end_)
+      continue;
+    const char c = *pos_++;
+    if (c == '"')
+      break;
+    if (c == '\n')
+    {
+      // not permitted in JSON, but harmless
+      ++line_;
+      value += c;
+      continue;
+    }
+    // escape sequence
+    if (!fill())
+      return parseError("unterminated string");
+    const char esc = *pos_++;
+    switch (esc)
+    {
+      case '"':
+      case '\\':
+      case '/':
+        value += esc;
+        break;
+      case 'b':
+        value += '\b';
+        break;
+      case 'f':
+        value += '\f';
+        break;
+      case 'n':
+        value += '\n';
+        break;
+      case 'r':
+        value += '\r';
+        break;
+      case 't':
+        value += '\t';
+        break;
+      case 'u':
+      {
+        char hex[4];
+        Uint32 codePoint = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+          if (!fill())
+            return parseError("unterminated string");
+          hex[i] = *pos_++;
+        }
+        if (!parseHex(hex, 4, codePoint))
+          return parseError("invalid unicode escape sequence");
+        // combine surrogate pairs
+        if ((codePoint >= 0xd800) && (codePoint < 0xdc00) && fill() && (*pos_ == '\\'))
+        {
+          char low[6];
+          int i = 0;
+          for (; (i < 6) && fill(); ++i) low[i] = *pos_++;
+          Uint32 lowSurrogate = 0;
+          if ((i < 6) || (low[1] != 'u') || !parseHex(low + 2, 4, lowSurrogate) ||
+              (lowSurrogate < 0xdc00) || (lowSurrogate >= 0xe000))
+            return parseError("invalid surrogate pair");
+          codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (lowSurrogate - 0xdc00);
+        }
+        appendUTF8(value, codePoint);
+        break;
+      }
+      default:
+        return parseError("invalid escape sequence");
+    }
+  }
+  return result;
+}
+
+
+OFCondition DcmJsonReader::readWord(OFString &value)
+{
+  value.clear();
+  while (fill())
+  {
+    const char *run = pos_;
+    while ((pos_ < end_) && (isalnum(OFstatic_cast(unsigned char, *pos_)) ||
+           (*pos_ == '-') || (*pos_ == '+') || (*pos_ == '.'))) ++pos_;
+    value.append(run, pos_ - run);
+    if (pos_ < end_) break;
+  }
+  if (value.empty())
+    return parseError("value expected");
+  return EC_Normal;
+}
+
+
+OFCondition DcmJsonReader::skipValue(const unsigned int depth)
+{
+  if (depth > JSON_MAX_DEPTH)
+    return parseError("nesting too deep");
+  OFCondition result = EC_Normal;
+  OFString text;
+  OFBool done = OFFalse;
+  switch (peek())
+  {
+    case '"':
+      result = readString(text);
+      break;
+    case '[':
+      ++pos_;
+      if (peek() == ']')
+        ++pos_;
+      else while (result.good() && !done)
+      {
+        result = skipValue(depth + 1);
+        if (result.good()) result = readSeparator(']', done);
+      }
+      break;
+    case '{':
+      ++pos_;
+      if (peek() == '}')
+        ++pos_;
+      else while (result.good() && !done)
+      {
+        result = readString(text);
+        if (result.good()) result = expect(':');
+        if (result.good()) result = skipValue(depth + 1);
+        if (result.good()) result = readSeparator('}', done);
+      }
+      break;
+    default:
+      result = readWord(text);
+      break;
+  }
+  return result;
+}
+
+
+OFCondition DcmJsonReader::readDataset(DcmItem &dataset)
+{
+  if (topLevel_ == TS_done)
+    return EC_EndOfStream;
+  int c = peek();
+  if (topLevel_ == TS_start)
+  {
+    if (c == '[')
+    {
+      ++pos_;
+      topLevel_ = TS_array;
+      c = peek();
+      if (c == ']')
+      {
+        ++pos_;
+        topLevel_ = TS_done;
+        return EC_EndOfStream;
+      }
+    }
+    else if (c < 0)
+    {
+      topLevel_ = TS_done;
+      return EC_EndOfStream;
+    }
+  }
+  OFCondition result = expect('{');
+  if (result.good())
+    result = readItemContent(dataset, NULL, 1);
+  if (result.good())
+  {
+    if (topLevel_ == TS_array)
+    {
+      OFBool done = OFFalse;
+      result = readSeparator(']', done);
+      if (done) topLevel_ = TS_done;
+    }
+    else
+      topLevel_ = TS_done;
+    if ((topLevel_ == TS_done) && result.good() && (peek() >= 0))
+      result = parseError("unexpected data after the end of the document");
+  }
+  // do not continue after a parse error
+  if (result.bad())
+    topLevel_ = TS_done;
+  return result;
+}
+
+
+OFCondition DcmJsonReader::readFileFormat(DcmFileFormat &fileformat)
+{
+  fileformat.clear();
+  DcmDataset *dataset = fileformat.getDataset();
+  DcmMetaInfo *metainfo = fileformat.getMetaInfo();
+  if ((dataset == NULL) || (metainfo == NULL))
+    return EC_IllegalCall;
+  OFCondition result = readDataset(*dataset);
+  if (result.good())
+  {
+    // move the file meta information elements to the meta header
+    DcmObject *obj = dataset->nextInContainer(NULL);
+    while ((obj != NULL) && (obj->getGTag() <= 0x0002))
+    {
+      DcmObject *next = dataset->nextInContainer(obj);
+      if (obj->getGTag() == 0x0002)
+        metainfo->insert(dataset->remove(obj), OFTrue /* replaceOld */);
+      obj = next;
+    }
+  }
+  return result;
+}
+
+
+OFCondition DcmJsonReader::readItemContent(DcmItem &item,
+                                           const OFString *firstKey,
+                                           const unsigned int depth)
+{
+  if (depth > JSON_MAX_DEPTH)
+    return parseError("nesting too deep");
+  OFCondition result = EC_Normal;
+  OFBool done = OFFalse;
+  if (firstKey != NULL)
+  {
+    result = readElement(item, *firstKey, depth + 1);
+    if (result.good())
+      result = readSeparator('}', done);
+  }
+  else if (peek() == '}')
+  {
+    ++pos_;
+    done = OFTrue;
+  }
+  OFString key;
+  while (result.good() && !done)
+  {
+    result = readString(key);
+    if (result.good())
+      result = readElement(item, key, depth + 1);
+    if (result.good())
+      result = readSeparator('}', done);
+  }
+  return result;
+}
+
+
+OFCondition DcmJsonReader::readElement(DcmItem &item,
+                                       const OFString &key,
+                                       const unsigned int depth)
+{
+  if (depth > JSON_MAX_DEPTH)
+    return parseError("nesting too deep");
+  Uint32 group = 0;
+  Uint32 elem = 0;
+  if ((key.length() != 8) || !parseHex(key.c_str(), 4, group) || !parseHex(key.c_str() + 4, 4, elem))
+    return parseError("invalid attribute tag");
+  const DcmTagKey tagKey(OFstatic_cast(Uint16, group), OFstatic_cast(Uint16, elem));
+  OFCondition result = expect(':');
+  if (result.good())
+    result = expect('{');
+  OFString name;
+  OFString vr;
+  OFString inlineBinary;
+  OFString bulkDataURI;
+  OFVector<JsonValue> values;
+  unsigned int member = 0;
+  OFBool done = OFFalse;
+  if (result.good() && (peek() == '}'))
+  {
+    ++pos_;
+    done = OFTrue;
+  }
+  while (result.good() && !done)
+  {
+    result = readString(name);
+    if (result.good())
+      result = expect(':');
+    if (result.good())
+    {
+      if (name == "vr")
+      {
+        result = readString(vr);
+        member |= JSON_MEMBER_VR;
+      }
+      else if (name == "Value")
+      {
+        result = readValueArray(values, depth + 1);
+        member |= JSON_MEMBER_VALUE;
+      }
+      else if (name == "InlineBinary")
+      {
+        result = readString(inlineBinary);
+        member |= JSON_MEMBER_INLINEBINARY;
+      }
+      else if (name == "BulkDataURI")
+      {
+        result = readString(bulkDataURI);
+        member |= JSON_MEMBER_BULKDATAURI;
+      }
+      else
+      {
+        DCMDATA_WARN("DcmJsonReader: ignoring unknown member '" << name << "' of element " << tagKey);
+        result = skipValue(depth + 1);
+      }
+    }
+    if (result.good())
+      result = readSeparator('}', done);
+  }
+  if (result.good())
+    result = createElement(item, tagKey, vr, values, inlineBinary, bulkDataURI, member);
+  // delete all items that have not been inserted into a sequence
+  for (size_t i = 0; i < values.size(); ++i)
+    delete values[i].item;
+  return result;
+}
+
+
+OFCondition DcmJsonReader::readValueArray(OFVector<JsonValue> &values,
+                                          const unsigned int depth)
+{
+  if (depth > JSON_MAX_DEPTH)
+    return parseError("nesting too deep");
+  OFCondition result = expect('[');
+  OFBool done = OFFalse;
+  if (result.good() && (peek() == ']'))
+  {
+    ++pos_;
+    done = OFTrue;
+  }
+  while (result.good() && !done)
+  {
+    values.push_back(JsonValue());
+    JsonValue &value = values.back();
+    const int c = peek();
+    if (c == '"')
+    {
+      value.type = JsonValue::JV_string;
+      result = readString(value.text);
+    }
+    else if (c == '{')
+    {
+      ++pos_;
+      result = readValueObject(value, depth + 1);
+    }
+    else
+    {
+      result = readWord(value.text);
+      if (result.good())
+      {
+        const char first = value.text[0];
+        if (value.text == "null")
+        {
+          value.type = JsonValue::JV_null;
+          value.text.clear();
+        }
+        else if (((first >= '0') && (first <= '9')) || (first == '-') || (first == '+') || (first == '.') ||
+                 (first == 'i') || (first == 'I') || (first == 'n') || (first == 'N'))
+          value.type = JsonValue::JV_number;
+        else
+          result = parseError("invalid value");
+      }
+    }
+    if (result.good())
+      result = readSeparator(']', done);
+  }
+  return result;
+}
+
+
+OFCondition DcmJsonReader::readValueObject(JsonValue &value,
+                                           const unsigned int depth)
+{
+  if (peek() == '}')
+  {
+    // an empty object is an empty sequence item or an empty person name
+    ++pos_;
+    value.type = JsonValue::JV_item;
+    value.item = new DcmItem();
+    return EC_Normal;
+  }
+  OFString key;
+  OFCondition result = readString(key);
+  if (result.good())
+  {
+    if ((key == JsonComponentGroupNames[0]) || (key == JsonComponentGroupNames[1]) || (key == JsonComponentGroupNames[2]))
+      result = readPersonName(value, key, depth);
+    else
+    {
+      value.type = JsonValue::JV_item;
+      value.item = new DcmItem();
+      result = readItemContent(*value.item, &key, depth);
+    }
+  }
+  return result;
+}
+
+
+OFCondition DcmJsonReader::readPersonName(JsonValue &value,
+                                          const OFString &firstKey,
+                                          const unsigned int depth)
+{
+  OFString groups[3];
+  OFString key = firstKey;
+  OFString text;
+  OFCondition result = EC_Normal;
+  OFBool done = OFFalse;
+  while (result.good() && !done)
+  {
+    result = expect(':');
+    if (result.good())
+    {
+      int group = 0;
+      while ((group < 3) && (key != JsonComponentGroupNames[group])) ++group;
+      if (group == 3)
+      {
+        DCMDATA_WARN("DcmJsonReader: ignoring unknown person name component group '" << key << "'");
+        result = skipValue(depth + 1);
+      }
+      else if (peek() == '"')
+        result = readString(groups[group]);
+      else
+      {
+        // null denotes an empty component group
+        result = readWord(text);
+        if (result.good() && (text != "null"))
+          result = parseError("string expected");
+      }
+    }
+    if (result.good())
+      result = readSeparator('}', done);
+    if (result.good() && !done)
+      result = readString(key);
+  }
+  if (result.good())
+  {
+    // omit trailing empty component groups
+    int count = 3;
+    while ((count > 0) && groups[count - 1].empty()) --count;
+    value.type = JsonValue::JV_personName;
+    value.text.clear();
+    for (int i = 0; i < count; ++i)
+    {
+      if (i > 0) value.text += '=';
+      value.text += groups[i];
+    }
+  }
+  return result;
+}
+
+
+OFCondition DcmJsonReader::createElement(DcmItem &item,
+                                         const DcmTagKey &tagKey,
+                                         const OFString &vr,
+                                         OFVector<JsonValue> &values,
+                                         const OFString &inlineBinary,
+                                         const OFString &bulkDataURI,
+                                         const unsigned int member)
+{
+  DcmTag tag(tagKey);
+  if (member & JSON_MEMBER_VR)
+  {
+    const DcmVR dcmVR(vr.c_str());
+    if (dcmVR.getEVR() == EVR_UNKNOWN)
+    {
+      DCMDATA_WARN("DcmJsonReader: invalid VR '" << vr << "' for element " << tag << ", using UN");
+      tag.setVR(DcmVR(EVR_UN));
+    }
+    else
+      tag.setVR(dcmVR);
+  }
+  else
+    DCMDATA_WARN("DcmJsonReader: missing VR for element " << tag << ", using VR from data dictionary");
+  DcmElement *elem = NULL;
+  OFCondition result = DcmItem::newDicomElementWithVR(elem, tag);
+  if (result.bad())
+    return result;
+  if (elem->ident() == EVR_SQ)
+  {
+    DcmSequenceOfItems *sequence = OFstatic_cast(DcmSequenceOfItems *, elem);
+    for (size_t i = 0; (i < values.size()) && result.good(); ++i)
+    {
+      if (values[i].type == JsonValue::JV_item)
+      {
+        result = sequence->insert(values[i].item);
+        if (result.good()) values[i].item = NULL;
+      }
+      else
+      {
+        DCMDATA_ERROR("DcmJsonReader: sequence " << tag << " contains a value that is not an item");
+        result = EC_JsonParseError;
+      }
+    }
+    if (member & (JSON_MEMBER_INLINEBINARY | JSON_MEMBER_BULKDATAURI))
+      DCMDATA_WARN("DcmJsonReader: ignoring binary value of sequence " << tag);
+  }
+  else if (member & JSON_MEMBER_BULKDATAURI)
+    result = readBulkData(*elem, bulkDataURI);
+  else if (member & JSON_MEMBER_INLINEBINARY)
+  {
+    unsigned char *data = NULL;
+    const size_t length = OFStandard::decodeBase64(inlineBinary, data);
+    if (length > 0)
+      result = putBinaryValue(*elem, data, length);
+    delete[] data;
+  }
+  else if (!values.empty())
+  {
+    if (elem->ident() == EVR_AT)
+    {
+      // attribute tags are given as "ggggeeee"
+      OFVector<Uint16> tags;
+      for (size_t i = 0; (i < values.size()) && result.good(); ++i)
+      {
+        Uint32 atGroup = 0;
+        Uint32 atElem = 0;
+        const OFString &text = values[i].text;
+        if ((text.length() != 8) || !parseHex(text.c_str(), 4, atGroup) || !parseHex(text.c_str() + 4, 4, atElem))
+        {
+          DCMDATA_ERROR("DcmJsonReader: invalid attribute tag value '" << text << "' in element " << tag);
+          result = EC_JsonParseError;
+        }
+        tags.push_back(OFstatic_cast(Uint16, atGroup));
+        tags.push_back(OFstatic_cast(Uint16, atElem));
+      }
+      if (result.good())
+        result = elem->putUint16Array(&tags[0], OFstatic_cast(unsigned long, tags.size() / 2));
+    }
+    else
+    {
+      // all other values are converted from their string representation
+      OFString value;
+      for (size_t i = 0; (i < values.size()) && result.good(); ++i)
+      {
+        if (i > 0) value += '\\';
+        if ((values[i].type == JsonValue::JV_item) && (values[i].item->card() > 0))
+        {
+          DCMDATA_ERROR("DcmJsonReader: element " << tag << " contains an unexpected object");
+          result = EC_JsonParseError;
+        }
+        else
+          value += values[i].text;
+      }
+      if (result.good())
+        result = elem->putOFStringArray(value);
+    }
+  }
+  if (result.good())
+    result = item.insert(elem, OFTrue /* replaceOld */);
+  if (result.bad())
+  {
+    DCMDATA_ERROR("DcmJsonReader: cannot set value of element " << tag << ": " << result.text());
+    delete elem;
+  }
+  return result;
+}
+
+
+OFCondition DcmJsonReader::readBulkData(DcmElement &element,
+                                        const OFString &uri)
+{
+  OFString path;
+  OFBool fileScheme = OFFalse;
+  if (uri.compare(0, 5, "file:") == 0)
+  {
+    fileScheme = OFTrue;
+    path = uri.substr(5);
+    if (path.compare(0, 2, "//") == 0)
+    {
+      // "file://host/path", only the local host is supported
+      const size_t slash = path.find('/', 2);
+      const OFString host = path.substr(2, (slash == OFString_npos) ? OFString_npos : slash - 2);
+      if (!host.empty() && (host != "localhost"))
+        path.clear();
+      else
+        path = (slash == OFString_npos) ? "" : path.substr(slash);
+    }
+  }
+  else if (!hasUriScheme(uri))
+    path = uri;
+  if (bulkDataDir_.empty() || path.empty())
+  {
+    DCMDATA_WARN("DcmJsonReader: cannot retrieve BulkDataURI '" << uri << "', empty element " << element.getTag() << " inserted");
+    return EC_Normal;
+  }
+  OFString filename;
+  if (!decodePercent(path, filename))
+  {
+    DCMDATA_ERROR("DcmJsonReader: invalid percent-encoding in BulkDataURI '" << uri << "'");
+    return EC_InvalidFilename;
+  }
+  // an absolute path must denote a file within the bulk data directory
+  if (fileScheme && (filename[0] == '/'))
+  {
+    // skip the slash before a drive letter, e.g. "file:///C:/dir/file"
+    if ((filename.length() > 2) && (filename[2] == ':'))
+      filename.erase(0, 1);
+    size_t length = bulkDataDir_.length();
+    while ((length > 1) && isPathSeparator(bulkDataDir_[length - 1]))
+      --length;
+    size_t i = 0;
+    while ((i < length) && (i < filename.length()) && ((filename[i] == bulkDataDir_[i]) ||
+           (isPathSeparator(filename[i]) && isPathSeparator(bulkDataDir_[i]))))
+      ++i;
+    if ((i == length) && (i < filename.length()) && isPathSeparator(filename[i]))
+      filename.erase(0, i + 1);
+  }
+  if (!isSafeRelativePath(filename))
+  {
+    DCMDATA_ERROR("DcmJsonReader: BulkDataURI '" << uri << "' does not refer to a file within the bulk data directory");
+    return EC_InvalidFilename;
+  }
+  OFFilename pathname;
+  OFStandard::combineDirAndFilename(pathname, bulkDataDir_, filename, OFTrue /*allowEmptyDirName*/);
+  return loadBulkDataFile(element, pathname);
+}
+
+
+OFCondition DcmJsonReader::loadBulkDataFile(DcmElement &element,
+                                            const OFFilename &filename)
+{
+  OFFile file;
+  if (!file.fopen(filename, "rb"))
+  {
+    DCMDATA_ERROR("DcmJsonReader: cannot open bulk data file: " << filename);
+    return EC_InvalidFilename;
+  }
+  const size_t length = OFstatic_cast(size_t, OFStandard::getFileSize(filename));
+  Uint8 *data = new Uint8[length > 0 ? length : 1];
+  OFCondition result = EC_Normal;
+  if (file.fread(data, 1, length) != length)
+  {
+    DCMDATA_ERROR("DcmJsonReader: cannot read bulk data file: " << filename);
+    result = EC_InvalidStream;
+  }
+  else
+  {
+    DCMDATA_DEBUG("DcmJsonReader: read " << length << " bytes for element " << element.getTag()
+      << " from bulk data file: " << filename);
+    result = putBinaryValue(element, data, length);
+  }
+  delete[] data;
+  return result;
+}
+
+
+OFCondition DcmJsonReader::putBinaryValue(DcmElement &element,
+                                          Uint8 *data,
+                                          const size_t length)
+{
+  DcmEVR evr = element.ident();
+  // pixel data and overlay data use the VR given in the document
+  if ((evr == EVR_PixelData) || (evr == EVR_OverlayData))
+    evr = element.getTag().getEVR();
+  size_t width = 1;
+  switch (evr)
+  {
+    case EVR_OW:
+    case EVR_US:
+    case EVR_SS:
+    case EVR_AT:
+      width = 2;
+      break;
+    case EVR_OL:
+    case EVR_UL:
+    case EVR_up:
+    case EVR_SL:
+    case EVR_OF:
+    case EVR_FL:
+      width = 4;
+      break;
+    case EVR_OV:
+    case EVR_UV:
+    case EVR_SV:
+    case EVR_OD:
+    case EVR_FD:
+      width = 8;
+      break;
+    case EVR_SQ:
+      return EC_IllegalCall;
+    case EVR_OB:
+    case EVR_UN:
+      return element.putUint8Array(data, OFstatic_cast(unsigned long, length));
+    default:
+      // all other VRs are strings
+      return element.putString(OFreinterpret_cast(const char *, data), OFstatic_cast(Uint32, length));
+  }
+  if (length % width != 0)
+    DCMDATA_WARN("DcmJsonReader: length of binary value (" << length << " bytes) of element "
+      << element.getTag() << " is not a multiple of " << width);
+  const unsigned long count = OFstatic_cast(unsigned long, length / width);
+  swapIfNecessary(gLocalByteOrder, EBO_LittleEndian, data, OFstatic_cast(Uint32, count * width), width);
+  switch (evr)
+  {
+    case EVR_SS:
+      return element.putSint16Array(OFreinterpret_cast(Sint16 *, data), count);
+    case EVR_AT:
+      // the number of values is the number of tags
+      return element.putUint16Array(OFreinterpret_cast(Uint16 *, data), count / 2);
+    case EVR_OW:
+    case EVR_US:
+      return element.putUint16Array(OFreinterpret_cast(Uint16 *, data), count);
+    case EVR_SL:
+      return element.putSint32Array(OFreinterpret_cast(Sint32 *, data), count);
+    case EVR_OF:
+    case EVR_FL:
+      return element.putFloat32Array(OFreinterpret_cast(Float32 *, data), count);
+    case EVR_OD:
+    case EVR_FD:
+      return element.putFloat64Array(OFreinterpret_cast(Float64 *, data), count);
+    case EVR_SV:
+      return OFstatic_cast(DcmSigned64bitVeryLong &, element).putSint64Array(OFreinterpret_cast(Sint64 *, data), count);
+    case EVR_OV:
+    case EVR_UV:
+      return OFstatic_cast(DcmUnsigned64bitVeryLong &, element).putUint64Array(OFreinterpret_cast(Uint64 *, data), count);
+    default:
+      return element.putUint32Array(OFreinterpret_cast(Uint32 *, data), count);
+  }
+}
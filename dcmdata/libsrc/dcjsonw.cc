@@ -0,0 +1,815 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: fast compact JSON writer for DICOM datasets
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmdata/dcjsonw.h"
+#include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmdata/dcfilefo.h"
+#include "dcmtk/dcmdata/dcmetinf.h"
+#include "dcmtk/dcmdata/dcdatset.h"
+#include "dcmtk/dcmdata/dcsequen.h"
+#include "dcmtk/dcmdata/dcvrds.h"
+#include "dcmtk/dcmdata/dcvris.h"
+#include "dcmtk/dcmdata/dcvrpn.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/ofmath.h"
+#include "dcmtk/ofstd/ofstream.h"
+
+
+/* escape character for each byte value in a JSON string, 0 if the byte is copied
+ * as is. 'u' means that the character is written as "\u00xx".
+ */
+static const char JsonEscapeTable[256] =
+{
+  'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+  'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+  0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* upper case hexadecimal digits */
+static const char JsonHexDigits[] = "0123456789ABCDEF";
+
+/* names of the component groups of a person name */
+static const char *JsonComponentGroupNames[] = { "Alphabetic", "Ideographic", "Phonetic" };
+
+/* write a string literal to the output buffer */
+#define WRITE_LITERAL(literal) write(literal, sizeof(literal) - 1)
+
+
+DcmJsonWriter::DcmJsonWriter(DcmJsonFormatCompact& format)
+: format_(format)
+, bulkDataThreshold_(0)
+, buffer_()
+, length_(0)
+, value_()
+{
+}
+
+
+DcmJsonWriter::~DcmJsonWriter()
+{
+}
+
+
+void DcmJsonWriter::setBulkDataThreshold(const Uint32 threshold)
+{
+  bulkDataThreshold_ = threshold;
+}
+
+
+void DcmJsonWriter::reserve(const size_t size)
+{
+  if (size > buffer_.size()) buffer_.resize(size);
+}
+
+
+void DcmJsonWriter::grow(const size_t size)
+{
+  size_t newSize = 2 * buffer_.size();
+  if (newSize < length_ + size) newSize = length_ + size;
+  if (newSize < 4096) newSize = 4096;
+  buffer_.resize(newSize);
+}
+
+
+void DcmJsonWriter::append(const char *text)
+{
+  if (text) write(text, strlen(text));
+}
+
+
+const char *DcmJsonWriter::getBuffer() const
+{
+  return buffer_.empty() ? "" : &buffer_[0];
+}
+
+
+size_t DcmJsonWriter::getLength() const
+{
+  return length_;
+}
+
+
+void DcmJsonWriter::clear()
+{
+  length_ = 0;
+}
+
+
+OFCondition DcmJsonWriter::writeDataset(DcmItem& item)
+{
+  return writeItemContent(item, OFTrue);
+}
+
+
+OFCondition DcmJsonWriter::writeFileFormat(DcmFileFormat& fileformat)
+{
+  DcmDataset *dset = fileformat.getDataset();
+  OFCondition status = EC_Normal;
+  if (format_.printMetaheaderInformation)
+  {
+    // print meta-header elements and dataset (non-standard)
+    DcmMetaInfo *metinf = fileformat.getMetaInfo();
+    write('{');
+    if (metinf)
+      status = writeItemContent(*metinf, OFFalse);
+    if (dset && status.good())
+    {
+      if (metinf && (metinf->card() > 0) && (dset->card() > 0)) write(',');
+      status = writeItemContent(*dset, OFFalse);
+    }
+    write('}');
+  }
+  else if (dset)
+    status = writeItemContent(*dset, OFTrue);
+  else
+    WRITE_LITERAL("{}");
+  return status;
+}
+
+
+OFCondition DcmJsonWriter::writeItemContent(DcmItem& item, const OFBool printBraces)
+{
+  OFCondition status = EC_Normal;
+  OFBool first = OFTrue;
+  DcmObject *obj = item.nextInContainer(NULL);
+  while (status.good() && (obj != NULL))
+  {
+    // group length elements are not written
+    if (obj->getTag().getElement() != 0)
+    {
+      if (first)
+      {
+        if (printBraces) write('{');
+        first = OFFalse;
+      }
+      else
+        write(',');
+      status = writeElement(*OFstatic_cast(DcmElement *, obj));
+    }
+    obj = item.nextInContainer(obj);
+  }
+  if (printBraces)
+  {
+    if (first)
+      WRITE_LITERAL("{}");
+    else
+      write('}');
+  }
+  return status;
+}
+
+
+OFCondition DcmJsonWriter::writeElement(DcmElement& elem)
+{
+  switch (elem.ident())
+  {
+    case EVR_AE:
+    case EVR_AS:
+    case EVR_CS:
+    case EVR_DA:
+    case EVR_DT:
+    case EVR_TM:
+    case EVR_UI:
+    case EVR_UR:
+    case EVR_LO:
+    case EVR_SH:
+      return writeString(elem, OFFalse);
+    case EVR_LT:
+    case EVR_ST:
+    case EVR_UC:
+    case EVR_UT:
+      return writeString(elem, OFTrue);
+    case EVR_PN:
+      return writePersonName(OFstatic_cast(DcmPersonName&, elem));
+    case EVR_IS:
+    case EVR_DS:
+      return writeNumberString(elem);
+    case EVR_US:
+    case EVR_SS:
+    case EVR_UL:
+    case EVR_SL:
+    case EVR_up:
+      return writeInteger(elem);
+    case EVR_FL:
+    case EVR_FD:
+      return writeFloat(elem);
+    case EVR_AT:
+      return writeAttributeTag(elem);
+    case EVR_SQ:
+      return writeSequence(OFstatic_cast(DcmSequenceOfItems&, elem));
+    case EVR_OB:
+    case EVR_OW:
+    case EVR_UN:
+      // pixel data (which might be encapsulated) is handled by class DcmPixelData
+      if ((elem.getTag() == DCM_PixelData) || elem.getTag().isPrivate())
+        return writeWithStream(elem);
+      return writeInlineBinary(elem);
+    case EVR_OD:
+    case EVR_OF:
+    case EVR_OL:
+    case EVR_OV:
+      return writeInlineBinary(elem);
+    default:
+      return writeWithStream(elem);
+  }
+}
+
+
+void DcmJsonWriter::writeOpener(DcmElement& elem)
+{
+  const DcmTag& tag = elem.getTag();
+  const Uint16 group = tag.getGTag();
+  const Uint16 element = tag.getETag();
+  char buf[16];
+  buf[0] = '"';
+  buf[1] = JsonHexDigits[(group >> 12) & 0x0f];
+  buf[2] = JsonHexDigits[(group >> 8) & 0x0f];
+  buf[3] = JsonHexDigits[(group >> 4) & 0x0f];
+  buf[4] = JsonHexDigits[group & 0x0f];
+  buf[5] = JsonHexDigits[(element >> 12) & 0x0f];
+  buf[6] = JsonHexDigits[(element >> 8) & 0x0f];
+  buf[7] = JsonHexDigits[(element >> 4) & 0x0f];
+  buf[8] = JsonHexDigits[element & 0x0f];
+  write(buf, 9);
+  WRITE_LITERAL("\":{\"vr\":\"");
+  const char *vrName = DcmVR(tag.getVR()).getValidVRName();
+  write(vrName, strlen(vrName));
+  write('"');
+}
+
+
+OFBool DcmJsonWriter::writeBulkDataURI(DcmElement& elem)
+{
+  if ((bulkDataThreshold_ > 0) && (elem.getLength() <= bulkDataThreshold_))
+    return OFFalse;
+  if (!format_.asBulkDataURI(elem.getTag(), value_))
+    return OFFalse;
+  WRITE_LITERAL(",\"BulkDataURI\":\"");
+  writeEscaped(value_.c_str(), value_.length());
+  write('"');
+  return OFTrue;
+}
+
+
+void DcmJsonWriter::writeValueString(const OFString& value)
+{
+  if (value.empty())
+    WRITE_LITERAL("null");
+  else
+  {
+    write('"');
+    writeEscaped(value.c_str(), value.length());
+    write('"');
+  }
+}
+
+
+void DcmJsonWriter::writeEscaped(const char *str, size_t length)
+{
+  // the worst case is that each character is written as "\u00xx"
+  makeRoom(6 * length);
+  char *out = &buffer_[length_];
+  const unsigned char *in = OFreinterpret_cast(const unsigned char *, str);
+  const unsigned char *end = in + length;
+  while (in < end)
+  {
+    // copy the run of characters that do not need escaping
+    const unsigned char *run = in;
+    while ((in < end) && (JsonEscapeTable[*in] == 0)) ++in;
+    if (in > run)
+    {
+      memcpy(out, run, in - run);
+      out += in - run;
+    }
+    if (in < end)
+    {
+      const char esc = JsonEscapeTable[*in];
+      *out++ = '\\';
+      *out++ = esc;
+      if (esc == 'u')
+      {
+        *out++ = '0';
+        *out++ = '0';
+        *out++ = JsonHexDigits[*in >> 4];
+        *out++ = OFstatic_cast(char, (*in & 0x0f) < 10 ? '0' + (*in & 0x0f) : 'a' + (*in & 0x0f) - 10);
+      }
+      ++in;
+    }
+  }
+  length_ = out - &buffer_[0];
+}
+
+
+void DcmJsonWriter::writeNumber(const char *str, size_t length, const OFBool decimal)
+{
+  if (length == 0)
+  {
+    WRITE_LITERAL("null");
+    return;
+  }
+  // this is the same normalization as in DcmJsonFormat::normalizeDecimalString()
+  // and DcmJsonFormat::normalizeIntegerString(), but without temporary strings
+  makeRoom(length + 3);
+  char *out = &buffer_[length_];
+  const char *end = str + length;
+  // skip all plus characters
+  while ((str < end) && (*str == '+')) ++str;
+  if ((str < end) && (*str == '-'))
+  {
+    *out++ = '-';
+    ++str;
+  }
+  // skip leading zeroes and plus characters
+  while ((str < end) && ((*str == '0') || (*str == '+'))) ++str;
+  if (str == end)
+    *out++ = '0';
+  else if (decimal && (*str == '.'))
+    *out++ = '0';
+  OFBool period = OFFalse;
+  while (str < end)
+  {
+    const char c = *str++;
+    if (c == '+') continue;
+    *out++ = c;
+    if (decimal && (c == '.') && !period)
+    {
+      period = OFTrue;
+      // make sure that the period is followed by a digit
+      while ((str < end) && (*str == '+')) ++str;
+      if ((str == end) || (*str < '0') || (*str > '9'))
+        *out++ = '0';
+    }
+  }
+  length_ = out - &buffer_[0];
+}
+
+
+void DcmJsonWriter::writeUnsigned(unsigned long value, const OFBool negative)
+{
+  char buf[24];
+  char *p = buf + sizeof(buf);
+  do
+  {
+    *--p = OFstatic_cast(char, '0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  if (negative) *--p = '-';
+  write(p, buf + sizeof(buf) - p);
+}
+
+
+OFCondition DcmJsonWriter::writeString(DcmElement& elem, const OFBool bulkData)
+{
+  writeOpener(elem);
+  if (!elem.isEmpty() && !(bulkData && writeBulkDataURI(elem)))
+  {
+    OFCondition status = elem.getOFString(value_, 0);
+    if (status.bad())
+      return status;
+    WRITE_LITERAL(",\"Value\":[");
+    writeValueString(value_);
+    const unsigned long vm = elem.getVM();
+    for (unsigned long valNo = 1; valNo < vm; ++valNo)
+    {
+      status = elem.getOFString(value_, valNo);
+      if (status.bad())
+        return status;
+      write(',');
+      writeValueString(value_);
+    }
+    write(']');
+  }
+  write('}');
+  return EC_Normal;
+}
+
+
+OFCondition DcmJsonWriter::writeNumberString(DcmElement& elem)
+{
+  const OFBool decimal = (elem.ident() == EVR_DS);
+  writeOpener(elem);
+  if (!elem.isEmpty() && !writeBulkDataURI(elem))
+  {
+    const unsigned long vm = elem.getVM();
+    if (vm > 0)
+    {
+      const DcmJsonFormat::NumStringPolicy policy = format_.getJsonNumStringPolicy();
+      WRITE_LITERAL(",\"Value\":[");
+      for (unsigned long valNo = 0; valNo < vm; ++valNo)
+      {
+        OFCondition status = elem.getOFString(value_, valNo);
+        if (status.bad())
+          return status;
+        if (valNo > 0) write(',');
+        OFBool asNumber = OFFalse;
+        if (policy != DcmJsonFormat::NSP_always_string)
+        {
+          const OFBool isValid = decimal ? DcmDecimalString::checkStringValue(value_, "1").good()
+                                         : DcmIntegerString::checkStringValue(value_, "1").good();
+          if (isValid)
+            asNumber = OFTrue;
+          else if (policy == DcmJsonFormat::NSP_always_number)
+            return EC_CannotWriteStringAsJsonNumber;
+        }
+        if (asNumber)
+          writeNumber(value_.c_str(), value_.length(), decimal);
+        else
+          writeValueString(value_);
+      }
+      write(']');
+    }
+  }
+  write('}');
+  return EC_Normal;
+}
+
+
+OFCondition DcmJsonWriter::writeInteger(DcmElement& elem)
+{
+  writeOpener(elem);
+  if (!elem.isEmpty() && !writeBulkDataURI(elem))
+  {
+    const DcmEVR evr = elem.ident();
+    const unsigned long vm = elem.getVM();
+    OFCondition status = EC_Normal;
+    WRITE_LITERAL(",\"Value\":[");
+    // the first value is always retrieved in order to report an error for an invalid value
+    for (unsigned long valNo = 0; (valNo == 0) || (valNo < vm); ++valNo)
+    {
+      if (valNo > 0) write(',');
+      if (evr == EVR_US)
+      {
+        Uint16 v = 0;
+        status = elem.getUint16(v, valNo);
+        if (status.good()) writeUnsigned(v);
+      }
+      else if (evr == EVR_SS)
+      {
+        Sint16 v = 0;
+        status = elem.getSint16(v, valNo);
+        if (status.good()) writeUnsigned(v < 0 ? 0UL - OFstatic_cast(unsigned long, v) : OFstatic_cast(unsigned long, v), v < 0);
+      }
+      else if (evr == EVR_SL)
+      {
+        Sint32 v = 0;
+        status = elem.getSint32(v, valNo);
+        if (status.good()) writeUnsigned(v < 0 ? 0UL - OFstatic_cast(unsigned long, v) : OFstatic_cast(unsigned long, v), v < 0);
+      }
+      else
+      {
+        Uint32 v = 0;
+        status = elem.getUint32(v, valNo);
+        if (status.good()) writeUnsigned(v);
+      }
+      if (status.bad())
+        return status;
+    }
+    write(']');
+  }
+  write('}');
+  return EC_Normal;
+}
+
+
+OFCondition DcmJsonWriter::writeFloat(DcmElement& elem)
+{
+  const OFBool single = (elem.ident() == EVR_FL);
+  writeOpener(elem);
+  if (!elem.isEmpty())
+  {
+    const unsigned long vm = elem.getVM();
+    OFCondition status;
+    Float64 f = 0.0;
+    if (!format_.getJsonExtensionEnabled())
+    {
+      // infinity and not-a-number cannot be written without the JSON extension
+      for (unsigned long valNo = 0; valNo < vm; ++valNo)
+      {
+        if (single)
+        {
+          Float32 f32 = 0.0;
+          status = elem.getFloat32(f32, valNo);
+          f = f32;
+        }
+        else
+          status = elem.getFloat64(f, valNo);
+        if (status.bad()) return status;
+        if ((OFMath::isinf)(f) || (OFMath::isnan)(f)) return EC_CannotWriteJsonNumber;
+      }
+    }
+    if (!writeBulkDataURI(elem))
+    {
+      char buf[64];
+      WRITE_LITERAL(",\"Value\":[");
+      for (unsigned long valNo = 0; (valNo == 0) || (valNo < vm); ++valNo)
+      {
+        if (valNo > 0) write(',');
+        // same conversion as in getOFString()
+        if (single)
+        {
+          Float32 f32 = 0.0;
+          status = elem.getFloat32(f32, valNo);
+          if (status.bad()) return status;
+          OFStandard::ftoa(buf, sizeof(buf), f32, 0, 0, 9 /* FLT_DECIMAL_DIG for DICOM FL */);
+        }
+        else
+        {
+          status = elem.getFloat64(f, valNo);
+          if (status.bad()) return status;
+          OFStandard::ftoa(buf, sizeof(buf), f, 0, 0, 17 /* DBL_DECIMAL_DIG for DICOM FD */);
+        }
+        writeNumber(buf, strlen(buf), OFTrue);
+      }
+      write(']');
+    }
+  }
+  write('}');
+  return EC_Normal;
+}
+
+
+OFCondition DcmJsonWriter::writeAttributeTag(DcmElement& elem)
+{
+  writeOpener(elem);
+  if (!elem.isEmpty())
+  {
+    Uint16 *values = NULL;
+    elem.getUint16Array(values);
+    const unsigned long vm = elem.getVM();
+    if ((values != NULL) && (vm > 0))
+    {
+      char buf[12];
+      buf[0] = '"';
+      buf[9] = '"';
+      WRITE_LITERAL(",\"Value\":[");
+      for (unsigned long valNo = 0; valNo < vm; ++valNo)
+      {
+        if (valNo > 0) write(',');
+        for (int i = 0; i < 2; ++i)
+        {
+          const Uint16 v = *values++;
+          buf[1 + 4 * i] = JsonHexDigits[(v >> 12) & 0x0f];
+          buf[2 + 4 * i] = JsonHexDigits[(v >> 8) & 0x0f];
+          buf[3 + 4 * i] = JsonHexDigits[(v >> 4) & 0x0f];
+          buf[4 + 4 * i] = JsonHexDigits[v & 0x0f];
+        }
+        write(buf, 10);
+      }
+      write(']');
+    }
+  }
+  write('}');
+  return EC_Normal;
+}
+
+
+OFCondition DcmJsonWriter::writeSequence(DcmSequenceOfItems& elem)
+{
+  writeOpener(elem);
+  OFCondition status = EC_Normal;
+  DcmObject *item = elem.nextInContainer(NULL);
+  if (item != NULL)
+  {
+    WRITE_LITERAL(",\"Value\":[");
+    status = writeItemContent(*OFstatic_cast(DcmItem *, item), OFTrue);
+    while (status.good() && ((item = elem.nextInContainer(item)) != NULL))
+    {
+      write(',');
+      status = writeItemContent(*OFstatic_cast(DcmItem *, item), OFTrue);
+    }
+    write(']');
+  }
+  write('}');
+  return status;
+}
+
+
+OFCondition DcmJsonWriter::writeInlineBinary(DcmElement& elem)
+{
+  writeOpener(elem);
+  const Uint32 length = elem.getLengthField();
+  if ((length > 0) && !writeBulkDataURI(elem))
+  {
+    WRITE_LITERAL(",\"InlineBinary\":\"");
+    /* adjust byte order to little endian */
+    const unsigned char *data = OFstatic_cast(const unsigned char *, elem.getValue(EBO_LittleEndian));
+    OFStandard::encodeBase64(data, OFstatic_cast(size_t, length), value_);
+    write(value_.c_str(), value_.length());
+    write('"');
+  }
+  write('}');
+  return EC_Normal;
+}
+
+
+OFCondition DcmJsonWriter::writeWithStream(DcmElement& elem)
+{
+  OFOStringStream stream;
+  OFCondition status = elem.writeJson(stream, format_);
+  stream << OFStringStream_ends;
+  OFSTRINGSTREAM_GETSTR(stream, result)
+  append(result);
+  OFSTRINGSTREAM_FREESTR(result)
+  return status;
+}
+
+
+/* helper class that writes a person name value in the same way as
+ * DcmPersonName::writeJson(), see there for details
+ */
+class DcmJsonPersonNameLexer
+{
+public:
+
+  DcmJsonPersonNameLexer(const char *begin, const char *end)
+  : it(begin)
+  , end_(end)
+  , componentGroup(0)
+  , currentComponent(0)
+  , hasTrailingNull(OFFalse)
+  {
+  }
+
+  void handleValue()
+  {
+    currentComponent = 0;
+    componentGroup = 0;
+    hasTrailingNull = OFTrue;
+  }
+
+  void handleComponentGroup()
+  {
+    if (componentGroup != 2)
+    {
+      currentComponent = 0;
+      ++componentGroup;
+    }
+    else
+    {
+      DCMDATA_ERROR("DcmPersonName::writeJson(): omitting invalid "
+          "component group (more than three component groups present)");
+      while (++it != end_ && *it != '\\' && *it != '=');
+      --it;
+    }
+  }
+
+  OFBool nextValue()
+  {
+    for (; it != end_; ++it) switch (*it)
+    {
+      case '\\':
+        handleValue();
+        return OFTrue;
+      case '=':
+        handleComponentGroup();
+        break;
+      case '^':
+        ++currentComponent;
+        break;
+      case ' ':
+        break;
+      default:
+        return OFTrue;
+    }
+    return hasTrailingNull;
+  }
+
+  OFBool nextComponentGroup()
+  {
+    for (; it != end_; ++it) switch (*it)
+    {
+      case '\\':
+        ++it;
+        handleValue();
+        return OFFalse;
+      case '=':
+        handleComponentGroup();
+        break;
+      case '^':
+        ++currentComponent;
+        break;
+      case ' ':
+        break;
+      default:
+        return OFTrue;
+    }
+    return OFFalse;
+  }
+
+  OFBool nextComponent()
+  {
+    for (; it != end_; ++it) switch (*it)
+    {
+      case '\\':
+      case '=':
+        return OFFalse;
+      case '^':
+        ++currentComponent;
+        break;
+      case ' ':
+        break;
+      default:
+        return OFTrue;
+    }
+    return OFFalse;
+  }
+
+  /// current position within the value
+  const char *it;
+
+  /// end of the value
+  const char *end_;
+
+  /// index of the current component group
+  unsigned componentGroup;
+
+  /// number of empty components since the last non-empty one
+  unsigned currentComponent;
+
+  /// true if the last value is empty and a trailing null must be written
+  OFBool hasTrailingNull;
+};
+
+
+OFCondition DcmJsonWriter::writePersonName(DcmPersonName& elem)
+{
+  char *begin = NULL;
+  OFCondition status = elem.getString(begin);
+  if (status.bad())
+    return status;
+  DcmJsonPersonNameLexer lexer(begin, begin + elem.getLength());
+  writeOpener(elem);
+  OFBool first = OFTrue;
+  while (lexer.nextValue())
+  {
+    write(first ? ",\"Value\":[" : ",", first ? 10 : 1);
+    first = OFFalse;
+    // write the current value
+    lexer.hasTrailingNull = OFFalse;
+    if (lexer.nextComponentGroup())
+    {
+      write('{');
+      OFBool firstGroup = OFTrue;
+      do
+      {
+        if (!firstGroup) write(',');
+        firstGroup = OFFalse;
+        // write component group name and all non-empty components
+        const char *name = JsonComponentGroupNames[lexer.componentGroup];
+        write('"');
+        write(name, strlen(name));
+        WRITE_LITERAL("\":\"");
+        do
+        {
+          for (; lexer.currentComponent; --lexer.currentComponent) write('^');
+          const char *component = lexer.it;
+          while (++lexer.it != lexer.end_ && *lexer.it != '\\' && *lexer.it != '=' && *lexer.it != '^');
+          const char *componentEnd = lexer.it - 1;
+          while (*componentEnd == ' ') --componentEnd;
+          writeEscaped(component, componentEnd - component + 1);
+        } while (lexer.nextComponent());
+        write('"');
+      } while (lexer.nextComponentGroup());
+      write('}');
+    }
+    else
+      WRITE_LITERAL("null");
+  }
+  if (!first) write(']');
+  write('}');
+  return EC_Normal;
+}
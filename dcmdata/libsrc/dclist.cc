@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2019, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -23,6 +23,7 @@
 
 #include "dcmtk/ofstd/ofstream.h"
 #include "dcmtk/dcmdata/dclist.h"
+#include "dcmtk/dcmdata/dcarena.h"
 
 
 // *****************************************
@@ -46,6 +47,57 @@ DcmListNode::~DcmListNode()
 }
 
 
+// ********************************
+
+
+void *DcmListNode::operator new(size_t size)
+{
+    return ::operator new(size);
+}
+
+
+void *DcmListNode::operator new(size_t size, const std::nothrow_t& nt) OFnoexcept
+{
+    return ::operator new(size, nt);
+}
+
+
+void *DcmListNode::operator new(size_t size, void *ptr) OFnoexcept
+{
+    return ::operator new(size, ptr);
+}
+
+
+void *DcmListNode::operator new(size_t size, DcmMemoryArena *arena)
+{
+    return DcmMemoryArena::allocate(size, arena);
+}
+
+
+void DcmListNode::operator delete(void *ptr)
+{
+    DcmMemoryArena::deallocate(ptr);
+}
+
+
+void DcmListNode::operator delete(void *ptr, const std::nothrow_t& nt) OFnoexcept
+{
+    ::operator delete(ptr, nt);
+}
+
+
+void DcmListNode::operator delete(void *ptr, void *place) OFnoexcept
+{
+    ::operator delete(ptr, place);
+}
+
+
+void DcmListNode::operator delete(void *ptr, DcmMemoryArena * /* arena */)
+{
+    DcmMemoryArena::deallocate(ptr);
+}
+
+
 // *****************************************
 // *** DcmList *****************************
 // *****************************************
@@ -55,7 +107,9 @@ DcmList::DcmList()
   : firstNode(NULL),
     lastNode(NULL),
     currentNode(NULL),
-    cardinality(0)
+    cardinality(0),
+    modCounter(0),
+    memoryArena(NULL)
 {
 }
 
@@ -76,6 +130,24 @@ DcmList::~DcmList()
         } while ( firstNode != NULL );
         currentNode = firstNode = lastNode = NULL;
     }
+    if ( memoryArena != NULL )
+        memoryArena->release();
+}
+
+
+// ********************************
+
+
+void DcmList::setMemoryArena( DcmMemoryArena *arena )
+{
+    if ( arena != memoryArena )
+    {
+        if ( arena != NULL )
+            arena->addReference();
+        if ( memoryArena != NULL )
+            memoryArena->release();
+        memoryArena = arena;
+    }
 }
 
 
@@ -87,15 +159,16 @@ DcmObject *DcmList::append( DcmObject *obj )
     if ( obj != NULL )
     {
         if ( DcmList::empty() )                        // list is empty !
-            currentNode = firstNode = lastNode = new DcmListNode(obj);
+            currentNode = firstNode = lastNode = new (memoryArena) DcmListNode(obj);
         else
         {
-            DcmListNode *node = new DcmListNode(obj);
+            DcmListNode *node = new (memoryArena) DcmListNode(obj);
             lastNode->nextNode = node;
             node->prevNode = lastNode;
             currentNode = lastNode = node;
         }
         cardinality++;
+        modCounter++;
     } // obj == NULL
     return obj;
 }
@@ -109,15 +182,16 @@ DcmObject *DcmList::prepend( DcmObject *obj )
     if ( obj != NULL )
     {
         if ( DcmList::empty() )                        // list is empty !
-            currentNode = firstNode = lastNode = new DcmListNode(obj);
+            currentNode = firstNode = lastNode = new (memoryArena) DcmListNode(obj);
         else
         {
-            DcmListNode *node = new DcmListNode(obj);
+            DcmListNode *node = new (memoryArena) DcmListNode(obj);
             node->nextNode = firstNode;
             firstNode->prevNode = node;
             currentNode = firstNode = node;
         }
         cardinality++;
+        modCounter++;
     } // obj == NULL
     return obj;
 }
@@ -132,8 +206,9 @@ DcmObject *DcmList::insert( DcmObject *obj, E_ListPos pos )
     {
         if ( DcmList::empty() )                 // list is empty !
         {
-            currentNode = firstNode = lastNode = new DcmListNode(obj);
+            currentNode = firstNode = lastNode = new (memoryArena) DcmListNode(obj);
             cardinality++;
+            modCounter++;
         }
         else {
             if ( pos==ELP_last )
@@ -146,7 +221,7 @@ DcmObject *DcmList::insert( DcmObject *obj, E_ListPos pos )
                 DcmList::append( obj );         // cardinality++;
             else if ( pos == ELP_prev )         // insert before current node
             {
-                DcmListNode *node = new DcmListNode(obj);
+                DcmListNode *node = new (memoryArena) DcmListNode(obj);
                 if ( currentNode->prevNode == NULL )
                     firstNode = node;           // insert at the beginning
                 else
@@ -156,11 +231,12 @@ DcmObject *DcmList::insert( DcmObject *obj, E_ListPos pos )
                 currentNode->prevNode = node;
                 currentNode = node;
                 cardinality++;
+                modCounter++;
             }
             else //( pos==ELP_next || pos==ELP_atpos )
                                                 // insert after current node
             {
-                DcmListNode *node = new DcmListNode(obj);
+                DcmListNode *node = new (memoryArena) DcmListNode(obj);
                 if ( currentNode->nextNode == NULL )
                     lastNode = node;            // append to the end
                 else
@@ -170,6 +246,7 @@ DcmObject *DcmList::insert( DcmObject *obj, E_ListPos pos )
                 currentNode->nextNode = node;
                 currentNode = node;
                 cardinality++;
+                modCounter++;
             }
         }
     } // obj == NULL
@@ -207,6 +284,7 @@ DcmObject *DcmList::remove()
         tempobj = tempnode->value();
         delete tempnode;
         cardinality--;
+        modCounter++;
         return tempobj;
     }
 }
@@ -305,4 +383,5 @@ void DcmList::deleteAllElements()
     lastNode = NULL;
     currentNode = NULL;
     cardinality = 0;
+    modCounter++;
 }
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2017-2022, OFFIS e.V.
+ *  Copyright (C) 2017-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -383,3 +383,322 @@ OFBool DcmAttributeMatching::operator()( const void* queryData, const size_t que
     assert( m_pMatch );
     return m_pMatch( queryData, querySize, candidateData, candidateSize );
 }
+
+// comparison function for sorting the UIDs of a compiled List of UID query,
+// orders by size first, since that is cheaper to compare
+static OFBool lessUID( const char* lhs, const size_t lhsSize, const char* rhs, const size_t rhsSize )
+{
+    if( lhsSize != rhsSize )
+        return lhsSize < rhsSize;
+    return memcmp( lhs, rhs, lhsSize ) < 0;
+}
+
+DcmAttributeMatching::CompiledQuery::CompiledQuery()
+: m_eType( T_Empty )
+, m_Query()
+, m_Segments()
+, m_bOpenBeginning( OFFalse )
+, m_bOpenEnd( OFFalse )
+, m_MinSize( 0 )
+, m_bIsRange( OFFalse )
+, m_bNoLowerBound( OFFalse )
+, m_bNoUpperBound( OFFalse )
+, m_FirstDate()
+, m_SecondDate()
+, m_FirstTime()
+, m_SecondTime()
+, m_FirstDateTime()
+, m_SecondDateTime()
+{
+
+}
+
+DcmAttributeMatching::CompiledQuery::CompiledQuery( const DcmVR vr, const void* queryData, const size_t querySize )
+: m_eType( T_Universal )
+, m_Query( OFreinterpret_cast( const char*, queryData ), querySize )
+, m_Segments()
+, m_bOpenBeginning( OFFalse )
+, m_bOpenEnd( OFFalse )
+, m_MinSize( 0 )
+, m_bIsRange( OFFalse )
+, m_bNoLowerBound( OFFalse )
+, m_bNoUpperBound( OFFalse )
+, m_FirstDate()
+, m_SecondDate()
+, m_FirstTime()
+, m_SecondTime()
+, m_FirstDateTime()
+, m_SecondDateTime()
+{
+    // an empty query always results in Universal Matching
+    if( !querySize )
+        return;
+    // choose the same kind of matching as DcmAttributeMatching( vr ) does
+    switch( vr.getEVR() )
+    {
+    default:
+        m_eType = T_SingleValue;
+        break;
+
+    case EVR_AE:
+    case EVR_CS:
+    case EVR_LO:
+    case EVR_LT:
+    case EVR_PN:
+    case EVR_SH:
+    case EVR_ST:
+    case EVR_UC:
+    case EVR_UR:
+    case EVR_UT:
+        compileWildCard();
+        break;
+
+    case EVR_DA:
+        m_eType = T_Date;
+        compileRange( &DcmDate::getOFDateFromString, m_FirstDate, m_SecondDate );
+        break;
+
+    case EVR_TM:
+        m_eType = T_Time;
+        compileRange( &DcmTime::getOFTimeFromString, m_FirstTime, m_SecondTime );
+        break;
+
+    case EVR_DT:
+        m_eType = T_DateTime;
+        compileRange( &DcmDateTime::getOFDateTimeFromString, m_FirstDateTime, m_SecondDateTime );
+        break;
+
+    case EVR_UI:
+        compileUIDList();
+        break;
+    }
+}
+
+void DcmAttributeMatching::CompiledQuery::compileWildCard()
+{
+    const char* const query = m_Query.c_str();
+    const size_t size = m_Query.size();
+    // queries without any wild card characters are matched as single values
+    if( !memchr( query, '*', size ) && !memchr( query, '?', size ) )
+    {
+        m_eType = T_SingleValue;
+        return;
+    }
+    m_eType = T_WildCard;
+    m_bOpenBeginning = query[0] == '*';
+    m_bOpenEnd = query[size - 1] == '*';
+    // split the query into the (non-empty) segments between '*' wild cards,
+    // multiple consecutive '*' characters are equivalent to a single one
+    size_t pos = 0;
+    while( pos < size )
+    {
+        if( query[pos] == '*' )
+        {
+            ++pos;
+            continue;
+        }
+        Segment segment;
+        segment.offset = pos;
+        segment.hasWildCard = OFFalse;
+        while( pos < size && query[pos] != '*' )
+        {
+            if( query[pos] == '?' )
+                segment.hasWildCard = OFTrue;
+            ++pos;
+        }
+        segment.size = pos - segment.offset;
+        m_MinSize += segment.size;
+        m_Segments.push_back( segment );
+    }
+}
+
+void DcmAttributeMatching::CompiledQuery::compileUIDList()
+{
+    m_eType = T_UIDList;
+    const char* const query = m_Query.c_str();
+    const size_t size = m_Query.size();
+    // split the query into the individual UIDs
+    size_t pos = 0;
+    for( ;; )
+    {
+        Segment segment;
+        segment.offset = pos;
+        segment.hasWildCard = OFFalse;
+        while( pos < size && query[pos] != '\\' )
+            ++pos;
+        segment.size = pos - segment.offset;
+        m_Segments.push_back( segment );
+        if( pos++ == size )
+            break;
+    }
+    // sort the UIDs for binary search (insertion sort is sufficient, since
+    // the number of UIDs in a query is usually small)
+    for( size_t i = 1; i < m_Segments.size(); ++i )
+    {
+        const Segment segment = m_Segments[i];
+        size_t j = i;
+        while( j > 0 && lessUID( query + segment.offset, segment.size, query + m_Segments[j - 1].offset, m_Segments[j - 1].size ) )
+        {
+            m_Segments[j] = m_Segments[j - 1];
+            --j;
+        }
+        m_Segments[j] = segment;
+    }
+}
+
+template<typename T>
+void DcmAttributeMatching::CompiledQuery::compileRange( OFCondition (*parse)(const char*,const size_t,T&), T& first, T& second )
+{
+    const Range query( m_Query.c_str(), m_Query.size() );
+    m_bIsRange = query.isRange();
+    m_bNoLowerBound = query.hasOpenBeginning();
+    m_bNoUpperBound = query.hasOpenEnd();
+    // an invalid query value never matches
+    if( !m_bNoLowerBound && parse( query.first, query.firstSize, first ).bad() )
+        m_eType = T_None;
+    else if( m_bIsRange && !m_bNoUpperBound && parse( query.second, query.secondSize, second ).bad() )
+        m_eType = T_None;
+}
+
+template<typename T>
+OFBool DcmAttributeMatching::CompiledQuery::matchRange( OFCondition (*parse)(const char*,const size_t,T&),
+                                                        const T& first, const T& second,
+                                                        const char* candidateData, const size_t candidateSize ) const
+{
+    T candidate;
+    if( parse( candidateData, candidateSize, candidate ).bad() )
+        return OFFalse;
+    if( !m_bIsRange )
+        return first == candidate;
+    return ( m_bNoLowerBound || first <= candidate )
+        && ( m_bNoUpperBound || second >= candidate );
+}
+
+OFBool DcmAttributeMatching::CompiledQuery::matchSegment( const Segment& segment, const char* candidateData ) const
+{
+    const char* query = m_Query.c_str() + segment.offset;
+    if( !segment.hasWildCard )
+        return !memcmp( query, candidateData, segment.size );
+    for( const char* const queryEnd = query + segment.size; query != queryEnd; ++query, ++candidateData )
+        if( *query != '?' && *query != *candidateData )
+            return OFFalse;
+    return OFTrue;
+}
+
+const char* DcmAttributeMatching::CompiledQuery::findSegment( const Segment& segment, const char* begin, const char* end ) const
+{
+    // the last position at which the segment may start
+    const char* const last = end - segment.size;
+    const char first = m_Query[segment.offset];
+    while( begin <= last )
+    {
+        // quickly skip to the next candidate position for segments starting with a literal
+        if( first != '?' )
+        {
+            begin = OFreinterpret_cast( const char*, memchr( begin, first, last - begin + 1 ) );
+            if( !begin )
+                return OFnullptr;
+        }
+        if( matchSegment( segment, begin ) )
+            return begin;
+        ++begin;
+    }
+    return OFnullptr;
+}
+
+OFBool DcmAttributeMatching::CompiledQuery::matchWildCard( const char* candidateData, const size_t candidateSize ) const
+{
+    if( candidateSize < m_MinSize )
+        return OFFalse;
+    const char* begin = candidateData;
+    const char* end = candidateData + candidateSize;
+    OFVector<Segment>::const_iterator first = m_Segments.begin();
+    OFVector<Segment>::const_iterator last = m_Segments.end();
+    // without any '*' wild card, the candidate must have exactly the size of the query
+    if( !m_bOpenBeginning && !m_bOpenEnd && m_Segments.size() == 1 )
+        return candidateSize == m_MinSize && matchSegment( *first, begin );
+    // the first segment must match the beginning of the candidate
+    if( !m_bOpenBeginning )
+    {
+        if( !matchSegment( *first, begin ) )
+            return OFFalse;
+        begin += first->size;
+        ++first;
+    }
+    // the last segment must match the end of the candidate
+    if( !m_bOpenEnd )
+    {
+        --last;
+        if( !matchSegment( *last, end - last->size ) )
+            return OFFalse;
+        end -= last->size;
+    }
+    // all other segments are searched from left to right, each one after the
+    // previous one, which always finds a match if there is any
+    for( ; first != last; ++first )
+    {
+        begin = findSegment( *first, begin, end );
+        if( !begin )
+            return OFFalse;
+        begin += first->size;
+    }
+    return OFTrue;
+}
+
+OFBool DcmAttributeMatching::CompiledQuery::matchUIDList( const char* candidateData, const size_t candidateSize ) const
+{
+    // binary search for the candidate within the sorted list of UIDs
+    const char* const query = m_Query.c_str();
+    size_t lower = 0;
+    size_t upper = m_Segments.size();
+    while( lower < upper )
+    {
+        const size_t middle = lower + ( upper - lower ) / 2;
+        const Segment& segment = m_Segments[middle];
+        int result = ( segment.size < candidateSize ) ? -1 : ( segment.size > candidateSize ) ? 1 : 0;
+        if( !result )
+            result = memcmp( query + segment.offset, candidateData, candidateSize );
+        if( !result )
+            return OFTrue;
+        if( result < 0 )
+            lower = middle + 1;
+        else
+            upper = middle;
+    }
+    return OFFalse;
+}
+
+DcmAttributeMatching::CompiledQuery::operator OFBool() const
+{
+    return m_eType != T_Empty;
+}
+
+OFBool DcmAttributeMatching::CompiledQuery::operator!() const
+{
+    return m_eType == T_Empty;
+}
+
+OFBool DcmAttributeMatching::CompiledQuery::operator()( const void* candidateData, const size_t candidateSize ) const
+{
+    assert( m_eType != T_Empty );
+    const char* const candidate = OFreinterpret_cast( const char*, candidateData );
+    switch( m_eType )
+    {
+    case T_Universal:
+        return OFTrue;
+    case T_SingleValue:
+        return candidateSize == m_Query.size() && !memcmp( m_Query.c_str(), candidate, candidateSize );
+    case T_WildCard:
+        return matchWildCard( candidate, candidateSize );
+    case T_Date:
+        return matchRange( &DcmDate::getOFDateFromString, m_FirstDate, m_SecondDate, candidate, candidateSize );
+    case T_Time:
+        return matchRange( &DcmTime::getOFTimeFromString, m_FirstTime, m_SecondTime, candidate, candidateSize );
+    case T_DateTime:
+        return matchRange( &DcmDateTime::getOFDateTimeFromString, m_FirstDateTime, m_SecondDateTime, candidate, candidateSize );
+    case T_UIDList:
+        return matchUIDList( candidate, candidateSize );
+    default:
+        return OFFalse;
+    }
+}
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2021, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -28,6 +28,7 @@
 #include "dcmtk/ofstd/ofstream.h"
 #include "dcmtk/dcmdata/dcjson.h"
 #include "dcmtk/dcmdata/dcobject.h"
+#include "dcmtk/dcmdata/dcarena.h"
 #include "dcmtk/dcmdata/dcdeftag.h"
 #include "dcmtk/dcmdata/dcvr.h"
 #include "dcmtk/dcmdata/dcxfer.h"
@@ -54,6 +55,9 @@ OFGlobal<OFBool>    dcmReplaceWrongDelimitationItem(OFFalse);
 OFGlobal<OFBool>    dcmConvertUndefinedLengthOBOWtoSQ(OFFalse);
 OFGlobal<OFBool>    dcmConvertVOILUTSequenceOWtoSQ(OFFalse);
 OFGlobal<OFBool>    dcmUseExplLengthPixDataForEncTS(OFFalse);
+OFGlobal<OFBool>    dcmUseMemoryMappedFileInput(OFFalse);
+OFGlobal<OFBool>    dcmUseSharedFileHandleInput(OFFalse);
+OFGlobal<Uint32>    dcmElementIndexThreshold(64);
 
 // ****** public methods **********************************
 
@@ -86,6 +90,54 @@ DcmObject::~DcmObject()
 }
 
 
+void *DcmObject::operator new(size_t size)
+{
+    return ::operator new(size);
+}
+
+
+void *DcmObject::operator new(size_t size, const std::nothrow_t& nt) OFnoexcept
+{
+    return ::operator new(size, nt);
+}
+
+
+void *DcmObject::operator new(size_t size, void *ptr) OFnoexcept
+{
+    return ::operator new(size, ptr);
+}
+
+
+void *DcmObject::operator new(size_t size, DcmMemoryArena *arena)
+{
+    return DcmMemoryArena::allocate(size, arena);
+}
+
+
+void DcmObject::operator delete(void *ptr)
+{
+    DcmMemoryArena::deallocate(ptr);
+}
+
+
+void DcmObject::operator delete(void *ptr, const std::nothrow_t& nt) OFnoexcept
+{
+    ::operator delete(ptr, nt);
+}
+
+
+void DcmObject::operator delete(void *ptr, void *place) OFnoexcept
+{
+    ::operator delete(ptr, place);
+}
+
+
+void DcmObject::operator delete(void *ptr, DcmMemoryArena * /* arena */)
+{
+    DcmMemoryArena::deallocate(ptr);
+}
+
+
 DcmObject &DcmObject::operator=(const DcmObject &obj)
 {
     if (this != &obj)
@@ -178,6 +230,15 @@ DcmItem *DcmObject::getRootItem()
 }
 
 
+DcmMemoryArena *DcmObject::getMemoryArena() const
+{
+    return (Parent != NULL) ? Parent->getMemoryArena() : NULL;
+}
+
+
+// ********************************
+
+
 DcmItem *DcmObject::getParentItem()
 {
     DcmItem *parentItem = NULL;
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2010, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -25,8 +25,19 @@
 
 #include "dcmtk/dcmdata/dcostrmz.h"
 #include "dcmtk/dcmdata/dcerror.h"
+#include "dcmtk/ofstd/ofvector.h"
 
-#define DCMZLIBOUTPUTFILTER_BUFSIZE 4096
+#ifdef WITH_THREADS
+#include "dcmtk/ofstd/ofthread.h"
+#endif
+
+#define DCMZLIBOUTPUTFILTER_DEFAULT_BUFSIZE 65536
+#define DCMZLIBOUTPUTFILTER_MIN_BUFSIZE 4096
+
+/* size of the deflate window, i.e. the maximum amount of preceding
+ * uncompressed data that may be referenced by the compressed stream
+ */
+#define DCMZLIB_WINDOW_SIZE 32768
 
 /* taken from zutil.h */
 #if MAX_MEM_LEVEL >= 8
@@ -36,6 +47,9 @@
 #endif
 
 OFGlobal<int> dcmZlibCompressionLevel(Z_DEFAULT_COMPRESSION);
+OFGlobal<Uint32> dcmZlibOutputBufferSize(DCMZLIBOUTPUTFILTER_DEFAULT_BUFSIZE);
+OFGlobal<Uint32> dcmZlibCompressionThreads(1);
+OFGlobal<Uint32> dcmZlibParallelBlockSize(131072);
 
 // helper method to fix old-style casts warnings
 BEGIN_EXTERN_C
@@ -53,20 +67,506 @@ static int OFdeflateInit(z_stream* const stream, int level)
   return deflateInit2(stream, level, Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY);
 #endif
 }
+
+static int OFdeflateInitRaw(z_stream* const stream, int level)
+{
+  /* windowBits is passed < 0 to suppress zlib header */
+  return deflateInit2(stream, level, Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+}
 END_EXTERN_C
 
+/* determine the buffer size to be used by a new filter object */
+static offile_off_t getOutputBufferSize()
+{
+  Uint32 size = dcmZlibOutputBufferSize.get();
+  if (size < DCMZLIBOUTPUTFILTER_MIN_BUFSIZE) size = DCMZLIBOUTPUTFILTER_MIN_BUFSIZE;
+  return OFstatic_cast(offile_off_t, size);
+}
+
+/* create an error condition from the message of the given zlib stream */
+static OFCondition makeZLibError(const z_streamp zstream)
+{
+  OFString etext = "ZLib Error: ";
+  if (zstream->msg) etext += zstream->msg;
+  return makeOFCondition(OFM_dcmdata, 16, OF_error, etext.c_str());
+}
+
+
+/** helper class managing a single block of a block-parallel deflate stream.
+ *  The block is compressed independently from all other blocks, using the
+ *  uncompressed data preceding the block (if any) as the dictionary. Unless
+ *  it is the last block of the stream, the compressed block is terminated
+ *  with a sync flush, i.e. it ends on a byte boundary and does not carry the
+ *  "last block" flag, so that all blocks can simply be concatenated.
+ */
+class DcmZLibCompressionBlock
+{
+public:
+
+  /** constructor
+   *  @param blockSize maximum number of uncompressed bytes in this block
+   *  @param level compression level
+   */
+  DcmZLibCompressionBlock(size_t blockSize, int level)
+  : input(new unsigned char[blockSize])
+  , inputCount(0)
+  , dictionary(NULL)
+  , dictionaryLength(0)
+  , finalize(OFFalse)
+  , output(NULL)
+  , outputSize(0)
+  , outputCount(0)
+  , status(EC_Normal)
+  , zstream_()
+  {
+    zstream_.zalloc = Z_NULL;
+    zstream_.zfree = Z_NULL;
+    zstream_.opaque = Z_NULL;
+    if (Z_OK == OFdeflateInitRaw(&zstream_, level))
+    {
+      // worst case size of a compressed block including the sync flush marker
+      outputSize = OFstatic_cast(size_t, deflateBound(&zstream_, OFstatic_cast(uLong, blockSize))) + 16;
+      output = new unsigned char[outputSize];
+    }
+    else status = makeZLibError(&zstream_);
+  }
+
+  /// destructor
+  ~DcmZLibCompressionBlock()
+  {
+    deflateEnd(&zstream_);
+    delete[] input;
+    delete[] output;
+  }
+
+  /** compresses the content of the input buffer into the output buffer.
+   *  The result is stored in outputCount and status.
+   */
+  void compress()
+  {
+    outputCount = 0;
+    if (status.bad()) return;
+    if (deflateReset(&zstream_) != Z_OK)
+    {
+      status = makeZLibError(&zstream_);
+      return;
+    }
+    if (dictionaryLength > 0)
+    {
+      if (deflateSetDictionary(&zstream_, dictionary, OFstatic_cast(uInt, dictionaryLength)) != Z_OK)
+      {
+        status = makeZLibError(&zstream_);
+        return;
+      }
+    }
+    zstream_.next_in = input;
+    zstream_.avail_in = OFstatic_cast(uInt, inputCount);
+    zstream_.next_out = output;
+    zstream_.avail_out = OFstatic_cast(uInt, outputSize);
+    const int zstatus = deflate(&zstream_, (finalize ? Z_FINISH : Z_SYNC_FLUSH));
+    if ((finalize && (zstatus != Z_STREAM_END)) ||
+        (!finalize && ((zstatus != Z_OK) || (zstream_.avail_in > 0) || (zstream_.avail_out == 0))))
+    {
+      // the output buffer is large enough for the worst case, so this should never happen
+      if (zstatus == Z_OK || zstatus == Z_BUF_ERROR)
+        status = makeOFCondition(OFM_dcmdata, 16, OF_error, "ZLib Error: insufficient output buffer");
+      else
+        status = makeZLibError(&zstream_);
+      return;
+    }
+    outputCount = outputSize - OFstatic_cast(size_t, zstream_.avail_out);
+  }
+
+  /// uncompressed input data
+  unsigned char *input;
+
+  /// number of bytes in the input buffer
+  size_t inputCount;
+
+  /// dictionary (uncompressed data preceding this block), may be NULL
+  const unsigned char *dictionary;
+
+  /// number of bytes in the dictionary
+  size_t dictionaryLength;
+
+  /// true if this is the last block of the compressed stream
+  OFBool finalize;
+
+  /// compressed output data
+  unsigned char *output;
+
+  /// size of the output buffer
+  size_t outputSize;
+
+  /// number of bytes in the output buffer
+  size_t outputCount;
+
+  /// status of the last compression
+  OFCondition status;
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmZLibCompressionBlock(const DcmZLibCompressionBlock&);
+
+  /// private unimplemented copy assignment operator
+  DcmZLibCompressionBlock& operator=(const DcmZLibCompressionBlock&);
+
+  /// zlib status for this block
+  z_stream zstream_;
+};
+
+
+#ifdef WITH_THREADS
+
+/** worker thread compressing a single block of a block-parallel deflate
+ *  stream. The thread is started once and compresses its block again for
+ *  each batch, until shutdown() is called.
+ */
+class DcmZLibCompressionThread: public OFThread
+{
+public:
+
+  /** constructor
+   *  @param block block to be compressed
+   */
+  DcmZLibCompressionThread(DcmZLibCompressionBlock& block)
+  : OFThread()
+  , block_(block)
+  , startSemaphore_(0)
+  , doneSemaphore_(0)
+  , shutdown_(OFFalse)
+  {
+  }
+
+  /// lets the thread compress its block, see waitForBlock()
+  void compressBlock()
+  {
+    startSemaphore_.post();
+  }
+
+  /// waits until the block passed to compressBlock() has been compressed
+  void waitForBlock()
+  {
+    doneSemaphore_.wait();
+  }
+
+  /// lets the thread terminate, must be followed by join()
+  void shutdown()
+  {
+    shutdown_ = OFTrue;
+    startSemaphore_.post();
+  }
+
+protected:
+
+  /// compresses the block whenever compressBlock() is called
+  virtual void run()
+  {
+    while ((startSemaphore_.wait() == 0) && !shutdown_)
+    {
+      block_.compress();
+      doneSemaphore_.post();
+    }
+  }
+
+private:
+
+  /// block to be compressed
+  DcmZLibCompressionBlock& block_;
+
+  /// posted when the block should be compressed
+  OFSemaphore startSemaphore_;
+
+  /// posted when the block has been compressed
+  OFSemaphore doneSemaphore_;
+
+  /// true if the thread should terminate
+  OFBool shutdown_;
+};
+
+#endif
+
+
+/** block-parallel deflate compressor. Uncompressed data is collected in a
+ *  batch of blocks (one per thread). Once the batch is full, all blocks are
+ *  compressed concurrently and the compressed blocks are written to the
+ *  consumer in their original order, resulting in a single valid deflate
+ *  stream. The last 32 kBytes of uncompressed data preceding each block are
+ *  used as its dictionary, so the compression ratio is almost the same as
+ *  with a single compressor.
+ */
+class DcmZLibParallelCompressor
+{
+public:
+
+  /** constructor
+   *  @param numBlocks number of blocks compressed in parallel
+   *  @param blockSize number of uncompressed bytes per block
+   *  @param level compression level
+   */
+  DcmZLibParallelCompressor(size_t numBlocks, size_t blockSize, int level)
+  : blocks_()
+#ifdef WITH_THREADS
+  , threads_()
+#endif
+  , blockSize_(blockSize)
+  , window_(new unsigned char[DCMZLIB_WINDOW_SIZE])
+  , windowCount_(0)
+  , fillBlock_(0)
+  , numPending_(0)
+  , pendingBlock_(0)
+  , pendingOffset_(0)
+  , finished_(OFFalse)
+  , status_(EC_Normal)
+  {
+    for (size_t i = 0; i < numBlocks; ++i)
+    {
+      DcmZLibCompressionBlock *block = new DcmZLibCompressionBlock(blockSize, level);
+      blocks_.push_back(block);
+      if (block->status.bad()) status_ = block->status;
+    }
+  }
+
+  /// destructor
+  ~DcmZLibParallelCompressor()
+  {
+#ifdef WITH_THREADS
+    for (size_t i = 0; i < threads_.size(); ++i)
+    {
+      if (threads_[i])
+      {
+        threads_[i]->shutdown();
+        threads_[i]->join();
+        delete threads_[i];
+      }
+    }
+#endif
+    for (size_t i = 0; i < blocks_.size(); ++i) delete blocks_[i];
+    delete[] window_;
+  }
+
+  /// returns the status of the compressor
+  OFCondition status() const
+  {
+    return status_;
+  }
+
+  /// returns true if the end of the compressed stream has been created
+  OFBool isFinished() const
+  {
+    return finished_;
+  }
+
+  /// returns true if compressed data is waiting to be written to the consumer
+  OFBool hasPendingOutput() const
+  {
+    return pendingBlock_ < numPending_;
+  }
+
+  /// returns true if the current batch of blocks is full
+  OFBool isBatchFull() const
+  {
+    return fillBlock_ == blocks_.size();
+  }
+
+  /// returns the number of uncompressed bytes in a complete batch
+  offile_off_t batchSize() const
+  {
+    return OFstatic_cast(offile_off_t, blocks_.size() * blockSize_);
+  }
+
+  /** copies as much of the given data as possible into the current batch
+   *  @param buf pointer to input data
+   *  @param buflen number of bytes in buf
+   *  @return number of bytes copied
+   */
+  offile_off_t addInput(const void *buf, offile_off_t buflen)
+  {
+    const unsigned char *data = OFstatic_cast(const unsigned char *, buf);
+    offile_off_t result = 0;
+    while ((result < buflen) && !finished_ && !isBatchFull())
+    {
+      DcmZLibCompressionBlock *block = blocks_[fillBlock_];
+      size_t len = blockSize_ - block->inputCount;
+      if (OFstatic_cast(offile_off_t, len) > buflen - result) len = OFstatic_cast(size_t, buflen - result);
+      memcpy(block->input + block->inputCount, data + result, len);
+      block->inputCount += len;
+      result += OFstatic_cast(offile_off_t, len);
+      if (block->inputCount == blockSize_) ++fillBlock_;
+    }
+    return result;
+  }
+
+  /** compresses all blocks of the current batch. Must only be called if
+   *  there is no pending output.
+   *  @param finalize true if the current batch constitutes the end of the
+   *    stream, i.e. the last block should terminate the compressed stream
+   */
+  void compressBatch(OFBool finalize)
+  {
+    if (status_.bad() || finished_ || hasPendingOutput()) return;
+    size_t numBlocks = fillBlock_;
+    if ((numBlocks < blocks_.size()) && (blocks_[numBlocks]->inputCount > 0)) ++numBlocks;
+    // at the end of the stream, we need at least one (possibly empty) final block
+    if (finalize && (numBlocks == 0)) numBlocks = 1;
+    if (numBlocks == 0) return;
+
+    size_t i;
+    for (i = 0; i < numBlocks; ++i)
+    {
+      DcmZLibCompressionBlock *block = blocks_[i];
+      if (i == 0)
+      {
+        block->dictionary = window_;
+        block->dictionaryLength = windowCount_;
+      } else {
+        // all blocks except the last one are full and larger than the window
+        block->dictionary = blocks_[i - 1]->input + blockSize_ - DCMZLIB_WINDOW_SIZE;
+        block->dictionaryLength = DCMZLIB_WINDOW_SIZE;
+      }
+      block->finalize = finalize && (i + 1 == numBlocks);
+    }
+
+#ifdef WITH_THREADS
+    // compress the first block in this thread and all others in worker threads.
+    // The worker threads are started for the first batch with more than one
+    // block and are reused for all following batches.
+    if ((numBlocks > 1) && threads_.empty())
+    {
+      for (i = 1; i < blocks_.size(); ++i)
+      {
+        DcmZLibCompressionThread *thread = new DcmZLibCompressionThread(*blocks_[i]);
+        if (thread->start() != 0)
+        {
+          // thread could not be created, compress its block in this thread instead
+          delete thread;
+          thread = NULL;
+        }
+        threads_.push_back(thread);
+      }
+    }
+    for (i = 1; i < numBlocks; ++i)
+    {
+      if (threads_[i - 1])
+        threads_[i - 1]->compressBlock();
+      else
+        blocks_[i]->compress();
+    }
+    blocks_[0]->compress();
+    for (i = 1; i < numBlocks; ++i)
+    {
+      if (threads_[i - 1]) threads_[i - 1]->waitForBlock();
+    }
+#else
+    for (i = 0; i < numBlocks; ++i) blocks_[i]->compress();
+#endif
+
+    for (i = 0; i < numBlocks; ++i)
+    {
+      if (blocks_[i]->status.bad()) status_ = blocks_[i]->status;
+    }
+
+    // keep the tail of the last block as dictionary for the next batch
+    if (!finalize)
+    {
+      memcpy(window_, blocks_[numBlocks - 1]->input + blockSize_ - DCMZLIB_WINDOW_SIZE, DCMZLIB_WINDOW_SIZE);
+      windowCount_ = DCMZLIB_WINDOW_SIZE;
+    }
+
+    for (i = 0; i < numBlocks; ++i) blocks_[i]->inputCount = 0;
+    fillBlock_ = 0;
+    numPending_ = numBlocks;
+    pendingBlock_ = 0;
+    pendingOffset_ = 0;
+    if (finalize) finished_ = OFTrue;
+  }
+
+  /** writes pending compressed data to the given consumer until all data
+   *  has been written or the consumer suspends
+   *  @param consumer consumer to write to
+   *  @return true if there is no more pending output, false otherwise
+   */
+  OFBool flushOutput(DcmConsumer& consumer)
+  {
+    while (status_.good() && hasPendingOutput())
+    {
+      DcmZLibCompressionBlock *block = blocks_[pendingBlock_];
+      if (pendingOffset_ < block->outputCount)
+      {
+        const offile_off_t written = consumer.write(block->output + pendingOffset_,
+          OFstatic_cast(offile_off_t, block->outputCount - pendingOffset_));
+        if (written == 0) return OFFalse; // consumer suspension
+        pendingOffset_ += OFstatic_cast(size_t, written);
+      }
+      if (pendingOffset_ == block->outputCount)
+      {
+        ++pendingBlock_;
+        pendingOffset_ = 0;
+      }
+    }
+    return !hasPendingOutput();
+  }
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmZLibParallelCompressor(const DcmZLibParallelCompressor&);
+
+  /// private unimplemented copy assignment operator
+  DcmZLibParallelCompressor& operator=(const DcmZLibParallelCompressor&);
+
+  /// blocks of the current batch
+  OFVector<DcmZLibCompressionBlock *> blocks_;
+
+#ifdef WITH_THREADS
+  /// worker threads for all blocks but the first one, NULL if a thread could not be started
+  OFVector<DcmZLibCompressionThread *> threads_;
+#endif
+
+  /// number of uncompressed bytes per block
+  size_t blockSize_;
+
+  /// uncompressed data preceding the current batch, used as dictionary
+  unsigned char *window_;
+
+  /// number of bytes in window_
+  size_t windowCount_;
+
+  /// index of the block currently being filled
+  size_t fillBlock_;
+
+  /// number of blocks of the last batch that contain output
+  size_t numPending_;
+
+  /// index of the first block with output not yet written
+  size_t pendingBlock_;
+
+  /// number of bytes already written from the output of pendingBlock_
+  size_t pendingOffset_;
+
+  /// true if the final batch has been compressed
+  OFBool finished_;
+
+  /// status
+  OFCondition status_;
+};
+
+
 DcmZLibOutputFilter::DcmZLibOutputFilter()
 : DcmOutputFilter()
 , current_(NULL)
 , zstream_(new z_stream)
 , status_(EC_MemoryExhausted)
 , flushed_(OFFalse)
-, inputBuf_(new unsigned char[DCMZLIBOUTPUTFILTER_BUFSIZE])
+, bufSize_(getOutputBufferSize())
+, inputBuf_(new unsigned char[OFstatic_cast(size_t, bufSize_)])
 , inputBufStart_(0)
 , inputBufCount_(0)
-, outputBuf_(new unsigned char[DCMZLIBOUTPUTFILTER_BUFSIZE])
+, outputBuf_(new unsigned char[OFstatic_cast(size_t, bufSize_)])
 , outputBufStart_(0)
 , outputBufCount_(0)
+, parallel_(NULL)
 {
   if (zstream_ && inputBuf_ && outputBuf_)
   {
@@ -82,6 +582,17 @@ DcmZLibOutputFilter::DcmZLibOutputFilter()
       status_ = makeOFCondition(OFM_dcmdata, 16, OF_error, etext.c_str());
     }
   }
+#ifndef ZLIB_ENCODE_RFC1950_HEADER
+  // block-parallel compression is only supported for the deflated bitstream format
+  const Uint32 numThreads = dcmZlibCompressionThreads.get();
+  if (status_.good() && (numThreads > 1))
+  {
+    Uint32 blockSize = dcmZlibParallelBlockSize.get();
+    if (blockSize < DCMZLIB_WINDOW_SIZE) blockSize = DCMZLIB_WINDOW_SIZE;
+    parallel_ = new DcmZLibParallelCompressor(numThreads, blockSize, dcmZlibCompressionLevel.get());
+    status_ = parallel_->status();
+  }
+#endif
 }
 
 DcmZLibOutputFilter::~DcmZLibOutputFilter()
@@ -93,6 +604,7 @@ DcmZLibOutputFilter::~DcmZLibOutputFilter()
   }
   delete[] inputBuf_;
   delete[] outputBuf_;
+  delete parallel_;
 }
 
 
@@ -109,14 +621,25 @@ OFCondition DcmZLibOutputFilter::status() const
 OFBool DcmZLibOutputFilter::isFlushed() const
 {
   if (status_.bad() || (current_ == NULL)) return OFTrue;
+  if (parallel_)
+    return parallel_->isFinished() && !parallel_->hasPendingOutput() && current_->isFlushed();
   return (inputBufCount_ == 0) && (outputBufCount_ == 0) && flushed_ && current_->isFlushed();
 }
 
 
 offile_off_t DcmZLibOutputFilter::avail() const
 {
+  if (status_.good() && parallel_)
+  {
+    // write() compresses the current batch once it is full and continues
+    // with the next one, so a complete batch can always be accepted unless
+    // compressed data is still waiting for the consumer
+    if (parallel_->hasPendingOutput() || parallel_->isFinished()) return 0;
+    return parallel_->batchSize();
+  }
+
   // compute number of bytes available in input buffer
-  if (status_.good() ) return DCMZLIBOUTPUTFILTER_BUFSIZE - inputBufCount_;
+  if (status_.good() ) return bufSize_ - inputBufCount_;
     else return 0;
 }
 
@@ -125,8 +648,8 @@ void DcmZLibOutputFilter::flushOutputBuffer()
   if (outputBufCount_)
   {
     // flush from outputBufStart_ to end of data or end of buffer, whatever comes first
-    offile_off_t numBytes = (outputBufStart_ + outputBufCount_ > DCMZLIBOUTPUTFILTER_BUFSIZE) ?
-      (DCMZLIBOUTPUTFILTER_BUFSIZE - outputBufStart_) : outputBufCount_ ;
+    offile_off_t numBytes = (outputBufStart_ + outputBufCount_ > bufSize_) ?
+      (bufSize_ - outputBufStart_) : outputBufCount_ ;
 
     offile_off_t written = current_->write(outputBuf_ + outputBufStart_, numBytes);
 
@@ -134,7 +657,7 @@ void DcmZLibOutputFilter::flushOutputBuffer()
     outputBufCount_ -= written;
     outputBufStart_ += written;
 
-    if (outputBufStart_ == DCMZLIBOUTPUTFILTER_BUFSIZE)
+    if (outputBufStart_ == bufSize_)
     {
       // wrapped around
       outputBufStart_ = 0;
@@ -158,15 +681,15 @@ void DcmZLibOutputFilter::flushOutputBuffer()
 offile_off_t DcmZLibOutputFilter::fillInputBuffer(const void *buf, offile_off_t buflen)
 {
   offile_off_t result = 0;
-  if (buf && buflen && inputBufCount_ < DCMZLIBOUTPUTFILTER_BUFSIZE)
+  if (buf && buflen && inputBufCount_ < bufSize_)
   {
 
     const unsigned char *data = OFstatic_cast(const unsigned char *, buf);
 
     // use first part of input buffer
-    if (inputBufStart_ + inputBufCount_ < DCMZLIBOUTPUTFILTER_BUFSIZE)
+    if (inputBufStart_ + inputBufCount_ < bufSize_)
     {
-      result = DCMZLIBOUTPUTFILTER_BUFSIZE - (inputBufStart_ + inputBufCount_);
+      result = bufSize_ - (inputBufStart_ + inputBufCount_);
       if (result > buflen) result = buflen;
 
       memcpy(inputBuf_ + inputBufStart_ + inputBufCount_, data, OFstatic_cast(size_t, result));
@@ -176,13 +699,13 @@ offile_off_t DcmZLibOutputFilter::fillInputBuffer(const void *buf, offile_off_t
     }
 
     // use second part of input buffer
-    if (buflen && (inputBufCount_ < DCMZLIBOUTPUTFILTER_BUFSIZE) &&
-        inputBufStart_ + inputBufCount_ >= DCMZLIBOUTPUTFILTER_BUFSIZE)
+    if (buflen && (inputBufCount_ < bufSize_) &&
+        inputBufStart_ + inputBufCount_ >= bufSize_)
     {
-      offile_off_t len = DCMZLIBOUTPUTFILTER_BUFSIZE - inputBufCount_;
+      offile_off_t len = bufSize_ - inputBufCount_;
       if (len > buflen) len = buflen;
 
-      memcpy(inputBuf_ + (inputBufStart_ + inputBufCount_ - DCMZLIBOUTPUTFILTER_BUFSIZE), data, OFstatic_cast(size_t, len));
+      memcpy(inputBuf_ + (inputBufStart_ + inputBufCount_ - bufSize_), data, OFstatic_cast(size_t, len));
 
       inputBufCount_ += len;
       result += len;
@@ -196,8 +719,8 @@ void DcmZLibOutputFilter::compressInputBuffer(OFBool finalize)
   if (inputBufCount_ || finalize)
   {
     // flush from inputBufStart_ to end of data or end of buffer, whatever comes first
-    offile_off_t numBytes = (inputBufStart_ + inputBufCount_ > DCMZLIBOUTPUTFILTER_BUFSIZE) ?
-      (DCMZLIBOUTPUTFILTER_BUFSIZE - inputBufStart_) : inputBufCount_ ;
+    offile_off_t numBytes = (inputBufStart_ + inputBufCount_ > bufSize_) ?
+      (bufSize_ - inputBufStart_) : inputBufCount_ ;
 
     offile_off_t written = compress(inputBuf_ + inputBufStart_, numBytes, finalize);
 
@@ -205,7 +728,7 @@ void DcmZLibOutputFilter::compressInputBuffer(OFBool finalize)
     inputBufCount_ -= written;
     inputBufStart_ += written;
 
-    if (inputBufStart_ == DCMZLIBOUTPUTFILTER_BUFSIZE)
+    if (inputBufStart_ == bufSize_)
     {
       // wrapped around
       inputBufStart_ = 0;
@@ -229,17 +752,17 @@ void DcmZLibOutputFilter::compressInputBuffer(OFBool finalize)
 offile_off_t DcmZLibOutputFilter::compress(const void *buf, offile_off_t buflen, OFBool finalize)
 {
   offile_off_t result = 0;
-  if (outputBufCount_ < DCMZLIBOUTPUTFILTER_BUFSIZE)
+  if (outputBufCount_ < bufSize_)
   {
     zstream_->next_in = OFstatic_cast(Bytef *, OFconst_cast(void *, buf));
     zstream_->avail_in = OFstatic_cast(uInt, buflen);
     int zstatus;
 
     // use first part of output buffer
-    if (outputBufStart_ + outputBufCount_ < DCMZLIBOUTPUTFILTER_BUFSIZE)
+    if (outputBufStart_ + outputBufCount_ < bufSize_)
     {
       zstream_->next_out = OFstatic_cast(Bytef *, outputBuf_ + outputBufStart_ + outputBufCount_);
-      zstream_->avail_out = OFstatic_cast(uInt, DCMZLIBOUTPUTFILTER_BUFSIZE - (outputBufStart_ + outputBufCount_));
+      zstream_->avail_out = OFstatic_cast(uInt, bufSize_ - (outputBufStart_ + outputBufCount_));
       zstatus = deflate(zstream_, (finalize ? Z_FINISH : 0));
 
       if (zstatus == Z_OK || zstatus == Z_BUF_ERROR) { /* everything OK */ }
@@ -251,15 +774,15 @@ offile_off_t DcmZLibOutputFilter::compress(const void *buf, offile_off_t buflen,
         status_ = makeOFCondition(OFM_dcmdata, 16, OF_error, etext.c_str());
       }
 
-      outputBufCount_ = DCMZLIBOUTPUTFILTER_BUFSIZE - outputBufStart_ - OFstatic_cast(offile_off_t, zstream_->avail_out);
+      outputBufCount_ = bufSize_ - outputBufStart_ - OFstatic_cast(offile_off_t, zstream_->avail_out);
     }
 
     // use second part of output buffer
-    if ((outputBufCount_ < DCMZLIBOUTPUTFILTER_BUFSIZE) &&
-        outputBufStart_ + outputBufCount_ >= DCMZLIBOUTPUTFILTER_BUFSIZE)
+    if ((outputBufCount_ < bufSize_) &&
+        outputBufStart_ + outputBufCount_ >= bufSize_)
     {
-      zstream_->next_out = OFstatic_cast(Bytef *, outputBuf_ + (outputBufStart_ + outputBufCount_ - DCMZLIBOUTPUTFILTER_BUFSIZE));
-      zstream_->avail_out = OFstatic_cast(uInt, DCMZLIBOUTPUTFILTER_BUFSIZE - outputBufCount_);
+      zstream_->next_out = OFstatic_cast(Bytef *, outputBuf_ + (outputBufStart_ + outputBufCount_ - bufSize_));
+      zstream_->avail_out = OFstatic_cast(uInt, bufSize_ - outputBufCount_);
       zstatus = deflate(zstream_, (finalize ? Z_FINISH : 0));
 
       if (zstatus == Z_OK || zstatus == Z_BUF_ERROR) { /* everything OK */ }
@@ -271,7 +794,7 @@ offile_off_t DcmZLibOutputFilter::compress(const void *buf, offile_off_t buflen,
         status_ = makeOFCondition(OFM_dcmdata, 16, OF_error, etext.c_str());
       }
 
-      outputBufCount_ =  DCMZLIBOUTPUTFILTER_BUFSIZE - OFstatic_cast(offile_off_t, zstream_->avail_out);
+      outputBufCount_ =  bufSize_ - OFstatic_cast(offile_off_t, zstream_->avail_out);
     }
 
     result = (buflen - OFstatic_cast(offile_off_t, zstream_->avail_in));
@@ -282,15 +805,16 @@ offile_off_t DcmZLibOutputFilter::compress(const void *buf, offile_off_t buflen,
 offile_off_t DcmZLibOutputFilter::write(const void *buf, offile_off_t buflen)
 {
   if (status_.bad() || (current_ == NULL)) return 0;
+  if (parallel_) return writeParallel(buf, buflen);
 
   // flush output buffer if necessary
-  if (outputBufCount_ == DCMZLIBOUTPUTFILTER_BUFSIZE) flushOutputBuffer();
+  if (outputBufCount_ == bufSize_) flushOutputBuffer();
 
   // compress pending input from input buffer
-  while (status_.good() && inputBufCount_ > 0 && outputBufCount_ < DCMZLIBOUTPUTFILTER_BUFSIZE)
+  while (status_.good() && inputBufCount_ > 0 && outputBufCount_ < bufSize_)
   {
     compressInputBuffer(OFFalse);
-    if (outputBufCount_ == DCMZLIBOUTPUTFILTER_BUFSIZE) flushOutputBuffer();
+    if (outputBufCount_ == bufSize_) flushOutputBuffer();
   }
 
   const unsigned char *data = OFstatic_cast(const unsigned char *, buf);
@@ -299,10 +823,10 @@ offile_off_t DcmZLibOutputFilter::write(const void *buf, offile_off_t buflen)
   // compress user data only if input buffer is empty
   if (inputBufCount_ == 0)
   {
-    while (status_.good() && (buflen > result) && outputBufCount_ < DCMZLIBOUTPUTFILTER_BUFSIZE)
+    while (status_.good() && (buflen > result) && outputBufCount_ < bufSize_)
     {
       result += compress(data+result, buflen-result, OFFalse);
-      if (outputBufCount_ == DCMZLIBOUTPUTFILTER_BUFSIZE) flushOutputBuffer();
+      if (outputBufCount_ == bufSize_) flushOutputBuffer();
     }
   }
 
@@ -314,25 +838,60 @@ offile_off_t DcmZLibOutputFilter::write(const void *buf, offile_off_t buflen)
 }
 
 
+offile_off_t DcmZLibOutputFilter::writeParallel(const void *buf, offile_off_t buflen)
+{
+  const unsigned char *data = OFstatic_cast(const unsigned char *, buf);
+  offile_off_t result = 0;
+  while (status_.good())
+  {
+    // write compressed data of the previous batch first
+    if (parallel_->hasPendingOutput() && !parallel_->flushOutput(*current_)) break;
+
+    // compress the current batch as soon as it is full
+    if (parallel_->isBatchFull())
+    {
+      parallel_->compressBatch(OFFalse);
+      status_ = parallel_->status();
+      continue;
+    }
+
+    if (result == buflen) break;
+    result += parallel_->addInput(data + result, buflen - result);
+  }
+  return result;
+}
+
 void DcmZLibOutputFilter::flush()
 {
-  if (status_.good() && current_)
+  if (status_.good() && current_ && parallel_)
+  {
+    // compress the remaining input, which terminates the compressed stream
+    if (!parallel_->isFinished() &&
+        (!parallel_->hasPendingOutput() || parallel_->flushOutput(*current_)))
+    {
+      parallel_->compressBatch(OFTrue);
+      flushed_ = parallel_->isFinished();
+    }
+    parallel_->flushOutput(*current_);
+    status_ = parallel_->status();
+  }
+  else if (status_.good() && current_)
   {
     // flush output buffer first
-    if (outputBufCount_ == DCMZLIBOUTPUTFILTER_BUFSIZE) flushOutputBuffer();
+    if (outputBufCount_ == bufSize_) flushOutputBuffer();
 
     // compress pending input from input buffer
-    while (status_.good() && inputBufCount_ > 0 && outputBufCount_ < DCMZLIBOUTPUTFILTER_BUFSIZE)
+    while (status_.good() && inputBufCount_ > 0 && outputBufCount_ < bufSize_)
     {
       compressInputBuffer(OFTrue);
-      if (outputBufCount_ == DCMZLIBOUTPUTFILTER_BUFSIZE) flushOutputBuffer();
+      if (outputBufCount_ == bufSize_) flushOutputBuffer();
     }
 
-    while (status_.good() && (! flushed_) && outputBufCount_ < DCMZLIBOUTPUTFILTER_BUFSIZE)
+    while (status_.good() && (! flushed_) && outputBufCount_ < bufSize_)
     {
       // create output from compression engine until end of compressed stream
       compress(NULL, 0, OFTrue);
-      if (outputBufCount_ == DCMZLIBOUTPUTFILTER_BUFSIZE) flushOutputBuffer();
+      if (outputBufCount_ == bufSize_) flushOutputBuffer();
     }
 
     // final attempt to flush output buffer
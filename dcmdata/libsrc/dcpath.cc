@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2008-2023, OFFIS e.V.
+ *  Copyright (C) 2008-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -952,3 +952,153 @@ DcmPathProcessor::checkPrivateTagReservation(DcmItem* item, const DcmTagKey& tag
     }
     return EC_Normal;
 }
+
+
+// ------------------------ Tag selection ------------------------
+
+DcmTagSelection::DcmTagSelection()
+  : m_selection()
+{
+}
+
+
+DcmTagSelection::~DcmTagSelection()
+{
+    clear();
+}
+
+
+OFCondition DcmTagSelection::addPath(const OFString& path)
+{
+    if (path.empty())
+        return EC_IllegalParameter;
+    OFString restPath(path);
+    return addPathComponents(restPath);
+}
+
+
+void DcmTagSelection::addTag(const DcmTagKey& tag)
+{
+    const size_t pos = lowerBound(tag);
+    if ((pos < m_selection.size()) && (m_selection[pos].tag == tag))
+    {
+        // select the attribute completely
+        delete m_selection[pos].itemSelection;
+        m_selection[pos].itemSelection = NULL;
+    } else {
+        SelectionEntry entry;
+        entry.tag = tag;
+        entry.itemSelection = NULL;
+        m_selection.insert(m_selection.begin() + pos, entry);
+    }
+}
+
+
+void DcmTagSelection::clear()
+{
+    for (size_t i = 0; i < m_selection.size(); ++i)
+        delete m_selection[i].itemSelection;
+    m_selection.clear();
+}
+
+
+OFBool DcmTagSelection::empty() const
+{
+    return m_selection.empty();
+}
+
+
+OFBool DcmTagSelection::isSelected(const DcmTagKey& tag) const
+{
+    return findEntry(tag) != NULL;
+}
+
+
+const DcmTagSelection* DcmTagSelection::getItemSelection(const DcmTagKey& tag) const
+{
+    const SelectionEntry *entry = findEntry(tag);
+    return (entry != NULL) ? entry->itemSelection : NULL;
+}
+
+
+OFBool DcmTagSelection::isNeededPrivateCreator(const DcmTagKey& tag) const
+{
+    if (tag.isPrivateReservation())
+    {
+        // private tags (gggg,xxyy) with xx equal to the element number of the reservation
+        const size_t pos = lowerBound(DcmTagKey(tag.getGroup(), OFstatic_cast(Uint16, tag.getElement() << 8)));
+        return (pos < m_selection.size()) && (m_selection[pos].tag.getGroup() == tag.getGroup()) &&
+            ((m_selection[pos].tag.getElement() >> 8) == tag.getElement());
+    }
+    return OFFalse;
+}
+
+
+size_t DcmTagSelection::lowerBound(const DcmTagKey& tag) const
+{
+    size_t first = 0;
+    size_t count = m_selection.size();
+    while (count > 0)
+    {
+        const size_t step = count / 2;
+        if (m_selection[first + step].tag < tag)
+        {
+            first += step + 1;
+            count -= step + 1;
+        } else
+            count = step;
+    }
+    return first;
+}
+
+
+const DcmTagSelection::SelectionEntry* DcmTagSelection::findEntry(const DcmTagKey& tag) const
+{
+    const size_t pos = lowerBound(tag);
+    if ((pos < m_selection.size()) && (m_selection[pos].tag == tag))
+        return &m_selection[pos];
+    return NULL;
+}
+
+
+OFCondition DcmTagSelection::addPathComponents(OFString& path)
+{
+    DcmTag tag;
+    OFCondition status = DcmPath::parseTagFromPath(path, tag);
+    if (status.bad())
+        return status;
+    if (!path.empty())
+    {
+        Uint32 itemNo = 0;
+        OFBool wasWildcard = OFFalse;
+        // all items are filtered in the same way, so the item number is not used
+        status = DcmPath::parseItemNoFromPath(path, itemNo, wasWildcard);
+        if (status.bad())
+            return status;
+    }
+    // the path ends with an attribute or an item, so select the attribute completely
+    if (path.empty())
+    {
+        addTag(tag);
+        return EC_Normal;
+    }
+    const size_t pos = lowerBound(tag);
+    if ((pos < m_selection.size()) && (m_selection[pos].tag == tag))
+    {
+        // the sequence is already selected completely, so there is nothing to do
+        if (m_selection[pos].itemSelection == NULL)
+            return EC_Normal;
+        return m_selection[pos].itemSelection->addPathComponents(path);
+    }
+    DcmTagSelection *itemSelection = new DcmTagSelection();
+    status = itemSelection->addPathComponents(path);
+    if (status.good())
+    {
+        SelectionEntry entry;
+        entry.tag = tag;
+        entry.itemSelection = itemSelection;
+        m_selection.insert(m_selection.begin() + pos, entry);
+    } else
+        delete itemSelection;
+    return status;
+}
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2023, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -103,3 +103,11 @@ void DcmPrivateTagCache::updateCache(DcmObject *dobj)
     }
   }
 }
+
+void DcmPrivateTagCache::updateCache(const DcmTagKey& tk, const char *pc)
+{
+  if (pc && (tk.getGroup() & 1) && (tk.getElement() <= 0xff) && (tk.getElement() >= 0x10))
+  {
+    list_.push_back(new DcmPrivateTagCacheEntry(tk, pc));
+  }
+}
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2024, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -34,6 +34,408 @@
 #include "dcmtk/dcmdata/dcuid.h"     /* for dcmGenerateUniqueIdentifer()*/
 
 
+/** distributes the bytes of a decompressed RLE stripe into the image buffer.
+ *  The common sample distances are handled by separate loops with a constant
+ *  stride, which the compiler can unroll and vectorize. A distance of one
+ *  (8-bit planar or monochrome data) is a plain memory copy.
+ *  @param src decompressed stripe
+ *  @param dst first byte of the stripe in the image buffer
+ *  @param count number of bytes to distribute
+ *  @param stride distance between two consecutive bytes in dst
+ */
+static void scatterRLEStripe(const Uint8 *src, Uint8 *dst, size_t count, size_t stride)
+{
+  size_t i;
+  switch (stride)
+  {
+    case 1:
+      memcpy(dst, src, count);
+      break;
+    case 2:
+      for (i = 0; i < count; ++i) dst[2 * i] = src[i];
+      break;
+    case 3:
+      for (i = 0; i < count; ++i) dst[3 * i] = src[i];
+      break;
+    case 4:
+      for (i = 0; i < count; ++i) dst[4 * i] = src[i];
+      break;
+    case 6:
+      for (i = 0; i < count; ++i) dst[6 * i] = src[i];
+      break;
+    default:
+      for (i = 0; i < count; ++i) dst[stride * i] = src[i];
+      break;
+  }
+}
+
+/** helper class that decompresses the frames of an RLE compressed image.
+ *  Used for both sequential and parallel decompression, see
+ *  DcmCodec::decompressFrames(). Each thread uses its own RLE decoder.
+ */
+class DcmRLEFrameDecompressionTask: public DcmEncapsulatedFrameDecompressionTask
+{
+public:
+
+  /** constructor
+   *  @param fragmentData pointers to the content of all fragments
+   *  @param fragmentLength lengths of all fragments
+   *  @param startFragments index of the first fragment of each frame, followed by
+   *    the number of fragments. May be empty if only decompressFrameAt() is used.
+   *  @param imageSamplesPerPixel samples per pixel
+   *  @param imageBytesAllocated bytes allocated per sample
+   *  @param imageColumns number of columns
+   *  @param imageRows number of rows
+   *  @param imagePlanarConfiguration planar configuration
+   *  @param enableReverseByteOrder assume LSB to MSB order of RLE segments
+   *  @param imageData8 pointer to the uncompressed pixel data of all frames
+   *  @param frameSize size of an uncompressed frame in bytes
+   *  @param numberOfThreads number of threads that will use this object
+   */
+  DcmRLEFrameDecompressionTask(
+    const OFVector<Uint8 *>& fragmentData,
+    const OFVector<Uint32>& fragmentLength,
+    const OFVector<Uint32>& startFragments,
+    Uint16 imageSamplesPerPixel,
+    Uint16 imageBytesAllocated,
+    Uint16 imageColumns,
+    Uint16 imageRows,
+    Uint16 imagePlanarConfiguration,
+    OFBool enableReverseByteOrder,
+    Uint8 *imageData8,
+    Uint32 frameSize,
+    Uint32 numberOfThreads)
+  : DcmEncapsulatedFrameDecompressionTask(fragmentData, fragmentLength, startFragments, imageData8, frameSize, numberOfThreads)
+  , imageSamplesPerPixel_(imageSamplesPerPixel)
+  , imageBytesAllocated_(imageBytesAllocated)
+  , imageColumns_(imageColumns)
+  , imageRows_(imageRows)
+  , imagePlanarConfiguration_(imagePlanarConfiguration)
+  , enableReverseByteOrder_(enableReverseByteOrder)
+  , bytesPerStripe_(OFstatic_cast(size_t, imageColumns) * OFstatic_cast(size_t, imageRows))
+  , decoders_()
+  {
+    for (Uint32 i = 0; i < numberOfThreads; ++i)
+      decoders_.push_back(new DcmRLEDecoder(bytesPerStripe_));
+  }
+
+  /// destructor
+  virtual ~DcmRLEFrameDecompressionTask()
+  {
+    for (size_t i = 0; i < decoders_.size(); ++i)
+      delete decoders_[i];
+  }
+
+  /** check whether all RLE decoders were successfully initialized
+   *  @return OFTrue if initialization failed, OFFalse otherwise
+   */
+  OFBool fail() const
+  {
+    for (size_t i = 0; i < decoders_.size(); ++i)
+      if (decoders_[i]->fail()) return OFTrue;
+    return OFFalse;
+  }
+
+protected:
+
+  /** decompresses a single frame into the given buffer
+   *  @param frameNo number of the frame, starting with 0
+   *  @param threadNo number of the calling thread, starting with 0
+   *  @param currentItem index of the first fragment of the frame. Upon return,
+   *    contains the index of the fragment following the last one used.
+   *  @param endItem index of the fragment following the last one that may be used
+   *  @param imageData8 pointer to the uncompressed pixel data of this frame
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  virtual OFCondition decodeFrame(Uint32 frameNo, Uint32 threadNo, Uint32& currentItem, Uint32 endItem, Uint8 *imageData8);
+
+private:
+
+  /// private undefined copy constructor
+  DcmRLEFrameDecompressionTask(const DcmRLEFrameDecompressionTask&);
+
+  /// private undefined copy assignment operator
+  DcmRLEFrameDecompressionTask& operator=(const DcmRLEFrameDecompressionTask&);
+
+  /// samples per pixel
+  Uint16 imageSamplesPerPixel_;
+
+  /// bytes allocated per sample
+  Uint16 imageBytesAllocated_;
+
+  /// number of columns
+  Uint16 imageColumns_;
+
+  /// number of rows
+  Uint16 imageRows_;
+
+  /// planar configuration
+  Uint16 imagePlanarConfiguration_;
+
+  /// assume LSB to MSB order of RLE segments
+  OFBool enableReverseByteOrder_;
+
+  /// number of bytes per RLE stripe
+  size_t bytesPerStripe_;
+
+  /// RLE decoders, one per thread
+  OFVector<DcmRLEDecoder *> decoders_;
+};
+
+
+OFCondition DcmRLEFrameDecompressionTask::decodeFrame(
+  Uint32 frameNo,
+  Uint32 threadNo,
+  Uint32& currentItem,
+  Uint32 endItem,
+  Uint8 *imageData8)
+{
+  DcmRLEDecoder& rledecoder = *decoders_[threadNo];
+  Uint8 *rleData = NULL;
+  Uint32 fragmentLength = 0;
+  Uint32 numberOfStripes = 0;
+  Uint32 rleHeader[16];
+
+  DCMDATA_DEBUG("RLE decoder processes frame " << frameNo);
+  DCMDATA_DEBUG("RLE decoder processes pixel item " << currentItem);
+  // get first pixel item of this frame
+  OFCondition result = getFragment(currentItem, endItem, rleData, fragmentLength);
+  if (result.good())
+  {
+    // we require that the RLE header must be completely
+    // contained in the first fragment; otherwise bail out
+    if ((fragmentLength < 64) || (rleData == NULL))
+    {
+      DCMDATA_ERROR("Pixel item shorter than 64 bytes, RLE header incomplete.");
+      result = EC_CannotChangeRepresentation;
+    }
+  }
+
+  if (result.good())
+  {
+    // copy RLE header to buffer and adjust byte order
+    memcpy(rleHeader, rleData, 64);
+    swapIfNecessary(gLocalByteOrder, EBO_LittleEndian, rleHeader, 16*OFstatic_cast(Uint32, sizeof(Uint32)), sizeof(Uint32));
+
+    // determine number of stripes.
+    numberOfStripes = rleHeader[0];
+
+    // check that number of stripes in RLE header matches our expectation
+    if ((numberOfStripes < 1) || (numberOfStripes > 15) ||
+        (numberOfStripes != OFstatic_cast(Uint32, imageBytesAllocated_) * imageSamplesPerPixel_))
+    {
+        DCMDATA_ERROR("Number of stripes in RLE header incorrect: found " << numberOfStripes << ", expected " << (OFstatic_cast(Uint32, imageBytesAllocated_) * imageSamplesPerPixel_));
+        result = EC_CannotChangeRepresentation;
+    }
+  }
+
+  if (result.good())
+  {
+    // this variable keeps the number of bytes we have processed
+    // for the current frame in earlier pixel fragments
+    Uint32 fragmentOffset = 0;
+
+    // this variable keeps the current position within the current fragment
+    Uint32 byteOffset = 0;
+
+    OFBool lastStripe = OFFalse;
+    OFBool lastStripeOfColor = OFFalse;
+    Uint32 inputBytes = 0;
+
+    // pointers for buffer copy operations
+    Uint8 *outputBuffer = NULL;
+    Uint8 *pixelPointer = NULL;
+
+    // byte offset for first sample in frame
+    Uint32 sampleOffset = 0;
+
+    // byte offset between samples
+    Uint32 offsetBetweenSamples = 0;
+
+    // temporary variables
+    Uint32 sample = 0;
+    Uint32 byte = 0;
+
+    // for each stripe in stripe set
+    for (Uint32 stripeIndex = 0; (stripeIndex < numberOfStripes) && result.good(); ++stripeIndex)
+    {
+      // reset RLE codec
+      rledecoder.clear();
+
+      // adjust start point for RLE stripe, ignoring trailing garbage from the last run
+      byteOffset = rleHeader[stripeIndex + 1];
+      if (byteOffset < fragmentOffset)
+      {
+          DCMDATA_ERROR("Byte offset in RLE header is wrong.");
+          result = EC_CannotChangeRepresentation;
+      }
+      else
+      {
+        byteOffset -= fragmentOffset; // now byteOffset is correct but may point to next fragment
+        while ((byteOffset > fragmentLength) && result.good())
+        {
+          DCMDATA_DEBUG("RLE decoder processes pixel item " << currentItem);
+          Uint32 previousLength = fragmentLength;
+          result = getFragment(currentItem, endItem, rleData, fragmentLength);
+          if (result.good())
+          {
+            byteOffset -= previousLength;
+            fragmentOffset += previousLength;
+          }
+          else
+          {
+            DCMDATA_ERROR("Cannot access pixel fragment.");
+          }
+        }
+      }
+
+      // something went wrong; most likely the byte offset in the RLE header is incorrect.
+      if (result.bad()) return EC_CannotChangeRepresentation;
+
+      // byteOffset now points to the first byte of the new RLE stripe
+      // check if the current stripe is the last one for this frame
+      if (stripeIndex + 1 == numberOfStripes) lastStripe = OFTrue; else lastStripe = OFFalse;
+
+      if (lastStripe)
+      {
+        // the last stripe needs special handling because we cannot use the
+        // offset table to determine the number of bytes to feed to the codec
+        // if the RLE data is split in multiple fragments. We need to feed
+        // data fragment by fragment until the RLE codec has produced
+        // sufficient output.
+        while ((rledecoder.size() < bytesPerStripe_) && result.good())
+        {
+          // feed complete remaining content of fragment to RLE codec and
+          // switch to next fragment
+          result = rledecoder.decompress(rleData + byteOffset, OFstatic_cast(size_t, fragmentLength - byteOffset));
+
+          // special handling for zero pad byte at the end of the RLE stream
+          // which results in an EC_StreamNotifyClient return code
+          // or trailing garbage data which results in EC_CorruptedData
+          if (rledecoder.size() == bytesPerStripe_) result = EC_Normal;
+
+          // Check if we're already done. If yes, don't change fragment
+          if (result.good() || result == EC_StreamNotifyClient)
+          {
+            if (rledecoder.size() < bytesPerStripe_)
+            {
+              DCMDATA_WARN("RLE decoder is finished but has produced insufficient data for this stripe, will continue with next pixel item");
+              DCMDATA_DEBUG("RLE decoder processes pixel item " << currentItem);
+              Uint32 previousLength = fragmentLength;
+              result = getFragment(currentItem, endItem, rleData, fragmentLength);
+              if (result.good())
+              {
+                byteOffset = 0;
+                fragmentOffset += previousLength;
+              }
+            }
+            else byteOffset = fragmentLength;
+          }
+        } /* while */
+      }
+      else
+      {
+        // not the last stripe. We can use the offset table to determine
+        // the number of bytes to feed to the RLE codec.
+        inputBytes = rleHeader[stripeIndex+2];
+        if (inputBytes < rleHeader[stripeIndex + 1])
+        {
+            DCMDATA_ERROR("Byte offset in RLE header is wrong.");
+            result = EC_CannotChangeRepresentation;
+        }
+        else
+        {
+          inputBytes -= rleHeader[stripeIndex + 1]; // number of bytes to feed to codec
+          while ((inputBytes > (fragmentLength - byteOffset)) && result.good())
+          {
+            // feed complete remaining content of fragment to RLE codec and
+            // switch to next fragment
+            result = rledecoder.decompress(rleData + byteOffset, OFstatic_cast(size_t, fragmentLength - byteOffset));
+
+            Uint32 previousLength = fragmentLength;
+            if (result.good() || result == EC_StreamNotifyClient)
+            {
+              DCMDATA_DEBUG("RLE decoder processes pixel item " << currentItem);
+              result = getFragment(currentItem, endItem, rleData, fragmentLength);
+            }
+            if (result.good())
+            {
+              inputBytes -= previousLength - byteOffset;
+              byteOffset = 0;
+              fragmentOffset += previousLength;
+            }
+          } /* while */
+
+          // last fragment for this RLE stripe
+          result = rledecoder.decompress(rleData + byteOffset, OFstatic_cast(size_t, inputBytes));
+
+          // special handling for zero pad byte at the end of the RLE stream
+          // which results in an EC_StreamNotifyClient return code
+          // or trailing garbage data which results in EC_CorruptedData
+          if (rledecoder.size() == bytesPerStripe_) result = EC_Normal;
+
+          byteOffset += inputBytes;
+        }
+      }
+
+      // copy the decoded stuff over to the buffer here...
+      // make sure the RLE decoder has produced the right amount of data
+      lastStripeOfColor = lastStripe || ((imagePlanarConfiguration_ == 1) && ((stripeIndex + 1) % imageBytesAllocated_ == 0));
+
+      if (lastStripeOfColor && (rledecoder.size() < bytesPerStripe_))
+      {
+          // stripe ended prematurely? report a warning and continue
+          DCMDATA_WARN("RLE decoder is finished but has produced insufficient data for this stripe, filling remaining pixels");
+          result = EC_Normal;
+      }
+      else if (rledecoder.size() != bytesPerStripe_)
+      {
+          DCMDATA_ERROR("RLE decoder is finished but has produced insufficient data for this stripe");
+          result = EC_CannotChangeRepresentation;
+      }
+
+      // distribute decompressed bytes into output image array
+      if (result.good())
+      {
+        // which sample and byte are we currently compressing?
+        sample = stripeIndex / imageBytesAllocated_;
+        byte = stripeIndex % imageBytesAllocated_;
+
+        // raw buffer containing bytesPerStripe bytes of uncompressed data
+        outputBuffer = OFstatic_cast(Uint8 *, rledecoder.getOutputBuffer());
+
+        // compute byte offsets
+        if (imagePlanarConfiguration_ == 0)
+        {
+           sampleOffset = sample * imageBytesAllocated_;
+           offsetBetweenSamples = imageSamplesPerPixel_ * imageBytesAllocated_;
+        }
+        else
+        {
+           sampleOffset = sample * imageBytesAllocated_ * imageColumns_ * imageRows_;
+           offsetBetweenSamples = imageBytesAllocated_;
+        }
+
+        // initialize pointer to output data
+        if (enableReverseByteOrder_)
+        {
+          // assume incorrect LSB to MSB order of RLE segments as produced by some tools
+          pixelPointer = imageData8 + sampleOffset + byte;
+        }
+        else
+        {
+          pixelPointer = imageData8 + sampleOffset + imageBytesAllocated_ - byte - 1;
+        }
+
+        // distribute the bytes of the stripe to all pixels of the frame
+        scatterRLEStripe(outputBuffer, pixelPointer, bytesPerStripe_, offsetBetweenSamples);
+      }
+    } /* for */
+  }
+  return result;
+}
+
+
 DcmRLECodecDecoder::DcmRLECodecDecoder()
 : DcmCodec()
 {
@@ -86,7 +488,6 @@ OFCondition DcmRLECodecDecoder::decode(
     Uint16 imageBitsAllocated = 0;
     Uint16 imageBytesAllocated = 0;
     Uint16 imagePlanarConfiguration = 0;
-    Uint32 rleHeader[16];
     DcmItem *ditem = OFstatic_cast(DcmItem *, dataset);
     OFBool numberOfFramesPresent = OFFalse;
 
@@ -121,320 +522,73 @@ OFCondition DcmRLECodecDecoder::decode(
 
     if (result.good())
     {
-      DcmPixelItem *pixItem = NULL;
-      Uint8 * rleData = NULL;
-      const size_t bytesPerStripe = OFstatic_cast(size_t, imageColumns) * OFstatic_cast(size_t, imageRows);
+      // compute size of uncompressed frame, in bytes
+      Uint32 frameSize = imageBytesAllocated * imageRows * imageColumns * imageSamplesPerPixel;
 
-      DcmRLEDecoder rledecoder(bytesPerStripe);
-      if (rledecoder.fail()) result = EC_MemoryExhausted;  // RLE decoder failed to initialize
-      else
+      // check for overflow
+      if (imageRows != 0 && frameSize / imageRows != OFstatic_cast(Uint32, imageBytesAllocated) * imageColumns * imageSamplesPerPixel)
       {
-        // compute size of uncompressed frame, in bytes
-        Uint32 frameSize = imageBytesAllocated * imageRows * imageColumns * imageSamplesPerPixel;
+        DCMDATA_WARN("DcmRLECodecDecoder: Cannot decompress image because uncompressed representation would exceed maximum possible size of PixelData attribute");
+        return EC_ElemLengthExceeds32BitField;
+      }
 
-        // check for overflow
-        if (imageRows != 0 && frameSize / imageRows != OFstatic_cast(Uint32, imageBytesAllocated) * imageColumns * imageSamplesPerPixel)
-        {
-          DCMDATA_WARN("DcmRLECodecDecoder: Cannot decompress image because uncompressed representation would exceed maximum possible size of PixelData attribute");
-          return EC_ElemLengthExceeds32BitField;
-        }
+      Uint32 totalSize = frameSize * imageFrames;
 
-        Uint32 totalSize = frameSize * imageFrames;
+      // check for overflow
+      if (totalSize == 0xFFFFFFFF || (frameSize != 0 && totalSize / frameSize != OFstatic_cast(Uint32, imageFrames)))
+      {
+        DCMDATA_WARN("DcmRLECodecDecoder: Cannot decompress image because uncompressed representation would exceed maximum possible size of PixelData attribute");
+        return EC_ElemLengthExceeds32BitField;
+      }
 
-        // check for overflow
-        if (totalSize == 0xFFFFFFFF || (frameSize != 0 && totalSize / frameSize != OFstatic_cast(Uint32, imageFrames)))
-        {
-          DCMDATA_WARN("DcmRLECodecDecoder: Cannot decompress image because uncompressed representation would exceed maximum possible size of PixelData attribute");
-          return EC_ElemLengthExceeds32BitField;
-        }
+      if (totalSize & 1) totalSize++; // align on 16-bit word boundary
+      Uint16 *imageData16 = NULL;
+      OFVector<Uint8 *> fragmentData;
+      OFVector<Uint32> fragmentLength;
+      OFVector<Uint32> startFragments;
 
-        if (totalSize & 1) totalSize++; // align on 16-bit word boundary
-        Uint16 *imageData16 = NULL;
-        Sint32 currentFrame = 0;
-        Uint32 currentItem = 1; // ignore offset table
-        Uint32 numberOfStripes = 0;
-        Uint32 fragmentLength = 0;
+      // if the fragments of all frames can be determined in advance,
+      // the frames can be decompressed in parallel
+      Uint32 numberOfThreads = getDecompressionThreadCount(OFstatic_cast(Uint32, imageFrames));
+      if ((numberOfThreads > 1) && determineFrameFragments(OFstatic_cast(Uint32, imageFrames), pixSeq, startFragments).bad())
+      {
+        DCMDATA_DEBUG("RLE decoder cannot determine fragments of all frames in advance, decompressing frames sequentially");
+        numberOfThreads = 1;
+      }
 
-        result = uncompressedPixelData.createUint16Array(totalSize/sizeof(Uint16), imageData16);
-        if (result.good())
+      // access the content of all fragments
+      result = getFragmentData(pixSeq, fragmentData, fragmentLength);
+      if (result.good()) result = uncompressedPixelData.createUint16Array(totalSize/sizeof(Uint16), imageData16);
+      if (result.good())
+      {
+        DcmRLEFrameDecompressionTask task(fragmentData, fragmentLength, startFragments,
+          imageSamplesPerPixel, imageBytesAllocated, imageColumns, imageRows, imagePlanarConfiguration,
+          enableReverseByteOrder, OFreinterpret_cast(Uint8 *, imageData16), frameSize, numberOfThreads);
+        if (task.fail()) result = EC_MemoryExhausted;  // RLE decoder failed to initialize
+        else if (numberOfThreads > 1)
         {
-          Uint8 *imageData8 = OFreinterpret_cast(Uint8 *, imageData16);
-
-          while ((currentFrame < imageFrames) && result.good())
+          DCMDATA_DEBUG("RLE decoder processes " << imageFrames << " frames using " << numberOfThreads << " threads");
+          result = decompressFrames(task, 0, OFstatic_cast(Uint32, imageFrames), numberOfThreads);
+        }
+        else
+        {
+          Uint32 currentItem = 1; // ignore offset table
+          const Uint32 numberOfFragments = OFstatic_cast(Uint32, fragmentData.size());
+          for (Sint32 currentFrame = 0; (currentFrame < imageFrames) && result.good(); ++currentFrame)
           {
-            DCMDATA_DEBUG("RLE decoder processes frame " << currentFrame);
-            DCMDATA_DEBUG("RLE decoder processes pixel item " << currentItem);
-            // get first pixel item of this frame
-            result = pixSeq->getItem(pixItem, currentItem++);
-            if (result.good())
-            {
-              fragmentLength = pixItem->getLength();
-              result = pixItem->getUint8Array(rleData);
-              if (result.good())
-              {
-                // we require that the RLE header must be completely
-                // contained in the first fragment; otherwise bail out
-                if (fragmentLength < 64)
-                {
-                  DCMDATA_ERROR("Pixel item shorter than 64 bytes, RLE header incomplete.");
-                  result = EC_CannotChangeRepresentation;
-                }
-              }
-            }
-
-            if (result.good())
-            {
-              // copy RLE header to buffer and adjust byte order
-              memcpy(rleHeader, rleData, 64);
-              swapIfNecessary(gLocalByteOrder, EBO_LittleEndian, rleHeader, 16*OFstatic_cast(Uint32, sizeof(Uint32)), sizeof(Uint32));
-
-              // determine number of stripes.
-              numberOfStripes = rleHeader[0];
-
-              // check that number of stripes in RLE header matches our expectation
-              if ((numberOfStripes < 1) || (numberOfStripes > 15) ||
-                  (numberOfStripes != OFstatic_cast(Uint32, imageBytesAllocated) * imageSamplesPerPixel))
-              {
-                  DCMDATA_ERROR("Number of stripes in RLE header incorrect: found " << numberOfStripes << ", expected " << (OFstatic_cast(Uint32, imageBytesAllocated) * imageSamplesPerPixel));
-                  result = EC_CannotChangeRepresentation;
-              }
-            }
-
-            if (result.good())
-            {
-              // this variable keeps the number of bytes we have processed
-              // for the current frame in earlier pixel fragments
-              Uint32 fragmentOffset = 0;
-
-              // this variable keeps the current position within the current fragment
-              Uint32 byteOffset = 0;
-
-              OFBool lastStripe = OFFalse;
-              OFBool lastStripeOfColor = OFFalse;
-              Uint32 inputBytes = 0;
-
-              // pointers for buffer copy operations
-              Uint8 *outputBuffer = NULL;
-              Uint8 *pixelPointer = NULL;
-
-              // byte offset for first sample in frame
-              Uint32 sampleOffset = 0;
-
-              // byte offset between samples
-              Uint32 offsetBetweenSamples = 0;
-
-              // temporary variables
-              Uint32 sample = 0;
-              Uint32 byte = 0;
-              Uint32 pixel = 0;
-
-              // for each stripe in stripe set
-              for (Uint32 stripeIndex = 0; (stripeIndex < numberOfStripes) && result.good(); ++stripeIndex)
-              {
-                // reset RLE codec
-                rledecoder.clear();
-
-                // adjust start point for RLE stripe, ignoring trailing garbage from the last run
-                byteOffset = rleHeader[stripeIndex + 1];
-                if (byteOffset < fragmentOffset)
-                {
-                    DCMDATA_ERROR("Byte offset in RLE header is wrong.");
-                    result = EC_CannotChangeRepresentation;
-                }
-                else
-                {
-                  byteOffset -= fragmentOffset; // now byteOffset is correct but may point to next fragment
-                  while ((byteOffset > fragmentLength) && result.good())
-                  {
-                    DCMDATA_DEBUG("RLE decoder processes pixel item " << currentItem);
-                    result = pixSeq->getItem(pixItem, currentItem++);
-                    if (result.good())
-                    {
-                      byteOffset -= fragmentLength;
-                      fragmentOffset += fragmentLength;
-                      fragmentLength = pixItem->getLength();
-                      result = pixItem->getUint8Array(rleData);
-                      if (result.bad())
-                      {
-                        DCMDATA_ERROR("Cannot access pixel fragment.");
-                      }
-                    }
-                    else
-                    {
-                      DCMDATA_ERROR("Cannot access pixel fragment.");
-                    }
-                  }
-                }
-
-                // something went wrong; most likely the byte offset in the RLE header is incorrect.
-                if (result.bad()) return EC_CannotChangeRepresentation;
-
-                // byteOffset now points to the first byte of the new RLE stripe
-                // check if the current stripe is the last one for this frame
-                if (stripeIndex + 1 == numberOfStripes) lastStripe = OFTrue; else lastStripe = OFFalse;
-
-                if (lastStripe)
-                {
-                  // the last stripe needs special handling because we cannot use the
-                  // offset table to determine the number of bytes to feed to the codec
-                  // if the RLE data is split in multiple fragments. We need to feed
-                  // data fragment by fragment until the RLE codec has produced
-                  // sufficient output.
-                  while ((rledecoder.size() < bytesPerStripe) && result.good())
-                  {
-                    // feed complete remaining content of fragment to RLE codec and
-                    // switch to next fragment
-                    result = rledecoder.decompress(rleData + byteOffset, OFstatic_cast(size_t, fragmentLength - byteOffset));
-
-                    // special handling for zero pad byte at the end of the RLE stream
-                    // which results in an EC_StreamNotifyClient return code
-                    // or trailing garbage data which results in EC_CorruptedData
-                    if (rledecoder.size() == bytesPerStripe) result = EC_Normal;
-
-                    // Check if we're already done. If yes, don't change fragment
-                    if (result.good() || result == EC_StreamNotifyClient)
-                    {
-                      if (rledecoder.size() < bytesPerStripe)
-                      {
-                        DCMDATA_WARN("RLE decoder is finished but has produced insufficient data for this stripe, will continue with next pixel item");
-                        DCMDATA_DEBUG("RLE decoder processes pixel item " << currentItem);
-                        result = pixSeq->getItem(pixItem, currentItem++);
-                        if (result.good())
-                        {
-                          byteOffset = 0;
-                          fragmentOffset += fragmentLength;
-                          fragmentLength = pixItem->getLength();
-                          result = pixItem->getUint8Array(rleData);
-                        }
-                      }
-                      else byteOffset = fragmentLength;
-                    }
-                  } /* while */
-                }
-                else
-                {
-                  // not the last stripe. We can use the offset table to determine
-                  // the number of bytes to feed to the RLE codec.
-                  inputBytes = rleHeader[stripeIndex+2];
-                  if (inputBytes < rleHeader[stripeIndex + 1])
-                  {
-                      DCMDATA_ERROR("Byte offset in RLE header is wrong.");
-                      result = EC_CannotChangeRepresentation;
-                  }
-                  else
-                  {
-                    inputBytes -= rleHeader[stripeIndex + 1]; // number of bytes to feed to codec
-                    while ((inputBytes > (fragmentLength - byteOffset)) && result.good())
-                    {
-                      // feed complete remaining content of fragment to RLE codec and
-                      // switch to next fragment
-                      result = rledecoder.decompress(rleData + byteOffset, OFstatic_cast(size_t, fragmentLength - byteOffset));
-
-                      if (result.good() || result == EC_StreamNotifyClient)
-                      {
-                        DCMDATA_DEBUG("RLE decoder processes pixel item " << currentItem);
-                        result = pixSeq->getItem(pixItem, currentItem++);
-                      }
-                      if (result.good())
-                      {
-                        inputBytes -= fragmentLength - byteOffset;
-                        byteOffset = 0;
-                        fragmentOffset += fragmentLength;
-                        fragmentLength = pixItem->getLength();
-                        result = pixItem->getUint8Array(rleData);
-                      }
-                    } /* while */
-
-                    // last fragment for this RLE stripe
-                    result = rledecoder.decompress(rleData + byteOffset, OFstatic_cast(size_t, inputBytes));
-
-                    // special handling for zero pad byte at the end of the RLE stream
-                    // which results in an EC_StreamNotifyClient return code
-                    // or trailing garbage data which results in EC_CorruptedData
-                    if (rledecoder.size() == bytesPerStripe) result = EC_Normal;
-
-                    byteOffset += inputBytes;
-                  }
-                }
-
-                // copy the decoded stuff over to the buffer here...
-                // make sure the RLE decoder has produced the right amount of data
-                lastStripeOfColor = lastStripe || ((imagePlanarConfiguration == 1) && ((stripeIndex + 1) % imageBytesAllocated == 0));
-
-                if (lastStripeOfColor && (rledecoder.size() < bytesPerStripe))
-                {
-                    // stripe ended prematurely? report a warning and continue
-                    DCMDATA_WARN("RLE decoder is finished but has produced insufficient data for this stripe, filling remaining pixels");
-                    result = EC_Normal;
-                }
-                else if (rledecoder.size() != bytesPerStripe)
-                {
-                    DCMDATA_ERROR("RLE decoder is finished but has produced insufficient data for this stripe");
-                    result = EC_CannotChangeRepresentation;
-                }
-
-                // distribute decompressed bytes into output image array
-                if (result.good())
-                {
-                  // which sample and byte are we currently compressing?
-                  sample = stripeIndex / imageBytesAllocated;
-                  byte = stripeIndex % imageBytesAllocated;
-
-                  // raw buffer containing bytesPerStripe bytes of uncompressed data
-                  outputBuffer = OFstatic_cast(Uint8 *, rledecoder.getOutputBuffer());
-
-                  // compute byte offsets
-                  if (imagePlanarConfiguration == 0)
-                  {
-                     sampleOffset = sample * imageBytesAllocated;
-                     offsetBetweenSamples = imageSamplesPerPixel * imageBytesAllocated;
-                  }
-                  else
-                  {
-                     sampleOffset = sample * imageBytesAllocated * imageColumns * imageRows;
-                     offsetBetweenSamples = imageBytesAllocated;
-                  }
-
-                  // initialize pointer to output data
-                  if (enableReverseByteOrder)
-                  {
-                    // assume incorrect LSB to MSB order of RLE segments as produced by some tools
-                    pixelPointer = imageData8 + sampleOffset + byte;
-                  }
-                  else
-                  {
-                    pixelPointer = imageData8 + sampleOffset + imageBytesAllocated - byte - 1;
-                  }
-
-                  // loop through all pixels of the frame
-                  for (pixel = 0; pixel < bytesPerStripe; ++pixel)
-                  {
-                    *pixelPointer = *outputBuffer++;
-                    pixelPointer += offsetBetweenSamples;
-                  }
-                }
-              } /* for */
-            }
-
-            // advance by one frame
-            if (result.good())
-            {
-              currentFrame++;
-              imageData8 += frameSize;
-            }
-
-          } /* while still frames to process */
+            result = task.decompressFrameAt(OFstatic_cast(Uint32, currentFrame), 0, currentItem, numberOfFragments);
+          }
+        }
 
-          // adjust byte order for uncompressed image to little endian
-          swapIfNecessary(EBO_LittleEndian, gLocalByteOrder, imageData16, OFstatic_cast(Uint32, totalSize), sizeof(Uint16));
+        // adjust byte order for uncompressed image to little endian
+        swapIfNecessary(EBO_LittleEndian, gLocalByteOrder, imageData16, OFstatic_cast(Uint32, totalSize), sizeof(Uint16));
 
-          // Number of Frames might have changed in case the previous value was wrong
-          if (result.good() && (numberOfFramesPresent || (imageFrames > 1)))
-          {
-            char numBuf[20];
-            sprintf(numBuf, "%ld", OFstatic_cast(long, imageFrames));
-            result = OFstatic_cast(DcmItem *, dataset)->putAndInsertString(DCM_NumberOfFrames, numBuf);
-          }
+        // Number of Frames might have changed in case the previous value was wrong
+        if (result.good() && (numberOfFramesPresent || (imageFrames > 1)))
+        {
+          char numBuf[20];
+          sprintf(numBuf, "%ld", OFstatic_cast(long, imageFrames));
+          result = OFstatic_cast(DcmItem *, dataset)->putAndInsertString(DCM_NumberOfFrames, numBuf);
         }
       }
     }
@@ -691,11 +845,9 @@ OFCondition DcmRLECodecDecoder::decodeFrame(
 
         // copy the pixel data that was decoded
         const size_t decoderSize = rledecoder.size();
-        for (pixel = 0; pixel < decoderSize; ++pixel)
-        {
-            *pixelPointer = *outputBuffer++;
-            pixelPointer += offsetBetweenSamples;
-        }
+        scatterRLEStripe(outputBuffer, pixelPointer, decoderSize, offsetBetweenSamples);
+        outputBuffer += decoderSize;
+        pixelPointer += decoderSize * offsetBetweenSamples;
         // and fill the remainder of the image with copies of the last decoded pixel
         const Uint8 lastPixelValue = *(outputBuffer - 1);
         for (pixel = OFstatic_cast(Uint32, decoderSize); pixel < bytesPerStripe; ++pixel)
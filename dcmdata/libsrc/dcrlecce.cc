@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2021, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -35,6 +35,287 @@ typedef OFList<DcmRLEEncoder *> DcmRLEEncoderList;
 typedef OFListIterator(DcmRLEEncoder *) DcmRLEEncoderListIterator;
 
 
+/** collects the bytes of one RLE stripe from the image buffer.
+ *  This is the counterpart of the stripe distribution in the RLE decoder:
+ *  the common sample distances are handled by separate loops with a constant
+ *  stride, which the compiler can unroll and vectorize.
+ *  @param src first byte of the stripe in the image buffer
+ *  @param dst destination buffer of at least count bytes
+ *  @param count number of bytes to collect
+ *  @param stride distance between two consecutive bytes in src
+ */
+static void gatherRLEStripe(const Uint8 *src, Uint8 *dst, size_t count, size_t stride)
+{
+  size_t i;
+  switch (stride)
+  {
+    case 1:
+      memcpy(dst, src, count);
+      break;
+    case 2:
+      for (i = 0; i < count; ++i) dst[i] = src[2 * i];
+      break;
+    case 3:
+      for (i = 0; i < count; ++i) dst[i] = src[3 * i];
+      break;
+    case 4:
+      for (i = 0; i < count; ++i) dst[i] = src[4 * i];
+      break;
+    case 6:
+      for (i = 0; i < count; ++i) dst[i] = src[6 * i];
+      break;
+    default:
+      for (i = 0; i < count; ++i) dst[i] = src[stride * i];
+      break;
+  }
+}
+
+/** helper class that compresses the frames of a multi-frame image
+ *  with RLE, possibly in parallel, see DcmCodec::compressFrames()
+ */
+class DcmRLEFrameCompressionTask: public DcmFrameCompressionTask
+{
+public:
+  /** constructor
+   *  @param pixelData pointer to the uncompressed pixel data in little endian byte order
+   *  @param columns number of columns
+   *  @param rows number of rows
+   *  @param samplesPerPixel number of samples per pixel
+   *  @param bytesAllocated number of bytes allocated per sample
+   *  @param planarConfiguration planar configuration of the uncompressed pixel data
+   *  @param numberOfFrames number of frames
+   *  @param pixelSequence pixel sequence in which the compressed frames are stored
+   *  @param offsetList offset list updated for each compressed frame
+   *  @param fragmentSize maximum fragment size (in kbytes), 0 for unlimited
+   */
+  DcmRLEFrameCompressionTask(
+    const Uint8 *pixelData,
+    Uint16 columns,
+    Uint16 rows,
+    Uint16 samplesPerPixel,
+    Uint16 bytesAllocated,
+    Uint16 planarConfiguration,
+    Uint32 numberOfFrames,
+    DcmPixelSequence *pixelSequence,
+    DcmOffsetList& offsetList,
+    Uint32 fragmentSize)
+  : DcmFrameCompressionTask()
+  , pixelData_(pixelData)
+  , columns_(columns)
+  , rows_(rows)
+  , samplesPerPixel_(samplesPerPixel)
+  , bytesAllocated_(bytesAllocated)
+  , planarConfiguration_(planarConfiguration)
+  , pixelSequence_(pixelSequence)
+  , offsetList_(offsetList)
+  , fragmentSize_(fragmentSize)
+  , rleData_(numberOfFrames, OFstatic_cast(Uint8 *, NULL))
+  , rleSize_(numberOfFrames, 0)
+  , compressedSize_(0)
+  {
+  }
+
+  /// destructor, frees all compressed frames that have not been stored
+  virtual ~DcmRLEFrameCompressionTask()
+  {
+    for (size_t i = 0; i < rleData_.size(); ++i) delete[] rleData_[i];
+  }
+
+  /** compresses a single frame into an RLE stripe set with header
+   *  @param frameNo number of the frame
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  virtual OFCondition compressFrame(Uint32 frameNo, Uint32 /* threadNo */)
+  {
+    OFCondition result = EC_Normal;
+    DcmRLEEncoderList rleEncoderList;
+    DcmRLEEncoderListIterator first = rleEncoderList.begin();
+    DcmRLEEncoderListIterator last = rleEncoderList.end();
+    const Uint32 frameSize = columns_ * rows_ * samplesPerPixel_ * bytesAllocated_;
+    Uint32 rleHeader[16];
+    Uint32 i;
+
+    // offset to start of frame, in bytes
+    const Uint32 frameOffset = frameSize * frameNo;
+
+    // compute byte offset between samples
+    Uint32 offsetBetweenSamples = 0;
+    if (planarConfiguration_ == 0)
+       offsetBetweenSamples = samplesPerPixel_ * bytesAllocated_;
+       else offsetBetweenSamples = bytesAllocated_;
+
+    // buffer for the bytes of one row of a stripe
+    OFVector<Uint8> rowBuffer(columns_);
+
+    // loop through all samples of one frame
+    for (Uint32 sample = 0; sample < samplesPerPixel_; sample++)
+    {
+      // compute byte offset for first sample in frame
+      Uint32 sampleOffset = 0;
+      if (planarConfiguration_ == 0)
+         sampleOffset = sample * bytesAllocated_;
+         else sampleOffset = sample * bytesAllocated_ * columns_ * rows_;
+
+      // loop through the bytes of one sample
+      for (Uint32 byte = 0; byte < bytesAllocated_; byte++)
+      {
+        const Uint8 *pixelPointer = pixelData_ + frameOffset + sampleOffset + bytesAllocated_ - byte - 1;
+
+        // initialize new RLE codec for this stripe
+        DcmRLEEncoder *rleEncoder = new DcmRLEEncoder(1 /* DICOM padding required */);
+        if (rleEncoder)
+        {
+          rleEncoderList.push_back(rleEncoder);
+
+          // loop through all rows of the frame
+          for (Uint32 row = 0; row < rows_; ++row)
+          {
+            // collect the bytes of this row, unless they are already contiguous
+            if (offsetBetweenSamples == 1)
+              rleEncoder->add(pixelPointer, columns_);
+            else
+            {
+              gatherRLEStripe(pixelPointer, &rowBuffer[0], columns_, offsetBetweenSamples);
+              rleEncoder->add(&rowBuffer[0], columns_);
+            }
+
+            // enforce DICOM rule that "Each row of the image shall be encoded
+            // separately and not cross a row boundary."
+            // (see DICOM part 5 section G.3.1)
+            rleEncoder->flush();
+            pixelPointer += OFstatic_cast(size_t, columns_) * offsetBetweenSamples;
+          }
+
+          rleEncoder->flush();
+          if (rleEncoder->fail()) result = EC_MemoryExhausted;
+        } else result = EC_MemoryExhausted;
+      }
+    }
+
+    // create compressed frame and erase RLE codec list
+    if (result.good() && (rleEncoderList.size() > 0) && (rleEncoderList.size() < 16))
+    {
+      // compute size of compressed frame including RLE header
+      // and populate RLE header
+      for (i=0; i<16; i++) rleHeader[i] = 0;
+      rleHeader[0] = OFstatic_cast(Uint32, rleEncoderList.size());
+      Uint32 rleSize = 64;
+      i = 1;
+      first = rleEncoderList.begin();
+      while (first != last)
+      {
+        rleHeader[i++] = rleSize;
+        rleSize += OFstatic_cast(Uint32, (*first)->size());
+        ++first;
+      }
+
+      // allocate buffer for compressed frame
+      Uint8 *rleData = new Uint8[rleSize];
+
+      if (rleData)
+      {
+        // copy RLE header to compressed frame buffer
+        swapIfNecessary(EBO_LittleEndian, gLocalByteOrder, rleHeader, OFstatic_cast(Uint32, 16*sizeof(Uint32)), sizeof(Uint32));
+        memcpy(rleData, rleHeader, 64);
+
+        // store RLE stripe sets in compressed frame buffer
+        Uint8 *rleData2 = rleData + 64;
+        first = rleEncoderList.begin();
+        while (first != last)
+        {
+          (*first)->write(rleData2);
+          rleData2 += (*first)->size();
+          delete *first;
+          first = rleEncoderList.erase(first);
+        }
+
+        // keep compressed frame until it is stored
+        rleData_[frameNo] = rleData;
+        rleSize_[frameNo] = rleSize;
+      } else result = EC_MemoryExhausted;
+    }
+    else if (result.good()) result = EC_CannotChangeRepresentation;
+
+    // erase RLE codec list
+    first = rleEncoderList.begin();
+    while (first != last)
+    {
+      delete *first;
+      first = rleEncoderList.erase(first);
+    }
+    return result;
+  }
+
+  /** stores a compressed frame in the pixel sequence, breaking
+   *  it into segments if necessary
+   *  @param frameNo number of the frame
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  virtual OFCondition storeFrame(Uint32 frameNo)
+  {
+    OFCondition result = pixelSequence_->storeCompressedFrame(offsetList_, rleData_[frameNo], rleSize_[frameNo], fragmentSize_);
+    if (result.good()) compressedSize_ += rleSize_[frameNo];
+
+    // erase buffer for compressed frame
+    delete[] rleData_[frameNo];
+    rleData_[frameNo] = NULL;
+    return result;
+  }
+
+  /** returns the total size of all compressed frames stored so far
+   *  @return compressed size in bytes
+   */
+  Uint32 getCompressedSize() const
+  {
+    return compressedSize_;
+  }
+
+private:
+
+  /// private undefined copy constructor
+  DcmRLEFrameCompressionTask(const DcmRLEFrameCompressionTask&);
+
+  /// private undefined copy assignment operator
+  DcmRLEFrameCompressionTask& operator=(const DcmRLEFrameCompressionTask&);
+
+  /// pointer to the uncompressed pixel data
+  const Uint8 *pixelData_;
+
+  /// number of columns
+  Uint16 columns_;
+
+  /// number of rows
+  Uint16 rows_;
+
+  /// number of samples per pixel
+  Uint16 samplesPerPixel_;
+
+  /// number of bytes allocated per sample
+  Uint16 bytesAllocated_;
+
+  /// planar configuration of the uncompressed pixel data
+  Uint16 planarConfiguration_;
+
+  /// pixel sequence in which the compressed frames are stored
+  DcmPixelSequence *pixelSequence_;
+
+  /// offset list updated for each compressed frame
+  DcmOffsetList& offsetList_;
+
+  /// maximum fragment size (in kbytes), 0 for unlimited
+  Uint32 fragmentSize_;
+
+  /// compressed frames that have not been stored yet
+  OFVector<Uint8 *> rleData_;
+
+  /// size of the compressed frames that have not been stored yet
+  OFVector<Uint32> rleSize_;
+
+  /// total size of all compressed frames stored so far
+  Uint32 compressedSize_;
+};
+
+
 // =======================================================================
 
 DcmRLECodecEncoder::DcmRLECodecEncoder()
@@ -122,14 +403,8 @@ OFCondition DcmRLECodecEncoder::encode(
   DcmStack localStack(objStack);
   (void)localStack.pop();             // pop pixel data element from stack
   DcmObject *dataset = localStack.pop(); // this is the item in which the pixel data is located
-  Uint8 *pixelData8 = OFreinterpret_cast(Uint8 *, OFconst_cast(Uint16 *, pixelData));
-  Uint8 *pixelPointer = NULL;
+  const Uint8 *pixelData8 = OFreinterpret_cast(const Uint8 *, pixelData);
   DcmOffsetList offsetList;
-  DcmRLEEncoderList rleEncoderList;
-  DcmRLEEncoderListIterator first = rleEncoderList.begin();
-  DcmRLEEncoderListIterator last = rleEncoderList.end();
-  Uint32 rleHeader[16];
-  Uint32 i;
   OFBool byteSwapped = OFFalse;  // true if we have byte-swapped the original pixel data
 
   if ((!dataset)||((dataset->ident()!= EVR_dataset) && (dataset->ident()!= EVR_item))) result = EC_InvalidTag;
@@ -204,137 +479,15 @@ OFCondition DcmRLECodecEncoder::encode(
     // create RLE stripe sets
     if (result.good())
     {
-      const Uint32 bytesPerStripe = columns * rows;
-      const Uint32 frameSize = columns * rows * samplesPerPixel * bytesAllocated;
-      Uint32 frameOffset = 0;
-      Uint32 sampleOffset = 0;
-      Uint32 offsetBetweenSamples = 0;
-      Uint32 sample = 0;
-      Uint32 byte = 0;
-      Uint32 pixel = 0;
-      Uint32 columnCounter = 0;
-
-      DcmRLEEncoder *rleEncoder = NULL;
-      Uint32 rleSize = 0;
-      Uint8 *rleData = NULL;
-      Uint8 *rleData2 = NULL;
-
       // warn about (possibly) non-standard fragmentation
       if (djcp->getFragmentSize() > 0)
          DCMDATA_WARN("DcmRLECodecEncoder: limiting the fragment size may result in non-standard conformant encoding");
 
-      // compute byte offset between samples
-      if (planarConfiguration == 0)
-         offsetBetweenSamples = samplesPerPixel * bytesAllocated;
-         else offsetBetweenSamples = bytesAllocated;
-
-      // loop through all frames of the image
-      for (Uint32 currentFrame = 0; ((currentFrame < OFstatic_cast(Uint32, numberOfFrames)) && result.good()); currentFrame++)
-      {
-        // offset to start of frame, in bytes
-        frameOffset = frameSize * currentFrame;
-
-        // loop through all samples of one frame
-        for (sample = 0; sample < samplesPerPixel; sample++)
-        {
-          // compute byte offset for first sample in frame
-          if (planarConfiguration == 0)
-             sampleOffset = sample * bytesAllocated;
-             else sampleOffset = sample * bytesAllocated * columns * rows;
-
-          // loop through the bytes of one sample
-          for (byte = 0; byte < bytesAllocated; byte++)
-          {
-            pixelPointer = pixelData8 + frameOffset + sampleOffset + bytesAllocated - byte - 1;
-
-            // initialize new RLE codec for this stripe
-            rleEncoder = new DcmRLEEncoder(1 /* DICOM padding required */);
-            if (rleEncoder)
-            {
-              rleEncoderList.push_back(rleEncoder);
-              columnCounter = columns;
-
-              // loop through all pixels of the frame
-              for (pixel = 0; pixel < bytesPerStripe; ++pixel)
-              {
-                rleEncoder->add(*pixelPointer);
-
-                // enforce DICOM rule that "Each row of the image shall be encoded
-                // separately and not cross a row boundary."
-                // (see DICOM part 5 section G.3.1)
-                if (--columnCounter == 0)
-                {
-                  rleEncoder->flush();
-                  columnCounter = columns;
-                }
-                pixelPointer += offsetBetweenSamples;
-              }
-
-              rleEncoder->flush();
-              if (rleEncoder->fail()) result = EC_MemoryExhausted;
-            } else result = EC_MemoryExhausted;
-          }
-        }
-
-        // store frame and erase RLE codec list
-        if (result.good() && (rleEncoderList.size() > 0) && (rleEncoderList.size() < 16))
-        {
-          // compute size of compressed frame including RLE header
-          // and populate RLE header
-          for (i=0; i<16; i++) rleHeader[i] = 0;
-          rleHeader[0] = OFstatic_cast(Uint32, rleEncoderList.size());
-          rleSize = 64;
-          i = 1;
-          first = rleEncoderList.begin();
-          while (first != last)
-          {
-            rleHeader[i++] = rleSize;
-            rleSize += OFstatic_cast(Uint32, (*first)->size());
-            ++first;
-          }
-
-          // allocate buffer for compressed frame
-          rleData = new Uint8[rleSize];
-
-          if (rleData)
-          {
-            // copy RLE header to compressed frame buffer
-            swapIfNecessary(EBO_LittleEndian, gLocalByteOrder, rleHeader, OFstatic_cast(Uint32, 16*sizeof(Uint32)), sizeof(Uint32));
-            memcpy(rleData, rleHeader, 64);
-
-            // store RLE stripe sets in compressed frame buffer
-            rleData2 = rleData + 64;
-            first = rleEncoderList.begin();
-            while (first != last)
-            {
-              (*first)->write(rleData2);
-              rleData2 += (*first)->size();
-              delete *first;
-              first = rleEncoderList.erase(first);
-            }
-
-            // store compressed frame, breaking into segments if necessary
-            result = pixelSequence->storeCompressedFrame(offsetList, rleData, rleSize, djcp->getFragmentSize());
-            compressedSize += rleSize;
-
-            // erase buffer for compressed frame
-            delete[] rleData;
-          } else result = EC_MemoryExhausted;
-        }
-        else
-        {
-          // erase RLE codec list
-          first = rleEncoderList.begin();
-          while (first != last)
-          {
-            delete *first;
-            first = rleEncoderList.erase(first);
-          }
-          if (result.good()) result = EC_CannotChangeRepresentation;
-        }
-
-      }
-
+      // compress all frames of the image, possibly in parallel
+      DcmRLEFrameCompressionTask task(pixelData8, columns, rows, samplesPerPixel, bytesAllocated,
+        planarConfiguration, OFstatic_cast(Uint32, numberOfFrames), pixelSequence, offsetList, djcp->getFragmentSize());
+      result = DcmCodec::compressFrames(task, OFstatic_cast(Uint32, numberOfFrames), djcp->getNumberOfThreads());
+      compressedSize = task.getCompressedSize();
     }
 
     // store pixel sequence if everything went well.
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2023, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -44,7 +44,8 @@ DcmSequenceOfItems::DcmSequenceOfItems(const DcmTag &tag)
   itemList(new DcmList),
   lastItemComplete(OFTrue),
   fStartPosition(0),
-  readAsUN_(OFFalse)
+  readAsUN_(OFFalse),
+  itemReadSelection(NULL)
 {
 }
 
@@ -60,7 +61,8 @@ DcmSequenceOfItems::DcmSequenceOfItems(
   itemList(new DcmList),
   lastItemComplete(OFTrue),
   fStartPosition(0),
-  readAsUN_(readAsUN)
+  readAsUN_(readAsUN),
+  itemReadSelection(NULL)
 {
 }
 
@@ -73,7 +75,8 @@ DcmSequenceOfItems::DcmSequenceOfItems(const DcmSequenceOfItems &old)
     itemList(new DcmList),
     lastItemComplete(old.lastItemComplete),
     fStartPosition(old.fStartPosition),
-    readAsUN_(old.readAsUN_)
+    readAsUN_(old.readAsUN_),
+    itemReadSelection(NULL)
 {
     if (!old.itemList->empty())
     {
@@ -545,6 +548,7 @@ OFCondition DcmSequenceOfItems::makeSubObject(DcmObject *&subObject,
 {
     OFCondition l_error = EC_Normal;
     DcmItem *subItem = NULL;
+    DcmMemoryArena *arena = getMemoryArena();
 
     switch (newTag.getEVR())
     {
@@ -552,9 +556,9 @@ OFCondition DcmSequenceOfItems::makeSubObject(DcmObject *&subObject,
             if (newTag == DCM_Item)
             {
                 if (getTag() == DCM_DirectoryRecordSequence)
-                    subItem = new DcmDirectoryRecord(newTag, newLength);
+                    subItem = new (arena) DcmDirectoryRecord(newTag, newLength);
                 else
-                    subItem = new DcmItem(newTag, newLength);
+                    subItem = new (arena) DcmItem(newTag, newLength);
             }
             else if (newTag == DCM_SequenceDelimitationItem)
                 l_error = EC_SequEnd;
@@ -565,7 +569,7 @@ OFCondition DcmSequenceOfItems::makeSubObject(DcmObject *&subObject,
             break;
 
         default:
-            subItem = new DcmItem(newTag, newLength);
+            subItem = new (arena) DcmItem(newTag, newLength);
             l_error = EC_CorruptedData;
             break;
     }
@@ -625,6 +629,26 @@ OFCondition DcmSequenceOfItems::readTagAndLength(DcmInputStream &inStream,
 // ********************************
 
 
+void DcmSequenceOfItems::setItemReadSelection(const DcmTagSelection *selection)
+{
+    itemReadSelection = selection;
+    /* also clear the selection of the items read so far */
+    if ((selection == NULL) && !itemList->empty())
+    {
+        itemList->seek(ELP_first);
+        do
+        {
+            DcmObject *dO = itemList->get();
+            if ((dO != NULL) && (dO->ident() == EVR_item))
+                OFstatic_cast(DcmItem *, dO)->setReadSelection(NULL);
+        } while (itemList->seek(ELP_next));
+    }
+}
+
+
+// ********************************
+
+
 OFCondition DcmSequenceOfItems::readSubItem(DcmInputStream &inStream,
                                             const DcmTag &newTag,
                                             const Uint32 newLength,
@@ -639,11 +663,15 @@ OFCondition DcmSequenceOfItems::readSubItem(DcmInputStream &inStream,
     if (l_error.good() && (subObject != NULL))
     {
         // inStream.UnsetPutbackMark(); // not needed anymore with new stream architecture
+        itemList->setMemoryArena(getMemoryArena());
         itemList->insert(subObject, ELP_next);
         // dump some information if required
         DCMDATA_TRACE("DcmSequenceOfItems::readSubItem() Sub Item " << newTag << " inserted");
         // remember the parent (i.e. the surrounding sequence)
         subObject->setParent(this);
+        // only read the selected attributes from the item (if any)
+        if ((itemReadSelection != NULL) && (subObject->ident() == EVR_item))
+            OFstatic_cast(DcmItem *, subObject)->setReadSelection(itemReadSelection);
         // read sub-item
         l_error = subObject->read(inStream, xfer, glenc, maxReadLength);
         // prevent subObject from getting deleted
@@ -0,0 +1,575 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: Implementation of classes DcmParserHandler and DcmStreamParser
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmdata/dcsparse.h"   /* for class DcmStreamParser */
+#include "dcmtk/dcmdata/dcitem.h"     /* for class DcmItem */
+#include "dcmtk/dcmdata/dcistrma.h"   /* for class DcmInputStream */
+#include "dcmtk/dcmdata/dcistrmf.h"   /* for class DcmInputFileStream */
+#include "dcmtk/dcmdata/dcdeftag.h"   /* for tag constants */
+#include "dcmtk/dcmdata/dcmetinf.h"   /* for DCM_Magic, DCM_PreambleLen */
+
+/* default maximum number of bytes passed to the handler at once */
+#define DCM_StreamParserChunkSize 65536
+
+
+/** helper class that provides access to the tag and length parsing code of
+ *  class DcmItem and to the private creator cache of a dataset or item.
+ *  One instance is used per nesting level.
+ */
+class DcmStreamParserItem: public DcmItem
+{
+public:
+
+  /// constructor. Undefined length disables the item length check in readTagAndLength().
+  DcmStreamParserItem()
+  : DcmItem(DCM_ItemTag, DCM_UndefinedLength)
+  {
+  }
+
+  /** reads tag and length of the next data element
+   *  @param inStream stream from which the data is read
+   *  @param xfer transfer syntax of the data
+   *  @param tag tag that was read, returned in this parameter
+   *  @param length length that was read, returned in this parameter
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition readHeader(DcmInputStream& inStream,
+                         const E_TransferSyntax xfer,
+                         DcmTag& tag,
+                         Uint32& length)
+  {
+    Uint32 bytesRead = 0;
+    return readTagAndLength(inStream, xfer, tag, length, bytesRead);
+  }
+
+  /** determines the transfer syntax of the dataset in the given stream
+   *  @param inStream stream from which the data is read
+   *  @return transfer syntax that was determined
+   */
+  E_TransferSyntax detectTransferSyntax(DcmInputStream& inStream)
+  {
+    return checkTransferSyntax(inStream);
+  }
+
+  /** adds a private creator to the cache of this nesting level
+   *  @param tag tag of the private creator element
+   *  @param privateCreator private creator identifier
+   */
+  void updatePrivateCreators(const DcmTagKey& tag,
+                             const char *privateCreator)
+  {
+    addPrivateCreator(tag, privateCreator);
+  }
+};
+
+
+/* ---------------------------------------------------------------------- */
+
+
+DcmParserHandler::~DcmParserHandler()
+{
+}
+
+
+OFCondition DcmParserHandler::startDataset(const E_TransferSyntax /* xfer */)
+{
+  return EC_Normal;
+}
+
+
+OFCondition DcmParserHandler::endDataset()
+{
+  return EC_Normal;
+}
+
+
+OFCondition DcmParserHandler::elementHeader(const DcmTag& /* tag */,
+                                            const Uint32 /* length */,
+                                            OFBool& /* readValue */)
+{
+  return EC_Normal;
+}
+
+
+OFCondition DcmParserHandler::elementValue(const DcmTag& /* tag */,
+                                           const Uint8 * /* data */,
+                                           const Uint32 /* length */,
+                                           const Uint32 /* offset */)
+{
+  return EC_Normal;
+}
+
+
+OFCondition DcmParserHandler::startSequence(const DcmTag& /* tag */,
+                                            const Uint32 /* length */)
+{
+  return EC_Normal;
+}
+
+
+OFCondition DcmParserHandler::endSequence(const DcmTag& /* tag */)
+{
+  return EC_Normal;
+}
+
+
+OFCondition DcmParserHandler::startItem(const Uint32 /* length */)
+{
+  return EC_Normal;
+}
+
+
+OFCondition DcmParserHandler::endItem()
+{
+  return EC_Normal;
+}
+
+
+OFCondition DcmParserHandler::startPixelSequence(const DcmTag& /* tag */)
+{
+  return EC_Normal;
+}
+
+
+OFCondition DcmParserHandler::pixelFragment(const Uint32 /* fragment */,
+                                            const Uint8 * /* data */,
+                                            const Uint32 /* length */,
+                                            const Uint32 /* offset */,
+                                            const Uint32 /* fragmentLength */)
+{
+  return EC_Normal;
+}
+
+
+OFCondition DcmParserHandler::endPixelSequence()
+{
+  return EC_Normal;
+}
+
+
+/* ---------------------------------------------------------------------- */
+
+
+DcmStreamParser::DcmStreamParser(DcmParserHandler& handler)
+: handler_(handler)
+, chunkSize_(DCM_StreamParserChunkSize)
+, buffer_()
+{
+}
+
+
+DcmStreamParser::~DcmStreamParser()
+{
+}
+
+
+void DcmStreamParser::setChunkSize(const Uint32 chunkSize)
+{
+  if (chunkSize > 0)
+  {
+    chunkSize_ = chunkSize;
+    buffer_.clear();
+  }
+}
+
+
+OFCondition DcmStreamParser::parseFile(const OFFilename& fileName,
+                                       const E_TransferSyntax readXfer)
+{
+  if (fileName.isEmpty()) return EC_InvalidFilename;
+  DcmInputFileStream fileStream(fileName);
+  OFCondition result = fileStream.status();
+  if (result.good())
+    result = parseFileFormat(fileStream, readXfer);
+  return result;
+}
+
+
+OFCondition DcmStreamParser::parseFileFormat(DcmInputStream& inStream,
+                                             const E_TransferSyntax readXfer)
+{
+  OFCondition result = inStream.status();
+  if (result.bad()) return result;
+
+  /* check for the preamble and the DICOM prefix */
+  OFBool hasMetaHeader = OFFalse;
+  if (inStream.avail() >= DCM_PreambleLen + DCM_MagicLen)
+  {
+    char preamble[DCM_PreambleLen + DCM_MagicLen];
+    inStream.mark();
+    inStream.read(preamble, DCM_PreambleLen + DCM_MagicLen);
+    if (strncmp(preamble + DCM_PreambleLen, DCM_Magic, DCM_MagicLen) == 0)
+      hasMetaHeader = OFTrue;
+    else
+      inStream.putback();
+  }
+  if (!hasMetaHeader)
+    return parseDataset(inStream, readXfer);
+
+  /* parse the file meta information, which is always little endian explicit */
+  DcmStreamParserItem reader;
+  OFString xferUID;
+  DcmTag tag;
+  Uint32 length = 0;
+  Uint8 group[2];
+  while (result.good() && !inStream.eos() && (inStream.avail() >= 2))
+  {
+    /* the meta information ends with the first element that is not in group 0002 */
+    inStream.mark();
+    inStream.read(group, 2);
+    inStream.putback();
+    if ((group[0] != 0x02) || (group[1] != 0x00))
+      break;
+    result = reader.readHeader(inStream, EXS_LittleEndianExplicit, tag, length);
+    if (result.bad())
+      break;
+    if (length == DCM_UndefinedLength)
+      result = EC_CorruptedData;
+    else
+    {
+      OFBool readValueFlag = OFTrue;
+      result = handler_.elementHeader(tag, length, readValueFlag);
+      if (result.good())
+      {
+        if (tag == DCM_TransferSyntaxUID)
+          result = readValue(inStream, tag, length, DCM_UndefinedLength, readValueFlag, &xferUID);
+        else if (readValueFlag)
+          result = readValue(inStream, tag, length, DCM_UndefinedLength, OFTrue, NULL);
+        else
+          result = skipValue(inStream, length);
+      }
+    }
+  }
+  if (result.bad())
+    return result;
+
+  /* determine the transfer syntax of the dataset */
+  E_TransferSyntax xfer = readXfer;
+  const size_t pos = xferUID.find_last_not_of(OFString(" \0", 2));
+  if (pos != OFString_npos)
+  {
+    xfer = DcmXfer(xferUID.substr(0, pos + 1).c_str()).getXfer();
+    if (xfer == EXS_Unknown)
+      return EC_UnknownTransferSyntax;
+  }
+  return parseDataset(inStream, xfer);
+}
+
+
+OFCondition DcmStreamParser::parseDataset(DcmInputStream& inStream,
+                                          const E_TransferSyntax xfer)
+{
+  OFCondition result = inStream.status();
+  if (result.bad()) return result;
+
+  E_TransferSyntax readXfer = xfer;
+  if (readXfer == EXS_Unknown)
+  {
+    DcmStreamParserItem reader;
+    readXfer = reader.detectTransferSyntax(inStream);
+  }
+
+  /* install the decompression filter for deflated transfer syntaxes */
+  const E_StreamCompression sc = DcmXfer(readXfer).getStreamCompression();
+  switch (sc)
+  {
+    case ESC_none:
+      // nothing to do
+      break;
+    case ESC_unsupported:
+      // stream compressed transfer syntax that we cannot read; bail out.
+      result = EC_UnsupportedEncoding;
+      break;
+    default:
+      // supported stream compressed transfer syntax, install filter
+      result = inStream.installCompressionFilter(sc);
+      break;
+  }
+
+  if (result.good())
+    result = handler_.startDataset(readXfer);
+  if (result.good())
+    result = parseItemContent(inStream, readXfer, DCM_UndefinedLength, OFTrue);
+  if (result.good())
+    result = handler_.endDataset();
+  return result;
+}
+
+
+OFCondition DcmStreamParser::parseItemContent(DcmInputStream& inStream,
+                                              const E_TransferSyntax xfer,
+                                              const Uint32 length,
+                                              const OFBool isDataset)
+{
+  /* each item has its own private creators */
+  DcmStreamParserItem reader;
+  const OFBool undefinedLength = (length == DCM_UndefinedLength);
+  const offile_off_t endPosition = inStream.tell() + (undefinedLength ? 0 : length);
+  DcmXfer xferSyn(xfer);
+  OFCondition result = EC_Normal;
+  DcmTag tag;
+  Uint32 valueLength = 0;
+  while (result.good())
+  {
+    if (!undefinedLength && (inStream.tell() >= endPosition))
+      break;
+    if (inStream.eos())
+    {
+      /* only the dataset may end with the stream */
+      if (!isDataset)
+        result = EC_ItemDelimitationItemMissing;
+      break;
+    }
+    result = reader.readHeader(inStream, xfer, tag, valueLength);
+    if (result == EC_StreamNotifyClient)
+      result = EC_EndOfStream;
+    if (result.bad())
+      break;
+    if (tag == DCM_ItemDelimitationItem)
+    {
+      /* end of an item with undefined length */
+      if (!isDataset && undefinedLength)
+        break;
+      DCMDATA_WARN("DcmStreamParser: Ignoring unexpected item delimitation item " << tag);
+    }
+    else if ((tag == DCM_SequenceDelimitationItem) || (tag == DCM_Item))
+    {
+      result = isDataset ? EC_CorruptedData : EC_ItemDelimitationItemMissing;
+    }
+    else if (tag.getEVR() == EVR_SQ)
+    {
+      result = parseSequence(reader, inStream, xfer, tag, valueLength);
+    }
+    else if (valueLength == DCM_UndefinedLength)
+    {
+      /* same interpretation of undefined length as in DcmItem::newDicomElement() */
+      const DcmEVR evr = tag.getEVR();
+      const OFBool isOBOW = (evr == EVR_OB) || (evr == EVR_OW) || (evr == EVR_ox);
+      if ((tag == DCM_PixelData) || (evr == EVR_px) || (evr == EVR_PixelData))
+        result = parsePixelSequence(reader, inStream, xfer, tag);
+      else if ((evr == EVR_UN) || (evr == EVR_UNKNOWN) || (evr == EVR_UNKNOWN2B))
+      {
+        /* undefined length UN (or unknown tag in implicit VR) is a sequence,
+         * encoded in implicit VR little endian for explicit UN (CP-246) */
+        const E_TransferSyntax seqXfer = ((evr == EVR_UN) && dcmEnableCP246Support.get()) ? EXS_LittleEndianImplicit : xfer;
+        tag.setVR(EVR_SQ);
+        result = parseSequence(reader, inStream, seqXfer, tag, valueLength);
+      }
+      else if ((tag.isPrivate() && dcmReadImplPrivAttribMaxLengthAsSQ.get()) ||
+               (isOBOW && dcmConvertUndefinedLengthOBOWtoSQ.get()))
+      {
+        /* explicitly enabled: treat as sequence */
+        tag.setVR(EVR_SQ);
+        result = parseSequence(reader, inStream, xfer, tag, valueLength);
+      }
+      else if (isOBOW && dcmIgnoreParsingErrors.get())
+      {
+        /* ignore the parse error and read the items, keep the VR unchanged */
+        DCMDATA_WARN("DcmStreamParser: Parse error in " << tag << ": " << OFCondition(EC_UndefinedLengthOBOW).text());
+        result = parseSequence(reader, inStream, xfer, tag, valueLength);
+      }
+      else
+      {
+        result = isOBOW ? EC_UndefinedLengthOBOW : EC_CorruptedData;
+        DCMDATA_ERROR("DcmStreamParser: Parse error in " << tag << " with VR " << tag.getVRName()
+          << " and undefined length: " << result.text());
+      }
+    }
+    else
+    {
+      const OFBool isPrivateCreator = (tag.getGTag() & 1) && (tag.getETag() >= 0x10) && (tag.getETag() <= 0xff);
+      OFBool readValueFlag = OFTrue;
+      result = handler_.elementHeader(tag, valueLength, readValueFlag);
+      if (result.good())
+      {
+        if (isPrivateCreator)
+        {
+          /* private creators are always needed for the subsequent private elements */
+          OFString privateCreator;
+          result = readValue(inStream, tag, valueLength, DCM_UndefinedLength, readValueFlag, &privateCreator);
+          const size_t pos = privateCreator.find_last_not_of(OFString(" \0", 2));
+          if (result.good() && (pos != OFString_npos))
+            reader.updatePrivateCreators(tag, privateCreator.substr(0, pos + 1).c_str());
+        }
+        else if (readValueFlag)
+          result = readValue(inStream, tag, valueLength, DCM_UndefinedLength, OFTrue, NULL);
+        else
+          result = skipValue(inStream, valueLength);
+      }
+    }
+  }
+  if (result.good() && !undefinedLength && (inStream.tell() > endPosition))
+    result = EC_SeqOrItemContentOverflow;
+  return result;
+}
+
+
+OFCondition DcmStreamParser::parseSequence(DcmStreamParserItem& reader,
+                                           DcmInputStream& inStream,
+                                           const E_TransferSyntax xfer,
+                                           const DcmTag& tag,
+                                           const Uint32 length)
+{
+  OFCondition result = handler_.startSequence(tag, length);
+  const OFBool undefinedLength = (length == DCM_UndefinedLength);
+  const offile_off_t endPosition = inStream.tell() + (undefinedLength ? 0 : length);
+  DcmTag itemTag;
+  Uint32 itemLength = 0;
+  while (result.good())
+  {
+    if (!undefinedLength && (inStream.tell() >= endPosition))
+      break;
+    if (inStream.eos())
+    {
+      result = EC_SequDelimitationItemMissing;
+      break;
+    }
+    result = reader.readHeader(inStream, xfer, itemTag, itemLength);
+    if (result == EC_StreamNotifyClient)
+      result = EC_EndOfStream;
+    if (result.bad())
+      break;
+    if (itemTag == DCM_SequenceDelimitationItem)
+    {
+      if (!undefinedLength)
+        DCMDATA_WARN("DcmStreamParser: Sequence delimitation item in sequence " << tag << " with explicit length");
+      break;
+    }
+    if (itemTag != DCM_Item)
+    {
+      DCMDATA_ERROR("DcmStreamParser: Parse error in sequence " << tag << ", found " << itemTag << " instead of an item");
+      result = EC_SequDelimitationItemMissing;
+      break;
+    }
+    result = handler_.startItem(itemLength);
+    if (result.good())
+      result = parseItemContent(inStream, xfer, itemLength, OFFalse);
+    if (result.good())
+      result = handler_.endItem();
+  }
+  if (result.good() && !undefinedLength && (inStream.tell() > endPosition))
+    result = EC_SeqOrItemContentOverflow;
+  if (result.good())
+    result = handler_.endSequence(tag);
+  return result;
+}
+
+
+OFCondition DcmStreamParser::parsePixelSequence(DcmStreamParserItem& reader,
+                                                DcmInputStream& inStream,
+                                                const E_TransferSyntax xfer,
+                                                const DcmTag& tag)
+{
+  OFCondition result = handler_.startPixelSequence(tag);
+  DcmTag itemTag;
+  Uint32 itemLength = 0;
+  Uint32 fragment = 0;
+  while (result.good())
+  {
+    if (inStream.eos())
+    {
+      result = EC_SequDelimitationItemMissing;
+      break;
+    }
+    result = reader.readHeader(inStream, xfer, itemTag, itemLength);
+    if (result == EC_StreamNotifyClient)
+      result = EC_EndOfStream;
+    if (result.bad())
+      break;
+    if (itemTag == DCM_SequenceDelimitationItem)
+      break;
+    if ((itemTag != DCM_Item) || (itemLength == DCM_UndefinedLength))
+    {
+      DCMDATA_ERROR("DcmStreamParser: Parse error in encapsulated pixel data, found " << itemTag << " instead of a fragment");
+      result = EC_CorruptedData;
+      break;
+    }
+    result = readValue(inStream, tag, itemLength, fragment++, OFTrue, NULL);
+  }
+  if (result.good())
+    result = handler_.endPixelSequence();
+  return result;
+}
+
+
+OFCondition DcmStreamParser::readValue(DcmInputStream& inStream,
+                                       const DcmTag& tag,
+                                       const Uint32 length,
+                                       const Uint32 fragment,
+                                       const OFBool notifyHandler,
+                                       OFString *value)
+{
+  if (buffer_.empty()) buffer_.resize(chunkSize_);
+  if (value) value->clear();
+  if ((length == 0) && notifyHandler && (fragment != DCM_UndefinedLength))
+  {
+    /* report empty fragments, e.g. an empty basic offset table */
+    return handler_.pixelFragment(fragment, NULL, 0, 0, 0);
+  }
+  OFCondition result = EC_Normal;
+  Uint32 offset = 0;
+  while (result.good() && (offset < length))
+  {
+    const Uint32 remaining = length - offset;
+    const Uint32 chunk = (remaining < chunkSize_) ? remaining : chunkSize_;
+    Uint32 bytesRead = 0;
+    while (bytesRead < chunk)
+    {
+      const offile_off_t n = inStream.read(&buffer_[bytesRead], chunk - bytesRead);
+      if (n <= 0) break;
+      bytesRead += OFstatic_cast(Uint32, n);
+    }
+    if (bytesRead < chunk)
+    {
+      result = inStream.status().bad() ? inStream.status() : EC_EndOfStream;
+      break;
+    }
+    if (value)
+      value->append(OFreinterpret_cast(const char *, &buffer_[0]), chunk);
+    if (notifyHandler)
+    {
+      if (fragment == DCM_UndefinedLength)
+        result = handler_.elementValue(tag, &buffer_[0], chunk, offset);
+      else
+        result = handler_.pixelFragment(fragment, &buffer_[0], chunk, offset, length);
+    }
+    offset += chunk;
+  }
+  return result;
+}
+
+
+OFCondition DcmStreamParser::skipValue(DcmInputStream& inStream,
+                                       const Uint32 length)
+{
+  offile_off_t remaining = length;
+  while (remaining > 0)
+  {
+    const offile_off_t skipped = inStream.skip(remaining);
+    if (skipped <= 0)
+      return inStream.status().bad() ? inStream.status() : EC_EndOfStream;
+    remaining -= skipped;
+  }
+  return EC_Normal;
+}
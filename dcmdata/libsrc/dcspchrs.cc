@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2023, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -28,6 +28,11 @@
 #include "dcmtk/dcmdata/dcdeftag.h"
 #include "dcmtk/ofstd/ofstream.h"
 #include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/oflist.h"
+
+#ifdef WITH_THREADS
+#include "dcmtk/ofstd/ofthread.h"     /* for class OFMutex */
+#endif
 
 #if DCMTK_ENABLE_CHARSET_CONVERSION == DCMTK_CHARSET_CONVERSION_OFICONV
 #include "dcmtk/oficonv/iconv.h"
@@ -67,6 +72,165 @@ END_EXTERN_C
 #define MAX_OUTPUT_STRING_LENGTH 60
 
 
+/*-------------------------*
+ *  local helper classes   *
+ *-------------------------*/
+
+/** process-wide cache of unused character set converters, see
+ *  DcmSpecificCharacterSet::acquireConverter()
+ */
+class DcmCharacterSetConverterCache
+{
+  public:
+
+    /// constructor
+    DcmCharacterSetConverterCache()
+      : Converters(),
+        NumberOfConverters(0),
+        MaxSize(DCMTK_CHARSET_CONVERTER_CACHE_SIZE)
+#ifdef WITH_THREADS
+      , Mutex()
+#endif
+    {
+    }
+
+    /// destructor, deletes all cached converters
+    ~DcmCharacterSetConverterCache()
+    {
+        clear();
+    }
+
+    /** remove a converter for the given key from the cache
+     *  @param key key of the converter
+     *  @return converter, NULL if there is none
+     */
+    DcmSpecificCharacterSet *get(const OFString &key)
+    {
+        DcmSpecificCharacterSet *converter = NULL;
+        lock();
+        T_ConverterMap::iterator it = Converters.find(key);
+        if ((it != Converters.end()) && !it->second.empty())
+        {
+            converter = it->second.front();
+            it->second.pop_front();
+            --NumberOfConverters;
+        }
+        unlock();
+        return converter;
+    }
+
+    /** add a converter to the cache, or delete it if the cache is full
+     *  @param key key of the converter
+     *  @param converter converter to be added
+     */
+    void put(const OFString &key,
+             DcmSpecificCharacterSet *converter)
+    {
+        lock();
+        if (NumberOfConverters < MaxSize)
+        {
+            Converters[key].push_front(converter);
+            ++NumberOfConverters;
+            converter = NULL;
+        }
+        unlock();
+        delete converter;
+    }
+
+    /** set the maximum number of cached converters
+     *  @param maxSize maximum number of converters
+     */
+    void setMaxSize(const size_t maxSize)
+    {
+        lock();
+        MaxSize = maxSize;
+        const OFBool tooMany = (NumberOfConverters > maxSize);
+        unlock();
+        if (tooMany)
+            clear();
+    }
+
+    /// delete all cached converters
+    void clear()
+    {
+        T_ConverterMap converters;
+        lock();
+        /* delete the converters outside of the critical section */
+        converters.swap(Converters);
+        NumberOfConverters = 0;
+        unlock();
+        for (T_ConverterMap::iterator it = converters.begin(); it != converters.end(); ++it)
+        {
+            for (OFListIterator(DcmSpecificCharacterSet *) conv = it->second.begin(); conv != it->second.end(); ++conv)
+                delete *conv;
+        }
+    }
+
+  private:
+
+    /// type definition of a map storing the unused converters for each key
+    typedef OFMap<OFString, OFList<DcmSpecificCharacterSet *> > T_ConverterMap;
+
+    /// private undefined copy constructor
+    DcmCharacterSetConverterCache(const DcmCharacterSetConverterCache &);
+
+    /// private undefined assignment operator
+    DcmCharacterSetConverterCache &operator=(const DcmCharacterSetConverterCache &);
+
+    /// lock the cache (if thread support is available)
+    void lock()
+    {
+#ifdef WITH_THREADS
+        Mutex.lock();
+#endif
+    }
+
+    /// unlock the cache (if thread support is available)
+    void unlock()
+    {
+#ifdef WITH_THREADS
+        Mutex.unlock();
+#endif
+    }
+
+    /// unused converters for each key
+    T_ConverterMap Converters;
+    /// total number of unused converters
+    size_t NumberOfConverters;
+    /// maximum number of unused converters
+    size_t MaxSize;
+#ifdef WITH_THREADS
+    /// mutex protecting the cache
+    OFMutex Mutex;
+#endif
+};
+
+
+/// the global cache of character set converters
+static DcmCharacterSetConverterCache GlobalConverterCache;
+
+
+/** create the key for a converter in the cache
+ *  @param fromCharset name of the source character set(s)
+ *  @param toCharset name of the destination character set
+ *  @param flags conversion flags
+ *  @return key
+ */
+static OFString getConverterCacheKey(const OFString &fromCharset,
+                                     const OFString &toCharset,
+                                     const unsigned flags)
+{
+    /* the key is only used internally, the separators do not occur in a defined term */
+    char buffer[32];
+    OFStandard::snprintf(buffer, sizeof(buffer), "\n%u", flags);
+    OFString key = toCharset;
+    key += '\t';
+    key += fromCharset;
+    key += buffer;
+    return key;
+}
+
+
 
 /*------------------*
  *  implementation  *
@@ -77,7 +241,9 @@ DcmSpecificCharacterSet::DcmSpecificCharacterSet()
     DestinationCharacterSet(),
     DestinationEncoding(),
     DefaultEncodingConverter(),
-    EncodingConverters()
+    EncodingConverters(),
+    ASCIIPassThrough(OFFalse),
+    CacheKey()
 {
 #if DCMTK_ENABLE_CHARSET_CONVERSION == DCMTK_CHARSET_CONVERSION_OFICONV
     // set the callback function for oficonv so that logger output goes to the dcmdata logger
@@ -102,6 +268,9 @@ void DcmSpecificCharacterSet::clear()
     SourceCharacterSet.clear();
     DestinationCharacterSet.clear();
     DestinationEncoding.clear();
+    ASCIIPassThrough = OFFalse;
+    // a modified converter is not returned to the cache
+    CacheKey.clear();
 }
 
 
@@ -143,6 +312,8 @@ unsigned DcmSpecificCharacterSet::getConversionFlags() const
 
 OFCondition DcmSpecificCharacterSet::setConversionFlags(const unsigned flags)
 {
+    // a modified converter is not returned to the cache
+    CacheKey.clear();
     if (!EncodingConverters.empty())
     {
         /* pass conversion flags to all "encoding converters" */
@@ -179,6 +350,7 @@ OFCondition DcmSpecificCharacterSet::selectCharacterSet(const OFString &fromChar
             // output some useful debug information
             if (status.good())
             {
+                ASCIIPassThrough = isASCIICompatibleEncoding(DestinationEncoding);
                 DCMDATA_DEBUG("DcmSpecificCharacterSet: Selected character set '' (ASCII) "
                     << "for the conversion to " << DestinationEncoding);
             }
@@ -339,6 +511,7 @@ OFCondition DcmSpecificCharacterSet::selectCharacterSetWithoutCodeExtensions()
         // output some useful debug information
         if (status.good())
         {
+            ASCIIPassThrough = isASCIICompatibleEncoding(fromEncoding) && isASCIICompatibleEncoding(DestinationEncoding);
             DCMDATA_DEBUG("DcmSpecificCharacterSet: Selected character set '" << SourceCharacterSet
                 << "' (" << fromEncoding << ") for the conversion to " << DestinationEncoding);
         }
@@ -491,6 +664,7 @@ OFCondition DcmSpecificCharacterSet::selectCharacterSetWithCodeExtensions(const
                     if (i == 0)
                     {
                         DefaultEncodingConverter = conv.first->second;
+                        ASCIIPassThrough = isASCIICompatibleEncoding(encodingName) && isASCIICompatibleEncoding(DestinationEncoding);
                         DCMDATA_TRACE("DcmSpecificCharacterSet: Also selected this character set "
                             << "(i.e. '" << definedTerm << "') as the default one");
                     }
@@ -548,6 +722,12 @@ OFCondition DcmSpecificCharacterSet::convertString(const char *fromString,
                                                    const OFString &delimiters)
 {
     OFCondition status = EC_Normal;
+    // strings consisting of ASCII characters only are not changed by the conversion
+    if (ASCIIPassThrough && isPlainASCIIString(fromString, fromLength))
+    {
+        toString.assign(fromString, fromLength);
+        return status;
+    }
     // check whether there are or could be any code extensions
     const OFBool hasEscapeChar = checkForEscapeCharacter(fromString, fromLength);
     if (EncodingConverters.empty() || (!hasEscapeChar && delimiters.empty()))
@@ -823,6 +1003,64 @@ size_t DcmSpecificCharacterSet::countCharactersInUTF8String(const OFString &utf8
 }
 
 
+OFCondition DcmSpecificCharacterSet::acquireConverter(const OFString &fromCharset,
+                                                      const OFString &toCharset,
+                                                      const unsigned flags,
+                                                      DcmSpecificCharacterSet *&converter)
+{
+    OFCondition status = EC_Normal;
+    // check whether there is an unused converter for this combination
+    const OFString key = getConverterCacheKey(fromCharset, toCharset, flags);
+    converter = GlobalConverterCache.get(key);
+    if (converter == NULL)
+    {
+        DCMDATA_DEBUG("DcmSpecificCharacterSet: Creating a new character set converter for '"
+            << fromCharset << "'" << (fromCharset.empty() ? " (ASCII)" : "") << " to '"
+            << toCharset << "'" << (toCharset.empty() ? " (ASCII)" : ""));
+        converter = new DcmSpecificCharacterSet();
+        // select source and destination character set
+        status = converter->selectCharacterSet(fromCharset, toCharset);
+        if (status.good() && (flags > 0))
+            status = converter->setConversionFlags(flags);
+        if (status.good())
+            converter->CacheKey = key;
+        else {
+            delete converter;
+            converter = NULL;
+        }
+    } else {
+        DCMDATA_TRACE("DcmSpecificCharacterSet: Reusing character set converter for '"
+            << fromCharset << "' to '" << toCharset << "'");
+    }
+    return status;
+}
+
+
+void DcmSpecificCharacterSet::releaseConverter(DcmSpecificCharacterSet *converter)
+{
+    if (converter != NULL)
+    {
+        // converters that have not been created by acquireConverter() are not cached
+        if (converter->CacheKey.empty())
+            delete converter;
+        else
+            GlobalConverterCache.put(converter->CacheKey, converter);
+    }
+}
+
+
+void DcmSpecificCharacterSet::setConverterCacheSize(const size_t maxSize)
+{
+    GlobalConverterCache.setMaxSize(maxSize);
+}
+
+
+void DcmSpecificCharacterSet::clearConverterCache()
+{
+    GlobalConverterCache.clear();
+}
+
+
 OFBool DcmSpecificCharacterSet::checkForEscapeCharacter(const char *strValue,
                                                         const size_t strLength) const
 {
@@ -842,6 +1080,31 @@ OFBool DcmSpecificCharacterSet::checkForEscapeCharacter(const char *strValue,
 }
 
 
+OFBool DcmSpecificCharacterSet::isASCIICompatibleEncoding(const OFString &encoding)
+{
+    // the Japanese JIS X 0201 character set differs from ASCII in two characters
+    return (encoding == "ASCII") || (encoding == "UTF-8") ||
+           (encoding.compare(0, 9, "ISO-8859-") == 0) ||
+           (encoding == "GB18030") || (encoding == "GBK") ||
+           (encoding == "ISO-IR-166") || (encoding == "TIS-620");
+}
+
+
+OFBool DcmSpecificCharacterSet::isPlainASCIIString(const char *strValue,
+                                                   const size_t strLength)
+{
+    // iterate over the string of characters
+    for (size_t pos = 0; pos < strLength; ++pos)
+    {
+        // and check for 8-bit characters or the ESC character
+        const unsigned char c = OFstatic_cast(unsigned char, strValue[pos]);
+        if ((c >= 0x80) || (c == 0x1b))
+            return OFFalse;
+    }
+    return OFTrue;
+}
+
+
 OFString DcmSpecificCharacterSet::convertToLengthLimitedOctalString(const char *strValue,
                                                                     const size_t strLength) const
 {
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2017, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -67,6 +67,58 @@ OFCondition swapIfNecessary(const E_ByteOrder newByteOrder,
 
 
 
+/* The following helpers load each value as a machine word (using memcpy()
+ * to avoid unaligned access), reverse its bytes with shift operations and
+ * store it again. Compilers translate this into bswap/rotate instructions
+ * and vectorize the loops with byte shuffles where the target supports it,
+ * which is much faster than exchanging single bytes. Source and target may
+ * be identical, in which case the data is swapped in place.
+ */
+
+static void swapWords16(Uint8 *target, const Uint8 *source, size_t count)
+{
+    Uint16 v;
+    for (size_t i = 0; i < count; ++i)
+    {
+        memcpy(&v, source, sizeof(v));
+        v = OFstatic_cast(Uint16, (v >> 8) | (v << 8));
+        memcpy(target, &v, sizeof(v));
+        source += sizeof(v);
+        target += sizeof(v);
+    }
+}
+
+static void swapWords32(Uint8 *target, const Uint8 *source, size_t count)
+{
+    Uint32 v;
+    for (size_t i = 0; i < count; ++i)
+    {
+        memcpy(&v, source, sizeof(v));
+        v = (v >> 24) | ((v >> 8) & 0x0000ff00UL) | ((v << 8) & 0x00ff0000UL) | (v << 24);
+        memcpy(target, &v, sizeof(v));
+        source += sizeof(v);
+        target += sizeof(v);
+    }
+}
+
+static void swapWords64(Uint8 *target, const Uint8 *source, size_t count)
+{
+    Uint32 lo, hi;
+    for (size_t i = 0; i < count; ++i)
+    {
+        /* swap both halves and exchange them */
+        memcpy(&lo, source, sizeof(lo));
+        memcpy(&hi, source + sizeof(lo), sizeof(hi));
+        lo = (lo >> 24) | ((lo >> 8) & 0x0000ff00UL) | ((lo << 8) & 0x00ff0000UL) | (lo << 24);
+        hi = (hi >> 24) | ((hi >> 8) & 0x0000ff00UL) | ((hi << 8) & 0x00ff0000UL) | (hi << 24);
+        memcpy(target, &hi, sizeof(hi));
+        memcpy(target + sizeof(hi), &lo, sizeof(lo));
+        source += 2 * sizeof(lo);
+        target += 2 * sizeof(lo);
+    }
+}
+
+
 void swapBytes(void * value, const Uint32 byteLength,
                const size_t valWidth)
     /*
@@ -79,27 +131,19 @@ void swapBytes(void * value, const Uint32 byteLength,
      *   valWidth     - [in] Specifies how many bytes shall be treated together as one element.
      */
 {
-    Uint8 save;
+    Uint8 *base = OFstatic_cast(Uint8 *, value);
 
-    /* in case valWidth equals 2, swap correspondingly */
+    /* the common value widths are handled by the word-wise helpers */
     if (valWidth == 2)
-    {
-        Uint8 *first = &OFstatic_cast(Uint8*, value)[0];
-        Uint8 *second = &OFstatic_cast(Uint8*, value)[1];
-        Uint32 times = byteLength / 2;
-        while(times)
-        {
-            --times;
-            save = *first;
-            *first = *second;
-            *second = save;
-            first += 2;
-            second += 2;
-        }
-    }
-    /* if valWidth is greater than 2, swap correspondingly */
+        swapWords16(base, base, byteLength / 2);
+    else if (valWidth == 4)
+        swapWords32(base, base, byteLength / 4);
+    else if (valWidth == 8)
+        swapWords64(base, base, byteLength / 8);
+    /* for any other width greater than 2, swap bytewise */
     else if (valWidth > 2)
     {
+        Uint8 save;
         size_t i;
         const size_t halfWidth = valWidth / 2;
         const size_t offset = valWidth - 1;
@@ -107,7 +151,6 @@ void swapBytes(void * value, const Uint32 byteLength,
         Uint8 *end;
 
         Uint32 times = OFstatic_cast(Uint32, byteLength / valWidth);
-        Uint8  *base = OFstatic_cast(Uint8 *, value);
 
         while (times)
         {
@@ -128,6 +171,86 @@ void swapBytes(void * value, const Uint32 byteLength,
 }
 
 
+void swapBytesCopy(void * target, const void * source,
+                   const Uint32 byteLength, const size_t valWidth)
+    /*
+     * This function copies byteLength bytes from source to target and swaps
+     * the bytes of each valWidth element while copying. Trailing bytes that
+     * do not form a complete element are copied unchanged.
+     *
+     * Parameters:
+     *   target       - [out] Array of at least byteLength bytes to copy the data to.
+     *   source       - [in] Array that contains the bytes to be copied.
+     *   byteLength   - [in] Length of the above arrays.
+     *   valWidth     - [in] Specifies how many bytes shall be treated together as one element.
+     */
+{
+    Uint8 *dst = OFstatic_cast(Uint8 *, target);
+    const Uint8 *src = OFstatic_cast(const Uint8 *, source);
+    size_t swapped = 0;
+
+    if (valWidth == 2)
+    {
+        swapped = byteLength & ~OFstatic_cast(size_t, 1);
+        swapWords16(dst, src, swapped / 2);
+    }
+    else if (valWidth == 4)
+    {
+        swapped = byteLength & ~OFstatic_cast(size_t, 3);
+        swapWords32(dst, src, swapped / 4);
+    }
+    else if (valWidth == 8)
+    {
+        swapped = byteLength & ~OFstatic_cast(size_t, 7);
+        swapWords64(dst, src, swapped / 8);
+    }
+    else if (valWidth > 2)
+    {
+        /* for any other width, copy each element in reverse order */
+        swapped = (byteLength / valWidth) * valWidth;
+        for (size_t i = 0; i < swapped; i += valWidth)
+        {
+            for (size_t j = 0; j < valWidth; ++j)
+                dst[i + j] = src[i + valWidth - j - 1];
+        }
+    }
+
+    /* copy remaining bytes (or all bytes if there is nothing to swap) */
+    if (swapped < byteLength)
+        memcpy(dst + swapped, src + swapped, byteLength - swapped);
+}
+
+
+OFCondition copySwapIfNecessary(const E_ByteOrder newByteOrder,
+                                const E_ByteOrder oldByteOrder,
+                                void * target, const void * source,
+                                const Uint32 byteLength, const size_t valWidth)
+    /*
+     * This function copies byteLength bytes from source to target and swaps
+     * them while copying if newByteOrder and oldByteOrder differ from each other.
+     *
+     * Parameters:
+     *   newByteOrder - [in] The new byte ordering (little or big endian).
+     *   oldByteOrder - [in] The current old byte ordering (little or big endian).
+     *   target       - [out] Array of at least byteLength bytes to copy the data to.
+     *   source       - [in] Array that contains the bytes to be copied.
+     *   byteLength   - [in] Length of the above arrays.
+     *   valWidth     - [in] Specifies how many bytes shall be treated together as one element.
+     */
+{
+    /* if the two byte orderings are unknown this is an illegal call */
+    if (oldByteOrder != EBO_unknown && newByteOrder != EBO_unknown)
+    {
+        if (oldByteOrder != newByteOrder && valWidth != 1)
+            swapBytesCopy(target, source, byteLength, valWidth);
+        else
+            memcpy(target, source, byteLength);
+        return EC_Normal;
+    }
+    return EC_IllegalCall;
+}
+
+
 Uint16 swapShort(const Uint16 toSwap)
 {
     Uint8 *swapped = OFreinterpret_cast(Uint8 *, OFconst_cast(Uint16 *, &toSwap));
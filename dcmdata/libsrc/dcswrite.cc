@@ -0,0 +1,432 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: Implementation of class DcmStreamingWriter
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmdata/dcswrite.h"   /* for class DcmStreamingWriter */
+#include "dcmtk/dcmdata/dcostrma.h"   /* for class DcmOutputStream */
+#include "dcmtk/dcmdata/dcfilefo.h"   /* for class DcmFileFormat */
+#include "dcmtk/dcmdata/dcmetinf.h"   /* for class DcmMetaInfo */
+#include "dcmtk/dcmdata/dcdatset.h"   /* for class DcmDataset */
+#include "dcmtk/dcmdata/dcdeftag.h"   /* for tag constants */
+#include "dcmtk/dcmdata/dcelem.h"     /* for class DcmElement */
+#include "dcmtk/dcmdata/dcswap.h"     /* for swapIfNecessary() */
+#include "dcmtk/dcmdata/dcvr.h"       /* for class DcmVR */
+
+/* maximum number of bytes swapped at once when writing native pixel data */
+#define DCM_StreamingWriterSwapBufsize 65536
+
+
+DcmStreamingWriter::DcmStreamingWriter(DcmOutputStream& outStream,
+                                       const E_TransferSyntax xfer)
+: outStream_(outStream)
+, xfer_(xfer)
+, byteOrder_(EBO_unknown)
+, explicitVR_(OFTrue)
+, status_(EC_Normal)
+, metaHeaderWritten_(OFFalse)
+, datasetStarted_(OFFalse)
+, levels_()
+, lastTags_()
+, pixelDataState_(EPS_none)
+, pixelDataLength_(0)
+, pixelDataWritten_(0)
+, swapPixelData_(OFFalse)
+, swapBuffer_()
+, writeCache_()
+{
+  DcmXfer xf(xfer);
+  byteOrder_ = xf.getByteOrder();
+  explicitVR_ = xf.isExplicitVR();
+  if ((xfer == EXS_Unknown) || (byteOrder_ == EBO_unknown) || (xfer == EXS_BigEndianImplicit))
+    status_ = EC_UnsupportedEncoding;
+  else
+    status_ = outStream_.status();
+  levels_.push_back(EL_dataset);
+  lastTags_.push_back(DcmTagKey(0x0000, 0x0000));
+}
+
+
+DcmStreamingWriter::~DcmStreamingWriter()
+{
+}
+
+
+OFCondition DcmStreamingWriter::writeMetaHeader(const OFString& sopClassUID,
+                                                const OFString& sopInstanceUID)
+{
+  if (status_.bad()) return status_;
+  if (metaHeaderWritten_ || datasetStarted_) return EC_IllegalCall;
+
+  /* create the file meta information from a temporary dataset that only
+   * contains the UIDs referenced by the meta header
+   */
+  DcmFileFormat fileformat;
+  DcmDataset *dataset = fileformat.getDataset();
+  OFCondition result = dataset->putAndInsertOFStringArray(DCM_SOPClassUID, sopClassUID);
+  if (result.good())
+    result = dataset->putAndInsertOFStringArray(DCM_SOPInstanceUID, sopInstanceUID);
+  if (result.good())
+    result = fileformat.validateMetaInfo(xfer_);
+  if (result.good())
+  {
+    /* the file meta information is always encoded in little endian explicit VR */
+    DcmMetaInfo *metainfo = fileformat.getMetaInfo();
+    metainfo->transferInit();
+    result = metainfo->write(outStream_, EXS_LittleEndianExplicit, EET_ExplicitLength, NULL);
+    metainfo->transferEnd();
+    metaHeaderWritten_ = OFTrue;
+    if (result.bad()) status_ = result;
+  }
+  return result;
+}
+
+
+OFCondition DcmStreamingWriter::writeElement(DcmObject& object)
+{
+  OFCondition result = checkElement(object.getTag());
+  if (result.good())
+  {
+    object.transferInit();
+    result = object.write(outStream_, xfer_, EET_UndefinedLength, &writeCache_);
+    object.transferEnd();
+    if (result.bad()) status_ = result;
+  }
+  return result;
+}
+
+
+OFCondition DcmStreamingWriter::writeString(const DcmTag& tag,
+                                            const OFString& value)
+{
+  if (status_.bad()) return status_;
+  DcmElement *elem = NULL;
+  OFCondition result = DcmItem::newDicomElementWithVR(elem, tag);
+  if (result.good())
+  {
+    result = elem->putOFStringArray(value);
+    if (result.good())
+      result = writeElement(*elem);
+  }
+  delete elem;
+  return result;
+}
+
+
+OFCondition DcmStreamingWriter::writeUint16(const DcmTag& tag,
+                                            const Uint16 value)
+{
+  if (status_.bad()) return status_;
+  DcmElement *elem = NULL;
+  OFCondition result = DcmItem::newDicomElementWithVR(elem, tag);
+  if (result.good())
+  {
+    result = elem->putUint16(value);
+    if (result.good())
+      result = writeElement(*elem);
+  }
+  delete elem;
+  return result;
+}
+
+
+OFCondition DcmStreamingWriter::beginSequence(const DcmTag& tag)
+{
+  OFCondition result = checkElement(tag);
+  if (result.good())
+  {
+    result = writeHeader(tag, EVR_SQ, DCM_UndefinedLength);
+    if (result.good())
+    {
+      levels_.push_back(EL_sequence);
+      lastTags_.push_back(DcmTagKey(0x0000, 0x0000));
+    }
+  }
+  return result;
+}
+
+
+OFCondition DcmStreamingWriter::endSequence()
+{
+  if (status_.bad()) return status_;
+  if ((levels_.back() != EL_sequence) || (pixelDataState_ != EPS_none)) return EC_IllegalCall;
+  levels_.pop_back();
+  lastTags_.pop_back();
+  return writeItemHeader(DCM_SequenceDelimitationItem, 0);
+}
+
+
+OFCondition DcmStreamingWriter::beginItem()
+{
+  if (status_.bad()) return status_;
+  if (levels_.back() != EL_sequence) return EC_IllegalCall;
+  OFCondition result = writeItemHeader(DCM_Item, DCM_UndefinedLength);
+  if (result.good())
+  {
+    levels_.push_back(EL_item);
+    lastTags_.push_back(DcmTagKey(0x0000, 0x0000));
+  }
+  return result;
+}
+
+
+OFCondition DcmStreamingWriter::endItem()
+{
+  if (status_.bad()) return status_;
+  if ((levels_.back() != EL_item) || (pixelDataState_ != EPS_none)) return EC_IllegalCall;
+  levels_.pop_back();
+  lastTags_.pop_back();
+  return writeItemHeader(DCM_ItemDelimitationItem, 0);
+}
+
+
+OFCondition DcmStreamingWriter::beginPixelData(const Uint32 length,
+                                               const DcmEVR vr)
+{
+  if (status_.bad()) return status_;
+  if (DcmXfer(xfer_).isEncapsulated() || ((vr != EVR_OB) && (vr != EVR_OW)) || (length == DCM_UndefinedLength))
+    return EC_IllegalCall;
+  OFCondition result = checkElement(DCM_PixelData);
+  if (result.good())
+  {
+    /* odd value lengths are padded to even length */
+    result = writeHeader(DCM_PixelData, vr, length + (length & 1));
+    if (result.good())
+    {
+      pixelDataState_ = EPS_native;
+      pixelDataLength_ = length;
+      pixelDataWritten_ = 0;
+      swapPixelData_ = (vr == EVR_OW) && (DcmXfer(xfer_).getPixelDataByteOrder() != gLocalByteOrder);
+    }
+  }
+  return result;
+}
+
+
+OFCondition DcmStreamingWriter::beginEncapsulatedPixelData()
+{
+  if (status_.bad()) return status_;
+  if (! DcmXfer(xfer_).isEncapsulated()) return EC_IllegalCall;
+  OFCondition result = checkElement(DCM_PixelData);
+  if (result.good())
+    result = writeHeader(DCM_PixelData, EVR_OB, DCM_UndefinedLength);
+  /* empty basic offset table */
+  if (result.good())
+    result = writeItemHeader(DCM_Item, 0);
+  if (result.good())
+    pixelDataState_ = EPS_encapsulated;
+  return result;
+}
+
+
+OFCondition DcmStreamingWriter::writePixelData(const void *data,
+                                               const Uint32 length)
+{
+  if (status_.bad()) return status_;
+  if ((data == NULL) && (length > 0)) return EC_IllegalParameter;
+  OFCondition result = EC_Normal;
+  if (pixelDataState_ == EPS_native)
+  {
+    if (length > pixelDataLength_ - pixelDataWritten_) return EC_ValueLengthMismatch;
+    if (swapPixelData_)
+    {
+      if (length & 1) return EC_IllegalParameter;
+      if (swapBuffer_.empty()) swapBuffer_.resize(DCM_StreamingWriterSwapBufsize);
+      const Uint8 *src = OFstatic_cast(const Uint8 *, data);
+      Uint32 remaining = length;
+      while (result.good() && (remaining > 0))
+      {
+        const Uint32 chunk = (remaining < DCM_StreamingWriterSwapBufsize) ? remaining : DCM_StreamingWriterSwapBufsize;
+        swapBytesCopy(&swapBuffer_[0], src, chunk, sizeof(Uint16));
+        result = writeRaw(&swapBuffer_[0], chunk);
+        src += chunk;
+        remaining -= chunk;
+      }
+    }
+    else
+      result = writeRaw(data, length);
+    if (result.good())
+      pixelDataWritten_ += length;
+  }
+  else if (pixelDataState_ == EPS_encapsulated)
+  {
+    if (length == DCM_UndefinedLength) return EC_IllegalParameter;
+    /* one fragment, padded to even length */
+    result = writeItemHeader(DCM_Item, length + (length & 1));
+    if (result.good())
+      result = writeRaw(data, length);
+    if (result.good() && (length & 1))
+    {
+      const Uint8 pad = 0;
+      result = writeRaw(&pad, 1);
+    }
+  }
+  else
+    result = EC_IllegalCall;
+  return result;
+}
+
+
+OFCondition DcmStreamingWriter::endPixelData()
+{
+  if (status_.bad()) return status_;
+  OFCondition result = EC_Normal;
+  if (pixelDataState_ == EPS_native)
+  {
+    if (pixelDataWritten_ != pixelDataLength_)
+    {
+      status_ = EC_ValueLengthMismatch;
+      return status_;
+    }
+    if (pixelDataLength_ & 1)
+    {
+      const Uint8 pad = 0;
+      result = writeRaw(&pad, 1);
+    }
+  }
+  else if (pixelDataState_ == EPS_encapsulated)
+    result = writeItemHeader(DCM_SequenceDelimitationItem, 0);
+  else
+    return EC_IllegalCall;
+  pixelDataState_ = EPS_none;
+  return result;
+}
+
+
+OFCondition DcmStreamingWriter::finish()
+{
+  if (status_.bad()) return status_;
+  if ((levels_.size() > 1) || (pixelDataState_ != EPS_none)) return EC_IllegalCall;
+  OFCondition result = startDataset();
+  if (result.good())
+  {
+    outStream_.flush();
+    if (! outStream_.isFlushed())
+      result = EC_StreamNotifyClient;
+    else
+      result = outStream_.status();
+    if (result.bad()) status_ = result;
+  }
+  return result;
+}
+
+
+OFCondition DcmStreamingWriter::startDataset()
+{
+  if (status_.good() && ! datasetStarted_)
+  {
+    datasetStarted_ = OFTrue;
+    const E_StreamCompression sc = DcmXfer(xfer_).getStreamCompression();
+    switch (sc)
+    {
+      case ESC_none:
+        // nothing to do
+        break;
+      case ESC_unsupported:
+        // stream compressed transfer syntax that we cannot create; bail out.
+        status_ = EC_UnsupportedEncoding;
+        break;
+      default:
+        // supported stream compressed transfer syntax, install filter
+        status_ = outStream_.installCompressionFilter(sc);
+        break;
+    }
+  }
+  return status_;
+}
+
+
+OFCondition DcmStreamingWriter::checkElement(const DcmTagKey& tag)
+{
+  if (status_.bad()) return status_;
+  if ((levels_.back() == EL_sequence) || (pixelDataState_ != EPS_none)) return EC_IllegalCall;
+  if (tag <= lastTags_.back()) return EC_TagOrderViolation;
+  OFCondition result = startDataset();
+  if (result.good())
+    lastTags_.back() = tag;
+  return result;
+}
+
+
+OFCondition DcmStreamingWriter::writeRaw(const void *data, const Uint32 length)
+{
+  const Uint8 *buf = OFstatic_cast(const Uint8 *, data);
+  offile_off_t remaining = length;
+  while (remaining > 0)
+  {
+    const offile_off_t written = outStream_.write(buf, remaining);
+    if (written <= 0)
+    {
+      /* a blocking stream accepts all data unless an error occurred */
+      status_ = outStream_.status();
+      if (status_.good()) status_ = EC_StreamNotifyClient;
+      return status_;
+    }
+    buf += written;
+    remaining -= written;
+  }
+  return EC_Normal;
+}
+
+
+OFCondition DcmStreamingWriter::writeHeader(const DcmTagKey& tag,
+                                            const DcmEVR vr,
+                                            const Uint32 length)
+{
+  Uint16 tagField[2];
+  tagField[0] = tag.getGroup();
+  tagField[1] = tag.getElement();
+  swapIfNecessary(byteOrder_, gLocalByteOrder, tagField, 4, sizeof(Uint16));
+  Uint8 buf[12];
+  memcpy(buf, tagField, 4);
+  size_t headerLength = 4;
+  if (explicitVR_)
+  {
+    /* only VRs with extended length encoding are written by this class */
+    const char *vrName = DcmVR(vr).getValidVRName();
+    buf[4] = OFstatic_cast(Uint8, vrName[0]);
+    buf[5] = OFstatic_cast(Uint8, vrName[1]);
+    buf[6] = 0;
+    buf[7] = 0;
+    headerLength = 8;
+  }
+  Uint32 lengthField = length;
+  swapIfNecessary(byteOrder_, gLocalByteOrder, &lengthField, 4, sizeof(Uint32));
+  memcpy(buf + headerLength, &lengthField, 4);
+  return writeRaw(buf, OFstatic_cast(Uint32, headerLength + 4));
+}
+
+
+OFCondition DcmStreamingWriter::writeItemHeader(const DcmTagKey& tag,
+                                                const Uint32 length)
+{
+  Uint16 tagField[2];
+  tagField[0] = tag.getGroup();
+  tagField[1] = tag.getElement();
+  swapIfNecessary(byteOrder_, gLocalByteOrder, tagField, 4, sizeof(Uint16));
+  Uint32 lengthField = length;
+  swapIfNecessary(byteOrder_, gLocalByteOrder, &lengthField, 4, sizeof(Uint32));
+  Uint8 buf[8];
+  memcpy(buf, tagField, 4);
+  memcpy(buf + 4, &lengthField, 4);
+  return writeRaw(buf, 8);
+}
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -26,6 +26,9 @@
 #include "dcmtk/dcmdata/dcjson.h"
 #include "dcmtk/ofstd/ofstring.h"
 #include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/ofmath.h"
+
+#include <cmath>
 
 
 #define MAX_DS_LENGTH 16
@@ -131,33 +134,28 @@ OFCondition DcmDecimalString::getFloat64Vector(OFVector<Float64> &doubleVals)
         const unsigned long vm = getVM();
         if (vm > 0)
         {
-            Float64 doubleVal;
-            OFString doubleStr;
-            char *p = strVal;
+            const char *p = strVal;
+            const char *end = strVal + strLen;
             OFBool success = OFFalse;
             /* avoid memory re-allocations by specifying the expected size */
             doubleVals.reserve(vm);
-            /* iterate over the string value and search for delimiters */
-            for (Uint32 i = 0; i <= strLen; i++)
+            /* convert the values directly within the string buffer */
+            for (;;)
             {
-                if ((i == strLen) || (*p == '\\'))
+                const char *delim = OFstatic_cast(const char *, memchr(p, '\\', end - p));
+                if (delim == NULL)
+                    delim = end;
+                const Float64 doubleVal = OFStandard::atof(p, delim - p, &success);
+                if (!success)
                 {
-                    /* extract single value and convert it to floating point */
-                    doubleStr.assign(strVal, p - strVal);
-                    doubleVal = OFStandard::atof(doubleStr.c_str(), &success);
-                    if (success)
-                    {
-                        /* store floating point value in result variable */
-                        doubleVals.push_back(doubleVal);
-                        strVal = p + 1;
-                    }
-                    else
-                    {
-                        l_error = EC_CorruptedData;
-                        break;
-                    }
+                    l_error = EC_CorruptedData;
+                    break;
                 }
-                ++p;
+                /* store floating point value in result variable */
+                doubleVals.push_back(doubleVal);
+                if (delim == end)
+                    break;
+                p = delim + 1;
             }
         }
     }
@@ -165,7 +163,6 @@ OFCondition DcmDecimalString::getFloat64Vector(OFVector<Float64> &doubleVals)
 }
 
 
-
 // ********************************
 
 
@@ -234,6 +231,121 @@ OFCondition DcmDecimalString::putFloat64Prec(const Float64 val,
 }
 
 
+/* Exact powers of ten that can be represented as a double. */
+static const Float64 exactPowersOf10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+/* Format the given value as the shortest decimal string from which the same value
+ * is obtained again. If that string would exceed the maximum length of a DS value,
+ * the precision is reduced until it fits. The string is stored without a trailing
+ * NUL byte in target (which must provide space for MAX_DS_LENGTH characters).
+ * Returns the length of the string or 0 if the value cannot be represented as DS.
+ */
+static size_t formatDecimalString(char *target, const Float64 val)
+{
+    if (OFMath::isnan(val) || OFMath::isinf(val))
+        return 0;
+    /* Most values have a short representation in fixed-point notation, i.e. there is
+     * a (small) number of fractional digits n for which val * 10^n is an integer i and
+     * i / 10^n results in val again. Since both i (< 2^53) and 10^n (n <= 22) are exact,
+     * this is also the value that OFStandard::atof() returns for the resulting string.
+     */
+    const Float64 absVal = (val < 0) ? -val : val;
+    for (size_t n = 0; n < sizeof(exactPowersOf10) / sizeof(exactPowersOf10[0]); ++n)
+    {
+        const Float64 scaled = absVal * exactPowersOf10[n];
+        if (scaled >= 9007199254740992.0 /* 2^53 */)
+            break;
+        const Float64 integer = floor(scaled + 0.5);
+        if (integer / exactPowersOf10[n] == absVal)
+        {
+            /* convert the integer from right to left and insert the decimal point */
+            char digits[32];
+            char *p = digits + sizeof(digits);
+            Uint64 i = OFstatic_cast(Uint64, integer);
+            size_t count = 0;
+            do
+            {
+                *--p = OFstatic_cast(char, '0' + i % 10);
+                i /= 10;
+                if (++count == n)
+                    *--p = '.';
+            } while ((i > 0) || (count < n));
+            if (count == n)
+                *--p = '0';
+            if ((val < 0) && (integer > 0))
+                *--p = '-';
+            const size_t len = digits + sizeof(digits) - p;
+            if (len > MAX_DS_LENGTH)
+                break;
+            memcpy(target, p, len);
+            return len;
+        }
+    }
+    /* otherwise, use the exponential notation (if needed) and up to 17 significant digits */
+    char buf[32];
+    size_t len = 0;
+    int prec = 15;
+    for (; prec <= 17; ++prec)
+    {
+        OFStandard::ftoa(buf, sizeof(buf), val, 0, 0, prec);
+        len = strlen(buf);
+        OFBool success = OFFalse;
+        if ((OFStandard::atof(buf, len, &success) == val) && success)
+            break;
+    }
+    /* reduce the precision until the string fits */
+    while ((len > MAX_DS_LENGTH) && (prec > 1))
+    {
+        OFStandard::ftoa(buf, sizeof(buf), val, 0, 0, --prec);
+        len = strlen(buf);
+    }
+    if (len > MAX_DS_LENGTH)
+        return 0;
+    memcpy(target, buf, len);
+    return len;
+}
+
+
+OFCondition DcmDecimalString::putFloat64Array(const Float64 *doubleVals,
+                                              const unsigned long numDoubles)
+{
+    errorFlag = EC_Normal;
+    if (numDoubles > 0)
+    {
+        /* check for valid data */
+        if (doubleVals != NULL)
+        {
+            /* create the complete string value at once */
+            char *buffer = new char[OFstatic_cast(size_t, numDoubles) * (MAX_DS_LENGTH + 1)];
+            char *p = buffer;
+            for (unsigned long i = 0; i < numDoubles; ++i)
+            {
+                if (i > 0)
+                    *p++ = '\\';
+                const size_t len = formatDecimalString(p, doubleVals[i]);
+                if (len == 0)
+                {
+                    errorFlag = EC_IllegalParameter;
+                    break;
+                }
+                p += len;
+            }
+            if (errorFlag.good())
+                errorFlag = putString(buffer, OFstatic_cast(Uint32, p - buffer));
+            delete[] buffer;
+        } else
+            errorFlag = EC_CorruptedData;
+    } else
+        errorFlag = putString(NULL, 0);
+    return errorFlag;
+}
+
+
 // ********************************
 
 
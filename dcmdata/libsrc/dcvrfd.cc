@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2021, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -328,20 +328,22 @@ OFCondition DcmFloatingPointDouble::putString(const char *stringVal,
     {
         Float64 *field = new Float64[vm];
         OFBool success = OFFalse;
-        OFString value;
-        size_t pos = 0;
-        /* retrieve double data from character string */
+        const char *p = stringVal;
+        const char *end = stringVal + stringLen;
+        /* retrieve double data directly from the multi-valued character string */
         for (unsigned long i = 0; (i < vm) && errorFlag.good(); i++)
         {
-            /* get specified value from multi-valued string */
-            pos = DcmElement::getValueFromString(stringVal, pos, stringLen, value);
-            if (!value.empty())
+            const char *delim = OFstatic_cast(const char *, memchr(p, '\\', end - p));
+            if (delim == NULL)
+                delim = end;
+            if (delim != p)
             {
-                field[i] = OFStandard::atof(value.c_str(), &success);
+                field[i] = OFStandard::atof(p, delim - p, &success);
                 if (!success)
                     errorFlag = EC_CorruptedData;
             } else
                 errorFlag = EC_CorruptedData;
+            p = (delim == end) ? end : delim + 1;
         }
         /* set binary data as the element value */
         if (errorFlag == EC_Normal)
@@ -411,7 +413,7 @@ OFCondition DcmFloatingPointDouble::writeJson(STD_NAMESPACE ostream &out,
           // check if any values is 'inf' or 'nan', and return an error in this case
           // since the JSON extension that would allow us to write these is not enabled
           Float64 f = 0.0;
-          for (unsigned long valNo = 1; valNo < vm; ++valNo)
+          for (unsigned long valNo = 0; valNo < vm; ++valNo)
           {
             status = getFloat64(f, valNo);
             if (status.bad()) return status;
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2021, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -413,7 +413,7 @@ OFCondition DcmFloatingPointSingle::writeJson(STD_NAMESPACE ostream &out,
           // check if any values is 'inf' or 'nan', and return an error in this case
           // since the JSON extension that would allow us to write these is not enabled
           Float32 f = 0.0;
-          for (unsigned long valNo = 1; valNo < vm; ++valNo)
+          for (unsigned long valNo = 0; valNo < vm; ++valNo)
           {
             status = getFloat32(f, valNo);
             if (status.bad()) return status;
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -115,6 +115,128 @@ OFCondition DcmIntegerString::getSint32(Sint32 &sintVal,
 }
 
 
+/* Convert a single integer value of the given length, which may be surrounded by
+ * spaces. Values with unexpected characters are converted like getSint32() does.
+ */
+static OFBool parseIntegerString(const char *p, const char *end, Sint32 &sintVal)
+{
+    const char *s = p;
+    while ((s != end) && (*s == ' ')) ++s;
+    OFBool negative = OFFalse;
+    if ((s != end) && ((*s == '-') || (*s == '+')))
+        negative = (*s++ == '-');
+    Sint64 value = 0;
+    const char *digits = s;
+    while ((s != end) && (*s >= '0') && (*s <= '9') && (value <= 0x80000000))
+        value = value * 10 + (*s++ - '0');
+    const char *last = s;
+    while ((s != end) && (*s == ' ')) ++s;
+    if ((s == end) && (last != digits) && (value <= (negative ? 0x80000000 : 0x7fffffff)))
+    {
+        sintVal = OFstatic_cast(Sint32, negative ? -value : value);
+        return OFTrue;
+    }
+    /* fall back to the general conversion for anything else */
+    const OFString str(p, end - p);
+#ifdef SCNd32
+    return sscanf(str.c_str(), "%" SCNd32, &sintVal) == 1;
+#elif SIZEOF_LONG == 8
+    return sscanf(str.c_str(), "%d", &sintVal) == 1;
+#else
+    return sscanf(str.c_str(), "%ld", &sintVal) == 1;
+#endif
+}
+
+
+OFCondition DcmIntegerString::getSint32Vector(OFVector<Sint32> &sintVals)
+{
+    /* get stored value */
+    char *strVal = NULL;
+    Uint32 strLen = 0;
+    OFCondition l_error = getString(strVal, strLen);
+    /* clear result variable */
+    sintVals.clear();
+    if (l_error.good() && (strVal != NULL))
+    {
+        /* determine number of stored values */
+        const unsigned long vm = getVM();
+        if (vm > 0)
+        {
+            const char *p = strVal;
+            const char *end = strVal + strLen;
+            Sint32 sintVal = 0;
+            /* avoid memory re-allocations by specifying the expected size */
+            sintVals.reserve(vm);
+            /* convert the values directly within the string buffer */
+            for (;;)
+            {
+                const char *delim = OFstatic_cast(const char *, memchr(p, '\\', end - p));
+                if (delim == NULL)
+                    delim = end;
+                if (!parseIntegerString(p, delim, sintVal))
+                {
+                    l_error = EC_CorruptedData;
+                    break;
+                }
+                /* store integer value in result variable */
+                sintVals.push_back(sintVal);
+                if (delim == end)
+                    break;
+                p = delim + 1;
+            }
+        }
+    }
+    return l_error;
+}
+
+
+// ********************************
+
+
+OFCondition DcmIntegerString::putSint32Array(const Sint32 *sintVals,
+                                             const unsigned long numSints)
+{
+    errorFlag = EC_Normal;
+    if (numSints > 0)
+    {
+        /* check for valid data */
+        if (sintVals != NULL)
+        {
+            /* create the complete string value at once */
+            char *buffer = new char[OFstatic_cast(size_t, numSints) * (MAX_IS_LENGTH + 1)];
+            char *end = buffer;
+            char digits[16];
+            for (unsigned long i = 0; i < numSints; ++i)
+            {
+                /* convert the value from right to left */
+                char *p = digits + sizeof(digits);
+                Sint64 value = sintVals[i];
+                const OFBool negative = (value < 0);
+                if (negative)
+                    value = -value;
+                do
+                {
+                    *--p = OFstatic_cast(char, '0' + value % 10);
+                    value /= 10;
+                } while (value > 0);
+                if (negative)
+                    *--p = '-';
+                if (i > 0)
+                    *end++ = '\\';
+                const size_t len = digits + sizeof(digits) - p;
+                memcpy(end, p, len);
+                end += len;
+            }
+            errorFlag = putString(buffer, OFstatic_cast(Uint32, end - buffer));
+            delete[] buffer;
+        } else
+            errorFlag = EC_CorruptedData;
+    } else
+        errorFlag = putString(NULL, 0);
+    return errorFlag;
+}
+
+
 // ********************************
 
 
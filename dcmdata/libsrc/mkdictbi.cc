@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2021, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -27,10 +27,14 @@
 #include "dcmtk/ofstd/ofstring.h"
 #include "dcmtk/ofstd/ofdatime.h"
 #include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/ofvector.h"
 #include "dcmtk/dcmdata/dcdicent.h"
 
 #define PRIVATE_TAGS_IFNAME "ENABLE_PRIVATE_TAGS"
 
+/* marks an unused slot of the perfect hash table */
+#define UNUSED_SLOT 0xffff
+
 void
 DcmDataDictionary::loadBuiltinDictionary()
 {
@@ -103,6 +107,95 @@ printSimpleEntry(FILE* fout, const DcmDictEntry* e, OFBool& isFirst, OFBool& isP
       fprintf(fout, "      NULL }\n");
 }
 
+static Uint32
+nextPowerOfTwo(Uint32 n)
+{
+    Uint32 result = 1;
+    while (result < n) result <<= 1;
+    return result;
+}
+
+static Uint32
+tagHashKey(const DcmDictEntry* e)
+{
+    return (OFstatic_cast(Uint32, e->getGroup()) << 16) | e->getElement();
+}
+
+/*
+** Computes a minimal-lookup perfect hash table for the given entries using
+** the "hash and displace" method: the keys are distributed into buckets by
+** a first hash function, and for each bucket (the largest first) a
+** displacement is searched that maps all keys of the bucket to free slots.
+** Returns false if no such table could be found.
+*/
+static OFBool
+computePerfectHash(const OFVector<const DcmDictEntry*>& entries,
+                   OFVector<Uint16>& displacements,
+                   OFVector<Uint16>& slots)
+{
+    const size_t count = entries.size();
+    const Uint32 bucketMask = OFstatic_cast(Uint32, displacements.size()) - 1;
+    const Uint32 slotMask = OFstatic_cast(Uint32, slots.size()) - 1;
+    OFVector<OFVector<size_t> > buckets(displacements.size());
+    size_t maxBucketSize = 0;
+    size_t i, j;
+    for (i = 0; i < count; ++i)
+    {
+        OFVector<size_t>& bucket = buckets[DcmDataDictionary::builtinHash(tagHashKey(entries[i]), 0) & bucketMask];
+        bucket.push_back(i);
+        if (bucket.size() > maxBucketSize) maxBucketSize = bucket.size();
+    }
+    for (i = 0; i < displacements.size(); ++i) displacements[i] = 0;
+    for (i = 0; i < slots.size(); ++i) slots[i] = UNUSED_SLOT;
+    OFVector<Uint32> candidates;
+    for (size_t size = maxBucketSize; size > 0; --size)
+    {
+        for (size_t b = 0; b < buckets.size(); ++b)
+        {
+            const OFVector<size_t>& bucket = buckets[b];
+            if (bucket.size() != size) continue;
+            OFBool found = OFFalse;
+            for (Uint32 d = 1; !found && (d <= 0xffff); ++d)
+            {
+                candidates.clear();
+                found = OFTrue;
+                for (i = 0; found && (i < size); ++i)
+                {
+                    const Uint32 slot = DcmDataDictionary::builtinHash(tagHashKey(entries[bucket[i]]), d) & slotMask;
+                    if (slots[slot] != UNUSED_SLOT) found = OFFalse;
+                    for (j = 0; found && (j < candidates.size()); ++j)
+                    {
+                        if (candidates[j] == slot) found = OFFalse;
+                    }
+                    candidates.push_back(slot);
+                }
+                if (found)
+                {
+                    displacements[b] = OFstatic_cast(Uint16, d);
+                    for (i = 0; i < size; ++i)
+                        slots[candidates[i]] = OFstatic_cast(Uint16, bucket[i]);
+                }
+            }
+            if (!found) return OFFalse;
+        }
+    }
+    return OFTrue;
+}
+
+static void
+printTable(FILE* fout, const char* name, const OFVector<Uint16>& table)
+{
+    fprintf(fout, "static const Uint16 %s[%lu] = {\n", name, OFstatic_cast(unsigned long, table.size()));
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+        if (i % 10 == 0) fprintf(fout, "   ");
+        fprintf(fout, " 0x%04x%s", table[i], (i + 1 < table.size()) ? "," : "");
+        if ((i % 10 == 9) || (i + 1 == table.size())) fprintf(fout, "\n");
+    }
+    fprintf(fout, "};\n");
+    fprintf(fout, "\n");
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -172,23 +265,6 @@ main(int argc, char* argv[])
     fprintf(fout, "#if DCM_DICT_DEFAULT == DCM_DICT_DEFAULT_USE_BUILTIN\n");
     fprintf(fout, "#include \"dcmtk/dcmdata/dcdicent.h\"\n");
     fprintf(fout, "\n");
-    fprintf(fout, "struct DBI_SimpleEntry {\n");
-    fprintf(fout, "    Uint16 group;\n");
-    fprintf(fout, "    Uint16 element;\n");
-    fprintf(fout, "    Uint16 upperGroup;\n");
-    fprintf(fout, "    Uint16 upperElement;\n");
-    fprintf(fout, "    DcmEVR evr;\n");
-    fprintf(fout, "    const char* tagName;\n");
-    fprintf(fout, "    int vmMin;\n");
-    fprintf(fout, "    int vmMax;\n");
-    fprintf(fout, "    const char* standardVersion;\n");
-    fprintf(fout, "    DcmDictRangeRestriction groupRestriction;\n");
-    fprintf(fout, "    DcmDictRangeRestriction elementRestriction;\n");
-    fprintf(fout, "    const char* privateCreator;\n");
-    fprintf(fout, "};\n");
-    fprintf(fout, "\n");
-    fprintf(fout, "static const DBI_SimpleEntry simpleBuiltinDict[] = {\n");
-
     OFBool isFirst = OFTrue;
     OFBool isPrivate = OFFalse;
 
@@ -203,16 +279,50 @@ main(int argc, char* argv[])
         e = new DcmDictEntry(*(*iter));
         list.insertAndReplace(e);
     }
-    /* output the list contents */
 
-    /* non-repeating standard elements */
+    /*
+    ** non-repeating standard elements are stored in a static table which
+    ** is accessed through a perfect hash function, all other elements are
+    ** added to the dictionary at runtime.
+    */
+    OFVector<const DcmDictEntry*> staticEntries;
     DcmDictEntryListIterator listIter(list.begin());
     DcmDictEntryListIterator listLast(list.end());
     for (; listIter != listLast; ++listIter)
     {
-        printSimpleEntry(fout, *listIter, isFirst, isPrivate);
+        if ((*listIter)->getPrivateCreator() == NULL)
+            staticEntries.push_back(*listIter);
+    }
+    if (staticEntries.size() >= UNUSED_SLOT) {
+        fprintf(stderr, "Too many dictionary entries (%lu), giving up\n", OFstatic_cast(unsigned long, staticEntries.size()));
+        return -1;
+    }
+    OFVector<Uint16> displacements(nextPowerOfTwo(OFstatic_cast(Uint32, staticEntries.size() / 4 + 1)));
+    OFVector<Uint16> slots(nextPowerOfTwo(OFstatic_cast(Uint32, staticEntries.size() + 1)));
+    if (!computePerfectHash(staticEntries, displacements, slots)) {
+        fprintf(stderr, "Failed to compute perfect hash table, giving up\n");
+        return -1;
     }
 
+    fprintf(fout, "static const DcmBuiltinDictEntry staticBuiltinDict[] = {\n");
+    for (size_t j = 0; j < staticEntries.size(); ++j)
+    {
+        printSimpleEntry(fout, staticEntries[j], isFirst, isPrivate);
+    }
+    fprintf(fout, "\n};\n");
+    fprintf(fout, "\n");
+    fprintf(fout, "static const Uint16 staticBuiltinDict_count =\n");
+    fprintf(fout, "    OFstatic_cast(Uint16, sizeof(staticBuiltinDict)/sizeof(DcmBuiltinDictEntry));\n");
+    fprintf(fout, "\n");
+    printTable(fout, "staticBuiltinDict_displacements", displacements);
+    printTable(fout, "staticBuiltinDict_slots", slots);
+    fprintf(fout, "/* storage for the entries, which are constructed on first access */\n");
+    fprintf(fout, "static DcmBuiltinDictEntryStorage staticBuiltinDict_storage[%lu];\n", OFstatic_cast(unsigned long, staticEntries.size()));
+    fprintf(fout, "\n");
+
+    fprintf(fout, "static const DcmBuiltinDictEntry simpleBuiltinDict[] = {\n");
+    isFirst = OFTrue;
+
     /* repeating standard elements */
     DcmDictEntryListIterator repIter(globalDataDict.repeatingBegin());
     DcmDictEntryListIterator repLast(globalDataDict.repeatingEnd());
@@ -221,6 +331,13 @@ main(int argc, char* argv[])
         printSimpleEntry(fout, *repIter, isFirst, isPrivate);
     }
 
+    /* non-repeating private elements */
+    for (listIter = list.begin(); listIter != listLast; ++listIter)
+    {
+        if ((*listIter)->getPrivateCreator() != NULL)
+            printSimpleEntry(fout, *listIter, isFirst, isPrivate);
+    }
+
     if (isPrivate)
     {
        fprintf(fout, "#endif\n");
@@ -229,15 +346,19 @@ main(int argc, char* argv[])
     fprintf(fout, "\n};\n");
     fprintf(fout, "\n");
     fprintf(fout, "static const size_t simpleBuiltinDict_count =\n");
-    fprintf(fout, "    sizeof(simpleBuiltinDict)/sizeof(DBI_SimpleEntry);\n");
+    fprintf(fout, "    sizeof(simpleBuiltinDict)/sizeof(DcmBuiltinDictEntry);\n");
     fprintf(fout, "\n");
 
     fprintf(fout, "\n");
     fprintf(fout, "void\n");
     fprintf(fout, "DcmDataDictionary::loadBuiltinDictionary()\n");
     fprintf(fout, "{\n");
+    fprintf(fout, "    setBuiltinEntries(staticBuiltinDict, staticBuiltinDict_storage,\n");
+    fprintf(fout, "        staticBuiltinDict_count,\n");
+    fprintf(fout, "        staticBuiltinDict_displacements, %lu,\n", OFstatic_cast(unsigned long, displacements.size()));
+    fprintf(fout, "        staticBuiltinDict_slots, %lu);\n", OFstatic_cast(unsigned long, slots.size()));
     fprintf(fout, "    DcmDictEntry* e = NULL;\n");
-    fprintf(fout, "    const DBI_SimpleEntry *b = simpleBuiltinDict;\n");
+    fprintf(fout, "    const DcmBuiltinDictEntry *b = simpleBuiltinDict;\n");
     fprintf(fout, "    for (size_t i=0; i<simpleBuiltinDict_count; ++i) {\n");
     fprintf(fout, "        b = simpleBuiltinDict + i;\n");
     fprintf(fout, "        e = new DcmDictEntry(b->group, b->element,\n");
@@ -0,0 +1,464 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: Benchmark of the RLE codec on a 16-bit CT frame and an 8-bit
+ *           RGB frame, compared with a byte-by-byte reference implementation
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+#include "dcmtk/ofstd/ofconsol.h"     /* for COUT */
+#include "dcmtk/ofstd/oftimer.h"      /* for class OFTimer */
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/ofstd/ofstd.h"
+
+#include "dcmtk/dcmdata/dctk.h"       /* for typical set of "dcmdata" headers */
+#include "dcmtk/dcmdata/dcpixseq.h"   /* for class DcmPixelSequence */
+#include "dcmtk/dcmdata/dcpxitem.h"   /* for class DcmPixelItem */
+#include "dcmtk/dcmdata/dcrleerg.h"   /* for class DcmRLEEncoderRegistration */
+#include "dcmtk/dcmdata/dcrledrg.h"   /* for class DcmRLEDecoderRegistration */
+#include "dcmtk/dcmdata/dcrleenc.h"   /* for class DcmRLEEncoder */
+
+#define DEFAULT_ITERATIONS 50
+
+
+/* description of a test frame */
+struct BenchmarkFrame
+{
+  const char *name;
+  Uint16 rows;
+  Uint16 columns;
+  Uint16 samplesPerPixel;
+  Uint16 bytesAllocated;
+  OFVector<Uint8> pixels;  // little endian, color-by-pixel
+};
+
+
+/* simple linear congruential generator, so that the frames are reproducible */
+static Uint32 nextRandom(Uint32& state)
+{
+  state = state * 1103515245UL + 12345UL;
+  return (state >> 16) & 0x7fff;
+}
+
+
+/* create a 16-bit CT frame: a round phantom filled with a smooth ramp and
+ * some noise (literal runs), surrounded by air (replicate runs)
+ */
+static void createCTFrame(BenchmarkFrame& frame)
+{
+  frame.name = "CT 512x512, 16 bit";
+  frame.rows = 512;
+  frame.columns = 512;
+  frame.samplesPerPixel = 1;
+  frame.bytesAllocated = 2;
+  frame.pixels.resize(OFstatic_cast(size_t, frame.rows) * frame.columns * 2);
+  Uint32 state = 1;
+  size_t i = 0;
+  for (int y = 0; y < frame.rows; ++y)
+  {
+    for (int x = 0; x < frame.columns; ++x)
+    {
+      const int dx = x - frame.columns / 2;
+      const int dy = y - frame.rows / 2;
+      Uint16 value = 0;
+      if (dx * dx + dy * dy < 230 * 230)
+        value = OFstatic_cast(Uint16, 1000 + (x + y) / 4 + nextRandom(state) % 16);
+      frame.pixels[i++] = OFstatic_cast(Uint8, value & 0xff);
+      frame.pixels[i++] = OFstatic_cast(Uint8, value >> 8);
+    }
+  }
+}
+
+
+/* create an 8-bit RGB frame: flat color bars in the upper half (replicate
+ * runs) and noisy color ramps in the lower half (mostly literal runs)
+ */
+static void createRGBFrame(BenchmarkFrame& frame)
+{
+  frame.name = "RGB 640x480, 8 bit";
+  frame.rows = 480;
+  frame.columns = 640;
+  frame.samplesPerPixel = 3;
+  frame.bytesAllocated = 1;
+  frame.pixels.resize(OFstatic_cast(size_t, frame.rows) * frame.columns * 3);
+  Uint32 state = 1;
+  size_t i = 0;
+  for (int y = 0; y < frame.rows; ++y)
+  {
+    for (int x = 0; x < frame.columns; ++x)
+    {
+      if (y < frame.rows / 2)
+      {
+        const int bar = x / 80;
+        frame.pixels[i++] = OFstatic_cast(Uint8, (bar & 1) ? 255 : 0);
+        frame.pixels[i++] = OFstatic_cast(Uint8, (bar & 2) ? 255 : 0);
+        frame.pixels[i++] = OFstatic_cast(Uint8, (bar & 4) ? 255 : 0);
+      }
+      else
+      {
+        frame.pixels[i++] = OFstatic_cast(Uint8, x + nextRandom(state) % 4);
+        frame.pixels[i++] = OFstatic_cast(Uint8, y + nextRandom(state) % 4);
+        frame.pixels[i++] = OFstatic_cast(Uint8, (x + y) / 2);
+      }
+    }
+  }
+}
+
+
+/* create an uncompressed dataset containing the given frame */
+static OFCondition createDataset(const BenchmarkFrame& frame, DcmDataset& dset)
+{
+  OFCondition result = dset.putAndInsertUint16(DCM_SamplesPerPixel, frame.samplesPerPixel);
+  if (result.good()) result = dset.putAndInsertString(DCM_PhotometricInterpretation, (frame.samplesPerPixel == 3) ? "RGB" : "MONOCHROME2");
+  if (result.good() && (frame.samplesPerPixel == 3)) result = dset.putAndInsertUint16(DCM_PlanarConfiguration, 0);
+  if (result.good()) result = dset.putAndInsertUint16(DCM_Rows, frame.rows);
+  if (result.good()) result = dset.putAndInsertUint16(DCM_Columns, frame.columns);
+  if (result.good()) result = dset.putAndInsertUint16(DCM_BitsAllocated, OFstatic_cast(Uint16, frame.bytesAllocated * 8));
+  if (result.good()) result = dset.putAndInsertUint16(DCM_BitsStored, OFstatic_cast(Uint16, frame.bytesAllocated * 8));
+  if (result.good()) result = dset.putAndInsertUint16(DCM_HighBit, OFstatic_cast(Uint16, frame.bytesAllocated * 8 - 1));
+  if (result.good()) result = dset.putAndInsertUint16(DCM_PixelRepresentation, 0);
+  if (result.good())
+  {
+    if (frame.bytesAllocated == 1)
+      result = dset.putAndInsertUint8Array(DCM_PixelData, &frame.pixels[0], OFstatic_cast(unsigned long, frame.pixels.size()));
+    else
+    {
+      /* the frame is stored in little endian byte order */
+      OFVector<Uint16> words(frame.pixels.size() / 2);
+      for (size_t i = 0; i < words.size(); ++i)
+        words[i] = OFstatic_cast(Uint16, frame.pixels[2 * i] | (frame.pixels[2 * i + 1] << 8));
+      result = dset.putAndInsertUint16Array(DCM_PixelData, &words[0], OFstatic_cast(unsigned long, words.size()));
+    }
+  }
+  if (result.good())
+    result = dset.chooseRepresentation(EXS_LittleEndianExplicit, NULL);
+  return result;
+}
+
+
+/* reference encoder: the byte-by-byte path that was used before the RLE
+ * codec collected stripes with specialized loops and passed them to the
+ * encoder in blocks. The output has the same format as the codec's.
+ */
+static void referenceEncode(const BenchmarkFrame& frame, OFVector<Uint8>& output)
+{
+  const size_t bytesPerStripe = OFstatic_cast(size_t, frame.rows) * frame.columns;
+  const size_t offsetBetweenSamples = OFstatic_cast(size_t, frame.samplesPerPixel) * frame.bytesAllocated;
+  const Uint32 numberOfStripes = OFstatic_cast(Uint32, frame.samplesPerPixel) * frame.bytesAllocated;
+  OFVector<DcmRLEEncoder *> encoders;
+  for (Uint32 sample = 0; sample < frame.samplesPerPixel; ++sample)
+  {
+    /* most significant byte first */
+    for (Uint32 byte = frame.bytesAllocated; byte > 0; --byte)
+    {
+      DcmRLEEncoder *encoder = new DcmRLEEncoder(1 /* pad */);
+      const Uint8 *pixelPointer = &frame.pixels[0] + sample * frame.bytesAllocated + byte - 1;
+      Uint16 columnCounter = frame.columns;
+      for (size_t pixel = 0; pixel < bytesPerStripe; ++pixel)
+      {
+        encoder->add(*pixelPointer);
+        if (--columnCounter == 0)
+        {
+          encoder->flush();
+          columnCounter = frame.columns;
+        }
+        pixelPointer += offsetBetweenSamples;
+      }
+      encoder->flush();
+      encoders.push_back(encoder);
+    }
+  }
+  /* RLE header: number of segments and offsets in little endian byte order */
+  Uint32 header[16];
+  size_t size = 64;
+  memset(header, 0, sizeof(header));
+  header[0] = numberOfStripes;
+  for (Uint32 i = 0; i < numberOfStripes; ++i)
+  {
+    header[i + 1] = OFstatic_cast(Uint32, size);
+    size += encoders[i]->size();
+  }
+  output.resize(size);
+  for (Uint32 j = 0; j < 16; ++j)
+  {
+    output[4 * j] = OFstatic_cast(Uint8, header[j]);
+    output[4 * j + 1] = OFstatic_cast(Uint8, header[j] >> 8);
+    output[4 * j + 2] = OFstatic_cast(Uint8, header[j] >> 16);
+    output[4 * j + 3] = OFstatic_cast(Uint8, header[j] >> 24);
+  }
+  size = 64;
+  for (Uint32 k = 0; k < numberOfStripes; ++k)
+  {
+    encoders[k]->write(&output[size]);
+    size += encoders[k]->size();
+    delete encoders[k];
+  }
+}
+
+
+/* reference decoder: expands runs and distributes the bytes of a stripe one
+ * by one, as the RLE codec did before it used memset(), memcpy() and loops
+ * with a constant stride. Returns false if the data is not valid.
+ */
+static OFBool referenceDecode(const Uint8 *input, size_t length, const BenchmarkFrame& frame, OFVector<Uint8>& output)
+{
+  const size_t bytesPerStripe = OFstatic_cast(size_t, frame.rows) * frame.columns;
+  const size_t offsetBetweenSamples = OFstatic_cast(size_t, frame.samplesPerPixel) * frame.bytesAllocated;
+  const Uint32 numberOfStripes = OFstatic_cast(Uint32, frame.samplesPerPixel) * frame.bytesAllocated;
+  if (length < 64) return OFFalse;
+  Uint32 header[16];
+  for (Uint32 j = 0; j < 16; ++j)
+  {
+    header[j] = OFstatic_cast(Uint32, input[4 * j]) | (OFstatic_cast(Uint32, input[4 * j + 1]) << 8) |
+      (OFstatic_cast(Uint32, input[4 * j + 2]) << 16) | (OFstatic_cast(Uint32, input[4 * j + 3]) << 24);
+  }
+  if (header[0] != numberOfStripes) return OFFalse;
+  output.resize(bytesPerStripe * offsetBetweenSamples);
+  OFVector<Uint8> stripe(bytesPerStripe);
+  for (Uint32 i = 0; i < numberOfStripes; ++i)
+  {
+    const size_t start = header[i + 1];
+    const size_t end = (i + 1 < numberOfStripes) ? header[i + 2] : length;
+    if ((start > end) || (end > length)) return OFFalse;
+    /* expand the runs of the segment */
+    const Uint8 *cp = input + start;
+    const Uint8 *last = input + end;
+    size_t offset = 0;
+    while ((cp < last) && (offset < bytesPerStripe))
+    {
+      const Uint8 control = *cp++;
+      if (control < 128)
+      {
+        size_t count = OFstatic_cast(size_t, control) + 1;
+        if ((cp + count > last) || (offset + count > bytesPerStripe)) return OFFalse;
+        while (count--) stripe[offset++] = *cp++;
+      }
+      else if (control > 128)
+      {
+        size_t count = 257 - OFstatic_cast(size_t, control);
+        if ((cp == last) || (offset + count > bytesPerStripe)) return OFFalse;
+        const Uint8 value = *cp++;
+        while (count--) stripe[offset++] = value;
+      }
+    }
+    if (offset != bytesPerStripe) return OFFalse;
+    /* distribute the stripe, most significant byte first */
+    const Uint32 sample = i / frame.bytesAllocated;
+    const Uint32 byte = frame.bytesAllocated - 1 - i % frame.bytesAllocated;
+    Uint8 *pixelPointer = &output[0] + sample * frame.bytesAllocated + byte;
+    for (size_t pixel = 0; pixel < bytesPerStripe; ++pixel)
+    {
+      *pixelPointer = stripe[pixel];
+      pixelPointer += offsetBetweenSamples;
+    }
+  }
+  return OFTrue;
+}
+
+
+/* get the first fragment of the (single) compressed frame */
+static OFCondition getCompressedFrame(DcmDataset& dset, const Uint8 *&data, size_t& length)
+{
+  DcmElement *elem = NULL;
+  OFCondition result = dset.findAndGetElement(DCM_PixelData, elem);
+  if (result.good())
+  {
+    DcmPixelData *pixData = OFstatic_cast(DcmPixelData *, elem);
+    DcmPixelSequence *pixSeq = NULL;
+    DcmPixelItem *pixItem = NULL;
+    E_TransferSyntax xfer = EXS_Unknown;
+    const DcmRepresentationParameter *param = NULL;
+    pixData->getCurrentRepresentationKey(xfer, param);
+    result = pixData->getEncapsulatedRepresentation(xfer, param, pixSeq);
+    /* item 0 is the basic offset table */
+    if (result.good()) result = pixSeq->getItem(pixItem, 1);
+    Uint8 *fragment = NULL;
+    if (result.good()) result = pixItem->getUint8Array(fragment);
+    if (result.good())
+    {
+      data = fragment;
+      length = pixItem->getLength();
+    }
+  }
+  return result;
+}
+
+
+/* compare the uncompressed pixel data of the given dataset with the frame */
+static OFBool comparePixels(DcmDataset& dset, const BenchmarkFrame& frame)
+{
+  DcmElement *elem = NULL;
+  Uint8 *data = NULL;
+  if (dset.findAndGetElement(DCM_PixelData, elem).bad() || elem->getUint8Array(data).bad())
+    return OFFalse;
+  if (elem->getLength() != frame.pixels.size())
+    return OFFalse;
+  if (frame.bytesAllocated == 2)
+  {
+    /* the element value is stored in local byte order */
+    OFVector<Uint8> copy(data, data + frame.pixels.size());
+    swapIfNecessary(EBO_LittleEndian, gLocalByteOrder, &copy[0], OFstatic_cast(Uint32, copy.size()), 2);
+    return memcmp(&copy[0], &frame.pixels[0], copy.size()) == 0;
+  }
+  return memcmp(data, &frame.pixels[0], frame.pixels.size()) == 0;
+}
+
+
+/* print one line of the result table */
+static void printResult(const char *label, double seconds, int iterations, size_t bytes)
+{
+  const double msPerFrame = seconds * 1000.0 / iterations;
+  const double mbPerSecond = (seconds > 0) ? (OFstatic_cast(double, bytes) * iterations / seconds / 1048576.0) : 0.0;
+  char buf[128];
+  OFStandard::snprintf(buf, sizeof(buf), "  %-30s %9.3f ms/frame %9.1f MB/s", label, msPerFrame, mbPerSecond);
+  COUT << buf << OFendl;
+}
+
+
+/* run the benchmark for the given frame, returns false if a result is wrong */
+static OFBool runBenchmark(const BenchmarkFrame& frame, int iterations)
+{
+  const size_t frameSize = frame.pixels.size();
+  COUT << frame.name << " (" << frameSize << " bytes, " << iterations << " iterations)" << OFendl;
+
+  DcmDataset uncompressed;
+  if (createDataset(frame, uncompressed).bad())
+  {
+    CERR << "Error: cannot create dataset" << OFendl;
+    return OFFalse;
+  }
+
+  /* the codec works on a copy of the dataset, so measure the copy separately */
+  OFTimer timer;
+  for (int i = 0; i < iterations; ++i)
+  {
+    DcmDataset dset(uncompressed);
+  }
+  printResult("dataset copy (overhead)", timer.getDiff(), iterations, frameSize);
+
+  /* compression with the RLE codec */
+  timer.reset();
+  for (int i = 0; i < iterations; ++i)
+  {
+    DcmDataset dset(uncompressed);
+    if (dset.chooseRepresentation(EXS_RLELossless, NULL).bad())
+    {
+      CERR << "Error: RLE compression failed" << OFendl;
+      return OFFalse;
+    }
+  }
+  printResult("encode, RLE codec", timer.getDiff(), iterations, frameSize);
+  DcmDataset compressed(uncompressed);
+  compressed.chooseRepresentation(EXS_RLELossless, NULL);
+  compressed.removeAllButCurrentRepresentations();
+
+  /* compression with the byte-by-byte reference implementation */
+  OFVector<Uint8> referenceData;
+  timer.reset();
+  for (int i = 0; i < iterations; ++i)
+    referenceEncode(frame, referenceData);
+  printResult("encode, byte-by-byte reference", timer.getDiff(), iterations, frameSize);
+
+  /* both encoders must produce the same compressed frame */
+  const Uint8 *codecData = NULL;
+  size_t codecLength = 0;
+  if (getCompressedFrame(compressed, codecData, codecLength).bad())
+  {
+    CERR << "Error: cannot access compressed frame" << OFendl;
+    return OFFalse;
+  }
+  if ((codecLength != referenceData.size()) || (memcmp(codecData, &referenceData[0], codecLength) != 0))
+  {
+    CERR << "Error: compressed frames differ" << OFendl;
+    return OFFalse;
+  }
+
+  /* decompression with the RLE codec */
+  timer.reset();
+  for (int i = 0; i < iterations; ++i)
+  {
+    DcmDataset dset(compressed);
+    if (dset.chooseRepresentation(EXS_LittleEndianExplicit, NULL).bad())
+    {
+      CERR << "Error: RLE decompression failed" << OFendl;
+      return OFFalse;
+    }
+    if ((i == 0) && !comparePixels(dset, frame))
+    {
+      CERR << "Error: decompressed frame differs from original" << OFendl;
+      return OFFalse;
+    }
+  }
+  printResult("decode, RLE codec", timer.getDiff(), iterations, frameSize);
+
+  /* decompression with the byte-by-byte reference implementation */
+  OFVector<Uint8> decoded;
+  timer.reset();
+  for (int i = 0; i < iterations; ++i)
+  {
+    if (!referenceDecode(codecData, codecLength, frame, decoded))
+    {
+      CERR << "Error: reference decompression failed" << OFendl;
+      return OFFalse;
+    }
+  }
+  printResult("decode, byte-by-byte reference", timer.getDiff(), iterations, frameSize);
+  if ((decoded.size() != frameSize) || (memcmp(&decoded[0], &frame.pixels[0], frameSize) != 0))
+  {
+    CERR << "Error: reference decoder output differs from original" << OFendl;
+    return OFFalse;
+  }
+  COUT << "  compressed size: " << codecLength << " bytes" << OFendl;
+  return OFTrue;
+}
+
+
+int main(int argc, char *argv[])
+{
+  int iterations = DEFAULT_ITERATIONS;
+  if (argc > 1)
+  {
+    iterations = atoi(argv[1]);
+    if ((argc > 2) || (iterations < 1))
+    {
+      CERR << "Usage: " << argv[0] << " [iterations]" << OFendl;
+      return 1;
+    }
+  }
+
+  if (!dcmDataDict.isDictionaryLoaded())
+  {
+    CERR << "Warning: no data dictionary loaded, "
+         << "check environment variable: "
+         << DCM_DICT_ENVIRONMENT_VARIABLE << OFendl;
+  }
+
+  DcmRLEEncoderRegistration::registerCodecs();
+  DcmRLEDecoderRegistration::registerCodecs();
+
+  BenchmarkFrame ct;
+  BenchmarkFrame rgb;
+  createCTFrame(ct);
+  createRGBFrame(rgb);
+  const OFBool ok = runBenchmark(ct, iterations) && runBenchmark(rgb, iterations);
+
+  DcmRLEEncoderRegistration::cleanup();
+  DcmRLEDecoderRegistration::cleanup();
+  return ok ? 0 : 1;
+}
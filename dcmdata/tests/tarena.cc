@@ -0,0 +1,196 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: test program for class DcmMemoryArena
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcarena.h"
+
+#define ITEMS 50
+
+
+OFTEST(dcmdata_memoryArena)
+{
+  DcmMemoryArena *arena = new DcmMemoryArena(1024);
+  void *blocks[100];
+
+  // blocks from the heap do not touch the arena
+  void *heapBlock = DcmMemoryArena::allocate(24, NULL);
+  OFCHECK(heapBlock != NULL);
+  DcmMemoryArena::deallocate(heapBlock);
+  DcmMemoryArena::deallocate(NULL);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    blocks[i] = DcmMemoryArena::allocate(40, arena);
+    memset(blocks[i], i, 40);
+  }
+  OFCHECK_EQUAL(arena->getNumberOfAllocations(), 100);
+  OFCHECK_EQUAL(arena->getNumberOfLiveObjects(), 100);
+  // 100 blocks of 48 bytes (after alignment) fit into 5 chunks of 1024 bytes
+  OFCHECK_EQUAL(arena->getNumberOfChunks(), 5);
+  // blocks must not overlap and must be aligned
+  for (int i = 0; i < 100; ++i)
+  {
+    OFCHECK_EQUAL(*OFstatic_cast(Uint8 *, blocks[i]), i);
+    OFCHECK_EQUAL(OFreinterpret_cast(size_t, blocks[i]) % 8, 0);
+  }
+
+  // blocks larger than a chunk get a chunk of their own
+  void *large = DcmMemoryArena::allocate(5000, arena);
+  memset(large, 0xff, 5000);
+  OFCHECK_EQUAL(arena->getNumberOfChunks(), 6);
+
+  // once all blocks are gone, the chunks are reused
+  for (int i = 0; i < 100; ++i)
+    DcmMemoryArena::deallocate(blocks[i]);
+  DcmMemoryArena::deallocate(large);
+  OFCHECK_EQUAL(arena->getNumberOfLiveObjects(), 0);
+  OFCHECK_EQUAL(arena->getNumberOfChunks(), 5);
+  for (int i = 0; i < 100; ++i)
+    blocks[i] = DcmMemoryArena::allocate(40, arena);
+  OFCHECK_EQUAL(arena->getNumberOfChunks(), 5);
+  OFCHECK_EQUAL(arena->getNumberOfAllocations(), 201);
+
+  // the arena survives the release as long as blocks or references are left
+  arena->addReference();
+  arena->release();
+  arena->release();
+  for (int i = 0; i < 100; ++i)
+    DcmMemoryArena::deallocate(blocks[i]);
+}
+
+
+OFTEST(dcmdata_memoryArenaObjects)
+{
+  DcmMemoryArena *arena = new DcmMemoryArena();
+  DcmTagKey tag(DCM_Rows);
+
+  // objects from the arena and from the heap can be mixed
+  DcmObject *arenaObject = new (arena) DcmUnsignedShort(tag);
+  DcmObject *heapObject = new DcmUnsignedShort(tag);
+  DcmObject *nullArenaObject = new (OFstatic_cast(DcmMemoryArena *, NULL)) DcmUnsignedShort(tag);
+  OFCHECK_EQUAL(arena->getNumberOfLiveObjects(), 1);
+  delete heapObject;
+  delete nullArenaObject;
+  OFCHECK_EQUAL(arena->getNumberOfLiveObjects(), 1);
+  delete arenaObject;
+  OFCHECK_EQUAL(arena->getNumberOfLiveObjects(), 0);
+
+  // the global nothrow and placement forms of operator new are still available
+  DcmObject *nothrowObject = new (std::nothrow) DcmUnsignedShort(tag);
+  OFCHECK(nothrowObject != NULL);
+  delete nothrowObject;
+  void *buffer = ::operator new(sizeof(DcmUnsignedShort));
+  DcmUnsignedShort *placedObject = new (buffer) DcmUnsignedShort(tag);
+  OFCHECK(OFstatic_cast(void *, placedObject) == buffer);
+  placedObject->~DcmUnsignedShort();
+  ::operator delete(buffer);
+  OFCHECK_EQUAL(arena->getNumberOfAllocations(), 1);
+  arena->release();
+}
+
+
+/* create a dataset with nested sequences */
+static void createDataset(DcmDataset& dset)
+{
+  DcmItem *item = NULL;
+  DcmItem *subItem = NULL;
+  OFCHECK(dset.putAndInsertString(DCM_SOPClassUID, UID_ComprehensiveSRStorage).good());
+  OFCHECK(dset.putAndInsertString(DCM_PatientName, "Doe^John").good());
+  for (int i = 0; i < ITEMS; ++i)
+  {
+    OFCHECK(dset.findOrCreateSequenceItem(DCM_ContentSequence, item, -2).good());
+    OFCHECK(item->putAndInsertString(DCM_RelationshipType, "CONTAINS").good());
+    OFCHECK(item->putAndInsertString(DCM_ValueType, "NUM").good());
+    OFCHECK(item->findOrCreateSequenceItem(DCM_ConceptNameCodeSequence, subItem).good());
+    OFCHECK(subItem->putAndInsertString(DCM_CodeValue, "121206").good());
+    OFCHECK(subItem->putAndInsertString(DCM_CodingSchemeDesignator, "DCM").good());
+    OFCHECK(subItem->putAndInsertString(DCM_CodeMeaning, "Distance").good());
+    OFCHECK(item->findOrCreateSequenceItem(DCM_MeasuredValueSequence, subItem).good());
+    OFCHECK(subItem->putAndInsertFloat64(DCM_FloatingPointValue, i * 0.5).good());
+  }
+}
+
+
+OFTEST(dcmdata_memoryArenaDataset)
+{
+  OFTempFile temp;
+  if (temp.getStatus().bad())
+  {
+    OFCHECK_FAIL("Could not create temporary file: " << temp.getStatus().text());
+    return;
+  }
+  DcmFileFormat source;
+  createDataset(*source.getDataset());
+  OFCHECK(source.saveFile(temp.getFilename(), EXS_LittleEndianExplicit).good());
+
+  DcmFileFormat dfile;
+  DcmDataset *dset = dfile.getDataset();
+  OFCHECK(dset->getMemoryArena() == NULL);
+  dset->enableMemoryArena();
+  DcmMemoryArena *arena = dset->getMemoryArena();
+  OFCHECK(arena != NULL);
+  OFCHECK(dfile.loadFile(temp.getFilename()).good());
+
+  // every element, item and list node of the dataset is taken from the arena
+  OFCHECK(arena->getNumberOfLiveObjects() > ITEMS * 20);
+  OFCHECK(arena->getNumberOfChunks() < arena->getNumberOfLiveObjects() / 100);
+
+  // the content is the same as without arena
+  OFOStringStream original, copy;
+  source.getDataset()->print(original);
+  dset->print(copy);
+  OFSTRINGSTREAM_GETOFSTRING(original, originalString)
+  OFSTRINGSTREAM_GETOFSTRING(copy, copyString)
+  OFCHECK_EQUAL(originalString, copyString);
+  Float64 value = 0;
+  OFCHECK(dset->findAndGetFloat64(DCM_FloatingPointValue, value, 0, OFTrue /* searchIntoSub */).good());
+  OFCHECK_EQUAL(value, 0.0);
+
+  // loading the file again reuses the chunks
+  const size_t chunks = arena->getNumberOfChunks();
+  OFCHECK(dfile.loadFile(temp.getFilename()).good());
+  OFCHECK_EQUAL(arena->getNumberOfChunks(), chunks);
+
+  // copies do not share the arena
+  DcmDataset dsetCopy(*dset);
+  OFCHECK(dsetCopy.getMemoryArena() == NULL);
+
+  // objects removed from the dataset survive the dataset
+  DcmElement *sequence = dset->remove(DCM_ContentSequence);
+  OFCHECK(sequence != NULL);
+  dfile.clear();
+  dset->enableMemoryArena(OFFalse);
+  OFCHECK(dset->getMemoryArena() == NULL);
+  if (sequence != NULL)
+  {
+    OFCHECK_EQUAL(OFstatic_cast(DcmSequenceOfItems *, sequence)->card(), ITEMS);
+    delete sequence;
+  }
+
+  // without arena, elements are allocated from the heap again
+  OFCHECK(dfile.loadFile(temp.getFilename()).good());
+  OFCHECK(dset->findAndGetFloat64(DCM_FloatingPointValue, value, 0, OFTrue /* searchIntoSub */).good());
+}
@@ -0,0 +1,434 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: test program for sequential and parallel multi-frame compression
+ *           and decompression
+ *
+ */
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dccodec.h"    /* for class DcmCodec */
+#include "dcmtk/dcmdata/dcpixseq.h"   /* for class DcmPixelSequence */
+#include "dcmtk/dcmdata/dcpxitem.h"   /* for class DcmPixelItem */
+#include "dcmtk/dcmdata/dcrleerg.h"   /* for class DcmRLEEncoderRegistration */
+#include "dcmtk/dcmdata/dcrledrg.h"   /* for class DcmRLEDecoderRegistration */
+#include "dcmtk/dcmdata/dcrleenc.h"   /* for class DcmRLEEncoder */
+#include "dcmtk/dcmdata/dcrledec.h"   /* for class DcmRLEDecoder */
+
+#define ROWS 48
+#define COLUMNS 64
+#define FRAMES 7
+#define SAMPLES 3
+
+
+/* helper class providing access to the static helper methods of DcmCodec */
+class DcmCodecTestHelper: public DcmCodec
+{
+public:
+  using DcmCodec::determineFrameFragments;
+};
+
+
+/* frame decompression task that stores the number of fragments of each frame */
+class DcmFrameTaskTestHelper: public DcmEncapsulatedFrameDecompressionTask
+{
+public:
+  DcmFrameTaskTestHelper(
+    const OFVector<Uint8 *>& fragmentData,
+    const OFVector<Uint32>& fragmentLength,
+    const OFVector<Uint32>& startFragments,
+    Uint8 *imageData8)
+  : DcmEncapsulatedFrameDecompressionTask(fragmentData, fragmentLength, startFragments, imageData8, 1, 2)
+  {
+  }
+
+protected:
+  virtual OFCondition decodeFrame(Uint32 /* frameNo */, Uint32 /* threadNo */, Uint32& currentItem, Uint32 endItem, Uint8 *frameData)
+  {
+    Uint8 *data = NULL;
+    Uint32 length = 0;
+    Uint8 fragments = 0;
+    while (getFragment(currentItem, endItem, data, length).good()) ++fragments;
+    *frameData = fragments;
+    return EC_Normal;
+  }
+};
+
+
+/* add a pixel item with the given content to the pixel sequence */
+static void addFragment(DcmPixelSequence *pixSeq, const Uint8 *data, Uint32 length)
+{
+  DcmPixelItem *pixItem = new DcmPixelItem(DCM_PixelItemTag);
+  OFCHECK(pixItem->putUint8Array(data, length).good());
+  OFCHECK(pixSeq->insert(pixItem).good());
+}
+
+
+/* create a multi-frame RGB image with 16 bits per sample and pseudo-random pixel data */
+static void createImage(DcmDataset& dset, OFVector<Uint16>& pixels)
+{
+  const size_t count = OFstatic_cast(size_t, ROWS) * COLUMNS * SAMPLES * FRAMES;
+  Uint32 seed = 4711;
+  pixels.clear();
+  pixels.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    seed = seed * 1103515245 + 12345;
+    // mix random values with runs so that the RLE encoder produces both run types
+    pixels.push_back(OFstatic_cast(Uint16, ((i / 37) % 3 == 0) ? (i / 37) : (seed >> 16)));
+  }
+  OFCHECK(dset.putAndInsertString(DCM_SOPClassUID, UID_MultiframeTrueColorSecondaryCaptureImageStorage).good());
+  OFCHECK(dset.putAndInsertString(DCM_SOPInstanceUID, "1.2.276.0.7230010.3.1.4.0.1").good());
+  OFCHECK(dset.putAndInsertUint16(DCM_SamplesPerPixel, SAMPLES).good());
+  OFCHECK(dset.putAndInsertString(DCM_PhotometricInterpretation, "RGB").good());
+  OFCHECK(dset.putAndInsertUint16(DCM_PlanarConfiguration, 0).good());
+  OFCHECK(dset.putAndInsertString(DCM_NumberOfFrames, "7").good());
+  OFCHECK(dset.putAndInsertUint16(DCM_Rows, ROWS).good());
+  OFCHECK(dset.putAndInsertUint16(DCM_Columns, COLUMNS).good());
+  OFCHECK(dset.putAndInsertUint16(DCM_BitsAllocated, 16).good());
+  OFCHECK(dset.putAndInsertUint16(DCM_BitsStored, 16).good());
+  OFCHECK(dset.putAndInsertUint16(DCM_HighBit, 15).good());
+  OFCHECK(dset.putAndInsertUint16(DCM_PixelRepresentation, 0).good());
+  OFCHECK(dset.putAndInsertUint16Array(DCM_PixelData, &pixels[0], OFstatic_cast(unsigned long, count)).good());
+}
+
+
+/* decompress a copy of the given RLE compressed dataset and compare the result */
+static void checkDecompression(const DcmDataset& compressed, const OFVector<Uint16>& pixels, Uint32 numberOfThreads)
+{
+  DcmDataset dset(compressed);
+  dcmDecompressionThreads.set(numberOfThreads);
+  OFCHECK(dset.chooseRepresentation(EXS_LittleEndianExplicit, NULL).good());
+  dcmDecompressionThreads.set(1);
+  OFCHECK(dset.canWriteXfer(EXS_LittleEndianExplicit));
+
+  const Uint16 *data = NULL;
+  unsigned long count = 0;
+  OFCHECK(dset.findAndGetUint16Array(DCM_PixelData, data, &count).good());
+  OFCHECK_EQUAL(count, pixels.size());
+  if ((data != NULL) && (count == pixels.size()))
+  {
+    size_t mismatch = 0;
+    while ((mismatch < count) && (data[mismatch] == pixels[mismatch])) ++mismatch;
+    OFCHECK_EQUAL(mismatch, pixels.size());
+  }
+}
+
+
+/* compress an image with RLE using the given encoder settings, then decompress
+ * it sequentially and in parallel
+ */
+static void testRLEDecompression(Uint32 fragmentSize, OFBool createOffsetTable)
+{
+  DcmRLEEncoderRegistration::registerCodecs(OFFalse, fragmentSize, createOffsetTable);
+  DcmRLEDecoderRegistration::registerCodecs();
+
+  DcmDataset dset;
+  OFVector<Uint16> pixels;
+  createImage(dset, pixels);
+  OFCHECK(dset.chooseRepresentation(EXS_RLELossless, NULL).good());
+  OFCHECK(dset.canWriteXfer(EXS_RLELossless));
+  dset.removeAllButCurrentRepresentations();
+
+  // check that the encoder settings produced the expected fragment layout
+  DcmElement *elem = NULL;
+  DcmPixelSequence *pixSeq = NULL;
+  E_TransferSyntax xfer = EXS_Unknown;
+  const DcmRepresentationParameter *param = NULL;
+  OFCHECK(dset.findAndGetElement(DCM_PixelData, elem).good());
+  if (elem != NULL)
+  {
+    OFstatic_cast(DcmPixelData *, elem)->getCurrentRepresentationKey(xfer, param);
+    OFCHECK(OFstatic_cast(DcmPixelData *, elem)->getEncapsulatedRepresentation(xfer, param, pixSeq).good());
+  }
+  if (pixSeq != NULL)
+  {
+    if (fragmentSize == 0)
+      OFCHECK_EQUAL(pixSeq->card(), FRAMES + 1);
+    else
+      OFCHECK(pixSeq->card() > FRAMES + 1);
+  }
+
+  checkDecompression(dset, pixels, 1);
+  checkDecompression(dset, pixels, 3);
+  checkDecompression(dset, pixels, FRAMES + 2);
+
+  DcmRLEEncoderRegistration::cleanup();
+  DcmRLEDecoderRegistration::cleanup();
+}
+
+
+/* compress an image with RLE using the given number of threads and return
+ * the compressed pixel sequence
+ */
+static void compressRLE(DcmDataset& dset, Uint32 fragmentSize, Uint32 numberOfThreads, DcmPixelSequence *&pixSeq)
+{
+  DcmRLEEncoderRegistration::registerCodecs(OFFalse, fragmentSize, OFTrue, OFFalse, numberOfThreads);
+  OFCHECK(dset.chooseRepresentation(EXS_RLELossless, NULL).good());
+  OFCHECK(dset.canWriteXfer(EXS_RLELossless));
+  dset.removeAllButCurrentRepresentations();
+  DcmRLEEncoderRegistration::cleanup();
+
+  DcmElement *elem = NULL;
+  E_TransferSyntax xfer = EXS_Unknown;
+  const DcmRepresentationParameter *param = NULL;
+  pixSeq = NULL;
+  OFCHECK(dset.findAndGetElement(DCM_PixelData, elem).good());
+  if (elem != NULL)
+  {
+    OFstatic_cast(DcmPixelData *, elem)->getCurrentRepresentationKey(xfer, param);
+    OFCHECK(OFstatic_cast(DcmPixelData *, elem)->getEncapsulatedRepresentation(xfer, param, pixSeq).good());
+  }
+}
+
+
+/* compress an image with RLE sequentially and in parallel and compare the results */
+static void testRLECompression(Uint32 fragmentSize)
+{
+  DcmRLEDecoderRegistration::registerCodecs();
+
+  OFVector<Uint16> pixels;
+  DcmDataset sequential;
+  createImage(sequential, pixels);
+  DcmPixelSequence *sequentialSeq = NULL;
+  compressRLE(sequential, fragmentSize, 1, sequentialSeq);
+
+  const Uint32 threads[2] = { 3, FRAMES + 2 };
+  for (size_t t = 0; t < 2; ++t)
+  {
+    DcmDataset parallel;
+    createImage(parallel, pixels);
+    DcmPixelSequence *parallelSeq = NULL;
+    compressRLE(parallel, fragmentSize, threads[t], parallelSeq);
+
+    // both pixel sequences (including the offset table) must be identical
+    OFCHECK(sequentialSeq != NULL);
+    OFCHECK(parallelSeq != NULL);
+    if ((sequentialSeq != NULL) && (parallelSeq != NULL))
+    {
+      OFCHECK_EQUAL(parallelSeq->card(), sequentialSeq->card());
+      if (parallelSeq->card() == sequentialSeq->card())
+      {
+        for (unsigned long i = 0; i < sequentialSeq->card(); ++i)
+        {
+          DcmPixelItem *seqItem = NULL;
+          DcmPixelItem *parItem = NULL;
+          Uint8 *seqData = NULL;
+          Uint8 *parData = NULL;
+          OFCHECK(sequentialSeq->getItem(seqItem, i).good());
+          OFCHECK(parallelSeq->getItem(parItem, i).good());
+          if ((seqItem != NULL) && (parItem != NULL))
+          {
+            OFCHECK_EQUAL(parItem->getLength(), seqItem->getLength());
+            seqItem->getUint8Array(seqData);
+            parItem->getUint8Array(parData);
+            if ((seqData != NULL) && (parData != NULL) && (parItem->getLength() == seqItem->getLength()))
+              OFCHECK(memcmp(seqData, parData, seqItem->getLength()) == 0);
+          }
+        }
+      }
+    }
+
+    checkDecompression(parallel, pixels, 1);
+  }
+
+  DcmRLEDecoderRegistration::cleanup();
+}
+
+
+OFTEST(dcmdata_codec_determineFrameFragments)
+{
+  const Uint8 fragment[32] = { 0 };
+  OFVector<Uint32> startFragments;
+
+  // one fragment per frame, empty offset table
+  DcmPixelSequence simpleSeq(DCM_PixelSequenceTag);
+  addFragment(&simpleSeq, NULL, 0);
+  addFragment(&simpleSeq, fragment, 10);
+  addFragment(&simpleSeq, fragment, 20);
+  addFragment(&simpleSeq, fragment, 6);
+  OFCHECK(DcmCodecTestHelper::determineFrameFragments(3, &simpleSeq, startFragments).good());
+  OFCHECK_EQUAL(startFragments.size(), 4);
+  if (startFragments.size() == 4)
+  {
+    OFCHECK_EQUAL(startFragments[0], 1);
+    OFCHECK_EQUAL(startFragments[1], 2);
+    OFCHECK_EQUAL(startFragments[2], 3);
+    OFCHECK_EQUAL(startFragments[3], 4);
+  }
+
+  // multiple fragments per frame without offset table cannot be handled
+  OFCHECK(DcmCodecTestHelper::determineFrameFragments(2, &simpleSeq, startFragments).bad());
+  OFCHECK(startFragments.empty());
+
+  // more frames than fragments
+  OFCHECK(DcmCodecTestHelper::determineFrameFragments(4, &simpleSeq, startFragments).bad());
+
+  // multiple fragments per frame with offset table: frame 1 starts at fragment 3,
+  // i.e. at offset (10 + 8) + (20 + 8) = 46
+  DcmPixelSequence tableSeq(DCM_PixelSequenceTag);
+  const Uint8 offsetTable[8] = { 0, 0, 0, 0, 46, 0, 0, 0 };
+  addFragment(&tableSeq, offsetTable, 8);
+  addFragment(&tableSeq, fragment, 10);
+  addFragment(&tableSeq, fragment, 20);
+  addFragment(&tableSeq, fragment, 6);
+  addFragment(&tableSeq, fragment, 8);
+  OFCHECK(DcmCodecTestHelper::determineFrameFragments(2, &tableSeq, startFragments).good());
+  OFCHECK_EQUAL(startFragments.size(), 3);
+  if (startFragments.size() == 3)
+  {
+    OFCHECK_EQUAL(startFragments[0], 1);
+    OFCHECK_EQUAL(startFragments[1], 3);
+    OFCHECK_EQUAL(startFragments[2], 5);
+  }
+
+  // offset table with an offset that does not point to the start of a fragment
+  DcmPixelSequence badSeq(DCM_PixelSequenceTag);
+  const Uint8 badOffsetTable[8] = { 0, 0, 0, 0, 40, 0, 0, 0 };
+  addFragment(&badSeq, badOffsetTable, 8);
+  addFragment(&badSeq, fragment, 10);
+  addFragment(&badSeq, fragment, 20);
+  addFragment(&badSeq, fragment, 6);
+  OFCHECK(DcmCodecTestHelper::determineFrameFragments(2, &badSeq, startFragments).bad());
+}
+
+
+OFTEST(dcmdata_codec_frameDecompressionTask)
+{
+  Uint8 fragment[4] = { 0 };
+  Uint8 frames[3] = { 0 };
+  OFVector<Uint8 *> fragmentData(5, fragment);
+  OFVector<Uint32> fragmentLength(5, 4);
+  OFVector<Uint32> startFragments;
+  startFragments.push_back(1);
+  startFragments.push_back(3);
+  startFragments.push_back(4);
+  startFragments.push_back(7); // beyond the last fragment
+  DcmFrameTaskTestHelper task(fragmentData, fragmentLength, startFragments, frames);
+
+  OFCHECK(task.decompressFrame(0, 0).good());
+  OFCHECK_EQUAL(frames[0], 2);
+  OFCHECK(task.decompressFrame(1, 1).good());
+  OFCHECK_EQUAL(frames[1], 1);
+
+  // the end of the last frame is limited to the number of fragments
+  OFCHECK(task.decompressFrame(2, 0).good());
+  OFCHECK_EQUAL(frames[2], 1);
+
+  // invalid frame and thread numbers
+  OFCHECK(task.decompressFrame(3, 0).bad());
+  OFCHECK(task.decompressFrame(0, 2).bad());
+
+  // start fragment beyond the last fragment
+  Uint32 currentItem = 5;
+  OFCHECK(task.decompressFrameAt(2, 0, currentItem, 7) == EC_CorruptedData);
+}
+
+
+OFTEST(dcmdata_codec_parallelRLEDecompression)
+{
+  // one fragment per frame
+  testRLEDecompression(0, OFTrue);
+  // multiple fragments per frame with offset table
+  testRLEDecompression(1, OFTrue);
+  // multiple fragments per frame without offset table (sequential fallback)
+  testRLEDecompression(1, OFFalse);
+}
+
+
+OFTEST(dcmdata_codec_parallelRLECompression)
+{
+  // one fragment per frame
+  testRLECompression(0);
+  // multiple fragments per frame
+  testRLECompression(1);
+}
+
+
+OFTEST(dcmdata_codec_RLEEncoderDecoder)
+{
+  // create a byte stream with literal runs and replicate runs of various
+  // lengths, including runs longer than the 128 bytes of a single PackBits run
+  OFVector<unsigned char> input;
+  Uint32 seed = 815;
+  const size_t runLengths[] = { 1, 2, 3, 127, 128, 129, 130, 300, 1000, 5 };
+  for (size_t r = 0; r < 200; ++r)
+  {
+    seed = seed * 1103515245 + 12345;
+    const size_t length = runLengths[(seed >> 16) % 10];
+    if ((seed >> 8) & 1)
+    {
+      const unsigned char value = OFstatic_cast(unsigned char, seed >> 24);
+      for (size_t i = 0; i < length; ++i) input.push_back(value);
+    }
+    else
+    {
+      for (size_t i = 0; i < length; ++i)
+      {
+        seed = seed * 1103515245 + 12345;
+        input.push_back(OFstatic_cast(unsigned char, seed >> 24));
+      }
+    }
+  }
+
+  // adding bytes one by one and as a block must produce the same stream
+  DcmRLEEncoder singleEncoder(1);
+  for (size_t i = 0; i < input.size(); ++i) singleEncoder.add(input[i]);
+  singleEncoder.flush();
+  DcmRLEEncoder blockEncoder(1);
+  blockEncoder.add(&input[0], input.size());
+  blockEncoder.flush();
+  OFCHECK(!singleEncoder.fail());
+  OFCHECK(!blockEncoder.fail());
+  OFCHECK_EQUAL(blockEncoder.size(), singleEncoder.size());
+  OFCHECK_EQUAL(blockEncoder.size() % 2, 0);
+  OFVector<unsigned char> singleStream(singleEncoder.size());
+  OFVector<unsigned char> compressed(blockEncoder.size());
+  singleEncoder.write(&singleStream[0]);
+  blockEncoder.write(&compressed[0]);
+  if (singleStream.size() == compressed.size())
+    OFCHECK(memcmp(&singleStream[0], &compressed[0], compressed.size()) == 0);
+
+  // decompress the stream at once and in small chunks (which suspends the
+  // decoder in the middle of runs) and compare with the original data
+  const size_t chunkSizes[] = { compressed.size(), 1, 2, 7, 129 };
+  for (size_t c = 0; c < 5; ++c)
+  {
+    DcmRLEDecoder decoder(input.size());
+    size_t pos = 0;
+    while (pos < compressed.size())
+    {
+      size_t chunk = chunkSizes[c];
+      if (chunk > compressed.size() - pos) chunk = compressed.size() - pos;
+      OFCondition cond = decoder.decompress(&compressed[pos], chunk);
+      OFCHECK(cond.good() || (cond == EC_StreamNotifyClient));
+      pos += chunk;
+    }
+    OFCHECK(!decoder.fail());
+    OFCHECK_EQUAL(decoder.size(), input.size());
+    if (decoder.size() == input.size())
+      OFCHECK(memcmp(decoder.getOutputBuffer(), &input[0], input.size()) == 0);
+  }
+
+  // a too small output buffer is reported as corrupted data
+  DcmRLEDecoder smallDecoder(input.size() - 1);
+  OFCHECK(smallDecoder.decompress(&compressed[0], compressed.size()) == EC_CorruptedData);
+  OFCHECK(smallDecoder.fail());
+}
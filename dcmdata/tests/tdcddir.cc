@@ -0,0 +1,452 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: test program for parallel loading and incremental writing
+ *           of DICOMDIR files
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/ofstd/oflist.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcddirif.h"
+
+#ifdef HAVE_WINDOWS_H
+#include <direct.h>      /* for _rmdir() */
+#define rmdir _rmdir
+#elif defined(HAVE_UNISTD_H)
+#include <unistd.h>      /* for rmdir() */
+#endif
+
+
+#define DICOMDIR_NAME "DDTEST.DIR"
+#define DICOMDIR_FULL "DDFULL.DIR"
+#define NUMBER_OF_FILES 24
+
+
+/* return the name of the n-th test file */
+static OFFilename testFilename(const unsigned int n)
+{
+  char buffer[16];
+  OFStandard::snprintf(buffer, sizeof(buffer), "DDTEST%02u", n);
+  return buffer;
+}
+
+
+/* a temporary directory for the files of a single test, so that the tests
+ * do not interfere when run in parallel. The test files and DICOMDIR files
+ * are deleted together with the directory.
+ */
+class DicomDirTestDirectory
+{
+public:
+  DicomDirTestDirectory()
+  : temp_()
+  , directory_(OFString(temp_.getFilename()) + ".d")
+  , good_(OFStandard::createDirectory(directory_, OFFilename()).good())
+  {
+    if (!good_)
+      OFCHECK_FAIL("Could not create temporary directory: " << directory_);
+  }
+
+  ~DicomDirTestDirectory()
+  {
+    for (unsigned int n = 0; n < NUMBER_OF_FILES; ++n)
+      OFStandard::deleteFile(path(testFilename(n)));
+    OFStandard::deleteFile(path(DICOMDIR_NAME));
+    OFStandard::deleteFile(path(DICOMDIR_NAME ".BAK"));
+    OFStandard::deleteFile(path(DICOMDIR_FULL));
+    OFStandard::deleteFile(path(DICOMDIR_FULL ".BAK"));
+    if (good_)
+      rmdir(directory_.getCharPointer());
+  }
+
+  OFBool good() const
+  {
+    return good_;
+  }
+
+  const OFFilename &directory() const
+  {
+    return directory_;
+  }
+
+  /* return the path of the given file within the directory */
+  OFFilename path(const OFFilename &filename) const
+  {
+    OFFilename result;
+    OFStandard::combineDirAndFilename(result, directory_, filename);
+    return result;
+  }
+
+private:
+  OFTempFile temp_;
+  OFFilename directory_;
+  OFBool good_;
+};
+
+
+/* create a small secondary capture image. The files are distributed over
+ * a few patients, studies and series, so that new records are added to
+ * existing ones and new ones are created.
+ */
+static void createTestFile(const DicomDirTestDirectory &dir,
+                           const unsigned int n)
+{
+  const unsigned int patient = n % 3;
+  const unsigned int study = (n / 3) % 2;
+  const unsigned int series = (n / 6) % 2;
+  char buffer[64];
+  DcmFileFormat fileformat;
+  DcmDataset *dset = fileformat.getDataset();
+  OFCHECK(dset->putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage).good());
+  OFStandard::snprintf(buffer, sizeof(buffer), "1.2.276.0.7230010.3.9.9.%u", n + 1);
+  OFCHECK(dset->putAndInsertString(DCM_SOPInstanceUID, buffer).good());
+  OFStandard::snprintf(buffer, sizeof(buffer), "Patient^%c", 'A' + patient);
+  OFCHECK(dset->putAndInsertString(DCM_PatientName, buffer).good());
+  OFStandard::snprintf(buffer, sizeof(buffer), "PID%u", patient);
+  OFCHECK(dset->putAndInsertString(DCM_PatientID, buffer).good());
+  OFStandard::snprintf(buffer, sizeof(buffer), "1.2.276.0.7230010.3.9.1.%u.%u", patient, study);
+  OFCHECK(dset->putAndInsertString(DCM_StudyInstanceUID, buffer).good());
+  OFCHECK(dset->putAndInsertString(DCM_StudyDate, "20240101").good());
+  OFCHECK(dset->putAndInsertString(DCM_StudyTime, "120000").good());
+  OFStandard::snprintf(buffer, sizeof(buffer), "%u", study + 1);
+  OFCHECK(dset->putAndInsertString(DCM_StudyID, buffer).good());
+  OFCHECK(dset->putAndInsertString(DCM_AccessionNumber, "").good());
+  OFCHECK(dset->putAndInsertString(DCM_StudyDescription, "DICOMDIR test").good());
+  OFStandard::snprintf(buffer, sizeof(buffer), "1.2.276.0.7230010.3.9.2.%u.%u.%u", patient, study, series);
+  OFCHECK(dset->putAndInsertString(DCM_SeriesInstanceUID, buffer).good());
+  OFCHECK(dset->putAndInsertString(DCM_Modality, "OT").good());
+  OFStandard::snprintf(buffer, sizeof(buffer), "%u", series + 1);
+  OFCHECK(dset->putAndInsertString(DCM_SeriesNumber, buffer).good());
+  OFStandard::snprintf(buffer, sizeof(buffer), "%u", n + 1);
+  OFCHECK(dset->putAndInsertString(DCM_InstanceNumber, buffer).good());
+  OFCHECK(dset->putAndInsertUint16(DCM_SamplesPerPixel, 1).good());
+  OFCHECK(dset->putAndInsertString(DCM_PhotometricInterpretation, "MONOCHROME2").good());
+  OFCHECK(dset->putAndInsertUint16(DCM_Rows, 4).good());
+  OFCHECK(dset->putAndInsertUint16(DCM_Columns, 4).good());
+  OFCHECK(dset->putAndInsertUint16(DCM_BitsAllocated, 8).good());
+  OFCHECK(dset->putAndInsertUint16(DCM_BitsStored, 8).good());
+  OFCHECK(dset->putAndInsertUint16(DCM_HighBit, 7).good());
+  OFCHECK(dset->putAndInsertUint16(DCM_PixelRepresentation, 0).good());
+  Uint8 pixels[16];
+  for (size_t i = 0; i < sizeof(pixels); ++i)
+    pixels[i] = OFstatic_cast(Uint8, n + i);
+  OFCHECK(dset->putAndInsertUint8Array(DCM_PixelData, pixels, sizeof(pixels)).good());
+  OFCHECK(fileformat.saveFile(dir.path(testFilename(n)), EXS_LittleEndianExplicit).good());
+}
+
+
+/* create the test files */
+static void createTestFiles(const DicomDirTestDirectory &dir,
+                            OFList<OFFilename> &filenames)
+{
+  for (unsigned int n = 0; n < NUMBER_OF_FILES; ++n)
+  {
+    createTestFile(dir, n);
+    filenames.push_back(testFilename(n));
+  }
+}
+
+
+/* check whether the given tag is one of the offsets, which depend on the order of the records */
+static OFBool isOffsetTag(const DcmTagKey &tag)
+{
+  return (tag == DCM_OffsetOfTheNextDirectoryRecord) ||
+         (tag == DCM_OffsetOfReferencedLowerLevelDirectoryEntity);
+}
+
+
+/* compare two directory records and all records below them */
+static void compareRecords(DcmDirectoryRecord &rec1, DcmDirectoryRecord &rec2)
+{
+  OFCHECK_EQUAL(rec1.getRecordType(), rec2.getRecordType());
+  OFCHECK_EQUAL(rec1.card(), rec2.card());
+  if (rec1.card() == rec2.card())
+  {
+    for (unsigned long i = 0; i < rec1.card(); ++i)
+    {
+      DcmElement *elem1 = rec1.getElement(i);
+      DcmElement *elem2 = rec2.getElement(i);
+      OFCHECK(elem1->getTag() == elem2->getTag());
+      if (!isOffsetTag(elem1->getTag()))
+      {
+        OFString value1, value2;
+        elem1->getOFStringArray(value1);
+        elem2->getOFStringArray(value2);
+        OFCHECK_EQUAL(value1, value2);
+      }
+    }
+  }
+  OFCHECK_EQUAL(rec1.cardSub(), rec2.cardSub());
+  if (rec1.cardSub() == rec2.cardSub())
+  {
+    for (unsigned long i = 0; i < rec1.cardSub(); ++i)
+      compareRecords(*rec1.getSub(i), *rec2.getSub(i));
+  }
+}
+
+
+/* compare the logical structure of two DICOMDIR files */
+static void compareDicomDirs(const DicomDirTestDirectory &dir,
+                             const OFFilename &filename1,
+                             const OFFilename &filename2)
+{
+  DcmDicomDir dicomdir1(dir.path(filename1));
+  DcmDicomDir dicomdir2(dir.path(filename2));
+  OFCHECK(dicomdir1.error().good());
+  OFCHECK(dicomdir2.error().good());
+  compareRecords(dicomdir1.getRootRecord(), dicomdir2.getRootRecord());
+}
+
+
+/* count the image records in a DICOMDIR file */
+static unsigned long countRecords(DcmDirectoryRecord &record)
+{
+  unsigned long count = (record.getRecordType() == ERT_Image) ? 1 : 0;
+  for (unsigned long i = 0; i < record.cardSub(); ++i)
+    count += countRecords(*record.getSub(i));
+  return count;
+}
+
+
+/* create a DICOMDIR from the given files */
+static void createDicomDir(const DicomDirTestDirectory &dir,
+                           const OFFilename &dicomdir,
+                           const OFList<OFFilename> &filenames,
+                           const unsigned int threads,
+                           const E_EncodingType enctype,
+                           const E_GrpLenEncoding glenc = EGL_withoutGL)
+{
+  DicomDirInterface ddir;
+  OFList<OFFilename> badFiles;
+  size_t goodFiles = 0;
+  OFCHECK(ddir.createNewDicomDir(DicomDirInterface::AP_GeneralPurpose, dir.path(dicomdir), "TESTSET").good());
+  OFCHECK(ddir.setNumberOfThreads(threads).good());
+  OFCHECK(ddir.addDicomFiles(filenames, dir.directory(), badFiles, goodFiles).good());
+  OFCHECK_EQUAL(goodFiles, filenames.size());
+  OFCHECK(badFiles.empty());
+  OFCHECK(ddir.writeDicomDir(enctype, glenc).good());
+}
+
+
+/* append to a DICOMDIR in several steps using the incremental mode and
+ * compare the result with a DICOMDIR that has been created in one step
+ */
+static void checkIncrementalAppend(const E_EncodingType enctype,
+                                   const OFBool inputDataCorrection = OFTrue)
+{
+  /* without automatic input data correction, the values of the existing
+   * records and of the files keep their trailing padding
+   */
+  const OFBool oldInputDataCorrection = dcmEnableAutomaticInputDataCorrection.get();
+  dcmEnableAutomaticInputDataCorrection.set(inputDataCorrection);
+  DicomDirTestDirectory dir;
+  OFList<OFFilename> filenames;
+  if (dir.good())
+    createTestFiles(dir, filenames);
+  OFList<OFFilename> first, second, third;
+  OFListConstIterator(OFFilename) iter = filenames.begin();
+  for (unsigned int n = 0; iter != filenames.end(); ++n, ++iter)
+  {
+    if (n < 5)
+      first.push_back(*iter);
+    else if (n < 14)
+      second.push_back(*iter);
+    else
+      third.push_back(*iter);
+  }
+  createDicomDir(dir, DICOMDIR_FULL, filenames, 1, enctype);
+  createDicomDir(dir, DICOMDIR_NAME, first, 1, enctype);
+
+  /* the directory record sequence of the original file */
+  DcmFileFormat original;
+  OFCHECK(original.loadFile(dir.path(DICOMDIR_NAME)).good());
+  DcmSequenceOfItems *originalSeq = NULL;
+  OFCHECK(original.getDataset()->findAndGetSequence(DCM_DirectoryRecordSequence, originalSeq).good());
+
+  /* append the second part, then the third part with the same object */
+  {
+    DicomDirInterface ddir;
+    OFList<OFFilename> badFiles;
+    size_t goodFiles = 0;
+    ddir.disableBackupMode();
+    OFCHECK(ddir.appendToDicomDir(DicomDirInterface::AP_GeneralPurpose, dir.path(DICOMDIR_NAME)).good());
+    OFCHECK(ddir.addDicomFiles(second, dir.directory(), badFiles, goodFiles).good());
+    OFCHECK_EQUAL(goodFiles, second.size());
+    OFCHECK(ddir.writeDicomDirIncremental(enctype).good());
+    OFCHECK(ddir.addDicomFiles(third, dir.directory(), badFiles, goodFiles).good());
+    OFCHECK_EQUAL(goodFiles, third.size());
+    OFCHECK(ddir.writeDicomDirIncremental(enctype).good());
+    OFCHECK(badFiles.empty());
+  }
+  compareDicomDirs(dir, DICOMDIR_NAME, DICOMDIR_FULL);
+  DcmDicomDir dicomdir(dir.path(DICOMDIR_NAME));
+  OFCHECK_EQUAL(countRecords(dicomdir.getRootRecord()), NUMBER_OF_FILES);
+
+  /* the existing records must be unchanged at the beginning of the file,
+   * i.e. the file has not been rewritten completely
+   */
+  DcmFileFormat appended;
+  OFCHECK(appended.loadFile(dir.path(DICOMDIR_NAME)).good());
+  DcmSequenceOfItems *appendedSeq = NULL;
+  OFCHECK(appended.getDataset()->findAndGetSequence(DCM_DirectoryRecordSequence, appendedSeq).good());
+  if ((originalSeq != NULL) && (appendedSeq != NULL))
+  {
+    OFCHECK(appendedSeq->card() > originalSeq->card());
+    for (unsigned long i = 0; (i < originalSeq->card()) && (i < appendedSeq->card()); ++i)
+    {
+      OFString id1, id2;
+      originalSeq->getItem(i)->findAndGetOFStringArray(DCM_ReferencedFileID, id1);
+      appendedSeq->getItem(i)->findAndGetOFStringArray(DCM_ReferencedFileID, id2);
+      OFCHECK_EQUAL(id1, id2);
+    }
+  }
+  dcmEnableAutomaticInputDataCorrection.set(oldInputDataCorrection);
+}
+
+
+OFTEST(dcmdata_dicomdirParallelLoading)
+{
+  const OFBool oldInputDataCorrection = dcmEnableAutomaticInputDataCorrection.get();
+  dcmEnableAutomaticInputDataCorrection.set(OFTrue);
+  DicomDirTestDirectory dir;
+  OFList<OFFilename> filenames;
+  if (dir.good())
+    createTestFiles(dir, filenames);
+  createDicomDir(dir, DICOMDIR_FULL, filenames, 1, EET_ExplicitLength);
+#ifdef WITH_THREADS
+  createDicomDir(dir, DICOMDIR_NAME, filenames, 4, EET_ExplicitLength);
+  compareDicomDirs(dir, DICOMDIR_NAME, DICOMDIR_FULL);
+  /* more threads than files */
+  OFList<OFFilename> two;
+  two.push_back(testFilename(0));
+  two.push_back(testFilename(1));
+  createDicomDir(dir, DICOMDIR_NAME, two, 8, EET_ExplicitLength);
+  DcmDicomDir dicomdir(dir.path(DICOMDIR_NAME));
+  OFCHECK_EQUAL(countRecords(dicomdir.getRootRecord()), 2);
+#else
+  DicomDirInterface ddir;
+  OFCHECK(ddir.setNumberOfThreads(4) == EC_IllegalCall);
+#endif
+  dcmEnableAutomaticInputDataCorrection.set(oldInputDataCorrection);
+}
+
+
+OFTEST(dcmdata_dicomdirParallelLoadingBadFiles)
+{
+  const OFBool oldInputDataCorrection = dcmEnableAutomaticInputDataCorrection.get();
+  dcmEnableAutomaticInputDataCorrection.set(OFTrue);
+  DicomDirTestDirectory dir;
+  OFList<OFFilename> filenames;
+  if (dir.good())
+    createTestFiles(dir, filenames);
+  /* replace one of the files by a non-DICOM file */
+  OFFile file;
+  OFCHECK(file.fopen(dir.path(testFilename(7)), "wb"));
+  OFCHECK(file.fputs("this is not a DICOM file") >= 0);
+  file.fclose();
+  for (unsigned int threads = 1; threads <= 4; threads += 3)
+  {
+    DicomDirInterface ddir;
+    OFList<OFFilename> badFiles;
+    size_t goodFiles = 0;
+    OFCHECK(ddir.createNewDicomDir(DicomDirInterface::AP_GeneralPurpose, dir.path(DICOMDIR_NAME), "TESTSET").good());
+    if (threads > 1 && ddir.setNumberOfThreads(threads).bad())
+      break;
+    /* bad files are reported and skipped */
+    OFCHECK(ddir.addDicomFiles(filenames, dir.directory(), badFiles, goodFiles).good());
+    OFCHECK_EQUAL(goodFiles, NUMBER_OF_FILES - 1);
+    OFCHECK_EQUAL(badFiles.size(), 1);
+    if (!badFiles.empty())
+      OFCHECK_EQUAL(OFString(badFiles.front().getCharPointer()), "DDTEST07");
+    /* processing stops at the bad file in abort mode */
+    badFiles.clear();
+    OFCHECK(ddir.createNewDicomDir(DicomDirInterface::AP_GeneralPurpose, dir.path(DICOMDIR_NAME), "TESTSET").good());
+    ddir.enableAbortMode();
+    OFCHECK(ddir.addDicomFiles(filenames, dir.directory(), badFiles, goodFiles).bad());
+    OFCHECK_EQUAL(goodFiles, 7);
+    OFCHECK_EQUAL(badFiles.size(), 1);
+  }
+  dcmEnableAutomaticInputDataCorrection.set(oldInputDataCorrection);
+}
+
+
+OFTEST(dcmdata_dicomdirIncrementalAppend)
+{
+  checkIncrementalAppend(EET_ExplicitLength);
+}
+
+
+OFTEST(dcmdata_dicomdirIncrementalAppendUndefinedLength)
+{
+  checkIncrementalAppend(EET_UndefinedLength);
+}
+
+
+OFTEST(dcmdata_dicomdirIncrementalAppendNoCorrection)
+{
+  /* trailing padding must not result in duplicate patient or study records */
+  checkIncrementalAppend(EET_ExplicitLength, OFFalse /* inputDataCorrection */);
+}
+
+
+OFTEST(dcmdata_dicomdirIncrementalAppendFallback)
+{
+  const OFBool oldInputDataCorrection = dcmEnableAutomaticInputDataCorrection.get();
+  dcmEnableAutomaticInputDataCorrection.set(OFTrue);
+  DicomDirTestDirectory dir;
+  OFList<OFFilename> filenames;
+  if (dir.good())
+    createTestFiles(dir, filenames);
+  OFList<OFFilename> first, second;
+  OFListConstIterator(OFFilename) iter = filenames.begin();
+  for (unsigned int n = 0; iter != filenames.end(); ++n, ++iter)
+  {
+    if (n < 10)
+      first.push_back(*iter);
+    else
+      second.push_back(*iter);
+  }
+  createDicomDir(dir, DICOMDIR_FULL, filenames, 1, EET_ExplicitLength, EGL_withGL);
+  /* a new DICOMDIR is written completely */
+  {
+    DicomDirInterface ddir;
+    OFList<OFFilename> badFiles;
+    size_t goodFiles = 0;
+    OFCHECK(ddir.createNewDicomDir(DicomDirInterface::AP_GeneralPurpose, dir.path(DICOMDIR_NAME), "TESTSET").good());
+    OFCHECK(ddir.addDicomFiles(first, dir.directory(), badFiles, goodFiles).good());
+    OFCHECK(ddir.writeDicomDirIncremental(EET_ExplicitLength).good());
+  }
+  /* group length elements cannot be appended */
+  {
+    DicomDirInterface ddir;
+    OFList<OFFilename> badFiles;
+    size_t goodFiles = 0;
+    ddir.disableBackupMode();
+    OFCHECK(ddir.appendToDicomDir(DicomDirInterface::AP_GeneralPurpose, dir.path(DICOMDIR_NAME)).good());
+    OFCHECK(ddir.addDicomFiles(second, dir.directory(), badFiles, goodFiles).good());
+    OFCHECK(ddir.writeDicomDirIncremental(EET_ExplicitLength, EGL_withGL).good());
+  }
+  compareDicomDirs(dir, DICOMDIR_NAME, DICOMDIR_FULL);
+  dcmEnableAutomaticInputDataCorrection.set(oldInputDataCorrection);
+}
@@ -0,0 +1,210 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: test program for the zlib (deflate) stream filters
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+
+#ifdef WITH_ZLIB
+
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcostrmb.h"
+#include "dcmtk/dcmdata/dcostrmz.h"
+#include "dcmtk/dcmdata/dcistrmz.h"
+
+#define TEST_DATA_SIZE 300001
+#define TEST_OUTPUT_SIZE 1000
+
+
+/* create compressible test data */
+static void createTestData(OFVector<unsigned char> &data)
+{
+  data.resize(TEST_DATA_SIZE);
+  Uint32 seed = 4711;
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    seed = seed * 1103515245 + 12345;
+    // a few distinct values with frequent repetitions
+    data[i] = OFstatic_cast(unsigned char, (i % 97 < 50) ? (i % 13) + 'a' : (seed >> 24) & 0x0f);
+  }
+}
+
+
+/* compress the given data through an output buffer stream with a small buffer,
+ * thereby forcing the compression filter to handle consumer suspension
+ */
+static OFBool compressData(const OFVector<unsigned char> &data, OFVector<unsigned char> &result)
+{
+  unsigned char buffer[TEST_OUTPUT_SIZE];
+  DcmOutputBufferStream out(buffer, TEST_OUTPUT_SIZE);
+  if (out.installCompressionFilter(ESC_zlib).bad()) return OFFalse;
+  void *block = NULL;
+  offile_off_t length = 0;
+  size_t offset = 0;
+  int rounds = 0;
+  while (out.good() && (offset < data.size()))
+  {
+    // write in chunks of odd size
+    offile_off_t chunk = 7777;
+    if (offset + chunk > data.size()) chunk = OFstatic_cast(offile_off_t, data.size() - offset);
+    offset += OFstatic_cast(size_t, out.write(&data[offset], chunk));
+    out.flushBuffer(block, length);
+    result.insert(result.end(), OFstatic_cast(unsigned char *, block), OFstatic_cast(unsigned char *, block) + length);
+    if (++rounds > 100000) return OFFalse;
+  }
+  out.flush();
+  while (out.good() && !out.isFlushed())
+  {
+    out.flushBuffer(block, length);
+    result.insert(result.end(), OFstatic_cast(unsigned char *, block), OFstatic_cast(unsigned char *, block) + length);
+    out.flush();
+    if (++rounds > 100000) return OFFalse;
+  }
+  out.flushBuffer(block, length);
+  result.insert(result.end(), OFstatic_cast(unsigned char *, block), OFstatic_cast(unsigned char *, block) + length);
+  return out.good();
+}
+
+
+/* decompress the given deflated bitstream directly with zlib
+ * and return the number of bytes in the result buffer
+ */
+static size_t inflateData(OFVector<unsigned char> &data, unsigned char *result, size_t resultSize)
+{
+  z_stream zstream;
+  zstream.zalloc = Z_NULL;
+  zstream.zfree = Z_NULL;
+  zstream.opaque = Z_NULL;
+  zstream.next_in = Z_NULL;
+  zstream.avail_in = 0;
+  if (inflateInit2(&zstream, -MAX_WBITS) != Z_OK) return 0;
+  zstream.next_in = &data[0];
+  zstream.avail_in = OFstatic_cast(uInt, data.size());
+  zstream.next_out = result;
+  zstream.avail_out = OFstatic_cast(uInt, resultSize);
+  const int zstatus = inflate(&zstream, Z_FINISH);
+  size_t count = resultSize - zstream.avail_out;
+  // the stream must be complete and must not be followed by any other data
+  if ((zstatus != Z_STREAM_END) || (zstream.avail_in > 0)) count = 0;
+  inflateEnd(&zstream);
+  return count;
+}
+
+
+/* compress the test data with the given number of threads and check the result */
+static void checkDeflateStream(Uint32 numThreads)
+{
+  OFVector<unsigned char> data;
+  OFVector<unsigned char> compressed;
+  createTestData(data);
+  dcmZlibCompressionThreads.set(numThreads);
+  dcmZlibParallelBlockSize.set(0); // minimum block size, i.e. several batches
+  const OFBool compressOK = compressData(data, compressed);
+  dcmZlibCompressionThreads.set(1);
+  dcmZlibParallelBlockSize.set(131072);
+  OFCHECK(compressOK);
+  if (!compressOK) return;
+  OFCHECK(compressed.size() > 0);
+  OFCHECK(compressed.size() < data.size() / 2);
+  unsigned char *decompressed = new unsigned char[TEST_DATA_SIZE + 1];
+  const size_t count = inflateData(compressed, decompressed, TEST_DATA_SIZE + 1);
+  OFCHECK_EQUAL(count, data.size());
+  if (count == data.size())
+    OFCHECK(memcmp(decompressed, &data[0], count) == 0);
+  delete[] decompressed;
+}
+
+
+/* save the given dataset deflated, read it back and compare it to the original */
+static void checkDeflatedFile(DcmDataset &dset, Uint32 bufferSize, Uint32 numThreads)
+{
+  OFTempFile temp;
+  if (temp.getStatus().bad())
+  {
+    OFCHECK_FAIL("Could not create temporary file: " << temp.getStatus().text());
+    return;
+  }
+  dcmZlibInputBufferSize.set(bufferSize);
+  dcmZlibOutputBufferSize.set(bufferSize);
+  dcmZlibCompressionThreads.set(numThreads);
+  DcmFileFormat fileformat(&dset);
+  OFCondition cond = fileformat.saveFile(temp.getFilename(), EXS_DeflatedLittleEndianExplicit);
+  DcmFileFormat result;
+  if (cond.good()) cond = result.loadFile(temp.getFilename());
+  if (cond.good()) cond = result.loadAllDataIntoMemory();
+  dcmZlibInputBufferSize.set(65536);
+  dcmZlibOutputBufferSize.set(65536);
+  dcmZlibCompressionThreads.set(1);
+  if (cond.bad())
+  {
+    OFCHECK_FAIL(cond.text());
+    return;
+  }
+  OFCHECK_EQUAL(result.getDataset()->getOriginalXfer(), EXS_DeflatedLittleEndianExplicit);
+  OFCHECK_EQUAL(result.getDataset()->compare(dset), 0);
+}
+
+#endif
+
+
+OFTEST(dcmdata_deflateStream)
+{
+#ifdef WITH_ZLIB
+  checkDeflateStream(1);
+#endif
+}
+
+OFTEST(dcmdata_deflateStreamParallel)
+{
+#ifdef WITH_ZLIB
+  checkDeflateStream(3);
+#endif
+}
+
+OFTEST(dcmdata_deflateFile)
+{
+#ifdef WITH_ZLIB
+  DcmDataset dset;
+  OFCHECK(dset.putAndInsertString(DCM_SOPClassUID, UID_ComprehensiveSRStorage).good());
+  OFCHECK(dset.putAndInsertString(DCM_SOPInstanceUID, "1.2.276.0.7230010.3.1.4.2").good());
+  OFCHECK(dset.putAndInsertString(DCM_Modality, "SR").good());
+  char buf[64];
+  for (int i = 0; i < 2000; ++i)
+  {
+    DcmItem *item = NULL;
+    OFCHECK(dset.findOrCreateSequenceItem(DCM_ContentSequence, item, -2).good());
+    if (item)
+    {
+      OFStandard::snprintf(buf, sizeof(buf), "finding %d of a rather long report text", i);
+      item->putAndInsertString(DCM_RelationshipType, "CONTAINS");
+      item->putAndInsertString(DCM_ValueType, "TEXT");
+      item->putAndInsertString(DCM_TextValue, buf);
+    }
+  }
+  // small and large buffers, single and multiple threads
+  checkDeflatedFile(dset, 0, 1);
+  checkDeflatedFile(dset, 1048576, 1);
+  checkDeflatedFile(dset, 4096, 4);
+#endif
+}
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2020, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -27,6 +27,7 @@
 #include "dcmtk/dcmdata/dctagkey.h"
 #include "dcmtk/dcmdata/dcvr.h"
 #include "dcmtk/dcmdata/dcdicent.h"
+#include "dcmtk/ofstd/ofmap.h"
 
 OFTEST(dcmdata_readingDataDictionary)
 {
@@ -116,3 +117,82 @@ OFTEST(dcmdata_usingDataDictionary)
 
 #undef checkDictionary
 }
+
+OFTEST(dcmdata_frozenDataDictionary)
+{
+    // Use a separate instance in order to keep the global dictionary unchanged
+    GlobalDcmDataDictionary globalDict;
+    const DcmTagKey key(0x0009, 0x0010);
+    const char *creator = "Test";
+
+    OFCHECK(!globalDict.isFrozen());
+    const int numEntries = globalDict.rdlock().numberOfEntries();
+    globalDict.rdunlock();
+
+    globalDict.freeze();
+    OFCHECK(globalDict.isFrozen());
+
+    // Modifying a frozen dictionary creates a new snapshot, the old one stays valid
+    const DcmDataDictionary &oldDict = globalDict.rdlock();
+    OFCHECK_EQUAL(oldDict.numberOfEntries(), numEntries);
+    DcmDataDictionary &newDict = globalDict.wrlock();
+    OFCHECK(&newDict != &oldDict);
+    OFCHECK_EQUAL(newDict.numberOfEntries(), numEntries);
+    OFCHECK_EQUAL(newDict.numberOfSkeletonEntries(), oldDict.numberOfSkeletonEntries());
+    OFCHECK_EQUAL(newDict.isDictionaryLoaded(), oldDict.isDictionaryLoaded());
+    newDict.addEntry(new DcmDictEntry(0x0009, 0x0010, DcmVR(EVR_LO), "TestEntry", 1, 1,
+        "test", OFTrue, creator));
+    globalDict.wrunlock();
+    OFCHECK_EQUAL(oldDict.numberOfEntries(), numEntries);
+    OFCHECK(oldDict.findEntry(key, creator) == NULL);
+    globalDict.rdunlock();
+
+    // The new snapshot is used by subsequent read access
+    const DcmDataDictionary &currentDict = globalDict.rdlock();
+    OFCHECK(&currentDict == &newDict);
+    OFCHECK_EQUAL(currentDict.numberOfEntries(), numEntries + 1);
+    OFCHECK(currentDict.findEntry(key, creator) != NULL);
+    globalDict.rdunlock();
+    OFCHECK(globalDict.isFrozen());
+}
+
+/* count the normal entries by iterating over them and check that each
+ * public tag key occurs only once
+ */
+static int countNormalEntries(DcmDataDictionary &dict)
+{
+    int count = 0;
+    OFBool unique = OFTrue;
+    OFMap<DcmTagKey, int> keys;
+    DcmHashDictIterator iter(dict.normalBegin());
+    DcmHashDictIterator last(dict.normalEnd());
+    for (; iter != last; ++iter)
+    {
+        ++count;
+        if ((*iter)->getPrivateCreator() == NULL)
+        {
+            if (keys.find(**iter) != keys.end()) unique = OFFalse;
+            keys[**iter] = count;
+        }
+    }
+    OFCHECK(unique);
+    return count;
+}
+
+OFTEST(dcmdata_iteratingDataDictionary)
+{
+    // With a builtin dictionary, this also covers the static part of it
+    DcmDataDictionary localDict(OFTrue, OFFalse);
+    const DcmTagKey key(0x0010, 0x0010);
+    const int numEntries = localDict.numberOfNormalTagEntries();
+    OFCHECK_EQUAL(countNormalEntries(localDict), numEntries);
+
+    // An entry that replaces an existing one must not be counted twice
+    const OFBool exists = (localDict.findEntry(key, NULL) != NULL);
+    DcmDictEntry *entry = new DcmDictEntry(0x0010, 0x0010, DcmVR(EVR_PN), "Replaced", 1, 1,
+        "test", OFTrue, NULL);
+    localDict.addEntry(entry);
+    OFCHECK(localDict.findEntry(key, NULL) == entry);
+    OFCHECK_EQUAL(localDict.numberOfNormalTagEntries(), numEntries + (exists ? 0 : 1));
+    OFCHECK_EQUAL(countNormalEntries(localDict), localDict.numberOfNormalTagEntries());
+}
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2023 OFFIS e.V.
+ *  Copyright (C) 2011-2026 OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -24,6 +24,7 @@
 #include "dcmtk/ofstd/oftest.h"
 
 OFTEST_REGISTER(dcmdata_partialElementAccess);
+OFTEST_REGISTER(dcmdata_partialElementAccessSharedFile);
 OFTEST_REGISTER(dcmdata_i2d_bmp);
 OFTEST_REGISTER(dcmdata_checkStringValue);
 OFTEST_REGISTER(dcmdata_determineVM);
@@ -35,7 +36,10 @@ OFTEST_REGISTER(dcmdata_decimalString_2);
 OFTEST_REGISTER(dcmdata_decimalString_3);
 OFTEST_REGISTER(dcmdata_decimalString_4);
 OFTEST_REGISTER(dcmdata_decimalString_putFloat64);
+OFTEST_REGISTER(dcmdata_decimalString_putFloat64Array);
+OFTEST_REGISTER(dcmdata_integerString_vector);
 OFTEST_REGISTER(dcmdata_floatingPointDouble);
+OFTEST_REGISTER(dcmdata_floatingPointJsonInfNan);
 OFTEST_REGISTER(dcmdata_personName);
 OFTEST_REGISTER(dcmdata_uniqueIdentifier_1);
 OFTEST_REGISTER(dcmdata_uniqueIdentifier_2);
@@ -97,6 +101,7 @@ OFTEST_REGISTER(dcmdata_sequenceInsert);
 OFTEST_REGISTER(dcmdata_pixelSequenceInsert);
 OFTEST_REGISTER(dcmdata_findAndGetSequenceItem);
 OFTEST_REGISTER(dcmdata_findAndGetUint16Array);
+OFTEST_REGISTER(dcmdata_elementIndex);
 OFTEST_REGISTER(dcmdata_parser_missingDelimitationItems);
 OFTEST_REGISTER(dcmdata_parser_missingSequenceDelimitationItem_1);
 OFTEST_REGISTER(dcmdata_parser_missingSequenceDelimitationItem_2);
@@ -105,6 +110,9 @@ OFTEST_REGISTER(dcmdata_parser_wrongDelimitationItemForItem);
 OFTEST_REGISTER(dcmdata_parser_explicitItemLengthTooLarge);
 OFTEST_REGISTER(dcmdata_parser_oddLengthPartialValue_lastItem);
 OFTEST_REGISTER(dcmdata_parser_oddLengthPartialValue_notLastItem);
+OFTEST_REGISTER(dcmdata_parser_memoryMappedInput);
+OFTEST_REGISTER(dcmdata_parser_sharedFileHandleInput);
+OFTEST_REGISTER(dcmdata_parser_selectiveReading);
 OFTEST_REGISTER(dcmdata_parser_wrongExplicitVRinDataset_default);
 OFTEST_REGISTER(dcmdata_parser_wrongExplicitVRinDataset_defaultVR_dictLen);
 OFTEST_REGISTER(dcmdata_parser_wrongExplicitVRinDataset_dictVR_defaultLen);
@@ -112,12 +120,51 @@ OFTEST_REGISTER(dcmdata_parser_wrongExplicitVRinDataset_preferDataDict);
 OFTEST_REGISTER(dcmdata_parser_undefinedLengthUNSequence);
 OFTEST_REGISTER(dcmdata_readingDataDictionary);
 OFTEST_REGISTER(dcmdata_usingDataDictionary);
+OFTEST_REGISTER(dcmdata_frozenDataDictionary);
+OFTEST_REGISTER(dcmdata_iteratingDataDictionary);
 OFTEST_REGISTER(dcmdata_specificCharacterSet_1);
 OFTEST_REGISTER(dcmdata_specificCharacterSet_2);
 OFTEST_REGISTER(dcmdata_specificCharacterSet_3);
 OFTEST_REGISTER(dcmdata_specificCharacterSet_4);
+OFTEST_REGISTER(dcmdata_specificCharacterSet_5);
+OFTEST_REGISTER(dcmdata_specificCharacterSet_6);
 OFTEST_REGISTER(dcmdata_attribute_filter);
 OFTEST_REGISTER(dcmdata_attribute_matching);
+OFTEST_REGISTER(dcmdata_attribute_matching_compiled);
 OFTEST_REGISTER(dcmdata_newDicomElementPrivate);
 OFTEST_REGISTER(dcmdata_generateUniqueIdentifier);
+OFTEST_REGISTER(dcmdata_codec_determineFrameFragments);
+OFTEST_REGISTER(dcmdata_codec_frameDecompressionTask);
+OFTEST_REGISTER(dcmdata_codec_parallelRLEDecompression);
+OFTEST_REGISTER(dcmdata_codec_parallelRLECompression);
+OFTEST_REGISTER(dcmdata_codec_RLEEncoderDecoder);
+OFTEST_REGISTER(dcmdata_swapBytes);
+OFTEST_REGISTER(dcmdata_copySwapIfNecessary);
+OFTEST_REGISTER(dcmdata_elementByteOrder);
+OFTEST_REGISTER(dcmdata_streamingWriter);
+OFTEST_REGISTER(dcmdata_streamingWriterErrors);
+OFTEST_REGISTER(dcmdata_streamParser);
+OFTEST_REGISTER(dcmdata_streamParserDataset);
+OFTEST_REGISTER(dcmdata_streamParserUndefinedLength);
+OFTEST_REGISTER(dcmdata_memoryArena);
+OFTEST_REGISTER(dcmdata_memoryArenaObjects);
+OFTEST_REGISTER(dcmdata_memoryArenaDataset);
+OFTEST_REGISTER(dcmdata_jsonWriter);
+OFTEST_REGISTER(dcmdata_jsonWriterFileFormat);
+OFTEST_REGISTER(dcmdata_jsonWriterBulkData);
+OFTEST_REGISTER(dcmdata_jsonReader);
+OFTEST_REGISTER(dcmdata_jsonReaderStream);
+OFTEST_REGISTER(dcmdata_jsonReaderSyntax);
+OFTEST_REGISTER(dcmdata_jsonReaderBulkData);
+OFTEST_REGISTER(dcmdata_jsonReaderBulkDataPaths);
+OFTEST_REGISTER(dcmdata_jsonReaderNesting);
+OFTEST_REGISTER(dcmdata_dicomdirParallelLoading);
+OFTEST_REGISTER(dcmdata_dicomdirParallelLoadingBadFiles);
+OFTEST_REGISTER(dcmdata_dicomdirIncrementalAppend);
+OFTEST_REGISTER(dcmdata_dicomdirIncrementalAppendUndefinedLength);
+OFTEST_REGISTER(dcmdata_dicomdirIncrementalAppendNoCorrection);
+OFTEST_REGISTER(dcmdata_dicomdirIncrementalAppendFallback);
+OFTEST_REGISTER(dcmdata_deflateStream);
+OFTEST_REGISTER(dcmdata_deflateStreamParallel);
+OFTEST_REGISTER(dcmdata_deflateFile);
 OFTEST_MAIN("dcmdata")
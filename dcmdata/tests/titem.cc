@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2021, OFFIS e.V.
+ *  Copyright (C) 2021-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -48,3 +48,61 @@ OFTEST(dcmdata_findAndGetUint16Array)
     OFCHECK(item.findAndGetUint16Array(DCM_FrameIncrementPointer, uintVals, &numUints).good());
     OFCHECK_EQUAL(numUints, 2);
 }
+
+
+static void checkElementIndex(DcmItem &item, const Uint16 count)
+{
+    Uint16 value = 0;
+    /* all elements with even element numbers exist, the others not */
+    for (Uint16 i = 0; i < 2 * count; ++i)
+    {
+        const DcmTagKey key(0x0009, OFstatic_cast(Uint16, 0x1000 + i));
+        if (i % 2 == 0)
+        {
+            OFCHECK(item.tagExists(key));
+            OFCHECK(item.findAndGetUint16(key, value).good());
+            OFCHECK_EQUAL(value, i);
+        } else {
+            OFCHECK(!item.tagExists(key));
+            OFCHECK(item.findAndGetUint16(key, value) == EC_TagNotFound);
+        }
+    }
+}
+
+OFTEST(dcmdata_elementIndex)
+{
+    const Uint16 count = 200;
+    const Uint32 oldThreshold = dcmElementIndexThreshold.get();
+    for (int run = 0; run < 2; ++run)
+    {
+        /* first run without, second run with element index */
+        dcmElementIndexThreshold.set(run == 0 ? 0 : 16);
+        DcmItem item;
+        /* insert elements in descending order, so the index is updated in the middle */
+        for (Uint16 i = count; i > 0; --i)
+        {
+            const Uint16 elem = OFstatic_cast(Uint16, 2 * (i - 1));
+            OFCHECK(item.putAndInsertUint16(DcmTag(0x0009, OFstatic_cast(Uint16, 0x1000 + elem), EVR_US), elem).good());
+            /* interleave lookups with insertions */
+            OFCHECK(item.tagExists(DcmTagKey(0x0009, OFstatic_cast(Uint16, 0x1000 + elem))));
+        }
+        OFCHECK_EQUAL(item.card(), count);
+        checkElementIndex(item, count);
+        /* replace an existing element */
+        OFCHECK(item.putAndInsertUint16(DcmTag(0x0009, 0x1002, EVR_US), 2).good());
+        OFCHECK_EQUAL(item.card(), count);
+        checkElementIndex(item, count);
+        /* remove some elements in different ways */
+        delete item.remove(DcmTagKey(0x0009, 0x1000));
+        delete item.remove(OFstatic_cast(unsigned long, 0));
+        OFCHECK(item.remove(DcmTagKey(0x0009, 0x1001)) == NULL);
+        OFCHECK_EQUAL(item.card(), count - 2);
+        OFCHECK(!item.tagExists(DcmTagKey(0x0009, 0x1000)));
+        OFCHECK(!item.tagExists(DcmTagKey(0x0009, 0x1002)));
+        OFCHECK(item.tagExists(DcmTagKey(0x0009, 0x1004)));
+        /* clear the item and check that the index is not used anymore */
+        OFCHECK(item.clear().good());
+        OFCHECK(!item.tagExists(DcmTagKey(0x0009, 0x1004)));
+    }
+    dcmElementIndexThreshold.set(oldThreshold);
+}
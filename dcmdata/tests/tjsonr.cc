@@ -0,0 +1,439 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: test program for class DcmJsonReader
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/ofstd/offile.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcjsonr.h"
+#include "dcmtk/dcmdata/dcjsonw.h"
+
+
+/* JSON reader that resolves BulkDataURIs of the form "test:<text>" */
+class TestBulkDataJsonReader : public DcmJsonReader
+{
+public:
+  TestBulkDataJsonReader() : DcmJsonReader(), uris() {}
+
+  virtual OFCondition readBulkData(DcmElement& element, const OFString& uri)
+  {
+    uris.push_back(uri);
+    if (uri.compare(0, 5, "test:") == 0)
+    {
+      OFString value = uri.substr(5);
+      return putBinaryValue(element, OFreinterpret_cast(Uint8 *, OFconst_cast(char *, value.c_str())), value.length());
+    }
+    return DcmJsonReader::readBulkData(element, uri);
+  }
+
+  OFVector<OFString> uris;
+};
+
+
+/* create a dataset with elements of most value representations */
+static void createDataset(DcmItem& dset)
+{
+  static const Uint8 bytes[] = { 0x00, 0x01, 0x02, 0xfe, 0xff, 0x80, 0x7f };
+  static const Uint16 words[] = { 0x0000, 0x1234, 0xffff };
+  static const Float32 floats[] = { 1.5f, -0.25f };
+  static const Float64 doubles[] = { 1e300, -2.5e-10 };
+  DcmItem *item = NULL;
+  OFCHECK(dset.putAndInsertString(DCM_SpecificCharacterSet, "ISO_IR 192").good());
+  OFCHECK(dset.putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage).good());
+  OFCHECK(dset.insertEmptyElement(DCM_StudyDate).good());
+  OFCHECK(dset.putAndInsertString(DCM_ImageType, "ORIGINAL\\\\PRIMARY").good());
+  OFCHECK(dset.putAndInsertString(DCM_DerivationDescription, "tab\there, \"quoted\" and back\\slash\r\n\x01 \xc3\xa4 end").good());
+  OFCHECK(dset.putAndInsertString(DCM_PatientName, "Doe^John=\xe5\xb1\xb1\xe7\x94\xb0^\xe5\xa4\xaa\xe9\x83\x8e\\^^Smith").good());
+  OFCHECK(dset.insertEmptyElement(DCM_PerformingPhysicianName).good());
+  OFCHECK(dset.putAndInsertString(DCM_ReferencedFrameNumber, "7\\-1\\12").good());
+  OFCHECK(dset.putAndInsertString(DCM_ImagePositionPatient, "0.5\\-12.5\\100000").good());
+  OFCHECK(dset.putAndInsertString(DCM_SelectorSSValue, "-32768\\0\\32767").good());
+  OFCHECK(dset.putAndInsertString(DCM_SelectorSLValue, "-2147483648\\2147483647").good());
+  OFCHECK(dset.putAndInsertString(DCM_SelectorULValue, "4294967295\\0").good());
+  OFCHECK(dset.putAndInsertUint16(DCM_Rows, 512).good());
+  OFCHECK(dset.putAndInsertFloat32Array(DCM_SelectorFLValue, floats, 2).good());
+  OFCHECK(dset.putAndInsertFloat64Array(DCM_SelectorFDValue, doubles, 2).good());
+  OFCHECK(dset.putAndInsertTagKey(DCM_SelectorATValue, DCM_PatientName).good());
+  OFCHECK(dset.putAndInsertString(DCM_SelectorUVValue, "18446744073709551615").good());
+  OFCHECK(dset.putAndInsertString(DCM_SelectorSVValue, "-9223372036854775807").good());
+  OFCHECK(dset.putAndInsertUint8Array(DCM_ICCProfile, bytes, sizeof(bytes)).good());
+  OFCHECK(dset.putAndInsertUint16Array(DCM_RedPaletteColorLookupTableData, words, 3).good());
+  OFCHECK(dset.putAndInsertFloat32Array(DCM_SelectorOFValue, floats, 2).good());
+  OFCHECK(dset.putAndInsertFloat64Array(DCM_SelectorODValue, doubles, 2).good());
+  OFCHECK(dset.insertEmptyElement(DCM_ReferencedSOPSequence).good());
+  OFCHECK(dset.findOrCreateSequenceItem(DCM_ContentSequence, item, -2).good());
+  OFCHECK(item->putAndInsertString(DCM_ValueType, "TEXT").good());
+  OFCHECK(item->putAndInsertString(DCM_TextValue, "Line 1\nLine 2").good());
+  OFCHECK(dset.findOrCreateSequenceItem(DCM_ContentSequence, item, -2).good());
+  OFCHECK(item->findOrCreateSequenceItem(DCM_ConceptNameCodeSequence, item).good());
+  OFCHECK(item->putAndInsertString(DCM_CodeMeaning, "Nested").good());
+  OFCHECK(dset.findOrCreateSequenceItem(DCM_ContentSequence, item, -2).good());
+  OFCHECK(dset.putAndInsertUint16Array(DCM_PixelData, words, 3).good());
+}
+
+
+/* write an item in compact JSON format */
+static OFString writeJson(DcmItem& dset)
+{
+  DcmJsonFormatCompact format(OFFalse);
+  DcmJsonWriter writer(format);
+  OFCHECK(writer.writeDataset(dset).good());
+  return OFString(writer.getBuffer(), writer.getLength());
+}
+
+
+/* parse a JSON document and return the first dataset */
+static OFCondition readJson(const OFString& json, DcmItem& dset)
+{
+  DcmJsonReader reader;
+  reader.setBuffer(json.c_str(), json.length());
+  return reader.readDataset(dset);
+}
+
+
+OFTEST(dcmdata_jsonReader)
+{
+  DcmDataset source;
+  createDataset(source);
+  const OFString expected = writeJson(source);
+  DcmDataset dset;
+  OFCHECK(readJson(expected, dset).good());
+  OFCHECK_EQUAL(writeJson(dset), expected);
+  OFCHECK_EQUAL(dset.card(), source.card());
+
+  // the values are also identical in binary form
+  const Uint16 *words = NULL;
+  OFCHECK(dset.findAndGetUint16Array(DCM_RedPaletteColorLookupTableData, words).good());
+  OFCHECK(words != NULL && words[1] == 0x1234 && words[2] == 0xffff);
+  Float64 f64 = 0;
+  OFCHECK(dset.findAndGetFloat64(DCM_SelectorODValue, f64, 1).good());
+  OFCHECK_EQUAL(f64, -2.5e-10);
+  DcmElement *elem = NULL;
+  OFCHECK(dset.findAndGetElement(DCM_PixelData, elem).good());
+  OFCHECK(elem != NULL && elem->getTag().getEVR() == EVR_OW);
+  OFString value;
+  OFCHECK(dset.findAndGetOFStringArray(DCM_PatientName, value).good());
+  OFCHECK_EQUAL(value, "Doe^John=\xe5\xb1\xb1\xe7\x94\xb0^\xe5\xa4\xaa\xe9\x83\x8e\\^^Smith");
+  OFCHECK(dset.findAndGetOFStringArray(DCM_DerivationDescription, value).good());
+  OFCHECK_EQUAL(value, "tab\there, \"quoted\" and back\\slash\r\n\x01 \xc3\xa4 end");
+
+  // the file meta information is moved to the meta header
+  DcmFileFormat fileformat;
+  OFCHECK(fileformat.getMetaInfo()->putAndInsertString(DCM_MediaStorageSOPClassUID, UID_SecondaryCaptureImageStorage).good());
+  createDataset(*fileformat.getDataset());
+  DcmJsonFormatCompact format(OFTrue);
+  DcmJsonWriter writer(format);
+  OFCHECK(writer.writeFileFormat(fileformat).good());
+  DcmJsonReader reader;
+  reader.setBuffer(writer.getBuffer(), writer.getLength());
+  DcmFileFormat result;
+  OFCHECK(reader.readFileFormat(result).good());
+  OFCHECK_EQUAL(result.getMetaInfo()->card(), 1);
+  OFCHECK_EQUAL(result.getDataset()->card(), source.card());
+  OFCHECK(reader.readFileFormat(result) == EC_EndOfStream);
+}
+
+
+OFTEST(dcmdata_jsonReaderStream)
+{
+  OFTempFile temp;
+  if (temp.getStatus().bad())
+  {
+    OFCHECK_FAIL("Could not create temporary file: " << temp.getStatus().text());
+    return;
+  }
+  DcmDataset source;
+  createDataset(source);
+  const OFString json = writeJson(source);
+  OFFile file;
+  OFCHECK(file.fopen(temp.getFilename(), "wb"));
+  OFString document = "[\n  " + json + ",\n  {}, " + json + "\n]\n";
+  OFCHECK_EQUAL(file.fwrite(document.c_str(), 1, document.length()), document.length());
+  file.fclose();
+
+  // a small buffer makes sure that tokens are split between reads
+  const size_t sizes[] = { 1, 7, DcmJsonReaderBufferSize };
+  for (size_t i = 0; i < 3; ++i)
+  {
+    DcmJsonReader reader(sizes[i]);
+    OFCHECK(reader.openFile(temp.getFilename()).good());
+    DcmDataset dset;
+    OFCHECK(reader.readDataset(dset).good());
+    OFCHECK_EQUAL(writeJson(dset), json);
+    dset.clear();
+    OFCHECK(reader.readDataset(dset).good());
+    OFCHECK_EQUAL(dset.card(), 0);
+    OFCHECK(reader.readDataset(dset).good());
+    OFCHECK_EQUAL(writeJson(dset), json);
+    OFCHECK(reader.readDataset(dset) == EC_EndOfStream);
+  }
+
+  // empty documents and empty arrays contain no dataset
+  DcmDataset dset;
+  OFCHECK(readJson("", dset) == EC_EndOfStream);
+  OFCHECK(readJson(" [ ] ", dset) == EC_EndOfStream);
+  OFCHECK(readJson("{}", dset).good());
+}
+
+
+OFTEST(dcmdata_jsonReaderSyntax)
+{
+  // members in arbitrary order, whitespace, unknown members and escape sequences
+  DcmDataset dset;
+  OFCHECK(readJson(
+    "{ \"00100010\" : { \"Value\" : [ { \"Ideographic\" : \"\\u5c71\\u7530\", \"Alphabetic\" : \"Yamada\" }, null,\n"
+    "                                 { \"Phonetic\" : \"\\ud83d\\ude00\" } ], \"vr\" : \"PN\" },\n"
+    "  \"00200032\":{\"vr\":\"DS\",\"Value\":[1.5,-2E3,null]},\n"
+    "  \"00081030\":{\"vr\":\"LO\",\"Value\":[\"a\\/b\\u00e4\"],\"extra\":{\"x\":[1,{\"y\":null}]}},\n"
+    "  \"00280010\":{\"vr\":\"US\"},\n"
+    "  \"00081115\":{\"vr\":\"SQ\",\"Value\":[{},{\"00081150\":{\"vr\":\"UI\",\"Value\":[\"1.2.3\"]}}]},\n"
+    "  \"00720060\":{\"Value\":[\"00100010\",\"7FE00010\"],\"vr\":\"AT\"}\n"
+    "}", dset).good());
+  OFString value;
+  OFCHECK(dset.findAndGetOFStringArray(DCM_PatientName, value).good());
+  OFCHECK_EQUAL(value, "Yamada=\xe5\xb1\xb1\xe7\x94\xb0\\\\==\xf0\x9f\x98\x80");
+  OFCHECK(dset.findAndGetOFStringArray(DCM_ImagePositionPatient, value).good());
+  OFCHECK_EQUAL(value, "1.5\\-2E3\\");
+  OFCHECK(dset.findAndGetOFStringArray(DCM_StudyDescription, value).good());
+  OFCHECK_EQUAL(value, "a/b\xc3\xa4");
+  DcmElement *elem = NULL;
+  OFCHECK(dset.findAndGetElement(DCM_Rows, elem).good());
+  OFCHECK(elem != NULL && elem->getLength() == 0);
+  DcmItem *item = NULL;
+  OFCHECK(dset.findAndGetSequenceItem(DCM_ReferencedSeriesSequence, item, 0).good());
+  OFCHECK(item != NULL && item->card() == 0);
+  OFCHECK(dset.findAndGetSequenceItem(DCM_ReferencedSeriesSequence, item, 1).good());
+  OFCHECK(item != NULL && item->findAndGetOFString(DCM_ReferencedSOPClassUID, value).good());
+  OFCHECK_EQUAL(value, "1.2.3");
+  DcmTagKey tag;
+  OFCHECK(dset.findAndGetElement(DCM_SelectorATValue, elem).good());
+  OFCHECK(elem != NULL && elem->getTagVal(tag, 1).good());
+  OFCHECK(tag == DCM_PixelData);
+
+  // malformed documents
+  const char *malformed[] =
+  {
+    "{",
+    "{\"00100010\"}",
+    "{\"0010001\":{\"vr\":\"PN\"}}",
+    "{\"00100010\":{\"vr\":\"PN\",\"Value\":[\"unterminated]}}",
+    "{\"00100010\":{\"vr\":\"PN\",\"Value\":[\"a\" \"b\"]}}",
+    "{\"00100010\":{\"vr\":\"PN\",\"Value\":[true]}}",
+    "{\"00081030\":{\"vr\":\"LO\",\"Value\":[\"\\x\"]}}",
+    "{\"00081030\":{\"vr\":\"LO\",\"Value\":[\"\\ud83d\\u0041\"]}}",
+    "{\"00081115\":{\"vr\":\"SQ\",\"Value\":[\"item\"]}}",
+    "{\"00720026\":{\"vr\":\"AT\",\"Value\":[\"0010\"]}}",
+    "{}}",
+    "[{},{}"
+  };
+  for (size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); ++i)
+  {
+    DcmDataset bad;
+    DcmJsonReader reader;
+    reader.setBuffer(malformed[i], strlen(malformed[i]));
+    OFCondition status = reader.readDataset(bad);
+    if (status.good())
+      status = reader.readDataset(bad);
+    OFCHECK_EQUAL(status.text(), OFString(OFCondition(EC_JsonParseError).text()));
+    // no further dataset is returned after an error
+    OFCHECK(reader.readDataset(bad) == EC_EndOfStream);
+  }
+}
+
+
+OFTEST(dcmdata_jsonReaderBulkData)
+{
+  OFTempFile temp;
+  if (temp.getStatus().bad())
+  {
+    OFCHECK_FAIL("Could not create temporary file: " << temp.getStatus().text());
+    return;
+  }
+  static const Uint8 bytes[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+  OFFile file;
+  OFCHECK(file.fopen(temp.getFilename(), "wb"));
+  OFCHECK_EQUAL(file.fwrite(bytes, 1, sizeof(bytes)), sizeof(bytes));
+  file.fclose();
+
+  const OFString json =
+    "{\"00082111\":{\"vr\":\"ST\",\"BulkDataURI\":\"test:some text\"},"
+    "\"00720074\":{\"vr\":\"FD\",\"BulkDataURI\":\"http://host/bulk\"},"
+    "\"00283006\":{\"vr\":\"US\",\"BulkDataURI\":\"file://" + OFString(temp.getFilename()) + "\"},"
+    "\"7FE00010\":{\"vr\":\"OB\",\"InlineBinary\":\"AQIDBAUGBwg=\"}}";
+  DcmDataset dset;
+  DcmElement *elem = NULL;
+  {
+    // without a bulk data directory, no files are read
+    TestBulkDataJsonReader reader;
+    reader.setBuffer(json.c_str(), json.length());
+    OFCHECK(reader.readDataset(dset).good());
+    OFCHECK(dset.findAndGetElement(DCM_LUTData, elem).good());
+    OFCHECK(elem != NULL && elem->getLength() == 0);
+  }
+  OFString directory;
+  OFStandard::getDirNameFromPath(directory, temp.getFilename());
+  TestBulkDataJsonReader reader;
+  reader.setBulkDataDirectory(directory);
+  reader.setBuffer(json.c_str(), json.length());
+  OFCHECK(reader.readDataset(dset).good());
+  OFCHECK_EQUAL(reader.uris.size(), 3);
+  OFString value;
+  OFCHECK(dset.findAndGetOFString(DCM_DerivationDescription, value).good());
+  OFCHECK_EQUAL(value, "some text");
+  // unknown schemes result in an empty element
+  OFCHECK(dset.findAndGetElement(DCM_SelectorFDValue, elem).good());
+  OFCHECK(elem != NULL && elem->getLength() == 0);
+  // bulk data is little endian
+  Uint16 us = 0;
+  OFCHECK(dset.findAndGetUint16(DCM_LUTData, us, 3).good());
+  OFCHECK_EQUAL(us, 0x0807);
+  const Uint8 *ob = NULL;
+  unsigned long count = 0;
+  OFCHECK(dset.findAndGetUint8Array(DCM_PixelData, ob, &count).good());
+  OFCHECK(count == sizeof(bytes) && ob != NULL && memcmp(ob, bytes, sizeof(bytes)) == 0);
+}
+
+
+OFTEST(dcmdata_jsonReaderBulkDataPaths)
+{
+  OFTempFile temp;
+  if (temp.getStatus().bad())
+  {
+    OFCHECK_FAIL("Could not create temporary file: " << temp.getStatus().text());
+    return;
+  }
+  static const Uint8 bytes[] = { 0x01, 0x02, 0x03, 0x04 };
+  OFFile file;
+  OFCHECK(file.fopen(temp.getFilename(), "wb"));
+  OFCHECK_EQUAL(file.fwrite(bytes, 1, sizeof(bytes)), sizeof(bytes));
+  file.fclose();
+  OFString directory;
+  OFString filename;
+  OFStandard::getDirNameFromPath(directory, temp.getFilename());
+  OFStandard::getFilenameFromPath(filename, temp.getFilename());
+  // percent-encode all characters of the filename
+  OFString encoded;
+  for (size_t i = 0; i < filename.length(); ++i)
+  {
+    char hex[4];
+    OFStandard::snprintf(hex, sizeof(hex), "%%%02X", OFstatic_cast(unsigned char, filename[i]));
+    encoded += hex;
+  }
+
+  // valid references to the file within the bulk data directory
+  const OFString valid[] =
+  {
+    filename,
+    "./" + encoded,
+    "file:" + OFString(temp.getFilename()),
+    "file://" + OFString(temp.getFilename()),
+    "file://localhost" + OFString(temp.getFilename())
+  };
+  for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); ++i)
+  {
+    const OFString json = "{\"00283006\":{\"vr\":\"US\",\"BulkDataURI\":\"" + valid[i] + "\"}}";
+    DcmJsonReader reader;
+    reader.setBulkDataDirectory(directory);
+    reader.setBuffer(json.c_str(), json.length());
+    DcmDataset dset;
+    OFCHECK(reader.readDataset(dset).good());
+    Uint16 us = 0;
+    OFCHECK(dset.findAndGetUint16(DCM_LUTData, us, 1).good());
+    OFCHECK_EQUAL(us, 0x0403);
+  }
+
+  // references to files outside of the bulk data directory are rejected
+  const OFString invalid[] =
+  {
+    "../" + filename,
+    "%2E%2E/" + filename,
+    "sub/../../" + filename,
+    "/etc/passwd",
+    "file:///etc/passwd",
+    "file://" + directory + "/../" + filename,
+    "file://" + directory + "/%2e%2e/" + filename,
+    "file://" + directory + "x/" + filename,
+    "%zz",
+    "%00"
+  };
+  for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+  {
+    const OFString json = "{\"00283006\":{\"vr\":\"US\",\"BulkDataURI\":\"" + invalid[i] + "\"}}";
+    DcmJsonReader reader;
+    reader.setBulkDataDirectory(directory);
+    reader.setBuffer(json.c_str(), json.length());
+    DcmDataset dset;
+    OFCHECK(reader.readDataset(dset) == EC_InvalidFilename);
+  }
+
+  // files on remote hosts cannot be retrieved
+  const OFString json = "{\"00283006\":{\"vr\":\"US\",\"BulkDataURI\":\"file://host" + OFString(temp.getFilename()) + "\"}}";
+  DcmJsonReader reader;
+  reader.setBulkDataDirectory(directory);
+  reader.setBuffer(json.c_str(), json.length());
+  DcmDataset dset;
+  OFCHECK(reader.readDataset(dset).good());
+  DcmElement *elem = NULL;
+  OFCHECK(dset.findAndGetElement(DCM_LUTData, elem).good());
+  OFCHECK(elem != NULL && elem->getLength() == 0);
+}
+
+
+/* create a document with sequences nested to the given level */
+static OFString nestedSequences(const size_t levels)
+{
+  OFString json;
+  for (size_t i = 0; i < levels; ++i)
+    json += "{\"0040A730\":{\"vr\":\"SQ\",\"Value\":[";
+  json += "{\"0040A160\":{\"vr\":\"UT\",\"Value\":[\"leaf\"]}}";
+  for (size_t i = 0; i < levels; ++i)
+    json += "]}}";
+  return json;
+}
+
+
+OFTEST(dcmdata_jsonReaderNesting)
+{
+  DcmDataset dset;
+  OFCHECK(readJson(nestedSequences(50), dset).good());
+  DcmItem *item = &dset;
+  DcmItem *next = NULL;
+  size_t levels = 0;
+  while (item->findAndGetSequenceItem(DCM_ContentSequence, next, 0).good())
+  {
+    item = next;
+    ++levels;
+  }
+  OFCHECK_EQUAL(levels, 50);
+  OFString value;
+  OFCHECK(item->findAndGetOFString(DCM_TextValue, value).good());
+  OFCHECK_EQUAL(value, "leaf");
+  // deeply nested documents are rejected instead of exhausting the stack
+  DcmDataset deep;
+  OFCHECK(readJson(nestedSequences(1000), deep) == EC_JsonParseError);
+  DcmDataset skipped;
+  OFString unknown = "{\"00100010\":{\"vr\":\"PN\",\"extra\":";
+  unknown += OFString(1000, '[');
+  OFCHECK(readJson(unknown, skipped) == EC_JsonParseError);
+}
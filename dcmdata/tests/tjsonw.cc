@@ -0,0 +1,215 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: test program for class DcmJsonWriter
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcjsonw.h"
+
+
+/* compact JSON format that writes some elements as BulkDataURI */
+class BulkDataJsonFormat : public DcmJsonFormatCompact
+{
+public:
+  BulkDataJsonFormat() : DcmJsonFormatCompact(OFFalse) {}
+
+  virtual OFBool asBulkDataURI(const DcmTagKey& tag, OFString& uri)
+  {
+    if ((tag == DCM_ICCProfile) || (tag == DCM_DerivationDescription) || (tag == DCM_SelectorFDValue))
+    {
+      char buf[64];
+      sprintf(buf, "http://host/\"%04X%04X\"", tag.getGroup(), tag.getElement());
+      uri = buf;
+      return OFTrue;
+    }
+    return OFFalse;
+  }
+};
+
+
+/* create a dataset with elements of most value representations */
+static void createDataset(DcmItem& dset)
+{
+  static const Uint8 bytes[] = { 0x00, 0x01, 0x02, 0xfe, 0xff, 0x80, 0x7f };
+  static const Uint16 words[] = { 0x0000, 0x1234, 0xffff };
+  static const Float32 floats[] = { 1.5f, -0.25f };
+  DcmItem *item = NULL;
+  OFCHECK(dset.putAndInsertUint32(DcmTagKey(0x0008, 0x0000), 1234).good());
+  OFCHECK(dset.putAndInsertString(DCM_SpecificCharacterSet, "ISO_IR 100").good());
+  OFCHECK(dset.putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage).good());
+  OFCHECK(dset.insertEmptyElement(DCM_StudyDate).good());
+  OFCHECK(dset.putAndInsertString(DCM_ImageType, "ORIGINAL\\\\PRIMARY").good());
+  OFCHECK(dset.putAndInsertString(DCM_DerivationDescription, "tab\there, \"quoted\" and back\\slash\r\n\x01\x1f\x7f\xe4 end").good());
+  OFCHECK(dset.putAndInsertString(DCM_TextValue, "").good());
+  OFCHECK(dset.putAndInsertString(DCM_PatientName, "Doe ^John^^ ^=Yamada^Tarou==\\\\^^Smith\\").good());
+  OFCHECK(dset.putAndInsertString(DCM_ReferringPhysicianName, "A=B=C=D^E").good());
+  OFCHECK(dset.insertEmptyElement(DCM_PerformingPhysicianName).good());
+  OFCHECK(dset.putAndInsertString(DCM_ReferencedFrameNumber, "+007\\-0\\12\\\\x1").good());
+  OFCHECK(dset.putAndInsertString(DCM_ImagePositionPatient, "+.5\\-0.\\-00012.50\\1.e5\\00\\abc").good());
+  OFCHECK(dset.putAndInsertString(DCM_SelectorSSValue, "-32768\\0\\32767").good());
+  OFCHECK(dset.putAndInsertString(DCM_SelectorSLValue, "-2147483648\\2147483647").good());
+  OFCHECK(dset.putAndInsertString(DCM_SelectorULValue, "4294967295\\0").good());
+  OFCHECK(dset.putAndInsertUint16(DCM_Rows, 512).good());
+  OFCHECK(dset.putAndInsertFloat32Array(DCM_SelectorFLValue, floats, 2).good());
+  OFCHECK(dset.putAndInsertString(DCM_SelectorFDValue, "1e300\\-2.5e-10\\0\\0.1").good());
+  OFCHECK(dset.putAndInsertTagKey(DCM_SelectorATValue, DCM_PatientName).good());
+  OFCHECK(dset.putAndInsertString(DCM_SelectorUVValue, "18446744073709551615").good());
+  OFCHECK(dset.putAndInsertUint8Array(DCM_ICCProfile, bytes, sizeof(bytes)).good());
+  OFCHECK(dset.putAndInsertUint16Array(DCM_RedPaletteColorLookupTableData, words, 3).good());
+  OFCHECK(dset.putAndInsertFloat32Array(DCM_SelectorOFValue, floats, 2).good());
+  OFCHECK(dset.insertEmptyElement(DCM_ReferencedSOPSequence).good());
+  OFCHECK(dset.findOrCreateSequenceItem(DCM_ContentSequence, item, -2).good());
+  OFCHECK(item->putAndInsertString(DCM_ValueType, "TEXT").good());
+  OFCHECK(item->putAndInsertString(DCM_TextValue, "Line 1\nLine 2").good());
+  OFCHECK(dset.findOrCreateSequenceItem(DCM_ContentSequence, item, -2).good());
+  OFCHECK(item->findOrCreateSequenceItem(DCM_ConceptNameCodeSequence, item).good());
+  OFCHECK(item->putAndInsertString(DCM_CodeMeaning, "Nested").good());
+  OFCHECK(dset.findOrCreateSequenceItem(DCM_ContentSequence, item, -2).good());
+  OFCHECK(dset.putAndInsertUint8Array(DCM_PixelData, bytes, 6).good());
+}
+
+
+/* write an item with the existing stream-based implementation */
+static OFCondition writeJsonStream(DcmItem& dset, DcmJsonFormat& format, OFString& result)
+{
+  OFOStringStream stream;
+  OFCondition status = dset.writeJsonExt(stream, format, OFTrue, OFTrue);
+  OFSTRINGSTREAM_GETOFSTRING(stream, tmp)
+  result = tmp;
+  return status;
+}
+
+
+OFTEST(dcmdata_jsonWriter)
+{
+  DcmDataset dset;
+  createDataset(dset);
+  const DcmJsonFormat::NumStringPolicy policies[] =
+  {
+    DcmJsonFormat::NSP_auto,
+    DcmJsonFormat::NSP_always_string,
+    DcmJsonFormat::NSP_always_number
+  };
+  for (size_t i = 0; i < 3; ++i)
+  {
+    DcmJsonFormatCompact format(OFFalse);
+    format.setJsonNumStringPolicy(policies[i]);
+    OFString expected;
+    OFCondition expectedStatus = writeJsonStream(dset, format, expected);
+    DcmJsonWriter writer(format);
+    OFCondition status = writer.writeDataset(dset);
+    OFCHECK_EQUAL(status.text(), OFString(expectedStatus.text()));
+    OFCHECK_EQUAL(OFString(writer.getBuffer(), writer.getLength()), expected);
+  }
+
+  // the output buffer is reused
+  DcmJsonFormatCompact format(OFFalse);
+  DcmJsonWriter writer(format);
+  OFString expected;
+  OFCHECK(writeJsonStream(dset, format, expected).good());
+  writer.append("[");
+  OFCHECK(writer.writeDataset(dset).good());
+  writer.append(",");
+  OFCHECK(writer.writeDataset(dset).good());
+  writer.append("]");
+  OFCHECK_EQUAL(OFString(writer.getBuffer(), writer.getLength()), "[" + expected + "," + expected + "]");
+  writer.clear();
+  OFCHECK_EQUAL(writer.getLength(), 0);
+  OFCHECK(writer.writeDataset(dset).good());
+  OFCHECK_EQUAL(OFString(writer.getBuffer(), writer.getLength()), expected);
+
+  // empty datasets
+  DcmDataset empty;
+  writer.clear();
+  OFCHECK(writer.writeDataset(empty).good());
+  OFCHECK_EQUAL(OFString(writer.getBuffer(), writer.getLength()), "{}");
+
+  // infinity cannot be written without the JSON extension
+  DcmDataset infinite;
+  OFCHECK(infinite.putAndInsertString(DCM_SelectorFDValue, "1\\inf").good());
+  writer.clear();
+  OFCHECK(writer.writeDataset(infinite) == EC_CannotWriteJsonNumber);
+  OFCHECK(writeJsonStream(infinite, format, expected) == EC_CannotWriteJsonNumber);
+  format.setJsonExtensionEnabled(OFTrue);
+  writer.clear();
+  OFCHECK(writer.writeDataset(infinite).good());
+  OFCHECK(writeJsonStream(infinite, format, expected).good());
+  OFCHECK_EQUAL(OFString(writer.getBuffer(), writer.getLength()), expected);
+}
+
+
+OFTEST(dcmdata_jsonWriterFileFormat)
+{
+  OFTempFile temp;
+  if (temp.getStatus().bad())
+  {
+    OFCHECK_FAIL("Could not create temporary file: " << temp.getStatus().text());
+    return;
+  }
+  DcmFileFormat source;
+  createDataset(*source.getDataset());
+  OFCHECK(source.saveFile(temp.getFilename(), EXS_LittleEndianExplicit).good());
+  DcmFileFormat dfile;
+  OFCHECK(dfile.loadFile(temp.getFilename()).good());
+  for (int meta = 0; meta < 2; ++meta)
+  {
+    DcmJsonFormatCompact format(meta != 0);
+    OFOStringStream stream;
+    OFCHECK(dfile.writeJson(stream, format).good());
+    OFSTRINGSTREAM_GETOFSTRING(stream, expected)
+    DcmJsonWriter writer(format);
+    OFCHECK(writer.writeFileFormat(dfile).good());
+    OFCHECK_EQUAL(OFString(writer.getBuffer(), writer.getLength()), expected);
+  }
+}
+
+
+OFTEST(dcmdata_jsonWriterBulkData)
+{
+  DcmDataset dset;
+  createDataset(dset);
+  BulkDataJsonFormat format;
+  OFString expected;
+  OFCHECK(writeJsonStream(dset, format, expected).good());
+  DcmJsonWriter writer(format);
+  OFCHECK(writer.writeDataset(dset).good());
+  OFCHECK_EQUAL(OFString(writer.getBuffer(), writer.getLength()), expected);
+
+  // small values are written inline if a threshold is set
+  DcmDataset small;
+  OFCHECK(small.putAndInsertString(DCM_DerivationDescription, "short").good());
+  OFCHECK(small.putAndInsertString(DCM_SelectorFDValue, "1\\2").good());
+  writer.clear();
+  writer.setBulkDataThreshold(8);
+  OFCHECK(writer.writeDataset(small).good());
+  OFCHECK_EQUAL(OFString(writer.getBuffer(), writer.getLength()),
+    "{\"00082111\":{\"vr\":\"ST\",\"Value\":[\"short\"]},"
+    "\"00720074\":{\"vr\":\"FD\",\"BulkDataURI\":\"http://host/\\\"00720074\\\"\"}}");
+  writer.clear();
+  writer.setBulkDataThreshold(16);
+  OFCHECK(writer.writeDataset(small).good());
+  OFCHECK_EQUAL(OFString(writer.getBuffer(), writer.getLength()),
+    "{\"00082111\":{\"vr\":\"ST\",\"Value\":[\"short\"]},"
+    "\"00720074\":{\"vr\":\"FD\",\"Value\":[1,2]}}");
+}
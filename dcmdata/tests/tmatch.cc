@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2017-2018, OFFIS e.V.
+ *  Copyright (C) 2017-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -163,3 +163,93 @@ OFTEST(dcmdata_attribute_matching)
     OFCHECK(match( "-12", 3, "11", 2 ));
     OFCHECK(!DcmAttributeMatching( EVR_PN )( "M?ller", 6, "^Martin", 7 ));
 }
+
+// compare the results of a compiled query with the ones of the respective matching function
+static void test_compiled( const DcmEVR vr, const char* const* queries, const size_t numQueries,
+                           const char* const* candidates, const size_t numCandidates )
+{
+    const DcmAttributeMatching match( vr );
+    for( size_t i = 0; i < numQueries; ++i )
+    {
+        const DcmAttributeMatching::CompiledQuery query( vr, queries[i], strlen( queries[i] ) );
+        OFCHECK(query);
+        for( size_t j = 0; j < numCandidates; ++j )
+        {
+            const OFBool expected = match( queries[i], strlen( queries[i] ), candidates[j], strlen( candidates[j] ) );
+            if( query( candidates[j], strlen( candidates[j] ) ) != expected )
+                OFCHECK_FAIL( "query \"" << queries[i] << "\" and candidate \"" << candidates[j] << "\" should " << ( expected ? "" : "not " ) << "match" );
+        }
+    }
+}
+
+OFTEST(dcmdata_attribute_matching_compiled)
+{
+    const char* const wildCardQueries[] =
+    {
+        "", "*", "**", "?", "?*", "*?", "hello world", "hello", "?ell*??l?", "?ell***?*?l??", "?ell*?**?l?*",
+        "*o*o*", "h*d", "h*o*o*d", "*world", "hello*", "*lo w*", "*l?o*", "he?lo?wor?d", "*d*d", "o*o"
+    };
+    const char* const wildCardCandidates[] =
+    {
+        "", "h", "hello", "hello world", "hello world!", "hello wor", "hellO world", "hd", "ood", "odd", "o", "oo"
+    };
+    test_compiled( EVR_PN, wildCardQueries, sizeof( wildCardQueries ) / sizeof( wildCardQueries[0] ),
+                   wildCardCandidates, sizeof( wildCardCandidates ) / sizeof( wildCardCandidates[0] ) );
+    const char* const dateQueries[] =
+    {
+        "", "17000101", "20000101", "-20000101", "20000101-", "19990101-20000305", "1987.08.02",
+        "-", "204512101-29110114", "20451210-29110134", "3124"
+    };
+    const char* const dateCandidates[] =
+    {
+        "", "20000101", "19990531", "20010101", "19991231", "19980107", "20000306", "19870802", "122713.114122", "2000"
+    };
+    test_compiled( EVR_DA, dateQueries, sizeof( dateQueries ) / sizeof( dateQueries[0] ),
+                   dateCandidates, sizeof( dateCandidates ) / sizeof( dateCandidates[0] ) );
+    const char* const timeQueries[] =
+    {
+        "", "12", "-12", "1200-", "12-", "11-121428.234763", "11:23:17.123456", "49", "04-25"
+    };
+    const char* const timeCandidates[] =
+    {
+        "", "120000", "113059.654321", "120000.000001", "115959.999999", "12", "105959.999999", "121428.234764",
+        "112317.123456", "20140909"
+    };
+    test_compiled( EVR_TM, timeQueries, sizeof( timeQueries ) / sizeof( timeQueries[0] ),
+                   timeCandidates, sizeof( timeCandidates ) / sizeof( timeCandidates[0] ) );
+    const char* const dateTimeQueries[] =
+    {
+        "", "-2000", "200001-", "2000-", "1999-20000305173259.123456", "20170224113224.000000+0030", "201713-2018"
+    };
+    const char* const dateTimeCandidates[] =
+    {
+        "", "20000101000000.000000", "19990531132417.231194", "20000102000000.000001", "2001010100",
+        "19991231235959.999999", "1998010712+0430", "20000306", "20170224120224+0100"
+    };
+    test_compiled( EVR_DT, dateTimeQueries, sizeof( dateTimeQueries ) / sizeof( dateTimeQueries[0] ),
+                   dateTimeCandidates, sizeof( dateTimeCandidates ) / sizeof( dateTimeCandidates[0] ) );
+    const char* const uidQueries[] =
+    {
+        "", "123.456.789.10", "456.789.10", "456.789.10\\123.456.789.10", "456.789.10\\123.456.789.10\\456.123.789.10",
+        "456.789.10\\123.456.79.10\\456.123.789.10", "1.2\\", "\\1.2.3\\1.2\\1.2.3.4\\1"
+    };
+    const char* const uidCandidates[] =
+    {
+        "", "1", "1.2", "1.2.3", "123.456.789.10", "456.789.10", "456.123.789.10", "123.456.789.1"
+    };
+    test_compiled( EVR_UI, uidQueries, sizeof( uidQueries ) / sizeof( uidQueries[0] ),
+                   uidCandidates, sizeof( uidCandidates ) / sizeof( uidCandidates[0] ) );
+    const char* const singleValueQueries[] = { "", "Hello world!", "Hello*world!" };
+    const char* const singleValueCandidates[] = { "", "Hello world!", "Hello*world!", "Hello" };
+    test_compiled( EVR_US, singleValueQueries, sizeof( singleValueQueries ) / sizeof( singleValueQueries[0] ),
+                   singleValueCandidates, sizeof( singleValueCandidates ) / sizeof( singleValueCandidates[0] ) );
+    // default constructed objects cannot be used for matching
+    DcmAttributeMatching::CompiledQuery query;
+    OFCHECK(!query);
+    // copies remain valid after the original is gone
+    query = DcmAttributeMatching::CompiledQuery( EVR_PN, "M?ller*", 7 );
+    OFCHECK(query( "Miller", 6 ));
+    OFCHECK(query( "Muller^Hans", 11 ));
+    OFCHECK(!query( "Mueller", 7 ));
+    OFCHECK(!query( "^Martin", 7 ));
+}
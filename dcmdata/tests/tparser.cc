@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2020, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -29,6 +29,7 @@
 #include "dcmtk/dcmdata/dcpxitem.h"
 #include "dcmtk/dcmdata/dcistrmb.h"
 #include "dcmtk/dcmdata/dcostrmb.h"
+#include "dcmtk/dcmdata/dcpath.h"
 #include "dctmacro.h"
 
 
@@ -252,7 +253,7 @@ OFTEST(dcmdata_parser_explicitItemLengthTooLarge)
     }
 }
 
-static void testOddLengthPartialValue(const Uint8* data, size_t length)
+static void testOddLengthPartialValue(const Uint8* data, size_t length, OFBool useMemoryMapping = OFFalse, OFBool useSharedFileHandle = OFFalse)
 {
     const unsigned int bytesToRead = 5;
     DcmFileFormat dfile;
@@ -274,7 +275,11 @@ static void testOddLengthPartialValue(const Uint8* data, size_t length)
     f.fclose();
 
     // Everything larger than 1 byte won't be loaded now but only later
+    dcmUseMemoryMappedFileInput.set(useMemoryMapping);
+    dcmUseSharedFileHandleInput.set(useSharedFileHandle);
     cond = dfile.loadFile(temp.getFilename(), TRANSFER_SYNTAX, EGL_noChange, 1, ERM_dataset);
+    dcmUseMemoryMappedFileInput.set(OFFalse);
+    dcmUseSharedFileHandleInput.set(OFFalse);
     if (cond.bad())
     {
         OFCHECK_FAIL(cond.text());
@@ -329,6 +334,141 @@ OFTEST(dcmdata_parser_oddLengthPartialValue_notLastItem)
     testOddLengthPartialValue(data, sizeof(data));
 }
 
+OFTEST(dcmdata_parser_memoryMappedInput)
+{
+    const Uint8 data[] = {
+        TAG_AND_LENGTH(DCM_PixelData, 'O', 'W', 5),
+        VALUE, VALUE, VALUE, VALUE, VALUE,
+        TAG_AND_LENGTH(DCM_DataSetTrailingPadding, 'O', 'B', 4),
+        VALUE, VALUE, VALUE, VALUE
+    };
+
+    // Same as above, but the file (and the deferred value) is read from a memory mapping
+    testOddLengthPartialValue(data, sizeof(data), OFTrue);
+}
+
+OFTEST(dcmdata_parser_sharedFileHandleInput)
+{
+    const Uint8 data[] = {
+        TAG_AND_LENGTH(DCM_PixelData, 'O', 'W', 5),
+        VALUE, VALUE, VALUE, VALUE, VALUE,
+        TAG_AND_LENGTH(DCM_DataSetTrailingPadding, 'O', 'B', 4),
+        VALUE, VALUE, VALUE, VALUE
+    };
+
+    // Same as above, but the file (and the deferred value) is read through a shared file handle
+    testOddLengthPartialValue(data, sizeof(data), OFFalse, OFTrue);
+}
+
+static void testSelectiveReading(const E_TransferSyntax xfer, const E_EncodingType encType)
+{
+    DcmFileFormat dfile;
+    DcmDataset *dset = dfile.getDataset();
+    DcmItem *item = NULL;
+    OFTempFile temp;
+
+    if (temp.getStatus().bad())
+    {
+        OFCHECK_FAIL("Could not create temporary file: " << temp.getStatus().text());
+        return;
+    }
+
+    // create a dataset with some attributes that are not selected below
+    OFCHECK(dset->putAndInsertString(DCM_PatientName, "Doe^John").good());
+    OFCHECK(dset->putAndInsertString(DCM_PatientID, "12345").good());
+    OFCHECK(dset->putAndInsertString(DCM_StudyDescription, "Selective reading").good());
+    for (int i = 0; i < 2; ++i)
+    {
+        OFCHECK(dset->findOrCreateSequenceItem(DCM_ReferencedSeriesSequence, item, -2).good());
+        OFCHECK(item->putAndInsertString(DCM_SeriesInstanceUID, i == 0 ? "1.2.3.4" : "1.2.3.5").good());
+        OFCHECK(item->putAndInsertString(DCM_ReferencedSOPClassUID, UID_CTImageStorage).good());
+        OFCHECK(dset->findOrCreateSequenceItem(DCM_ContentSequence, item, -2).good());
+        OFCHECK(item->putAndInsertString(DCM_CodeValue, "121071").good());
+    }
+    OFCHECK(dset->putAndInsertString(DcmTag(0x0009, 0x0010, EVR_LO), "SELECTIVE TEST").good());
+    OFCHECK(dset->putAndInsertString(DcmTag(0x0009, 0x1001, EVR_LO), "selected").good());
+    OFCHECK(dset->putAndInsertString(DcmTag(0x0011, 0x0010, EVR_LO), "OTHER TEST").good());
+    OFCHECK(dset->putAndInsertString(DcmTag(0x0011, 0x1001, EVR_LO), "not selected").good());
+    Uint8 pixelData[1024];
+    memset(pixelData, 0x55, sizeof(pixelData));
+    OFCHECK(dset->putAndInsertUint8Array(DCM_PixelData, pixelData, sizeof(pixelData)).good());
+    OFCondition cond = dfile.saveFile(temp.getFilename(), xfer, encType);
+    if (cond.bad())
+    {
+        OFCHECK_FAIL(cond.text());
+        return;
+    }
+
+    DcmTagSelection selection;
+    OFCHECK(selection.addPath("PatientName").good());
+    OFCHECK(selection.addPath("ReferencedSeriesSequence[*].SeriesInstanceUID").good());
+    OFCHECK(selection.addPath("(0009,1001)").good());
+    OFCHECK(selection.addPath("UnknownAttributeName").bad());
+    OFCHECK(selection.addPath("ContentSequence[").bad());
+
+    DcmFileFormat selectedFile;
+    cond = selectedFile.loadFileSelective(temp.getFilename(), selection);
+    if (cond.bad())
+    {
+        OFCHECK_FAIL(cond.text());
+        return;
+    }
+    dset = selectedFile.getDataset();
+    OFCHECK(dset->getReadSelection() == NULL);
+    OFCHECK(selectedFile.getMetaInfo()->tagExists(DCM_MediaStorageSOPInstanceUID));
+    // sequence, private creator, private element and patient name
+    OFCHECK_EQUAL(dset->card(), 4);
+    OFCHECK(dset->tagExists(DCM_PatientName));
+    OFCHECK(dset->tagExists(DcmTagKey(0x0009, 0x0010)));
+    OFCHECK(dset->tagExists(DcmTagKey(0x0009, 0x1001)));
+    OFCHECK(!dset->tagExists(DCM_PatientID));
+    OFCHECK(!dset->tagExists(DCM_ContentSequence));
+    OFCHECK(!dset->tagExists(DCM_PixelData));
+    OFString value;
+    OFCHECK(dset->findAndGetOFString(DCM_PatientName, value).good());
+    OFCHECK_EQUAL(value, "Doe^John");
+    // no references to the selection remain after reading
+    DcmSequenceOfItems *seq = NULL;
+    OFCHECK(dset->findAndGetSequence(DCM_ReferencedSeriesSequence, seq).good());
+    if (seq != NULL)
+        OFCHECK(seq->getItemReadSelection() == NULL);
+    for (int i = 0; i < 2; ++i)
+    {
+        OFCHECK(dset->findAndGetSequenceItem(DCM_ReferencedSeriesSequence, item, i).good());
+        if (item != NULL)
+        {
+            OFCHECK(item->getReadSelection() == NULL);
+            OFCHECK_EQUAL(item->card(), 1);
+            OFCHECK(item->findAndGetOFString(DCM_SeriesInstanceUID, value).good());
+            OFCHECK_EQUAL(value, i == 0 ? "1.2.3.4" : "1.2.3.5");
+        }
+    }
+
+    // a sequence path without attribute selects the complete sequence
+    selection.clear();
+    OFCHECK(selection.empty());
+    OFCHECK(selection.addPath("ContentSequence[*].CodeValue").good());
+    OFCHECK(selection.addPath("ContentSequence").good());
+    cond = selectedFile.loadFileSelective(temp.getFilename(), selection);
+    OFCHECK(cond.good());
+    OFCHECK_EQUAL(dset->card(), 1);
+    OFCHECK(dset->findAndGetSequenceItem(DCM_ContentSequence, item, 1).good());
+
+    // reading without a selection reads everything again
+    cond = selectedFile.loadFile(temp.getFilename());
+    OFCHECK(cond.good());
+    OFCHECK(dset->tagExists(DCM_PixelData));
+    OFCHECK(dset->tagExists(DCM_PatientID));
+}
+
+OFTEST(dcmdata_parser_selectiveReading)
+{
+    testSelectiveReading(EXS_LittleEndianExplicit, EET_ExplicitLength);
+    testSelectiveReading(EXS_LittleEndianExplicit, EET_UndefinedLength);
+    testSelectiveReading(EXS_LittleEndianImplicit, EET_UndefinedLength);
+    testSelectiveReading(EXS_BigEndianExplicit, EET_ExplicitLength);
+}
+
 static const DcmTagKey wrongExplicitVRinDataset_unknownTag1(0x0006, 0x0006);
 static const DcmTagKey wrongExplicitVRinDataset_unknownTag2(0x0006, 0x0008);
 
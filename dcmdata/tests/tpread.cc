@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2021, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -406,3 +406,88 @@ OFTEST(dcmdata_partialElementAccess)
 #endif
     delete[] buffer;
 }
+
+OFTEST(dcmdata_partialElementAccessSharedFile)
+{
+    /* make sure data dictionary is loaded */
+    if (!dcmDataDict.isDictionaryLoaded())
+    {
+      OFCHECK_FAIL("no data dictionary loaded, check environment variable: " DCM_DICT_ENVIRONMENT_VARIABLE);
+      return;
+    }
+
+    OFRandom rnd;
+    DcmFileFormat dfile;
+
+    unsigned char *buffer = new unsigned char[BUFSIZE];
+    unsigned char *bufptr = buffer;
+    for (int i = BUFSIZE; i; --i)
+    {
+      *bufptr++ = OFstatic_cast(unsigned char, rnd.getRND32());
+    }
+
+    createTestDataset(dfile.getDataset(), buffer);
+    OFCondition cond = dfile.saveFile("test_sh.dcm", EXS_LittleEndianExplicit);
+    if (cond.bad()) { OFCHECK_FAIL(cond.text()); }
+
+    // all values remain in the file and are read through a shared file handle
+    DcmFileFormat *dfile_sh = new DcmFileFormat();
+    dcmUseSharedFileHandleInput.set(OFTrue);
+    cond = dfile_sh->loadFile("test_sh.dcm");
+    dcmUseSharedFileHandleInput.set(OFFalse);
+    if (cond.bad()) { OFCHECK_FAIL(cond.text()); }
+
+    DcmElement *delem = NULL;
+    OFCHECK(dfile_sh->getDataset()->findAndGetElement(DCM_EncapsulatedDocument, delem).good());
+    if (delem)
+    {
+      const DcmInputStreamFactory *factory = delem->getInputStream();
+      OFCHECK(factory != NULL && factory->ident() == DFT_DcmInputSharedFileStreamFactory);
+
+      // the value can be accessed directly in the file
+      OFFilename filename;
+      offile_off_t offset = 0;
+      Uint32 length = 0;
+      OFCHECK(delem->getValueFileLocation(filename, offset, length).good());
+      OFCHECK_EQUAL(OFString(filename.getCharPointer()), "test_sh.dcm");
+      OFCHECK_EQUAL(length, OFstatic_cast(Uint32, BUFSIZE));
+      unsigned char *target = new unsigned char[BUFSIZE];
+      OFFile file;
+      OFCHECK(file.fopen(filename, "rb"));
+      OFCHECK_EQUAL(file.fseek(offset, SEEK_SET), 0);
+      OFCHECK_EQUAL(file.fread(target, 1, BUFSIZE), OFstatic_cast(size_t, BUFSIZE));
+      file.fclose();
+      OFCHECK(memcmp(target, buffer, BUFSIZE) == 0);
+      delete[] target;
+    }
+
+    cond = sequentialNonOverlappingRead(rnd, dfile_sh->getDataset(), buffer);
+    if (cond.bad()) { OFCHECK_FAIL(cond.text()); }
+    cond = randomRead(rnd, dfile_sh->getDataset(), buffer);
+    if (cond.bad()) { OFCHECK_FAIL(cond.text()); }
+
+    // a copy of the dataset refers to the same file handle, which remains
+    // open after the original dataset has been deleted
+    DcmFileFormat dfile_copy(*dfile_sh);
+    delete dfile_sh;
+    cond = sequentialOverlappingRead(rnd, dfile_copy.getDataset(), buffer);
+    if (cond.bad()) { OFCHECK_FAIL(cond.text()); }
+
+    OFCHECK(dfile_copy.getDataset()->findAndGetElement(DCM_EncapsulatedDocument, delem).good());
+    if (delem)
+    {
+      OFCHECK(delem->loadAllDataIntoMemory().good());
+      Uint8 *value = NULL;
+      OFCHECK(delem->getUint8Array(value).good());
+      OFCHECK(value != NULL && memcmp(value, buffer, BUFSIZE) == 0);
+
+      // once loaded, the value is no longer located in the file
+      OFFilename filename;
+      offile_off_t offset = 0;
+      Uint32 length = 0;
+      OFCHECK(delem->getValueFileLocation(filename, offset, length) == EC_IllegalCall);
+    }
+
+    unlink("test_sh.dcm");
+    delete[] buffer;
+}
@@ -0,0 +1,341 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: test program for class DcmStreamParser
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcsparse.h"
+#include "dcmtk/dcmdata/dcpxitem.h"
+#include "dcmtk/dcmdata/dcistrmb.h"
+
+#define PIXELSIZE 1000
+
+
+/* handler that records the parser events */
+class DcmTestParserHandler: public DcmParserHandler
+{
+public:
+  DcmTestParserHandler()
+  : xfer(EXS_Unknown), events(), patientName(), privateCreator(), pixelBytes(0)
+  , fragments(0), fragmentBytes(0), skipPatientName(OFFalse), stopAtTag()
+  {
+  }
+
+  virtual OFCondition startDataset(const E_TransferSyntax x)
+  {
+    xfer = x;
+    events += "DS ";
+    return EC_Normal;
+  }
+
+  virtual OFCondition endDataset()
+  {
+    events += "/DS";
+    return EC_Normal;
+  }
+
+  virtual OFCondition elementHeader(const DcmTag& tag, const Uint32 /* length */, OFBool& readValue)
+  {
+    if (tag == stopAtTag) return EC_IllegalCall;
+    if (tag.getGroup() == 0x0002) return EC_Normal;
+    if ((tag == DCM_PatientName) && skipPatientName) readValue = OFFalse;
+    if (tag.isPrivate() && (tag.getElement() >= 0x1000) && tag.getPrivateCreator()) privateCreator = tag.getPrivateCreator();
+    events += tag.toString() + " ";
+    return EC_Normal;
+  }
+
+  virtual OFCondition elementValue(const DcmTag& tag, const Uint8 *data, const Uint32 length, const Uint32 offset)
+  {
+    if (tag == DCM_PatientName) patientName.append(OFreinterpret_cast(const char *, data), length);
+    if (tag == DCM_PixelData)
+    {
+      OFCHECK_EQUAL(offset, pixelBytes);
+      pixelBytes += length;
+    }
+    return EC_Normal;
+  }
+
+  virtual OFCondition startSequence(const DcmTag& tag, const Uint32 /* length */)
+  {
+    events += "SQ" + tag.toString() + " ";
+    return EC_Normal;
+  }
+
+  virtual OFCondition endSequence(const DcmTag& /* tag */)
+  {
+    events += "/SQ ";
+    return EC_Normal;
+  }
+
+  virtual OFCondition startItem(const Uint32 /* length */)
+  {
+    events += "IT ";
+    return EC_Normal;
+  }
+
+  virtual OFCondition endItem()
+  {
+    events += "/IT ";
+    return EC_Normal;
+  }
+
+  virtual OFCondition startPixelSequence(const DcmTag& /* tag */)
+  {
+    events += "PS ";
+    return EC_Normal;
+  }
+
+  virtual OFCondition pixelFragment(const Uint32 fragment, const Uint8 * /* data */, const Uint32 length, const Uint32 offset, const Uint32 fragmentLength)
+  {
+    if (offset == 0) ++fragments;
+    if (offset + length == fragmentLength) OFCHECK_EQUAL(fragment + 1, fragments);
+    fragmentBytes += length;
+    return EC_Normal;
+  }
+
+  virtual OFCondition endPixelSequence()
+  {
+    events += "/PS ";
+    return EC_Normal;
+  }
+
+  E_TransferSyntax xfer;
+  OFString events;
+  OFString patientName;
+  OFString privateCreator;
+  Uint32 pixelBytes;
+  Uint32 fragments;
+  Uint32 fragmentBytes;
+  OFBool skipPatientName;
+  DcmTagKey stopAtTag;
+};
+
+
+/* create a test file with a sequence, a private element and pixel data */
+static OFCondition createFile(const OFFilename& filename, E_TransferSyntax xfer)
+{
+  DcmFileFormat dfile;
+  DcmDataset *dset = dfile.getDataset();
+  DcmItem *item = NULL;
+  OFCHECK(dset->putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage).good());
+  OFCHECK(dset->putAndInsertString(DCM_SOPInstanceUID, "1.2.276.0.7230010.3.1.4.2").good());
+  OFCHECK(dset->putAndInsertString(DCM_PatientName, "Doe^John").good());
+  for (int i = 0; i < 2; ++i)
+  {
+    OFCHECK(dset->findOrCreateSequenceItem(DCM_ReferencedSeriesSequence, item, -2).good());
+    OFCHECK(item->putAndInsertString(DCM_SeriesInstanceUID, i == 0 ? "1.2.3.4" : "1.2.3.5").good());
+  }
+  OFCHECK(dset->putAndInsertString(DcmTag(0x0009, 0x0010, EVR_LO), "STREAM PARSER TEST").good());
+  OFCHECK(dset->putAndInsertString(DcmTag(0x0009, 0x1001, EVR_LO), "private").good());
+  Uint8 pixelData[PIXELSIZE];
+  memset(pixelData, 0x55, sizeof(pixelData));
+  if (DcmXfer(xfer).isEncapsulated())
+  {
+    DcmPixelData *pixel = new DcmPixelData(DCM_PixelData);
+    DcmPixelSequence *pixSeq = new DcmPixelSequence(DCM_PixelSequenceTag);
+    pixSeq->insert(new DcmPixelItem(DCM_PixelItemTag));
+    DcmOffsetList offsetList;
+    OFCHECK(pixSeq->storeCompressedFrame(offsetList, pixelData, PIXELSIZE, 0).good());
+    pixel->putOriginalRepresentation(xfer, NULL, pixSeq);
+    OFCHECK(dset->insert(pixel).good());
+  }
+  else
+    OFCHECK(dset->putAndInsertUint8Array(DCM_PixelData, pixelData, sizeof(pixelData)).good());
+  return dfile.saveFile(filename, xfer);
+}
+
+
+static void parseTestFile(E_TransferSyntax xfer)
+{
+  OFTempFile temp;
+  if (temp.getStatus().bad())
+  {
+    OFCHECK_FAIL("Could not create temporary file: " << temp.getStatus().text());
+    return;
+  }
+  OFCondition cond = createFile(temp.getFilename(), xfer);
+  if (cond.bad())
+  {
+    OFCHECK_FAIL(cond.text());
+    return;
+  }
+
+  DcmTestParserHandler handler;
+  DcmStreamParser parser(handler);
+  // use a small chunk size in order to check that values are split correctly
+  parser.setChunkSize(64);
+  cond = parser.parseFile(temp.getFilename());
+  if (cond.bad())
+  {
+    OFCHECK_FAIL(cond.text());
+    return;
+  }
+  OFCHECK_EQUAL(handler.xfer, xfer);
+  OFCHECK_EQUAL(handler.patientName, "Doe^John");
+  OFCHECK_EQUAL(handler.privateCreator, "STREAM PARSER TEST");
+  OFString expected = "DS (0008,0016) (0008,0018) SQ(0008,1115) IT (0020,000e) /IT IT (0020,000e) /IT /SQ "
+    "(0009,0010) (0009,1001) (0010,0010) ";
+  if (DcmXfer(xfer).isEncapsulated())
+  {
+    expected += "PS /PS /DS";
+    OFCHECK_EQUAL(handler.fragments, 2);
+    OFCHECK_EQUAL(handler.fragmentBytes, PIXELSIZE);
+  }
+  else
+  {
+    expected += "(7fe0,0010) /DS";
+    OFCHECK_EQUAL(handler.pixelBytes, PIXELSIZE);
+  }
+  OFCHECK_EQUAL(handler.events, expected);
+
+  // skipped values are not reported
+  DcmTestParserHandler skipHandler;
+  skipHandler.skipPatientName = OFTrue;
+  DcmStreamParser skipParser(skipHandler);
+  OFCHECK(skipParser.parseFile(temp.getFilename()).good());
+  OFCHECK(skipHandler.patientName.empty());
+  OFCHECK_EQUAL(skipHandler.events, handler.events);
+
+  // an error returned by the handler stops parsing
+  DcmTestParserHandler stopHandler;
+  stopHandler.stopAtTag = DCM_PatientName;
+  DcmStreamParser stopParser(stopHandler);
+  OFCHECK(stopParser.parseFile(temp.getFilename()) == EC_IllegalCall);
+  OFCHECK(stopHandler.events.find("(7fe0,0010)") == OFString_npos);
+}
+
+
+OFTEST(dcmdata_streamParser)
+{
+  parseTestFile(EXS_LittleEndianExplicit);
+  parseTestFile(EXS_LittleEndianImplicit);
+  parseTestFile(EXS_BigEndianExplicit);
+#ifdef WITH_ZLIB
+  parseTestFile(EXS_DeflatedLittleEndianExplicit);
+#endif
+  parseTestFile(EXS_RLELossless);
+}
+
+
+OFTEST(dcmdata_streamParserDataset)
+{
+  // dataset without file meta information, transfer syntax is detected
+  OFTempFile temp;
+  if (temp.getStatus().bad())
+  {
+    OFCHECK_FAIL("Could not create temporary file: " << temp.getStatus().text());
+    return;
+  }
+  DcmFileFormat dfile;
+  DcmDataset *dset = dfile.getDataset();
+  OFCHECK(dset->putAndInsertString(DCM_PatientName, "Doe^Jane").good());
+  OFCHECK(dset->putAndInsertString(DCM_PatientID, "12345").good());
+  OFCHECK(dset->saveFile(temp.getFilename(), EXS_LittleEndianImplicit).good());
+
+  DcmTestParserHandler handler;
+  DcmStreamParser parser(handler);
+  OFCHECK(parser.parseFile(temp.getFilename()).good());
+  OFCHECK_EQUAL(handler.xfer, EXS_LittleEndianImplicit);
+  OFCHECK_EQUAL(handler.patientName, "Doe^Jane");
+  OFCHECK_EQUAL(handler.events, "DS (0010,0010) (0010,0020) /DS");
+
+  // missing file
+  OFCHECK(parser.parseFile("").bad());
+}
+
+
+/* parse a dataset encoded in the given buffer */
+static OFCondition parseBuffer(const Uint8 *data, size_t length, E_TransferSyntax xfer, DcmTestParserHandler& handler)
+{
+  DcmInputBufferStream stream;
+  stream.setBuffer(data, OFstatic_cast(offile_off_t, length));
+  stream.setEos();
+  DcmStreamParser parser(handler);
+  return parser.parseDataset(stream, xfer);
+}
+
+
+OFTEST(dcmdata_streamParserUndefinedLength)
+{
+  // Make sure data dictionary is loaded
+  if (!dcmDataDict.isDictionaryLoaded())
+  {
+    OFCHECK_FAIL("no data dictionary loaded, check environment variable: " DCM_DICT_ENVIRONMENT_VARIABLE);
+    return;
+  }
+  // other tests may have changed the global parser flags
+  dcmIgnoreParsingErrors.set(OFFalse);
+  dcmConvertUndefinedLengthOBOWtoSQ.set(OFFalse);
+
+  // unknown private element with undefined length in implicit VR is a sequence
+  const Uint8 implicitSQ[] = {
+    0x09, 0x00, 0x02, 0x10, 0xff, 0xff, 0xff, 0xff,  // (0009,1002), undefined length
+    0xfe, 0xff, 0x00, 0xe0, 0xff, 0xff, 0xff, 0xff,  // item, undefined length
+    0x10, 0x00, 0x20, 0x00, 0x02, 0x00, 0x00, 0x00,  // (0010,0020), length 2
+    '4', '2',
+    0xfe, 0xff, 0x0d, 0xe0, 0x00, 0x00, 0x00, 0x00,  // item delimitation item
+    0xfe, 0xff, 0xdd, 0xe0, 0x00, 0x00, 0x00, 0x00   // sequence delimitation item
+  };
+  DcmTestParserHandler sqHandler;
+  OFCHECK(parseBuffer(implicitSQ, sizeof(implicitSQ), EXS_LittleEndianImplicit, sqHandler).good());
+  OFCHECK_EQUAL(sqHandler.events, "DS SQ(0009,1002) IT (0010,0020) /IT /SQ /DS");
+
+  // known non-sequence element with undefined length in implicit VR is an error
+  const Uint8 implicitLO[] = {
+    0x10, 0x00, 0x10, 0x00, 0xff, 0xff, 0xff, 0xff,  // (0010,0010), undefined length
+    0xfe, 0xff, 0xdd, 0xe0, 0x00, 0x00, 0x00, 0x00   // sequence delimitation item
+  };
+  DcmTestParserHandler loHandler;
+  OFCHECK(parseBuffer(implicitLO, sizeof(implicitLO), EXS_LittleEndianImplicit, loHandler) == EC_CorruptedData);
+  OFCHECK(loHandler.events.find("SQ") == OFString_npos);
+
+  // explicit VR UT with undefined length is an error
+  const Uint8 explicitUT[] = {
+    0x08, 0x00, 0x19, 0x01, 'U', 'T', 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,  // (0008,0119)
+    0xfe, 0xff, 0xdd, 0xe0, 0x00, 0x00, 0x00, 0x00   // sequence delimitation item
+  };
+  DcmTestParserHandler utHandler;
+  OFCHECK(parseBuffer(explicitUT, sizeof(explicitUT), EXS_LittleEndianExplicit, utHandler) == EC_CorruptedData);
+
+  // explicit VR OB with undefined length (other than pixel data) is an error
+  const Uint8 explicitOB[] = {
+    0x42, 0x00, 0x11, 0x00, 'O', 'B', 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,  // (0042,0011)
+    0xfe, 0xff, 0xdd, 0xe0, 0x00, 0x00, 0x00, 0x00   // sequence delimitation item
+  };
+  DcmTestParserHandler obHandler;
+  OFCHECK(parseBuffer(explicitOB, sizeof(explicitOB), EXS_LittleEndianExplicit, obHandler) == EC_UndefinedLengthOBOW);
+
+  // unless conversion to a sequence is enabled
+  dcmConvertUndefinedLengthOBOWtoSQ.set(OFTrue);
+  DcmTestParserHandler convHandler;
+  OFCHECK(parseBuffer(explicitOB, sizeof(explicitOB), EXS_LittleEndianExplicit, convHandler).good());
+  dcmConvertUndefinedLengthOBOWtoSQ.set(OFFalse);
+  OFCHECK_EQUAL(convHandler.events, "DS SQ(0042,0011) /SQ /DS");
+
+  // or parsing errors are ignored
+  dcmIgnoreParsingErrors.set(OFTrue);
+  DcmTestParserHandler ignoreHandler;
+  OFCHECK(parseBuffer(explicitOB, sizeof(explicitOB), EXS_LittleEndianExplicit, ignoreHandler).good());
+  dcmIgnoreParsingErrors.set(OFFalse);
+}
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2022, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -223,3 +223,91 @@ OFTEST(dcmdata_specificCharacterSet_4)
         DCMDATA_WARN("Cannot test DcmSpecificCharacterSet since the underlying character set conversion library is not available");
     }
 }
+
+
+OFTEST(dcmdata_specificCharacterSet_5)
+{
+    DcmSpecificCharacterSet converter;
+    if (converter.isConversionAvailable())
+    {
+        OFString resultStr;
+        // ASCII strings are not changed by the conversion between ASCII compatible character sets
+        OFCHECK(converter.selectCharacterSet("ISO_IR 100").good());
+        OFCHECK(converter.convertString("Doe^John\\Smith", resultStr).good());
+        OFCHECK_EQUAL(resultStr, "Doe^John\\Smith");
+        OFCHECK(converter.convertString(OFString("A\0B", 3), resultStr).good());
+        OFCHECK_EQUAL(resultStr, OFString("A\0B", 3));
+        OFCHECK(converter.convertString("J\366rg", resultStr).good());
+        OFCHECK_EQUAL(resultStr, "J\303\266rg");
+        // the same applies to the default character set and code extensions
+        OFCHECK(converter.selectCharacterSet("", "ISO_IR 100").good());
+        OFCHECK(converter.convertString("Doe^John", resultStr).good());
+        OFCHECK_EQUAL(resultStr, "Doe^John");
+        // but 8-bit characters are still rejected for ASCII
+        OFCHECK(converter.convertString("J\366rg", resultStr).bad());
+        OFCHECK(converter.selectCharacterSet("\\ISO 2022 IR 100").good());
+        OFCHECK(converter.convertString("Doe^John=Doe^John", resultStr, "=^").good());
+        OFCHECK_EQUAL(resultStr, "Doe^John=Doe^John");
+        // escape sequences are still processed
+        OFCHECK(converter.selectCharacterSet("\\ISO 2022 IR 149").good());
+        OFCHECK(converter.convertString("Hong^Gildong=\033$)C\373\363^\033$)C\321\316\324\327", resultStr, "=^").good());
+        OFCHECK_EQUAL(resultStr, "Hong^Gildong=\346\264\252^\345\220\211\346\264\236");
+        // a cleared converter cannot be used
+        converter.clear();
+        OFCHECK(converter.convertString("Some Text", resultStr).bad());
+    } else {
+        // in case there is no libiconv, report a warning but do not fail
+        DCMDATA_WARN("Cannot test DcmSpecificCharacterSet since the underlying character set conversion library is not available");
+    }
+}
+
+
+OFTEST(dcmdata_specificCharacterSet_6)
+{
+    if (DcmSpecificCharacterSet::isConversionAvailable())
+    {
+        OFString resultStr;
+        DcmSpecificCharacterSet *converter1 = NULL;
+        DcmSpecificCharacterSet *converter2 = NULL;
+        DcmSpecificCharacterSet::clearConverterCache();
+        // converters in use are not shared
+        OFCHECK(DcmSpecificCharacterSet::acquireConverter("ISO_IR 100", "ISO_IR 192", 0, converter1).good());
+        OFCHECK(DcmSpecificCharacterSet::acquireConverter("ISO_IR 100", "ISO_IR 192", 0, converter2).good());
+        OFCHECK(converter1 != NULL);
+        OFCHECK(converter2 != NULL);
+        OFCHECK(converter1 != converter2);
+        if ((converter1 != NULL) && (converter2 != NULL))
+        {
+            OFCHECK(converter1->convertString("J\366rg", resultStr).good());
+            OFCHECK_EQUAL(resultStr, "J\303\266rg");
+            OFCHECK_EQUAL(converter2->getSourceCharacterSet(), "ISO_IR 100");
+        }
+        // released converters are reused for the same combination only,
+        // the most recently released one first
+        DcmSpecificCharacterSet *released = converter1;
+        DcmSpecificCharacterSet::releaseConverter(converter2);
+        DcmSpecificCharacterSet::releaseConverter(converter1);
+        OFCHECK(DcmSpecificCharacterSet::acquireConverter("ISO_IR 100", "ISO_IR 100", 0, converter1).good());
+        OFCHECK(converter1 != released);
+        DcmSpecificCharacterSet::releaseConverter(converter1);
+        OFCHECK(DcmSpecificCharacterSet::acquireConverter("ISO_IR 100", "ISO_IR 192", 0, converter1).good());
+        OFCHECK(converter1 == released);
+        if (converter1 != NULL)
+        {
+            OFCHECK(converter1->convertString("J\351r\364me", resultStr).good());
+            OFCHECK_EQUAL(resultStr, "J\303\251r\303\264me");
+        }
+        DcmSpecificCharacterSet::releaseConverter(converter1);
+        // invalid character sets are reported
+        OFCHECK(DcmSpecificCharacterSet::acquireConverter("DCMTK", "ISO_IR 192", 0, converter1).bad());
+        OFCHECK(converter1 == NULL);
+        // with a disabled cache, converters are not reused
+        DcmSpecificCharacterSet::setConverterCacheSize(0);
+        OFCHECK(DcmSpecificCharacterSet::acquireConverter("ISO_IR 100", "ISO_IR 192", 0, converter1).good());
+        DcmSpecificCharacterSet::releaseConverter(converter1);
+        DcmSpecificCharacterSet::setConverterCacheSize(DCMTK_CHARSET_CONVERTER_CACHE_SIZE);
+    } else {
+        // in case there is no libiconv, report a warning but do not fail
+        DCMDATA_WARN("Cannot test DcmSpecificCharacterSet since the underlying character set conversion library is not available");
+    }
+}
@@ -0,0 +1,162 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: test program for the byte order functions
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/dcmdata/dcswap.h"
+#include "dcmtk/dcmdata/dcvrus.h"
+#include "dcmtk/dcmdata/dcdeftag.h"
+
+#define BUFSIZE 67
+
+
+/* helper class providing access to the value field in a given byte order */
+class DcmSwapTestElement: public DcmUnsignedShort
+{
+public:
+  DcmSwapTestElement(const DcmTag& tag) : DcmUnsignedShort(tag) { }
+  using DcmElement::getValue;
+};
+
+
+/* fill buffer with the byte sequence 0, 1, 2, ... */
+static void fillBuffer(Uint8 *buf, size_t length)
+{
+  for (size_t i = 0; i < length; ++i) buf[i] = OFstatic_cast(Uint8, i);
+}
+
+
+/* check that each value of the given width has been reversed and that
+ * trailing bytes that do not form a complete value are unchanged
+ */
+static void checkSwapped(const Uint8 *buf, size_t length, size_t width)
+{
+  const size_t swapped = (length / width) * width;
+  size_t errors = 0;
+  for (size_t i = 0; i < swapped; ++i)
+  {
+    const size_t expected = (i / width) * width + (width - 1 - i % width);
+    if (buf[i] != OFstatic_cast(Uint8, expected)) ++errors;
+  }
+  for (size_t i = swapped; i < length; ++i)
+  {
+    if (buf[i] != OFstatic_cast(Uint8, i)) ++errors;
+  }
+  OFCHECK_EQUAL(errors, 0);
+}
+
+
+OFTEST(dcmdata_swapBytes)
+{
+  Uint8 buf[BUFSIZE];
+  Uint8 copy[BUFSIZE];
+  const size_t widths[] = { 2, 3, 4, 6, 8 };
+  for (size_t w = 0; w < 5; ++w)
+  {
+    // swap in place (at an odd address to check unaligned access)
+    fillBuffer(buf + 1, BUFSIZE - 1);
+    swapBytes(buf + 1, BUFSIZE - 1, widths[w]);
+    checkSwapped(buf + 1, BUFSIZE - 1, widths[w]);
+
+    // swapping twice restores the original data
+    swapBytes(buf + 1, BUFSIZE - 1, widths[w]);
+    checkSwapped(buf + 1, BUFSIZE - 1, 1);
+
+    // swap while copying, including the trailing bytes
+    fillBuffer(buf, BUFSIZE);
+    memset(copy, 0xff, BUFSIZE);
+    swapBytesCopy(copy + 1, buf, BUFSIZE - 1, widths[w]);
+    checkSwapped(copy + 1, BUFSIZE - 1, widths[w]);
+    checkSwapped(buf, BUFSIZE, 1);
+    OFCHECK_EQUAL(copy[0], 0xff);
+  }
+
+  // swapping of single values
+  Uint8 value[4] = { 1, 2, 3, 4 };
+  OFCHECK(swapIfNecessary(EBO_BigEndian, EBO_LittleEndian, value, 4, 4).good());
+  OFCHECK(value[0] == 4 && value[1] == 3 && value[2] == 2 && value[3] == 1);
+  OFCHECK(swapIfNecessary(EBO_BigEndian, EBO_LittleEndian, value, 2, 2).good());
+  OFCHECK(value[0] == 3 && value[1] == 4);
+  OFCHECK_EQUAL(swapShort(0x1234), 0x3412);
+}
+
+
+OFTEST(dcmdata_copySwapIfNecessary)
+{
+  Uint8 buf[BUFSIZE];
+  Uint8 copy[BUFSIZE];
+  fillBuffer(buf, BUFSIZE);
+
+  // different byte orders: swap while copying
+  OFCHECK(copySwapIfNecessary(EBO_BigEndian, EBO_LittleEndian, copy, buf, BUFSIZE, 4).good());
+  checkSwapped(copy, BUFSIZE, 4);
+
+  // same byte order or single bytes: plain copy
+  OFCHECK(copySwapIfNecessary(EBO_BigEndian, EBO_BigEndian, copy, buf, BUFSIZE, 4).good());
+  checkSwapped(copy, BUFSIZE, 1);
+  OFCHECK(copySwapIfNecessary(EBO_BigEndian, EBO_LittleEndian, copy, buf, BUFSIZE, 1).good());
+  checkSwapped(copy, BUFSIZE, 1);
+
+  // unknown byte order
+  OFCHECK(copySwapIfNecessary(EBO_unknown, EBO_LittleEndian, copy, buf, BUFSIZE, 2).bad());
+}
+
+
+OFTEST(dcmdata_elementByteOrder)
+{
+  const Uint16 values[4] = { 0x0102, 0x0304, 0x0506, 0x0708 };
+  DcmSwapTestElement elem(DCM_FrameNumbersOfInterest);
+  OFCHECK(elem.putUint16Array(values, 4).good());
+
+  // change the internal byte order of the value field
+  const E_ByteOrder otherByteOrder = (gLocalByteOrder == EBO_LittleEndian) ? EBO_BigEndian : EBO_LittleEndian;
+  OFCHECK(elem.getValue(otherByteOrder) != NULL);
+
+  // partial access to complete values in local byte order
+  Uint16 partial[2] = { 0, 0 };
+  OFCHECK(elem.getPartialValue(partial, 2, 4, NULL, gLocalByteOrder).good());
+  OFCHECK_EQUAL(partial[0], 0x0304);
+  OFCHECK_EQUAL(partial[1], 0x0506);
+
+  // partial access in the internal byte order
+  OFCHECK(elem.getPartialValue(partial, 0, 2, NULL, otherByteOrder).good());
+  OFCHECK_EQUAL(partial[0], 0x0201);
+
+  // partial access that starts in the middle of a value
+  Uint8 bytes[3] = { 0, 0, 0 };
+  OFCHECK(elem.getPartialValue(bytes, 1, 3, NULL, EBO_LittleEndian).good());
+  OFCHECK(bytes[0] == 0x01 && bytes[1] == 0x04 && bytes[2] == 0x03);
+
+  // append a value, which converts the value field to local byte order
+  OFCHECK(elem.getValue(otherByteOrder) != NULL);
+  OFCHECK(elem.putUint16(0x090a, 4).good());
+  Uint16 *result = NULL;
+  OFCHECK(elem.getUint16Array(result).good());
+  OFCHECK_EQUAL(elem.getNumberOfValues(), 5);
+  if (result != NULL)
+  {
+    OFCHECK_EQUAL(result[0], 0x0102);
+    OFCHECK_EQUAL(result[3], 0x0708);
+    OFCHECK_EQUAL(result[4], 0x090a);
+  }
+}
@@ -0,0 +1,220 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  agent
+ *
+ *  Purpose: test program for class DcmStreamingWriter
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcswrite.h"
+#include "dcmtk/dcmdata/dcostrmf.h"
+#include "dcmtk/dcmdata/dcpxitem.h"
+
+#define ROWS 16
+#define COLUMNS 16
+#define FRAMES 3
+#define FRAMESIZE (ROWS * COLUMNS * 2)
+
+
+/* create the frames of the test image */
+static void createFrames(Uint16 *buf)
+{
+  for (size_t i = 0; i < FRAMES * ROWS * COLUMNS; ++i)
+    buf[i] = OFstatic_cast(Uint16, i * 7 + 0x1234);
+}
+
+
+/* stream a multi-frame image with a sequence to the given file */
+static OFCondition streamImage(const char *filename, E_TransferSyntax xfer, const Uint16 *pixelData)
+{
+  DcmOutputFileStream out(filename);
+  DcmStreamingWriter writer(out, xfer);
+  OFCondition cond = writer.writeMetaHeader(UID_SecondaryCaptureImageStorage, "1.2.276.0.7230010.3.1.4.1");
+  if (cond.good()) cond = writer.writeString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+  if (cond.good()) cond = writer.writeString(DCM_SOPInstanceUID, "1.2.276.0.7230010.3.1.4.1");
+  if (cond.good()) cond = writer.writeString(DCM_Modality, "OT");
+  if (cond.good()) cond = writer.beginSequence(DCM_ReferencedSeriesSequence);
+  for (int i = 0; cond.good() && (i < 2); ++i)
+  {
+    cond = writer.beginItem();
+    if (cond.good()) cond = writer.writeString(DCM_ReferencedSOPClassUID, UID_CTImageStorage);
+    if (cond.good()) cond = writer.writeString(DCM_SeriesInstanceUID, i == 0 ? "1.2.3.4" : "1.2.3.5");
+    if (cond.good()) cond = writer.endItem();
+  }
+  if (cond.good()) cond = writer.endSequence();
+  if (cond.good()) cond = writer.writeString(DCM_PatientName, "Doe^John");
+  if (cond.good()) cond = writer.writeUint16(DCM_SamplesPerPixel, 1);
+  if (cond.good()) cond = writer.writeString(DCM_PhotometricInterpretation, "MONOCHROME2");
+  if (cond.good()) cond = writer.writeString(DCM_NumberOfFrames, "3");
+  if (cond.good()) cond = writer.writeUint16(DCM_Rows, ROWS);
+  if (cond.good()) cond = writer.writeUint16(DCM_Columns, COLUMNS);
+  if (cond.good()) cond = writer.writeUint16(DCM_BitsAllocated, 16);
+  if (cond.good()) cond = writer.writeUint16(DCM_BitsStored, 16);
+  if (cond.good()) cond = writer.writeUint16(DCM_HighBit, 15);
+  if (cond.good()) cond = writer.writeUint16(DCM_PixelRepresentation, 0);
+  if (DcmXfer(xfer).isEncapsulated())
+  {
+    if (cond.good()) cond = writer.beginEncapsulatedPixelData();
+    // fragments of odd and even length
+    if (cond.good()) cond = writer.writePixelData(pixelData, 5);
+    if (cond.good()) cond = writer.writePixelData(pixelData, FRAMESIZE);
+  }
+  else
+  {
+    if (cond.good()) cond = writer.beginPixelData(FRAMES * FRAMESIZE);
+    for (int i = 0; cond.good() && (i < FRAMES); ++i)
+      cond = writer.writePixelData(pixelData + i * FRAMESIZE / 2, FRAMESIZE);
+  }
+  if (cond.good()) cond = writer.endPixelData();
+  if (cond.good()) cond = writer.finish();
+  return cond;
+}
+
+
+/* stream a test image in the given transfer syntax and read it back */
+static void checkStreamedImage(E_TransferSyntax xfer)
+{
+  OFTempFile temp;
+  if (temp.getStatus().bad())
+  {
+    OFCHECK_FAIL("Could not create temporary file: " << temp.getStatus().text());
+    return;
+  }
+  Uint16 pixelData[FRAMES * ROWS * COLUMNS];
+  createFrames(pixelData);
+  OFCondition cond = streamImage(temp.getFilename(), xfer, pixelData);
+  if (cond.bad())
+  {
+    OFCHECK_FAIL(cond.text());
+    return;
+  }
+
+  DcmFileFormat dfile;
+  cond = dfile.loadFile(temp.getFilename());
+  if (cond.bad())
+  {
+    OFCHECK_FAIL(cond.text());
+    return;
+  }
+  DcmDataset *dset = dfile.getDataset();
+  OFCHECK_EQUAL(dset->getOriginalXfer(), xfer);
+  OFString value;
+  OFCHECK(dfile.getMetaInfo()->findAndGetOFString(DCM_MediaStorageSOPInstanceUID, value).good());
+  OFCHECK_EQUAL(value, "1.2.276.0.7230010.3.1.4.1");
+  OFCHECK(dset->findAndGetOFString(DCM_PatientName, value).good());
+  OFCHECK_EQUAL(value, "Doe^John");
+  OFCHECK(dset->findAndGetOFString(DCM_SeriesInstanceUID, value, 0, OFTrue /* searchIntoSub */).good());
+  OFCHECK_EQUAL(value, "1.2.3.4");
+  DcmItem *item = NULL;
+  OFCHECK(dset->findAndGetSequenceItem(DCM_ReferencedSeriesSequence, item, 1).good());
+  if (item != NULL)
+  {
+    OFCHECK(item->findAndGetOFString(DCM_SeriesInstanceUID, value).good());
+    OFCHECK_EQUAL(value, "1.2.3.5");
+  }
+  Uint16 rows = 0;
+  OFCHECK(dset->findAndGetUint16(DCM_Rows, rows).good());
+  OFCHECK_EQUAL(rows, ROWS);
+
+  if (DcmXfer(xfer).isEncapsulated())
+  {
+    DcmElement *elem = NULL;
+    DcmPixelSequence *pixSeq = NULL;
+    DcmPixelItem *fragment = NULL;
+    OFCHECK(dset->findAndGetElement(DCM_PixelData, elem).good());
+    DcmPixelData *pixel = OFstatic_cast(DcmPixelData *, elem);
+    OFCHECK(pixel != NULL && pixel->getEncapsulatedRepresentation(xfer, NULL, pixSeq).good());
+    if (pixSeq != NULL)
+    {
+      OFCHECK_EQUAL(pixSeq->card(), 3);
+      Uint8 *fragmentData = NULL;
+      OFCHECK(pixSeq->getItem(fragment, 0).good() && (fragment->getLength() == 0));
+      OFCHECK(pixSeq->getItem(fragment, 1).good() && (fragment->getLength() == 6));
+      OFCHECK(pixSeq->getItem(fragment, 2).good() && (fragment->getLength() == FRAMESIZE));
+      OFCHECK(fragment->getUint8Array(fragmentData).good());
+      OFCHECK(fragmentData != NULL && memcmp(fragmentData, pixelData, FRAMESIZE) == 0);
+    }
+  }
+  else
+  {
+    const Uint16 *result = NULL;
+    unsigned long count = 0;
+    OFCHECK(dset->findAndGetUint16Array(DCM_PixelData, result, &count).good());
+    OFCHECK_EQUAL(count, FRAMES * ROWS * COLUMNS);
+    OFCHECK(result != NULL && memcmp(result, pixelData, sizeof(pixelData)) == 0);
+  }
+}
+
+
+OFTEST(dcmdata_streamingWriter)
+{
+  checkStreamedImage(EXS_LittleEndianExplicit);
+  checkStreamedImage(EXS_LittleEndianImplicit);
+  checkStreamedImage(EXS_BigEndianExplicit);
+#ifdef WITH_ZLIB
+  checkStreamedImage(EXS_DeflatedLittleEndianExplicit);
+#endif
+  checkStreamedImage(EXS_RLELossless);
+}
+
+
+OFTEST(dcmdata_streamingWriterErrors)
+{
+  OFTempFile temp;
+  if (temp.getStatus().bad())
+  {
+    OFCHECK_FAIL("Could not create temporary file: " << temp.getStatus().text());
+    return;
+  }
+  DcmOutputFileStream out(temp.getFilename());
+  Uint8 data[4] = { 0, 0, 0, 0 };
+
+  // big endian implicit is not a valid encoding
+  DcmStreamingWriter invalid(out, EXS_BigEndianImplicit);
+  OFCHECK(invalid.status() == EC_UnsupportedEncoding);
+
+  DcmStreamingWriter writer(out, EXS_LittleEndianExplicit);
+  OFCHECK(writer.writeString(DCM_PatientName, "Doe^John").good());
+  // meta header must precede the dataset
+  OFCHECK(writer.writeMetaHeader(UID_SecondaryCaptureImageStorage, "1.2.3") == EC_IllegalCall);
+  // tags must be ascending
+  OFCHECK(writer.writeString(DCM_PatientName, "Doe^Jane") == EC_TagOrderViolation);
+  OFCHECK(writer.writeString(DCM_Modality, "OT") == EC_TagOrderViolation);
+  // items only within sequences, elements only within items
+  OFCHECK(writer.beginItem() == EC_IllegalCall);
+  OFCHECK(writer.beginSequence(DCM_OtherPatientIDsSequence).good());
+  OFCHECK(writer.writeString(DCM_PatientID, "12345") == EC_IllegalCall);
+  OFCHECK(writer.beginItem().good());
+  OFCHECK(writer.writeString(DCM_PatientID, "12345").good());
+  OFCHECK(writer.finish() == EC_IllegalCall);
+  OFCHECK(writer.endSequence() == EC_IllegalCall);
+  OFCHECK(writer.endItem().good());
+  OFCHECK(writer.endSequence().good());
+  // encapsulated pixel data is not permitted for native transfer syntaxes
+  OFCHECK(writer.beginEncapsulatedPixelData() == EC_IllegalCall);
+  OFCHECK(writer.beginPixelData(4).good());
+  OFCHECK(writer.writePixelData(data, 2).good());
+  OFCHECK(writer.writePixelData(data, 4) == EC_ValueLengthMismatch);
+  OFCHECK(writer.endPixelData() == EC_ValueLengthMismatch);
+  // errors are sticky
+  OFCHECK(writer.finish() == EC_ValueLengthMismatch);
+}
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2020, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -24,6 +24,7 @@
 
 #include "dcmtk/ofstd/oftest.h"
 #include "dcmtk/dcmdata/dcvrds.h"
+#include "dcmtk/dcmdata/dcvris.h"
 #include "dcmtk/dcmdata/dcdeftag.h"
 #include "dcmtk/dcmdata/dcitem.h"
 
@@ -166,3 +167,79 @@ OFTEST(dcmdata_decimalString_putFloat64)
     OFCHECK(item.findAndGetOFStringArray(DCM_ContourData, testStr).good());
     OFCHECK(testStr == "0.1");
 }
+
+
+OFTEST(dcmdata_decimalString_putFloat64Array)
+{
+    OFString testStr;
+    OFVector<Float64> doubleVals;
+    DcmDecimalString decStr(DCM_ContourData, EVR_DS);
+
+    // shortest representation that results in the same value
+    const Float64 values[] = { 0, 0.1, -4.99, 500.005, 1e-5, 1234567890123456.0, 1.0/3, -2.0/3, 1e300, 0.1 + 0.2 };
+    const size_t numValues = sizeof(values) / sizeof(values[0]);
+    OFCHECK(decStr.putFloat64Array(values, numValues).good());
+    OFCHECK(decStr.getOFStringArray(testStr).good());
+    OFCHECK_EQUAL(testStr, "0\\0.1\\-4.99\\500.005\\0.00001\\1234567890123456\\0.33333333333333\\-0.6666666666667\\1e+300\\0.3");
+    OFCHECK(decStr.checkValue("1-n").good());
+    OFCHECK(decStr.getFloat64Vector(doubleVals).good());
+    OFCHECK_EQUAL(doubleVals.size(), numValues);
+    // values that fit into 16 characters are not changed
+    for (size_t i = 0; i < 6; ++i)
+        OFCHECK_EQUAL(doubleVals[i], values[i]);
+    OFCHECK_EQUAL(doubleVals[8], values[8]);
+
+    // values that cannot be represented as DS
+    const Float64 infinity = OFnumeric_limits<Float64>::infinity();
+    OFCHECK(decStr.putFloat64Array(&infinity, 1) == EC_IllegalParameter);
+    const Float64 nan = OFnumeric_limits<Float64>::quiet_NaN();
+    OFCHECK(decStr.putFloat64Array(&nan, 1) == EC_IllegalParameter);
+
+    // empty arrays result in an empty value
+    OFCHECK(decStr.putFloat64Array(NULL, 0).good());
+    OFCHECK_EQUAL(decStr.getLength(), 0);
+
+    // check DcmItem::putAndInsertFloat64Array() for Decimal Strings
+    DcmItem item;
+    OFCHECK(item.putAndInsertFloat64Array(DcmTag(DCM_ContourData, EVR_DS), values, 3).good());
+    OFCHECK(item.findAndGetOFStringArray(DCM_ContourData, testStr).good());
+    OFCHECK_EQUAL(testStr, "0\\0.1\\-4.99");
+}
+
+
+OFTEST(dcmdata_integerString_vector)
+{
+    OFString testStr;
+    OFVector<Sint32> sintVals;
+    DcmIntegerString intStr(DCM_ReferencedFrameNumber, EVR_IS);
+
+    const Sint32 values[] = { 0, 1, -1, 2147483647, -2147483647 - 1, 4711 };
+    const size_t numValues = sizeof(values) / sizeof(values[0]);
+    OFCHECK(intStr.putSint32Array(values, numValues).good());
+    OFCHECK(intStr.getOFStringArray(testStr).good());
+    OFCHECK_EQUAL(testStr, "0\\1\\-1\\2147483647\\-2147483648\\4711");
+    OFCHECK(intStr.checkValue("1-n").good());
+    OFCHECK(intStr.getSint32Vector(sintVals).good());
+    OFCHECK_EQUAL(sintVals.size(), numValues);
+    for (size_t i = 0; (i < numValues) && (i < sintVals.size()); ++i)
+        OFCHECK_EQUAL(sintVals[i], values[i]);
+
+    // spaces and signs are permitted, other characters are not
+    OFCHECK(intStr.putString(" 12 \\+7\\-0013 ").good());
+    OFCHECK(intStr.getSint32Vector(sintVals).good());
+    OFCHECK(sintVals.size() == 3 && sintVals[0] == 12 && sintVals[1] == 7 && sintVals[2] == -13);
+    OFCHECK(intStr.putString("1\\2\\ - \\4").good());
+    OFCHECK(intStr.getSint32Vector(sintVals).bad());
+    OFCHECK_EQUAL(sintVals.size(), 2);
+
+    // empty value
+    OFCHECK(intStr.putString("   ").good());
+    OFCHECK(intStr.getSint32Vector(sintVals).good());
+    OFCHECK_EQUAL(sintVals.size(), 0);
+
+    // check DcmItem::putAndInsertSint32Array() for Integer Strings
+    DcmItem item;
+    OFCHECK(item.putAndInsertSint32Array(DCM_ReferencedFrameNumber, values, 3).good());
+    OFCHECK(item.findAndGetOFStringArray(DCM_ReferencedFrameNumber, testStr).good());
+    OFCHECK_EQUAL(testStr, "0\\1\\-1");
+}
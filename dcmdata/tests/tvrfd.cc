@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2014, OFFIS e.V.
+ *  Copyright (C) 2014-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -23,7 +23,10 @@
 #include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
 
 #include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/ofstream.h"
 #include "dcmtk/dcmdata/dcvrfd.h"
+#include "dcmtk/dcmdata/dcvrfl.h"
+#include "dcmtk/dcmdata/dcjson.h"
 #include "dcmtk/dcmdata/dcdeftag.h"
 
 
@@ -61,3 +64,26 @@ OFTEST(dcmdata_floatingPointDouble)
     OFCHECK(floatDouble.getFloat64(value, 3).good());
     OFCHECK_EQUAL(value, 4.4);
 }
+
+
+OFTEST(dcmdata_floatingPointJsonInfNan)
+{
+    DcmJsonFormatCompact format;
+    OFOStringStream out;
+    /* a non-finite first value cannot be written without the JSON extension */
+    DcmFloatingPointDouble floatDouble(DCM_InversionTimes);
+    OFCHECK(floatDouble.putString("inf\\1").good());
+    OFCHECK(floatDouble.writeJson(out, format) == EC_CannotWriteJsonNumber);
+    OFCHECK(floatDouble.putString("nan").good());
+    OFCHECK(floatDouble.writeJson(out, format) == EC_CannotWriteJsonNumber);
+    DcmFloatingPointSingle floatSingle(DCM_RecommendedDisplayFrameRateInFloat);
+    OFCHECK(floatSingle.putString("-inf").good());
+    OFCHECK(floatSingle.writeJson(out, format) == EC_CannotWriteJsonNumber);
+    OFCHECK(floatSingle.putString("nan\\2").good());
+    OFCHECK(floatSingle.writeJson(out, format) == EC_CannotWriteJsonNumber);
+    /* finite values and the JSON extension are not affected */
+    OFCHECK(floatSingle.putString("1\\2").good());
+    OFCHECK(floatSingle.writeJson(out, format).good());
+    format.setJsonExtensionEnabled(OFTrue);
+    OFCHECK(floatDouble.writeJson(out, format).good());
+}
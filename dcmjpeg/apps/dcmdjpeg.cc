@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2001-2022, OFFIS e.V.
+ *  Copyright (C) 2001-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -27,6 +27,7 @@
 #include "dcmtk/dcmdata/dcuid.h"       /* for dcmtk version name */
 #include "dcmtk/dcmjpeg/djdecode.h"    /* for dcmjpeg decoders */
 #include "dcmtk/dcmjpeg/dipijpeg.h"    /* for dcmimage JPEG plugin */
+#include "dcmtk/dcmdata/dccodec.h"     /* for dcmDecompressionThreads */
 
 #ifdef WITH_ZLIB
 #include <zlib.h>      /* for zlibVersion() */
@@ -110,6 +111,11 @@ int main(int argc, char *argv[])
       cmd.addOption("--workaround-pred6",    "+w6",    "enable workaround for JPEG lossless images\nwith overflow in predictor 6");
       cmd.addOption("--workaround-incpl",    "+wi",    "enable workaround for incomplete JPEG data");
       cmd.addOption("--workaround-cornell",  "+wc",    "enable workaround for 16-bit JPEG lossless\nCornell images with Huffman table overflow");
+#ifdef WITH_THREADS
+    cmd.addSubGroup("multi-frame decompression:");
+      cmd.addOption("--threads",             "+mt", 1, "[n]umber of threads: integer (default: 1)",
+                                                       "decompress frames of multi-frame images\nin parallel using n threads");
+#endif
 
   cmd.addGroup("output options:");
     cmd.addSubGroup("output file format:");
@@ -187,6 +193,15 @@ int main(int argc, char *argv[])
       if (cmd.findOption("--workaround-incpl")) opt_forceSingleFragmentPerFrame = OFTrue;
       if (cmd.findOption("--workaround-cornell")) opt_cornellWorkaroundEnable = OFTrue;
 
+#ifdef WITH_THREADS
+      if (cmd.findOption("--threads"))
+      {
+        OFCmdUnsignedInt opt_decompressionThreads = 1;
+        app.checkValue(cmd.getValueAndCheckMinMax(opt_decompressionThreads, 1, 256));
+        dcmDecompressionThreads.set(OFstatic_cast(Uint32, opt_decompressionThreads));
+      }
+#endif
+
       cmd.beginOptionBlock();
       if (cmd.findOption("--read-file"))
       {
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2001-2020, OFFIS e.V.
+ *  Copyright (C) 2001-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -35,6 +35,7 @@ class DcmDataset;
 class DcmItem;
 class DJCodecParameter;
 class DJDecoder;
+class DJCodecFrameDecompressionTask;
 
 /** abstract codec class for JPEG decoders.
  *  This abstract class contains most of the application logic
@@ -211,6 +212,9 @@ public:
 
 private:
 
+  /// helper class for parallel decompression, needs access to static helper methods
+  friend class DJCodecFrameDecompressionTask;
+
   /** creates an instance of the compression library to be used for decoding.
    *  @param toRepParam representation parameter passed to decode()
    *  @param cp codec parameter passed to decode()
@@ -224,6 +228,45 @@ private:
     Uint8 bitsPerSample,
     OFBool isYBR) const = 0;
 
+  /** decompresses all frames except the first one in parallel, which is only
+   *  possible if the fragments of all frames can be determined in advance.
+   *  Called by decode() after the first frame has been decompressed.
+   *  Does nothing unless enabled by the global flag dcmDecompressionThreads.
+   *  @param fromRepParam representation parameter passed to decode()
+   *  @param pixSeq compressed pixel sequence
+   *  @param cp codec parameter passed to decode()
+   *  @param precision bits per sample for the image data
+   *  @param isYBR flag indicating whether DICOM photometric interpretation is YCbCr
+   *  @param isSigned flag indicating whether the pixel data is signed
+   *  @param createPlanarConfiguration flag indicating whether the frames
+   *    must be converted to color-by-plane planar configuration
+   *  @param imageFrames number of frames
+   *  @param nextItem index of the fragment following the first frame
+   *  @param frameSize size of an uncompressed frame in bytes
+   *  @param imageColumns columns
+   *  @param imageRows rows
+   *  @param imageData8 pointer to the uncompressed pixel data of all frames
+   *  @param currentFrame number of the next frame to be decompressed,
+   *    set to imageFrames if all remaining frames have been decompressed
+   *  @return EC_Normal if successful or if the frames must be decompressed
+   *    sequentially, an error code otherwise
+   */
+  OFCondition decodeRemainingFrames(
+    const DcmRepresentationParameter *fromRepParam,
+    DcmPixelSequence *pixSeq,
+    const DJCodecParameter *cp,
+    Uint8 precision,
+    OFBool isYBR,
+    OFBool isSigned,
+    OFBool createPlanarConfiguration,
+    Uint32 imageFrames,
+    Uint32 nextItem,
+    Uint32 frameSize,
+    Uint16 imageColumns,
+    Uint16 imageRows,
+    Uint8 *imageData8,
+    Sint32& currentFrame) const;
+
   // static private helper methods
 
   /** scans the given block of JPEG data for a Start of Frame marker
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2001-2020, OFFIS e.V.
+ *  Copyright (C) 2001-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -25,6 +25,7 @@
 #include "dcmtk/config/osconfig.h"
 #include "dcmtk/ofstd/oftypes.h"
 #include "dcmtk/dcmdata/dccodec.h"    /* for class DcmCodec */
+#include "dcmtk/dcmdata/dcofsetl.h"   /* for DcmOffsetList */
 #include "dcmtk/dcmjpeg/djutils.h"    /* for enums */
 #include "dcmtk/ofstd/oflist.h"
 #include "dcmtk/ofstd/ofstring.h"     /* for class OFString */
@@ -313,6 +314,45 @@ private:
     const DcmCodecParameter *cp,
     DcmStack & objStack) const;
 
+  /** compresses all frames of an image and stores them in the given pixel
+   *  sequence. If requested by the codec parameters, the frames are
+   *  compressed in parallel, using one encoder instance per thread.
+   *  @param jpeg encoder instance used by the calling thread
+   *  @param toRepParam representation parameter passed to encode()
+   *  @param cp codec parameter passed to encode()
+   *  @param encoderBits bits per sample passed to createEncoderInstance()
+   *    when creating additional encoder instances
+   *  @param dimage image from which the frames are rendered, NULL if the
+   *    frames are taken from the given uncompressed pixel data
+   *  @param pixelData uncompressed pixel data, only used if dimage is NULL
+   *  @param frameSize size of one frame of the uncompressed pixel data in bytes
+   *  @param frameCount number of frames
+   *  @param columns columns of each frame
+   *  @param rows rows of each frame
+   *  @param interpr color model of the frames passed to the encoder
+   *  @param samplesPerPixel samples per pixel of the frames passed to the encoder
+   *  @param pixelSequence pixel sequence in which the compressed frames are stored
+   *  @param offsetList offset list updated for each compressed frame
+   *  @param compressedSize total size of all compressed frames returned in this parameter
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  OFCondition encodeFrames(
+    DJEncoder *jpeg,
+    const DcmRepresentationParameter * toRepParam,
+    const DJCodecParameter *cp,
+    Uint8 encoderBits,
+    DicomImage *dimage,
+    const Uint8 *pixelData,
+    size_t frameSize,
+    size_t frameCount,
+    Uint16 columns,
+    Uint16 rows,
+    EP_Interpretation interpr,
+    Uint16 samplesPerPixel,
+    DcmPixelSequence *pixelSequence,
+    DcmOffsetList& offsetList,
+    size_t& compressedSize) const;
+
   /** create Lossy Image Compression and Lossy Image Compression Ratio.
    *  @param dataset dataset to be modified
    *  @param ratio image compression ratio > 1. This is not the "quality factor"
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2018, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -68,6 +68,8 @@ public:
    *  @param pAcrNemaCompatibility accept old ACR-NEMA images without photometric interpretation
    *    (only "pseudo" lossless encoder)
    *  @param pTrueLosslessMode Enables true lossless compression (replaces old "pseudo lossless" encoder)
+   *  @param pNumberOfThreads number of threads used to compress the frames of a multi-frame
+   *    image in parallel, 1 for sequential compression
    */
   DJCodecParameter(
     E_CompressionColorSpaceConversion pCompressionCSConversion,
@@ -97,7 +99,8 @@ public:
     OFBool pUseModalityRescale = OFFalse,
     OFBool pAcceptWrongPaletteTags = OFFalse,
     OFBool pAcrNemaCompatibility = OFFalse,
-    OFBool pTrueLosslessMode = OFTrue);
+    OFBool pTrueLosslessMode = OFTrue,
+    Uint32 pNumberOfThreads = 1);
 
   /// copy constructor
   DJCodecParameter(const DJCodecParameter& arg);
@@ -323,6 +326,14 @@ public:
     return forceSingleFragmentPerFrame;
   }
 
+  /** returns the number of threads used for compression
+   *  @return number of threads used for compression
+   */
+  Uint32 getNumberOfThreads() const
+  {
+    return numberOfThreads;
+  }
+
 private:
 
   /// private undefined copy assignment operator
@@ -427,6 +438,9 @@ private:
    */
   OFBool forceSingleFragmentPerFrame;
 
+  /// number of threads used to compress the frames of a multi-frame image
+  Uint32 numberOfThreads;
+
 };
 
 
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2001-2024, OFFIS e.V.
+ *  Copyright (C) 2001-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -36,6 +36,133 @@
 #include "dcmtk/dcmjpeg/djdecabs.h"  /* for class DJDecoder */
 
 
+/** helper class that decompresses the frames of a JPEG compressed multi-frame
+ *  image in parallel, see DcmCodec::decompressFrames(). Each thread uses its
+ *  own decoder instance.
+ */
+class DJCodecFrameDecompressionTask: public DcmEncapsulatedFrameDecompressionTask
+{
+public:
+
+  /** constructor
+   *  @param fragmentData pointers to the content of all fragments
+   *  @param fragmentLength lengths of all fragments
+   *  @param startFragments index of the first fragment of each frame, followed by the number of fragments
+   *  @param decoders decoder instances, one per thread
+   *  @param imageData8 pointer to the uncompressed pixel data of all frames
+   *  @param frameSize size of an uncompressed frame in bytes
+   *  @param precision precision of the JPEG data
+   *  @param imageColumns number of columns
+   *  @param imageRows number of rows
+   *  @param isSigned true if pixel data is signed
+   *  @param createPlanarConfiguration true if frames must be converted to color-by-plane
+   *  @param forceSingleFragmentPerFrame true if incomplete frames should be ignored
+   */
+  DJCodecFrameDecompressionTask(
+    const OFVector<Uint8 *>& fragmentData,
+    const OFVector<Uint32>& fragmentLength,
+    const OFVector<Uint32>& startFragments,
+    const OFVector<DJDecoder *>& decoders,
+    Uint8 *imageData8,
+    Uint32 frameSize,
+    Uint8 precision,
+    Uint16 imageColumns,
+    Uint16 imageRows,
+    OFBool isSigned,
+    OFBool createPlanarConfiguration,
+    OFBool forceSingleFragmentPerFrame)
+  : DcmEncapsulatedFrameDecompressionTask(fragmentData, fragmentLength, startFragments,
+      imageData8, frameSize, OFstatic_cast(Uint32, decoders.size()))
+  , decoders_(decoders)
+  , precision_(precision)
+  , imageColumns_(imageColumns)
+  , imageRows_(imageRows)
+  , isSigned_(isSigned)
+  , createPlanarConfiguration_(createPlanarConfiguration)
+  , forceSingleFragmentPerFrame_(forceSingleFragmentPerFrame)
+  {
+  }
+
+protected:
+
+  /** decompresses a single frame into the given buffer
+   *  @param frameNo number of the frame, starting with 0
+   *  @param threadNo number of the calling thread, starting with 0
+   *  @param currentItem index of the first fragment of the frame. Upon return,
+   *    contains the index of the fragment following the last one used.
+   *  @param endItem index of the fragment following the last one that may be used
+   *  @param imageData8 pointer to the uncompressed pixel data of this frame
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  virtual OFCondition decodeFrame(Uint32 /* frameNo */, Uint32 threadNo, Uint32& currentItem, Uint32 endItem, Uint8 *imageData8)
+  {
+    DJDecoder *jpeg = decoders_[threadNo];
+    OFCondition result = jpeg->init();
+    if (result.good())
+    {
+      result = EJ_Suspension;
+      while (EJ_Suspension == result)
+      {
+        // the bitstream of this frame must not extend into the next frame
+        Uint8 *jpegData = NULL;
+        Uint32 length = 0;
+        result = getFragment(currentItem, endItem, jpegData, length);
+        if (result.good())
+        {
+          if (jpegData == NULL) result = EC_CorruptedData;
+          else
+          {
+            result = jpeg->decode(jpegData, length, imageData8, getFrameSize(), isSigned_);
+
+            // frame is incomplete. Nevertheless skip to next frame
+            // if "one fragment per frame" is enforced.
+            if ((EJ_Suspension == result) && forceSingleFragmentPerFrame_) result = EC_Normal;
+          }
+        }
+      }
+    }
+
+    // convert planar configuration if necessary
+    if (result.good() && createPlanarConfiguration_)
+    {
+      if (precision_ > 8)
+        result = DJCodecDecoder::createPlanarConfigurationWord(OFreinterpret_cast(Uint16*, imageData8), imageColumns_, imageRows_);
+        else result = DJCodecDecoder::createPlanarConfigurationByte(imageData8, imageColumns_, imageRows_);
+    }
+    return result;
+  }
+
+private:
+
+  /// private undefined copy constructor
+  DJCodecFrameDecompressionTask(const DJCodecFrameDecompressionTask&);
+
+  /// private undefined copy assignment operator
+  DJCodecFrameDecompressionTask& operator=(const DJCodecFrameDecompressionTask&);
+
+  /// decoder instances, one per thread
+  const OFVector<DJDecoder *>& decoders_;
+
+  /// precision of the JPEG data
+  Uint8 precision_;
+
+  /// number of columns
+  Uint16 imageColumns_;
+
+  /// number of rows
+  Uint16 imageRows_;
+
+  /// true if pixel data is signed
+  OFBool isSigned_;
+
+  /// true if frames must be converted to color-by-plane
+  OFBool createPlanarConfiguration_;
+
+  /// true if incomplete frames should be ignored
+  OFBool forceSingleFragmentPerFrame_;
+};
+
+
 DJCodecDecoder::DJCodecDecoder()
 : DcmCodec()
 {
@@ -256,6 +383,13 @@ OFCondition DJCodecDecoder::decode(
                         }
                         currentFrame++;
                         imageData8 += frameSize;
+
+                        // the first frame has determined the color model and planar configuration,
+                        // now decompress the remaining frames in parallel if possible
+                        if ((currentFrame == 1) && (imageFrames > 1) && result.good())
+                          result = decodeRemainingFrames(fromRepParam, pixSeq, djcp, precision, isYBR, isSigned,
+                            (imageSamplesPerPixel == 3) && createPlanarConfiguration, OFstatic_cast(Uint32, imageFrames),
+                            OFstatic_cast(Uint32, currentItem), frameSize, imageColumns, imageRows, imageData8 - frameSize, currentFrame);
                       }
                     }
                   }
@@ -376,6 +510,72 @@ OFCondition DJCodecDecoder::decode(
 }
 
 
+OFCondition DJCodecDecoder::decodeRemainingFrames(
+    const DcmRepresentationParameter *fromRepParam,
+    DcmPixelSequence *pixSeq,
+    const DJCodecParameter *cp,
+    Uint8 precision,
+    OFBool isYBR,
+    OFBool isSigned,
+    OFBool createPlanarConfiguration,
+    Uint32 imageFrames,
+    Uint32 nextItem,
+    Uint32 frameSize,
+    Uint16 imageColumns,
+    Uint16 imageRows,
+    Uint8 *imageData8,
+    Sint32& currentFrame) const
+{
+  Uint32 numberOfThreads = getDecompressionThreadCount(imageFrames - 1);
+  if (numberOfThreads < 2) return EC_Normal;
+
+  // determine the first fragment of each frame
+  OFVector<Uint32> startFragments;
+  OFBool forceSingleFragmentPerFrame = cp->getForceSingleFragmentPerFrame();
+  if (forceSingleFragmentPerFrame)
+  {
+    // one fragment per frame is only possible if there are enough fragments
+    if (imageFrames + 1 <= pixSeq->card())
+    {
+      for (Uint32 i = 1; i <= imageFrames + 1; ++i) startFragments.push_back(i);
+    }
+  }
+  else if (determineFrameFragments(imageFrames, pixSeq, startFragments).bad()) startFragments.clear();
+
+  // the second frame must start where the first frame has ended
+  if ((startFragments.size() != imageFrames + 1) || (startFragments[1] != nextItem))
+  {
+    DCMJPEG_DEBUG("cannot determine fragments of all frames in advance, decompressing frames sequentially");
+    return EC_Normal;
+  }
+
+  OFVector<Uint8 *> fragmentData;
+  OFVector<Uint32> fragmentLength;
+  OFCondition result = getFragmentData(pixSeq, fragmentData, fragmentLength);
+
+  // create one decoder instance per thread
+  OFVector<DJDecoder *> decoders;
+  for (Uint32 i = 0; (i < numberOfThreads) && result.good(); ++i)
+  {
+    DJDecoder *jpeg = createDecoderInstance(fromRepParam, cp, precision, isYBR);
+    if (jpeg == NULL) result = EC_MemoryExhausted; else decoders.push_back(jpeg);
+  }
+
+  if (result.good())
+  {
+    DCMJPEG_DEBUG("decompressing frames 2 to " << imageFrames << " using " << numberOfThreads << " threads");
+    DJCodecFrameDecompressionTask task(fragmentData, fragmentLength, startFragments, decoders,
+      imageData8, frameSize, precision, imageColumns, imageRows, isSigned,
+      createPlanarConfiguration, forceSingleFragmentPerFrame);
+    result = decompressFrames(task, 1, imageFrames - 1, numberOfThreads);
+    if (result.good()) currentFrame = OFstatic_cast(Sint32, imageFrames);
+  }
+
+  for (size_t i = 0; i < decoders.size(); ++i) delete decoders[i];
+  return result;
+}
+
+
 // the following macros make the source code more readable and easier to maintain
 
 #define GET_AND_CHECK_UINT16_VALUE(tag, variable)                                                                           \
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2001-2022, OFFIS e.V.
+ *  Copyright (C) 2001-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -49,6 +49,205 @@
 
 #include <cmath>
 
+
+/** helper class that compresses the frames of a multi-frame image with
+ *  JPEG, possibly in parallel, see DJCodecEncoder::encodeFrames()
+ */
+class DJCodecFrameCompressionTask: public DcmFrameCompressionTask
+{
+public:
+  /** constructor
+   *  @param encoders one encoder instance per thread
+   *  @param dimage image from which the frames are rendered, NULL if the
+   *    frames are taken from the given uncompressed pixel data
+   *  @param pixelData uncompressed pixel data, only used if dimage is NULL
+   *  @param frameSize size of one frame of the uncompressed pixel data in bytes
+   *  @param frameCount number of frames
+   *  @param columns columns of each frame
+   *  @param rows rows of each frame
+   *  @param interpr color model of the frames passed to the encoder
+   *  @param samplesPerPixel samples per pixel of the frames passed to the encoder
+   *  @param pixelSequence pixel sequence in which the compressed frames are stored
+   *  @param offsetList offset list updated for each compressed frame
+   *  @param fragmentSize maximum fragment size (in kbytes), 0 for unlimited
+   */
+  DJCodecFrameCompressionTask(
+    const OFVector<DJEncoder *>& encoders,
+    DicomImage *dimage,
+    const Uint8 *pixelData,
+    size_t frameSize,
+    size_t frameCount,
+    Uint16 columns,
+    Uint16 rows,
+    EP_Interpretation interpr,
+    Uint16 samplesPerPixel,
+    DcmPixelSequence *pixelSequence,
+    DcmOffsetList& offsetList,
+    Uint32 fragmentSize)
+  : DcmFrameCompressionTask()
+  , encoders_(encoders)
+  , dimage_(dimage)
+  , pixelData_(pixelData)
+  , frameSize_(frameSize)
+  , columns_(columns)
+  , rows_(rows)
+  , interpr_(interpr)
+  , samplesPerPixel_(samplesPerPixel)
+  , pixelSequence_(pixelSequence)
+  , offsetList_(offsetList)
+  , fragmentSize_(fragmentSize)
+  , frames_(frameCount, OFstatic_cast(const void *, NULL))
+  , renderedFrames_(frameCount, OFstatic_cast(Uint8 *, NULL))
+  , jpegData_(frameCount, OFstatic_cast(Uint8 *, NULL))
+  , jpegLen_(frameCount, 0)
+  , compressedSize_(0)
+  {
+  }
+
+  /// destructor, frees all frames that have not been stored
+  virtual ~DJCodecFrameCompressionTask()
+  {
+    for (size_t i = 0; i < jpegData_.size(); ++i)
+    {
+      delete[] renderedFrames_[i];
+      delete[] jpegData_[i];
+    }
+  }
+
+  /** determines the uncompressed data of a single frame. If the frames are
+   *  rendered and compressed in parallel, each frame is rendered into a
+   *  buffer of its own since DicomImage reuses its internal buffer.
+   *  @param frameNo number of the frame
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  virtual OFCondition prepareFrame(Uint32 frameNo)
+  {
+    if (dimage_ == NULL)
+      frames_[frameNo] = pixelData_ + frameSize_ * frameNo;
+    else
+    {
+      const int bitsPerSample = encoders_[0]->bitsPerSample();
+      if (encoders_.size() > 1)
+      {
+        const unsigned long size = dimage_->getOutputDataSize(bitsPerSample);
+        if (size == 0) return EC_MemoryExhausted;
+        renderedFrames_[frameNo] = new Uint8[size];
+        if (!dimage_->getOutputData(renderedFrames_[frameNo], size, bitsPerSample, frameNo, 0))
+          return EC_MemoryExhausted;
+        frames_[frameNo] = renderedFrames_[frameNo];
+      }
+      else frames_[frameNo] = dimage_->getOutputData(bitsPerSample, frameNo, 0);
+      if (frames_[frameNo] == NULL) return EC_MemoryExhausted;
+    }
+    return EC_Normal;
+  }
+
+  /** compresses a single frame using the encoder instance of the calling thread
+   *  @param frameNo number of the frame
+   *  @param threadNo number of the calling thread
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  virtual OFCondition compressFrame(Uint32 frameNo, Uint32 threadNo)
+  {
+    OFCondition result = EC_Normal;
+    DJEncoder *jpeg = encoders_[threadNo];
+    void *frame = OFconst_cast(void *, frames_[frameNo]);
+    if (jpeg->bytesPerSample() == 1)
+    {
+      result = jpeg->encode(columns_, rows_, interpr_, samplesPerPixel_, OFreinterpret_cast(Uint8 *, frame), jpegData_[frameNo], jpegLen_[frameNo]);
+    } else {
+      result = jpeg->encode(columns_, rows_, interpr_, samplesPerPixel_, OFreinterpret_cast(Uint16 *, frame), jpegData_[frameNo], jpegLen_[frameNo]);
+    }
+    if (result.good() && (jpegLen_[frameNo] == 0)) result = EC_CannotChangeRepresentation;
+
+    // the rendered frame is not needed anymore
+    delete[] renderedFrames_[frameNo];
+    renderedFrames_[frameNo] = NULL;
+    frames_[frameNo] = NULL;
+    return result;
+  }
+
+  /** stores a compressed frame in the pixel sequence
+   *  @param frameNo number of the frame
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  virtual OFCondition storeFrame(Uint32 frameNo)
+  {
+    OFCondition result = pixelSequence_->storeCompressedFrame(offsetList_, jpegData_[frameNo], jpegLen_[frameNo], fragmentSize_);
+    if (result.good()) compressedSize_ += jpegLen_[frameNo];
+
+    // delete block of JPEG data
+    delete[] jpegData_[frameNo];
+    jpegData_[frameNo] = NULL;
+    return result;
+  }
+
+  /** returns the total size of all compressed frames stored so far
+   *  @return compressed size in bytes
+   */
+  size_t getCompressedSize() const
+  {
+    return compressedSize_;
+  }
+
+private:
+
+  /// private undefined copy constructor
+  DJCodecFrameCompressionTask(const DJCodecFrameCompressionTask&);
+
+  /// private undefined copy assignment operator
+  DJCodecFrameCompressionTask& operator=(const DJCodecFrameCompressionTask&);
+
+  /// one encoder instance per thread
+  const OFVector<DJEncoder *>& encoders_;
+
+  /// image from which the frames are rendered, may be NULL
+  DicomImage *dimage_;
+
+  /// uncompressed pixel data, used if dimage_ is NULL
+  const Uint8 *pixelData_;
+
+  /// size of one frame of the uncompressed pixel data in bytes
+  size_t frameSize_;
+
+  /// columns of each frame
+  Uint16 columns_;
+
+  /// rows of each frame
+  Uint16 rows_;
+
+  /// color model of the frames passed to the encoder
+  EP_Interpretation interpr_;
+
+  /// samples per pixel of the frames passed to the encoder
+  Uint16 samplesPerPixel_;
+
+  /// pixel sequence in which the compressed frames are stored
+  DcmPixelSequence *pixelSequence_;
+
+  /// offset list updated for each compressed frame
+  DcmOffsetList& offsetList_;
+
+  /// maximum fragment size (in kbytes), 0 for unlimited
+  Uint32 fragmentSize_;
+
+  /// uncompressed data of the frames that have been prepared but not yet compressed
+  OFVector<const void *> frames_;
+
+  /// frames rendered into buffers of their own, owned by this object
+  OFVector<Uint8 *> renderedFrames_;
+
+  /// compressed frames that have not been stored yet
+  OFVector<Uint8 *> jpegData_;
+
+  /// size of the compressed frames that have not been stored yet
+  OFVector<Uint32> jpegLen_;
+
+  /// total size of all compressed frames stored so far
+  size_t compressedSize_;
+};
+
+
 DJCodecEncoder::DJCodecEncoder()
 : DcmCodec()
 {
@@ -372,41 +571,13 @@ OFCondition DJCodecEncoder::encodeColorImage(
       // render and compress each frame
       bitsPerSample = jpeg->bitsPerSample();
       size_t frameCount = dimage->getFrameCount();
-      unsigned short bytesPerSample = jpeg->bytesPerSample();
       unsigned short columns = OFstatic_cast(unsigned short, dimage->getWidth());
       unsigned short rows = OFstatic_cast(unsigned short, dimage->getHeight());
-      Uint8 *jpegData = NULL;
-      Uint32 jpegLen  = 0;
-      const void *frame = NULL;
 
       // compute original image size in bytes, ignoring any padding bits.
       uncompressedSize = OFstatic_cast(double, columns * rows * dimage->getDepth() * frameCount * samplesPerPixel) / 8.0;
-      for (unsigned long i=0; (i<frameCount) && (result.good()); i++)
-      {
-        frame = dimage->getOutputData(bitsPerSample, i, 0);
-        if (frame == NULL) result = EC_MemoryExhausted;
-        else
-        {
-          // compress frame
-          jpegData = NULL;
-          if (bytesPerSample == 1)
-          {
-            result = jpeg->encode(columns, rows, interpr, samplesPerPixel, OFreinterpret_cast(Uint8*, OFconst_cast(void*, frame)), jpegData, jpegLen);
-          } else {
-            result = jpeg->encode(columns, rows, interpr, samplesPerPixel, OFreinterpret_cast(Uint16*, OFconst_cast(void*, frame)), jpegData, jpegLen);
-          }
-
-          // store frame
-          if (result.good())
-          {
-            result = pixelSequence->storeCompressedFrame(offsetList, jpegData, jpegLen, cp->getFragmentSize());
-          }
-
-          // delete block of JPEG data
-          delete[] jpegData;
-          compressedSize += jpegLen;
-        }
-      }
+      result = encodeFrames(jpeg, toRepParam, cp, OFstatic_cast(Uint8, compressedBits), dimage, NULL, 0, frameCount,
+        columns, rows, interpr, samplesPerPixel, pixelSequence, offsetList, compressedSize);
       delete jpeg;
     } else result = EC_MemoryExhausted;
   }
@@ -501,8 +672,6 @@ OFCondition DJCodecEncoder::encodeTrueLossless(
     Uint16 rows = 0;
     Sint32 numberOfFrames = 1;
     EP_Interpretation interpr = EPI_Unknown;
-    Uint8 *jpegData = NULL;
-    Uint32 jpegLen  = 0;
     OFBool byteSwapped = OFFalse;      // true if we have byte-swapped the original pixel data
     OFBool planConfSwitched = OFFalse; // true if planar configuration was toggled
     DcmOffsetList offsetList;
@@ -641,30 +810,12 @@ OFCondition DJCodecEncoder::encodeTrueLossless(
     if (jpeg)
     {
       // main loop for compression: compress each frame
-      for (unsigned int i = 0; i < frameCount && result.good(); i++)
+      if (result.good())
       {
-        if (bitsAllocated == 8)
-        {
-          jpeg->encode(columns, rows, interpr, samplesPerPixel, OFconst_cast(Uint8*, framePointer), jpegData, jpegLen);
-        }
-        else if (bitsAllocated == 16)
-        {
-          jpeg->encode(columns, rows, interpr, samplesPerPixel, OFreinterpret_cast(Uint16*, OFconst_cast(Uint8*, framePointer)), jpegData, jpegLen);
-        }
-        // update variables
-        compressedSize += jpegLen;
-        framePointer += frameSize;
-        if (jpegLen == 0)
-        {
+        result = encodeFrames(jpeg, toRepParam, djcp, OFstatic_cast(Uint8, bitsAllocated), NULL, framePointer, frameSize,
+          frameCount, columns, rows, interpr, samplesPerPixel, pixelSequence, offsetList, compressedSize);
+        if (result.bad())
           DCMJPEG_ERROR("True lossless encoder: Error encoding frame");
-          result = EC_CannotChangeRepresentation;
-        }
-        else
-        {
-          result = pixelSequence->storeCompressedFrame(offsetList, jpegData, jpegLen, djcp->getFragmentSize());
-        }
-        // free memory
-        delete[] jpegData;
       }
     }
     else
@@ -743,6 +894,51 @@ OFCondition DJCodecEncoder::encodeTrueLossless(
 }
 
 
+OFCondition DJCodecEncoder::encodeFrames(
+  DJEncoder *jpeg,
+  const DcmRepresentationParameter * toRepParam,
+  const DJCodecParameter *cp,
+  Uint8 encoderBits,
+  DicomImage *dimage,
+  const Uint8 *pixelData,
+  size_t frameSize,
+  size_t frameCount,
+  Uint16 columns,
+  Uint16 rows,
+  EP_Interpretation interpr,
+  Uint16 samplesPerPixel,
+  DcmPixelSequence *pixelSequence,
+  DcmOffsetList& offsetList,
+  size_t& compressedSize) const
+{
+  // create one additional encoder instance for each additional thread
+  const Uint32 numberOfFrames = OFstatic_cast(Uint32, frameCount);
+  const Uint32 numberOfThreads = getCompressionThreadCount(cp->getNumberOfThreads(), numberOfFrames);
+  OFVector<DJEncoder *> encoders;
+  encoders.push_back(jpeg);
+  while (encoders.size() < numberOfThreads)
+  {
+    DJEncoder *encoder = createEncoderInstance(toRepParam, cp, encoderBits);
+    if (encoder == NULL) break;
+    encoders.push_back(encoder);
+  }
+  if (encoders.size() > 1)
+    DCMJPEG_DEBUG("JPEG encoder: compressing " << numberOfFrames << " frames using " << encoders.size() << " threads");
+
+  OFCondition result;
+  {
+    DJCodecFrameCompressionTask task(encoders, dimage, pixelData, frameSize, frameCount,
+      columns, rows, interpr, samplesPerPixel, pixelSequence, offsetList, cp->getFragmentSize());
+    result = compressFrames(task, numberOfFrames, OFstatic_cast(Uint32, encoders.size()));
+    compressedSize += task.getCompressedSize();
+  }
+
+  // delete the additional encoder instances
+  for (size_t i = 1; i < encoders.size(); ++i) delete encoders[i];
+  return result;
+}
+
+
 void DJCodecEncoder::appendCompressionRatio(
   OFString& arg,
   double ratio)
@@ -1193,43 +1389,15 @@ OFCondition DJCodecEncoder::encodeMonochromeImage(
 
       // render and compress each frame
       size_t frameCount = dimage.getFrameCount();
-      unsigned short bytesPerSample = jpeg->bytesPerSample();
       unsigned short columns = OFstatic_cast(unsigned short, dimage.getWidth());
       unsigned short rows = OFstatic_cast(unsigned short, dimage.getHeight());
-      Uint8 *jpegData = NULL;
-      Uint32 jpegLen  = 0;
-      const void *frame = NULL;
 
       // compute original image size in bytes, ignoring any padding bits.
       Uint16 samplesPerPixel = 0;
       if ((dataset->findAndGetUint16(DCM_SamplesPerPixel, samplesPerPixel)).bad()) samplesPerPixel = 1;
       uncompressedSize = OFstatic_cast(double, columns * rows * pixelDepth * frameCount * samplesPerPixel) / 8.0;
-      for (size_t i=0; (i<frameCount) && (result.good()); i++)
-      {
-        frame = dimage.getOutputData(bitsPerSample, OFstatic_cast(unsigned long, i), 0);
-        if (frame == NULL) result = EC_MemoryExhausted;
-        else
-        {
-          // compress frame
-          jpegData = NULL;
-          if (bytesPerSample == 1)
-          {
-            result = jpeg->encode(columns, rows, EPI_Monochrome2, 1, OFreinterpret_cast(Uint8*, OFconst_cast(void*, frame)), jpegData, jpegLen);
-          } else {
-            result = jpeg->encode(columns, rows, EPI_Monochrome2, 1, OFreinterpret_cast(Uint16*, OFconst_cast(void*, frame)), jpegData, jpegLen);
-          }
-
-          // store frame
-          if (result.good())
-          {
-            result = pixelSequence->storeCompressedFrame(offsetList, jpegData, jpegLen, cp->getFragmentSize());
-          }
-
-          // delete block of JPEG data
-          delete[] jpegData;
-          compressedSize += jpegLen;
-        }
-      }
+      result = encodeFrames(jpeg, toRepParam, cp, OFstatic_cast(Uint8, compressedBits), &dimage, NULL, 0, frameCount,
+        columns, rows, EPI_Monochrome2, 1, pixelSequence, offsetList, compressedSize);
       delete jpeg;
     } else result = EC_MemoryExhausted;
   }
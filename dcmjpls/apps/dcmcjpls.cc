@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2007-2022, OFFIS e.V.
+ *  Copyright (C) 2007-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -83,6 +83,7 @@ int main(int argc, char *argv[])
   OFBool           opt_createOffsetTable = OFTrue;
   JLS_UIDCreation  opt_uidcreation = EJLSUC_default;
   OFBool           opt_secondarycapture = OFFalse;
+  OFCmdUnsignedInt opt_compressionThreads = 1;
 
   // output options
   E_GrpLenEncoding opt_oglenc = EGL_recalcGL;
@@ -170,6 +171,11 @@ LICENSE_FILE_DECLARE_COMMAND_LINE_OPTIONS
       cmd.addOption("--uid-default",            "+ud",    "assign new UID if lossy compression (default)");
       cmd.addOption("--uid-always",             "+ua",    "always assign new UID");
       cmd.addOption("--uid-never",             "+un",    "never assign new UID");
+#ifdef WITH_THREADS
+    cmd.addSubGroup("multi-frame compression:");
+      cmd.addOption("--threads",                "+mt", 1, "[n]umber of threads: integer (default: 1)",
+                                                          "compress frames of multi-frame images\nin parallel using n threads");
+#endif
 
   cmd.addGroup("output options:");
     cmd.addSubGroup("post-1993 value representations:");
@@ -367,6 +373,14 @@ LICENSE_FILE_EVALUATE_COMMAND_LINE_OPTIONS
       if (cmd.findOption("--uid-never")) opt_uidcreation = EJLSUC_never;
       cmd.endOptionBlock();
 
+#ifdef WITH_THREADS
+      // multi-frame compression options
+      if (cmd.findOption("--threads"))
+      {
+        app.checkValue(cmd.getValueAndCheckMinMax(opt_compressionThreads, 1, 256));
+      }
+#endif
+
       // output options
       // post-1993 value representations
       cmd.beginOptionBlock();
@@ -408,7 +422,8 @@ LICENSE_FILE_EVALUATE_COMMAND_LINE_OPTIONS
       OFstatic_cast(Uint16, opt_t1), OFstatic_cast(Uint16, opt_t2), OFstatic_cast(Uint16, opt_t3),
       OFstatic_cast(Uint16, opt_reset),
       opt_prefer_cooked, opt_fragmentSize, opt_createOffsetTable,
-      opt_uidcreation, opt_secondarycapture, opt_interleaveMode, opt_useFFpadding);
+      opt_uidcreation, opt_secondarycapture, opt_interleaveMode, opt_useFFpadding,
+      OFstatic_cast(Uint32, opt_compressionThreads));
 
     /* make sure data dictionary is loaded */
     if (!dcmDataDict.isDictionaryLoaded())
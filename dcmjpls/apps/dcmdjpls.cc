@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2007-2022, OFFIS e.V.
+ *  Copyright (C) 2007-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -28,6 +28,7 @@
 #include "dcmtk/dcmimage/diregist.h"  /* include to support color images */
 #include "dcmtk/dcmjpls/djlsutil.h"   /* for dcmjpgls typedefs */
 #include "dcmtk/dcmjpls/djdecode.h"   /* for JPEG-LS decoder */
+#include "dcmtk/dcmdata/dccodec.h"    /* for dcmDecompressionThreads */
 
 #ifdef WITH_ZLIB
 #include <zlib.h>      /* for zlibVersion() */
@@ -113,6 +114,11 @@ LICENSE_FILE_DECLARE_COMMAND_LINE_OPTIONS
       cmd.addOption("--workaround-incpl",       "+wi",    "enable workaround for incomplete JPEG-LS data");
     cmd.addSubGroup("other processing options:");
       cmd.addOption("--ignore-offsettable",     "+io",    "ignore offset table when decompressing");
+#ifdef WITH_THREADS
+    cmd.addSubGroup("multi-frame decompression:");
+      cmd.addOption("--threads",                "+mt", 1, "[n]umber of threads: integer (default: 1)",
+                                                          "decompress frames of multi-frame images\nin parallel using n threads");
+#endif
 
   cmd.addGroup("output options:");
     cmd.addSubGroup("output file format:");
@@ -185,6 +191,15 @@ LICENSE_FILE_EVALUATE_COMMAND_LINE_OPTIONS
       if (cmd.findOption("--workaround-incpl")) opt_forceSingleFragmentPerFrame = OFTrue;
       if (cmd.findOption("--ignore-offsettable")) opt_ignoreOffsetTable = OFTrue;
 
+#ifdef WITH_THREADS
+      if (cmd.findOption("--threads"))
+      {
+        OFCmdUnsignedInt opt_decompressionThreads = 1;
+        app.checkValue(cmd.getValueAndCheckMinMax(opt_decompressionThreads, 1, 256));
+        dcmDecompressionThreads.set(OFstatic_cast(Uint32, opt_decompressionThreads));
+      }
+#endif
+
       cmd.beginOptionBlock();
       if (cmd.findOption("--read-file"))
       {
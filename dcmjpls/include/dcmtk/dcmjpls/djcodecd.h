@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2007-2020, OFFIS e.V.
+ *  Copyright (C) 2007-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -29,6 +29,7 @@
 
 /* forward declaration */
 class DJLSCodecParameter;
+class DJLSFrameDecompressionTask;
 
 /** abstract codec class for JPEG-LS decoders.
  *  This abstract class contains most of the application logic
@@ -192,6 +193,9 @@ public:
 
 private:
 
+  /// helper class for parallel decompression, needs access to static helper methods
+  friend class DJLSFrameDecompressionTask;
+
   /** returns the transfer syntax that this particular codec
    *  is able to Decode
    *  @return supported transfer syntax
@@ -239,6 +243,63 @@ private:
     Uint16 imageSamplesPerPixel,
     Uint16 bytesPerSample);
 
+  /** decompresses a single frame from the given JPEG-LS bitstream and
+   *  stores the result in the given buffer. Does not access the dataset.
+   *  @param jlsData JPEG-LS bitstream of the frame
+   *  @param compressedSize size of the JPEG-LS bitstream in bytes
+   *  @param buffer pointer to buffer where frame is to be stored
+   *  @param bufSize size of buffer in bytes
+   *  @param imageColumns number of columns for each frame
+   *  @param imageRows number of rows for each frame
+   *  @param imageSamplesPerPixel number of samples per pixel
+   *  @param bytesPerSample number of bytes per sample
+   *  @param imagePlanarConfiguration planar configuration of the uncompressed frame
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  static OFCondition decodeFrameData(
+    Uint8 *jlsData,
+    size_t compressedSize,
+    void *buffer,
+    Uint32 bufSize,
+    Uint16 imageColumns,
+    Uint16 imageRows,
+    Uint16 imageSamplesPerPixel,
+    Uint16 bytesPerSample,
+    Uint16 imagePlanarConfiguration);
+
+  /** decompresses all frames except the first one in parallel.
+   *  Called by decode() after the first frame has been decompressed.
+   *  Does nothing unless enabled by the global flag dcmDecompressionThreads.
+   *  @param fromPixSeq compressed pixel sequence
+   *  @param cp codec parameters for this codec
+   *  @param dataset pointer to dataset in which pixel data element is contained
+   *  @param nextItem index of the fragment following the first frame
+   *  @param buffer pointer to the uncompressed pixel data of all frames
+   *  @param frameSize size of an uncompressed frame in bytes
+   *  @param imageFrames number of frames in this image
+   *  @param imageColumns number of columns for each frame
+   *  @param imageRows number of rows for each frame
+   *  @param imageSamplesPerPixel number of samples per pixel
+   *  @param bytesPerSample number of bytes per sample
+   *  @param currentFrame number of the next frame to be decompressed,
+   *    set to imageFrames if all remaining frames have been decompressed
+   *  @return EC_Normal if successful or if the frames must be decompressed
+   *    sequentially, an error code otherwise
+   */
+  static OFCondition decodeRemainingFrames(
+    DcmPixelSequence * fromPixSeq,
+    const DJLSCodecParameter *cp,
+    DcmItem *dataset,
+    Uint32 nextItem,
+    Uint8 *buffer,
+    Uint32 frameSize,
+    Sint32 imageFrames,
+    Uint16 imageColumns,
+    Uint16 imageRows,
+    Uint16 imageSamplesPerPixel,
+    Uint16 bytesPerSample,
+    Sint32& currentFrame);
+
   /** determines if a given image requires color-by-plane planar configuration
    *  depending on SOP Class UID (DICOM IOD) and photometric interpretation.
    *  All SOP classes defined in the 2003 edition of the DICOM standard or earlier
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2007-2022, OFFIS e.V.
+ *  Copyright (C) 2007-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -31,6 +31,7 @@
 class DJLSRepresentationParameter;
 class DJLSCodecParameter;
 class DicomImage;
+class DJLSFrameCompressionTask;
 struct JlsCustomParameters;
 
 /** abstract codec class for JPEG-LS encoders.
@@ -195,6 +196,9 @@ public:
 
 private:
 
+  /// helper class for parallel compression, needs access to the frame compression methods
+  friend class DJLSFrameCompressionTask;
+
   /** returns the transfer syntax that this particular codec
    *  is able to encode
    *  @return supported transfer syntax
@@ -286,8 +290,8 @@ private:
    *  @param samplesPerPixel image samples per pixel
    *  @param planarConfiguration image planar configuration
    *  @param photometricInterpretation photometric interpretation of the DICOM dataset
-   *  @param pixelSequence object in which the compressed frame is stored
-   *  @param offsetList list of frame offsets updated in this parameter
+   *  @param compressedData compressed frame returned in this parameter upon success,
+   *    allocated with new[]. The caller is responsible for deleting the buffer.
    *  @param compressedSize size of compressed frame returned in this parameter
    *  @param djcp parameters for the codec
    *  @return EC_Normal if successful, an error code otherwise
@@ -300,16 +304,17 @@ private:
     Uint16 samplesPerPixel,
     Uint16 planarConfiguration,
     const OFString& photometricInterpretation,
-    DcmPixelSequence *pixelSequence,
-    DcmOffsetList &offsetList,
+    Uint8 *&compressedData,
     unsigned long &compressedSize,
     const DJLSCodecParameter *djcp) const;
 
-  /** perform the lossless cooked compression of a single frame
-   *  @param pixelSequence object in which the compressed frame is stored
+  /** perform the lossless cooked compression of a single frame.
+   *  This method only reads the intermediate representation of the image,
+   *  so it may be called concurrently for different frames of the same image.
    *  @param dimage DicomImage instance used to process frame
    *  @param photometricInterpretation photometric interpretation of the DICOM dataset
-   *  @param offsetList list of frame offsets updated in this parameter
+   *  @param compressedData compressed frame returned in this parameter upon success,
+   *    allocated with new[]. The caller is responsible for deleting the buffer.
    *  @param compressedSize size of compressed frame returned in this parameter
    *  @param djcp parameters for the codec
    *  @param frame frame index
@@ -317,10 +322,9 @@ private:
    *  @return EC_Normal if successful, an error code otherwise
    */
   OFCondition compressCookedFrame(
-    DcmPixelSequence *pixelSequence,
     DicomImage *dimage,
     const OFString& photometricInterpretation,
-    DcmOffsetList &offsetList,
+    Uint8 *&compressedData,
     unsigned long &compressedSize,
     const DJLSCodecParameter *djcp,
     Uint32 frame,
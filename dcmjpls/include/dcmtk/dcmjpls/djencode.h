@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2019, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -52,6 +52,8 @@ public:
    *  @param convertToSC               flag indicating whether image should be converted to Secondary Capture upon compression
    *  @param jplsInterleaveMode        flag describing which interleave the JPEG-LS datastream should use
    *  @param useFFbitstreamPadding     flag indicating whether the JPEG-LS bitstream should be FF padded as required by DICOM.
+   *  @param numberOfThreads           number of threads used to compress the frames of a multi-frame image in parallel,
+   *                                   1 for sequential compression
    */
   static void registerCodecs(
     Uint16 jpls_t1 = 0,
@@ -64,7 +66,8 @@ public:
     JLS_UIDCreation uidCreation = EJLSUC_default,
     OFBool convertToSC = OFFalse,
     DJLSCodecParameter::interleaveMode jplsInterleaveMode = DJLSCodecParameter::interleaveDefault,
-    OFBool useFFbitstreamPadding = OFTrue );
+    OFBool useFFbitstreamPadding = OFTrue,
+    Uint32 numberOfThreads = 1 );
 
   /** deregisters encoders.
    *  Attention: Must not be called while other threads might still use
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2007-2024, OFFIS e.V.
+ *  Copyright (C) 2007-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -39,6 +39,135 @@
 // JPEG-LS library (CharLS) includes
 #include "intrface.h"
 
+/** helper class that decompresses the frames of a JPEG-LS compressed
+ *  multi-frame image in parallel, see DcmCodec::decompressFrames()
+ */
+class DJLSFrameDecompressionTask: public DcmEncapsulatedFrameDecompressionTask
+{
+public:
+
+  /** constructor
+   *  @param fragmentData pointers to the content of all fragments
+   *  @param fragmentLength lengths of all fragments
+   *  @param startFragments index of the first fragment of each frame, followed by
+   *    the index of the fragment following the last frame
+   *  @param imageData8 pointer to the uncompressed pixel data of all frames
+   *  @param frameSize size of an uncompressed frame in bytes
+   *  @param numberOfThreads number of threads that will use this object
+   *  @param imageColumns number of columns for each frame
+   *  @param imageRows number of rows for each frame
+   *  @param imageSamplesPerPixel number of samples per pixel
+   *  @param bytesPerSample number of bytes per sample
+   *  @param imagePlanarConfiguration planar configuration of the uncompressed frames
+   *  @param forceSingleFragmentPerFrame true if incomplete frames should be ignored
+   */
+  DJLSFrameDecompressionTask(
+    const OFVector<Uint8 *>& fragmentData,
+    const OFVector<Uint32>& fragmentLength,
+    const OFVector<Uint32>& startFragments,
+    Uint8 *imageData8,
+    Uint32 frameSize,
+    Uint32 numberOfThreads,
+    Uint16 imageColumns,
+    Uint16 imageRows,
+    Uint16 imageSamplesPerPixel,
+    Uint16 bytesPerSample,
+    Uint16 imagePlanarConfiguration,
+    OFBool forceSingleFragmentPerFrame)
+  : DcmEncapsulatedFrameDecompressionTask(fragmentData, fragmentLength, startFragments, imageData8, frameSize, numberOfThreads)
+  , imageColumns_(imageColumns)
+  , imageRows_(imageRows)
+  , imageSamplesPerPixel_(imageSamplesPerPixel)
+  , bytesPerSample_(bytesPerSample)
+  , imagePlanarConfiguration_(imagePlanarConfiguration)
+  , forceSingleFragmentPerFrame_(forceSingleFragmentPerFrame)
+  {
+  }
+
+protected:
+
+  /** decompresses a single frame into the given buffer
+   *  @param currentItem index of the first fragment of the frame. Upon return,
+   *    contains the index of the fragment following the last one used.
+   *  @param endItem index of the fragment following the last one that may be used
+   *  @param imageData8 pointer to the uncompressed pixel data of this frame
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  virtual OFCondition decodeFrame(Uint32 /* frameNo */, Uint32 /* threadNo */, Uint32& currentItem, Uint32 endItem, Uint8 *imageData8)
+  {
+    const Uint32 firstItem = currentItem;
+    Uint8 *fragment = NULL;
+    Uint32 length = 0;
+    size_t compressedSize = 0;
+
+    // determine the size of the bitstream of this frame
+    while (getFragment(currentItem, endItem, fragment, length).good()) compressedSize += length;
+
+    Uint8 *jlsData = NULL;
+    Uint8 *frameData = NULL;
+    if (currentItem == firstItem + 1)
+    {
+      // standard case: a single fragment can be decompressed in place
+      jlsData = fragment;
+    }
+    else
+    {
+      // multiple fragments: copy the bitstream into a contiguous buffer
+      frameData = new Uint8[compressedSize];
+      size_t offset = 0;
+      for (Uint32 i = firstItem; getFragment(i, endItem, fragment, length).good(); )
+      {
+        if (fragment)
+        {
+          memcpy(frameData + offset, fragment, length);
+          offset += length;
+        }
+      }
+      compressedSize = offset;
+      jlsData = frameData;
+    }
+    if (jlsData == NULL) return EC_CorruptedData;
+
+    OFCondition result = DJLSDecoderBase::decodeFrameData(jlsData, compressedSize, imageData8, getFrameSize(),
+      imageColumns_, imageRows_, imageSamplesPerPixel_, bytesPerSample_, imagePlanarConfiguration_);
+    delete[] frameData;
+
+    if ((result == EC_JLSInvalidCompressedData) && forceSingleFragmentPerFrame_)
+    {
+      DCMJPLS_WARN("JPEG-LS bitstream invalid or incomplete, ignoring (but image is likely to be incomplete)");
+      result = EC_Normal;
+    }
+    return result;
+  }
+
+private:
+
+  /// private undefined copy constructor
+  DJLSFrameDecompressionTask(const DJLSFrameDecompressionTask&);
+
+  /// private undefined copy assignment operator
+  DJLSFrameDecompressionTask& operator=(const DJLSFrameDecompressionTask&);
+
+  /// number of columns for each frame
+  Uint16 imageColumns_;
+
+  /// number of rows for each frame
+  Uint16 imageRows_;
+
+  /// number of samples per pixel
+  Uint16 imageSamplesPerPixel_;
+
+  /// number of bytes per sample
+  Uint16 bytesPerSample_;
+
+  /// planar configuration of the uncompressed frames
+  Uint16 imagePlanarConfiguration_;
+
+  /// true if incomplete frames should be ignored
+  OFBool forceSingleFragmentPerFrame_;
+};
+
+
 E_TransferSyntax DJLSLosslessDecoder::supportedTransferSyntax() const
 {
   return EXS_JPEGLSLossless;
@@ -204,6 +333,15 @@ OFCondition DJLSDecoderBase::decode(
         // increment frame number, check if we're finished
         if (++currentFrame == imageFrames) done = OFTrue;
         pixeldata8 += frameSize;
+
+        // the first frame has determined the planar configuration,
+        // now decompress the remaining frames in parallel if possible
+        if ((currentFrame == 1) && !done)
+        {
+          result = decodeRemainingFrames(pixSeq, djcp, dataset, currentItem, pixeldata8 - frameSize, frameSize,
+            imageFrames, imageColumns, imageRows, imageSamplesPerPixel, bytesPerSample, currentFrame);
+          if (currentFrame == imageFrames) done = OFTrue;
+        }
       }
   }
 
@@ -419,77 +557,143 @@ OFCondition DJLSDecoderBase::decodeFrame(
 
   if (result.good())
   {
-    JlsParameters params;
-    JLS_ERROR err;
-
-    err = JpegLsReadHeader(jlsData, compressedSize, &params);
-    result = DJLSError::convert(err);
+    result = decodeFrameData(jlsData, compressedSize, buffer, bufSize, imageColumns, imageRows,
+      imageSamplesPerPixel, bytesPerSample, imagePlanarConfiguration);
 
-    if (result.good())
+    // update planar configuration if we are decoding a color image
+    if (result.good() && (imageSamplesPerPixel > 1))
     {
-      if (params.width != imageColumns) result = EC_JLSImageDataMismatch;
-      else if (params.height != imageRows) result = EC_JLSImageDataMismatch;
-      else if (params.components != imageSamplesPerPixel) result = EC_JLSImageDataMismatch;
-      else if ((bytesPerSample == 1) && (params.bitspersample > 8)) result = EC_JLSImageDataMismatch;
-      else if ((bytesPerSample == 2) && (params.bitspersample <= 8)) result = EC_JLSImageDataMismatch;
+      dataset->putAndInsertUint16(DCM_PlanarConfiguration, imagePlanarConfiguration);
     }
+  }
+  delete[] jlsData;
 
-    if (!result.good())
-    {
-      delete[] jlsData;
-    }
-    else
-    {
-      err = JpegLsDecode(buffer, bufSize, jlsData, compressedSize, &params);
-      result = DJLSError::convert(err);
-      delete[] jlsData;
+  return result;
+}
+
+
+OFCondition DJLSDecoderBase::decodeFrameData(
+    Uint8 *jlsData,
+    size_t compressedSize,
+    void *buffer,
+    Uint32 bufSize,
+    Uint16 imageColumns,
+    Uint16 imageRows,
+    Uint16 imageSamplesPerPixel,
+    Uint16 bytesPerSample,
+    Uint16 imagePlanarConfiguration)
+{
+  JlsParameters params;
+  JLS_ERROR err;
+
+  err = JpegLsReadHeader(jlsData, compressedSize, &params);
+  OFCondition result = DJLSError::convert(err);
+
+  if (result.good())
+  {
+    if (params.width != imageColumns) result = EC_JLSImageDataMismatch;
+    else if (params.height != imageRows) result = EC_JLSImageDataMismatch;
+    else if (params.components != imageSamplesPerPixel) result = EC_JLSImageDataMismatch;
+    else if ((bytesPerSample == 1) && (params.bitspersample > 8)) result = EC_JLSImageDataMismatch;
+    else if ((bytesPerSample == 2) && (params.bitspersample <= 8)) result = EC_JLSImageDataMismatch;
+  }
+
+  if (result.good())
+  {
+    err = JpegLsDecode(buffer, bufSize, jlsData, compressedSize, &params);
+    result = DJLSError::convert(err);
 
-      if (result.good() && imageSamplesPerPixel == 3)
+    if (result.good() && imageSamplesPerPixel == 3)
+    {
+      if (params.colorTransform != 0)
       {
-        if (params.colorTransform != 0)
-        {
-          DCMJPLS_WARN("Color Transformation " << params.colorTransform << " is a non-standard HP/JPEG-LS extension");
-        }
-        if (imagePlanarConfiguration == 1 && params.ilv != ILV_NONE)
-        {
-          // The dataset says this should be planarConfiguration == 1, but
-          // it isn't -> convert it.
-          DCMJPLS_DEBUG("different planar configuration in JPEG-LS bitstream, converting to \"1\"");
-          if (bytesPerSample == 1)
-            result = createPlanarConfiguration1Byte(OFreinterpret_cast(Uint8*, buffer), imageColumns, imageRows);
-          else
-            result = createPlanarConfiguration1Word(OFreinterpret_cast(Uint16*, buffer), imageColumns, imageRows);
-        }
-        else if (imagePlanarConfiguration == 0 && params.ilv != ILV_SAMPLE && params.ilv != ILV_LINE)
-        {
-          // The dataset says this should be planarConfiguration == 0, but
-          // it isn't -> convert it.
-          DCMJPLS_DEBUG("different planar configuration in JPEG-LS bitstream, converting to \"0\"");
-          if (bytesPerSample == 1)
-            result = createPlanarConfiguration0Byte(OFreinterpret_cast(Uint8*, buffer), imageColumns, imageRows);
-          else
-            result = createPlanarConfiguration0Word(OFreinterpret_cast(Uint16*, buffer), imageColumns, imageRows);
-        }
+        DCMJPLS_WARN("Color Transformation " << params.colorTransform << " is a non-standard HP/JPEG-LS extension");
       }
-
-      if (result.good())
+      if (imagePlanarConfiguration == 1 && params.ilv != ILV_NONE)
       {
-          // decompression is complete, finally adjust byte order if necessary
-          if (bytesPerSample == 1) // we're writing bytes into words
-          {
-              result = swapIfNecessary(gLocalByteOrder, EBO_LittleEndian, buffer,
-                      bufSize, sizeof(Uint16));
-          }
+        // The dataset says this should be planarConfiguration == 1, but
+        // it isn't -> convert it.
+        DCMJPLS_DEBUG("different planar configuration in JPEG-LS bitstream, converting to \"1\"");
+        if (bytesPerSample == 1)
+          result = createPlanarConfiguration1Byte(OFreinterpret_cast(Uint8*, buffer), imageColumns, imageRows);
+        else
+          result = createPlanarConfiguration1Word(OFreinterpret_cast(Uint16*, buffer), imageColumns, imageRows);
       }
-
-      // update planar configuration if we are decoding a color image
-      if (result.good() && (imageSamplesPerPixel > 1))
+      else if (imagePlanarConfiguration == 0 && params.ilv != ILV_SAMPLE && params.ilv != ILV_LINE)
       {
-        dataset->putAndInsertUint16(DCM_PlanarConfiguration, imagePlanarConfiguration);
+        // The dataset says this should be planarConfiguration == 0, but
+        // it isn't -> convert it.
+        DCMJPLS_DEBUG("different planar configuration in JPEG-LS bitstream, converting to \"0\"");
+        if (bytesPerSample == 1)
+          result = createPlanarConfiguration0Byte(OFreinterpret_cast(Uint8*, buffer), imageColumns, imageRows);
+        else
+          result = createPlanarConfiguration0Word(OFreinterpret_cast(Uint16*, buffer), imageColumns, imageRows);
       }
     }
+
+    if (result.good())
+    {
+        // decompression is complete, finally adjust byte order if necessary
+        if (bytesPerSample == 1) // we're writing bytes into words
+        {
+            result = swapIfNecessary(gLocalByteOrder, EBO_LittleEndian, buffer,
+                    bufSize, sizeof(Uint16));
+        }
+    }
+  }
+
+  return result;
+}
+
+
+OFCondition DJLSDecoderBase::decodeRemainingFrames(
+    DcmPixelSequence * fromPixSeq,
+    const DJLSCodecParameter *cp,
+    DcmItem *dataset,
+    Uint32 nextItem,
+    Uint8 *buffer,
+    Uint32 frameSize,
+    Sint32 imageFrames,
+    Uint16 imageColumns,
+    Uint16 imageRows,
+    Uint16 imageSamplesPerPixel,
+    Uint16 bytesPerSample,
+    Sint32& currentFrame)
+{
+  Uint32 numberOfThreads = getDecompressionThreadCount(OFstatic_cast(Uint32, imageFrames - 1));
+  if (numberOfThreads < 2) return EC_Normal;
+
+  // determine the fragments of all remaining frames in the same way as decodeFrame()
+  const Uint32 numItems = OFstatic_cast(Uint32, fromPixSeq->card());
+  const OFBool ignoreOffsetTable = cp->ignoreOffsetTable();
+  OFVector<Uint32> startFragments(OFstatic_cast(size_t, imageFrames) + 1, 0);
+  startFragments[1] = nextItem;
+  for (Sint32 frameNo = 1; frameNo < imageFrames; ++frameNo)
+  {
+    Uint32 fragmentsForThisFrame = computeNumberOfFragments(imageFrames, frameNo, startFragments[frameNo], ignoreOffsetTable, fromPixSeq);
+    if ((fragmentsForThisFrame == 0) || (startFragments[frameNo] + fragmentsForThisFrame > numItems))
+      return EC_JLSCannotComputeNumberOfFragments;
+    startFragments[frameNo + 1] = startFragments[frameNo] + fragmentsForThisFrame;
   }
 
+  // the first frame has stored the planar configuration in the dataset,
+  // it is the same for all frames
+  Uint16 imagePlanarConfiguration = 0;
+  if (imageSamplesPerPixel > 1)
+    dataset->findAndGetUint16(DCM_PlanarConfiguration, imagePlanarConfiguration);
+
+  OFVector<Uint8 *> fragmentData;
+  OFVector<Uint32> fragmentLength;
+  OFCondition result = getFragmentData(fromPixSeq, fragmentData, fragmentLength);
+  if (result.good())
+  {
+    DCMJPLS_DEBUG("JPEG-LS decoder processes frames 2 to " << imageFrames << " using " << numberOfThreads << " threads");
+    DJLSFrameDecompressionTask task(fragmentData, fragmentLength, startFragments, buffer, frameSize,
+      numberOfThreads, imageColumns, imageRows, imageSamplesPerPixel, bytesPerSample, imagePlanarConfiguration,
+      cp->getForceSingleFragmentPerFrame());
+    result = decompressFrames(task, 1, OFstatic_cast(Uint32, imageFrames - 1), numberOfThreads);
+    if (result.good()) currentFrame = imageFrames;
+  }
   return result;
 }
 
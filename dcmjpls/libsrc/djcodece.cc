@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2007-2023, OFFIS e.V.
+ *  Copyright (C) 2007-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -79,6 +79,193 @@ E_TransferSyntax DJLSNearLosslessEncoder::supportedTransferSyntax() const
 
 // --------------------------------------------------------------------------
 
+/** helper class that compresses the frames of a multi-frame image with
+ *  JPEG-LS, possibly in parallel, see DcmCodec::compressFrames().
+ *  The frames are either taken from the uncompressed pixel data ("raw"
+ *  mode) or from the intermediate representation of a DicomImage
+ *  ("cooked" mode). Both are only read during compression.
+ */
+class DJLSFrameCompressionTask: public DcmFrameCompressionTask
+{
+public:
+  /** constructor
+   *  @param codec encoder that performs the compression of each frame
+   *  @param djcp parameters for the codec
+   *  @param photometricInterpretation photometric interpretation of the DICOM dataset
+   *  @param frameCount number of frames
+   *  @param pixelSequence pixel sequence in which the compressed frames are stored
+   *  @param offsetList offset list updated for each compressed frame
+   */
+  DJLSFrameCompressionTask(
+    const DJLSEncoderBase& codec,
+    const DJLSCodecParameter *djcp,
+    const OFString& photometricInterpretation,
+    unsigned long frameCount,
+    DcmPixelSequence *pixelSequence,
+    DcmOffsetList& offsetList)
+  : DcmFrameCompressionTask()
+  , codec_(codec)
+  , djcp_(djcp)
+  , photometricInterpretation_(photometricInterpretation)
+  , pixelSequence_(pixelSequence)
+  , offsetList_(offsetList)
+  , pixelData_(NULL)
+  , frameSize_(0)
+  , bitsAllocated_(0)
+  , columns_(0)
+  , rows_(0)
+  , samplesPerPixel_(0)
+  , planarConfiguration_(0)
+  , dimage_(NULL)
+  , nearLosslessDeviation_(0)
+  , compressedData_(frameCount, OFstatic_cast(Uint8 *, NULL))
+  , compressedFrameSize_(frameCount, 0)
+  , compressedSize_(0)
+  {
+  }
+
+  /// destructor, frees all compressed frames that have not been stored
+  virtual ~DJLSFrameCompressionTask()
+  {
+    for (size_t i = 0; i < compressedData_.size(); ++i) delete[] compressedData_[i];
+  }
+
+  /** select raw mode, i.e.\ compress the frames of the given uncompressed pixel data
+   *  @param pixelData pointer to the first frame
+   *  @param frameSize size of one frame in bytes
+   *  @param bitsAllocated number of bits allocated per pixel
+   *  @param columns frame width
+   *  @param rows frame height
+   *  @param samplesPerPixel image samples per pixel
+   *  @param planarConfiguration image planar configuration
+   */
+  void setRawFrames(
+    const Uint8 *pixelData,
+    unsigned long frameSize,
+    Uint16 bitsAllocated,
+    Uint16 columns,
+    Uint16 rows,
+    Uint16 samplesPerPixel,
+    Uint16 planarConfiguration)
+  {
+    pixelData_ = pixelData;
+    frameSize_ = frameSize;
+    bitsAllocated_ = bitsAllocated;
+    columns_ = columns;
+    rows_ = rows;
+    samplesPerPixel_ = samplesPerPixel;
+    planarConfiguration_ = planarConfiguration;
+  }
+
+  /** select cooked mode, i.e.\ compress the frames of the given image
+   *  @param dimage DicomImage instance used to process the frames
+   *  @param nearLosslessDeviation maximum deviation for near-lossless encoding
+   */
+  void setCookedFrames(DicomImage *dimage, Uint16 nearLosslessDeviation)
+  {
+    dimage_ = dimage;
+    nearLosslessDeviation_ = nearLosslessDeviation;
+  }
+
+  /** compresses a single frame
+   *  @param frameNo number of the frame
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  virtual OFCondition compressFrame(Uint32 frameNo, Uint32 /* threadNo */)
+  {
+    DCMJPLS_DEBUG("JPEG-LS encoder processes frame " << (frameNo+1) << " of " << compressedData_.size());
+    if (dimage_)
+      return codec_.compressCookedFrame(dimage_, photometricInterpretation_,
+        compressedData_[frameNo], compressedFrameSize_[frameNo], djcp_, frameNo, nearLosslessDeviation_);
+    return codec_.compressRawFrame(pixelData_ + frameSize_ * frameNo, bitsAllocated_, columns_, rows_,
+      samplesPerPixel_, planarConfiguration_, photometricInterpretation_,
+      compressedData_[frameNo], compressedFrameSize_[frameNo], djcp_);
+  }
+
+  /** stores a compressed frame in the pixel sequence
+   *  @param frameNo number of the frame
+   *  @return EC_Normal if successful, an error code otherwise.
+   */
+  virtual OFCondition storeFrame(Uint32 frameNo)
+  {
+    OFCondition result = pixelSequence_->storeCompressedFrame(offsetList_, compressedData_[frameNo],
+      OFstatic_cast(Uint32, compressedFrameSize_[frameNo]), djcp_->getFragmentSize());
+    if (result.good()) compressedSize_ += compressedFrameSize_[frameNo];
+    delete[] compressedData_[frameNo];
+    compressedData_[frameNo] = NULL;
+    return result;
+  }
+
+  /** returns the total size of all compressed frames stored so far
+   *  @return compressed size in bytes
+   */
+  unsigned long getCompressedSize() const
+  {
+    return compressedSize_;
+  }
+
+private:
+
+  /// private undefined copy constructor
+  DJLSFrameCompressionTask(const DJLSFrameCompressionTask&);
+
+  /// private undefined copy assignment operator
+  DJLSFrameCompressionTask& operator=(const DJLSFrameCompressionTask&);
+
+  /// encoder that performs the compression of each frame
+  const DJLSEncoderBase& codec_;
+
+  /// parameters for the codec
+  const DJLSCodecParameter *djcp_;
+
+  /// photometric interpretation of the DICOM dataset
+  OFString photometricInterpretation_;
+
+  /// pixel sequence in which the compressed frames are stored
+  DcmPixelSequence *pixelSequence_;
+
+  /// offset list updated for each compressed frame
+  DcmOffsetList& offsetList_;
+
+  /// pointer to the first frame of the uncompressed pixel data (raw mode)
+  const Uint8 *pixelData_;
+
+  /// size of one frame in bytes (raw mode)
+  unsigned long frameSize_;
+
+  /// number of bits allocated per pixel (raw mode)
+  Uint16 bitsAllocated_;
+
+  /// frame width (raw mode)
+  Uint16 columns_;
+
+  /// frame height (raw mode)
+  Uint16 rows_;
+
+  /// image samples per pixel (raw mode)
+  Uint16 samplesPerPixel_;
+
+  /// image planar configuration (raw mode)
+  Uint16 planarConfiguration_;
+
+  /// DicomImage instance used to process the frames (cooked mode)
+  DicomImage *dimage_;
+
+  /// maximum deviation for near-lossless encoding (cooked mode)
+  Uint16 nearLosslessDeviation_;
+
+  /// compressed frames that have not been stored yet
+  OFVector<Uint8 *> compressedData_;
+
+  /// size of the compressed frames that have not been stored yet
+  OFVector<unsigned long> compressedFrameSize_;
+
+  /// total size of all compressed frames stored so far
+  unsigned long compressedSize_;
+};
+
+// --------------------------------------------------------------------------
+
 DJLSEncoderBase::DJLSEncoderBase()
 : DcmCodec()
 {
@@ -504,7 +691,6 @@ OFCondition DJLSEncoderBase::losslessRawEncode(
 
   DcmOffsetList offsetList;
   unsigned long compressedSize = 0;
-  unsigned long compressedFrameSize = 0;
   double uncompressedSize = 0.0;
 
   // render and compress each frame
@@ -525,17 +711,11 @@ OFCondition DJLSEncoderBase::losslessRawEncode(
     // compute original image size in bytes, ignoring any padding bits.
     uncompressedSize = columns * rows * samplesPerPixel * bitsStored * frameCount / 8.0;
 
-    for (unsigned long i=0; (i<frameCount) && (result.good()); ++i)
-    {
-      // compress frame
-      DCMJPLS_DEBUG("JPEG-LS encoder processes frame " << (i+1) << " of " << frameCount);
-      result = compressRawFrame(framePointer, bitsAllocated, columns, rows,
-          samplesPerPixel, planarConfiguration, photometricInterpretation,
-          pixelSequence, offsetList, compressedFrameSize, djcp);
-
-      compressedSize += compressedFrameSize;
-      framePointer += frameSize;
-    }
+    // compress all frames, possibly in parallel
+    DJLSFrameCompressionTask task(*this, djcp, photometricInterpretation, frameCount, pixelSequence, offsetList);
+    task.setRawFrames(framePointer, frameSize, bitsAllocated, columns, rows, samplesPerPixel, planarConfiguration);
+    result = compressFrames(task, OFstatic_cast(Uint32, frameCount), djcp->getNumberOfThreads());
+    compressedSize = task.getCompressedSize();
   }
 
   // store pixel sequence if everything went well.
@@ -647,15 +827,13 @@ OFCondition DJLSEncoderBase::compressRawFrame(
   Uint16 samplesPerPixel,
   Uint16 planarConfiguration,
   const OFString& /* photometricInterpretation */,
-  DcmPixelSequence *pixelSequence,
-  DcmOffsetList &offsetList,
+  Uint8 *&compressedData,
   unsigned long &compressedSize,
   const DJLSCodecParameter *djcp) const
 {
   OFCondition result = EC_Normal;
   Uint16 bytesAllocated = bitsAllocated / 8;
   Uint32 frameSize = width*height*bytesAllocated*samplesPerPixel;
-  Uint32 fragmentSize = djcp->getFragmentSize();
   JlsParameters jls_params;
   Uint8 *frameBuffer = NULL;
 
@@ -762,10 +940,9 @@ OFCondition DJLSEncoderBase::compressRawFrame(
     {
       compressedSize = OFstatic_cast(unsigned long, bytesWritten);
       fixPaddingIfNecessary(OFstatic_cast(Uint8 *, buffer), size, compressedSize, djcp->getUseFFbitstreamPadding());
-      result = pixelSequence->storeCompressedFrame(offsetList, buffer, compressedSize, fragmentSize);
+      compressedData = buffer;
     }
-
-    delete[] buffer;
+    else delete[] buffer;
   }
 
   if (frameBuffer)
@@ -883,7 +1060,6 @@ OFCondition DJLSEncoderBase::losslessCookedEncode(
 
   DcmOffsetList offsetList;
   unsigned long compressedSize = 0;
-  unsigned long compressedFrameSize = 0;
   double uncompressedSize = 0.0;
 
   // render and compress each frame
@@ -897,15 +1073,11 @@ OFCondition DJLSEncoderBase::losslessCookedEncode(
     uncompressedSize = dimage->getWidth() * dimage->getHeight() *
       bitsPerSample * frameCount * samplesPerPixel / 8.0;
 
-    for (unsigned long i=0; (i<frameCount) && (result.good()); ++i)
-    {
-      // compress frame
-      DCMJPLS_DEBUG("JPEG-LS encoder processes frame " << (i+1) << " of " << frameCount);
-      result = compressCookedFrame(pixelSequence, dimage,
-          photometricInterpretation, offsetList, compressedFrameSize, djcp, i, nearLosslessDeviation);
-
-      compressedSize += compressedFrameSize;
-    }
+    // compress all frames, possibly in parallel
+    DJLSFrameCompressionTask task(*this, djcp, photometricInterpretation, frameCount, pixelSequence, offsetList);
+    task.setCookedFrames(dimage, nearLosslessDeviation);
+    result = compressFrames(task, OFstatic_cast(Uint32, frameCount), djcp->getNumberOfThreads());
+    compressedSize = task.getCompressedSize();
   }
 
   // store pixel sequence if everything went well.
@@ -955,10 +1127,9 @@ OFCondition DJLSEncoderBase::losslessCookedEncode(
 
 
 OFCondition DJLSEncoderBase::compressCookedFrame(
-  DcmPixelSequence *pixelSequence,
   DicomImage *dimage,
   const OFString& /* photometricInterpretation */,
-  DcmOffsetList &offsetList,
+  Uint8 *&compressedData,
   unsigned long &compressedSize,
   const DJLSCodecParameter *djcp,
   Uint32 frame,
@@ -972,8 +1143,6 @@ OFCondition DJLSEncoderBase::compressCookedFrame(
   int depth = dimage->getDepth();
   if ((depth < 1) || (depth > 16)) return EC_JLSUnsupportedBitDepth;
 
-  Uint32 fragmentSize = djcp->getFragmentSize();
-
   const DiPixel *dinter = dimage->getInterData();
   if (dinter == NULL) return EC_IllegalCall;
 
@@ -1168,12 +1337,12 @@ OFCondition DJLSEncoderBase::compressCookedFrame(
   {
     // 'compressed_buffer_size' now contains the size of the compressed data in buffer
     compressedSize = OFstatic_cast(unsigned long, bytesWritten);
-    fixPaddingIfNecessary(OFstatic_cast(Uint8 *, buffer), compressed_buffer_size, compressedSize, djcp->getUseFFbitstreamPadding());
-    result = pixelSequence->storeCompressedFrame(offsetList, compressed_buffer, compressedSize, fragmentSize);
+    fixPaddingIfNecessary(compressed_buffer, compressed_buffer_size, compressedSize, djcp->getUseFFbitstreamPadding());
+    compressedData = compressed_buffer;
   }
+  else delete[] compressed_buffer;
 
   delete[] buffer;
-  delete[] compressed_buffer;
   if (frameBuffer)
     delete[] frameBuffer;
 
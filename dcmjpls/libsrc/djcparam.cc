@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2019, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -36,7 +36,8 @@ DJLSCodecParameter::DJLSCodecParameter(
      JLS_PlanarConfiguration planarConfiguration,
      OFBool ignoreOffsetTble,
      interleaveMode jplsInterleaveMode,
-     OFBool useFFbitstreamPadding)
+     OFBool useFFbitstreamPadding,
+     Uint32 numberOfThreads)
 : DcmCodecParameter()
 , preferCookedEncoding_(preferCookedEncoding)
 , jpls_t1_(jpls_t1)
@@ -49,6 +50,7 @@ DJLSCodecParameter::DJLSCodecParameter(
 , convertToSC_(convertToSC)
 , jplsInterleaveMode_(jplsInterleaveMode)
 , useFFbitstreamPadding_(useFFbitstreamPadding)
+, numberOfThreads_(numberOfThreads)
 , planarConfiguration_(planarConfiguration)
 , ignoreOffsetTable_(ignoreOffsetTble)
 , forceSingleFragmentPerFrame_(OFFalse)
@@ -73,6 +75,7 @@ DJLSCodecParameter::DJLSCodecParameter(
 , convertToSC_(OFFalse)
 , jplsInterleaveMode_(interleaveDefault)
 , useFFbitstreamPadding_(OFTrue)
+, numberOfThreads_(1)
 , planarConfiguration_(planarConfiguration)
 , ignoreOffsetTable_(ignoreOffsetTble)
 , forceSingleFragmentPerFrame_(forceSingleFragmentPerFrame)
@@ -92,6 +95,7 @@ DJLSCodecParameter::DJLSCodecParameter(const DJLSCodecParameter& arg)
 , convertToSC_(arg.convertToSC_)
 , jplsInterleaveMode_(arg.jplsInterleaveMode_)
 , useFFbitstreamPadding_(arg.useFFbitstreamPadding_)
+, numberOfThreads_(arg.numberOfThreads_)
 , planarConfiguration_(arg.planarConfiguration_)
 , ignoreOffsetTable_(arg.ignoreOffsetTable_)
 , forceSingleFragmentPerFrame_(arg.forceSingleFragmentPerFrame_)
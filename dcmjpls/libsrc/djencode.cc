@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2019, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -43,13 +43,15 @@ void DJLSEncoderRegistration::registerCodecs(
     JLS_UIDCreation uidCreation,
     OFBool convertToSC,
     DJLSCodecParameter::interleaveMode jplsInterleaveMode,
-    OFBool useFFbitstreamPadding)
+    OFBool useFFbitstreamPadding,
+    Uint32 numberOfThreads)
 {
   if (! registered_)
   {
     cp_ = new DJLSCodecParameter(preferCookedEncoding, jpls_t1, jpls_t2, jpls_t3,
       jpls_reset, fragmentSize, createOffsetTable, uidCreation,
-      convertToSC, EJLSPC_restore, OFFalse, jplsInterleaveMode, useFFbitstreamPadding);
+      convertToSC, EJLSPC_restore, OFFalse, jplsInterleaveMode, useFFbitstreamPadding,
+      numberOfThreads);
 
     if (cp_)
     {
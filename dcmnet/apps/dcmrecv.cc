@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2013-2023, OFFIS e.V.
+ *  Copyright (C) 2013-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -85,6 +85,7 @@ int main(int argc, char *argv[])
     OFCmdUnsignedInt opt_dimseTimeout = 0;
     OFCmdUnsignedInt opt_acseTimeout = 30;
     OFCmdUnsignedInt opt_maxPDULength = ASC_DEFAULTMAXPDU;
+    OFCmdUnsignedInt opt_maxAsyncOperations = 1;
     T_DIMSE_BlockingMode opt_blockingMode = DIMSE_BLOCKING;
 
     OFBool opt_showPresentationContexts = OFFalse;  // default: do not show presentation contexts in verbose mode
@@ -121,10 +122,12 @@ int main(int argc, char *argv[])
                                                           "timeout for ACSE messages");
         cmd.addOption("--dimse-timeout",       "-td",  1, "[s]econds: integer (default: unlimited)",
                                                           "timeout for DIMSE messages");
-        CONVERT_TO_STRING("[n]umber of bytes: integer (" << ASC_MINIMUMPDUSIZE << ".." << ASC_MAXIMUMPDUSIZE << ")", optString2);
+        CONVERT_TO_STRING("[n]umber of bytes: integer (" << ASC_MINIMUMPDUSIZE << ".." << ASC_LARGESTPDUSIZE << ")", optString2);
         CONVERT_TO_STRING("set max receive pdu to n bytes (default: " << opt_maxPDULength << ")", optString3);
         cmd.addOption("--max-pdu",             "-pdu", 1, optString2.c_str(),
                                                           optString3.c_str());
+        cmd.addOption("--max-async-ops",       "-mao", 1, "[n]umber of operations: integer (0..65535)",
+                                                          "accept asynchronous operations window of up to\nn outstanding C-STORE requests\n(0 = unlimited, default: 1)");
         cmd.addOption("--disable-host-lookup", "-dhl",    "disable hostname lookup");
 
     /* add TLS specific command line options if (and only if) we are compiling with OpenSSL */
@@ -209,7 +212,14 @@ int main(int argc, char *argv[])
             opt_blockingMode = DIMSE_NONBLOCKING;
         }
         if (cmd.findOption("--max-pdu"))
-            app.checkValue(cmd.getValueAndCheckMinMax(opt_maxPDULength, ASC_MINIMUMPDUSIZE, ASC_MAXIMUMPDUSIZE));
+        {
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_maxPDULength, ASC_MINIMUMPDUSIZE, ASC_LARGESTPDUSIZE));
+            /* larger PDUs require the library's PDU size limit to be raised */
+            if (opt_maxPDULength > dcmMaxPDUSizeLimit.get())
+                dcmMaxPDUSizeLimit.set(OFstatic_cast(Uint32, opt_maxPDULength));
+        }
+        if (cmd.findOption("--max-async-ops"))
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_maxAsyncOperations, 0, 65535));
         if (cmd.findOption("--disable-host-lookup"))
             opt_HostnameLookup = OFFalse;
 
@@ -278,6 +288,7 @@ int main(int argc, char *argv[])
     if (opt_aeTitle != NULL)
         storageSCP.setAETitle(opt_aeTitle);
     storageSCP.setMaxReceivePDULength(OFstatic_cast(Uint32, opt_maxPDULength));
+    storageSCP.setMaxOperationsInvoked(OFstatic_cast(Uint16, opt_maxAsyncOperations));
     storageSCP.setACSETimeout(OFstatic_cast(Uint32, opt_acseTimeout));
     storageSCP.setDIMSETimeout(OFstatic_cast(Uint32, opt_dimseTimeout));
     storageSCP.setDIMSEBlockingMode(opt_blockingMode);
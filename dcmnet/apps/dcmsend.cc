@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2018, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -120,6 +120,7 @@ int main(int argc, char *argv[])
     OFCmdUnsignedInt opt_acseTimeout = 30;
     OFCmdUnsignedInt opt_maxReceivePDULength = ASC_DEFAULTMAXPDU;
     OFCmdUnsignedInt opt_maxSendPDULength = 0;
+    OFCmdUnsignedInt opt_maxAsyncOperations = 1;
     T_DIMSE_BlockingMode opt_blockMode = DIMSE_BLOCKING;
 #ifdef WITH_ZLIB
     OFCmdUnsignedInt opt_compressionLevel = 0;
@@ -131,6 +132,7 @@ int main(int argc, char *argv[])
     OFBool opt_allowIllegalProposal = OFTrue;
     OFBool opt_checkUIDValues = OFTrue;
     OFBool opt_multipleAssociations = OFTrue;
+    OFCmdUnsignedInt opt_parallelAssociations = 1;
     DcmStorageSCU::E_DecompressionMode opt_decompressionMode = DcmStorageSCU::DM_losslessOnly;
 
     OFBool opt_dicomDir = OFFalse;
@@ -196,6 +198,10 @@ int main(int argc, char *argv[])
       cmd.addSubGroup("association handling:");
         cmd.addOption("--multi-associations",  "+ma",     "use multiple associations (one after the other)\nif needed to transfer the instances (default)");
         cmd.addOption("--single-association",  "-ma",     "always use a single association");
+#ifdef WITH_THREADS
+        cmd.addOption("--parallel-associations", "+pa", 1, "[n]umber of associations: integer (1..128)",
+                                                          "use up to n associations in parallel in order\nto transfer the instances (default: 1)");
+#endif
       cmd.addSubGroup("other network options:");
         cmd.addOption("--timeout",             "-to",  1, "[s]econds: integer (default: unlimited)",
                                                           "timeout for connection requests");
@@ -204,12 +210,14 @@ int main(int argc, char *argv[])
                                                           "timeout for ACSE messages");
         cmd.addOption("--dimse-timeout",       "-td",  1, "[s]econds: integer (default: unlimited)",
                                                           "timeout for DIMSE messages");
-        CONVERT_TO_STRING("[n]umber of bytes: integer (" << ASC_MINIMUMPDUSIZE << ".." << ASC_MAXIMUMPDUSIZE << ")", optString2);
+        CONVERT_TO_STRING("[n]umber of bytes: integer (" << ASC_MINIMUMPDUSIZE << ".." << ASC_LARGESTPDUSIZE << ")", optString2);
         CONVERT_TO_STRING("set max receive pdu to n bytes (default: " << opt_maxReceivePDULength << ")", optString3);
         cmd.addOption("--max-pdu",             "-pdu", 1, optString2.c_str(),
                                                           optString3.c_str());
         cmd.addOption("--max-send-pdu",                1, optString2.c_str(),
                                                           "restrict max send pdu to n bytes");
+        cmd.addOption("--max-async-ops",       "-mao", 1, "[n]umber of operations: integer (0..65535)",
+                                                          "propose asynchronous operations window, i.e. send\nup to n C-STORE requests without waiting for\nthe response (0 = unlimited, default: 1)");
     cmd.addGroup("output options:");
       cmd.addSubGroup("general:");
         cmd.addOption("--create-report-file",  "+crf", 1, "[f]ilename: string",
@@ -319,6 +327,13 @@ int main(int argc, char *argv[])
         if (cmd.findOption("--multi-associations")) opt_multipleAssociations = OFTrue;
         if (cmd.findOption("--single-association")) opt_multipleAssociations = OFFalse;
         cmd.endOptionBlock();
+#ifdef WITH_THREADS
+        if (cmd.findOption("--parallel-associations"))
+        {
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_parallelAssociations, 1, 128));
+            app.checkConflict("--parallel-associations", "--single-association", !opt_multipleAssociations);
+        }
+#endif
 
         if (cmd.findOption("--timeout"))
         {
@@ -333,12 +348,21 @@ int main(int argc, char *argv[])
             opt_blockMode = DIMSE_NONBLOCKING;
         }
         if (cmd.findOption("--max-pdu"))
-            app.checkValue(cmd.getValueAndCheckMinMax(opt_maxReceivePDULength, ASC_MINIMUMPDUSIZE, ASC_MAXIMUMPDUSIZE));
+        {
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_maxReceivePDULength, ASC_MINIMUMPDUSIZE, ASC_LARGESTPDUSIZE));
+            /* larger PDUs require the library's PDU size limit to be raised */
+            if (opt_maxReceivePDULength > dcmMaxPDUSizeLimit.get())
+                dcmMaxPDUSizeLimit.set(OFstatic_cast(Uint32, opt_maxReceivePDULength));
+        }
         if (cmd.findOption("--max-send-pdu"))
         {
-            app.checkValue(cmd.getValueAndCheckMinMax(opt_maxSendPDULength, ASC_MINIMUMPDUSIZE, ASC_MAXIMUMPDUSIZE));
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_maxSendPDULength, ASC_MINIMUMPDUSIZE, ASC_LARGESTPDUSIZE));
             dcmMaxOutgoingPDUSize.set(OFstatic_cast(Uint32, opt_maxSendPDULength));
+            if (opt_maxSendPDULength > dcmMaxPDUSizeLimit.get())
+                dcmMaxPDUSizeLimit.set(OFstatic_cast(Uint32, opt_maxSendPDULength));
         }
+        if (cmd.findOption("--max-async-ops"))
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_maxAsyncOperations, 0, 65535));
 
         /* output options */
         if (cmd.findOption("--create-report-file"))
@@ -449,6 +473,7 @@ int main(int argc, char *argv[])
     storageSCU.setPeerAETitle(opt_peerTitle);
     storageSCU.setAETitle(opt_ourTitle);
     storageSCU.setMaxReceivePDULength(OFstatic_cast(Uint32, opt_maxReceivePDULength));
+    storageSCU.setMaxOperationsInvoked(OFstatic_cast(Uint16, opt_maxAsyncOperations));
     storageSCU.setACSETimeout(OFstatic_cast(Uint32, opt_acseTimeout));
     storageSCU.setDIMSETimeout(OFstatic_cast(Uint32, opt_dimseTimeout));
     storageSCU.setDIMSEBlockingMode(opt_blockMode);
@@ -466,79 +491,92 @@ int main(int argc, char *argv[])
         OFLOG_DEBUG(dcmsendLogger, "only a single associations allowed (option --single-association used)");
     }
 
-    /* add presentation contexts to be negotiated (if there are still any) */
-    while ((status = storageSCU.addPresentationContexts()).good())
+    /* send SOP instances on multiple associations in parallel (if requested) */
+    if (opt_parallelAssociations > 1)
     {
-        if (opt_multipleAssociations)
-        {
-            /* output information on the start of the new association */
-            if (dcmsendLogger.isEnabledFor(OFLogger::DEBUG_LOG_LEVEL))
-            {
-                OFLOG_DEBUG(dcmsendLogger, OFString(65, '-') << OFendl
-                    << "starting association #" << (storageSCU.getAssociationCounter() + 1));
-            } else {
-                OFLOG_INFO(dcmsendLogger, "starting association #" << (storageSCU.getAssociationCounter() + 1));
-            }
-        }
-        OFLOG_INFO(dcmsendLogger, "initializing network ...");
-        /* initialize network */
-        status = storageSCU.initNetwork();
+        OFLOG_INFO(dcmsendLogger, "sending SOP instances on up to " << opt_parallelAssociations << " associations in parallel ...");
+        status = storageSCU.sendSOPInstancesInParallel(OFstatic_cast(size_t, opt_parallelAssociations));
         if (status.bad())
         {
-            OFLOG_FATAL(dcmsendLogger, "cannot initialize network: " << status.text());
+            OFLOG_FATAL(dcmsendLogger, "cannot send SOP instances: " << status.text());
             cleanup();
-            return EXITCODE_CANNOT_INITIALIZE_NETWORK;
+            return EXITCODE_CANNOT_SEND_REQUEST;
         }
-        OFLOG_INFO(dcmsendLogger, "negotiating network association ...");
-        /* negotiate network association with peer */
-        status = storageSCU.negotiateAssociation();
-        if (status.bad())
+    } else {
+        /* add presentation contexts to be negotiated (if there are still any) */
+        while ((status = storageSCU.addPresentationContexts()).good())
         {
-            // check whether we can continue with a new association
-            if (status == NET_EC_NoAcceptablePresentationContexts)
+            if (opt_multipleAssociations)
             {
-                OFLOG_ERROR(dcmsendLogger, "cannot negotiate network association: " << status.text());
-                // check whether there are any SOP instances to be sent
-                const size_t numToBeSent = storageSCU.getNumberOfSOPInstancesToBeSent();
-                if (numToBeSent > 0)
+                /* output information on the start of the new association */
+                if (dcmsendLogger.isEnabledFor(OFLogger::DEBUG_LOG_LEVEL))
                 {
-                    OFLOG_WARN(dcmsendLogger, "trying to continue with a new association "
-                        << "in order to send the remaining " << numToBeSent << " SOP instances");
+                    OFLOG_DEBUG(dcmsendLogger, OFString(65, '-') << OFendl
+                        << "starting association #" << (storageSCU.getAssociationCounter() + 1));
+                } else {
+                    OFLOG_INFO(dcmsendLogger, "starting association #" << (storageSCU.getAssociationCounter() + 1));
                 }
-            } else {
-                OFLOG_FATAL(dcmsendLogger, "cannot negotiate network association: " << status.text());
+            }
+            OFLOG_INFO(dcmsendLogger, "initializing network ...");
+            /* initialize network */
+            status = storageSCU.initNetwork();
+            if (status.bad())
+            {
+                OFLOG_FATAL(dcmsendLogger, "cannot initialize network: " << status.text());
                 cleanup();
-                return EXITCODE_CANNOT_NEGOTIATE_ASSOCIATION;
+                return EXITCODE_CANNOT_INITIALIZE_NETWORK;
             }
-        }
-        if (status.good())
-        {
-            OFLOG_INFO(dcmsendLogger, "sending SOP instances ...");
-            /* send SOP instances to be transferred */
-            status = storageSCU.sendSOPInstances();
+            OFLOG_INFO(dcmsendLogger, "negotiating network association ...");
+            /* negotiate network association with peer */
+            status = storageSCU.negotiateAssociation();
             if (status.bad())
             {
-                OFLOG_FATAL(dcmsendLogger, "cannot send SOP instance: " << status.text());
-                // handle certain error conditions (initiated by the communication peer)
-                if (status == DUL_PEERREQUESTEDRELEASE)
+                // check whether we can continue with a new association
+                if (status == NET_EC_NoAcceptablePresentationContexts)
                 {
-                    // peer requested release (aborting)
-                    storageSCU.closeAssociation(DCMSCU_PEER_REQUESTED_RELEASE);
+                    OFLOG_ERROR(dcmsendLogger, "cannot negotiate network association: " << status.text());
+                    // check whether there are any SOP instances to be sent
+                    const size_t numToBeSent = storageSCU.getNumberOfSOPInstancesToBeSent();
+                    if (numToBeSent > 0)
+                    {
+                        OFLOG_WARN(dcmsendLogger, "trying to continue with a new association "
+                            << "in order to send the remaining " << numToBeSent << " SOP instances");
+                    }
+                } else {
+                    OFLOG_FATAL(dcmsendLogger, "cannot negotiate network association: " << status.text());
+                    cleanup();
+                    return EXITCODE_CANNOT_NEGOTIATE_ASSOCIATION;
                 }
-                else if (status == DUL_PEERABORTEDASSOCIATION)
+            }
+            if (status.good())
+            {
+                OFLOG_INFO(dcmsendLogger, "sending SOP instances ...");
+                /* send SOP instances to be transferred */
+                status = storageSCU.sendSOPInstances();
+                if (status.bad())
                 {
-                    // peer aborted the association
-                    storageSCU.closeAssociation(DCMSCU_PEER_ABORTED_ASSOCIATION);
+                    OFLOG_FATAL(dcmsendLogger, "cannot send SOP instance: " << status.text());
+                    // handle certain error conditions (initiated by the communication peer)
+                    if (status == DUL_PEERREQUESTEDRELEASE)
+                    {
+                        // peer requested release (aborting)
+                        storageSCU.closeAssociation(DCMSCU_PEER_REQUESTED_RELEASE);
+                    }
+                    else if (status == DUL_PEERABORTEDASSOCIATION)
+                    {
+                        // peer aborted the association
+                        storageSCU.closeAssociation(DCMSCU_PEER_ABORTED_ASSOCIATION);
+                    }
+                    cleanup();
+                    return EXITCODE_CANNOT_SEND_REQUEST;
                 }
-                cleanup();
-                return EXITCODE_CANNOT_SEND_REQUEST;
             }
+            /* close current network association */
+            storageSCU.releaseAssociation();
+            /* check whether multiple associations are permitted */
+            if (!opt_multipleAssociations)
+                break;
         }
-        /* close current network association */
-        storageSCU.releaseAssociation();
-        /* check whether multiple associations are permitted */
-        if (!opt_multipleAssociations)
-            break;
     }
 
     /* if anything went wrong, report it to the logger */
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -105,12 +105,15 @@
 
 /*
  * There have been reports that smaller PDUs work better in some environments.
- * Allow a 4K minimum and a 128K maximum. Any further extension requires
- * modifications in the DUL code.
+ * Allow a 4K minimum and a 128K maximum by default. Larger PDUs can be enabled
+ * with the global dcmMaxPDUSizeLimit (see dul.h), up to ASC_LARGESTPDUSIZE.
+ * The protocol would permit up to 4G-1, but the association parameters store
+ * PDU sizes as (possibly 32-bit) long values, and the DUL needs even values.
  */
 #define ASC_DEFAULTMAXPDU       16384 /* 16K is default if nothing else specified */
 #define ASC_MINIMUMPDUSIZE       4096
-#define ASC_MAXIMUMPDUSIZE     131072 /* 128K - we only handle this big */
+#define ASC_MAXIMUMPDUSIZE     131072 /* 128K - default for dcmMaxPDUSizeLimit */
+#define ASC_LARGESTPDUSIZE 2147483646 /* 2G-2 - largest value for dcmMaxPDUSizeLimit */
 
 /*
 ** Type Definitions
@@ -396,6 +399,35 @@ ASC_printRejectParameters(
     OFString& str,
     const T_ASC_RejectParameters *rej);
 
+ /*
+  * Sets the Asynchronous Operations Window to be proposed in the A-ASSOCIATE-RQ
+  * (association requestor) or to be returned in the A-ASSOCIATE-AC (association
+  * acceptor).  A value of 0 stands for an unlimited number of outstanding
+  * operations.  The window is only sent if it differs from the default of one
+  * operation in each direction, and not at all if both values are 0 (which is
+  * also the initial setting).  An acceptor should never return values larger
+  * than the ones proposed by the requestor.
+  */
+DCMTK_DCMNET_EXPORT OFCondition
+ASC_setAsyncOperationsWindow(
+    T_ASC_Parameters * params,
+    unsigned short maxOpsInvoked,
+    unsigned short maxOpsPerformed);
+
+ /*
+  * Copies the Asynchronous Operations Window received from the peer into the
+  * supplied variables, i.e. the window accepted in the A-ASSOCIATE-AC
+  * (association requestor) or the window proposed in the A-ASSOCIATE-RQ
+  * (association acceptor).  If the peer did not send the sub-item, the default
+  * of one operation in each direction is returned.  The values are only valid
+  * after the association has been negotiated or received, respectively.
+  */
+DCMTK_DCMNET_EXPORT OFCondition
+ASC_getPeerAsyncOperationsWindow(
+    T_ASC_Parameters * params,
+    unsigned short *maxOpsInvoked,
+    unsigned short *maxOpsPerformed);
+
  /*
   * Adds a presentation context entry to the presentation context list.
   */
@@ -668,6 +700,19 @@ ASC_selectReadableAssociation(
     T_ASC_Association* assocs[],
     int assocCount, int timeout);
 
+/** Returns statistics on the data exchanged over the given association so far,
+ *  i.e. the number of bytes received and sent, and the time spent receiving and
+ *  sending PDUs. The throughput of the association can be determined from these
+ *  values, e.g. bytesReceived / receiveTime.
+ *  @param association - [in] The association
+ *  @param statistics - [out] The statistics
+ *  @return EC_Normal if successful, an error code otherwise
+ */
+DCMTK_DCMNET_EXPORT OFCondition
+ASC_getAssociationStatistics(
+    T_ASC_Association * association,
+    DUL_ASSOCIATIONSTATISTICS * statistics);
+
 /*
  * Association Messages
  */
@@ -693,6 +738,56 @@ ASC_receiveAssociation(
     DUL_BLOCKOPTIONS block=DUL_BLOCK,
     int timeout=0);
 
+/** Accepts an incoming transport connection, which is the first part of
+ *  ASC_receiveAssociation(). Nothing is read from the new connection and the
+ *  peer is not identified (i.e. no reverse DNS lookup is performed), so this
+ *  function does not wait for the peer once a connection is pending. The
+ *  association request must then be received by calling
+ *  ASC_receiveAssociationRequest(), e.g. as soon as data is available on the
+ *  transport connection.
+ *  @param network - [in] The network to accept the connection from
+ *  @param association - [out] The new association, must be destroyed by the
+ *    caller (even if an error is returned), unless it is NULL
+ *  @param maxReceivePDUSize - [in] Maximum PDU size to receive
+ *  @param retrieveRawPDU - [in] If OFTrue, the raw association request PDU
+ *    can be retrieved by ASC_receiveAssociationRequest()
+ *  @param useSecureLayer - [in] If OFTrue, the connection is secured by the
+ *    transport layer of the network
+ *  @param block - [in] Blocking mode for waiting for a connection
+ *  @param timeout - [in] Timeout in seconds in non-blocking mode
+ *  @return EC_Normal if a connection was accepted, DUL_NOASSOCIATIONREQUEST
+ *    if no connection is pending, another error code otherwise
+ */
+DCMTK_DCMNET_EXPORT OFCondition
+ASC_acceptTransportConnection(
+    T_ASC_Network * network,
+    T_ASC_Association ** association,
+    long maxReceivePDUSize,
+    OFBool retrieveRawPDU=OFFalse,
+    OFBool useSecureLayer=OFFalse,
+    DUL_BLOCKOPTIONS block=DUL_BLOCK,
+    int timeout=0);
+
+/** Receives the association request on a transport connection that has been
+ *  accepted by ASC_acceptTransportConnection(), which is the second part of
+ *  ASC_receiveAssociation(). This also identifies the peer and performs the
+ *  handshake of the secure transport layer, if any. Waits at most for the
+ *  ACSE timeout of the network.
+ *  @param network - [in] The network the connection was accepted from
+ *  @param association - [in/out] The association
+ *  @param associatePDU - [out] The raw association request PDU, if requested
+ *    by ASC_acceptTransportConnection()
+ *  @param associatePDUlength - [out] The length of the raw PDU
+ *  @return EC_Normal if the association request was received, an error code
+ *    otherwise
+ */
+DCMTK_DCMNET_EXPORT OFCondition
+ASC_receiveAssociationRequest(
+    T_ASC_Network * network,
+    T_ASC_Association * association,
+    void **associatePDU=NULL,
+    unsigned long *associatePDUlength=NULL);
+
 DCMTK_DCMNET_EXPORT OFCondition
 ASC_acknowledgeAssociation(
     T_ASC_Association * assoc,
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1998-2022, OFFIS e.V.
+ *  Copyright (C) 1998-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -59,6 +59,18 @@ extern DCMTK_DCMNET_EXPORT OFGlobal<Sint32> dcmSocketSendTimeout;   /* default:
  */
 extern DCMTK_DCMNET_EXPORT OFGlobal<Sint32> dcmSocketReceiveTimeout;   /* default: 60 */
 
+/** a contiguous block of data that is passed to
+ *  DcmTransportConnection::writeBuffers()
+ */
+struct DCMTK_DCMNET_EXPORT DcmTransportBuffer
+{
+  /// pointer to the data
+  void *data;
+
+  /// number of bytes of data
+  size_t length;
+};
+
 /** this class represents a TCP/IP based transport connection
  *  which can be a transparent TCP/IP socket communication or a
  *  secure transport protocol such as TLS.
@@ -116,6 +128,18 @@ public:
    */
   virtual ssize_t write(void *buf, size_t nbyte) = 0;
 
+  /** attempts to write the given sequence of buffers to the transport
+   *  connection, as if they had been concatenated into a single buffer.
+   *  The default implementation calls write() for each buffer and stops at
+   *  the first buffer that could not be written completely. Derived classes
+   *  may use a single gather write operation instead.
+   *  @param buffers array of buffers
+   *  @param count number of entries in the buffers array
+   *  @return number of bytes written, which may be less than the total length
+   *    of all buffers, negative number if unsuccessful.
+   */
+  virtual ssize_t writeBuffers(const DcmTransportBuffer *buffers, size_t count);
+
   /** Closes the transport connection. If a secure connection
    *  is used, a closure alert is sent before the connection
    *  is closed. Abstract method.
@@ -197,13 +221,15 @@ public:
    */
   static OFBool selectReadableAssociation(DcmTransportConnection *connections[], int connCount, int timeout);
 
-protected:
-
-  /** returns the socket file descriptor managed by this object.
+  /** returns the socket file descriptor managed by this object, e.g.\ for
+   *  watching the connection in an event loop. The socket must not be used
+   *  for reading or writing, and must not be closed by the caller.
    *  @return socket file descriptor
    */
   DcmNativeSocketType getSocket() { return theSocket; }
 
+protected:
+
   /** set the socket file descriptor managed by this object.
    *  @param socket file descriptor
    */
@@ -321,6 +347,16 @@ public:
    */
   virtual ssize_t write(void *buf, size_t nbyte);
 
+  /** attempts to write the given sequence of buffers to the transport
+   *  connection with a single gather write operation (writev() or WSASend()),
+   *  as if they had been concatenated into a single buffer.
+   *  @param buffers array of buffers
+   *  @param count number of entries in the buffers array
+   *  @return number of bytes written, which may be less than the total length
+   *    of all buffers, negative number if unsuccessful.
+   */
+  virtual ssize_t writeBuffers(const DcmTransportBuffer *buffers, size_t count);
+
   /** Closes the transport connection. If a secure connection
    *  is used, a closure alert is sent before the connection
    *  is closed.
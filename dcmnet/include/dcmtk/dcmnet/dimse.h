@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -119,6 +119,14 @@ extern DCMTK_DCMNET_EXPORT OFGlobal<OFBool> dcmPeerRequiresExactUIDCopy; /* defa
  */
 extern DCMTK_DCMNET_EXPORT OFGlobal<Uint32> dcmMaxOutgoingPDUSize; /* default 2^32-1 */
 
+/** size (in bytes) of the buffer used by DIMSE_receiveDataSetInFile(). The data
+ *  fragments of incoming PDVs are received directly into this buffer, without
+ *  being copied from the PDU buffer of the DUL layer, and the buffer is written
+ *  to the output stream when it is full. A value of 0 disables the buffer, in
+ *  which case each PDV is read into the PDU buffer and written separately.
+ */
+extern DCMTK_DCMNET_EXPORT OFGlobal<Uint32> dcmReceiveDataSetBufferSize; /* default 256 kBytes */
+
 
 /*
  * General Status Codes.
@@ -1240,6 +1248,7 @@ DIMSE_createFilestream(
                      DcmOutputFileStream **filestream);
 
 /** receive one data set (of instance data) via network from another DICOM application and store in file.
+ *  The data is collected in a buffer of size dcmReceiveDataSetBufferSize before being written.
  *  @param assoc           The association (network connection to another DICOM application).
  *  @param blocking        The blocking mode for receiving data (either DIMSE_BLOCKING or DIMSE_NONBLOCKING)
  *  @param timeout         Timeout interval for receiving data (if the blocking mode is DIMSE_NONBLOCKING).
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2018, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -25,6 +25,7 @@
 #include "dcmtk/config/osconfig.h"  /* make sure OS specific configuration is included first */
 
 #include "dcmtk/dcmnet/scu.h"       /* for base class DcmSCU */
+#include "dcmtk/ofstd/ofmap.h"      /* for class OFMap */
 
 
 /*---------------------*
@@ -332,10 +333,42 @@ class DCMTK_DCMNET_EXPORT DcmStorageSCU
      *  The sending process can be stopped by overwriting shouldStopAfterCurrentSOPInstance()
      *  in a derived class.  The sending process can be continued with the next SOP instance
      *  by calling sendSOPInstances() again.
+     *  If an asynchronous operations window has been negotiated (see
+     *  DcmSCU::setMaxOperationsInvoked()), the next SOP instance is loaded and sent without
+     *  waiting for the response to the previous C-STORE request, as long as the number of
+     *  outstanding requests does not exceed the negotiated window.  The responses are matched
+     *  with the requests by means of their message ID, and notifySOPInstanceSent() is called
+     *  when the response is received.  All outstanding responses are received before this
+     *  method returns; if the association fails in the meantime, the SOP instances concerned
+     *  are reported as sent without a response.
      *  @return status, EC_Normal if successful, an error code otherwise
      */
     OFCondition sendSOPInstances();
 
+    /** send all SOP instances from the transfer list that have not yet been sent to the
+     *  specified peer using a number of associations in parallel.  The SOP instances to be
+     *  sent are partitioned into consecutive parts of about the same size (so studies and
+     *  series are not split up unnecessarily), and each part is sent by a separate thread on
+     *  its own association(s).  For each of these associations, only the presentation
+     *  contexts needed for the SOP instances of the respective part are proposed (see
+     *  addPresentationContexts()).  The network parameters and modes of this object are used
+     *  for all associations, and the association counter is increased for each of them, so
+     *  the status summary and the report file also cover the parallel transfer.
+     *  If an association fails (e.g. because it is rejected or aborted by the peer), the SOP
+     *  instances of this part that have not been sent or for which no response has been
+     *  received are sent again on the remaining associations that did not fail.  This is
+     *  repeated until all SOP instances have been sent or no association is left.
+     *  The virtual methods notifySOPInstanceToBeSent(), notifySOPInstanceSent() and
+     *  shouldStopAfterCurrentSOPInstance() are called from the sending threads, but never at
+     *  the same time.  For SOP instances that are sent again, they are called again.
+     *  @note This method is only available if DCMTK has been compiled with thread support.
+     *    Secure connections (TLS) are not supported, and this object must not be connected
+     *    to the peer when calling this method.
+     *  @param  numAssociations  maximum number of associations to be used in parallel
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition sendSOPInstancesInParallel(const size_t numAssociations);
+
     /** get some status information on the overall sending process.  This text can for example
      *  be output to the logger (on the level at the user's option).
      *  @param  summary  reference to a string in which the summary is stored
@@ -510,6 +543,21 @@ class DCMTK_DCMNET_EXPORT DcmStorageSCU
 
   private:
 
+    /// internal class sending a part of the transfer list in a separate thread
+    class ParallelWorker;
+
+    /** receive responses to C-STORE requests that have been sent asynchronously.  The
+     *  responses that are already available are always received, and the method waits for
+     *  further responses until no more than the given number of requests is outstanding.
+     *  @param  outstandingRequests  map of message IDs and transfer entries of the C-STORE
+     *                               requests that have not yet been responded to.  Entries
+     *                               are removed from the map as soon as the response arrives.
+     *  @param  maxOutstanding       maximum number of requests that may remain outstanding
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition receiveSTOREResponses(OFMap<Uint16, TransferEntry *> &outstandingRequests,
+                                      const size_t maxOutstanding);
+
     /// association counter
     unsigned long AssociationCounter;
     /// presentation context counter
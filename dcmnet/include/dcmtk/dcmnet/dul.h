@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -130,6 +130,16 @@ extern DCMTK_DCMNET_EXPORT OFGlobal<unsigned long> dcmEnableBackwardCompatibilit
  */
 extern DCMTK_DCMNET_EXPORT OFGlobal<size_t> dcmAssociatePDUSizeLimit;   /* default: 1 MB */
 
+/** Upper limit (in bytes) for the maximum PDU size. This limit applies to the
+ *  maximum length of P-DATA-TF PDUs that we offer to receive, which determines
+ *  the size of the PDU buffer allocated for each association, and to the size
+ *  of the buffer used for sending P-DATA-TF PDUs if the peer accepts larger
+ *  (or unlimited) PDUs.  The default is ASC_MAXIMUMPDUSIZE (128 kBytes).
+ *  Values up to ASC_LARGESTPDUSIZE may be used for fast networks, at the
+ *  expense of memory per association.
+ */
+extern DCMTK_DCMNET_EXPORT OFGlobal<Uint32> dcmMaxPDUSizeLimit;   /* default: 128 kBytes */
+
 typedef void DUL_NETWORKKEY;
 typedef void DUL_ASSOCIATIONKEY;
 typedef unsigned char DUL_PRESENTATIONCONTEXTID;
@@ -196,6 +206,8 @@ typedef struct {
     char calledImplementationClassUID[DICOM_UI_LENGTH + 1];
     char calledImplementationVersionName[16 + 1];
     unsigned long peerMaxPDU;
+    unsigned short peerMaximumOperationsInvoked;
+    unsigned short peerMaximumOperationsPerformed;
     SOPClassExtendedNegotiationSubItemList *requestedExtNegList;
     SOPClassExtendedNegotiationSubItemList *acceptedExtNegList;
     UserIdentityNegotiationSubItemRQ *reqUserIdentNeg;
@@ -313,6 +325,22 @@ typedef struct {
     DUL_PDV *pdv;
 }   DUL_PDVLIST;
 
+/** statistics on the data exchanged over an association,
+ *  see DUL_getAssociationStatistics()
+ */
+typedef struct {
+    /// number of bytes received on the transport connection, including PDU headers
+    Uint64 bytesReceived;
+    /// number of bytes sent on the transport connection, including PDU headers
+    Uint64 bytesSent;
+    /** time in seconds spent receiving the content of PDUs. The time spent
+     *  waiting for the next PDU to arrive is not included.
+     */
+    double receiveTime;
+    /// time in seconds spent sending PDUs
+    double sendTime;
+}   DUL_ASSOCIATIONSTATISTICS;
+
 /*  Define the bits that go in the options field for InitializeNetwork
 **
 **  The low two bits define the byte order of messages at the DICOM
@@ -438,6 +466,21 @@ DUL_ReceiveAssociationRQ(
   DUL_ASSOCIATIONKEY ** association,
   int activatePDUStorage);
 
+DCMTK_DCMNET_EXPORT OFCondition
+DUL_AcceptTransportConnection(
+  DUL_NETWORKKEY ** network,
+  DUL_BLOCKOPTIONS block,
+  int timeout,
+  DUL_ASSOCIATESERVICEPARAMETERS * parameters,
+  DUL_ASSOCIATIONKEY ** association,
+  int activatePDUStorage);
+
+DCMTK_DCMNET_EXPORT OFCondition
+DUL_ReadAssociationRQ(
+  DUL_NETWORKKEY ** network,
+  DUL_ASSOCIATESERVICEPARAMETERS * parameters,
+  DUL_ASSOCIATIONKEY ** association);
+
 DCMTK_DCMNET_EXPORT OFCondition
 DUL_RejectAssociationRQ(
   DUL_ASSOCIATIONKEY ** association,
@@ -472,6 +515,15 @@ DUL_WritePDVs(DUL_ASSOCIATIONKEY ** association,
         DUL_PDVLIST * pdvList);
 DCMTK_DCMNET_EXPORT OFCondition DUL_NextPDV(DUL_ASSOCIATIONKEY ** association, DUL_PDV * pdv);
 
+/* receives the data fragment of the next data set PDV directly into the
+** caller's buffer instead of the association's PDU buffer, see dul.cc
+*/
+DCMTK_DCMNET_EXPORT OFCondition
+DUL_ReadPDVFragment(DUL_ASSOCIATIONKEY ** association,
+       DUL_BLOCKOPTIONS block, int timeout,
+       DUL_PRESENTATIONCONTEXTID presentationContextID,
+       void *buffer, unsigned long bufferLength, DUL_PDV * pdv);
+
 
 /* Miscellaneous functions.
 */
@@ -499,6 +551,58 @@ DCMTK_DCMNET_EXPORT OFString& dumpExtNegList(OFString& str, SOPClassExtendedNego
 DCMTK_DCMNET_EXPORT OFBool
 DUL_dataWaiting(DUL_ASSOCIATIONKEY * callerAssociation, int timeout);
 
+/* returns OFTrue if bytes of the next PDU have already been received
+ * ahead of time and are buffered by the association, i.e. data that is not
+ * visible on the network connection anymore. Unlike DUL_dataWaiting(), this
+ * never checks the network connection.
+ */
+DCMTK_DCMNET_EXPORT OFBool
+DUL_bufferedDataWaiting(DUL_ASSOCIATIONKEY * callerAssociation);
+
+/* receives the bytes that are available on the network connection of the
+ * association without waiting, and buffers them in the association until
+ * they are requested by the next read operation. At most maxLength bytes are
+ * buffered in total. Only supported for transparent (i.e. not TLS secured)
+ * connections, since a TLS connection may block until a complete record
+ * has been received. Returns DUL_NETWORKCLOSED if the peer closed the
+ * connection, and DUL_ILLEGALREQUEST if the connection is not transparent.
+ */
+DCMTK_DCMNET_EXPORT OFCondition
+DUL_receiveAvailableData(DUL_ASSOCIATIONKEY * callerAssociation,
+       unsigned long maxLength);
+
+/* returns the number of bytes of the next PDUs that have already been
+ * received and are buffered by the association.
+ */
+DCMTK_DCMNET_EXPORT unsigned long
+DUL_bufferedDataLength(DUL_ASSOCIATIONKEY * callerAssociation);
+
+/* returns OFTrue if the bytes buffered by the association comprise a
+ * complete DIMSE message, i.e. a command without data set, or a command
+ * followed by the last fragment of its data set, or any other complete PDU
+ * (e.g. A-ASSOCIATE-RQ, A-RELEASE-RQ or A-ABORT). Malformed PDUs are also
+ * reported as complete, in order to let the next read operation fail.
+ * The unprocessed PDVs of the PDU most recently read (see DUL_unprocessedPDVs())
+ * are considered to be the start of the message. The buffered bytes must start
+ * at a PDU boundary, i.e. no PDU may have been read partially.
+ */
+DCMTK_DCMNET_EXPORT OFBool
+DUL_bufferedMessageComplete(DUL_ASSOCIATIONKEY * callerAssociation);
+
+/* returns OFTrue if the PDU most recently read on the association still
+ * contains PDVs that have not been processed yet, i.e. data that is not
+ * visible on the network connection anymore.
+ */
+DCMTK_DCMNET_EXPORT OFBool
+DUL_unprocessedPDVs(DUL_ASSOCIATIONKEY * callerAssociation);
+
+/* copies the statistics on the data exchanged over the association so far
+ * into the given structure. Returns OFFalse if the association is invalid.
+ */
+DCMTK_DCMNET_EXPORT OFBool
+DUL_getAssociationStatistics(DUL_ASSOCIATIONKEY * callerAssociation,
+       DUL_ASSOCIATIONSTATISTICS * statistics);
+
 DCMTK_DCMNET_EXPORT DcmNativeSocketType DUL_networkSocket(DUL_NETWORKKEY * callerNet);
 
 DCMTK_DCMNET_EXPORT OFBool
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2017, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -152,6 +152,16 @@ typedef struct {
     unsigned long fragmentBufferLength;
     unsigned char *fragmentBuffer;
     DUL_ModeCallback *modeCallback;
+    unsigned char lookahead[12];        /* bytes received ahead of the current read request */
+    unsigned long lookaheadLength;
+    unsigned char *receiveBuffer;       /* bytes received ahead of time by DUL_receiveAvailableData() */
+    unsigned long receiveBufferSize;
+    unsigned long receiveBufferLength;
+    unsigned long receiveBufferOffset;
+    unsigned long directPDULength;      /* unread bytes of the P-DATA-TF PDU that is received by DUL_ReadPDVFragment() */
+    unsigned long directFragmentLength; /* unread bytes of the data fragment of the current PDV in that PDU */
+    DUL_PDV directPDV;                  /* header information of the current PDV in that PDU */
+    DUL_ASSOCIATIONSTATISTICS statistics;
 }   PRIVATE_ASSOCIATIONKEY;
 
 #define KEY_NETWORK "KEY NETWORK"
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2009-2023, OFFIS e.V.
+ *  Copyright (C) 2009-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -284,10 +284,19 @@ public:
 
     /** Set maximum PDU size the SCP is able to receive. This size is sent in association
      *  response message to SCU.
+     *  Values larger than the global dcmMaxPDUSizeLimit (default: 128 kBytes)
+     *  cause the association negotiation to fail.
      *  @param maxRecPDU [in] The maximum PDU size to use in bytes
      */
     void setMaxReceivePDULength(const Uint32 maxRecPDU);
 
+    /** Set the maximum number of outstanding operations the SCU may invoke asynchronously.
+     *  If the SCU proposes an asynchronous operations window, the smaller of the proposed
+     *  and this value is accepted. DcmSCP's default is 1, i.e. no asynchronous operations.
+     *  @param maxOps [in] The maximum number of operations invoked, 0 means unlimited
+     */
+    void setMaxOperationsInvoked(const Uint16 maxOps);
+
     /** Set whether waiting for a TCP/IP connection should be blocking or non-blocking.
      *  In non-blocking mode, the networking routines will wait for specified connection
      *  timeout, see setConnectionTimeout() function. In blocking mode, no timeout is set
@@ -389,6 +398,11 @@ public:
      */
     Uint32 getMaxReceivePDULength() const;
 
+    /** Returns the maximum number of outstanding operations the SCU may invoke asynchronously
+     *  @return Maximum number of operations invoked, 0 means unlimited
+     */
+    Uint16 getMaxOperationsInvoked() const;
+
     /** Returns whether receiving of TCP/IP connection requests is done in blocking or
      *  unblocking mode
      *  @return DUL_BLOCK if in blocking mode, otherwise DUL_NOBLOCK
@@ -1025,6 +1039,16 @@ protected:
      */
     virtual OFCondition processAssociationRQ();
 
+    /** Evaluate the association request received on the current association, i.e.\ negotiate
+     *  the presentation contexts and either acknowledge or refuse the request. In contrast to
+     *  processAssociationRQ(), no DIMSE commands are handled by this function.
+     *  @param accepted [out] OFTrue if the association was acknowledged, OFFalse if it was
+     *                        refused (or if an error occurred)
+     *  @return EC_Normal if association could be processed, ASC_NULLKEY otherwise
+     *          (only if internal association structure is invalid, should never happen)
+     */
+    virtual OFCondition acceptOrRefuseAssociation(OFBool& accepted);
+
     /** This function checks all presentation contexts proposed by the SCU whether they are
      *  supported or not. It is not an error if no common presentation context could be
      *  identified with the SCU; only issues like problems in memory management etc. are
@@ -1045,6 +1069,22 @@ protected:
      */
     virtual void handleAssociation();
 
+    /** Receive a single DIMSE command on the current association and handle it by calling
+     *  handleIncomingCommand(). The DIMSE blocking mode and timeout of the SCP configuration
+     *  are used for receiving the command.
+     *  @return EC_Normal if a command was received and handled successfully, an error code
+     *          otherwise, e.g.\ DUL_PEERREQUESTEDRELEASE or DUL_PEERABORTEDASSOCIATION if the
+     *          peer released or aborted the association
+     */
+    virtual OFCondition receiveAndHandleCommand();
+
+    /** Clean up on termination of the current association, i.e.\ acknowledge a release
+     *  request of the peer or abort the association in case of an error. The association
+     *  itself is neither dropped nor destroyed.
+     *  @param cond [in] The condition returned by the last call of receiveAndHandleCommand()
+     */
+    virtual void handleAssociationTermination(const OFCondition& cond);
+
     /** Send a DIMSE command and possibly also a dataset from a data object via network to
      *  another DICOM application
      *  @param presID          [in]  Presentation context ID to be used for message
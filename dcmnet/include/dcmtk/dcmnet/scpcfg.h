@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2012-2022, OFFIS e.V.
+ *  Copyright (C) 2012-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -149,10 +149,22 @@ public:
 
   /** Set maximum PDU size the SCP is able to receive. This size is sent in association
    *  response message to SCU.
+   *  Values larger than the global dcmMaxPDUSizeLimit (default: 128 kBytes)
+   *  cause the association negotiation to fail.
    *  @param maxRecPDU [in] The maximum PDU size to use in bytes
    */
   void setMaxReceivePDULength(const Uint32 maxRecPDU);
 
+  /** Set the maximum number of outstanding operations the SCU may invoke asynchronously,
+   *  i.e.\ without waiting for the response to the previous request. If the SCU proposes
+   *  an asynchronous operations window, the SCP accepts the smaller of the proposed and
+   *  this value. Since the SCP processes the requests one after the other, the number of
+   *  operations performed is always limited to 1.
+   *  @param maxOps [in] The maximum number of operations invoked, 0 means unlimited.
+   *                     DcmSCP's default is 1, i.e. no asynchronous operations.
+   */
+  void setMaxOperationsInvoked(const Uint16 maxOps);
+
   /** Set whether waiting for a TCP/IP connection should be blocking or non-blocking.
    *  In non-blocking mode, the networking routines will wait for specified connection
    *  timeout, see setConnectionTimeout() function. In blocking mode, no timeout is set
@@ -255,6 +267,11 @@ public:
    */
   Uint32 getMaxReceivePDULength() const;
 
+  /** Returns the maximum number of outstanding operations the SCU may invoke asynchronously
+   *  @return Maximum number of operations invoked, 0 means unlimited
+   */
+  Uint16 getMaxOperationsInvoked() const;
+
   /** Returns whether receiving of TCP/IP connection requests is done in blocking or
    *  unblocking mode
    *  @return DUL_BLOCK if in blocking mode, otherwise DUL_NOBLOCK
@@ -377,6 +394,11 @@ protected:
   /// association negotiation.
   Uint32 m_maxReceivePDULength;
 
+  /// Maximum number of outstanding operations the SCU may invoke asynchronously
+  /// (0 = unlimited). This value limits the asynchronous operations window accepted
+  /// during association negotiation.
+  Uint16 m_maxOperationsInvoked;
+
   /// Blocking mode for TCP/IP connection requests. If non-blocking mode is enabled, the SCP is
   /// waiting for new DIMSE data a specific (m_connectionTimeout) amount of time and then returns
   /// if not data arrives. In blocking mode, the SCP is calling the underlying operating
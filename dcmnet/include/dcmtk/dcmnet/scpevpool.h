@@ -0,0 +1,456 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmnet
+ *
+ *  Author:  agent
+ *
+ *  Purpose: Class listening for association requests and multiplexing all
+ *           incoming associations over a single event loop, with a bounded
+ *           pool of worker threads that only handle associations for which
+ *           a DIMSE message has been received.
+ *
+ */
+
+#ifndef SCPEVPOOL_H
+#define SCPEVPOOL_H
+
+#include "dcmtk/config/osconfig.h"  /* make sure OS specific configuration is included first */
+
+// Without threads this does not make sense, and the event loop needs POSIX pipes
+#if defined(WITH_THREADS) && !defined(_WIN32)
+
+#include "dcmtk/ofstd/ofthread.h"
+#include "dcmtk/ofstd/oflist.h"
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/dcmnet/scpthrd.h"
+#include "dcmtk/dcmnet/scpcfg.h"
+#include "dcmtk/dcmnet/assoc.h"
+
+/** Base class for implementing an event-driven SCP pool. In contrast to
+ *  DcmBaseSCPPool, where every association occupies its own worker thread
+ *  for its complete lifetime, all associations are multiplexed over a single
+ *  event loop (based on epoll() where available, and on poll() or select()
+ *  otherwise), which is run by the thread calling listen(). The event loop
+ *  only accepts new TCP connections and receives the data available on the
+ *  associations without blocking. Only when a complete DIMSE message has been
+ *  received on an association, the association is handed to one of a fixed
+ *  number of worker threads, which handles that message (and any further
+ *  message that is already complete) and then hands the association back to
+ *  the event loop. Thus, the number of simultaneous associations is not
+ *  limited by the number of threads, idle associations do not consume any
+ *  thread at all, and peers that send their messages slowly cannot block the
+ *  worker threads. Likewise, a new association is handed to a worker thread
+ *  for negotiation as soon as its association request has been received
+ *  completely, which has to happen within the ACSE timeout.
+ *  Messages that exceed the buffer of the event loop (i.e. 1 MB or the
+ *  maximum receive PDU size, whichever is larger), as well as all data on TLS
+ *  secured connections, which cannot be read without blocking, are received
+ *  by the worker thread. These reads are only limited by the DIMSE timeout
+ *  (or the ACSE timeout, respectively) in non-blocking DIMSE mode.
+ *  This base class is abstract.
+ *  @remark This class is only available if DCMTK is compiled with thread
+ *    support enabled, and not on Windows.
+ */
+class DCMTK_DCMNET_EXPORT DcmBaseSCPEventPool
+{
+public:
+
+  /** Abstract base class for the objects handling a single association
+   *  within the event-driven pool. Other than the workers of DcmBaseSCPPool,
+   *  a handler is not a thread; its methods are called by any of the worker
+   *  threads of the pool (but never by more than one thread at a time).
+   */
+  class DCMTK_DCMNET_EXPORT DcmBaseSCPHandler
+  {
+    public:
+
+      /** Virtual Destructor
+       */
+      virtual ~DcmBaseSCPHandler();
+
+      /** Set SCP configuration that should be used by the handler in order
+       *  to handle the incoming association request (presentation contexts,
+       *  etc.).
+       *  @param config A DcmSharedSCPConfig object to be used by this handler.
+       *  @return EC_Normal, if configuration is accepted, error code
+       *          otherwise.
+       */
+      virtual OFCondition setSharedConfig(const DcmSharedSCPConfig& config) = 0;
+
+      /** Negotiate the given association, i.e.\ acknowledge or refuse it.
+       *  The handler takes over responsibility for the association, including
+       *  freeing the memory of the T_ASC_Association struct, which has to take
+       *  place in this function if the association is refused, and in
+       *  finishAssociation() otherwise.
+       *  @param assoc Pointer to the association that should be handled.
+       *         Must not be NULL.
+       *  @param acknowledged OFTrue if the association was acknowledged,
+       *         OFFalse otherwise.
+       *  @return EC_Normal if association was handled properly, an error code
+       *          only in case of connection or messaging errors.
+       */
+      virtual OFCondition startAssociation(T_ASC_Association* assoc, OFBool& acknowledged) = 0;
+
+      /** Receive and handle the next DIMSE message on the association. This
+       *  function is only called if the message has been received completely
+       *  (or exceeds the buffer of the event loop, or data is available on a
+       *  TLS secured association).
+       *  @return EC_Normal if the message was handled and the association
+       *          continues, an error code otherwise, e.g. in case the peer
+       *          released or aborted the association.
+       */
+      virtual OFCondition processCommand() = 0;
+
+      /** Finish the association (e.g.\ acknowledge the release request of
+       *  the peer or abort the association in case of an error), and drop
+       *  and destroy it.
+       *  @param cond The condition that ended the association.
+       */
+      virtual void finishAssociation(const OFCondition& cond) = 0;
+
+    protected:
+
+      /** Protected constructor which is called by the pool in order to
+       *  create a handler.
+       */
+      DcmBaseSCPHandler();
+  };
+
+  /** Virtual destructor, frees internal memory.
+   */
+  virtual ~DcmBaseSCPEventPool();
+
+  /** Set the number of worker threads handling DIMSE messages.
+   *  @param maxWorkers Number of worker threads, at least 1.
+   */
+  virtual void setMaxThreads(const Uint16 maxWorkers);
+
+  /** Get the number of worker threads handling DIMSE messages.
+   *  @return Number of worker threads.
+   */
+  virtual Uint16 getMaxThreads();
+
+  /** Set the number of maximum permitted simultaneous associations. Further
+   *  association requests are rejected with reason "local limit exceeded".
+   *  @param maxAssociations Number of associations permitted at a time.
+   */
+  virtual void setMaxAssociations(const Uint16 maxAssociations);
+
+  /** Get the number of maximum permitted simultaneous associations.
+   *  @return Number of associations permitted at a time.
+   */
+  virtual Uint16 getMaxAssociations();
+
+  /** Get number of currently active associations.
+   *  @return Number of associations currently handled within pool, including
+   *          those that are still being negotiated and those whose association
+   *          request has not been received yet.
+   */
+  virtual size_t numAssociations();
+
+  /** Listen for incoming association requests and run the event loop, which
+   *  dispatches all associations to the worker threads, until
+   *  stopAfterCurrentAssociations() is called and all associations have
+   *  ended.
+   *  @return EC_Normal after the event loop was stopped, an error code if the
+   *          network or the event loop could not be initialized or the worker
+   *          threads could not be started.
+   */
+  virtual OFCondition listen();
+
+  /** Return handle to the SCP configuration that is used to configure how to
+   *  handle incoming associations. The configuration must not be changed
+   *  while listen() is running.
+   *  @return The SCP configuration.
+   */
+  virtual DcmSCPConfig& getConfig();
+
+  /** If called, the pool stops accepting new associations and returns from
+   *  listen() as soon as all current associations have ended. This function
+   *  can be called from any thread.
+   */
+  virtual void stopAfterCurrentAssociations();
+
+protected:
+
+  /** Constructor. Initializes internal member variables.
+   */
+  DcmBaseSCPEventPool();
+
+  /** Create a handler for a new association.
+   *  @return The handler created
+   */
+  virtual DcmBaseSCPHandler* createSCPHandler() = 0;
+
+  /** Drops association and clears internal structures to free memory
+   *  @param assoc The association to free
+   */
+  virtual void dropAndDestroyAssociation(T_ASC_Association* assoc);
+
+  /** Reject association using the given reason, e.g.\ because maximum number
+   *  of associations is currently already served.
+   *  @param assoc The association to reject
+   *  @param reason The rejection reason
+   */
+  void rejectAssociation(T_ASC_Association* assoc,
+                         const T_ASC_RejectParametersReason& reason);
+
+  /** Initialize network, i.e. create an instance of T_ASC_Network and set
+   *  transport layer if it is enabled.
+   *  @param network The T_ASC_Network pointer to create the instance
+   *  @return EC_Normal if there were no errors during initialization.
+   */
+  virtual OFCondition initializeNetwork(T_ASC_Network** network);
+
+private:
+
+  /// State of an association handled by the pool (defined in scpevpool.cc)
+  struct AssociationEntry;
+
+  /// Worker thread handling DIMSE messages (defined in scpevpool.cc)
+  class DcmSCPEventWorker;
+
+  // Needed to keep MS VC6 happy
+  friend class DcmSCPEventWorker;
+
+  /// Possible run modes of pool
+  enum runmode
+  {
+    /// Listen for new connections
+    LISTEN,
+    /// Wait for the current associations to end
+    STOP,
+    /// Shutting down worker threads
+    SHUTDOWN
+  };
+
+  /** Create the event loop (epoll instance or poll set) and the pipe used
+   *  to wake up the event loop.
+   *  @param listenSocket The socket on which new connections are accepted
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition openEventLoop(DcmNativeSocketType listenSocket);
+
+  /** Close the event loop and the wake-up pipe.
+   */
+  void closeEventLoop();
+
+  /** Stop watching the listen socket for incoming connections.
+   */
+  void stopWatchingListenSocket();
+
+  /** Start watching the given association for incoming data.
+   *  Must only be called by the event loop thread.
+   *  @param entry The association
+   */
+  void watch(AssociationEntry* entry);
+
+  /** Stop watching the given association for incoming data.
+   *  Must only be called by the event loop thread.
+   *  @param entry The association
+   */
+  void unwatch(AssociationEntry* entry);
+
+  /** Remove the given association from the event loop before its connection
+   *  is closed. May be called by any thread, but only if the association is
+   *  currently not watched.
+   *  @param entry The association
+   */
+  void forget(AssociationEntry* entry);
+
+  /** Wait for events on the watched sockets.
+   *  @param ready Returns the associations that have data available. These
+   *         are not watched anymore.
+   *  @param incoming Returns OFTrue if a new connection is waiting on the
+   *         listen socket.
+   *  @param timeout Timeout in milliseconds, -1 for infinite
+   */
+  void waitForEvents(OFVector<AssociationEntry*>& ready,
+                     OFBool& incoming,
+                     int timeout);
+
+  /** Wake up the event loop, e.g.\ because an association has been handed
+   *  back by a worker thread.
+   */
+  void wakeUp();
+
+  /** Accept an incoming transport connection and start watching it. The
+   *  association request is received (and negotiated) by a worker thread.
+   *  @param sharedConfig The configuration to be used by the handler
+   */
+  void acceptAssociation(const DcmSharedSCPConfig& sharedConfig);
+
+  /** Receive the data that is available on the given association without
+   *  blocking, and check whether the association should be handed to a
+   *  worker thread.
+   *  @param entry The association
+   *  @return OFTrue if a complete message (e.g.\ the association request or
+   *          a DIMSE message) has been received, or if the data cannot be
+   *          buffered, OFFalse if more data is needed
+   */
+  OFBool receiveMessage(AssociationEntry* entry);
+
+  /** Hand the given association to the worker threads.
+   *  @param entry The association
+   */
+  void dispatch(AssociationEntry* entry);
+
+  /** Hand the given association back to the event loop after a worker has
+   *  handled it.
+   *  @param entry The association
+   */
+  void returnToEventLoop(AssociationEntry* entry);
+
+  /** Wait for the next association to be handled by a worker thread.
+   *  @return The association, NULL if the worker thread should exit.
+   */
+  AssociationEntry* nextJob();
+
+  /** Handle the given association within a worker thread, i.e. receive the
+   *  association request and negotiate it, or handle the DIMSE messages that
+   *  have been received completely.
+   *  @param entry The association
+   */
+  void processJob(AssociationEntry* entry);
+
+  /// Mutex that guards the job queue, the list of returned associations
+  /// and the run mode
+  OFMutex m_criticalSection;
+  /// Semaphore counting the entries in the job queue
+  OFSemaphore m_jobsAvailable;
+  /// Associations waiting for a worker thread (NULL entries stop a worker)
+  OFList<AssociationEntry*> m_jobs;
+  /// Associations handed back to the event loop by the worker threads
+  OFList<AssociationEntry*> m_returned;
+  /// Associations currently watched by the event loop (event loop thread only)
+  OFList<AssociationEntry*> m_idle;
+  /// The worker threads
+  OFVector<DcmSCPEventWorker*> m_workers;
+  /// Number of associations currently handled by the pool
+  size_t m_numAssociations;
+
+  /// SCP configuration to be used by pool and all handlers
+  DcmSCPConfig m_cfg;
+  /// Number of worker threads
+  Uint16 m_maxWorkers;
+  /// Maximum number of associations that can exist at a time
+  Uint16 m_maxAssociations;
+
+  /// The network while listen() is running
+  T_ASC_Network* m_network;
+  /// Maximum number of bytes buffered for an association by the event loop
+  unsigned long m_bufferLimit;
+
+  /// Socket on which new connections are accepted
+  DcmNativeSocketType m_listenSocket;
+  /// OFTrue while the listen socket is watched by the event loop
+  OFBool m_listening;
+  /// Pipe used to wake up the event loop (read end, write end)
+  int m_wakeupPipe[2];
+  /// epoll instance, -1 if epoll is not available
+  int m_epollFd;
+
+  /// Current run mode of pool
+  runmode m_runMode;
+};
+
+/** Implementation of an event-driven DICOM SCP server pool. The pool waits
+ *  for incoming TCP/IP connection requests and multiplexes all accepted
+ *  associations over a single event loop. A fixed number of worker threads
+ *  (default: 5) negotiates the associations and handles the DIMSE messages
+ *  as soon as they have been received, using one SCP object per association. The maximum number of
+ *  simultaneous associations is configurable (default: 100); further requests
+ *  are rejected with the error "local limit exceeded".
+ *  Since the SCP objects are not bound to a thread, the SCP implementation
+ *  must not rely on handling all messages of an association in the same thread,
+ *  and it must handle each DIMSE message by overriding handleIncomingCommand()
+ *  rather than handleAssociation().
+ *  @tparam SCP the service class provider to be instantiated for each
+ *    association, must be derived from DcmThreadSCP.
+ */
+template<typename SCP = DcmThreadSCP>
+class DcmSCPEventPool : public DcmBaseSCPEventPool
+{
+public:
+
+    /** Default construct a DcmSCPEventPool object.
+     */
+    DcmSCPEventPool() : DcmBaseSCPEventPool()
+    {
+    }
+
+private:
+
+    /** Helper class to use any class derived from DcmThreadSCP as a handler
+     *  for a single association.
+     */
+    struct SCPHandler : public DcmBaseSCPEventPool::DcmBaseSCPHandler
+                      , private SCP
+    {
+        /** Construct a SCPHandler.
+         */
+        SCPHandler()
+          : DcmBaseSCPHandler()
+          , SCP()
+        {
+        }
+
+        /** Set the shared configuration for this handler.
+         *  @param config a DcmSharedSCPConfig object to be used by this handler.
+         *  @return the result of the underlying SCP implementation.
+         */
+        virtual OFCondition setSharedConfig(const DcmSharedSCPConfig& config)
+        {
+            return SCP::setSharedConfig(config);
+        }
+
+        /** Negotiate an already accepted (TCP/IP) connection.
+         *  @param assoc The association to be negotiated
+         *  @param acknowledged OFTrue if the association was acknowledged
+         *  @return the result of the underlying SCP implementation.
+         */
+        virtual OFCondition startAssociation(T_ASC_Association* assoc, OFBool& acknowledged)
+        {
+            return SCP::beginAssociation(assoc, acknowledged);
+        }
+
+        /** Receive and handle the next DIMSE message.
+         *  @return the result of the underlying SCP implementation.
+         */
+        virtual OFCondition processCommand()
+        {
+            return SCP::receiveAndHandleCommand();
+        }
+
+        /** Finish the association.
+         *  @param cond the condition that ended the association.
+         */
+        virtual void finishAssociation(const OFCondition& cond)
+        {
+            SCP::endAssociation(cond);
+        }
+    };
+
+    /** Create a handler for a new association.
+     *  @return a pointer to a newly created SCP handler.
+     */
+    virtual DcmBaseSCPHandler* createSCPHandler()
+    {
+        return new SCPHandler;
+    }
+};
+
+#endif // WITH_THREADS && !_WIN32
+
+#endif // SCPEVPOOL_H
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2013, OFFIS e.V.
+ *  Copyright (C) 2013-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -58,6 +58,30 @@ public:
    */
   virtual OFCondition run(T_ASC_Association* incomingAssoc);
 
+  /** Negotiate an already established (on TCP/IP level) connection, but do not
+   *  handle any DIMSE messages yet. This function is used in an event-driven
+   *  context (see DcmBaseSCPEventPool) where the DIMSE messages of an acknowledged
+   *  association are handled one at a time using receiveAndHandleCommand(), as
+   *  soon as data is available on the connection. If the association request is
+   *  refused, the association is dropped and destroyed by this function.
+   *  @param incomingAssoc the association of the connection.
+   *  @param acknowledged [out] OFTrue if the association was acknowledged, in
+   *    which case endAssociation() must be called once the association ends.
+   *  @return error code if the given association is not valid or any serious
+   *    network error occurs, EC_Normal otherwise (even if the association was
+   *    refused).
+   */
+  virtual OFCondition beginAssociation(T_ASC_Association* incomingAssoc,
+                                       OFBool& acknowledged);
+
+  /** End an association that has been acknowledged by beginAssociation(), i.e.
+   *  acknowledge the release request or abort the association, notify about
+   *  termination and drop and destroy the association.
+   *  @param cond the condition that ended the association, i.e. the result of
+   *    the last call of receiveAndHandleCommand().
+   */
+  virtual void endAssociation(const OFCondition& cond);
+
   /** Get access to the DcmSharedSCPConfig object. The shared configuration can be used
    *  to provide other SCPs with the same configuration without the need to copy it.
    *  @return a reference to the DcmSharedSCPConfig object used by this DcmSCP object.
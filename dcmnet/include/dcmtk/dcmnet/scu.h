@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2008-2024, OFFIS e.V.
+ *  Copyright (C) 2008-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -301,6 +301,53 @@ public:
                                          const OFString& moveOriginatorAETitle = "",
                                          const Uint16 moveOriginatorMsgID      = 0);
 
+    /** Sends a C-STORE request on given presentation context without waiting for the
+     *  corresponding response, which has to be received later on by calling
+     *  receiveSTOREResponse(). This allows for having several C-STORE operations
+     *  outstanding at the same time, but only as many as permitted by the asynchronous
+     *  operations window negotiated with the peer (see getNegotiatedMaxOperationsInvoked()).
+     *  Apart from that, this method behaves exactly like sendSTORERequest().
+     *  @param presID        [in]  The ID of the presentation context to be used. If 0 is
+     *                             given, the function tries to find an appropriate
+     *                             presentation context itself.
+     *  @param dicomFile     [in]  The filename of the DICOM file to be sent. Alternatively, a
+     *                             dataset can be given in the next parameter.
+     *  @param dataset       [in]  The dataset to be sent. Alternatively, a filename can be
+     *                             specified in the previous parameter.
+     *  @param messageID     [out] The message ID of the C-STORE request that was sent, which
+     *                             is needed to match the response.
+     *  @param moveOriginatorAETitle [in] If this C-STORE is started due to a C-MOVE request,
+     *                               this parameter informs the C-STORE SCP about the C-MOVE
+     *                               client's AE title.
+     *  @param moveOriginatorMsgID   [in] If this C-STORE is started due to a C-MOVE request,
+     *                               this parameter informs the C-STORE SCP about the C-MOVE
+     *                               message ID.
+     *  @return EC_Normal if request could be sent successfully, error code otherwise
+     */
+    virtual OFCondition sendSTORERequestAsync(const T_ASC_PresentationContextID presID,
+                                              const OFFilename& dicomFile,
+                                              DcmDataset* dataset,
+                                              Uint16& messageID,
+                                              const OFString& moveOriginatorAETitle = "",
+                                              const Uint16 moveOriginatorMsgID      = 0);
+
+    /** Receives the next C-STORE response from the peer, e.g.\ after one or more C-STORE
+     *  requests have been sent with sendSTORERequestAsync(). Since responses may arrive in
+     *  any order, the caller has to match them with the outstanding requests by means of
+     *  the returned message ID.
+     *  @param messageIDRespondedTo [out] The message ID of the request this response belongs to
+     *  @param rspStatusCode        [out] The response status code received. 0 means success,
+     *                                    others can be found in the DICOM standard.
+     *  @param waitForResponse      [in]  If OFTrue, wait for the next response (using the
+     *                                    configured DIMSE blocking mode and timeout). If
+     *                                    OFFalse, return DIMSE_NODATAAVAILABLE immediately
+     *                                    if no data is available from the peer yet.
+     *  @return EC_Normal if a C-STORE response was received successfully, error code otherwise
+     */
+    virtual OFCondition receiveSTOREResponse(Uint16& messageIDRespondedTo,
+                                             Uint16& rspStatusCode,
+                                             const OFBool waitForResponse = OFTrue);
+
     /** Sends a C-MOVE Request on given presentation context and receives list of responses.
      *  The function receives the first response and then calls the function handleMOVEResponse()
      *  which gets the relevant presentation context together with the response dataset and
@@ -637,10 +684,21 @@ public:
     /* Set methods */
 
     /** Set maximum PDU length (to be received by SCU)
+     *  Values larger than the global dcmMaxPDUSizeLimit (default: 128 kBytes)
+     *  cause the association negotiation to fail.
      *  @param maxRecPDU [in] The maximum PDU size to use in bytes
      */
     void setMaxReceivePDULength(const Uint32 maxRecPDU);
 
+    /** Set maximum number of operations (e.g.\ C-STORE requests) that the SCU proposes to
+     *  have outstanding at the same time, i.e.\ the asynchronous operations window to be
+     *  negotiated. The window is only proposed if the value is different from 1 (the
+     *  default), and the SCU never offers to perform more than one operation at a time.
+     *  @param maxOps [in] Maximum number of outstanding operations to be invoked by the SCU.
+     *                     0 means unlimited.
+     */
+    void setMaxOperationsInvoked(const Uint16 maxOps);
+
     /** Set whether to send in DIMSE blocking or non-blocking mode
      *  @param blockingMode [in] Either blocking or non-blocking mode
      */
@@ -741,6 +799,19 @@ public:
      */
     Uint32 getMaxReceivePDULength() const;
 
+    /** Returns maximum number of outstanding operations configured to be proposed by SCU
+     *  @return Maximum number of outstanding operations (0 = unlimited)
+     */
+    Uint16 getMaxOperationsInvoked() const;
+
+    /** Returns maximum number of outstanding operations that the SCU may invoke on the
+     *  current association, as accepted by the peer. If the peer did not accept an
+     *  asynchronous operations window, 1 is returned, which is also the case if the SCU
+     *  is not connected.
+     *  @return Negotiated maximum number of outstanding operations (0 = unlimited)
+     */
+    Uint16 getNegotiatedMaxOperationsInvoked() const;
+
     /** Returns whether DIMSE messaging is configured to be blocking or unblocking
      *  @return The blocking mode configured
      */
@@ -1077,6 +1148,9 @@ private:
     /// Maximum PDU size (default: 16384 bytes)
     Uint32 m_maxReceivePDULength;
 
+    /// Maximum number of outstanding operations proposed (default: 1, i.e.\ synchronous)
+    Uint16 m_maxOperationsInvoked;
+
     /// DIMSE blocking mode (default: blocking)
     T_DIMSE_BlockingMode m_blockMode;
 
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2023, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -213,6 +213,16 @@ typedef struct {
 ** Function Bodies
 */
 
+/* return the upper limit for the PDV send buffer, see dcmMaxPDUSizeLimit */
+static long
+getMaxPDUSizeLimit()
+{
+    Uint32 limit = dcmMaxPDUSizeLimit.get();
+    if (limit < ASC_MINIMUMPDUSIZE) return ASC_MINIMUMPDUSIZE;
+    if (limit > ASC_LARGESTPDUSIZE) return ASC_LARGESTPDUSIZE;
+    return OFstatic_cast(long, limit);
+}
+
 
 OFCondition
 ASC_initializeNetwork(T_ASC_NetworkRole role,
@@ -565,6 +575,30 @@ ASC_printRejectParameters(OFString& str, const T_ASC_RejectParameters *rej)
     return str;
 }
 
+OFCondition
+ASC_setAsyncOperationsWindow(T_ASC_Parameters * params,
+                             unsigned short maxOpsInvoked,
+                             unsigned short maxOpsPerformed)
+{
+    if (params == NULL) return ASC_NULLKEY;
+    params->DULparams.maximumOperationsInvoked = maxOpsInvoked;
+    params->DULparams.maximumOperationsPerformed = maxOpsPerformed;
+    return EC_Normal;
+}
+
+OFCondition
+ASC_getPeerAsyncOperationsWindow(T_ASC_Parameters * params,
+                                 unsigned short *maxOpsInvoked,
+                                 unsigned short *maxOpsPerformed)
+{
+    if (params == NULL) return ASC_NULLKEY;
+    if (maxOpsInvoked)
+        *maxOpsInvoked = params->DULparams.peerMaximumOperationsInvoked;
+    if (maxOpsPerformed)
+        *maxOpsPerformed = params->DULparams.peerMaximumOperationsPerformed;
+    return EC_Normal;
+}
+
 static T_ASC_SC_ROLE
 dulRole2ascRole(DUL_SC_ROLE role)
 {
@@ -1638,20 +1672,43 @@ ASC_selectReadableAssociation(T_ASC_Association* assocs[],
   P_DcmTransportConnection *connections = new P_DcmTransportConnection[assocCount];
   if (connections == NULL) return OFFalse;
 
+  /* data that the DUL layer has already received ahead of time (e.g. a
+   * short A-RELEASE-RQ following the last P-DATA PDU) is not visible on the
+   * connection. Such associations are readable without waiting, the other
+   * ones are only polled.
+   */
+  OFBool *buffered = new OFBool[assocCount];
+  OFBool anyBuffered = OFFalse;
+  OFBool anyConnection = OFFalse;
   int i;
   for (i=0; i<assocCount; i++)
   {
-    if (assocs[i]) connections[i] = DUL_getTransportConnection(assocs[i]->DULassociation);
+    buffered[i] = (assocs[i] != NULL) && DUL_bufferedDataWaiting(assocs[i]->DULassociation);
+    if (assocs[i] && !buffered[i]) connections[i] = DUL_getTransportConnection(assocs[i]->DULassociation);
     else connections[i] = NULL;
+    if (buffered[i]) anyBuffered = OFTrue;
+    if (connections[i]) anyConnection = OFTrue;
+  }
+  OFBool result = OFFalse;
+  if (!anyBuffered)
+    result = DcmTransportConnection::selectReadableAssociation(connections, assocCount, timeout);
+  else
+  {
+    /* the associations with buffered data are readable in any case */
+    if (!anyConnection || !DcmTransportConnection::selectReadableAssociation(connections, assocCount, 0))
+    {
+      for (i=0; i<assocCount; i++) connections[i] = NULL;
+    }
+    result = OFTrue;
   }
-  OFBool result = DcmTransportConnection::selectReadableAssociation(connections, assocCount, timeout);
   if (result)
   {
     for (i=0; i<assocCount; i++)
     {
-      if (connections[i]==NULL) assocs[i]=NULL;
+      if ((connections[i]==NULL) && !buffered[i]) assocs[i]=NULL;
     }
   }
+  delete[] buffered;
   delete[] connections;
   return result;
 }
@@ -1662,6 +1719,15 @@ ASC_dataWaiting(T_ASC_Association * association, int timeout)
   return DUL_dataWaiting(association->DULassociation, timeout);
 }
 
+OFCondition
+ASC_getAssociationStatistics(T_ASC_Association * association,
+    DUL_ASSOCIATIONSTATISTICS * statistics)
+{
+  if ((association == NULL) || (statistics == NULL)) return ASC_NULLKEY;
+  if (!DUL_getAssociationStatistics(association->DULassociation, statistics)) return ASC_NULLKEY;
+  return EC_Normal;
+}
+
 OFBool
 ASC_associationWaiting(T_ASC_Network * network, int timeout)
 {
@@ -1758,13 +1824,26 @@ ASC_receiveAssociation(T_ASC_Network * network,
                        DUL_BLOCKOPTIONS block,
                        int timeout)
 {
-    T_ASC_Parameters *params;
-    DUL_ASSOCIATIONKEY *DULassociation;
-    DUL_PRESENTATIONCONTEXT *pc;
-    LST_HEAD **l;
+    const OFBool retrieveRawPDU = (associatePDU && associatePDUlength) ? OFTrue : OFFalse;
 
-    int retrieveRawPDU = 0;
-    if (associatePDU && associatePDUlength) retrieveRawPDU = 1;
+    OFCondition cond = ASC_acceptTransportConnection(network, assoc, maxReceivePDUSize,
+        retrieveRawPDU, useSecureLayer, block, timeout);
+    if (cond.bad() || (cond.code() == DULC_FORKEDCHILD)) return cond;
+
+    return ASC_receiveAssociationRequest(network, *assoc, associatePDU, associatePDUlength);
+}
+
+OFCondition
+ASC_acceptTransportConnection(T_ASC_Network * network,
+                              T_ASC_Association ** assoc,
+                              long maxReceivePDUSize,
+                              OFBool retrieveRawPDU,
+                              OFBool useSecureLayer,
+                              DUL_BLOCKOPTIONS block,
+                              int timeout)
+{
+    T_ASC_Parameters *params;
+    DUL_ASSOCIATIONKEY *DULassociation = NULL;
 
     OFCondition cond = ASC_createAssociationParameters(&params, maxReceivePDUSize, dcmConnectionTimeout.get());
     if (cond.bad()) return cond;
@@ -1787,8 +1866,8 @@ ASC_receiveAssociation(T_ASC_Network * network,
     (*assoc)->params = params;
     (*assoc)->nextMsgID = 1;
 
-    cond = DUL_ReceiveAssociationRQ(&network->network, block, timeout,
-                                    &(params->DULparams), &DULassociation, retrieveRawPDU);
+    cond = DUL_AcceptTransportConnection(&network->network, block, timeout,
+                                         &(params->DULparams), &DULassociation, retrieveRawPDU ? 1 : 0);
 
     if (cond.code() == DULC_FORKEDCHILD)
     {
@@ -1799,10 +1878,28 @@ ASC_receiveAssociation(T_ASC_Network * network,
     }
 
     (*assoc)->DULassociation = DULassociation;
+    return cond;
+}
+
+OFCondition
+ASC_receiveAssociationRequest(T_ASC_Network * network,
+                              T_ASC_Association * assoc,
+                              void **associatePDU,
+                              unsigned long *associatePDUlength)
+{
+    T_ASC_Parameters *params;
+    DUL_PRESENTATIONCONTEXT *pc;
+    LST_HEAD **l;
 
-    if (retrieveRawPDU && DULassociation)
+    if (network == NULL) return ASC_NULLKEY;
+    if (assoc == NULL) return ASC_NULLKEY;
+
+    params = assoc->params;
+    OFCondition cond = DUL_ReadAssociationRQ(&network->network, &(params->DULparams), &assoc->DULassociation);
+
+    if (associatePDU && associatePDUlength && assoc->DULassociation)
     {
-      DUL_returnAssociatePDUStorage((*assoc)->DULassociation, *associatePDU, *associatePDUlength);
+      DUL_returnAssociatePDUStorage(assoc->DULassociation, *associatePDU, *associatePDUlength);
     }
 
     if (cond.bad()) return cond;
@@ -1836,8 +1933,8 @@ ASC_receiveAssociation(T_ASC_Network * network,
     params->theirMaxPDUReceiveSize = params->DULparams.peerMaxPDU;
 
     /* the PDV buffer and length get set when we acknowledge the association */
-    (*assoc)->sendPDVLength = 0;
-    (*assoc)->sendPDVBuffer = NULL;
+    assoc->sendPDVLength = 0;
+    assoc->sendPDVBuffer = NULL;
 
     return EC_Normal;
 }
@@ -1963,9 +2060,9 @@ ASC_requestAssociation(T_ASC_Network * network,
         sendLen = params->theirMaxPDUReceiveSize;
         if (sendLen < 1) {
             /* the length is unlimited, choose a suitable buffer len */
-            sendLen = ASC_MAXIMUMPDUSIZE;
-        } else if (sendLen > ASC_MAXIMUMPDUSIZE) {
-            sendLen = ASC_MAXIMUMPDUSIZE;
+            sendLen = getMaxPDUSizeLimit();
+        } else if (sendLen > getMaxPDUSizeLimit()) {
+            sendLen = getMaxPDUSizeLimit();
         }
         /* make sure max pdv length is even */
         if ((sendLen % 2) != 0)
@@ -2045,9 +2142,9 @@ ASC_acknowledgeAssociation(
         sendLen = assoc->params->theirMaxPDUReceiveSize;
         if (sendLen < 1) {
             /* the length is unlimited, choose a suitable buffer len */
-            sendLen = ASC_MAXIMUMPDUSIZE;
-        } else if (sendLen > ASC_MAXIMUMPDUSIZE) {
-            sendLen = ASC_MAXIMUMPDUSIZE;
+            sendLen = getMaxPDUSizeLimit();
+        } else if (sendLen > getMaxPDUSizeLimit()) {
+            sendLen = getMaxPDUSizeLimit();
         }
         /* make sure max pdv length is even */
         if ((sendLen % 2) != 0)
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1998-2022, OFFIS e.V.
+ *  Copyright (C) 1998-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -44,12 +44,18 @@ BEGIN_EXTERN_C
 #ifdef HAVE_SYS_SELECT_H
 #include <sys/select.h>
 #endif
+#ifdef HAVE_SYS_UIO_H
+#include <sys/uio.h>
+#endif
 END_EXTERN_C
 
 #ifdef DCMTK_HAVE_POLL
 #include <poll.h>
 #endif
 
+/* maximum number of buffers passed to a single gather write operation */
+#define DCMTRANS_MAX_GATHER_BUFFERS 64
+
 /* platform independent definition of EINTR */
 enum
 {
@@ -312,6 +318,20 @@ void DcmTransportConnection::dumpConnectionParameters(STD_NAMESPACE ostream& out
     out << dumpConnectionParameters(str) << OFendl;
 }
 
+ssize_t DcmTransportConnection::writeBuffers(const DcmTransportBuffer *buffers, size_t count)
+{
+  ssize_t total = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (buffers[i].length == 0) continue;
+    ssize_t nbytes = write(buffers[i].data, buffers[i].length);
+    if (nbytes < 0) return (total > 0) ? total : nbytes;
+    total += nbytes;
+    if (OFstatic_cast(size_t, nbytes) < buffers[i].length) break;
+  }
+  return total;
+}
+
 void DcmTransportConnection::setParentProcessMode()
 {
   isForkedParent = OFTrue;
@@ -367,6 +387,33 @@ ssize_t DcmTCPConnection::write(void *buf, size_t nbyte)
 #endif
 }
 
+ssize_t DcmTCPConnection::writeBuffers(const DcmTransportBuffer *buffers, size_t count)
+{
+  /* larger arrays are written partially, the caller has to write the rest */
+  if (count > DCMTRANS_MAX_GATHER_BUFFERS) count = DCMTRANS_MAX_GATHER_BUFFERS;
+#ifdef HAVE_WINSOCK_H
+  WSABUF vec[DCMTRANS_MAX_GATHER_BUFFERS];
+  for (size_t i = 0; i < count; ++i)
+  {
+    vec[i].buf = OFstatic_cast(char *, buffers[i].data);
+    vec[i].len = OFstatic_cast(ULONG, buffers[i].length);
+  }
+  DWORD nbytes = 0;
+  if (WSASend(getSocket(), vec, OFstatic_cast(DWORD, count), &nbytes, 0, NULL, NULL) != 0) return -1;
+  return OFstatic_cast(ssize_t, nbytes);
+#elif defined(HAVE_SYS_UIO_H)
+  struct iovec vec[DCMTRANS_MAX_GATHER_BUFFERS];
+  for (size_t i = 0; i < count; ++i)
+  {
+    vec[i].iov_base = buffers[i].data;
+    vec[i].iov_len = buffers[i].length;
+  }
+  return ::writev(getSocket(), vec, OFstatic_cast(int, count));
+#else
+  return DcmTransportConnection::writeBuffers(buffers, count);
+#endif
+}
+
 void DcmTCPConnection::close()
 {
   closeTransportConnection();
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2024, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -124,6 +124,11 @@
  */
 OFGlobal<Uint32> dcmMaxOutgoingPDUSize((Uint32) -1);
 
+/*  size of the buffer into which DIMSE_receiveDataSetInFile() receives
+ *  the data fragments of incoming PDVs, 0 to disable the buffer.
+ */
+OFGlobal<Uint32> dcmReceiveDataSetBufferSize(262144);
+
 /*
  * Other global variables (should be used very, very rarely).
  * Modification of this variables is THREAD UNSAFE.
@@ -1420,16 +1425,40 @@ DIMSE_receiveDataSetInFile(
     T_ASC_PresentationContextID pid = 0;
     E_TransferSyntax xferSyntax;
     OFBool last = OFFalse;
+    OFBool direct = OFFalse;
     DIC_UL pdvCount = 0;
     DIC_UL bytesRead = 0;
 
     if ((assoc == NULL) || (presID==NULL) || (filestream==NULL)) return DIMSE_NULLKEY;
 
+    /* The data fragments are received directly into this buffer and written to the
+     * stream in large blocks. Only PDVs that have already been read into the PDU
+     * buffer of the DUL layer (e.g. because they share a PDU with other PDVs) are
+     * taken from there and written separately. The buffer size must be even in
+     * order to detect fragments with odd length.
+     */
+    unsigned long bufferLength = OFstatic_cast(unsigned long, dcmReceiveDataSetBufferSize.get()) & ~1UL;
+    unsigned long bufferUsed = 0;
+    unsigned char *buffer = (bufferLength > 0) ? new unsigned char[bufferLength] : NULL;
+    DUL_BLOCKOPTIONS blk = (blocking == DIMSE_BLOCKING) ? (DUL_BLOCK) : (DUL_NOBLOCK);
+
     *presID = 0;        /* invalid value */
     offile_off_t written = 0;
     while (!last)
     {
-        cond = DIMSE_readNextPDV(assoc, blocking, timeout, &pdv);
+        direct = (buffer != NULL) && !DUL_unprocessedPDVs(assoc->DULassociation);
+        if (direct)
+        {
+            cond = DUL_ReadPDVFragment(&assoc->DULassociation, blk, timeout, pid,
+                buffer + bufferUsed, bufferLength - bufferUsed, &pdv);
+            /* PDVs that have been read into the PDU buffer are handled below */
+            if (cond == DUL_PDATAPDUARRIVED) continue;
+            if (cond == DUL_READTIMEOUT) cond = DIMSE_NODATAAVAILABLE;
+            else if (cond == DUL_NULLKEY || cond == DUL_ILLEGALKEY) cond = DIMSE_ILLEGALASSOCIATION;
+            else if (cond.bad() && (cond != DUL_PEERREQUESTEDRELEASE) && (cond != DUL_PEERABORTEDASSOCIATION))
+                cond = makeDcmnetSubCondition(DIMSEC_READPDVFAILED, OF_error, "DIMSE Read PDV failed", cond);
+        }
+        else cond = DIMSE_readNextPDV(assoc, blocking, timeout, &pdv);
         if (cond != EC_Normal) last = OFTrue; // terminate loop
 
         if (!last)
@@ -1474,10 +1503,25 @@ DIMSE_receiveDataSetInFile(
 
         if (!last)
         {
-          written = filestream->write((void *)(pdv.data), (Uint32)(pdv.fragmentLength));
-          if ((! filestream->good()) || (written != (Uint32)(pdv.fragmentLength)))
+          OFBool writeFailed = OFFalse;
+          if (direct) bufferUsed += pdv.fragmentLength;
+          /* write the buffer when it is full, at the end of the data set, and */
+          /* before a PDV that has not been received into the buffer */
+          if ((bufferUsed > 0) && (!direct || pdv.lastPDV || (bufferUsed == bufferLength)))
+          {
+            written = filestream->write(buffer, OFstatic_cast(offile_off_t, bufferUsed));
+            writeFailed = (! filestream->good()) || (written != OFstatic_cast(offile_off_t, bufferUsed));
+            bufferUsed = 0;
+          }
+          if (!direct && !writeFailed)
+          {
+            written = filestream->write((void *)(pdv.data), (Uint32)(pdv.fragmentLength));
+            writeFailed = (! filestream->good()) || (written != (Uint32)(pdv.fragmentLength));
+          }
+          if (writeFailed)
           {
-              cond = DIMSE_ignoreDataSet(assoc, blocking, timeout, &bytesRead, &pdvCount);
+              /* skip the rest of the data set, if any */
+              if (!pdv.lastPDV) cond = DIMSE_ignoreDataSet(assoc, blocking, timeout, &bytesRead, &pdvCount);
               if (cond == EC_Normal)
               {
                 cond = makeDcmnetCondition(DIMSEC_OUTOFRESOURCES, OF_error, "DIMSE receiveDataSetInFile: Cannot write to file");
@@ -1501,6 +1545,7 @@ DIMSE_receiveDataSetInFile(
           }
         }
     }
+    delete[] buffer;
 
     /* set the Presentation Context ID we received */
     *presID = pid;
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2023, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -23,6 +23,8 @@
 #include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
 
 #include "dcmtk/ofstd/ofdatime.h"
+#include "dcmtk/ofstd/ofthread.h"
+#include "dcmtk/ofstd/ofvector.h"
 #include "dcmtk/dcmdata/dccodec.h"
 #include "dcmtk/dcmdata/dcfilefo.h"
 #include "dcmtk/dcmdata/dcdatutl.h"
@@ -35,6 +37,7 @@
 // these are private DIMSE status codes of the class "pending"
 #define STATUS_STORE_Pending_NoPresentationContext 0xffff
 #define STATUS_STORE_Pending_InvalidDatasetPointer 0xfffe
+#define STATUS_STORE_Pending_NoResponse            0xfffd
 
 
 // helper functions
@@ -61,6 +64,181 @@ static const OFString &dicomToHostFilename(const OFString &dicomFilename,
 }
 
 
+#ifdef WITH_THREADS
+
+// internal class sending a part of the transfer list in a separate thread,
+// see DcmStorageSCU::sendSOPInstancesInParallel()
+
+class DcmStorageSCU::ParallelWorker
+  : public DcmStorageSCU,
+    public OFThread
+{
+
+  public:
+
+    ParallelWorker(DcmStorageSCU &parent,
+                   OFMutex &mutex);
+
+    virtual ~ParallelWorker();
+
+    void addTransferEntry(TransferEntry *transferEntry);
+
+    virtual OFCondition negotiateAssociation();
+
+    /// status of the sending process (EC_Normal if no error occurred)
+    OFCondition Status;
+    /// flag indicating whether an association failed, i.e. was not released normally
+    OFBool AssociationFailed;
+
+  protected:
+
+    virtual void run();
+
+    virtual void notifySOPInstanceToBeSent(const TransferEntry &transferEntry);
+
+    virtual void notifySOPInstanceSent(const TransferEntry &transferEntry);
+
+    virtual OFBool shouldStopAfterCurrentSOPInstance();
+
+  private:
+
+    /// storage SCU that owns the transfer list and receives all notifications
+    DcmStorageSCU &Parent;
+    /// mutex protecting the parent object
+    OFMutex &Mutex;
+};
+
+
+DcmStorageSCU::ParallelWorker::ParallelWorker(DcmStorageSCU &parent,
+                                              OFMutex &mutex)
+  : DcmStorageSCU(),
+    OFThread(),
+    Status(EC_Normal),
+    AssociationFailed(OFFalse),
+    Parent(parent),
+    Mutex(mutex)
+{
+    // use the same network parameters and modes as the parent
+    setPeerHostName(parent.getPeerHostName());
+    setPeerPort(parent.getPeerPort());
+    setPeerAETitle(parent.getPeerAETitle());
+    setAETitle(parent.getAETitle());
+    setMaxReceivePDULength(parent.getMaxReceivePDULength());
+    setMaxOperationsInvoked(parent.getMaxOperationsInvoked());
+    setACSETimeout(parent.getACSETimeout());
+    setDIMSETimeout(parent.getDIMSETimeout());
+    setDIMSEBlockingMode(parent.getDIMSEBlockingMode());
+    setConnectionTimeout(parent.getConnectionTimeout());
+    setVerbosePCMode(parent.getVerbosePCMode());
+    setDatasetConversionMode(parent.getDatasetConversionMode());
+    setProgressNotificationMode(parent.getProgressNotificationMode());
+    DecompressionMode = parent.DecompressionMode;
+    HaltOnUnsuccessfulStoreMode = parent.HaltOnUnsuccessfulStoreMode;
+    AllowIllegalProposalMode = parent.AllowIllegalProposalMode;
+    MoveOriginatorAETitle = parent.MoveOriginatorAETitle;
+    MoveOriginatorMsgID = parent.MoveOriginatorMsgID;
+}
+
+
+DcmStorageSCU::ParallelWorker::~ParallelWorker()
+{
+    // the transfer entries are owned by the parent, so do not delete them
+    TransferList.clear();
+    CurrentTransferEntry = TransferList.begin();
+}
+
+
+void DcmStorageSCU::ParallelWorker::addTransferEntry(TransferEntry *transferEntry)
+{
+    TransferList.push_back(transferEntry);
+    CurrentTransferEntry = TransferList.begin();
+}
+
+
+OFCondition DcmStorageSCU::ParallelWorker::negotiateAssociation()
+{
+    // number the associations of all threads consecutively
+    Mutex.lock();
+    AssociationCounter = Parent.AssociationCounter++;
+    Mutex.unlock();
+    return DcmStorageSCU::negotiateAssociation();
+}
+
+
+void DcmStorageSCU::ParallelWorker::run()
+{
+    // use as many associations as needed for the SOP instances of this part (one after the other)
+    while ((Status = addPresentationContexts()).good())
+    {
+        Status = initNetwork();
+        if (Status.good())
+            Status = negotiateAssociation();
+        if (Status.good())
+        {
+            Status = sendSOPInstances();
+            // handle certain error conditions (initiated by the communication peer)
+            if (Status == DUL_PEERABORTEDASSOCIATION)
+                closeAssociation(DCMSCU_PEER_ABORTED_ASSOCIATION);
+            else if (Status == DUL_PEERREQUESTEDRELEASE)
+                closeAssociation(DCMSCU_PEER_REQUESTED_RELEASE);
+            else
+                releaseAssociation();
+            if (isConnected())
+            {
+                // the association could not be released, so it is not usable anymore
+                abortAssociation();
+                AssociationFailed = OFTrue;
+                if (Status.good())
+                    Status = DIMSE_ILLEGALASSOCIATION;
+            }
+            else if (Status == DUL_PEERABORTEDASSOCIATION || Status == DUL_PEERREQUESTEDRELEASE)
+                AssociationFailed = OFTrue;
+        }
+        else if (Status == NET_EC_NoAcceptablePresentationContexts)
+        {
+            // continue with a new association for the remaining SOP instances
+            releaseAssociation();
+            Status = EC_Normal;
+        } else {
+            // association could not be established (e.g. rejected by the peer)
+            AssociationFailed = OFTrue;
+        }
+        if (Status.bad())
+            break;
+    }
+    // all SOP instances of this part have been processed
+    if (Status == NET_EC_NoPresentationContextsDefined)
+        Status = EC_Normal;
+}
+
+
+void DcmStorageSCU::ParallelWorker::notifySOPInstanceToBeSent(const TransferEntry &transferEntry)
+{
+    Mutex.lock();
+    Parent.notifySOPInstanceToBeSent(transferEntry);
+    Mutex.unlock();
+}
+
+
+void DcmStorageSCU::ParallelWorker::notifySOPInstanceSent(const TransferEntry &transferEntry)
+{
+    Mutex.lock();
+    Parent.notifySOPInstanceSent(transferEntry);
+    Mutex.unlock();
+}
+
+
+OFBool DcmStorageSCU::ParallelWorker::shouldStopAfterCurrentSOPInstance()
+{
+    Mutex.lock();
+    const OFBool result = Parent.shouldStopAfterCurrentSOPInstance();
+    Mutex.unlock();
+    return result;
+}
+
+#endif // WITH_THREADS
+
+
 // implementation of the internal class/struct for a single transfer entry
 
 DcmStorageSCU::TransferEntry::TransferEntry(const OFFilename &filename,
@@ -794,6 +972,15 @@ OFCondition DcmStorageSCU::sendSOPInstances()
     if (!TransferList.empty())
     {
         DcmDataset *dataset = NULL;
+        // determine how many C-STORE requests may be outstanding at the same time (0 = unlimited)
+        const Uint16 maxOperations = getNegotiatedMaxOperationsInvoked();
+        const OFBool asyncMode = (maxOperations != 1);
+        // C-STORE requests that have been sent but not yet been responded to
+        OFMap<Uint16, TransferEntry *> outstandingRequests;
+        if (maxOperations == 0)
+            DCMNET_DEBUG("sending SOP instances asynchronously without limiting the number of outstanding requests");
+        else if (asyncMode)
+            DCMNET_DEBUG("sending SOP instances asynchronously with up to " << maxOperations << " outstanding requests");
         // iterate over the list of SOP instances to be transferred
         // (continue with next SOP instance if there already was a transmission)
         OFListConstIterator(TransferEntry *) lastEntry = TransferList.end();
@@ -803,6 +990,8 @@ OFCondition DcmStorageSCU::sendSOPInstances()
             if (!(*CurrentTransferEntry)->RequestSent)
             {
                 DcmFileFormat fileformat;
+                // flag indicating whether the response to the C-STORE request is still outstanding
+                OFBool responsePending = OFFalse;
                 // check whether SOP instance can be sent on this association
                 // (i.e. whether it has been negotiated for this association)
                 if ((*CurrentTransferEntry)->PresentationContextID == 0)
@@ -872,8 +1061,22 @@ OFCondition DcmStorageSCU::sendSOPInstances()
                     // notify user of this class that the current SOP instance is to be sent
                     notifySOPInstanceToBeSent(**CurrentTransferEntry);
                     // call the inherited method from the base class doing the real work
-                    status = sendSTORERequest((*CurrentTransferEntry)->PresentationContextID, "" /* filename */, dataset,
-                        (*CurrentTransferEntry)->ResponseStatusCode, MoveOriginatorAETitle, MoveOriginatorMsgID);
+                    if (asyncMode)
+                    {
+                        // do not wait for the response, it is received later on
+                        Uint16 messageID = 0;
+                        status = sendSTORERequestAsync((*CurrentTransferEntry)->PresentationContextID, "" /* filename */,
+                            dataset, messageID, MoveOriginatorAETitle, MoveOriginatorMsgID);
+                        if (status.good())
+                        {
+                            (*CurrentTransferEntry)->ResponseStatusCode = STATUS_STORE_Pending_NoResponse;
+                            outstandingRequests[messageID] = *CurrentTransferEntry;
+                            responsePending = OFTrue;
+                        }
+                    } else {
+                        status = sendSTORERequest((*CurrentTransferEntry)->PresentationContextID, "" /* filename */, dataset,
+                            (*CurrentTransferEntry)->ResponseStatusCode, MoveOriginatorAETitle, MoveOriginatorMsgID);
+                    }
                     // store some further information (even in case of error)
                     (*CurrentTransferEntry)->AssociationNumber = AssociationCounter;
                     (*CurrentTransferEntry)->NetworkTransferSyntax = dataset->getCurrentXfer();
@@ -913,13 +1116,31 @@ OFCondition DcmStorageSCU::sendSOPInstances()
                         status = EC_Normal;
                 }
                 // notify user of this class that the current SOP instance has been processed
-                notifySOPInstanceSent(**CurrentTransferEntry);
+                // (in asynchronous mode, this is done as soon as the response is received)
+                if (!responsePending)
+                    notifySOPInstanceSent(**CurrentTransferEntry);
+                // receive the responses that are already available, and wait for further ones
+                // if no more C-STORE requests may be outstanding
+                if (status.good() && !outstandingRequests.empty())
+                {
+                    status = receiveSTOREResponses(outstandingRequests,
+                        (maxOperations == 0) ? outstandingRequests.size() : OFstatic_cast(size_t, maxOperations - 1));
+                }
             }
             ++CurrentTransferEntry;
             // check whether the sending process should be stopped
             if (shouldStopAfterCurrentSOPInstance())
                 break;
         }
+        // wait for the responses to all outstanding C-STORE requests (unless the association is gone)
+        if (!outstandingRequests.empty() && (status != DIMSE_ILLEGALASSOCIATION))
+        {
+            const OFCondition responseStatus = receiveSTOREResponses(outstandingRequests, 0 /* maxOutstanding */);
+            if (status.good())
+                status = responseStatus;
+        }
+        if (!outstandingRequests.empty())
+            DCMNET_ERROR("no response received for " << outstandingRequests.size() << " C-STORE request(s)");
     } else {
         // report an error to the caller
         status = NET_EC_NoSOPInstancesToSend;
@@ -928,6 +1149,178 @@ OFCondition DcmStorageSCU::sendSOPInstances()
 }
 
 
+OFCondition DcmStorageSCU::receiveSTOREResponses(OFMap<Uint16, TransferEntry *> &outstandingRequests,
+                                                 const size_t maxOutstanding)
+{
+    OFCondition status = EC_Normal;
+    while (status.good() && !outstandingRequests.empty())
+    {
+        // only wait for a response if there are too many outstanding requests
+        const OFBool waitForResponse = (outstandingRequests.size() > maxOutstanding);
+        Uint16 messageID = 0;
+        Uint16 rspStatusCode = 0;
+        status = receiveSTOREResponse(messageID, rspStatusCode, waitForResponse);
+        if (status.good())
+        {
+            // match the response with the request it belongs to
+            OFMap<Uint16, TransferEntry *>::iterator request = outstandingRequests.find(messageID);
+            if (request != outstandingRequests.end())
+            {
+                request->second->ResponseStatusCode = rspStatusCode;
+                // notify user of this class that the SOP instance has been processed
+                notifySOPInstanceSent(*request->second);
+                outstandingRequests.erase(request);
+            } else {
+                char buf[256];
+                sprintf(buf, "DIMSE: Unexpected Response MsgId: %u", OFstatic_cast(unsigned int, messageID));
+                status = makeDcmnetCondition(DIMSEC_UNEXPECTEDRESPONSE, OF_error, buf);
+                DCMNET_ERROR(status.text());
+            }
+        }
+        else if (!waitForResponse && (status == DIMSE_NODATAAVAILABLE))
+        {
+            // no response available yet, continue with the next request
+            status = EC_Normal;
+            break;
+        }
+    }
+    return status;
+}
+
+
+OFCondition DcmStorageSCU::sendSOPInstancesInParallel(const size_t numAssociations)
+{
+#ifdef WITH_THREADS
+    // check parameters and current state
+    if (numAssociations == 0)
+        return EC_IllegalParameter;
+    if (TransferList.empty())
+        return NET_EC_NoSOPInstancesToSend;
+    if (isConnected())
+        return NET_EC_AlreadyConnected;
+    if (getTLSEnabled())
+    {
+        DCMNET_ERROR("cannot send SOP instances in parallel: secure connections are not supported");
+        return EC_IllegalCall;
+    }
+    OFCondition status = EC_Normal;
+    // determine the SOP instances that are still to be sent
+    OFList<TransferEntry *> pendingEntries;
+    OFListIterator(TransferEntry *) transferEntry = TransferList.begin();
+    OFListConstIterator(TransferEntry *) lastEntry = TransferList.end();
+    while (transferEntry != lastEntry)
+    {
+        if (!(*transferEntry)->RequestSent)
+            pendingEntries.push_back(*transferEntry);
+        ++transferEntry;
+    }
+    OFMutex mutex;
+    // status of the last association that failed
+    OFCondition associationStatus = EC_Normal;
+    // flags indicating which of the parallel associations are still usable
+    OFVector<OFBool> healthy(numAssociations, OFTrue);
+    OFBool retry = OFFalse;
+    while (!pendingEntries.empty() && status.good())
+    {
+        // determine the associations to be used for this round
+        OFVector<size_t> slots;
+        for (size_t i = 0; (i < numAssociations) && (slots.size() < pendingEntries.size()); ++i)
+        {
+            if (healthy[i])
+                slots.push_back(i);
+        }
+        if (slots.empty())
+            break;
+        if (retry)
+            DCMNET_INFO("trying to send " << pendingEntries.size() << " SOP instances again on the remaining associations");
+        retry = OFTrue;
+        DCMNET_DEBUG("sending " << pendingEntries.size() << " SOP instances on " << slots.size()
+            << " association(s) in parallel");
+        // partition the SOP instances into consecutive parts of about the same size
+        OFVector<ParallelWorker *> workers;
+        const size_t partSize = (pendingEntries.size() + slots.size() - 1) / slots.size();
+        size_t count = 0;
+        transferEntry = pendingEntries.begin();
+        while (transferEntry != pendingEntries.end())
+        {
+            if (count % partSize == 0)
+                workers.push_back(new ParallelWorker(*this, mutex));
+            // reset the status of SOP instances that are sent again
+            (*transferEntry)->RequestSent = OFFalse;
+            (*transferEntry)->PresentationContextID = 0;
+            (*transferEntry)->ResponseStatusCode = 0;
+            workers.back()->addTransferEntry(*transferEntry);
+            ++transferEntry;
+            ++count;
+        }
+        pendingEntries.clear();
+        // start one thread per part and wait for all of them to finish
+        size_t i;
+        OFVector<OFBool> started(workers.size(), OFFalse);
+        for (i = 0; i < workers.size(); ++i)
+        {
+            started[i] = (workers[i]->start() == 0);
+            if (!started[i])
+            {
+                DCMNET_ERROR("cannot start thread for sending SOP instances in parallel");
+                // treat like a failed association, i.e. try again on the other ones
+                workers[i]->Status = EC_IllegalCall;
+                workers[i]->AssociationFailed = OFTrue;
+            }
+        }
+        for (i = 0; i < workers.size(); ++i)
+        {
+            if (started[i])
+                workers[i]->join();
+        }
+        // collect the results and the SOP instances that need to be sent again
+        for (i = 0; i < workers.size(); ++i)
+        {
+            ParallelWorker *worker = workers[i];
+            PresentationContextCounter += worker->PresentationContextCounter;
+            if (worker->AssociationFailed)
+            {
+                DCMNET_WARN("association failed while sending SOP instances in parallel: " << worker->Status.text());
+                healthy[slots[i]] = OFFalse;
+                transferEntry = worker->TransferList.begin();
+                while (transferEntry != worker->TransferList.end())
+                {
+                    TransferEntry *entry = *transferEntry;
+                    // datasets that have already been deleted cannot be sent again
+                    if ((!entry->RequestSent || (entry->ResponseStatusCode == STATUS_STORE_Pending_NoResponse)) &&
+                        (!entry->Filename.isEmpty() || (entry->Dataset != NULL)))
+                    {
+                        pendingEntries.push_back(entry);
+                    }
+                    ++transferEntry;
+                }
+                associationStatus = worker->Status;
+            }
+            else if (worker->Status.bad())
+            {
+                // e.g. unsuccessful store with "halt" mode enabled
+                status = worker->Status;
+            }
+            delete worker;
+        }
+    }
+    // report an error if some SOP instances could not be sent on any association
+    if (!pendingEntries.empty() && status.good())
+    {
+        DCMNET_ERROR("cannot send " << pendingEntries.size() << " SOP instances: no usable association left");
+        status = associationStatus;
+    }
+    // all SOP instances have been processed
+    CurrentTransferEntry = TransferList.end();
+    return status;
+#else
+    (void) numAssociations;
+    DCMNET_ERROR("cannot send SOP instances in parallel: DCMTK was compiled without thread support");
+    return EC_IllegalCall;
+#endif
+}
+
+
 void DcmStorageSCU::notifySOPInstanceToBeSent(const TransferEntry & /*transferEntry*/)
 {
     // do nothing in the default implementation
@@ -965,6 +1358,7 @@ void DcmStorageSCU::getStatusSummary(OFString &summary) const
     size_t numUnknown = 0;
     size_t numPending = 0;
     size_t numInvalid = 0;
+    size_t numNoResponse = 0;
     OFListConstIterator(TransferEntry *) transferEntry = TransferList.begin();
     OFListConstIterator(TransferEntry *) lastEntry = TransferList.end();
     while (transferEntry != lastEntry)
@@ -1005,6 +1399,10 @@ void DcmStorageSCU::getStatusSummary(OFString &summary) const
             {
                 --numSent;
                 ++numInvalid;
+            }
+            else if (rspStatus == STATUS_STORE_Pending_NoResponse)
+            {
+                ++numNoResponse;
             } else {
                 /* any other (unknown/unsupported) DIMSE status code */
                 ++numUnknown;
@@ -1024,6 +1422,8 @@ void DcmStorageSCU::getStatusSummary(OFString &summary) const
         stream << OFendl << "  * with status REFUSED  : " << numRefused;
     if (numUnknown > 0)
         stream << OFendl << "  * with unknown status  : " << numUnknown;
+    if (numNoResponse > 0)
+        stream << OFendl << "  * without response     : " << numNoResponse;
     if (numSent < numInstances)
         stream << OFendl << "- NOT sent to the peer   : " << (numInstances - numSent);
     if (numPending > 0)
@@ -1090,6 +1490,8 @@ OFCondition DcmStorageSCU::createReportFile(const OFString &filename) const
                         stream << "<no acceptable presentation context>";
                     else if (rspStatus == STATUS_STORE_Pending_InvalidDatasetPointer)
                         stream << "<invalid dataset pointer>";
+                    else if (rspStatus == STATUS_STORE_Pending_NoResponse)
+                        stream << "<no response received>";
                     else {
                         stream << "0x" << STD_NAMESPACE hex << STD_NAMESPACE setfill('0') << STD_NAMESPACE setw(4)
                             << rspStatus << " (" << DU_cstoreStatusString(rspStatus) << ")" << STD_NAMESPACE dec;
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -138,6 +138,7 @@ OFGlobal<DcmNativeSocketType> dcmExternalSocketHandle(DCMNET_INVALID_SOCKET);
 OFGlobal<const char *> dcmTCPWrapperDaemonName((const char *)NULL);
 OFGlobal<unsigned long> dcmEnableBackwardCompatibility(0);
 OFGlobal<size_t> dcmAssociatePDUSizeLimit(0x100000);
+OFGlobal<Uint32> dcmMaxPDUSizeLimit(131072);
 
 static int networkInitialized = 0;
 
@@ -161,6 +162,10 @@ receiveTransportConnectionTCP(PRIVATE_NETWORKKEY ** network,
                               int timeout,
                               DUL_ASSOCIATESERVICEPARAMETERS * params,
                               PRIVATE_ASSOCIATIONKEY ** association);
+static OFCondition
+identifyTransportConnection(PRIVATE_NETWORKKEY ** network,
+                            DUL_ASSOCIATESERVICEPARAMETERS * params,
+                            PRIVATE_ASSOCIATIONKEY ** association);
 
 
 static void destroyAssociationKey(PRIVATE_ASSOCIATIONKEY ** key);
@@ -181,13 +186,15 @@ static void setTCPBufferLength(int sock);
 
 static OFCondition checkNetwork(PRIVATE_NETWORKKEY ** networkKey);
 static OFCondition checkAssociation(PRIVATE_ASSOCIATIONKEY ** association);
+static OFCondition
+indicateNextPDU(PRIVATE_ASSOCIATIONKEY ** association, DUL_PDVLIST * pdvList,
+                DUL_BLOCKOPTIONS block, OFCondition cond, unsigned char pduType);
 static OFString dump_presentation_ctx(LST_HEAD ** l);
 static OFString dump_uid(const char *UID, const char *indent);
 static void clearRequestorsParams(DUL_ASSOCIATESERVICEPARAMETERS * params);
 static void clearPresentationContext(LST_HEAD ** l);
 
 #define MIN_PDU_LENGTH  4*1024
-#define MAX_PDU_LENGTH  128*1024
 
 static OFBool processIsForkedChild = OFFalse;
 static OFBool shouldFork = OFFalse;
@@ -499,7 +506,7 @@ DUL_RequestAssociation(
         return DUL_ILLEGALREQUEST;
     }
 
-    if (params->maxPDU < MIN_PDU_LENGTH || params->maxPDU > MAX_PDU_LENGTH)
+    if (params->maxPDU < MIN_PDU_LENGTH || params->maxPDU > dcmMaxPDUSizeLimit.get())
     {
         return makeDcmnetCondition(DULC_ILLEGALPARAMETER, OF_error, "DUL Illegal parameter (maxPDU) in function DUL_RequestAssociation");
     }
@@ -598,6 +605,8 @@ DUL_RequestAssociation(
 **      Association Items which describe the proposed Association and an
 **      AssociationKey used to access this Association.  The user should call
 **      DUL_AcknowledgeAssociateRQ if the Association is to be accepted.
+**      This is the same as calling DUL_AcceptTransportConnection() followed
+**      by DUL_ReadAssociationRQ().
 **
 ** Parameter Dictionary:
 **      callerNetworkKey    Caller's handle to the network environment.
@@ -624,17 +633,58 @@ DUL_ReceiveAssociationRQ(
   DUL_ASSOCIATESERVICEPARAMETERS * params,
   DUL_ASSOCIATIONKEY ** callerAssociation,
   int activatePDUStorage)
+{
+    OFCondition cond = DUL_AcceptTransportConnection(callerNetworkKey, block, timeout,
+                                                     params, callerAssociation, activatePDUStorage);
+    if (cond.bad() || (cond.code() == DULC_FORKEDCHILD))
+        return cond;
+
+    return DUL_ReadAssociationRQ(callerNetworkKey, params, callerAssociation);
+}
+
+
+/* DUL_AcceptTransportConnection
+**
+** Purpose:
+**      This function performs the first part of DUL_ReceiveAssociationRQ():
+**      It waits for an incoming transport connection, accepts it, and
+**      creates an AssociationKey for it. It neither identifies the peer nor
+**      reads anything from the new connection, so it never waits for the
+**      peer if a connection is pending. The Association Request is then
+**      received by calling DUL_ReadAssociationRQ().
+**
+** Parameter Dictionary:
+**      callerNetworkKey    Caller's handle to the network environment.
+**      block               Flag indicating blocking/non-blocking mode.
+**      timeout             When blocking mode is non-blocking, the timeout in
+**                          seconds.
+**      params              Pointer to a structure holding parameters which
+**                          describe this Association.
+**      callerAssociation   Caller handle for this association that is created
+**                          by this function.
+**      activatePDUStorage
+**
+** Return Values:
+**      DUL_NOASSOCIATIONREQUEST if no connection was received within the
+**      timeout. DULC_FORKEDCHILD (with OF_ok status) in the parent process
+**      in multi-process mode, the AssociationKey is NULL then.
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+OFCondition
+DUL_AcceptTransportConnection(
+  DUL_NETWORKKEY ** callerNetworkKey,
+  DUL_BLOCKOPTIONS block,
+  int timeout,
+  DUL_ASSOCIATESERVICEPARAMETERS * params,
+  DUL_ASSOCIATIONKEY ** callerAssociation,
+  int activatePDUStorage)
 {
     PRIVATE_NETWORKKEY
         ** network;
     PRIVATE_ASSOCIATIONKEY
         ** association;
-    unsigned char
-        pduType;
-    int
-        event;
-    DUL_ABORTITEMS
-        abortItems;
 
     network = (PRIVATE_NETWORKKEY **) callerNetworkKey;
     association = (PRIVATE_ASSOCIATIONKEY **) callerAssociation;
@@ -645,7 +695,7 @@ DUL_ReceiveAssociationRQ(
         return DUL_ILLEGALACCEPT;
     }
 
-    if (params->maxPDU < MIN_PDU_LENGTH || params->maxPDU > MAX_PDU_LENGTH)
+    if (params->maxPDU < MIN_PDU_LENGTH || params->maxPDU > dcmMaxPDUSizeLimit.get())
         return makeDcmnetCondition(DULC_ILLEGALPARAMETER, OF_error, "DUL Illegal parameter (maxPDU) in function DUL_ReceiveAssociationRQ");
 
     cond = createAssociationKey(network, "", params->maxPDU, association);
@@ -661,6 +711,67 @@ DUL_ReceiveAssociationRQ(
     cond = receiveTransportConnection(network, block, timeout, params, association);
 
     if (cond.bad() || (cond.code() == DULC_FORKEDCHILD))
+    {
+        destroyAssociationKey(association);
+        *association = NULL;
+    }
+    return cond;
+}
+
+
+/* DUL_ReadAssociationRQ
+**
+** Purpose:
+**      This function performs the second part of DUL_ReceiveAssociationRQ():
+**      For a transport connection that has been accepted by
+**      DUL_AcceptTransportConnection(), it identifies the peer, performs the
+**      handshake of the secure transport layer (if any) and receives the
+**      Association Request, waiting at most for the ARTIM timeout of the
+**      network. If the AssociationKey is destroyed because the connection
+**      could not be established, it is set to NULL.
+**
+** Parameter Dictionary:
+**      callerNetworkKey    Caller's handle to the network environment.
+**      params              Pointer to a structure holding parameters which
+**                          describe this Association, as passed to
+**                          DUL_AcceptTransportConnection().
+**      callerAssociation   Caller handle for this association that has been
+**                          created by DUL_AcceptTransportConnection().
+**
+** Return Values:
+**
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+OFCondition
+DUL_ReadAssociationRQ(
+  DUL_NETWORKKEY ** callerNetworkKey,
+  DUL_ASSOCIATESERVICEPARAMETERS * params,
+  DUL_ASSOCIATIONKEY ** callerAssociation)
+{
+    PRIVATE_NETWORKKEY
+        ** network;
+    PRIVATE_ASSOCIATIONKEY
+        ** association;
+    unsigned char
+        pduType;
+    int
+        event;
+    DUL_ABORTITEMS
+        abortItems;
+
+    network = (PRIVATE_NETWORKKEY **) callerNetworkKey;
+    association = (PRIVATE_ASSOCIATIONKEY **) callerAssociation;
+    OFCondition cond = checkNetwork(network);
+    if (cond.bad()) return cond;
+    cond = checkAssociation(association);
+    if (cond.bad()) return cond;
+
+    cond = identifyTransportConnection(network, params, association);
+    if (cond.good())
+        cond = (*association)->connection->serverSideHandshake();
+    if (cond.bad())
     {
         destroyAssociationKey(association);
         *association = NULL;
@@ -1211,9 +1322,7 @@ DUL_ReadPDVs(DUL_ASSOCIATIONKEY ** callerAssociation,
     PRIVATE_ASSOCIATIONKEY
         ** association;
     unsigned char
-        pduType;
-    int
-        event;
+        pduType = 0;
 
     /* assign the association to local variable */
     association = (PRIVATE_ASSOCIATIONKEY **) callerAssociation;
@@ -1222,12 +1331,51 @@ DUL_ReadPDVs(DUL_ASSOCIATIONKEY ** callerAssociation,
     OFCondition cond = checkAssociation(association);
     if (cond.bad()) return cond;
 
+    /* if DUL_ReadPDVFragment() has stopped in the middle of a P-DATA-TF PDU, */
+    /* the rest of that PDU has to be read before anything else */
+    if (((*association)->directPDULength > 0) || ((*association)->directFragmentLength > 0))
+        return PRV_BufferPendingPDVs(association, block, timeout);
+
     /* determine the type of the next PDU (in case the association */
     /* does not contain PDU header information yet, we need to try */
     /* to receive PDU header information on the network) */
     cond = PRV_NextPDUType(association, block, timeout, &pduType);
 
-    /* evaluate the return value of the above called function */
+    /* process the PDU (or the error) through the state machine */
+    return indicateNextPDU(association, pdvList, block, cond, pduType);
+}
+
+
+/* indicateNextPDU
+**
+** Purpose:
+**      Invoke the finite state machine for the next PDU (whose type has been
+**      determined by PRV_NextPDUType()) or for the error that occurred while
+**      trying to determine the type of the next PDU.
+**
+** Parameter Dictionary:
+**      association        Handle to the Association.
+**      pdvList            Pointer to a structure which describes the
+**                         list of PDVs to be read from the active
+**                         Association.
+**      block              Option used for blocking/non-blocking read.
+**      cond               Result of PRV_NextPDUType()
+**      pduType            Type of the next PDU, if cond is good
+**
+** Return Values:
+**
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+static OFCondition
+indicateNextPDU(PRIVATE_ASSOCIATIONKEY ** association, DUL_PDVLIST * pdvList,
+                DUL_BLOCKOPTIONS block, OFCondition cond, unsigned char pduType)
+{
+    int
+        event;
+
+    /* evaluate the return value of PRV_NextPDUType() */
     if (cond == DUL_NETWORKCLOSED) event = TRANS_CONN_CLOSED;
     else if ((cond == DUL_READTIMEOUT) && (block == DUL_NOBLOCK)) return cond;
     else if (cond == DUL_READTIMEOUT) event = ARTIM_TIMER_EXPIRED;
@@ -1267,11 +1415,83 @@ DUL_ReadPDVs(DUL_ASSOCIATIONKEY ** callerAssociation,
 
     /* call the finite state machine to invoke an action function given the current */
     /* event and state (captured in (*association)->protocolState) */
-    cond = PRV_StateMachine(NULL, association, event,
+    return PRV_StateMachine(NULL, association, event,
                             (*association)->protocolState, pdvList);
+}
 
-    /* return result value */
-    return cond;
+
+/* DUL_ReadPDVFragment
+**
+** Purpose:
+**      Receive the data fragment of the next PDV directly from the network
+**      into the caller's buffer, i.e. without reading the complete PDU into
+**      the Association's PDU buffer first. This avoids copying the data,
+**      and the headers of the next PDU and PDV are requested with the same
+**      read operation as the data fragment, where possible.
+**      Only data set PDVs of the given presentation context are received
+**      this way while the Association is in the data transfer state. All
+**      other PDVs are made available through DUL_NextPDV() instead, and all
+**      other PDUs are handled like in DUL_ReadPDVs().
+**
+** Parameter Dictionary:
+**      callerAssociation      Caller's handle for the Association.
+**      block                  Option used for blocking/non-blocking read.
+**      timeout                Timeout interval.
+**      presentationContextID  Presentation context of the PDVs to be
+**                             received, 0 for any presentation context.
+**      buffer                 Buffer for the data fragment.
+**      bufferLength           Size of the buffer. If the data fragment is
+**                             larger, only the first bufferLength bytes are
+**                             returned and the rest is returned by the next
+**                             call(s) of this function. If the buffer is
+**                             larger than the fragment, the remaining space
+**                             may be used as scratch space.
+**      pdv                    The PDV received. pdv->data points to buffer,
+**                             pdv->fragmentLength contains the number of bytes
+**                             received, and pdv->lastPDV is only set if the
+**                             last fragment of a data set has been completed.
+**
+** Return Values:
+**
+**      EC_Normal if (a part of) a data fragment has been received,
+**      DUL_PDATAPDUARRIVED if PDVs are available through DUL_NextPDV(),
+**      otherwise the same return values as DUL_ReadPDVs().
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+OFCondition
+DUL_ReadPDVFragment(DUL_ASSOCIATIONKEY ** callerAssociation,
+                    DUL_BLOCKOPTIONS block, int timeout,
+                    DUL_PRESENTATIONCONTEXTID presentationContextID,
+                    void *buffer, unsigned long bufferLength, DUL_PDV * pdv)
+{
+    PRIVATE_ASSOCIATIONKEY
+        ** association;
+    unsigned char
+        pduType = 0;
+
+    /* assign the association to local variable */
+    association = (PRIVATE_ASSOCIATIONKEY **) callerAssociation;
+
+    /* check if association is valid, if not return an error */
+    OFCondition cond = checkAssociation(association);
+    if (cond.bad()) return cond;
+    if ((buffer == NULL) || (pdv == NULL)) return DUL_NULLKEY;
+
+    /* PDVs that have already been read have to be processed first */
+    if ((*association)->pdvIndex != -1) return DUL_PDATAPDUARRIVED;
+
+    if (((*association)->directPDULength == 0) && ((*association)->directFragmentLength == 0))
+    {
+        /* we need a new PDU. Anything else than a P-DATA-TF PDU in the */
+        /* data transfer state is handled by the state machine as usual. */
+        cond = PRV_NextPDUType(association, block, timeout, &pduType);
+        if (cond.bad() || (pduType != DUL_TYPEDATA) || ((*association)->protocolState != STATE6))
+            return indicateNextPDU(association, NULL, block, cond, pduType);
+    }
+    return PRV_ReadPDVFragment(association, block, timeout, presentationContextID,
+                               OFstatic_cast(unsigned char *, buffer), bufferLength, pdv);
 }
 
 
@@ -1533,8 +1753,10 @@ receiveTransportConnection(PRIVATE_NETWORKKEY ** network,
 /* receiveTransportConnectionTCP
 **
 ** Purpose:
-**      Receive a TCP transport connection and fill in the fields of the
-**      service parameters and the Association handle.
+**      Receive a TCP transport connection and create the transport
+**      connection of the Association handle. The transport connection is
+**      identified by identifyTransportConnection() and the handshake of the
+**      secure transport layer is performed by DUL_ReadAssociationRQ().
 **
 ** Parameter Dictionary:
 **      network      Pointer to a structure maintaining information about
@@ -1980,6 +2202,83 @@ receiveTransportConnectionTCP(PRIVATE_NETWORKKEY ** network,
 #endif
     }
 
+    if ((*association)->connection) delete (*association)->connection;
+
+    if ((*network)->networkSpecific.TCP.tLayer)
+    {
+      (*association)->connection = ((*network)->networkSpecific.TCP.tLayer)->createConnection(sock, params->useSecureLayer);
+    }
+    else (*association)->connection = NULL;
+
+    if ((*association)->connection == NULL)
+    {
+#ifdef HAVE_WINSOCK_H
+      (void) shutdown(sock,  1 /* SD_SEND */);
+      (void) closesocket(sock);
+#else
+      (void) close(sock);
+#endif
+      OFString msg = "TCP Initialization Error: ";
+      msg += OFStandard::getLastNetworkErrorCode().message();
+      return makeDcmnetCondition(DULC_TCPINITERROR, OF_error, msg.c_str());
+    }
+
+    return EC_Normal;
+}
+
+
+/* identifyTransportConnection
+**
+** Purpose:
+**      Determine the address (and, unless disabled, the host name) of the
+**      peer of a transport connection that has been received by
+**      receiveTransportConnection(), fill in the corresponding fields of the
+**      service parameters and the Association handle, and enforce the
+**      access control of the TCP wrapper (if enabled).
+**
+** Parameter Dictionary:
+**      network      Pointer to a structure maintaining information about
+**                   the network environment.
+**      params       Pointer to structure describing the services for the
+**                   Association.
+**      association  Handle to the association
+**
+** Return Values:
+**
+** Notes:
+**      This is separate from receiveTransportConnection() because the
+**      reverse DNS lookup may take some time, see DUL_AcceptTransportConnection().
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+static OFCondition
+identifyTransportConnection(PRIVATE_NETWORKKEY ** network,
+                            DUL_ASSOCIATESERVICEPARAMETERS * params,
+                            PRIVATE_ASSOCIATIONKEY ** association)
+{
+#ifdef HAVE_DECLARATION_SOCKLEN_T
+    socklen_t len;
+#elif !defined(HAVE_PROTOTYPE_ACCEPT) || defined(HAVE_INTP_ACCEPT)
+    int len;
+#else
+    size_t len;
+#endif
+    struct sockaddr from;
+
+    if ((*association)->connection == NULL) return DUL_NULLKEY;
+    DcmNativeSocketType sock = (*association)->connection->getSocket();
+
+    len = sizeof(from);
+    if (getpeername(sock, &from, &len))
+    {
+        OFOStringStream stream;
+        stream << "TCP Initialization Error: " << OFStandard::getLastNetworkErrorCode().message()
+               << ", getpeername failed on socket " << sock << OFStringStream_ends;
+        OFSTRINGSTREAM_GETOFSTRING(stream, msg)
+        return makeDcmnetCondition(DULC_TCPINITERROR, OF_error, msg.c_str());
+    }
+
     // create string containing numerical IP address.
     OFString client_dns_name;
     char client_ip_address[20];
@@ -2031,12 +2330,6 @@ receiveTransportConnectionTCP(PRIVATE_NETWORKKEY ** network,
 
         if (! dcmtk_hosts_access(&request))
         {
-#ifdef HAVE_WINSOCK_H
-          (void) shutdown(sock,  1 /* SD_SEND */);
-          (void) closesocket(sock);
-#else
-          (void) close(sock);
-#endif
           OFOStringStream stream;
           stream << "TCP wrapper: denied connection from " << client_dns_name
                  << " (" << client_ip_address << ")" << OFStringStream_ends;
@@ -2046,28 +2339,8 @@ receiveTransportConnectionTCP(PRIVATE_NETWORKKEY ** network,
     }
 #endif
 
-    if ((*association)->connection) delete (*association)->connection;
-
-    if ((*network)->networkSpecific.TCP.tLayer)
-    {
-      (*association)->connection = ((*network)->networkSpecific.TCP.tLayer)->createConnection(sock, params->useSecureLayer);
-    }
-    else (*association)->connection = NULL;
-
-    if ((*association)->connection == NULL)
-    {
-#ifdef HAVE_WINSOCK_H
-      (void) shutdown(sock,  1 /* SD_SEND */);
-      (void) closesocket(sock);
-#else
-      (void) close(sock);
-#endif
-      OFString msg = "TCP Initialization Error: ";
-      msg += OFStandard::getLastNetworkErrorCode().message();
-      return makeDcmnetCondition(DULC_TCPINITERROR, OF_error, msg.c_str());
-    }
 
-    return (*association)->connection->serverSideHandshake();
+    return EC_Normal;
 }
 
 
@@ -2345,6 +2618,16 @@ createAssociationKey(PRIVATE_NETWORKKEY ** networkKey,
     key->logHandle = NULL;
     key->connection = NULL;
     key->modeCallback = NULL;
+
+    key->lookaheadLength = 0;
+    key->receiveBuffer = NULL;
+    key->receiveBufferSize = 0;
+    key->receiveBufferLength = 0;
+    key->receiveBufferOffset = 0;
+    key->directPDULength = 0;
+    key->directFragmentLength = 0;
+    (void) memset(&key->directPDV, 0, sizeof(key->directPDV));
+    (void) memset(&key->statistics, 0, sizeof(key->statistics));
     *associationKey = key;
     return EC_Normal;
 }
@@ -2370,6 +2653,7 @@ static void
 destroyAssociationKey(PRIVATE_ASSOCIATIONKEY ** key)
 {
     if (*key && (*key)->connection) delete (*key)->connection;
+    if (*key) free((*key)->receiveBuffer);
     free(*key);
     *key = NULL;
 }
@@ -2498,6 +2782,10 @@ DUL_DumpParams(OFString& ret_str, DUL_ASSOCIATESERVICEPARAMETERS * params)
         << "AP TITLE:     " << params->respondingAPTitle << OFendl
         << "MAX PDU:      " << (int)params->maxPDU << OFendl
         << "Peer MAX PDU: " << (int)params->peerMaxPDU << OFendl
+        << "ASYNC OPS:    " << params->maximumOperationsInvoked << "/"
+        << params->maximumOperationsPerformed << OFendl
+        << "Peer ASYNC:   " << params->peerMaximumOperationsInvoked << "/"
+        << params->peerMaximumOperationsPerformed << OFendl
         << "PRES ADDR:    " << params->callingPresentationAddress << OFendl
         << "PRES ADDR:    " << params->calledPresentationAddress << OFendl
         << "REQ IMP UID:  " << params->callingImplementationClassUID << OFendl;
@@ -2776,6 +3064,8 @@ clearRequestorsParams(DUL_ASSOCIATESERVICEPARAMETERS * params)
     params->acceptedPresentationContext = NULL;
     params->maximumOperationsInvoked = 0;
     params->maximumOperationsPerformed = 0;
+    params->peerMaximumOperationsInvoked = 0;
+    params->peerMaximumOperationsPerformed = 0;
     params->callingImplementationClassUID[0] = '\0';
     params->callingImplementationVersionName[0] = '\0';
     params->requestedExtNegList = NULL;
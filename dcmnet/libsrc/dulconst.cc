@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -92,6 +92,10 @@ static OFCondition
 constructMaxLength(unsigned long maxPDU, DUL_MAXLENGTH * max,
                    unsigned long *rtnLen);
 static OFCondition
+constructAsyncOperations(DUL_ASSOCIATESERVICEPARAMETERS * params,
+                         PRV_ASYNCOPERATIONS * async,
+                         unsigned long *rtnLen);
+static OFCondition
 constructSCUSCPRoles(unsigned char type,
                      DUL_ASSOCIATESERVICEPARAMETERS * params,
                      LST_HEAD ** lst,
@@ -113,6 +117,9 @@ streamUserInfo(DUL_USERINFO * userInfo, unsigned char *b,
 static OFCondition
 streamMaxLength(DUL_MAXLENGTH * max, unsigned char *b,
                 unsigned long *length);
+static OFCondition
+streamAsyncOperations(PRV_ASYNCOPERATIONS * async, unsigned char *b,
+                      unsigned long *length);
 static OFCondition
     streamSCUSCPList(LST_HEAD ** lst, unsigned char *b, unsigned long *length);
 static OFCondition
@@ -845,7 +852,11 @@ constructUserInfo(unsigned char type, DUL_ASSOCIATESERVICEPARAMETERS * params,
     totalUserInfoLength += length;
     *rtnLen += length;
 
-    // user info sub-item 53H (async operations) is not yet implemented!
+    // construct user info sub-item 53H: asynchronous operations window
+    cond = constructAsyncOperations(params, &userInfo->asyncOperations, &length);
+    if (cond.bad()) return cond;
+    totalUserInfoLength += length;
+    *rtnLen += length;
 
     // construct user info sub-item 55H: implementation version name
     if (type == DUL_TYPEASSOCIATERQ) {
@@ -945,6 +956,48 @@ constructMaxLength(unsigned long maxPDU, DUL_MAXLENGTH * max,
 }
 
 
+/* constructAsyncOperations
+**
+** Purpose:
+**  Construct the Asynchronous Operations Window part of the PDU. The
+**  sub-item is only sent if the window differs from the default of one
+**  outstanding operation in each direction. A window of 0/0 in the
+**  service parameters means that no window is negotiated at all.
+**
+** Parameter Dictionary:
+**  params    Service parameters describing the Association
+**  async     The Asynchronous Operations Window that is to be constructed
+**  rtnLength Length of the sub-item constructed (0 if not sent).
+**
+** Return Values:
+**
+** Algorithm:
+**  Description of the algorithm (optional) and any other notes.
+*/
+
+static OFCondition
+constructAsyncOperations(DUL_ASSOCIATESERVICEPARAMETERS * params,
+       PRV_ASYNCOPERATIONS * async, unsigned long *rtnLen)
+{
+    async->type = DUL_TYPEASYNCOPERATIONS;
+    async->rsv1 = 0;
+    async->maximumOperationsInvoked = params->maximumOperationsInvoked;
+    async->maximumOperationsProvided = params->maximumOperationsPerformed;
+    if (((params->maximumOperationsInvoked == 0) && (params->maximumOperationsPerformed == 0)) ||
+        ((params->maximumOperationsInvoked == 1) && (params->maximumOperationsPerformed == 1)))
+    {
+        async->length = 0;
+        *rtnLen = 0;
+    }
+    else
+    {
+        async->length = 4;
+        *rtnLen = 8;
+    }
+    return EC_Normal;
+}
+
+
 /* constructSCUSCPRoles
 **
 ** Purpose:
@@ -1298,7 +1351,14 @@ streamUserInfo(DUL_USERINFO * userInfo, unsigned char *b,
     b += subLength;
     *length += subLength;
 
-    // user info sub-item 53H (async operations) is not yet implemented!
+    // stream user info sub-item 53H: asynchronous operations window
+    if (userInfo->asyncOperations.length != 0) {
+        cond = streamAsyncOperations(&userInfo->asyncOperations, b, &subLength);
+        if (cond.bad())
+            return cond;
+        b += subLength;
+        *length += subLength;
+    }
 
 #ifdef OLD_USER_INFO_SUB_ITEM_ORDER
     /* prior DCMTK releases did not encode user information sub items
@@ -1389,6 +1449,38 @@ streamMaxLength(DUL_MAXLENGTH * max, unsigned char *b,
     return EC_Normal;
 }
 
+/* streamAsyncOperations
+**
+** Purpose:
+**  Convert the Asynchronous Operations Window structure into stream format
+**
+** Parameter Dictionary:
+**  async     Asynchronous Operations Window to be converted to stream format
+**  b         The stream version (output)
+**  length    Length of the stream version
+**
+** Return Values:
+**
+** Algorithm:
+**  Description of the algorithm (optional) and any other notes.
+*/
+static OFCondition
+streamAsyncOperations(PRV_ASYNCOPERATIONS * async, unsigned char *b,
+    unsigned long *length)
+{
+
+    *b++ = async->type;
+    *b++ = async->rsv1;
+    COPY_SHORT_BIG(async->length, b);
+    b += 2;
+    COPY_SHORT_BIG(async->maximumOperationsInvoked, b);
+    b += 2;
+    COPY_SHORT_BIG(async->maximumOperationsProvided, b);
+
+    *length = 8;
+    return EC_Normal;
+}
+
 /* streamSCUSCPList
 **
 ** Purpose:
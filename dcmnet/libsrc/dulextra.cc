@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2021, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -100,15 +100,271 @@
 #include "dulpriv.h"
 #include "dcmtk/dcmnet/dcmtrans.h"
 #include "dcmtk/dcmnet/diutil.h"
+#include "dcmtk/ofstd/ofstd.h"
+
+/* platform independent definition of EINTR */
+enum
+{
+#ifdef HAVE_WINSOCK_H
+    DCMNET_EINTR = WSAEINTR
+#else
+    DCMNET_EINTR = EINTR
+#endif
+};
+
+/* initial size of the buffer allocated by DUL_receiveAvailableData() */
+#define DUL_INITIALRECEIVEBUFFERSIZE 16384
+
+/* value of the Command Data Set Type (0000,0800) if no data set follows */
+#define DUL_COMMANDDATASETTYPE_NULL 0x0101
 
 OFBool
 DUL_dataWaiting(DUL_ASSOCIATIONKEY * callerAssociation, int timeout)
 {
     PRIVATE_ASSOCIATIONKEY * association = (PRIVATE_ASSOCIATIONKEY *)callerAssociation;
     if ((association==NULL)||(association->connection == NULL)) return OFFalse;
+    /* data that has already been received ahead of time is not visible on the connection */
+    if (DUL_bufferedDataWaiting(callerAssociation)) return OFTrue;
     return association->connection->networkDataAvailable(timeout);
 }
 
+OFBool
+DUL_bufferedDataWaiting(DUL_ASSOCIATIONKEY * callerAssociation)
+{
+    return (DUL_bufferedDataLength(callerAssociation) > 0);
+}
+
+unsigned long
+DUL_bufferedDataLength(DUL_ASSOCIATIONKEY * callerAssociation)
+{
+    PRIVATE_ASSOCIATIONKEY * association = (PRIVATE_ASSOCIATIONKEY *)callerAssociation;
+    if (association==NULL) return 0;
+    return association->lookaheadLength + association->receiveBufferLength - association->receiveBufferOffset;
+}
+
+/* makes sure that the receive buffer of the association can hold at least
+ * the given number of bytes, keeping the bytes already stored in it
+ */
+static OFCondition
+reserveReceiveBuffer(PRIVATE_ASSOCIATIONKEY * association, unsigned long size)
+{
+    if (size <= association->receiveBufferSize) return EC_Normal;
+    unsigned char *buffer = (unsigned char *) realloc(association->receiveBuffer, size_t(size));
+    if (buffer == NULL) return EC_MemoryExhausted;
+    association->receiveBuffer = buffer;
+    association->receiveBufferSize = size;
+    return EC_Normal;
+}
+
+OFCondition
+DUL_receiveAvailableData(DUL_ASSOCIATIONKEY * callerAssociation, unsigned long maxLength)
+{
+    PRIVATE_ASSOCIATIONKEY * association = (PRIVATE_ASSOCIATIONKEY *)callerAssociation;
+    if ((association==NULL)||(association->connection == NULL)) return DUL_NULLKEY;
+    if (!association->connection->isTransparentConnection()) return DUL_ILLEGALREQUEST;
+
+    /* move the unread bytes to the front of the buffer, preceded by the
+     * lookahead bytes, so that the buffer holds all bytes received ahead of time
+     */
+    if ((association->lookaheadLength > 0) || (association->receiveBufferOffset > 0))
+    {
+        const unsigned long unread = association->receiveBufferLength - association->receiveBufferOffset;
+        OFCondition cond = reserveReceiveBuffer(association, association->lookaheadLength + unread);
+        if (cond.bad()) return cond;
+        if (unread > 0)
+            memmove(association->receiveBuffer + association->lookaheadLength,
+                association->receiveBuffer + association->receiveBufferOffset, size_t(unread));
+        if (association->lookaheadLength > 0)
+            memcpy(association->receiveBuffer, association->lookahead, size_t(association->lookaheadLength));
+        association->receiveBufferLength = association->lookaheadLength + unread;
+        association->receiveBufferOffset = 0;
+        association->lookaheadLength = 0;
+    }
+
+    while ((association->receiveBufferLength < maxLength) && association->connection->networkDataAvailable(0))
+    {
+        if (association->receiveBufferLength == association->receiveBufferSize)
+        {
+            /* grow the buffer geometrically, but not beyond the limit */
+            unsigned long size = (association->receiveBufferSize > 0) ? 2 * association->receiveBufferSize : DUL_INITIALRECEIVEBUFFERSIZE;
+            if (size > maxLength) size = maxLength;
+            OFCondition cond = reserveReceiveBuffer(association, size);
+            if (cond.bad()) return cond;
+        }
+        ssize_t bytesRead;
+        do
+        {
+            bytesRead = association->connection->read(association->receiveBuffer + association->receiveBufferLength,
+                size_t(association->receiveBufferSize - association->receiveBufferLength));
+        } while (bytesRead == -1 && OFStandard::getLastNetworkErrorCode().value() == DCMNET_EINTR);
+        if (bytesRead <= 0) return DUL_NETWORKCLOSED;
+        association->statistics.bytesReceived += (unsigned long) bytesRead;
+        association->receiveBufferLength += (unsigned long) bytesRead;
+    }
+    return EC_Normal;
+}
+
+/* returns the byte at the given position of the bytes received ahead of
+ * time, which are the lookahead bytes followed by the receive buffer
+ */
+static unsigned char
+bufferedByte(const PRIVATE_ASSOCIATIONKEY * association, unsigned long pos)
+{
+    if (pos < association->lookaheadLength) return association->lookahead[pos];
+    return association->receiveBuffer[association->receiveBufferOffset + pos - association->lookaheadLength];
+}
+
+/* returns the 32-bit big endian number at the given position of the bytes received ahead of time */
+static unsigned long
+bufferedLength(const PRIVATE_ASSOCIATIONKEY * association, unsigned long pos)
+{
+    return (((unsigned long) bufferedByte(association, pos)) << 24) |
+           (((unsigned long) bufferedByte(association, pos + 1)) << 16) |
+           (((unsigned long) bufferedByte(association, pos + 2)) << 8) |
+           ((unsigned long) bufferedByte(association, pos + 3));
+}
+
+/* returns OFTrue if the given command set (encoded in implicit VR little
+ * endian) announces a data set. A command set without Command Data Set Type
+ * is treated as if no data set followed, the command will be rejected anyway.
+ */
+static OFBool
+commandHasDataSet(const OFString& command)
+{
+    const unsigned char *p = (const unsigned char *) command.data();
+    const size_t length = command.length();
+    size_t pos = 0;
+    while (pos + 8 <= length)
+    {
+        const unsigned int group = p[pos] | (p[pos + 1] << 8);
+        const unsigned int element = p[pos + 2] | (p[pos + 3] << 8);
+        const unsigned long valueLength = ((unsigned long) p[pos + 4]) | (((unsigned long) p[pos + 5]) << 8) |
+            (((unsigned long) p[pos + 6]) << 16) | (((unsigned long) p[pos + 7]) << 24);
+        pos += 8;
+        if ((group == 0x0000) && (element == 0x0800))
+            return (valueLength >= 2) && (pos + 2 <= length) &&
+                ((p[pos] | (p[pos + 1] << 8)) != DUL_COMMANDDATASETTYPE_NULL);
+        if (valueLength > length - pos) break;
+        pos += valueLength;
+    }
+    return OFFalse;
+}
+
+/* updates the state of the message that is being checked by
+ * DUL_bufferedMessageComplete() with the given PDV. Returns OFTrue if the
+ * message is complete, i.e. if this is the last fragment of a command
+ * without data set, or the last fragment of the data set.
+ */
+static OFBool
+messageCompletedByPDV(OFString& command, OFBool& commandComplete,
+    unsigned char header, const OFString& fragment)
+{
+    if (header & 1)
+    {
+        /* command fragment */
+        if (!commandComplete)
+        {
+            command += fragment;
+            if (header & 2)
+            {
+                commandComplete = OFTrue;
+                return !commandHasDataSet(command);
+            }
+        }
+        return OFFalse;
+    }
+    /* last fragment of the data set */
+    return (header & 2) ? OFTrue : OFFalse;
+}
+
+OFBool
+DUL_bufferedMessageComplete(DUL_ASSOCIATIONKEY * callerAssociation)
+{
+    PRIVATE_ASSOCIATIONKEY * association = (PRIVATE_ASSOCIATIONKEY *)callerAssociation;
+    if (association==NULL) return OFFalse;
+
+    OFString command;
+    OFString fragment;
+    OFBool commandComplete = OFFalse;
+
+    /* the message may start with the unprocessed PDVs of the PDU most
+     * recently read, see DUL_NextPDV()
+     */
+    if (association->pdvIndex != -1)
+    {
+        DUL_PDV pdv = association->currentPDV;
+        unsigned char *p = association->pdvPointer;
+        for (int index = association->pdvIndex; index < association->pdvCount; ++index)
+        {
+            if (index > association->pdvIndex)
+            {
+                /* the next PDV follows the fragment of the previous one */
+                p += pdv.fragmentLength + 2 + 4;
+                unsigned long pdvLength;
+                EXTRACT_LONG_BIG(p, pdvLength);
+                pdv.fragmentLength = pdvLength - 2;
+                pdv.pdvType = (p[5] & 1) ? DUL_COMMANDPDV : DUL_DATASETPDV;
+                pdv.lastPDV = (p[5] & 2) ? OFTrue : OFFalse;
+                pdv.data = p + 6;
+            }
+            const unsigned char header = OFstatic_cast(unsigned char,
+                ((pdv.pdvType == DUL_COMMANDPDV) ? 1 : 0) | (pdv.lastPDV ? 2 : 0));
+            if (pdv.pdvType == DUL_COMMANDPDV)
+                fragment.assign(OFstatic_cast(const char *, pdv.data), size_t(pdv.fragmentLength));
+            if (messageCompletedByPDV(command, commandComplete, header, fragment)) return OFTrue;
+        }
+    }
+
+    const unsigned long length = DUL_bufferedDataLength(callerAssociation);
+    unsigned long pos = 0;
+    while (length - pos >= 6)
+    {
+        const unsigned char pduType = bufferedByte(association, pos);
+        const unsigned long pduLength = bufferedLength(association, pos + 2);
+        pos += 6;
+        if (pduLength > length - pos) return OFFalse;
+        /* any other PDU than P-DATA-TF is handled on its own */
+        if (pduType != DUL_TYPEDATA) return OFTrue;
+
+        const unsigned long pduEnd = pos + pduLength;
+        while (pduEnd - pos >= 6)
+        {
+            const unsigned long pdvLength = bufferedLength(association, pos);
+            if ((pdvLength < 2) || (pdvLength > pduEnd - pos - 4)) return OFTrue;
+            const unsigned char header = bufferedByte(association, pos + 5);
+            const unsigned long fragmentStart = pos + 6;
+            pos += 4 + pdvLength;
+            fragment.clear();
+            if ((header & 1) && !commandComplete)
+            {
+                for (unsigned long i = fragmentStart; i < pos; ++i)
+                    fragment += OFstatic_cast(char, bufferedByte(association, i));
+            }
+            if (messageCompletedByPDV(command, commandComplete, header, fragment)) return OFTrue;
+        }
+        if (pos != pduEnd) return OFTrue;
+    }
+    return OFFalse;
+}
+
+OFBool
+DUL_unprocessedPDVs(DUL_ASSOCIATIONKEY * callerAssociation)
+{
+    PRIVATE_ASSOCIATIONKEY * association = (PRIVATE_ASSOCIATIONKEY *)callerAssociation;
+    if (association==NULL) return OFFalse;
+    return (association->pdvIndex != -1);
+}
+
+OFBool
+DUL_getAssociationStatistics(DUL_ASSOCIATIONKEY * callerAssociation,
+    DUL_ASSOCIATIONSTATISTICS * statistics)
+{
+    PRIVATE_ASSOCIATIONKEY * association = (PRIVATE_ASSOCIATIONKEY *)callerAssociation;
+    if ((association==NULL)||(statistics==NULL)) return OFFalse;
+    *statistics = association->statistics;
+    return OFTrue;
+}
+
 DcmTransportConnection *DUL_getTransportConnection(DUL_ASSOCIATIONKEY * callerAssociation)
 {
   if (callerAssociation == NULL) return NULL;
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -110,12 +110,13 @@ END_EXTERN_C
 #include "dulfsm.h"
 #include "dcmtk/ofstd/ofbmanip.h"
 #include "dcmtk/ofstd/ofconsol.h"
-#include "dcmtk/dcmnet/assoc.h"    /* for ASC_MAXIMUMPDUSIZE */
+#include "dcmtk/dcmnet/assoc.h"    /* for ASC_LARGESTPDUSIZE */
 #include "dcmtk/dcmnet/dcmtrans.h"
 #include "dcmtk/dcmnet/dcmlayer.h"
 #include "dcmtk/dcmnet/diutil.h"
 #include "dcmtk/dcmnet/helpers.h"
 #include "dcmtk/ofstd/ofsockad.h" /* for class OFSockAddr */
+#include "dcmtk/ofstd/oftimer.h"
 #include <ctime>
 #include <climits>
 
@@ -124,6 +125,9 @@ END_EXTERN_C
 #define INADDR_NONE 0xffffffff
 #endif
 
+/* maximum number of P-DATA-TF PDUs that are sent with a single write operation */
+#define DUL_MAXGATHEREDPDUS 16
+
 /* platform independent definition of EINTR */
 enum
 {
@@ -165,6 +169,9 @@ DT_1_SendPData(PRIVATE_NETWORKKEY ** network,
 static OFCondition
 DT_2_IndicatePData(PRIVATE_NETWORKKEY ** network,
         PRIVATE_ASSOCIATIONKEY ** association, int nextState, void *params);
+static OFCondition
+indicatePDVs(PRIVATE_ASSOCIATIONKEY ** association,
+        unsigned char pduType, unsigned long pduLength);
 
 static OFCondition
 AA_1_SendAAbort(PRIVATE_NETWORKKEY ** network,
@@ -249,8 +256,8 @@ static OFCondition
 sendPDataTCP(PRIVATE_ASSOCIATIONKEY ** association,
              DUL_PDVLIST * pdvList);
 static OFCondition
-writeDataPDU(PRIVATE_ASSOCIATIONKEY ** association,
-             DUL_DATAPDU * pdu);
+writeDataPDUs(PRIVATE_ASSOCIATIONKEY ** association,
+              DcmTransportBuffer * buffers, size_t count);
 static void clearPDUCache(PRIVATE_ASSOCIATIONKEY ** association);
 static void closeTransport(PRIVATE_ASSOCIATIONKEY ** association);
 static void closeTransportTCP(PRIVATE_ASSOCIATIONKEY ** association);
@@ -284,8 +291,18 @@ readPDUBodyTCP(PRIVATE_ASSOCIATIONKEY ** association,
                unsigned char *pduType, unsigned char *pduReserved,
                unsigned long *pduLength);
 static OFCondition
-defragmentTCP(DcmTransportConnection *connection, DUL_BLOCKOPTIONS block, time_t timerStart,
-              int timeout, void *b, unsigned long l, unsigned long *rtnLen);
+defragmentTCP(PRIVATE_ASSOCIATIONKEY ** association, DUL_BLOCKOPTIONS block, time_t timerStart,
+              int timeout, void *b, unsigned long l, unsigned long *rtnLen,
+              unsigned long lookahead = 0);
+static int
+writeToConnection(PRIVATE_ASSOCIATIONKEY ** association, void *b, unsigned long l);
+static OFCondition
+bufferPendingPDVs(PRIVATE_ASSOCIATIONKEY ** association, DUL_BLOCKOPTIONS block,
+                  int timeout, OFBool includeCurrentPDV);
+
+static void
+setPeerAsyncOperations(DUL_ASSOCIATESERVICEPARAMETERS * service,
+                       PRV_ASYNCOPERATIONS * async);
 
 static OFString dump_pdu(const char *type, void *buffer, unsigned long length);
 
@@ -888,10 +905,10 @@ AE_3_AssociateConfirmationAccept(PRIVATE_NETWORKKEY ** /*network*/,
     * service;
     unsigned char
         * buffer = NULL,
-        pduType,
-        pduReserve;
+        pduType = 0,
+        pduReserve = 0;
     unsigned long
-        pduLength;
+        pduLength = 0;
     PRV_ASSOCIATEPDU
         assoc;
     PRV_PRESENTATIONCONTEXTITEM
@@ -1016,6 +1033,7 @@ AE_3_AssociateConfirmationAccept(PRIVATE_NETWORKKEY ** /*network*/,
         destroyAssociatePDUPresentationContextList(&assoc.presentationContextList);
         destroyUserInformationLists(&assoc.userInfo);
         service->peerMaxPDU = assoc.userInfo.maxLength.maxLength;
+        setPeerAsyncOperations(service, &assoc.userInfo.asyncOperations);
         (*association)->maxPDV = assoc.userInfo.maxLength.maxLength;
         (*association)->maxPDVAcceptor =
             assoc.userInfo.maxLength.maxLength;
@@ -1061,10 +1079,10 @@ AE_4_AssociateConfirmationReject(PRIVATE_NETWORKKEY ** /*network*/,
     * service;
     unsigned char
         buffer[128],
-        pduType,
-        pduReserve;
+        pduType = 0,
+        pduReserve = 0;
     unsigned long
-        pduLength;
+        pduLength = 0;
 
     service = (DUL_ASSOCIATESERVICEPARAMETERS *) params;
     OFCondition cond = readPDUBody(association, DUL_BLOCK, 0, buffer, sizeof(buffer),
@@ -1151,10 +1169,10 @@ AE_6_ExamineAssociateRequest(PRIVATE_NETWORKKEY ** /*network*/,
     * service;
     unsigned char
         *buffer=NULL,
-        pduType,
-        pduReserve;
+        pduType = 0,
+        pduReserve = 0;
     unsigned long
-        pduLength;
+        pduLength = 0;
     PRV_ASSOCIATEPDU
         assoc;
 
@@ -1221,6 +1239,7 @@ AE_6_ExamineAssociateRequest(PRIVATE_NETWORKKEY ** /*network*/,
         }
 
         service->peerMaxPDU = assoc.userInfo.maxLength.maxLength;
+        setPeerAsyncOperations(service, &assoc.userInfo.asyncOperations);
         (*association)->maxPDV = assoc.userInfo.maxLength.maxLength;
         (*association)->maxPDVRequestor =
             assoc.userInfo.maxLength.maxLength;
@@ -1382,15 +1401,10 @@ DT_2_IndicatePData(PRIVATE_NETWORKKEY ** /*network*/,
          PRIVATE_ASSOCIATIONKEY ** association, int nextState, void * /*params*/)
 {
     unsigned char
-        pduType,
+        pduType = 0,
         pduReserved;
     unsigned long
-        pduLength,
-        pdvLength,
-        pdvCount,
-        length;
-    unsigned char
-       *p;
+        pduLength = 0;
 
     /* determine the finite state machine's next state */
     (*association)->protocolState = nextState;
@@ -1406,6 +1420,44 @@ DT_2_IndicatePData(PRIVATE_NETWORKKEY ** /*network*/,
     if (cond.bad())
         return cond;
 
+    /* make the PDVs available through DUL_NextPDV() */
+    return indicatePDVs(association, pduType, pduLength);
+}
+
+
+/* indicatePDVs
+**
+** Purpose:
+**      Check the PDVs of the P-DATA-TF PDU whose body is contained in the
+**      fragment buffer of the association, and make them available
+**      through DUL_NextPDV().
+**
+** Parameter Dictionary:
+**
+**      association     Handle to the Association
+**      pduType         Type of the PDU
+**      pduLength       Length of the PDU body in the fragment buffer
+**
+** Return Values:
+**
+**
+** Notes:
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+
+static OFCondition
+indicatePDVs(PRIVATE_ASSOCIATIONKEY ** association,
+             unsigned char pduType, unsigned long pduLength)
+{
+    unsigned long
+        pdvLength,
+        pdvCount,
+        length;
+    unsigned char
+       *p;
+
     /* count the amount of PDVs in the current PDU */
     length = pduLength;                     //set length to the PDU's length
     pdvCount = 0;                           //set counter variable to 0
@@ -1567,10 +1619,10 @@ AR_2_IndicateRelease(PRIVATE_NETWORKKEY ** /*network*/,
 {
     unsigned char
         buffer[128],
-        pduType,
-        pduReserve;
+        pduType = 0,
+        pduReserve = 0;
     unsigned long
-        pduLength;
+        pduLength = 0;
 
     /* Read remaining unimportant bytes of the A-RELEASE-RQ PDU */
     OFCondition cond = readPDUBody(association, DUL_BLOCK, 0, buffer, sizeof(buffer),
@@ -1617,10 +1669,10 @@ AR_3_ConfirmRelease(PRIVATE_NETWORKKEY ** /*network*/,
 {
     unsigned char
         buffer[128],
-        pduType,
-        pduReserve;
+        pduType = 0,
+        pduReserve = 0;
     unsigned long
-        pduLength;
+        pduLength = 0;
 
     /* Read remaining unimportant bytes of the A-RELEASE-RSP PDU */
     OFCondition cond = readPDUBody(association, DUL_BLOCK, 0, buffer, sizeof(buffer),
@@ -1780,10 +1832,10 @@ AR_8_IndicateARelease(PRIVATE_NETWORKKEY ** /*network*/,
 
     unsigned char
         buffer[128],
-        pduType,
-        pduReserve;
+        pduType = 0,
+        pduReserve = 0;
     unsigned long
-        pduLength;
+        pduLength = 0;
 
     /* Read remaining unimportant bytes of the A-RELEASE-RQ PDU */
     OFCondition cond = readPDUBody(association, DUL_BLOCK, 0, buffer, sizeof(buffer),
@@ -1981,10 +2033,10 @@ AA_3_IndicatePeerAborted(PRIVATE_NETWORKKEY ** /*network*/,
 {
     unsigned char
         buffer[128],
-        pduType,
-        pduReserve;
+        pduType = 0,
+        pduReserve = 0;
     unsigned long
-        pduLength;
+        pduLength = 0;
 
     /* Read remaining unimportant bytes of the A-ABORT PDU */
     OFCondition cond = readPDUBody(association, DUL_BLOCK, 0, buffer, sizeof(buffer),
@@ -2109,7 +2161,7 @@ AA_6_IgnorePDU(PRIVATE_NETWORKKEY ** /*network*/,
     PDULength = l;
     while (PDULength > 0 && cond.good())
     {
-        cond = defragmentTCP((*association)->connection,
+        cond = defragmentTCP(association,
                              DUL_NOBLOCK, (*association)->timerStart,
                    (*association)->timeout, buffer, sizeof(buffer), &l);
         if (cond.bad()) return cond;
@@ -2593,9 +2645,7 @@ sendAssociationRQTCP(PRIVATE_NETWORKKEY ** /*network*/,
     if (cond.bad())
         return cond;
 
-    do {
-      nbytes = (*association)->connection ? (*association)->connection->write((char*)b, size_t(associateRequest.length + 6)) : 0;
-    } while (nbytes == -1 && OFStandard::getLastNetworkErrorCode().value() == DCMNET_EINTR);
+    nbytes = writeToConnection(association, b, associateRequest.length + 6);
     if ((unsigned long) nbytes != associateRequest.length + 6)
     {
       OFString msg = "TCP I/O Error (";
@@ -2676,9 +2726,7 @@ sendAssociationACTCP(PRIVATE_NETWORKKEY ** /*network*/,
 
     if (cond.bad()) return cond;
 
-    do {
-      nbytes = (*association)->connection ? (*association)->connection->write((char*)b, size_t(associateReply.length + 6)) : 0;
-    } while (nbytes == -1 && OFStandard::getLastNetworkErrorCode().value() == DCMNET_EINTR);
+    nbytes = writeToConnection(association, b, associateReply.length + 6);
     if ((unsigned long) nbytes != associateReply.length + 6)
     {
       OFString msg = "TCP I/O Error (";
@@ -2750,9 +2798,7 @@ sendAssociationRJTCP(PRIVATE_NETWORKKEY ** /*network*/,
 
     if (cond.good())
     {
-        do {
-          nbytes = (*association)->connection ? (*association)->connection->write((char*)b, size_t(pdu.length + 6)) : 0;
-        } while (nbytes == -1 && OFStandard::getLastNetworkErrorCode().value() == DCMNET_EINTR);
+        nbytes = writeToConnection(association, b, pdu.length + 6);
         if ((unsigned long) nbytes != pdu.length + 6)
         {
           OFString msg = "TCP I/O Error (";
@@ -2810,9 +2856,7 @@ sendAbortTCP(DUL_ABORTITEMS * abortItems,
     }
     cond = streamRejectReleaseAbortPDU(&pdu, b, pdu.length + 6, &length);
     if (cond.good()) {
-        do {
-          nbytes = (*association)->connection ? (*association)->connection->write((char*)b, size_t(pdu.length + 6)) : 0;
-        } while (nbytes == -1 && OFStandard::getLastNetworkErrorCode().value() == DCMNET_EINTR);
+        nbytes = writeToConnection(association, b, pdu.length + 6);
         if ((unsigned long) nbytes != pdu.length + 6)
         {
           OFString msg = "TCP I/O Error (";
@@ -2870,9 +2914,7 @@ sendReleaseRQTCP(PRIVATE_ASSOCIATIONKEY ** association)
     }
     cond = streamRejectReleaseAbortPDU(&pdu, b, pdu.length + 6, &length);
     if (cond.good()) {
-        do {
-          nbytes = (*association)->connection ? (*association)->connection->write((char*)b, size_t(pdu.length + 6)) : 0;
-        } while (nbytes == -1 && OFStandard::getLastNetworkErrorCode().value() == DCMNET_EINTR);
+        nbytes = writeToConnection(association, b, pdu.length + 6);
         if ((unsigned long) nbytes != pdu.length + 6)
         {
           OFString msg = "TCP I/O Error (";
@@ -2931,9 +2973,7 @@ sendReleaseRPTCP(PRIVATE_ASSOCIATIONKEY ** association)
     }
     cond = streamRejectReleaseAbortPDU(&pdu, b, pdu.length + 6, &length);
     if (cond.good()) {
-        do {
-          nbytes = (*association)->connection ? (*association)->connection->write((char*)b, size_t(pdu.length + 6)) : 0;
-        } while (nbytes == -1 && OFStandard::getLastNetworkErrorCode().value() == DCMNET_EINTR);
+        nbytes = writeToConnection(association, b, pdu.length + 6);
         if ((unsigned long) nbytes != pdu.length + 6)
         {
           OFString msg = "TCP I/O Error (";
@@ -2976,13 +3016,20 @@ sendPDataTCP(PRIVATE_ASSOCIATIONKEY ** association,
         count,
         length,
         pdvLength,
-        maxLength;
+        maxLength,
+        headLength;
 
     OFBool localLast;
     unsigned char *p;
     DUL_DATAPDU dataPDU;
     OFBool firstTrip;
 
+    /* PDU head information and gather list (one head and one data fragment */
+    /* per PDU) for the PDUs that are sent with a single write operation */
+    unsigned char heads[DUL_MAXGATHEREDPDUS][24];
+    DcmTransportBuffer buffers[2 * DUL_MAXGATHEREDPDUS];
+    size_t pduCount = 0;
+
     /* assign the amount of PDVs in the array and the PDV array itself to local variables */
     count = pdvList->count;
     pdv = pdvList->pdv;
@@ -2996,7 +3043,7 @@ sendPDataTCP(PRIVATE_ASSOCIATIONKEY ** association,
     OFCondition cond = EC_Normal;
 
     /* adjust maxLength (maximum length of a PDU) */
-    if (maxLength == 0) maxLength = ASC_MAXIMUMPDUSIZE - 12;
+    if (maxLength == 0) maxLength = ASC_LARGESTPDUSIZE - 12;
     else if (maxLength < 14)
     {
        char buf[256];
@@ -3029,8 +3076,23 @@ sendPDataTCP(PRIVATE_ASSOCIATIONKEY ** association,
             /* construct a data PDU */
             cond = constructDataPDU(p, pdvLength, pdv->pdvType,
                            pdv->presentationContextID, localLast, &dataPDU);
-            /* send the constructed PDU over the network */
-            cond = writeDataPDU(association, &dataPDU);
+            /* construct the PDU head information and add head and data fragment */
+            /* (i.e. the PDV data, which is not copied) to the gather list */
+            if (cond.good())
+                cond = streamDataPDUHead(&dataPDU, heads[pduCount], sizeof(heads[pduCount]), &headLength);
+            if (cond.good())
+            {
+                buffers[2 * pduCount].data = heads[pduCount];
+                buffers[2 * pduCount].length = headLength;
+                buffers[2 * pduCount + 1].data = p;
+                buffers[2 * pduCount + 1].length = pdvLength;
+                /* send the gathered PDUs over the network if the list is full */
+                if (++pduCount == DUL_MAXGATHEREDPDUS)
+                {
+                    cond = writeDataPDUs(association, buffers, 2 * pduCount);
+                    pduCount = 0;
+                }
+            }
 
             /* adjust the pointer to the data, so that he points to data which still has to be sent */
             p += pdvLength;
@@ -3041,75 +3103,86 @@ sendPDataTCP(PRIVATE_ASSOCIATIONKEY ** association,
         pdv++;
 
     }
+    /* send the remaining PDUs over the network */
+    if (cond.good() && (pduCount > 0))
+        cond = writeDataPDUs(association, buffers, 2 * pduCount);
     /* return corresponding result value */
     return cond;
 }
 
-/* writeDataPDU
+/* writeDataPDUs
 **
 ** Purpose:
-**      Send the data through the socket interface (for TCP).
+**      Send one or more data PDUs through the socket interface (for TCP),
+**      using a single gather write operation if possible.
 **
 ** Parameter Dictionary:
 **
 **      association     Handle to the Association
-**      pdu             The data unit that is to be sent thru the socket
+**      buffers         PDU head information and PDV data of the PDUs
+**                      that are to be sent thru the socket. The array is
+**                      modified by this function.
+**      count           Number of entries in the buffers array
 **
 ** Return Values:
 **
 **
 ** Notes:
+**      The PDU head information contains the PDU type, PDU reserved field,
+**      PDU length, PDV length, presentation context ID and message control
+**      header (note that our representation of a PDU can only contain one
+**      PDV). It is followed by the PDV data, which is sent directly from the
+**      caller's buffer without being copied.
 **
 ** Algorithm:
 **      Description of the algorithm (optional) and any other notes.
 */
 
 static OFCondition
-writeDataPDU(PRIVATE_ASSOCIATIONKEY ** association,
-             DUL_DATAPDU * pdu)
+writeDataPDUs(PRIVATE_ASSOCIATIONKEY ** association,
+              DcmTransportBuffer * buffers, size_t count)
 {
-    unsigned char
-        head[24];
-    unsigned long
-        length;
-    int
-        nbytes;
-
-    /* construct a stream variable that will contain PDU head information */
-    /* (in detail, this variable will contain PDU type, PDU reserved field, */
-    /* PDU length, PDV length, presentation context ID, message control header) */
-    /* (note that our representation of a PDU can only contain one PDV.) */
-    OFCondition cond = streamDataPDUHead(pdu, head, sizeof(head), &length);
-    if (cond.bad()) return cond;
+    ssize_t nbytes;
+    size_t written;
+    double start = OFTimer::getTime();
 
-    /* send the PDU head information (see above) */
-    do
+    while (count > 0)
     {
-      nbytes = (*association)->connection ? (*association)->connection->write((char*)head, size_t(length)) : 0;
-    } while (nbytes == -1 && OFStandard::getLastNetworkErrorCode().value() == DCMNET_EINTR);
+        /* skip buffers that have been sent completely (or are empty) */
+        if (buffers->length == 0)
+        {
+            ++buffers;
+            --count;
+            continue;
+        }
+        do {
+          nbytes = (*association)->connection ? (*association)->connection->writeBuffers(buffers, count) : 0;
+        } while (nbytes == -1 && OFStandard::getLastNetworkErrorCode().value() == DCMNET_EINTR);
+        if (nbytes <= 0) break;
+        (*association)->statistics.bytesSent += (unsigned long) nbytes;
 
-    /* if not all head information was sent, return an error */
-    if ((unsigned long) nbytes != length)
-    {
-        OFString msg = "TCP I/O Error (";
-        msg += OFStandard::getLastNetworkErrorCode().message();
-        msg += ") occurred in routine: writeDataPDU";
-        return makeDcmnetCondition(DULC_TCPIOERROR, OF_error, msg.c_str());
+        /* in case of a partial write, continue with the data not sent yet */
+        written = OFstatic_cast(size_t, nbytes);
+        while ((count > 0) && (written >= buffers->length))
+        {
+            written -= buffers->length;
+            ++buffers;
+            --count;
+        }
+        if (written > 0)
+        {
+            buffers->data = OFstatic_cast(unsigned char *, buffers->data) + written;
+            buffers->length -= written;
+        }
     }
+    (*association)->statistics.sendTime += OFTimer::getDiff(start);
 
-    /* send the PDU's PDV data (note that our representation of a PDU can only contain one PDV.) */
-    do
-    {
-      nbytes = (*association)->connection ? (*association)->connection->write((char*)pdu->presentationDataValue.data,
-        size_t(pdu->presentationDataValue.length - 2)) : 0;
-    } while (nbytes == -1 && OFStandard::getLastNetworkErrorCode().value() == DCMNET_EINTR);
-
-        /* if not all head information was sent, return an error */
-    if ((unsigned long) nbytes != pdu->presentationDataValue.length - 2)
+    /* if not all data was sent, return an error */
+    if (count > 0)
     {
         OFString msg = "TCP I/O Error (";
         msg += OFStandard::getLastNetworkErrorCode().message();
-        msg += ") occurred in routine: writeDataPDU";
+        msg += ") occurred in routine: writeDataPDUs";
         return makeDcmnetCondition(DULC_TCPIOERROR, OF_error, msg.c_str());
     }
 
@@ -3490,7 +3563,7 @@ readPDUHeadTCP(PRIVATE_ASSOCIATIONKEY ** association,
 
     /* try to receive PDU header (6 bytes) over the network, mind blocking */
     /* options; in the end, buffer will contain the 6 bytes that were read. */
-    OFCondition cond = defragmentTCP((*association)->connection, block, (*association)->timerStart, timeout, buffer, 6, &length);
+    OFCondition cond = defragmentTCP(association, block, (*association)->timerStart, timeout, buffer, 6, &length);
 
     /* if receiving was not successful, return the corresponding error value */
     if (cond.bad()) return cond;
@@ -3608,9 +3681,11 @@ readPDUBodyTCP(PRIVATE_ASSOCIATIONKEY ** association,
       /* PDVs of the current PDU are (*association)->nextPDULength bytes long. Hence, in detail */
       /* we want to try to receive (*association)->nextPDULength bytes of data on the network) */
       /* The information that was received will be available through the buffer variable. */
-      cond = defragmentTCP((*association)->connection,
+      double start = OFTimer::getTime();
+      cond = defragmentTCP(association,
                          block, (*association)->timerStart, timeout,
                          buffer, (*association)->nextPDULength, &length);
+      (*association)->statistics.receiveTime += OFTimer::getDiff(start);
     }
 
     /* return result value */
@@ -3625,7 +3700,7 @@ readPDUBodyTCP(PRIVATE_ASSOCIATIONKEY ** association,
 **      incoming socket stream.
 **
 ** Parameter Dictionary:
-**      sock            Socket descriptor
+**      association     Handle to the Association
 **      block           Blocking/non-blocking option
 **      timerStart      Time at which the reading operation is started.
 **      timeout         Timeout interval for reading
@@ -3633,12 +3708,24 @@ readPDUBodyTCP(PRIVATE_ASSOCIATIONKEY ** association,
 **      l               Maximum number of bytes to read
 **      rtnLength       Actual number of bytes that were read (returned
 **                      to the caller)
+**      lookahead       Number of bytes that may be requested in addition
+**                      to the l bytes. Bytes received in addition are kept
+**                      in the association and returned by the next call.
+**                      The buffer must provide space for l + lookahead
+**                      bytes.
 **
 **
 ** Return Values:
 **
 **
 ** Notes:
+**      The lookahead bytes are received with the same read operation as
+**      the requested bytes if they are already available, but this
+**      function never waits for them. Bytes received ahead of time are
+**      returned first, starting with the lookahead bytes, followed by the
+**      bytes buffered by DUL_receiveAvailableData(). Since the network
+**      connection is only read when both are exhausted, the order of the
+**      received bytes is preserved.
 **
 ** Algorithm:
 **      Description of the algorithm (optional) and any other notes.
@@ -3646,11 +3733,13 @@ readPDUBodyTCP(PRIVATE_ASSOCIATIONKEY ** association,
 
 
 static OFCondition
-defragmentTCP(DcmTransportConnection *connection, DUL_BLOCKOPTIONS block, time_t timerStart,
-              int timeout, void *p, unsigned long l, unsigned long *rtnLen)
+defragmentTCP(PRIVATE_ASSOCIATIONKEY ** association, DUL_BLOCKOPTIONS block, time_t timerStart,
+              int timeout, void *p, unsigned long l, unsigned long *rtnLen,
+              unsigned long lookahead)
 {
     unsigned char *b;
     int bytesRead;
+    DcmTransportConnection *connection = (*association)->connection;
 
     /* assign buffer to local variable */
     b = (unsigned char *) p;
@@ -3659,8 +3748,47 @@ defragmentTCP(DcmTransportConnection *connection, DUL_BLOCKOPTIONS block, time_t
     if (rtnLen != NULL)
         *rtnLen = 0;
 
+    /* first return the bytes that have been received ahead of time, if any */
+    if ((l > 0) && ((*association)->lookaheadLength > 0))
+    {
+        unsigned long count = (*association)->lookaheadLength;
+        if (count > l) count = l;
+        memcpy(b, (*association)->lookahead, size_t(count));
+        (*association)->lookaheadLength -= count;
+        if ((*association)->lookaheadLength > 0)
+            memmove((*association)->lookahead, (*association)->lookahead + count, size_t((*association)->lookaheadLength));
+        b += count;
+        l -= count;
+        if (rtnLen != NULL)
+            *rtnLen += count;
+    }
+
+    /* then the bytes that have been received by DUL_receiveAvailableData() */
+    if ((l > 0) && ((*association)->receiveBufferLength > (*association)->receiveBufferOffset))
+    {
+        unsigned long count = (*association)->receiveBufferLength - (*association)->receiveBufferOffset;
+        if (count > l) count = l;
+        memcpy(b, (*association)->receiveBuffer + (*association)->receiveBufferOffset, size_t(count));
+        (*association)->receiveBufferOffset += count;
+        if ((*association)->receiveBufferOffset == (*association)->receiveBufferLength)
+        {
+            /* do not keep the memory of idle associations */
+            free((*association)->receiveBuffer);
+            (*association)->receiveBuffer = NULL;
+            (*association)->receiveBufferSize = 0;
+            (*association)->receiveBufferLength = 0;
+            (*association)->receiveBufferOffset = 0;
+        }
+        b += count;
+        l -= count;
+        if (rtnLen != NULL)
+            *rtnLen += count;
+    }
+    if (lookahead > sizeof((*association)->lookahead) - (*association)->lookaheadLength)
+        lookahead = sizeof((*association)->lookahead) - (*association)->lookaheadLength;
+
     /* if there is no network connection, return an error */
-    if (connection == NULL) return DUL_NULLKEY;
+    if ((l > 0) && (connection == NULL)) return DUL_NULLKEY;
 
     int timeToWait = 0;
     if (block == DUL_NOBLOCK)
@@ -3710,7 +3838,7 @@ defragmentTCP(DcmTransportConnection *connection, DUL_BLOCKOPTIONS block, time_t
             }
 
             /* data has become available, now call read(). */
-            bytesRead = connection->read((char*)b, size_t(l));
+            bytesRead = connection->read((char*)b, size_t(l + lookahead));
 
         } while ((bytesRead == -1 && OFStandard::getLastNetworkErrorCode().value() == DCMNET_EINTR)
 #ifdef HAVE_WINSOCK_H
@@ -3721,6 +3849,13 @@ defragmentTCP(DcmTransportConnection *connection, DUL_BLOCKOPTIONS block, time_t
         /* if we actually received data, move the buffer pointer to its own end, update the variable */
         /* that determines the end of the first loop, and update the reference parameter return variable */
         if (bytesRead > 0) {
+            (*association)->statistics.bytesReceived += (unsigned long) bytesRead;
+            if ((unsigned long) bytesRead > l) {
+                /* keep the bytes received in addition to the requested ones */
+                (*association)->lookaheadLength = (unsigned long) bytesRead - l;
+                memcpy((*association)->lookahead, b + l, size_t((*association)->lookaheadLength));
+                bytesRead = (int) l;
+            }
             b += bytesRead;
             l -= (unsigned long) bytesRead;
             if (rtnLen != NULL)
@@ -3733,6 +3868,271 @@ defragmentTCP(DcmTransportConnection *connection, DUL_BLOCKOPTIONS block, time_t
     return EC_Normal;
 }
 
+/* writeToConnection
+**
+** Purpose:
+**      Write the given number of bytes to the transport connection of the
+**      association and update the association's statistics.
+**
+** Parameter Dictionary:
+**      association     Handle to the Association
+**      p               Buffer holding the information
+**      l               Number of bytes to write
+**
+** Return Values:
+**      Number of bytes written, -1 in case of an error.
+**
+** Notes:
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+
+static int
+writeToConnection(PRIVATE_ASSOCIATIONKEY ** association, void *p, unsigned long l)
+{
+    int nbytes;
+    double start = OFTimer::getTime();
+    do {
+      nbytes = (*association)->connection ? (*association)->connection->write((char*)p, size_t(l)) : 0;
+    } while (nbytes == -1 && OFStandard::getLastNetworkErrorCode().value() == DCMNET_EINTR);
+    (*association)->statistics.sendTime += OFTimer::getDiff(start);
+    if (nbytes > 0)
+        (*association)->statistics.bytesSent += (unsigned long) nbytes;
+    return nbytes;
+}
+
+/* PRV_ReadPDVFragment
+**
+** Purpose:
+**      Receive (the next part of) the data fragment of the next PDV of the
+**      current P-DATA-TF PDU directly into the caller's buffer, see
+**      DUL_ReadPDVFragment(). Either the association contains the header of
+**      a P-DATA-TF PDU that has not been read yet, or a previous call of
+**      this function has stopped in the middle of a P-DATA-TF PDU.
+**
+** Parameter Dictionary:
+**      association            Handle to the Association
+**      block                  Blocking/non-blocking option
+**      timeout                Timeout interval for reading
+**      presentationContextID  Presentation context of the PDVs to be
+**                             received, 0 for any presentation context.
+**      buffer                 Buffer for the data fragment
+**      bufferLength           Size of the buffer
+**      pdv                    The PDV received (returned to the caller)
+**
+** Return Values:
+**
+**      EC_Normal if (a part of) a data fragment has been received,
+**      DUL_PDATAPDUARRIVED if PDVs are available through DUL_NextPDV().
+**
+** Notes:
+**      If the PDV is not the last one of the data set, the header of the
+**      next PDV (and of the next PDU, if the current one ends with this
+**      PDV) must follow. These headers are requested together with the
+**      data fragment, so that for a sequence of P-DATA-TF PDUs with one
+**      PDV each, only one read operation per PDU is needed.
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+
+OFCondition
+PRV_ReadPDVFragment(PRIVATE_ASSOCIATIONKEY ** association,
+                    DUL_BLOCKOPTIONS block, int timeout,
+                    DUL_PRESENTATIONCONTEXTID presentationContextID,
+                    unsigned char *buffer, unsigned long bufferLength, DUL_PDV * pdv)
+{
+    OFCondition cond = EC_Normal;
+    unsigned char
+        header[6];
+    unsigned long
+        pdvLength,
+        length;
+
+    /* (for non-blocking reading) if the timeout refers to */
+    /* the default timeout, set timeout correspondingly */
+    if (timeout == PRV_DEFAULTTIMEOUT)
+        timeout = (*association)->timeout;
+
+    if ((*association)->inputPDU != NO_PDU)
+    {
+        /* the header of a new P-DATA-TF PDU has been read, its body follows */
+        (*association)->inputPDU = NO_PDU;
+        if ((*association)->nextPDULength > (*association)->fragmentBufferLength)
+            return DUL_ILLEGALPDULENGTH;
+        if ((*association)->nextPDULength == 0)
+            return makeDcmnetCondition(DULC_ILLEGALPDU, OF_error, "PDU without any PDVs encountered. This probably indicates a malformed P DATA PDU.");
+        (*association)->directPDULength = (*association)->nextPDULength;
+        (*association)->directFragmentLength = 0;
+    }
+
+    if ((*association)->directFragmentLength == 0)
+    {
+        /* read the header of the next PDV */
+        if ((*association)->directPDULength < 6)
+        {
+            char buf[256];
+            sprintf(buf, "PDV lengths don't add up correctly: %lu bytes remaining. This probably indicates a malformed P-DATA PDU.", (*association)->directPDULength);
+            (*association)->directPDULength = 0;
+            return makeDcmnetCondition(DULC_ILLEGALPDU, OF_error, buf);
+        }
+        cond = defragmentTCP(association, block, (*association)->timerStart, timeout, header, 6, &length);
+        if (cond.bad())
+            return cond;
+        (*association)->directPDULength -= 6;
+
+        /* check the PDV length like DT_2_IndicatePData() does */
+        EXTRACT_LONG_BIG(header, pdvLength);
+        if (pdvLength < 2 || pdvLength - 2 > (*association)->directPDULength)
+        {
+            char buf[256];
+            sprintf(buf, "PDV with invalid length %lu encountered. This probably indicates a malformed P DATA PDU.", pdvLength);
+            (*association)->directPDULength = 0;
+            return makeDcmnetCondition(DULC_ILLEGALPDULENGTH, OF_error, buf);
+        }
+        (*association)->directPDV.fragmentLength = pdvLength - 2;
+        (*association)->directPDV.presentationContextID = header[4];
+        (*association)->directPDV.lastPDV = (header[5] & 2) ? OFTrue : OFFalse;
+        (*association)->directPDV.pdvType = (header[5] & 1) ? DUL_COMMANDPDV : DUL_DATASETPDV;
+        (*association)->directPDV.data = NULL;
+        (*association)->directFragmentLength = pdvLength - 2;
+
+        /* anything else than a data set PDV of the requested presentation context */
+        /* is made available through DUL_NextPDV(), along with the rest of the PDU */
+        if (((*association)->directPDV.pdvType != DUL_DATASETPDV) ||
+            ((presentationContextID != 0) && (presentationContextID != (*association)->directPDV.presentationContextID)))
+        {
+            return bufferPendingPDVs(association, block, timeout, OFTrue);
+        }
+    }
+
+    /* receive (the next part of) the data fragment */
+    unsigned long count = (*association)->directFragmentLength;
+    unsigned long lookahead = 0;
+    if (count > bufferLength)
+        count = bufferLength;
+    else if (!(*association)->directPDV.lastPDV)
+    {
+        /* request the header of the next PDV, and of the next PDU if this one is complete */
+        lookahead = ((*association)->directPDULength > count) ? 6 : 12;
+        if (lookahead > bufferLength - count)
+            lookahead = 0;
+    }
+    double start = OFTimer::getTime();
+    cond = defragmentTCP(association, block, (*association)->timerStart, timeout, buffer, count, &length, lookahead);
+    (*association)->statistics.receiveTime += OFTimer::getDiff(start);
+    if (cond.bad())
+        return cond;
+    (*association)->directFragmentLength -= count;
+    (*association)->directPDULength -= count;
+
+    *pdv = (*association)->directPDV;
+    pdv->fragmentLength = count;
+    pdv->data = buffer;
+    pdv->lastPDV = ((*association)->directPDV.lastPDV && ((*association)->directFragmentLength == 0)) ? OFTrue : OFFalse;
+
+    /* if more PDVs follow the last fragment of the data set in the same */
+    /* PDU, make them available through DUL_NextPDV() */
+    if (pdv->lastPDV && ((*association)->directPDULength > 0))
+    {
+        cond = bufferPendingPDVs(association, block, timeout, OFFalse);
+        if (cond != DUL_PDATAPDUARRIVED)
+            return cond;
+    }
+    return EC_Normal;
+}
+
+/* PRV_BufferPendingPDVs
+**
+** Purpose:
+**      Read the rest of a P-DATA-TF PDU of which PRV_ReadPDVFragment() has
+**      only received a part, and make the remaining PDVs available through
+**      DUL_NextPDV().
+**
+** Parameter Dictionary:
+**      association     Handle to the Association
+**      block           Blocking/non-blocking option
+**      timeout         Timeout interval for reading
+**
+** Return Values:
+**
+**      DUL_PDATAPDUARRIVED if successful, an error code otherwise.
+**
+** Notes:
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+
+OFCondition
+PRV_BufferPendingPDVs(PRIVATE_ASSOCIATIONKEY ** association,
+                      DUL_BLOCKOPTIONS block, int timeout)
+{
+    if (timeout == PRV_DEFAULTTIMEOUT)
+        timeout = (*association)->timeout;
+    return bufferPendingPDVs(association, block, timeout,
+        ((*association)->directFragmentLength > 0) ? OFTrue : OFFalse);
+}
+
+/* bufferPendingPDVs
+**
+** Purpose:
+**      Read the rest of the P-DATA-TF PDU that is currently being received
+**      by PRV_ReadPDVFragment() into the fragment buffer of the association,
+**      and make its PDVs available through DUL_NextPDV().
+**
+** Parameter Dictionary:
+**      association        Handle to the Association
+**      block              Blocking/non-blocking option
+**      timeout            Timeout interval for reading
+**      includeCurrentPDV  If true, the current PDV (i.e. the part of its
+**                         data fragment that has not been received yet)
+**                         is also made available.
+**
+** Return Values:
+**
+**      DUL_PDATAPDUARRIVED if successful, an error code otherwise.
+**
+** Notes:
+**      The remaining part of the PDU is never larger than the complete PDU,
+**      so it always fits into the fragment buffer.
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+
+static OFCondition
+bufferPendingPDVs(PRIVATE_ASSOCIATIONKEY ** association, DUL_BLOCKOPTIONS block,
+                  int timeout, OFBool includeCurrentPDV)
+{
+    unsigned char *p = (*association)->fragmentBuffer;
+    unsigned long length = (*association)->directPDULength;
+    unsigned long pduLength = length;
+    unsigned long pdvLength;
+
+    if (includeCurrentPDV)
+    {
+        /* re-create the header of the current PDV for the rest of its data fragment */
+        pdvLength = (*association)->directFragmentLength + 2;
+        COPY_LONG_BIG(pdvLength, p);
+        p[4] = (*association)->directPDV.presentationContextID;
+        p[5] = OFstatic_cast(unsigned char, ((*association)->directPDV.lastPDV ? 2 : 0) |
+               (((*association)->directPDV.pdvType == DUL_COMMANDPDV) ? 1 : 0));
+        pduLength += 6;
+        p += 6;
+    }
+    (*association)->directPDULength = 0;
+    (*association)->directFragmentLength = 0;
+
+    double start = OFTimer::getTime();
+    OFCondition cond = defragmentTCP(association, block, (*association)->timerStart, timeout, p, length, &length);
+    (*association)->statistics.receiveTime += OFTimer::getDiff(start);
+    if (cond.bad())
+        return cond;
+    return indicatePDVs(association, DUL_TYPEDATA, pduLength);
+}
+
 /* dump_pdu
 **
 ** Purpose:
@@ -3835,6 +4235,41 @@ static void setTCPBufferLength(int sock)
         DCMNET_TRACE("  environment variable TCP_BUFFER_LENGTH not set, using the system defaults");
 }
 
+/* setPeerAsyncOperations
+**
+** Purpose:
+**      Copy the Asynchronous Operations Window received from the peer into
+**      the service parameters. If the peer did not send the sub-item, the
+**      default window of one operation in each direction is used.
+**
+** Parameter Dictionary:
+**      service         Service parameters describing the Association
+**      async           Asynchronous Operations Window parsed from the PDU
+**
+** Return Values:
+**      None
+**
+** Notes:
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+static void
+setPeerAsyncOperations(DUL_ASSOCIATESERVICEPARAMETERS * service,
+                       PRV_ASYNCOPERATIONS * async)
+{
+    if (async->length != 0)
+    {
+        service->peerMaximumOperationsInvoked = async->maximumOperationsInvoked;
+        service->peerMaximumOperationsPerformed = async->maximumOperationsProvided;
+    }
+    else
+    {
+        service->peerMaximumOperationsInvoked = 1;
+        service->peerMaximumOperationsPerformed = 1;
+    }
+}
+
 /* translatePresentationContextList
 **
 ** Purpose:
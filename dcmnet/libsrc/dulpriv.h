@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2010, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -110,5 +110,13 @@ parseAssociate(unsigned char *buf, unsigned long len,
 OFCondition
 PRV_NextPDUType(PRIVATE_ASSOCIATIONKEY ** association,
 		DUL_BLOCKOPTIONS block, int timeout, unsigned char *type);
+OFCondition
+PRV_ReadPDVFragment(PRIVATE_ASSOCIATIONKEY ** association,
+		DUL_BLOCKOPTIONS block, int timeout,
+		DUL_PRESENTATIONCONTEXTID presentationContextID,
+		unsigned char *buffer, unsigned long bufferLength, DUL_PDV * pdv);
+OFCondition
+PRV_BufferPendingPDVs(PRIVATE_ASSOCIATIONKEY ** association,
+		DUL_BLOCKOPTIONS block, int timeout);
 
 #endif
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2009-2023, OFFIS e.V.
+ *  Copyright (C) 2009-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -429,8 +429,23 @@ OFCondition DcmSCP::waitForAssociationRQ(T_ASC_Network* network)
 }
 
 OFCondition DcmSCP::processAssociationRQ()
+{
+    OFBool accepted = OFFalse;
+    OFCondition cond = acceptOrRefuseAssociation(accepted);
+
+    // Go ahead and handle the association (i.e. handle the caller's requests) in this process
+    if (cond.good() && accepted)
+        handleAssociation();
+
+    return cond;
+}
+
+// ----------------------------------------------------------------------------
+
+OFCondition DcmSCP::acceptOrRefuseAssociation(OFBool& accepted)
 {
     DcmSCPActionType desiredAction = DCMSCP_ACTION_UNDEFINED;
+    accepted = OFFalse;
     if ((m_assoc == NULL) || (m_assoc->params == NULL))
         return ASC_NULLKEY;
 
@@ -536,9 +551,7 @@ OFCondition DcmSCP::processAssociationRQ()
     else
         DCMNET_DEBUG(ASC_dumpParameters(tempStr, m_assoc->params, ASC_ASSOC_AC));
 
-    // Go ahead and handle the association (i.e. handle the caller's requests) in this process
-    handleAssociation();
-
+    accepted = OFTrue;
     return EC_Normal;
 }
 
@@ -557,6 +570,22 @@ OFCondition DcmSCP::negotiateAssociation()
         OFString tempStr;
         DCMNET_ERROR(DimseCondition::dump(tempStr, result));
     }
+    else
+    {
+        // Accept an asynchronous operations window (if proposed) up to the configured size.
+        // Requests are always performed one after the other, i.e. synchronously.
+        Uint16 maxOps = m_cfg->getMaxOperationsInvoked();
+        unsigned short peerInvoked = 1;
+        unsigned short peerPerformed = 1;
+        ASC_getPeerAsyncOperationsWindow(m_assoc->params, &peerInvoked, &peerPerformed);
+        if ((maxOps != 1) && (peerInvoked != 1))
+        {
+            if ((maxOps == 0) || ((peerInvoked != 0) && (peerInvoked < maxOps)))
+                maxOps = peerInvoked;
+            DCMNET_DEBUG("Accepting asynchronous operations window: " << maxOps << " invoked, 1 performed");
+            result = ASC_setAsyncOperationsWindow(m_assoc->params, maxOps, 1);
+        }
+    }
     return result;
 }
 
@@ -594,31 +623,52 @@ void DcmSCP::handleAssociation()
         return;
     }
 
-    // Receive a DIMSE command and perform all the necessary actions. (Note that ReceiveAndHandleCommands()
-    // will always return a value 'cond' for which 'cond.bad()' will be true. This value indicates that either
-    // some kind of error occurred, or that the peer aborted the association (DUL_PEERABORTEDASSOCIATION),
-    // or that the peer requested the release of the association (DUL_PEERREQUESTEDRELEASE).) (Also note
-    // that ReceiveAndHandleCommands() will never return EC_Normal.)
+    // Receive a DIMSE command and perform all the necessary actions. (Note that receiveAndHandleCommand()
+    // will always return a value 'cond' for which 'cond.bad()' will be true at some point. This value indicates
+    // that either some kind of error occurred, or that the peer aborted the association (DUL_PEERABORTEDASSOCIATION),
+    // or that the peer requested the release of the association (DUL_PEERREQUESTEDRELEASE).)
     OFCondition cond = EC_Normal;
-    T_DIMSE_Message message;
-    T_ASC_PresentationContextID presID;
 
     // start a loop to be able to receive more than one DIMSE command
     while (cond.good())
     {
-        // receive a DIMSE command over the network
-        cond = DIMSE_receiveCommand(
-            m_assoc, m_cfg->getDIMSEBlockingMode(), m_cfg->getDIMSETimeout(), &presID, &message, NULL);
-
-        // check if peer did release or abort, or if we have a valid message
-        if (cond.good())
-        {
-            DcmPresentationContextInfo presInfo;
-            getPresentationContextInfo(m_assoc, presID, presInfo);
-            cond = handleIncomingCommand(&message, presInfo);
-        }
+        cond = receiveAndHandleCommand();
     }
     // Clean up on association termination.
+    handleAssociationTermination(cond);
+}
+
+// ----------------------------------------------------------------------------
+
+OFCondition DcmSCP::receiveAndHandleCommand()
+{
+    if (m_assoc == NULL)
+        return DIMSE_ILLEGALASSOCIATION;
+
+    T_DIMSE_Message message;
+    T_ASC_PresentationContextID presID;
+
+    // receive a DIMSE command over the network
+    OFCondition cond = DIMSE_receiveCommand(
+        m_assoc, m_cfg->getDIMSEBlockingMode(), m_cfg->getDIMSETimeout(), &presID, &message, NULL);
+
+    // check if peer did release or abort, or if we have a valid message
+    if (cond.good())
+    {
+        DcmPresentationContextInfo presInfo;
+        getPresentationContextInfo(m_assoc, presID, presInfo);
+        cond = handleIncomingCommand(&message, presInfo);
+    }
+    return cond;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmSCP::handleAssociationTermination(const OFCondition& cond)
+{
+    if (m_assoc == NULL)
+        return;
+
     if (cond == DUL_PEERREQUESTEDRELEASE)
     {
         notifyReleaseRequest();
@@ -1785,6 +1835,13 @@ void DcmSCP::setMaxReceivePDULength(const Uint32 maxRecPDU)
 
 // ----------------------------------------------------------------------------
 
+void DcmSCP::setMaxOperationsInvoked(const Uint16 maxOps)
+{
+    m_cfg->setMaxOperationsInvoked(maxOps);
+}
+
+// ----------------------------------------------------------------------------
+
 OFCondition DcmSCP::setEnableVerification(const OFString& profile)
 {
 
@@ -1923,6 +1980,13 @@ Uint32 DcmSCP::getMaxReceivePDULength() const
 
 // ----------------------------------------------------------------------------
 
+Uint16 DcmSCP::getMaxOperationsInvoked() const
+{
+    return m_cfg->getMaxOperationsInvoked();
+}
+
+// ----------------------------------------------------------------------------
+
 Uint16 DcmSCP::getPort() const
 {
     return m_cfg->getPort();
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2012-2020, OFFIS e.V.
+ *  Copyright (C) 2012-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -32,6 +32,7 @@ DcmSCPConfig::DcmSCPConfig() :
   m_aetitle("DCMTK_SCP"),
   m_refuseAssociation(OFFalse),
   m_maxReceivePDULength(ASC_DEFAULTMAXPDU),
+  m_maxOperationsInvoked(1),
   m_connectionBlockingMode(DUL_BLOCK),
   m_dimseBlockingMode(DIMSE_BLOCKING),
   m_dimseTimeout(0),
@@ -60,6 +61,7 @@ DcmSCPConfig::DcmSCPConfig(const DcmSCPConfig &old) :
   m_aetitle(old.m_aetitle),
   m_refuseAssociation(old.m_refuseAssociation),
   m_maxReceivePDULength(old.m_maxReceivePDULength),
+  m_maxOperationsInvoked(old.m_maxOperationsInvoked),
   m_connectionBlockingMode(old.m_connectionBlockingMode),
   m_dimseBlockingMode(old.m_dimseBlockingMode),
   m_dimseTimeout(old.m_dimseTimeout),
@@ -85,6 +87,7 @@ DcmSCPConfig& DcmSCPConfig::operator=(const DcmSCPConfig &obj)
     m_aetitle = obj.m_aetitle;
     m_refuseAssociation = obj.m_refuseAssociation;
     m_maxReceivePDULength = obj.m_maxReceivePDULength;
+    m_maxOperationsInvoked = obj.m_maxOperationsInvoked;
     m_connectionBlockingMode = obj.m_connectionBlockingMode;
     m_dimseBlockingMode = obj.m_dimseBlockingMode;
     m_dimseTimeout = obj.m_dimseTimeout;
@@ -120,6 +123,13 @@ void DcmSCPConfig::setMaxReceivePDULength(const Uint32 maxRecPDU)
 
 // ----------------------------------------------------------------------------
 
+void DcmSCPConfig::setMaxOperationsInvoked(const Uint16 maxOps)
+{
+  m_maxOperationsInvoked = maxOps;
+}
+
+// ----------------------------------------------------------------------------
+
 void DcmSCPConfig::setPort(const Uint16 port)
 {
   m_port = port;
@@ -220,6 +230,13 @@ Uint32 DcmSCPConfig::getMaxReceivePDULength() const
 
 // ----------------------------------------------------------------------------
 
+Uint16 DcmSCPConfig::getMaxOperationsInvoked() const
+{
+  return m_maxOperationsInvoked;
+}
+
+// ----------------------------------------------------------------------------
+
 Uint16 DcmSCPConfig::getPort() const
 {
   return m_port;
@@ -0,0 +1,928 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmnet
+ *
+ *  Author:  agent
+ *
+ *  Purpose: Class listening for association requests and multiplexing all
+ *           incoming associations over a single event loop, with a bounded
+ *           pool of worker threads that only handle associations for which
+ *           a DIMSE message has been received.
+ *
+ */
+
+#include "dcmtk/config/osconfig.h" /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmnet/scpevpool.h"
+
+#if defined(WITH_THREADS) && !defined(_WIN32)
+
+#include "dcmtk/dcmnet/diutil.h"
+#include "dcmtk/dcmnet/dcmtrans.h"
+#include "dcmtk/ofstd/oftimer.h"
+
+BEGIN_EXTERN_C
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+#ifdef HAVE_SYS_SELECT_H
+#include <sys/select.h>
+#endif
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+END_EXTERN_C
+
+#ifdef DCMTK_HAVE_POLL
+#include <poll.h>
+#endif
+
+/// maximum number of events retrieved by a single call of epoll_wait()
+#define DCMTK_EVENTPOOL_MAX_EVENTS 64
+
+/// maximum number of bytes buffered by the event loop for a single association
+#define DCMTK_EVENTPOOL_MAX_BUFFERED 1048576
+
+/// State of an association handled by the event-driven pool
+struct DcmBaseSCPEventPool::AssociationEntry
+{
+  /** constructor
+   *  @param handler the handler of the association
+   *  @param assoc the association
+   */
+  AssociationEntry(DcmBaseSCPHandler *handler, T_ASC_Association *assoc)
+  : m_handler(handler)
+  , m_assoc(assoc)
+  , m_socket(DUL_getTransportConnection(assoc->DULassociation)->getSocket())
+  , m_negotiated(OFFalse)
+  , m_rejected(OFFalse)
+  , m_rejectReason(ASC_REASON_SP_PRES_TEMPORARYCONGESTION)
+  , m_timedOut(OFFalse)
+  , m_registered(OFFalse)
+  , m_idlePos()
+  , m_idleTimer()
+  {
+  }
+
+  /// handler of the association, NULL if the association is rejected
+  DcmBaseSCPHandler *m_handler;
+  /// the association, owned by the handler once negotiated, NULL after the
+  /// association has ended
+  T_ASC_Association *m_assoc;
+  /// socket of the association
+  DcmNativeSocketType m_socket;
+  /// OFTrue if the association has been negotiated and acknowledged
+  OFBool m_negotiated;
+  /// OFTrue if the association request is to be rejected
+  OFBool m_rejected;
+  /// reason for rejecting the association request
+  T_ASC_RejectParametersReason m_rejectReason;
+  /// OFTrue if the association request or the next DIMSE message was not
+  /// received within the ACSE or DIMSE timeout, respectively
+  OFBool m_timedOut;
+  /// OFTrue if the socket has been added to the epoll instance
+  OFBool m_registered;
+  /// position in the list of watched associations, if watched
+  OFListIterator(AssociationEntry*) m_idlePos;
+  /// time since the connection was accepted, or since data was last received
+  /// after the association has been negotiated
+  OFTimer m_idleTimer;
+
+private:
+  /// private undefined copy constructor
+  AssociationEntry(const AssociationEntry &);
+  /// private undefined copy assignment operator
+  AssociationEntry &operator=(const AssociationEntry &);
+};
+
+/// Worker thread of the event-driven pool
+class DcmBaseSCPEventPool::DcmSCPEventWorker : public OFThread
+{
+public:
+  /** constructor
+   *  @param pool the pool this worker belongs to
+   */
+  DcmSCPEventWorker(DcmBaseSCPEventPool& pool)
+  : OFThread()
+  , m_pool(pool)
+  {
+  }
+
+protected:
+  /** handle associations until the pool shuts down
+   */
+  virtual void run()
+  {
+    DcmBaseSCPEventPool::AssociationEntry *entry;
+    while ((entry = m_pool.nextJob()) != NULL)
+      m_pool.processJob(entry);
+  }
+
+private:
+  /// the pool this worker belongs to
+  DcmBaseSCPEventPool& m_pool;
+};
+
+// ----------------------------------------------------------------------------
+
+DcmBaseSCPEventPool::DcmBaseSCPEventPool()
+  : m_criticalSection(),
+    m_jobsAvailable(0),
+    m_jobs(),
+    m_returned(),
+    m_idle(),
+    m_workers(),
+    m_numAssociations(0),
+    m_cfg(),
+    m_maxWorkers(5),
+    m_maxAssociations(100),
+    m_network(NULL),
+    m_bufferLimit(DCMTK_EVENTPOOL_MAX_BUFFERED),
+    m_listenSocket(DCMNET_INVALID_SOCKET),
+    m_listening(OFFalse),
+    m_epollFd(-1),
+    m_runMode( LISTEN )
+{
+  m_wakeupPipe[0] = -1;
+  m_wakeupPipe[1] = -1;
+}
+
+// ----------------------------------------------------------------------------
+
+DcmBaseSCPEventPool::~DcmBaseSCPEventPool()
+{
+  closeEventLoop();
+}
+
+// ----------------------------------------------------------------------------
+
+OFCondition DcmBaseSCPEventPool::listen()
+{
+  m_criticalSection.lock();
+  m_runMode = LISTEN;
+  m_criticalSection.unlock();
+
+  /* Copy the config to a shared config that is shared by all handlers. */
+  DcmSharedSCPConfig sharedConfig(m_cfg);
+
+  /* Initialize network, i.e. create an instance of T_ASC_Network*. */
+  T_ASC_Network *network = NULL;
+  OFCondition cond = initializeNetwork(&network);
+  if (cond.bad())
+    return cond;
+
+  cond = openEventLoop(DUL_networkSocket(network->network));
+  if (cond.bad())
+  {
+    ASC_dropNetwork(&network);
+    return cond;
+  }
+  m_network = network;
+
+  /* A complete PDU always fits into the buffer of the event loop */
+  m_bufferLimit = DCMTK_EVENTPOOL_MAX_BUFFERED;
+  if (m_cfg.getMaxReceivePDULength() + 6 > m_bufferLimit)
+    m_bufferLimit = m_cfg.getMaxReceivePDULength() + 6;
+
+  /* Start the worker threads */
+  const Uint16 numWorkers = (m_maxWorkers > 0) ? m_maxWorkers : 1;
+  DCMNET_DEBUG("DcmBaseSCPEventPool: Starting " << numWorkers << " worker threads");
+  for (Uint16 i = 0; (i < numWorkers) && cond.good(); ++i)
+  {
+    DcmSCPEventWorker *worker = new DcmSCPEventWorker(*this);
+    if (worker->start() != 0)
+    {
+      delete worker;
+      cond = NET_EC_CannotStartSCPThread;
+    }
+    else
+      m_workers.push_back(worker);
+  }
+
+  /* The event loop: run until stopped and all associations have ended */
+  const OFBool checkIdleTimeout = (m_cfg.getDIMSEBlockingMode() == DIMSE_NONBLOCKING);
+  const double idleTimeout = m_cfg.getDIMSETimeout();
+  const double requestTimeout = m_cfg.getACSETimeout();
+  OFTimer idleCheckTimer;
+  OFVector<AssociationEntry*> ready;
+  OFList<AssociationEntry*> returned;
+  while (cond.good())
+  {
+    /* Watch the associations that were handed back by the workers, and
+     * clean up those that have ended
+     */
+    m_criticalSection.lock();
+    returned.splice(returned.end(), m_returned);
+    for (OFListIterator(AssociationEntry*) it = returned.begin(); it != returned.end(); ++it)
+    {
+      if ((*it)->m_assoc == NULL)
+        --m_numAssociations;
+    }
+    const runmode mode = m_runMode;
+    const size_t numAssocs = m_numAssociations;
+    m_criticalSection.unlock();
+    for (OFListIterator(AssociationEntry*) it = returned.begin(); it != returned.end(); ++it)
+    {
+      if ((*it)->m_assoc == NULL)
+        delete *it;
+      else
+        watch(*it);
+    }
+    returned.clear();
+
+    if (mode != LISTEN)
+    {
+      if (m_listening)
+        stopWatchingListenSocket();
+      if (numAssocs == 0)
+        break;
+    }
+
+    /* Wait for incoming connections, data on the associations, or wake-up
+     * calls, and wake up regularly in order to check the timeouts
+     */
+    OFBool incoming = OFFalse;
+    waitForEvents(ready, incoming, 1000);
+
+    /* Accept all pending connections (up to a limit, in order not to delay
+     * the associations that have data available)
+     */
+    for (int i = 0; incoming && (i < DCMTK_EVENTPOOL_MAX_EVENTS); ++i)
+    {
+      acceptAssociation(sharedConfig);
+      incoming = ASC_associationWaiting(network, 0);
+    }
+
+    /* Receive the available data, and hand the association to a worker as
+     * soon as a complete message has been received. The association request
+     * has to be received completely within the ACSE timeout.
+     */
+    for (OFVector<AssociationEntry*>::iterator it = ready.begin(); it != ready.end(); ++it)
+    {
+      if ((*it)->m_negotiated)
+        (*it)->m_idleTimer.reset();
+      if (receiveMessage(*it))
+        dispatch(*it);
+      else
+        watch(*it);
+    }
+    ready.clear();
+
+    /* Close connections on which no association request was received within
+     * the ACSE timeout, and abort associations on which no message was
+     * received within the DIMSE timeout
+     */
+    if (idleCheckTimer.getDiff() >= 1.0)
+    {
+      idleCheckTimer.reset();
+      OFListIterator(AssociationEntry*) it = m_idle.begin();
+      while (it != m_idle.end())
+      {
+        AssociationEntry *entry = *it++;
+        if (entry->m_negotiated ? (checkIdleTimeout && (entry->m_idleTimer.getDiff() > idleTimeout))
+                                : (entry->m_idleTimer.getDiff() > requestTimeout))
+        {
+          if (entry->m_negotiated)
+            DCMNET_DEBUG("DcmBaseSCPEventPool: No data received within DIMSE timeout, aborting association");
+          else
+            DCMNET_DEBUG("DcmBaseSCPEventPool: No association request received within ACSE timeout, closing connection");
+          unwatch(entry);
+          entry->m_timedOut = OFTrue;
+          dispatch(entry);
+        }
+      }
+    }
+  }
+
+  /* Stop and join the worker threads. If the worker threads could not be
+   * started, the pending associations are aborted first.
+   */
+  m_criticalSection.lock();
+  m_runMode = SHUTDOWN;
+  for (size_t i = 0; i < m_workers.size(); ++i)
+  {
+    m_jobs.push_back(NULL);
+    m_jobsAvailable.post();
+  }
+  m_criticalSection.unlock();
+  for (OFVector<DcmSCPEventWorker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+  {
+    (*it)->join();
+    delete *it;
+  }
+  m_workers.clear();
+
+  /* Clean up associations that have not been handled, e.g. because the
+   * worker threads could not be started
+   */
+  m_criticalSection.lock();
+  m_returned.splice(m_returned.end(), m_jobs);
+  m_returned.splice(m_returned.end(), m_idle);
+  for (OFListIterator(AssociationEntry*) it = m_returned.begin(); it != m_returned.end(); ++it)
+  {
+    if (*it)
+    {
+      if ((*it)->m_assoc)
+      {
+        /* the association request has not been received yet, if not negotiated */
+        forget(*it);
+        if ((*it)->m_negotiated)
+          (*it)->m_handler->finishAssociation(DUL_NETWORKCLOSED);
+        else
+          dropAndDestroyAssociation((*it)->m_assoc);
+      }
+      delete (*it)->m_handler;
+      delete *it;
+    }
+  }
+  m_returned.clear();
+  m_numAssociations = 0;
+  m_criticalSection.unlock();
+
+  /* In the end, clean up the rest of the memory and drop network */
+  closeEventLoop();
+  m_network = NULL;
+  ASC_dropNetwork(&network);
+
+  return cond;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::stopAfterCurrentAssociations()
+{
+  m_criticalSection.lock();
+  if (m_runMode == LISTEN)
+    m_runMode = STOP;
+  m_criticalSection.unlock();
+  wakeUp();
+}
+
+// ----------------------------------------------------------------------------
+
+Uint16 DcmBaseSCPEventPool::getMaxThreads()
+{
+  return m_maxWorkers;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::setMaxThreads(const Uint16 maxWorkers)
+{
+  m_maxWorkers = maxWorkers;
+}
+
+// ----------------------------------------------------------------------------
+
+Uint16 DcmBaseSCPEventPool::getMaxAssociations()
+{
+  return m_maxAssociations;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::setMaxAssociations(const Uint16 maxAssociations)
+{
+  m_maxAssociations = maxAssociations;
+}
+
+// ----------------------------------------------------------------------------
+
+size_t DcmBaseSCPEventPool::numAssociations()
+{
+  m_criticalSection.lock();
+  size_t result = m_numAssociations;
+  m_criticalSection.unlock();
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+
+DcmSCPConfig& DcmBaseSCPEventPool::getConfig()
+{
+  return m_cfg;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::acceptAssociation(const DcmSharedSCPConfig& sharedConfig)
+{
+  T_ASC_Association *assoc = NULL;
+
+  /* The listen socket is readable, so accepting the TCP connection does not
+   * block. The association request is received by a worker thread as soon as
+   * it is available, see receiveMessage().
+   */
+  OFCondition cond = ASC_acceptTransportConnection(m_network, &assoc, m_cfg.getMaxReceivePDULength(),
+      OFFalse, m_cfg.transportLayerEnabled(), DUL_NOBLOCK, 0);
+  if (cond.bad())
+  {
+    if (cond == DUL_NOASSOCIATIONREQUEST)
+    {
+      ASC_destroyAssociation(&assoc);
+    }
+    else
+    {
+      dropAndDestroyAssociation(assoc);
+      DCMNET_ERROR("DcmBaseSCPEventPool: Error receiving association: " << cond.text());
+    }
+    return;
+  }
+
+  /* The association is rejected by the worker thread, after receiving the request */
+  AssociationEntry *entry = new AssociationEntry(NULL, assoc);
+  if (numAssociations() >= m_maxAssociations)
+  {
+    DCMNET_DEBUG("DcmBaseSCPEventPool: Maximum number of associations reached, rejecting association");
+    entry->m_rejected = OFTrue;
+    entry->m_rejectReason = ASC_REASON_SP_PRES_LOCALLIMITEXCEEDED;
+  }
+  else
+  {
+    entry->m_handler = createSCPHandler();
+    if ((entry->m_handler == NULL) || entry->m_handler->setSharedConfig(sharedConfig).bad())
+    {
+      delete entry->m_handler;
+      entry->m_handler = NULL;
+      entry->m_rejected = OFTrue;
+    }
+  }
+
+  m_criticalSection.lock();
+  ++m_numAssociations;
+  m_criticalSection.unlock();
+  watch(entry);
+}
+
+// ----------------------------------------------------------------------------
+
+OFBool DcmBaseSCPEventPool::receiveMessage(AssociationEntry *entry)
+{
+  DUL_ASSOCIATIONKEY *association = entry->m_assoc->DULassociation;
+  /* The transport layer can only be read without blocking if it is not
+   * secured by TLS. Other errors (e.g. a closed connection) are noticed
+   * by the worker thread when it reads the buffered data.
+   */
+  if (DUL_receiveAvailableData(association, m_bufferLimit).bad())
+    return OFTrue;
+  /* Larger messages are received by the worker thread */
+  return DUL_bufferedMessageComplete(association) ||
+    (DUL_bufferedDataLength(association) >= m_bufferLimit);
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::dispatch(AssociationEntry *entry)
+{
+  m_criticalSection.lock();
+  m_jobs.push_back(entry);
+  m_criticalSection.unlock();
+  m_jobsAvailable.post();
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::returnToEventLoop(AssociationEntry *entry)
+{
+  m_criticalSection.lock();
+  m_returned.push_back(entry);
+  m_criticalSection.unlock();
+  wakeUp();
+}
+
+// ----------------------------------------------------------------------------
+
+DcmBaseSCPEventPool::AssociationEntry *DcmBaseSCPEventPool::nextJob()
+{
+  m_jobsAvailable.wait();
+  m_criticalSection.lock();
+  AssociationEntry *entry = NULL;
+  if (!m_jobs.empty())
+  {
+    entry = m_jobs.front();
+    m_jobs.pop_front();
+  }
+  m_criticalSection.unlock();
+  return entry;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::processJob(AssociationEntry *entry)
+{
+  OFCondition cond = EC_Normal;
+  OFBool dataAvailable = OFTrue;
+
+  if (!entry->m_negotiated)
+  {
+    /* The connection is watched again after the association has been
+     * acknowledged, but it may already be closed before
+     */
+    forget(entry);
+    if (entry->m_timedOut)
+      cond = DUL_READTIMEOUT;
+    else
+      cond = ASC_receiveAssociationRequest(m_network, entry->m_assoc);
+    if (cond.bad())
+    {
+      DCMNET_DEBUG("DcmBaseSCPEventPool: Error receiving association request: " << cond.text());
+    }
+    else if (entry->m_rejected)
+    {
+      rejectAssociation(entry->m_assoc, entry->m_rejectReason);
+    }
+    else
+    {
+      /* Negotiate the association. If it is refused, the handler has
+       * already destroyed the association.
+       */
+      cond = entry->m_handler->startAssociation(entry->m_assoc, entry->m_negotiated);
+      if (!entry->m_negotiated)
+      {
+        if (cond.bad())
+          DCMNET_DEBUG("DcmBaseSCPEventPool: Association negotiation failed: " << cond.text());
+        entry->m_assoc = NULL;
+      }
+    }
+    if (!entry->m_negotiated)
+    {
+      dropAndDestroyAssociation(entry->m_assoc);
+      delete entry->m_handler;
+      entry->m_handler = NULL;
+      entry->m_assoc = NULL;
+      returnToEventLoop(entry);
+      return;
+    }
+    /* The peer usually waits for the acknowledgement before sending anything */
+    dataAvailable = ASC_dataWaiting(entry->m_assoc, 0) && receiveMessage(entry);
+  }
+  else if (entry->m_timedOut)
+  {
+    cond = DIMSE_NODATAAVAILABLE;
+  }
+
+  /* Handle the DIMSE messages that are available, including those that
+   * have already been read from the connection (e.g. by the TLS layer or
+   * as part of the previous PDU). A message that has only been received
+   * partially is left to the event loop, in order not to block this thread.
+   */
+  while (cond.good() && dataAvailable)
+  {
+    cond = entry->m_handler->processCommand();
+    if (cond.good())
+    {
+      dataAvailable = DUL_unprocessedPDVs(entry->m_assoc->DULassociation) ||
+        (ASC_dataWaiting(entry->m_assoc, 0) && receiveMessage(entry));
+    }
+  }
+
+  if (cond.bad())
+  {
+    forget(entry);
+    entry->m_handler->finishAssociation(cond);
+    delete entry->m_handler;
+    entry->m_handler = NULL;
+    entry->m_assoc = NULL;
+  }
+  else
+    entry->m_idleTimer.reset();
+  returnToEventLoop(entry);
+}
+
+// ----------------------------------------------------------------------------
+
+OFCondition DcmBaseSCPEventPool::openEventLoop(DcmNativeSocketType listenSocket)
+{
+  closeEventLoop();
+
+  if (pipe(m_wakeupPipe) != 0)
+  {
+    m_wakeupPipe[0] = -1;
+    m_wakeupPipe[1] = -1;
+    OFString msg = "TCP Initialization Error: ";
+    msg += OFStandard::getLastSystemErrorCode().message();
+    msg += ", cannot create pipe";
+    return makeDcmnetCondition(DULC_TCPINITERROR, OF_error, msg.c_str());
+  }
+  /* a full pipe must never block the workers, and reading the pipe must never block the event loop */
+  fcntl(m_wakeupPipe[0], F_SETFL, fcntl(m_wakeupPipe[0], F_GETFL) | O_NONBLOCK);
+  fcntl(m_wakeupPipe[1], F_SETFL, fcntl(m_wakeupPipe[1], F_GETFL) | O_NONBLOCK);
+  m_listenSocket = listenSocket;
+
+#ifdef HAVE_SYS_EPOLL_H
+  m_epollFd = epoll_create(DCMTK_EVENTPOOL_MAX_EVENTS);
+  if (m_epollFd < 0)
+  {
+    OFString msg = "TCP Initialization Error: ";
+    msg += OFStandard::getLastSystemErrorCode().message();
+    msg += ", cannot create epoll instance";
+    closeEventLoop();
+    return makeDcmnetCondition(DULC_TCPINITERROR, OF_error, msg.c_str());
+  }
+  /* the wake-up pipe is marked by its own address, the listen socket by NULL */
+  struct epoll_event event;
+  event.events = EPOLLIN;
+  event.data.ptr = m_wakeupPipe;
+  int result = epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeupPipe[0], &event);
+  if (result == 0)
+  {
+    event.data.ptr = NULL;
+    result = epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_listenSocket, &event);
+  }
+  if (result != 0)
+  {
+    OFString msg = "TCP Initialization Error: ";
+    msg += OFStandard::getLastSystemErrorCode().message();
+    msg += ", epoll_ctl failed";
+    closeEventLoop();
+    return makeDcmnetCondition(DULC_TCPINITERROR, OF_error, msg.c_str());
+  }
+#endif
+  m_listening = OFTrue;
+  return EC_Normal;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::closeEventLoop()
+{
+#ifdef HAVE_SYS_EPOLL_H
+  if (m_epollFd >= 0)
+    close(m_epollFd);
+  m_epollFd = -1;
+#endif
+  if (m_wakeupPipe[0] >= 0)
+    close(m_wakeupPipe[0]);
+  if (m_wakeupPipe[1] >= 0)
+    close(m_wakeupPipe[1]);
+  m_wakeupPipe[0] = -1;
+  m_wakeupPipe[1] = -1;
+  m_listenSocket = DCMNET_INVALID_SOCKET;
+  m_listening = OFFalse;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::stopWatchingListenSocket()
+{
+#ifdef HAVE_SYS_EPOLL_H
+  struct epoll_event event;
+  event.events = 0;
+  event.data.ptr = NULL;
+  epoll_ctl(m_epollFd, EPOLL_CTL_DEL, m_listenSocket, &event);
+#endif
+  m_listening = OFFalse;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::watch(AssociationEntry *entry)
+{
+#ifdef HAVE_SYS_EPOLL_H
+  /* one-shot mode: the association is disabled as soon as an event is reported */
+  struct epoll_event event;
+  event.events = EPOLLIN | EPOLLONESHOT;
+  event.data.ptr = entry;
+  if (epoll_ctl(m_epollFd, entry->m_registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, entry->m_socket, &event) != 0)
+  {
+    /* treat the association as readable, the worker will notice the error */
+    DCMNET_WARN("DcmBaseSCPEventPool: Cannot watch association: " << OFStandard::getLastSystemErrorCode().message());
+    dispatch(entry);
+    return;
+  }
+  entry->m_registered = OFTrue;
+#endif
+  entry->m_idlePos = m_idle.insert(m_idle.end(), entry);
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::unwatch(AssociationEntry *entry)
+{
+#ifdef HAVE_SYS_EPOLL_H
+  struct epoll_event event;
+  event.events = 0;
+  event.data.ptr = entry;
+  epoll_ctl(m_epollFd, EPOLL_CTL_MOD, entry->m_socket, &event);
+#endif
+  m_idle.erase(entry->m_idlePos);
+  entry->m_idlePos = m_idle.end();
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::forget(AssociationEntry *entry)
+{
+#ifdef HAVE_SYS_EPOLL_H
+  if (entry->m_registered && (m_epollFd >= 0))
+  {
+    struct epoll_event event;
+    event.events = 0;
+    event.data.ptr = entry;
+    epoll_ctl(m_epollFd, EPOLL_CTL_DEL, entry->m_socket, &event);
+  }
+#endif
+  entry->m_registered = OFFalse;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::wakeUp()
+{
+  if (m_wakeupPipe[1] >= 0)
+  {
+    const char c = 0;
+    // if the pipe is full, the event loop will wake up anyway
+    if (write(m_wakeupPipe[1], &c, 1) < 0) { /* ignore */ }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::waitForEvents(OFVector<AssociationEntry*>& ready,
+                                        OFBool& incoming,
+                                        int timeout)
+{
+  OFBool wokenUp = OFFalse;
+  incoming = OFFalse;
+
+#ifdef HAVE_SYS_EPOLL_H
+  struct epoll_event events[DCMTK_EVENTPOOL_MAX_EVENTS];
+  const int count = epoll_wait(m_epollFd, events, DCMTK_EVENTPOOL_MAX_EVENTS, timeout);
+  for (int i = 0; i < count; ++i)
+  {
+    if (events[i].data.ptr == NULL)
+      incoming = m_listening;
+    else if (events[i].data.ptr == m_wakeupPipe)
+      wokenUp = OFTrue;
+    else
+    {
+      /* the association has been disabled by the one-shot mode */
+      AssociationEntry *entry = OFstatic_cast(AssociationEntry*, events[i].data.ptr);
+      m_idle.erase(entry->m_idlePos);
+      entry->m_idlePos = m_idle.end();
+      ready.push_back(entry);
+    }
+  }
+#elif defined(DCMTK_HAVE_POLL)
+  OFVector<struct pollfd> pfd;
+  pfd.reserve(m_idle.size() + 2);
+  struct pollfd pfd1 = { m_wakeupPipe[0], POLLIN, 0 };
+  pfd.push_back(pfd1);
+  if (m_listening)
+  {
+    pfd1.fd = m_listenSocket;
+    pfd.push_back(pfd1);
+  }
+  for (OFListIterator(AssociationEntry*) it = m_idle.begin(); it != m_idle.end(); ++it)
+  {
+    pfd1.fd = (*it)->m_socket;
+    pfd.push_back(pfd1);
+  }
+  const int count = poll(&pfd[0], OFstatic_cast(nfds_t, pfd.size()), timeout);
+  if (count > 0)
+  {
+    wokenUp = (pfd[0].revents != 0);
+    size_t i = 1;
+    if (m_listening)
+      incoming = (pfd[i++].revents != 0);
+    OFListIterator(AssociationEntry*) it = m_idle.begin();
+    while (it != m_idle.end())
+    {
+      AssociationEntry *entry = *it++;
+      if (pfd[i++].revents != 0)
+      {
+        m_idle.erase(entry->m_idlePos);
+        entry->m_idlePos = m_idle.end();
+        ready.push_back(entry);
+      }
+    }
+  }
+#else
+  fd_set fdset;
+  FD_ZERO(&fdset);
+  int maxSocket = m_wakeupPipe[0];
+  FD_SET(m_wakeupPipe[0], &fdset);
+  if (m_listening)
+  {
+    FD_SET(m_listenSocket, &fdset);
+    if (m_listenSocket > maxSocket) maxSocket = m_listenSocket;
+  }
+  for (OFListIterator(AssociationEntry*) it = m_idle.begin(); it != m_idle.end(); ++it)
+  {
+    FD_SET((*it)->m_socket, &fdset);
+    if ((*it)->m_socket > maxSocket) maxSocket = (*it)->m_socket;
+  }
+  struct timeval t;
+  t.tv_sec = timeout / 1000;
+  t.tv_usec = (timeout % 1000) * 1000;
+#ifdef HAVE_INTP_SELECT
+  const int count = select(maxSocket + 1, (int *)(&fdset), NULL, NULL, (timeout < 0) ? NULL : &t);
+#else
+  const int count = select(maxSocket + 1, &fdset, NULL, NULL, (timeout < 0) ? NULL : &t);
+#endif
+  if (count > 0)
+  {
+    wokenUp = FD_ISSET(m_wakeupPipe[0], &fdset) != 0;
+    incoming = m_listening && (FD_ISSET(m_listenSocket, &fdset) != 0);
+    OFListIterator(AssociationEntry*) it = m_idle.begin();
+    while (it != m_idle.end())
+    {
+      AssociationEntry *entry = *it++;
+      if (FD_ISSET(entry->m_socket, &fdset))
+      {
+        m_idle.erase(entry->m_idlePos);
+        entry->m_idlePos = m_idle.end();
+        ready.push_back(entry);
+      }
+    }
+  }
+#endif
+
+  /* drain the wake-up pipe */
+  if (wokenUp)
+  {
+    char buf[64];
+    while (read(m_wakeupPipe[0], buf, sizeof(buf)) > 0) { /* nothing to do */ }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::rejectAssociation(T_ASC_Association *assoc,
+                                            const T_ASC_RejectParametersReason& reason)
+{
+  T_ASC_RejectParameters rej;
+  rej.result = ASC_RESULT_REJECTEDTRANSIENT;
+  rej.source = ASC_SOURCE_SERVICEPROVIDER_PRESENTATION_RELATED;
+  rej.reason = reason;
+  ASC_rejectAssociation( assoc, &rej );
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseSCPEventPool::dropAndDestroyAssociation(T_ASC_Association *assoc)
+{
+  if (assoc)
+  {
+    ASC_dropAssociation( assoc );
+    ASC_destroyAssociation( &assoc );
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+OFCondition DcmBaseSCPEventPool::initializeNetwork(T_ASC_Network** network)
+{
+  OFCondition cond = ASC_initializeNetwork(NET_ACCEPTOR, OFstatic_cast(int, m_cfg.getPort()), m_cfg.getACSETimeout(), network);
+  if (cond.good())
+  {
+    if (m_cfg.transportLayerEnabled())
+    {
+      cond = ASC_setTransportLayer(*network, m_cfg.getTransportLayer(), 0 /* Do not take over ownership */);
+      if (cond.bad())
+      {
+        DCMNET_ERROR("DcmBaseSCPEventPool: Error setting secured transport layer: " << cond.text());
+        ASC_dropNetwork(network);
+      }
+    }
+  }
+  return cond;
+}
+
+/* *********************************************************************** */
+/*               DcmBaseSCPEventPool::DcmBaseSCPHandler class              */
+/* *********************************************************************** */
+
+DcmBaseSCPEventPool::DcmBaseSCPHandler::DcmBaseSCPHandler()
+{
+}
+
+// ----------------------------------------------------------------------------
+
+DcmBaseSCPEventPool::DcmBaseSCPHandler::~DcmBaseSCPHandler()
+{
+  // do nothing
+}
+
+#endif // WITH_THREADS && !_WIN32
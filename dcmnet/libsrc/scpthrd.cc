@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2013-2019, OFFIS e.V.
+ *  Copyright (C) 2013-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -76,3 +76,37 @@ OFCondition DcmThreadSCP::run(T_ASC_Association* incomingAssoc)
   return result;
 
 }
+
+// ----------------------------------------------------------------------------
+
+OFCondition DcmThreadSCP::beginAssociation(T_ASC_Association* incomingAssoc,
+                                           OFBool& acknowledged)
+{
+  acknowledged = OFFalse;
+  if (incomingAssoc == NULL)
+  {
+    DCMNET_ERROR("Illegal Association handed to DcmSCP's beginAssociation(assoc) method");
+    return DIMSE_ILLEGALASSOCIATION;
+  }
+  if (isConnected())
+    return DIMSE_ILLEGALASSOCIATION;
+
+  m_assoc = incomingAssoc;
+
+  OFCondition result = acceptOrRefuseAssociation(acknowledged);
+  if (!acknowledged)
+  {
+    notifyAssociationTermination();
+    dropAndDestroyAssociation();
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmThreadSCP::endAssociation(const OFCondition& cond)
+{
+  handleAssociationTermination(cond);
+  notifyAssociationTermination();
+  dropAndDestroyAssociation();
+}
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2008-2024, OFFIS e.V.
+ *  Copyright (C) 2008-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -42,6 +42,7 @@ DcmSCU::DcmSCU()
     , m_assocConfigFile()
     , m_openDIMSERequest(NULL)
     , m_maxReceivePDULength(ASC_DEFAULTMAXPDU)
+    , m_maxOperationsInvoked(1)
     , m_blockMode(DIMSE_BLOCKING)
     , m_ourAETitle("ANY-SCU")
     , m_peer()
@@ -133,6 +134,11 @@ OFCondition DcmSCU::initNetwork()
     /* structure. The default values are "ANY-SCU" and "ANY-SCP". */
     ASC_setAPTitles(m_params, m_ourAETitle.c_str(), m_peerAETitle.c_str(), NULL);
 
+    /* propose asynchronous operations window (if any). The SCU does not perform */
+    /* more than one operation at a time, e.g. during a C-GET session. */
+    if (m_maxOperationsInvoked != 1)
+        ASC_setAsyncOperationsWindow(m_params, m_maxOperationsInvoked, 1);
+
     /* Figure out the presentation addresses and copy the */
     /* corresponding values into the association parameters.*/
     DIC_NODENAME peerHost;
@@ -689,6 +695,26 @@ OFCondition DcmSCU::sendSTORERequest(const T_ASC_PresentationContextID presID,
                                      Uint16& rspStatusCode,
                                      const OFString& moveOriginatorAETitle,
                                      const Uint16 moveOriginatorMsgID)
+{
+    Uint16 messageID = 0;
+    OFCondition cond
+        = sendSTORERequestAsync(presID, dicomFile, dataset, messageID, moveOriginatorAETitle, moveOriginatorMsgID);
+    if (cond.good())
+    {
+        /* Receive response (without checking the message ID, as before) */
+        Uint16 messageIDRespondedTo = 0;
+        cond = receiveSTOREResponse(messageIDRespondedTo, rspStatusCode);
+    }
+    return cond;
+}
+
+// Sends C-STORE request to another DICOM application without waiting for the response
+OFCondition DcmSCU::sendSTORERequestAsync(const T_ASC_PresentationContextID presID,
+                                          const OFFilename& dicomFile,
+                                          DcmDataset* dataset,
+                                          Uint16& messageID,
+                                          const OFString& moveOriginatorAETitle,
+                                          const Uint16 moveOriginatorMsgID)
 {
     // Do some basic validity checks
     if (!isConnected())
@@ -697,7 +723,6 @@ OFCondition DcmSCU::sendSTORERequest(const T_ASC_PresentationContextID presID,
     OFCondition cond;
     OFString tempStr;
     T_ASC_PresentationContextID pcid = presID;
-    DcmDataset* statusDetail         = NULL;
     T_DIMSE_Message msg;
     // Make sure everything is zeroed (especially options)
     memset((char*)&msg, 0, sizeof(msg));
@@ -835,12 +860,29 @@ OFCondition DcmSCU::sendSTORERequest(const T_ASC_PresentationContextID presID,
         DCMNET_ERROR("Failed sending C-STORE request: " << DimseCondition::dump(tempStr, cond));
         return cond;
     }
+    messageID = req->MessageID;
+    return cond;
+}
 
-    /* Receive response */
+// Receives the next C-STORE response from another DICOM application
+OFCondition DcmSCU::receiveSTOREResponse(Uint16& messageIDRespondedTo,
+                                         Uint16& rspStatusCode,
+                                         const OFBool waitForResponse)
+{
+    if (!isConnected())
+        return DIMSE_ILLEGALASSOCIATION;
+
+    /* Check whether (the beginning of) a response is available if we should not wait */
+    if (!waitForResponse && !DUL_unprocessedPDVs(m_assoc->DULassociation) && !ASC_dataWaiting(m_assoc, 0))
+        return DIMSE_NODATAAVAILABLE;
+
+    OFString tempStr;
+    T_ASC_PresentationContextID pcid = 0;
+    DcmDataset* statusDetail         = NULL;
     T_DIMSE_Message rsp;
     // Make sure everything is zeroed (especially options)
     memset((char*)&rsp, 0, sizeof(rsp));
-    cond = receiveDIMSECommand(&pcid, &rsp, &statusDetail, NULL /* not interested in the command set */);
+    OFCondition cond = receiveDIMSECommand(&pcid, &rsp, &statusDetail, NULL /* not interested in the command set */);
     if (cond.bad())
     {
         DCMNET_ERROR("Failed receiving DIMSE response: " << DimseCondition::dump(tempStr, cond));
@@ -869,6 +911,7 @@ OFCondition DcmSCU::sendSTORERequest(const T_ASC_PresentationContextID presID,
         return DIMSE_BADCOMMANDTYPE;
     }
     T_DIMSE_C_StoreRSP storeRsp = rsp.msg.CStoreRSP;
+    messageIDRespondedTo        = storeRsp.MessageIDBeingRespondedTo;
     rspStatusCode               = storeRsp.DimseStatus;
     if (statusDetail != NULL)
     {
@@ -2525,6 +2568,11 @@ void DcmSCU::setMaxReceivePDULength(const Uint32 maxRecPDU)
     m_maxReceivePDULength = maxRecPDU;
 }
 
+void DcmSCU::setMaxOperationsInvoked(const Uint16 maxOps)
+{
+    m_maxOperationsInvoked = maxOps;
+}
+
 void DcmSCU::setDIMSEBlockingMode(const T_DIMSE_BlockingMode blockingMode)
 {
     m_blockMode = blockingMode;
@@ -2608,6 +2656,25 @@ Uint32 DcmSCU::getMaxReceivePDULength() const
     return m_maxReceivePDULength;
 }
 
+Uint16 DcmSCU::getMaxOperationsInvoked() const
+{
+    return m_maxOperationsInvoked;
+}
+
+Uint16 DcmSCU::getNegotiatedMaxOperationsInvoked() const
+{
+    unsigned short maxOps = 1;
+    // without a proposal, the SCU always operates synchronously
+    if (isConnected() && (m_maxOperationsInvoked != 1))
+    {
+        ASC_getPeerAsyncOperationsWindow(m_params, &maxOps, NULL);
+        // the peer must not accept more than what has been proposed
+        if ((m_maxOperationsInvoked != 0) && ((maxOps == 0) || (maxOps > m_maxOperationsInvoked)))
+            maxOps = m_maxOperationsInvoked;
+    }
+    return maxOps;
+}
+
 OFBool DcmSCU::getTLSEnabled() const
 {
     return m_secureConnectionEnabled;
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2012-2022, OFFIS e.V.
+ *  Copyright (C) 2012-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -28,6 +28,11 @@ OFTEST_REGISTER(dcmnet_dimseStatusClass);
 
 #ifdef WITH_THREADS
 OFTEST_REGISTER(dcmnet_scp_pool);
+OFTEST_REGISTER(dcmnet_storescu_parallel_associations);
+#ifndef _WIN32
+OFTEST_REGISTER(dcmnet_scp_event_pool);
+OFTEST_REGISTER(dcmnet_scp_event_pool_slow_peers);
+#endif
 OFTEST_REGISTER(dcmnet_scp_builtin_verification_support);
 OFTEST_REGISTER(dcmnet_scp_fail_on_invalid_association_configuration);
 OFTEST_REGISTER(dcmnet_scp_fail_on_disallowed_host);
@@ -51,6 +56,10 @@ OFTEST_REGISTER(dcmnet_scu_sendNSETRequest_fails_when_requestedsopinstance_is_em
 OFTEST_REGISTER(dcmnet_scu_sendNSETRequest_succeeds_and_modifies_instance_when_scp_has_instance);
 OFTEST_REGISTER(dcmnet_scu_sendNSETRequest_succeeds_and_sets_responsestatuscode_from_scp_when_scp_sets_error_status);
 
+OFTEST_REGISTER(dcmnet_scp_receive_store_to_file);
+OFTEST_REGISTER(dcmnet_scp_receive_store_large_pdu);
+OFTEST_REGISTER(dcmnet_storescu_async_operations_window);
+
 #endif // WITH_THREADS
 
 OFTEST_MAIN("dcmnet")
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2013-2014, OFFIS e.V.
+ *  Copyright (C) 2013-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -15,7 +15,9 @@
  *
  *  Author:  Jan Schlamelcher
  *
- *  Purpose: Test DcmSCPPool class, including DcmSCP and DcmSCU interaction
+ *  Purpose: Test DcmSCPPool and DcmSCPEventPool classes, including DcmSCP and
+ *           DcmSCU interaction, sending with DcmStorageSCU in parallel, and
+ *           peers that send their requests slowly
  *
  */
 
@@ -26,7 +28,28 @@
 
 #include "dcmtk/ofstd/oftest.h"
 #include "dcmtk/dcmnet/scppool.h"
+#include "dcmtk/dcmnet/scpevpool.h"
 #include "dcmtk/dcmnet/scu.h"
+#include "dcmtk/dcmnet/dstorscu.h"
+#include "dcmtk/dcmnet/dcmtrans.h"
+#include "dcmtk/ofstd/oftimer.h"
+
+#ifndef _WIN32
+BEGIN_EXTERN_C
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
+#endif
+#ifdef HAVE_NETINET_IN_H
+#include <netinet/in.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+END_EXTERN_C
+#endif
 
 struct TestSCU : DcmSCU, OFThread
 {
@@ -110,4 +133,321 @@ OFTEST_FLAGS(dcmnet_scp_pool, EF_Slow)
     OFCHECK(pool.result.good());
 }
 
+/* number of C-STORE requests received by all instances of TestStoreSCP */
+static size_t numStoreRequests = 0;
+static OFMutex numStoreRequestsMutex;
+
+struct TestStoreSCP : DcmThreadSCP
+{
+protected:
+    OFCondition handleIncomingCommand(T_DIMSE_Message* incomingMsg, const DcmPresentationContextInfo& presInfo)
+    {
+        if (incomingMsg->CommandField == DIMSE_C_STORE_RQ)
+        {
+            T_DIMSE_C_StoreRQ& storeReq = incomingMsg->msg.CStoreRQ;
+            DcmDataset *dset = NULL;
+            OFCondition result = receiveSTORERequest(storeReq, presInfo.presentationContextID, dset);
+            delete dset;
+            if (result.good())
+            {
+                numStoreRequestsMutex.lock();
+                ++numStoreRequests;
+                numStoreRequestsMutex.unlock();
+                result = sendSTOREResponse(presInfo.presentationContextID, storeReq, STATUS_Success);
+            }
+            return result;
+        }
+        return DcmThreadSCP::handleIncomingCommand(incomingMsg, presInfo);
+    }
+};
+
+struct TestStorePool : DcmSCPPool<TestStoreSCP>, OFThread
+{
+    OFCondition result;
+protected:
+    void run()
+    {
+        result = listen();
+    }
+};
+
+struct TestParallelStorageSCU : DcmStorageSCU
+{
+    size_t numSuccess;
+    TestParallelStorageSCU() : numSuccess(0) { }
+protected:
+    void notifySOPInstanceSent(const TransferEntry &transferEntry)
+    {
+        if (transferEntry.RequestSent && (transferEntry.ResponseStatusCode == STATUS_Success))
+            ++numSuccess;
+    }
+};
+
+
+/* Test starts pool with a maximum of 2 SCP workers that accept C-STORE
+ * requests for two SOP classes. A storage SCU sends 40 SOP instances of
+ * both SOP classes on up to 4 associations in parallel. Associations
+ * rejected by the pool (since all workers are busy) must be compensated
+ * by sending the respective SOP instances on the other associations.
+ */
+OFTEST_FLAGS(dcmnet_storescu_parallel_associations, EF_Slow)
+{
+    TestStorePool pool;
+    DcmSCPConfig& config = pool.getConfig();
+
+    config.setAETitle("PoolTestSCP");
+    config.setPort(11112);
+    config.setConnectionBlockingMode(DUL_NOBLOCK);
+    config.setConnectionTimeout(1);
+
+    pool.setMaxThreads(2);
+    OFList<OFString> xfers;
+    xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+    xfers.push_back(UID_LittleEndianImplicitTransferSyntax);
+    config.addPresentationContext(UID_SecondaryCaptureImageStorage, xfers);
+    config.addPresentationContext(UID_ComputedRadiographyImageStorage, xfers);
+
+    pool.start();
+
+    TestParallelStorageSCU scu;
+    scu.setAETitle("PoolTestSCU");
+    scu.setPeerAETitle("PoolTestSCP");
+    scu.setPeerHostName("localhost");
+    scu.setPeerPort(11112);
+    scu.setHaltOnUnsuccessfulStoreMode(OFFalse);
+    char uid[100];
+    const size_t numInstances = 40;
+    for (size_t i = 0; i < numInstances; ++i)
+    {
+        DcmDataset *dset = new DcmDataset();
+        dset->putAndInsertString(DCM_SOPClassUID, (i < numInstances / 2) ? UID_SecondaryCaptureImageStorage : UID_ComputedRadiographyImageStorage);
+        dset->putAndInsertString(DCM_SOPInstanceUID, dcmGenerateUniqueIdentifier(uid, SITE_INSTANCE_UID_ROOT));
+        dset->putAndInsertString(DCM_PatientName, "Doe^John");
+        OFCHECK(scu.addDataset(dset, EXS_LittleEndianExplicit, DcmStorageSCU::HM_deleteAfterRemove).good());
+    }
+
+    // "ensure" the pool is initialized before the SCU starts connecting to it,
+    // see dcmnet_scp_pool
+    OFStandard::sleep(5);
+
+    numStoreRequests = 0;
+    OFCondition result = scu.sendSOPInstancesInParallel(4);
+    OFCHECK_MSG(result.good(), result.text());
+    OFCHECK_EQUAL(scu.numSuccess, numInstances);
+    OFCHECK_EQUAL(scu.getNumberOfSOPInstancesToBeSent(), 0);
+    OFCHECK(scu.getAssociationCounter() >= 4);
+
+    // Request shutdown.
+    pool.stopAfterCurrentAssociations();
+    pool.join();
+
+    OFCHECK(pool.result.good());
+    OFCHECK_EQUAL(numStoreRequests, numInstances);
+}
+
+#ifndef _WIN32
+
+struct TestMultiEchoSCU : DcmSCU, OFThread
+{
+    OFCondition result;
+protected:
+    void run()
+    {
+        result = negotiateAssociation();
+        for (int i = 0; (i < 10) && result.good(); ++i)
+            result = sendECHORequest(0);
+        releaseAssociation();
+    }
+};
+
+struct TestEventPool : DcmSCPEventPool<>, OFThread
+{
+    OFCondition result;
+protected:
+    void run()
+    {
+        result = listen();
+    }
+};
+
+
+/* Test starts event-driven pool with only 2 worker threads, configured
+ * to respond to C-ECHO (Verification SOP Class). 20 SCU threads are
+ * created and connect simultaneously to the pool, each sending 10 C-ECHO
+ * messages on its association before releasing the association.
+ */
+OFTEST_FLAGS(dcmnet_scp_event_pool, EF_Slow)
+{
+    TestEventPool pool;
+    DcmSCPConfig& config = pool.getConfig();
+
+    config.setAETitle("PoolTestSCP");
+    config.setPort(11112);
+    config.setDIMSEBlockingMode(DIMSE_NONBLOCKING);
+    config.setDIMSETimeout(30);
+
+    pool.setMaxThreads(2);
+    OFList<OFString> xfers;
+    xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+    xfers.push_back(UID_LittleEndianImplicitTransferSyntax);
+    config.addPresentationContext(UID_VerificationSOPClass, xfers);
+
+    pool.start();
+
+    OFVector<TestMultiEchoSCU*> scus(20);
+    for (OFVector<TestMultiEchoSCU*>::iterator it1 = scus.begin(); it1 != scus.end(); ++it1)
+    {
+        *it1 = new TestMultiEchoSCU;
+        (*it1)->setAETitle("PoolTestSCU");
+        (*it1)->setPeerAETitle("PoolTestSCP");
+        (*it1)->setPeerHostName("localhost");
+        (*it1)->setPeerPort(11112);
+        (*it1)->addPresentationContext(UID_VerificationSOPClass, xfers);
+        (*it1)->initNetwork();
+    }
+
+    // "ensure" the pool is initialized before any SCU starts connecting to it,
+    // see dcmnet_scp_pool
+    OFStandard::sleep(5);
+
+    for (OFVector<TestMultiEchoSCU*>::const_iterator it2 = scus.begin(); it2 != scus.end(); ++it2)
+        (*it2)->start();
+
+    for (OFVector<TestMultiEchoSCU*>::iterator it3 = scus.begin(); it3 != scus.end(); ++it3)
+    {
+        (*it3)->join();
+        OFCHECK((*it3)->result.good());
+        delete *it3;
+    }
+
+    // Request shutdown, which does not have to wait for a connection timeout.
+    pool.stopAfterCurrentAssociations();
+    pool.join();
+
+    OFCHECK(pool.result.good());
+    OFCHECK_EQUAL(pool.numAssociations(), 0);
+}
+
+/* open a TCP connection to the given port on the local host, without
+ * sending anything
+ */
+static int connectToLocalPort(unsigned short port)
+{
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0)
+        return -1;
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(sock, OFreinterpret_cast(struct sockaddr*, &addr), sizeof(addr)) != 0)
+    {
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+
+/* Test starts event-driven pool with a single worker thread and ACSE and
+ * DIMSE timeouts of 30 seconds. One peer connects without sending anything,
+ * another one sends only the header of an A-ASSOCIATE-RQ PDU, and a third
+ * one negotiates an association and then sends only the first part of a
+ * P-DATA-TF PDU. None of them must block the event loop or the worker
+ * thread, i.e. 5 SCUs sending C-ECHO messages in the meantime must be served
+ * well within the timeouts.
+ */
+OFTEST_FLAGS(dcmnet_scp_event_pool_slow_peers, EF_Slow)
+{
+    TestEventPool pool;
+    DcmSCPConfig& config = pool.getConfig();
+
+    config.setAETitle("PoolTestSCP");
+    config.setPort(11112);
+    config.setACSETimeout(30);
+    config.setDIMSEBlockingMode(DIMSE_NONBLOCKING);
+    config.setDIMSETimeout(30);
+
+    pool.setMaxThreads(1);
+    OFList<OFString> xfers;
+    xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+    xfers.push_back(UID_LittleEndianImplicitTransferSyntax);
+    config.addPresentationContext(UID_VerificationSOPClass, xfers);
+
+    pool.start();
+
+    OFVector<TestMultiEchoSCU*> scus(5);
+    for (OFVector<TestMultiEchoSCU*>::iterator it1 = scus.begin(); it1 != scus.end(); ++it1)
+    {
+        *it1 = new TestMultiEchoSCU;
+        (*it1)->setAETitle("PoolTestSCU");
+        (*it1)->setPeerAETitle("PoolTestSCP");
+        (*it1)->setPeerHostName("localhost");
+        (*it1)->setPeerPort(11112);
+        (*it1)->addPresentationContext(UID_VerificationSOPClass, xfers);
+        (*it1)->initNetwork();
+    }
+
+    // "ensure" the pool is initialized before any peer starts connecting to it,
+    // see dcmnet_scp_pool
+    OFStandard::sleep(5);
+
+    // a peer that does not send anything
+    const int silentPeer = connectToLocalPort(11112);
+    OFCHECK(silentPeer >= 0);
+
+    // a peer that sends only the PDU header of an association request
+    const int partialRequestPeer = connectToLocalPort(11112);
+    OFCHECK(partialRequestPeer >= 0);
+    const unsigned char requestHeader[] = { 0x01, 0x00, 0x00, 0x00, 0x00, 0x44 };
+    OFCHECK(write(partialRequestPeer, requestHeader, sizeof(requestHeader)) == sizeof(requestHeader));
+
+    // a peer that sends only the PDU and PDV headers of a C-ECHO request
+    T_ASC_Network *net = NULL;
+    T_ASC_Parameters *params = NULL;
+    T_ASC_Association *assoc = NULL;
+    const char *ts[] = { UID_LittleEndianImplicitTransferSyntax };
+    OFCHECK(ASC_initializeNetwork(NET_REQUESTOR, 0, 30, &net).good());
+    OFCHECK(ASC_createAssociationParameters(&params, ASC_DEFAULTMAXPDU, 30).good());
+    OFCHECK(ASC_setAPTitles(params, "PoolTestSCU", "PoolTestSCP", NULL).good());
+    OFCHECK(ASC_setPresentationAddresses(params, "localhost", "localhost:11112").good());
+    OFCHECK(ASC_addPresentationContext(params, 1, UID_VerificationSOPClass, ts, 1).good());
+    OFCHECK(ASC_requestAssociation(net, params, &assoc).good());
+    const unsigned char dataHeader[] = { 0x04, 0x00, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x4c, 0x01, 0x03 };
+    DcmTransportConnection *connection = assoc ? DUL_getTransportConnection(assoc->DULassociation) : NULL;
+    OFCHECK(connection != NULL);
+    if (connection)
+        OFCHECK(connection->write(OFconst_cast(unsigned char*, dataHeader), sizeof(dataHeader)) == sizeof(dataHeader));
+
+    OFTimer timer;
+    for (OFVector<TestMultiEchoSCU*>::const_iterator it2 = scus.begin(); it2 != scus.end(); ++it2)
+        (*it2)->start();
+
+    for (OFVector<TestMultiEchoSCU*>::iterator it3 = scus.begin(); it3 != scus.end(); ++it3)
+    {
+        (*it3)->join();
+        OFCHECK((*it3)->result.good());
+        delete *it3;
+    }
+    OFCHECK(timer.getDiff() < 10.0);
+
+    // Close the connections of the slow peers, which ends their associations.
+    if (silentPeer >= 0)
+        close(silentPeer);
+    if (partialRequestPeer >= 0)
+        close(partialRequestPeer);
+    ASC_dropAssociation(assoc);
+    ASC_destroyAssociation(&assoc);
+    ASC_dropNetwork(&net);
+
+    pool.stopAfterCurrentAssociations();
+    pool.join();
+
+    OFCHECK(pool.result.good());
+    OFCHECK_EQUAL(pool.numAssociations(), 0);
+}
+
+#endif // _WIN32
+
 #endif // WITH_THREADS
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2017-2023, OFFIS e.V.
+ *  Copyright (C) 2017-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -26,8 +26,10 @@
 #include "dcmtk/ofstd/oftest.h"
 #include "dcmtk/ofstd/oftimer.h"
 #include "dcmtk/ofstd/ofrand.h"
+#include "dcmtk/ofstd/oftempf.h"
 #include "dcmtk/dcmnet/scp.h"
 #include "dcmtk/dcmnet/scu.h"
+#include "dcmtk/dcmnet/dstorscu.h"
 
 
 /** SCP derived from DcmSCP in order to test two types of virtual methods:
@@ -1112,5 +1114,273 @@ OFTEST_FLAGS(dcmnet_scu_sendNSETRequest_succeeds_and_sets_responsestatuscode_fro
     OFCHECK_MSG((result = fixture.mppsSCU.releaseAssociation()).good(), result.text());
 }
 
+/** Test SCP that stores incoming C-STORE requests directly to file */
+struct TestSCPWithStoreSupport : TestSCP
+{
+    TestSCPWithStoreSupport(const OFString& filename, const Uint32 maxReceivePDU)
+        : TestSCP()
+        , m_filename(filename)
+        , m_store_result(EC_NotYetImplemented)
+    {
+        DcmSCPConfig& config = getConfig();
+        config.setAETitle("STORE_SCP");
+        config.setConnectionBlockingMode(DUL_NOBLOCK);
+        config.setConnectionTimeout(10);
+        config.setHostLookupEnabled(OFFalse);
+        config.setMaxReceivePDULength(maxReceivePDU);
+        configure_scp_for_echo(config, 0);
+        OFCHECK(openListenPort().good());
+        m_portNum = config.getPort();
+        OFList<OFString> xfers;
+        xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+        OFCHECK(config.addPresentationContext(UID_SecondaryCaptureImageStorage, xfers).good());
+        m_set_stop_after_assoc = OFTrue;
+    }
+
+    /** Overloads base class to store C-STORE requests to file. */
+    OFCondition handleIncomingCommand(T_DIMSE_Message* incomingMsg, const DcmPresentationContextInfo& presInfo) /* override */
+    {
+        if (incomingMsg->CommandField == DIMSE_C_STORE_RQ)
+        {
+            T_DIMSE_C_StoreRQ& storeReq = incomingMsg->msg.CStoreRQ;
+            m_store_result = receiveSTORERequest(storeReq, presInfo.presentationContextID, m_filename);
+            if (m_store_result.good())
+                return sendSTOREResponse(presInfo.presentationContextID, storeReq, STATUS_Success);
+            return m_store_result;
+        }
+        return DcmSCP::handleIncomingCommand(incomingMsg, presInfo);
+    }
+
+    /// The file in which the received dataset is stored
+    OFString m_filename;
+    /// The result of receiving the C-STORE request
+    OFCondition m_store_result;
+    /// The port the SCP is listening on
+    Uint16 m_portNum;
+};
+
+
+/** Send a dataset with a large pixel data element to an SCP that stores
+ *  it directly to file, and compare the received file with the original.
+ *  @param maxReceivePDU maximum PDU size of the SCP
+ *  @param bufferSize value of dcmReceiveDataSetBufferSize to use
+ */
+static void test_store_to_file(const Uint32 maxReceivePDU, const Uint32 bufferSize)
+{
+    OFTempFile tempFile;
+    OFCHECK(tempFile.getStatus().good());
+    const Uint32 oldBufferSize = dcmReceiveDataSetBufferSize.get();
+    dcmReceiveDataSetBufferSize.set(bufferSize);
+
+    DcmDataset dset;
+    dset.putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+    dset.putAndInsertString(DCM_SOPInstanceUID, "1.2.276.0.7230010.3.1.4.8323329.22");
+    dset.putAndInsertString(DCM_PatientName, "Doe^John");
+    const unsigned long numPixels = 1000001;
+    Uint16 *pixels = new Uint16[numPixels];
+    for (unsigned long i = 0; i < numPixels; ++i)
+        pixels[i] = OFstatic_cast(Uint16, i * 7);
+    dset.putAndInsertUint16Array(DCM_PixelData, pixels, numPixels);
+    delete[] pixels;
+
+    TestSCPWithStoreSupport scp(tempFile.getFilename(), maxReceivePDU);
+    scp.start();
+    OFStandard::forceSleep(1);
+
+    DcmSCU scu;
+    scu.setAETitle("STORE_SCU");
+    scu.setPeerAETitle("STORE_SCP");
+    scu.setPeerHostName("localhost");
+    scu.setPeerPort(scp.m_portNum);
+    scu.setConnectionTimeout(10);
+    scu.setMaxReceivePDULength(16384);
+    OFList<OFString> xfers;
+    xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+    OFCHECK(scu.addPresentationContext(UID_SecondaryCaptureImageStorage, xfers).good());
+    OFCondition result;
+    OFCHECK_MSG((result = scu.initNetwork()).good(), result.text());
+    OFCHECK_MSG((result = scu.negotiateAssociation()).good(), result.text());
+    const T_ASC_PresentationContextID presID = scu.findPresentationContextID(UID_SecondaryCaptureImageStorage, UID_LittleEndianExplicitTransferSyntax);
+    OFCHECK(presID != 0);
+    Uint16 rspStatusCode = 0xffff;
+    OFCHECK_MSG((result = scu.sendSTORERequest(presID, "", &dset, rspStatusCode)).good(), result.text());
+    OFCHECK_EQUAL(rspStatusCode, STATUS_Success);
+    OFCHECK_MSG((result = scu.releaseAssociation()).good(), result.text());
+    OFCHECK(scp.join() == 0);
+    dcmReceiveDataSetBufferSize.set(oldBufferSize);
+    OFCHECK_MSG(scp.m_store_result.good(), scp.m_store_result.text());
+
+    DcmFileFormat fileformat;
+    OFCHECK_MSG((result = fileformat.loadFile(tempFile.getFilename())).good(), result.text());
+    if (result.good())
+    {
+        OFCHECK_EQUAL(fileformat.getDataset()->getOriginalXfer(), EXS_LittleEndianExplicit);
+        OFCHECK_EQUAL(fileformat.getDataset()->compare(dset), 0);
+    }
+}
+
+OFTEST_FLAGS(dcmnet_scp_receive_store_to_file, EF_Slow)
+{
+    // data set written in PDV sized chunks
+    test_store_to_file(16384, 0);
+    // coalescing buffer smaller than a PDV
+    test_store_to_file(16384, 1000);
+    // coalescing buffer larger than a PDV, small and large PDUs
+    test_store_to_file(4096, 262144);
+    test_store_to_file(ASC_MAXIMUMPDUSIZE, 262144);
+}
+
+OFTEST_FLAGS(dcmnet_scp_receive_store_large_pdu, EF_Slow)
+{
+    // PDUs larger than ASC_MAXIMUMPDUSIZE require the limit to be raised
+    const Uint32 oldLimit = dcmMaxPDUSizeLimit.get();
+    dcmMaxPDUSizeLimit.set(4194304);
+    // data set split into several PDUs, or sent in a single PDU
+    test_store_to_file(1048576, 0);
+    test_store_to_file(4194304, 262144);
+    dcmMaxPDUSizeLimit.set(oldLimit);
+}
+
+
+/** Test SCP that accepts C-STORE requests (into memory) with an asynchronous
+ *  operations window and checks the order of the incoming message IDs
+ */
+struct TestSCPWithAsyncStoreSupport : TestSCP
+{
+    TestSCPWithAsyncStoreSupport(const Uint16 maxOperations)
+        : TestSCP()
+        , m_num_received(0)
+        , m_last_message_id(0)
+        , m_message_ids_ascending(OFTrue)
+    {
+        DcmSCPConfig& config = getConfig();
+        config.setAETitle("STORE_SCP");
+        config.setConnectionBlockingMode(DUL_NOBLOCK);
+        config.setConnectionTimeout(10);
+        config.setHostLookupEnabled(OFFalse);
+        config.setMaxOperationsInvoked(maxOperations);
+        configure_scp_for_echo(config, 0);
+        OFCHECK(openListenPort().good());
+        m_portNum = config.getPort();
+        OFList<OFString> xfers;
+        xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+        OFCHECK(config.addPresentationContext(UID_SecondaryCaptureImageStorage, xfers).good());
+        m_set_stop_after_assoc = OFTrue;
+    }
+
+    /** Overloads base class to receive C-STORE requests. */
+    OFCondition handleIncomingCommand(T_DIMSE_Message* incomingMsg, const DcmPresentationContextInfo& presInfo) /* override */
+    {
+        if (incomingMsg->CommandField == DIMSE_C_STORE_RQ)
+        {
+            T_DIMSE_C_StoreRQ& storeReq = incomingMsg->msg.CStoreRQ;
+            DcmDataset *dset = NULL;
+            OFCondition result = receiveSTORERequest(storeReq, presInfo.presentationContextID, dset);
+            delete dset;
+            if (result.bad())
+                return result;
+            if (storeReq.MessageID <= m_last_message_id)
+                m_message_ids_ascending = OFFalse;
+            m_last_message_id = storeReq.MessageID;
+            ++m_num_received;
+            return sendSTOREResponse(presInfo.presentationContextID, storeReq, STATUS_Success);
+        }
+        return DcmSCP::handleIncomingCommand(incomingMsg, presInfo);
+    }
+
+    /// The number of C-STORE requests received
+    size_t m_num_received;
+    /// The message ID of the last C-STORE request received
+    Uint16 m_last_message_id;
+    /// Indicator whether the message IDs were received in ascending order
+    OFBool m_message_ids_ascending;
+    /// The port the SCP is listening on
+    Uint16 m_portNum;
+};
+
+
+/** Storage SCU that records the response status of each SOP instance sent */
+struct TestStorageSCU : DcmStorageSCU
+{
+    TestStorageSCU()
+        : DcmStorageSCU()
+        , m_num_sent(0)
+        , m_num_success(0)
+    {
+    }
+
+    /** Overloads base class to count the responses. */
+    void notifySOPInstanceSent(const TransferEntry &transferEntry) /* override */
+    {
+        ++m_num_sent;
+        if (transferEntry.RequestSent && (transferEntry.ResponseStatusCode == STATUS_Success))
+            ++m_num_success;
+    }
+
+    /// The number of SOP instances for which the sending process has been completed
+    size_t m_num_sent;
+    /// The number of SOP instances that were stored successfully
+    size_t m_num_success;
+};
+
+
+/** Send a number of SOP instances with DcmStorageSCU to an SCP that accepts
+ *  an asynchronous operations window, and check the negotiated window size
+ *  and the response to each C-STORE request.
+ *  @param maxOperationsSCU maximum number of operations proposed by the SCU
+ *  @param maxOperationsSCP maximum number of operations accepted by the SCP
+ *  @param expectedWindow expected negotiated number of operations
+ */
+static void test_async_store(const Uint16 maxOperationsSCU, const Uint16 maxOperationsSCP, const Uint16 expectedWindow)
+{
+    const size_t numInstances = 20;
+    TestSCPWithAsyncStoreSupport scp(maxOperationsSCP);
+    scp.start();
+    OFStandard::forceSleep(1);
+
+    TestStorageSCU scu;
+    scu.setAETitle("STORE_SCU");
+    scu.setPeerAETitle("STORE_SCP");
+    scu.setPeerHostName("localhost");
+    scu.setPeerPort(scp.m_portNum);
+    scu.setConnectionTimeout(10);
+    scu.setMaxOperationsInvoked(maxOperationsSCU);
+    char uid[100];
+    for (size_t i = 0; i < numInstances; ++i)
+    {
+        DcmDataset *dset = new DcmDataset();
+        dset->putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+        dset->putAndInsertString(DCM_SOPInstanceUID, dcmGenerateUniqueIdentifier(uid, SITE_INSTANCE_UID_ROOT));
+        dset->putAndInsertString(DCM_PatientName, "Doe^John");
+        OFCHECK(scu.addDataset(dset, EXS_LittleEndianExplicit, DcmStorageSCU::HM_deleteAfterRemove).good());
+    }
+    OFCondition result;
+    OFCHECK_MSG((result = scu.addPresentationContexts()).good(), result.text());
+    OFCHECK_MSG((result = scu.initNetwork()).good(), result.text());
+    OFCHECK_MSG((result = scu.negotiateAssociation()).good(), result.text());
+    OFCHECK_EQUAL(scu.getNegotiatedMaxOperationsInvoked(), expectedWindow);
+    OFCHECK_MSG((result = scu.sendSOPInstances()).good(), result.text());
+    OFCHECK_MSG((result = scu.releaseAssociation()).good(), result.text());
+    OFCHECK(scp.join() == 0);
+    OFCHECK_EQUAL(scu.m_num_sent, numInstances);
+    OFCHECK_EQUAL(scu.m_num_success, numInstances);
+    OFCHECK_EQUAL(scp.m_num_received, numInstances);
+    OFCHECK(scp.m_message_ids_ascending);
+}
+
+OFTEST_FLAGS(dcmnet_storescu_async_operations_window, EF_Slow)
+{
+    // no window proposed
+    test_async_store(1, 4, 1);
+    // window proposed but not accepted
+    test_async_store(4, 1, 1);
+    // window reduced by the SCP
+    test_async_store(8, 3, 3);
+    // window reduced by the SCU
+    test_async_store(2, 0, 2);
+    // unlimited window
+    test_async_store(0, 0, 0);
+}
+
 
 #endif // WITH_THREADS
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1993-2023, OFFIS e.V.
+ *  Copyright (C) 1993-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -30,6 +30,7 @@
 #include "dcmtk/dcmdata/dcuid.h"
 #include "dcmtk/dcmdata/dcdeftag.h"
 #include "dcmtk/dcmdata/dcspchrs.h"
+#include "dcmtk/dcmdata/dcmatch.h"
 #include "dcmtk/dcmqrdb/dcmqrdbi.h"
 
 BEGIN_EXTERN_C
@@ -180,7 +181,7 @@ private:
 struct DCMTK_DCMQRDB_EXPORT DB_ElementList
 {
     /// default constructor
-    DB_ElementList(): elem(), next(NULL), utf8Value() {}
+    DB_ElementList(): elem(), next(NULL), utf8Value(), compiledQuery(), compiledUTF8Query() {}
 
     /// current list element
     DB_SmallDcmElmt elem ;
@@ -191,6 +192,13 @@ struct DCMTK_DCMQRDB_EXPORT DB_ElementList
     /// UTF-8 cache
     OFoptional<OFString> utf8Value ;
 
+    /// query value prepared for matching, created when the element is first matched
+    DcmAttributeMatching::CompiledQuery compiledQuery ;
+
+    /// UTF-8 cache prepared for matching, created when the element is first matched
+    /// against a candidate that requires character set conversion
+    DcmAttributeMatching::CompiledQuery compiledUTF8Query ;
+
 private:
     /** private undefined copy constructor
      * @param copy documented to avoid doxygen warning
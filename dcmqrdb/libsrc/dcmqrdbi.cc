@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1993-2023, OFFIS e.V.
+ *  Copyright (C) 1993-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -916,16 +916,24 @@ public:
 #endif
         }
 
+        // check whether the converted query value is used
+        const OFBool usesUTF8Query = query->utf8Value && (pQuery == query->utf8Value->c_str());
+
         // remove leading and trailing spaces before matching
         if (vr.isaString()) {
             OFStandard::trimString(pQuery, pQueryEnd);
             OFStandard::trimString(pCandidate, pCandidateEnd);
         }
 
-        // use DcmAttributeMatching to perform the appropriate matching function
-        // for the given VR
-        return DcmAttributeMatching( vr )( pQuery, pQueryEnd - pQuery,
-                                           pCandidate, pCandidateEnd - pCandidate );
+        // prepare the query value for the appropriate matching function for the
+        // given VR when it is used for the first time, since the same query key
+        // is usually matched against all records in the database. The original
+        // and the converted query value are prepared separately, since records
+        // in different character sets may be matched against the same key.
+        DcmAttributeMatching::CompiledQuery& compiledQuery = usesUTF8Query ? query->compiledUTF8Query : query->compiledQuery;
+        if (!compiledQuery)
+            compiledQuery = DcmAttributeMatching::CompiledQuery( vr, pQuery, pQueryEnd - pQuery );
+        return compiledQuery( pCandidate, pCandidateEnd - pCandidate );
     }
 
 private:
@@ -0,0 +1,160 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmqrdb
+ *
+ *  Author:  agent
+ *
+ *  Purpose: test program for class DcmQueryRetrieveIndexDatabaseHandle
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcspchrs.h"
+#include "dcmtk/dcmnet/dimse.h"
+#include "dcmtk/dcmqrdb/dcmqrdbi.h"
+#include "dcmtk/dcmqrdb/dcmqrdbs.h"
+#include "dcmtk/dcmqrdb/dcmqrcnf.h"
+
+#ifdef HAVE_WINDOWS_H
+#include <direct.h>      /* for _rmdir() */
+#define rmdir _rmdir
+#elif defined(HAVE_UNISTD_H)
+#include <unistd.h>      /* for rmdir() */
+#endif
+
+
+/* store a patient record with the given name and character set in the database */
+static void storePatient(DcmQueryRetrieveIndexDatabaseHandle& dbHandle,
+                         const OFString& storageArea,
+                         const char *patientID,
+                         const char *patientName,
+                         const char *characterSet,
+                         OFList<OFString>& files)
+{
+    char sopInstanceUID[100];
+    char studyInstanceUID[100];
+    char seriesInstanceUID[100];
+    dcmGenerateUniqueIdentifier(sopInstanceUID, SITE_INSTANCE_UID_ROOT);
+    dcmGenerateUniqueIdentifier(studyInstanceUID, SITE_STUDY_UID_ROOT);
+    dcmGenerateUniqueIdentifier(seriesInstanceUID, SITE_SERIES_UID_ROOT);
+    DcmFileFormat fileformat;
+    DcmDataset *dset = fileformat.getDataset();
+    OFCHECK(dset->putAndInsertString(DCM_SpecificCharacterSet, characterSet).good());
+    OFCHECK(dset->putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage).good());
+    OFCHECK(dset->putAndInsertString(DCM_SOPInstanceUID, sopInstanceUID).good());
+    OFCHECK(dset->putAndInsertString(DCM_StudyInstanceUID, studyInstanceUID).good());
+    OFCHECK(dset->putAndInsertString(DCM_SeriesInstanceUID, seriesInstanceUID).good());
+    OFCHECK(dset->putAndInsertString(DCM_PatientID, patientID).good());
+    OFCHECK(dset->putAndInsertString(DCM_PatientName, patientName).good());
+    OFString filename;
+    OFStandard::combineDirAndFilename(filename, storageArea, OFString(patientID) + ".dcm");
+    OFCHECK(fileformat.saveFile(filename, EXS_LittleEndianExplicit).good());
+    files.push_back(filename);
+    DcmQueryRetrieveDatabaseStatus status;
+    OFCHECK(dbHandle.storeRequest(UID_SecondaryCaptureImageStorage, sopInstanceUID, filename.c_str(), &status).good());
+    OFCHECK_EQUAL(status.status(), STATUS_Success);
+}
+
+
+/* find the patients with the given name and return their IDs in sorted order */
+static OFString findPatients(DcmQueryRetrieveIndexDatabaseHandle& dbHandle,
+                             const char *patientName,
+                             const char *characterSet)
+{
+    DcmDataset query;
+    OFCHECK(query.putAndInsertString(DCM_SpecificCharacterSet, characterSet).good());
+    OFCHECK(query.putAndInsertString(DCM_QueryRetrieveLevel, "PATIENT").good());
+    OFCHECK(query.putAndInsertString(DCM_PatientName, patientName).good());
+    OFCHECK(query.insertEmptyElement(DCM_PatientID).good());
+    DcmQueryRetrieveDatabaseStatus status;
+    OFCHECK(dbHandle.startFindRequest(UID_FINDPatientRootQueryRetrieveInformationModel, &query, &status).good());
+    OFList<OFString> patientIDs;
+    DcmQueryRetrieveCharacterSetOptions characterSetOptions;
+    while (DICOM_PENDING_STATUS(status.status()))
+    {
+        DcmDataset *response = NULL;
+        OFCHECK(dbHandle.nextFindResponse(&response, &status, characterSetOptions).good());
+        if (response != NULL)
+        {
+            OFString patientID;
+            OFCHECK(response->findAndGetOFString(DCM_PatientID, patientID).good());
+            OFListIterator(OFString) pos = patientIDs.begin();
+            while ((pos != patientIDs.end()) && (*pos < patientID))
+                ++pos;
+            patientIDs.insert(pos, patientID);
+            delete response;
+        }
+    }
+    OFCHECK_EQUAL(status.status(), STATUS_Success);
+    OFString result;
+    for (OFListIterator(OFString) it = patientIDs.begin(); it != patientIDs.end(); ++it)
+    {
+        if (!result.empty())
+            result += ' ';
+        result += *it;
+    }
+    return result;
+}
+
+
+OFTEST(dcmqrdb_findMixedCharacterSets)
+{
+    if (!DcmSpecificCharacterSet::isConversionAvailable())
+    {
+        OFCHECK_FAIL("Could not test the query, no character set conversion available");
+        return;
+    }
+    // use a new directory next to a temporary file as storage area
+    OFTempFile temp;
+    const OFString storageArea = OFString(temp.getFilename()) + ".d";
+    if (OFStandard::createDirectory(storageArea, "").bad())
+    {
+        OFCHECK_FAIL("Could not create temporary directory: " << storageArea);
+        return;
+    }
+    OFList<OFString> files;
+    {
+        OFCondition cond;
+        DcmQueryRetrieveIndexDatabaseHandle dbHandle(storageArea.c_str(), 10 /* maxStudies */, -1 /* maxBytesPerStudy */, cond);
+        OFCHECK(cond.good());
+        if (cond.good())
+        {
+            // records in ISO_IR 100 and ISO_IR 192 are matched against the same query key
+            storePatient(dbHandle, storageArea, "1", "M\xfcller^Hans", "ISO_IR 100", files);
+            storePatient(dbHandle, storageArea, "2", "M\xc3\xbcller^Anna", "ISO_IR 192", files);
+            storePatient(dbHandle, storageArea, "3", "Meier^Karl", "ISO_IR 100", files);
+            storePatient(dbHandle, storageArea, "4", "M\xc3\xbcller^Eva", "ISO_IR 192", files);
+            storePatient(dbHandle, storageArea, "5", "M\xfcller^Paul", "ISO_IR 100", files);
+            // a query that needs conversion for the ISO_IR 192 records only
+            OFCHECK_EQUAL(findPatients(dbHandle, "M\xfcller*", "ISO_IR 100"), "1 2 4 5");
+            // a query that needs conversion of the ISO_IR 100 records only
+            OFCHECK_EQUAL(findPatients(dbHandle, "M\xc3\xbcller*", "ISO_IR 192"), "1 2 4 5");
+            OFCHECK_EQUAL(findPatients(dbHandle, "M\xfcller^Anna", "ISO_IR 100"), "2");
+            OFCHECK_EQUAL(findPatients(dbHandle, "M\xc3\xbcller^Paul", "ISO_IR 192"), "5");
+        }
+    }
+    // remove the storage area
+    for (OFListIterator(OFString) it = files.begin(); it != files.end(); ++it)
+        OFStandard::deleteFile(*it);
+    OFString indexFile;
+    OFStandard::combineDirAndFilename(indexFile, storageArea, DBINDEXFILE);
+    OFStandard::deleteFile(indexFile);
+    rmdir(storageArea.c_str());
+}
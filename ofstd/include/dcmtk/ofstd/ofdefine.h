@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2024, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -41,4 +41,11 @@
 #define OFconstexpr
 #endif // NOT C++11
 
+/* define OFnoexcept to 'noexcept' or 'throw()' if not supported */
+#ifdef HAVE_CXX11
+#define OFnoexcept noexcept
+#else // C++11
+#define OFnoexcept throw()
+#endif // NOT C++11
+
 #endif
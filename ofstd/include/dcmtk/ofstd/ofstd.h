@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2000-2024, OFFIS e.V.
+ *  Copyright (C) 2000-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -797,6 +797,26 @@ class DCMTK_OFSTD_EXPORT OFStandard
      static double atof(const char *s,
                         OFBool *success = NULL);
 
+     /** converts a floating-point number from an ASCII decimal representation
+      *  of the given length to internal double-precision format.
+      *  This function works like atof(const char *, OFBool *), except that the
+      *  string does not need to be NUL-terminated and may be followed by trailing
+      *  white space. Values with at most 15 significant digits and a small
+      *  decimal exponent, i.e.\ the typical content of a Decimal String (DS),
+      *  are converted directly (and correctly rounded) without any memory
+      *  allocation; all other values are converted by the general implementation.
+      *  @param s pointer to the first character of the decimal ASCII
+      *    floating-point number, optionally preceded by white space.
+      *  @param length number of characters in s.
+      *  @param success pointer to return status code, may be NULL.
+      *    The status is OFTrue if a conversion could be performed
+      *    and OFFalse if the string does not have the expected format.
+      *  @return floating-point equivalent of string.
+      */
+     static double atof(const char *s,
+                        size_t length,
+                        OFBool *success);
+
      /** formats a floating-point number into an ASCII string.
       *  This function works similar to sprintf(), except that this
       *  implementation is not affected by a locale setting.
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2001-2024, OFFIS e.V.
+ *  Copyright (C) 2001-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -115,6 +115,7 @@ END_EXTERN_C
 
 
 #include <cmath>
+#include <cfloat>        /* for FLT_EVAL_METHOD */
 #include <cstring>       /* for memset() */
 #include <sstream>
 
@@ -1920,6 +1921,112 @@ size_t OFStandard::decodeBase64(const OFString &data,
     return count;
 }
 
+/* Exact powers of ten that can be represented as a double. Multiplying or dividing
+ * an integer of at most 53 bits by one of them results in a correctly rounded value.
+ */
+static const double atof_exactPowersOf10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Fast path for the conversion of simple decimal numbers ("-I.FE-X") with at most
+ * 15 significant digits, see OFStandard::atof(const char *, size_t, OFBool *).
+ * Returns OFFalse if the number cannot be converted this way (e.g. too many digits,
+ * large exponent, "NaN" or unexpected trailing characters); in this case, the
+ * general implementation has to be used.
+ */
+static OFBool atof_fastPath(const char *s, const char *end, double &result)
+{
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD != 0)
+    /* excess precision (e.g. x87) would cause double rounding */
+    return OFFalse;
+#else
+    while ((s != end) && ((*s == ' ') || (*s == '\t'))) ++s;
+    OFBool negative = OFFalse;
+    if ((s != end) && ((*s == '-') || (*s == '+')))
+        negative = (*s++ == '-');
+    Uint64 mantissa = 0;
+    int digits = 0;        // number of significant digits in the mantissa
+    int exponent = 0;      // decimal exponent of the mantissa
+    OFBool hasDigits = OFFalse;
+    for (; (s != end) && (*s >= '0') && (*s <= '9'); ++s)
+    {
+        hasDigits = OFTrue;
+        if (mantissa || (*s != '0'))
+        {
+            if (++digits > 15) return OFFalse;
+            mantissa = mantissa * 10 + (*s - '0');
+        }
+    }
+    if ((s != end) && (*s == '.'))
+    {
+        for (++s; (s != end) && (*s >= '0') && (*s <= '9'); ++s)
+        {
+            hasDigits = OFTrue;
+            --exponent;
+            if (mantissa || (*s != '0'))
+            {
+                if (++digits > 15) return OFFalse;
+                mantissa = mantissa * 10 + (*s - '0');
+            }
+        }
+    }
+    if (!hasDigits) return OFFalse;
+    if ((s != end) && ((*s == 'e') || (*s == 'E')))
+    {
+        ++s;
+        OFBool negativeExponent = OFFalse;
+        if ((s != end) && ((*s == '-') || (*s == '+')))
+            negativeExponent = (*s++ == '-');
+        if ((s == end) || (*s < '0') || (*s > '9')) return OFFalse;
+        int value = 0;
+        for (; (s != end) && (*s >= '0') && (*s <= '9'); ++s)
+        {
+            if (value > 1000) return OFFalse;
+            value = value * 10 + (*s - '0');
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+    /* only trailing white space is permitted */
+    while ((s != end) && ((*s == ' ') || (*s == '\t'))) ++s;
+    if (s != end) return OFFalse;
+    double d = OFstatic_cast(double, mantissa);
+    if (mantissa == 0)
+        exponent = 0;
+    if ((exponent < -22) || (exponent > 22)) return OFFalse;
+    if (exponent < 0)
+        d /= atof_exactPowersOf10[-exponent];
+    else
+        d *= atof_exactPowersOf10[exponent];
+    result = negative ? -d : d;
+    return OFTrue;
+#endif
+}
+
+
+double OFStandard::atof(const char *s, size_t length, OFBool *success)
+{
+    double d = 0.0;
+    if (s && atof_fastPath(s, s + length, d))
+    {
+        if (success) *success = OFTrue;
+        return d;
+    }
+    if (success) *success = OFFalse;
+    if (s == NULL) return d;
+    /* use the general implementation with a NUL-terminated copy of the string */
+    char buf[64];
+    if (length < sizeof(buf))
+    {
+        memcpy(buf, s, length);
+        buf[length] = '\0';
+        return OFStandard::atof(buf, success);
+    }
+    return OFStandard::atof(OFString(s, length).c_str(), success);
+}
+
+
 #ifndef ENABLE_OLD_OFSTD_ATOF_IMPLEMENTATION
 
 double OFStandard::atof(const char *s, OFBool *success)
@@ -1928,6 +2035,13 @@ double OFStandard::atof(const char *s, OFBool *success)
   if (success) *success = OFFalse;
   if (s)
   {
+    // try the fast conversion of simple numbers first
+    if (atof_fastPath(s, s + strlen(s), d))
+    {
+        if (success) *success = OFTrue;
+        return d;
+    }
+
     // convert input to a string object
     STD_NAMESPACE string ss(s);
 
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2024, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -28,6 +28,8 @@
 #include "dcmtk/ofstd/oftest.h"
 
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 struct ValuePair
 {
@@ -123,3 +125,47 @@ OFTEST(ofstd_atof)
     }
   }
 }
+
+
+OFTEST(ofstd_atof_length)
+{
+  OFBool r = OFFalse;
+  // values that are not NUL-terminated
+  const char *buf = "12.5\\-0.1e-2\\ 7 \\1.5x";
+  OFCHECK_EQUAL(OFStandard::atof(buf, 4, &r), 12.5);
+  OFCHECK(r);
+  OFCHECK_EQUAL(OFStandard::atof(buf + 5, 7, &r), -0.001);
+  OFCHECK(r);
+  OFCHECK_EQUAL(OFStandard::atof(buf + 13, 3, &r), 7.0);
+  OFCHECK(r);
+  // trailing characters are ignored like by the NUL-terminated version
+  OFCHECK_EQUAL(OFStandard::atof(buf + 17, 4, &r), 1.5);
+  OFCHECK(r);
+  OFCHECK_EQUAL(OFStandard::atof(buf, 0, &r), 0.0);
+  OFCHECK(!r);
+  OFCHECK_EQUAL(OFStandard::atof(NULL, 0, &r), 0.0);
+  OFCHECK(!r);
+
+  // both versions must return exactly the same (correctly rounded) values
+  const char *values[] =
+  {
+    "0.1", "-4.99", "500.005", "6.66E-01", "123456789012345", "1234567890123456", "0.000000000000000000001",
+    "1e22", "1e23", "9007199254740993", "-0", "3.14159265358979", "2.2250738585072014E-308", "NaN", "-INF", "1.5e", "."
+  };
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+  {
+    OFBool r1 = OFFalse;
+    OFBool r2 = OFFalse;
+    const double d1 = OFStandard::atof(values[i], &r1);
+    const double d2 = OFStandard::atof(values[i], strlen(values[i]), &r2);
+    OFCHECK_EQUAL(r1, r2);
+    if (r1 && r2 && (d1 == d1))
+    {
+      if (d1 != d2)
+        OFCHECK_FAIL("conversion of " << values[i] << " differs: " << d1 << " vs. " << d2);
+    }
+    // the result must be identical to the one of the C library
+    if (r1 && (d1 == d1) && (d1 != strtod(values[i], NULL)))
+      OFCHECK_FAIL("conversion of " << values[i] << " is not correctly rounded: " << d1);
+  }
+}
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2022, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -63,6 +63,7 @@ OFTEST_REGISTER(ofstd_OFUUID_1);
 OFTEST_REGISTER(ofstd_OFUUID_2);
 OFTEST_REGISTER(ofstd_OFVector);
 OFTEST_REGISTER(ofstd_atof);
+OFTEST_REGISTER(ofstd_atof_length);
 OFTEST_REGISTER(ofstd_base64_1);
 OFTEST_REGISTER(ofstd_base64_2);
 OFTEST_REGISTER(ofstd_base64_3);